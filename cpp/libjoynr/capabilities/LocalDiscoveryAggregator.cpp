@@ -18,23 +18,188 @@
  */
 #include "joynr/LocalDiscoveryAggregator.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
 #include "joynr/Future.h"
 #include "joynr/exceptions/JoynrException.h"
 #include "joynr/types/DiscoveryEntry.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
+#include "joynr/types/DiscoveryQos.h"
+#include "joynr/types/DiscoveryScope.h"
 
 namespace joynr
 {
 
+namespace
+{
+std::string createLookupKey(std::vector<std::string> domains,
+                            const std::string& interfaceName,
+                            const types::DiscoveryQos& discoveryQos)
+{
+    std::sort(domains.begin(), domains.end());
+    std::string key = interfaceName + "\n" +
+                      std::to_string(static_cast<int>(discoveryQos.getDiscoveryScope())) + "\n" +
+                      std::to_string(discoveryQos.getProviderMustSupportOnChange());
+    for (const std::string& domain : domains) {
+        key += "\n" + domain;
+    }
+    return key;
+}
+} // namespace
+
+struct LocalDiscoveryAggregator::LookupCache
+{
+    using Result = std::vector<types::DiscoveryEntryWithMetaInfo>;
+
+    struct Callbacks
+    {
+        std::function<void(const Result&)> onSuccess;
+        std::function<void(const exceptions::JoynrRuntimeException&)> onRuntimeError;
+        std::shared_ptr<joynr::Future<Result>> future;
+    };
+
+    struct PendingLookup
+    {
+        std::vector<std::string> domains;
+        std::string interfaceName;
+        // value of invalidations when the lookup was started
+        std::uint64_t invalidationCount;
+        std::vector<Callbacks> callbacks;
+    };
+
+    struct CachedLookup
+    {
+        std::vector<std::string> domains;
+        std::string interfaceName;
+        Result result;
+        std::chrono::steady_clock::time_point lookupTime;
+    };
+
+    void onLookupSuccess(const std::string& lookupKey,
+                         const std::string& pendingLookupKey,
+                         const Result& result)
+    {
+        std::vector<Callbacks> waitingCallbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto pendingLookup = pendingLookups.find(pendingLookupKey);
+            if (pendingLookup == pendingLookups.end()) {
+                return;
+            }
+            // results which may contain invalidated entries and empty results, which will
+            // likely change once a provider is registered, are not cached
+            if (pendingLookup->second.invalidationCount == invalidations && !result.empty() &&
+                !containsLocalEntries(result)) {
+                CachedLookup& cachedLookup = cachedLookups[lookupKey];
+                cachedLookup.domains = pendingLookup->second.domains;
+                cachedLookup.interfaceName = pendingLookup->second.interfaceName;
+                cachedLookup.result = result;
+                cachedLookup.lookupTime = std::chrono::steady_clock::now();
+            }
+            waitingCallbacks = std::move(pendingLookup->second.callbacks);
+            pendingLookups.erase(pendingLookup);
+        }
+        for (const Callbacks& callbacks : waitingCallbacks) {
+            if (callbacks.onSuccess) {
+                callbacks.onSuccess(result);
+            }
+            callbacks.future->onSuccess(result);
+        }
+    }
+
+    void onLookupError(const std::string& pendingLookupKey,
+                       const exceptions::JoynrRuntimeException& error)
+    {
+        std::vector<Callbacks> waitingCallbacks;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto pendingLookup = pendingLookups.find(pendingLookupKey);
+            if (pendingLookup == pendingLookups.end()) {
+                return;
+            }
+            waitingCallbacks = std::move(pendingLookup->second.callbacks);
+            pendingLookups.erase(pendingLookup);
+        }
+        for (const Callbacks& callbacks : waitingCallbacks) {
+            if (callbacks.onRuntimeError) {
+                callbacks.onRuntimeError(error);
+            }
+            callbacks.future->onError(std::shared_ptr<exceptions::JoynrException>(error.clone()));
+        }
+    }
+
+    void invalidate(const types::DiscoveryEntry& discoveryEntry)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++invalidations;
+        for (auto it = cachedLookups.begin(); it != cachedLookups.end();) {
+            if (affects(discoveryEntry, it->second)) {
+                it = cachedLookups.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    void invalidate(const std::string& participantId)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++invalidations;
+        for (auto it = cachedLookups.begin(); it != cachedLookups.end();) {
+            const Result& result = it->second.result;
+            if (std::any_of(result.cbegin(),
+                            result.cend(),
+                            [&participantId](const types::DiscoveryEntryWithMetaInfo& entry) {
+                                return entry.getParticipantId() == participantId;
+                            })) {
+                it = cachedLookups.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // local providers may be removed by other runtimes of the cluster controller without
+    // invalidating this cache
+    static bool containsLocalEntries(const Result& result)
+    {
+        return std::any_of(result.cbegin(),
+                           result.cend(),
+                           [](const types::DiscoveryEntryWithMetaInfo& entry) {
+                               return entry.getIsLocal();
+                           });
+    }
+
+    static bool affects(const types::DiscoveryEntry& discoveryEntry,
+                        const CachedLookup& cachedLookup)
+    {
+        return discoveryEntry.getInterfaceName() == cachedLookup.interfaceName &&
+               std::find(cachedLookup.domains.cbegin(),
+                         cachedLookup.domains.cend(),
+                         discoveryEntry.getDomain()) != cachedLookup.domains.cend();
+    }
+
+    std::mutex mutex;
+    std::uint64_t invalidations = 0;
+    // pending lookups are additionally keyed by cacheMaxAge, a lookup accepting only fresh
+    // entries must not be answered by a lookup accepting older ones
+    std::unordered_map<std::string, PendingLookup> pendingLookups;
+    std::unordered_map<std::string, CachedLookup> cachedLookups;
+};
+
 LocalDiscoveryAggregator::LocalDiscoveryAggregator(
         std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo> provisionedDiscoveryEntries)
-        : discoveryProxy(), provisionedDiscoveryEntries(std::move(provisionedDiscoveryEntries))
+        : discoveryProxy(),
+          provisionedDiscoveryEntries(std::move(provisionedDiscoveryEntries)),
+          lookupCache(std::make_shared<LookupCache>())
 {
 }
 
@@ -43,6 +208,21 @@ void LocalDiscoveryAggregator::setDiscoveryProxy(std::shared_ptr<IDiscoveryAsync
     this->discoveryProxy = std::move(discoveryProxy);
 }
 
+template <typename Key, typename... Args>
+std::function<void(Args...)> LocalDiscoveryAggregator::invalidateOnCompletion(
+        const Key& key,
+        std::function<void(Args...)> callback) const
+{
+    // lookups started before the CC processed the request might have missed the change
+    return [ cache = lookupCache, key, callback = std::move(callback) ](Args... args)
+    {
+        cache->invalidate(key);
+        if (callback) {
+            callback(args...);
+        }
+    };
+}
+
 #define REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(FUTURE_TYPE)                            \
     if (!discoveryProxy) {                                                                         \
         const std::string errorMsg("internal discoveryProxy not set");                             \
@@ -62,10 +242,12 @@ std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::addAsync(
 {
     assert(discoveryProxy);
     REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(void)
-    return discoveryProxy->addAsync(discoveryEntry,
-                                    std::move(onSuccess),
-                                    std::move(onRuntimeError),
-                                    std::move(messagingQos));
+    lookupCache->invalidate(discoveryEntry);
+    return discoveryProxy->addAsync(
+            discoveryEntry,
+            invalidateOnCompletion(discoveryEntry, std::move(onSuccess)),
+            invalidateOnCompletion(discoveryEntry, std::move(onRuntimeError)),
+            std::move(messagingQos));
 }
 
 std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::addAsync(
@@ -77,11 +259,13 @@ std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::addAsync(
 {
     assert(discoveryProxy);
     REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(void)
-    return discoveryProxy->addAsync(discoveryEntry,
-                                    awaitGlobalRegistration,
-                                    std::move(onSuccess),
-                                    std::move(onRuntimeError),
-                                    std::move(messagingQos));
+    lookupCache->invalidate(discoveryEntry);
+    return discoveryProxy->addAsync(
+            discoveryEntry,
+            awaitGlobalRegistration,
+            invalidateOnCompletion(discoveryEntry, std::move(onSuccess)),
+            invalidateOnCompletion(discoveryEntry, std::move(onRuntimeError)),
+            std::move(messagingQos));
 }
 
 std::shared_ptr<joynr::Future<std::vector<types::DiscoveryEntryWithMetaInfo>>>
@@ -96,12 +280,64 @@ LocalDiscoveryAggregator::lookupAsync(
     assert(discoveryProxy);
     REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(
             std::vector<types::DiscoveryEntryWithMetaInfo>)
-    return discoveryProxy->lookupAsync(domains,
-                                       interfaceName,
-                                       discoveryQos,
-                                       std::move(onSuccess),
-                                       std::move(onRuntimeError),
-                                       std::move(messagingQos));
+    using Result = LookupCache::Result;
+    auto future = std::make_shared<joynr::Future<Result>>();
+    const std::int64_t cacheMaxAgeMs = discoveryQos.getCacheMaxAge();
+    if (discoveryQos.getDiscoveryScope() == types::DiscoveryScope::LOCAL_ONLY) {
+        // local providers may be changed by other runtimes at any time, always ask the CC
+        return discoveryProxy->lookupAsync(domains,
+                                           interfaceName,
+                                           discoveryQos,
+                                           std::move(onSuccess),
+                                           std::move(onRuntimeError),
+                                           std::move(messagingQos));
+    }
+    std::string lookupKey = createLookupKey(domains, interfaceName, discoveryQos);
+    std::string pendingLookupKey = lookupKey + "\n" + std::to_string(cacheMaxAgeMs);
+    {
+        std::unique_lock<std::mutex> lock(lookupCache->mutex);
+        auto cachedLookup = lookupCache->cachedLookups.find(lookupKey);
+        if (cachedLookup != lookupCache->cachedLookups.cend() && cacheMaxAgeMs > 0 &&
+            std::chrono::steady_clock::now() - cachedLookup->second.lookupTime <=
+                    std::chrono::milliseconds(cacheMaxAgeMs)) {
+            const Result result = cachedLookup->second.result;
+            lock.unlock();
+            if (onSuccess) {
+                onSuccess(result);
+            }
+            future->onSuccess(result);
+            return future;
+        }
+
+        LookupCache::Callbacks callbacks{std::move(onSuccess), std::move(onRuntimeError), future};
+        auto pendingLookup = lookupCache->pendingLookups.find(pendingLookupKey);
+        if (pendingLookup != lookupCache->pendingLookups.end()) {
+            pendingLookup->second.callbacks.push_back(std::move(callbacks));
+            return future;
+        }
+        LookupCache::PendingLookup newPendingLookup;
+        newPendingLookup.domains = domains;
+        newPendingLookup.interfaceName = interfaceName;
+        newPendingLookup.invalidationCount = lookupCache->invalidations;
+        newPendingLookup.callbacks.push_back(std::move(callbacks));
+        lookupCache->pendingLookups.emplace(pendingLookupKey, std::move(newPendingLookup));
+    }
+
+    std::shared_ptr<LookupCache> cache = lookupCache;
+    auto onLookupSuccess = [cache, lookupKey, pendingLookupKey](const Result& result) {
+        cache->onLookupSuccess(lookupKey, pendingLookupKey, result);
+    };
+    auto onLookupError = [cache, pendingLookupKey](
+            const exceptions::JoynrRuntimeException& error) {
+        cache->onLookupError(pendingLookupKey, error);
+    };
+    discoveryProxy->lookupAsync(domains,
+                                interfaceName,
+                                discoveryQos,
+                                std::move(onLookupSuccess),
+                                std::move(onLookupError),
+                                std::move(messagingQos));
+    return future;
 }
 
 std::shared_ptr<joynr::Future<types::DiscoveryEntryWithMetaInfo>> LocalDiscoveryAggregator::
@@ -136,10 +372,12 @@ std::shared_ptr<joynr::Future<void>> LocalDiscoveryAggregator::removeAsync(
 {
     assert(discoveryProxy);
     REPORT_ERROR_AND_RETURN_IF_DISCOVERY_PROXY_NOT_SET(void)
-    return discoveryProxy->removeAsync(participantId,
-                                       std::move(onSuccess),
-                                       std::move(onRuntimeError),
-                                       std::move(messagingQos));
+    lookupCache->invalidate(participantId);
+    return discoveryProxy->removeAsync(
+            participantId,
+            invalidateOnCompletion(participantId, std::move(onSuccess)),
+            invalidateOnCompletion(participantId, std::move(onRuntimeError)),
+            std::move(messagingQos));
 }
 
 } // namespace joynr
@@ -29,7 +29,12 @@ MessagingQos::MessagingQos(std::uint64_t ttl,
                            MessagingQosEffort::Enum effort,
                            bool encrypt,
                            bool compress)
-        : ttl(ttl), effort(effort), encrypt(encrypt), compress(compress), messageHeaders()
+        : ttl(ttl),
+          effort(effort),
+          encrypt(encrypt),
+          compress(compress),
+          serializer("json"),
+          messageHeaders()
 {
 }
 
@@ -83,6 +88,16 @@ void MessagingQos::setCompress(const bool compress)
     this->compress = compress;
 }
 
+const std::string& MessagingQos::getSerializer() const
+{
+    return serializer;
+}
+
+void MessagingQos::setSerializer(const std::string& serializer)
+{
+    this->serializer = serializer;
+}
+
 void MessagingQos::putCustomMessageHeader(const std::string& key, const std::string& value)
 {
     checkCustomHeaderKeyValue(key, value);
@@ -120,6 +135,7 @@ bool MessagingQos::operator==(const MessagingQos& other) const
     return (this->getTtl() == other.getTtl() && this->getEffort() == other.getEffort() &&
             this->getEncrypt() == other.getEncrypt() &&
             this->getCompress() == other.getCompress() &&
+            this->getSerializer() == other.getSerializer() &&
             this->getCustomMessageHeaders() == other.getCustomMessageHeaders());
 }
 
@@ -131,6 +147,7 @@ std::string MessagingQos::toString() const
     msgQosAsString << "effort:" << MessagingQosEffort::getLiteral(this->getEffort());
     msgQosAsString << "encrypt:" << this->getEncrypt();
     msgQosAsString << "compress:" << this->getCompress();
+    msgQosAsString << "serializer:" << this->getSerializer();
     msgQosAsString << "}";
     return msgQosAsString.str();
 }
@@ -19,15 +19,46 @@
 
 #include "joynr/MulticastReceiverDirectory.h"
 
+#include <algorithm>
+#include <cctype>
+
+#include "joynr/Util.h"
+
 namespace joynr
 {
 
-MulticastReceiverDirectory::~MulticastReceiverDirectory()
+namespace
+{
+
+std::vector<std::string> splitIntoLevels(const std::string& multicastId)
+{
+    std::vector<std::string> levels;
+    std::size_t begin = 0;
+    std::size_t end;
+    while ((end = multicastId.find('/', begin)) != std::string::npos) {
+        levels.emplace_back(multicastId, begin, end - begin);
+        begin = end + 1;
+    }
+    levels.emplace_back(multicastId, begin);
+    return levels;
+}
+
+// wildcards only match non-empty alphanumeric partitions
+bool isWildcardMatch(const std::string& level)
+{
+    return !level.empty() && std::all_of(level.cbegin(), level.cend(), [](char c) {
+        return std::isalnum(static_cast<unsigned char>(c)) != 0;
+    });
+}
+
+} // namespace
+
+MulticastReceiverDirectory::MulticastReceiverDirectory() : root(), readWriteLock()
 {
-    JOYNR_LOG_TRACE(logger(), "destructor: number of entries = {}", multicastReceivers.size());
-    multicastReceivers.clear();
 }
 
+MulticastReceiverDirectory::~MulticastReceiverDirectory() = default;
+
 void MulticastReceiverDirectory::registerMulticastReceiver(const std::string& multicastId,
                                                            const std::string& receiverId)
 {
@@ -35,9 +66,8 @@ void MulticastReceiverDirectory::registerMulticastReceiver(const std::string& mu
                     "register multicast receiver: multicastId={}, receiverId={}",
                     multicastId,
                     receiverId);
-    std::lock_guard<std::recursive_mutex> lock(mutex);
-    MulticastMatcher matcher(multicastId);
-    multicastReceivers[matcher].insert(receiverId);
+    WriteLocker lock(readWriteLock);
+    findOrCreateNode(multicastId).receivers.insert(receiverId);
 }
 
 bool MulticastReceiverDirectory::unregisterMulticastReceiver(const std::string& multicastId,
@@ -47,65 +77,157 @@ bool MulticastReceiverDirectory::unregisterMulticastReceiver(const std::string&
                     "unregister multicast receiver: multicastId={}, receiverId={}",
                     multicastId,
                     receiverId);
-    std::lock_guard<std::recursive_mutex> lock(mutex);
-    if (contains(multicastId)) {
-        MulticastMatcher matcher(multicastId);
-        std::unordered_set<std::string>& receivers = multicastReceivers[matcher];
-        receivers.erase(receiverId);
-        JOYNR_LOG_TRACE(logger(),
-                        "removed multicast receiver: multicastId={}, receiverId={}",
-                        multicastId,
-                        receiverId);
-        if (receivers.empty()) {
-            JOYNR_LOG_TRACE(
-                    logger(), "removed last multicast receiver: multicastId={}", multicastId);
-            multicastReceivers.erase(matcher);
+    WriteLocker lock(readWriteLock);
+
+    // remember the path in order to prune nodes which are no longer needed
+    std::vector<std::pair<Node*, std::string>> path;
+    Node* node = &root;
+    for (auto& level : splitIntoLevels(multicastId)) {
+        auto child = node->children.find(level);
+        if (child == node->children.end()) {
+            return false;
         }
-        return true;
+        path.emplace_back(node, std::move(level));
+        node = child->second.get();
     }
-    return false;
+    if (node->receivers.empty()) {
+        return false;
+    }
+
+    node->receivers.erase(receiverId);
+    JOYNR_LOG_TRACE(logger(),
+                    "removed multicast receiver: multicastId={}, receiverId={}",
+                    multicastId,
+                    receiverId);
+    if (node->receivers.empty()) {
+        JOYNR_LOG_TRACE(logger(), "removed last multicast receiver: multicastId={}", multicastId);
+        for (auto it = path.rbegin(); it != path.rend(); ++it) {
+            Node* parent = it->first;
+            const Node& child = *parent->children[it->second];
+            if (!child.receivers.empty() || !child.children.empty()) {
+                break;
+            }
+            parent->children.erase(it->second);
+        }
+    }
+    return true;
 }
 
 std::unordered_set<std::string> MulticastReceiverDirectory::getReceivers(
-        const std::string& multicastId)
+        const std::string& multicastId) const
 {
     JOYNR_LOG_TRACE(logger(), "get multicast receivers: multicastId={}", multicastId);
-    std::lock_guard<std::recursive_mutex> lock(mutex);
-
+    const std::vector<std::string> levels = splitIntoLevels(multicastId);
     std::unordered_set<std::string> foundReceivers;
-    for (const auto& entry : multicastReceivers) {
-        if (entry.first.doesMatch(multicastId)) {
-            foundReceivers.insert(entry.second.cbegin(), entry.second.cend());
-        }
-    }
+
+    ReadLocker lock(readWriteLock);
+    collectReceivers(root, levels, 0, foundReceivers);
     return foundReceivers;
 }
 
 std::vector<std::string> MulticastReceiverDirectory::getMulticastIds() const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex);
     std::vector<std::string> multicastIds;
 
-    for (const auto& multicastReceiver : multicastReceivers) {
-        multicastIds.push_back(multicastReceiver.first.multicastId);
-    }
+    ReadLocker lock(readWriteLock);
+    forEachMulticastId(root, std::string(), [&multicastIds](const std::string& multicastId,
+                                                            const Node&) {
+        multicastIds.push_back(multicastId);
+    });
 
     return multicastIds;
 }
 
-bool MulticastReceiverDirectory::contains(const std::string& multicastId)
+bool MulticastReceiverDirectory::contains(const std::string& multicastId) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex);
-    MulticastMatcher matcher(multicastId);
-    return multicastReceivers.find(matcher) != multicastReceivers.cend();
+    ReadLocker lock(readWriteLock);
+    const Node* node = findNode(multicastId);
+    return node != nullptr && !node->receivers.empty();
 }
 
 bool MulticastReceiverDirectory::contains(const std::string& multicastId,
-                                          const std::string& receiverId)
+                                          const std::string& receiverId) const
 {
-    std::lock_guard<std::recursive_mutex> lock(mutex);
     const auto& receivers = getReceivers(multicastId);
     return receivers.find(receiverId) != receivers.cend();
 }
 
+MulticastReceiverDirectory::Node& MulticastReceiverDirectory::findOrCreateNode(
+        const std::string& multicastId)
+{
+    Node* node = &root;
+    for (auto& level : splitIntoLevels(multicastId)) {
+        std::unique_ptr<Node>& child = node->children[std::move(level)];
+        if (!child) {
+            child = std::make_unique<Node>();
+        }
+        node = child.get();
+    }
+    return *node;
+}
+
+const MulticastReceiverDirectory::Node* MulticastReceiverDirectory::findNode(
+        const std::string& multicastId) const
+{
+    const Node* node = &root;
+    for (const auto& level : splitIntoLevels(multicastId)) {
+        auto child = node->children.find(level);
+        if (child == node->children.cend()) {
+            return nullptr;
+        }
+        node = child->second.get();
+    }
+    return node;
+}
+
+void MulticastReceiverDirectory::collectReceivers(
+        const Node& node,
+        const std::vector<std::string>& levels,
+        std::size_t depth,
+        std::unordered_set<std::string>& foundReceivers) const
+{
+    auto multiLevelWildcard = node.children.find(util::MULTI_LEVEL_WILDCARD);
+    if (multiLevelWildcard != node.children.cend()) {
+        // matches the current level including all remaining levels as well as no level at all
+        const bool remainingLevelsMatch = std::all_of(
+                levels.cbegin() + depth, levels.cend(), isWildcardMatch);
+        if (remainingLevelsMatch) {
+            const auto& receivers = multiLevelWildcard->second->receivers;
+            foundReceivers.insert(receivers.cbegin(), receivers.cend());
+        }
+    }
+
+    if (depth == levels.size()) {
+        foundReceivers.insert(node.receivers.cbegin(), node.receivers.cend());
+        return;
+    }
+
+    const std::string& level = levels[depth];
+    auto exactMatch = node.children.find(level);
+    if (exactMatch != node.children.cend()) {
+        collectReceivers(*exactMatch->second, levels, depth + 1, foundReceivers);
+    }
+    if (isWildcardMatch(level)) {
+        auto singleLevelWildcard = node.children.find(util::SINGLE_LEVEL_WILDCARD);
+        if (singleLevelWildcard != node.children.cend()) {
+            collectReceivers(*singleLevelWildcard->second, levels, depth + 1, foundReceivers);
+        }
+    }
+}
+
+void MulticastReceiverDirectory::forEachMulticastId(
+        const Node& node,
+        const std::string& prefix,
+        const std::function<void(const std::string&, const Node&)>& callback) const
+{
+    for (const auto& child : node.children) {
+        const std::string multicastId =
+                (&node == &root) ? child.first : prefix + "/" + child.first;
+        if (!child.second->receivers.empty()) {
+            callback(multicastId, *child.second);
+        }
+        forEachMulticastId(*child.second, multicastId, callback);
+    }
+}
+
 } // namespace joynr
@@ -0,0 +1,304 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/TimerWheel.h"
+
+#include <cassert>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/version.hpp>
+
+#include "joynr/SteadyTimer.h"
+#include "joynr/Util.h"
+
+namespace joynr
+{
+
+namespace
+{
+
+/**
+ * asio service which attaches one TimerWheel to an io_service
+ */
+class TimerWheelService : public boost::asio::io_service::service
+{
+public:
+    static boost::asio::io_service::id id;
+
+    explicit TimerWheelService(boost::asio::io_service& ioService)
+            : boost::asio::io_service::service(ioService),
+              timerWheel(std::make_shared<TimerWheel>(ioService))
+    {
+    }
+
+    std::shared_ptr<TimerWheel> getTimerWheel() const
+    {
+        return timerWheel;
+    }
+
+private:
+#if BOOST_VERSION >= 106600
+    void shutdown() override
+#else
+    void shutdown_service() override
+#endif
+    {
+        timerWheel->shutdown();
+    }
+
+    std::shared_ptr<TimerWheel> timerWheel;
+};
+
+boost::asio::io_service::id TimerWheelService::id;
+
+} // namespace
+
+constexpr TimerWheel::TimerId TimerWheel::INVALID_TIMER_ID;
+
+TimerWheel::TimerWheel(boost::asio::io_service& ioService, std::chrono::milliseconds tickDuration)
+        : std::enable_shared_from_this<TimerWheel>(),
+          tickDuration(tickDuration),
+          startTime(std::chrono::steady_clock::now()),
+          slots(),
+          locations(),
+          currentTick(0),
+          nextTimerId(INVALID_TIMER_ID),
+          timer(std::make_unique<SteadyTimer>(ioService)),
+          isArmed(false),
+          armedTick(0),
+          armedGeneration(0),
+          isShutdown(false),
+          mutex()
+{
+    assert(tickDuration > std::chrono::milliseconds::zero());
+}
+
+TimerWheel::~TimerWheel()
+{
+    JOYNR_LOG_TRACE(logger(), "destructor: number of timers = {}", locations.size());
+}
+
+std::shared_ptr<TimerWheel> TimerWheel::getInstance(boost::asio::io_service& ioService)
+{
+    return boost::asio::use_service<TimerWheelService>(ioService).getTimerWheel();
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::milliseconds delay,
+                                         std::function<void()> callback)
+{
+    assert(callback);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (isShutdown) {
+        JOYNR_LOG_TRACE(logger(), "schedule failed: already shutdown");
+        return INVALID_TIMER_ID;
+    }
+
+    const std::uint64_t nowTick = getNowTick();
+    if (locations.empty()) {
+        // nothing can expire in between, skip idle ticks
+        currentTick = std::max(currentTick, nowTick);
+    }
+
+    // round up so that the callback is never invoked too early
+    const std::uint64_t delayTicks =
+            delay <= std::chrono::milliseconds::zero()
+                    ? 1
+                    : static_cast<std::uint64_t>((delay.count() + tickDuration.count() - 1) /
+                                                 tickDuration.count());
+    const std::uint64_t expiryTick = std::max(nowTick + delayTicks, currentTick + 1);
+
+    const TimerId timerId = ++nextTimerId;
+    const auto slot = getSlotFor(expiryTick);
+    Slot& target = slots[slot.first][slot.second];
+    target.push_back(Entry{timerId, expiryTick, std::move(callback)});
+    locations.emplace(timerId, Location{slot.first, slot.second, std::prev(target.end())});
+
+    if (!isArmed || expiryTick < armedTick) {
+        arm(std::min(expiryTick, getNextEventTick()));
+    }
+
+    return timerId;
+}
+
+bool TimerWheel::cancel(TimerId timerId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = locations.find(timerId);
+    if (it == locations.end()) {
+        return false;
+    }
+    const Location& location = it->second;
+    slots[location.level][location.slot].erase(location.entry);
+    locations.erase(it);
+    return true;
+}
+
+void TimerWheel::shutdown()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (isShutdown) {
+        return;
+    }
+    isShutdown = true;
+    isArmed = false;
+    locations.clear();
+    for (auto& level : slots) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    timer->cancel();
+    // the timer must not outlive the io_service
+    timer.reset();
+}
+
+std::size_t TimerWheel::getNumberOfTimers() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return locations.size();
+}
+
+std::uint64_t TimerWheel::getNowTick() const
+{
+    return static_cast<std::uint64_t>((std::chrono::steady_clock::now() - startTime) /
+                                      tickDuration);
+}
+
+std::pair<std::size_t, std::size_t> TimerWheel::getSlotFor(std::uint64_t expiryTick) const
+{
+    assert(expiryTick >= currentTick);
+    const std::uint64_t delta = expiryTick - currentTick;
+    for (std::size_t level = 0; level < NUMBER_OF_LEVELS; ++level) {
+        if (delta < (std::uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+            return {level, (expiryTick >> (SLOT_BITS * level)) & (NUMBER_OF_SLOTS - 1)};
+        }
+    }
+    // beyond the range of the wheel: park in the slot of the highest level which
+    // is cascaded last, the entry is placed again from there
+    const std::size_t level = NUMBER_OF_LEVELS - 1;
+    return {level,
+            ((currentTick >> (SLOT_BITS * level)) + NUMBER_OF_SLOTS - 1) & (NUMBER_OF_SLOTS - 1)};
+}
+
+void TimerWheel::relocate(Slot& source, Slot::iterator entry)
+{
+    const auto slot = getSlotFor(entry->expiryTick);
+    Slot& target = slots[slot.first][slot.second];
+    // splicing keeps the iterator stored in locations valid
+    target.splice(target.end(), source, entry);
+    Location& location = locations[entry->id];
+    location.level = slot.first;
+    location.slot = slot.second;
+}
+
+void TimerWheel::cascade(std::size_t level)
+{
+    Slot& source = slots[level][(currentTick >> (SLOT_BITS * level)) & (NUMBER_OF_SLOTS - 1)];
+    while (!source.empty()) {
+        relocate(source, source.begin());
+    }
+}
+
+void TimerWheel::advance(std::uint64_t nowTick,
+                         std::vector<std::function<void()>>& expiredCallbacks)
+{
+    while (currentTick < nowTick && !locations.empty()) {
+        ++currentTick;
+        for (std::size_t level = NUMBER_OF_LEVELS - 1; level > 0; --level) {
+            if ((currentTick & ((std::uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(level);
+            }
+        }
+        Slot& expired = slots[0][currentTick & (NUMBER_OF_SLOTS - 1)];
+        for (auto& entry : expired) {
+            assert(entry.expiryTick <= currentTick);
+            locations.erase(entry.id);
+            expiredCallbacks.push_back(std::move(entry.callback));
+        }
+        expired.clear();
+    }
+    if (locations.empty()) {
+        currentTick = std::max(currentTick, nowTick);
+    }
+}
+
+std::uint64_t TimerWheel::getNextEventTick() const
+{
+    // wake up for the next occupied slot of the lowest level or,
+    // at the latest, when the next cascade takes place
+    const std::uint64_t nextCascadeTick = ((currentTick >> SLOT_BITS) + 1) << SLOT_BITS;
+    for (std::uint64_t tick = currentTick + 1; tick < nextCascadeTick; ++tick) {
+        if (!slots[0][tick & (NUMBER_OF_SLOTS - 1)].empty()) {
+            return tick;
+        }
+    }
+    return nextCascadeTick;
+}
+
+void TimerWheel::arm(std::uint64_t tick)
+{
+    isArmed = true;
+    armedTick = tick;
+    const std::uint64_t generation = ++armedGeneration;
+
+    const auto expiryTime = startTime + tick * tickDuration;
+    const auto now = std::chrono::steady_clock::now();
+    std::chrono::milliseconds delay = std::chrono::milliseconds::zero();
+    if (expiryTime > now) {
+        // round up, the tick must have been reached when the timer fires
+        delay = std::chrono::duration_cast<std::chrono::milliseconds>(expiryTime - now) +
+                std::chrono::milliseconds(1);
+    }
+
+    timer->expiresFromNow(delay);
+    timer->asyncWait([ thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()), generation ](
+            const boost::system::error_code& errorCode) {
+        if (errorCode) {
+            return;
+        }
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->onTimerExpired(generation);
+        }
+    });
+}
+
+void TimerWheel::onTimerExpired(std::uint64_t generation)
+{
+    std::vector<std::function<void()>> expiredCallbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isShutdown || generation != armedGeneration) {
+            // superseded by a later call to arm()
+            return;
+        }
+        isArmed = false;
+        advance(getNowTick(), expiredCallbacks);
+        if (!locations.empty()) {
+            arm(getNextEventTick());
+        }
+    }
+
+    // invoke callbacks without holding the lock, they may schedule or cancel timeouts
+    for (auto& callback : expiredCallbacks) {
+        callback();
+    }
+}
+
+} // namespace joynr
@@ -28,6 +28,7 @@
 #include <string>
 
 #include <boost/filesystem.hpp>
+#include <boost/random/mersenne_twister.hpp>
 #include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
@@ -107,12 +108,9 @@ std::string attributeGetterFromName(const std::string& attributeName)
 
 std::string createUuid()
 {
-    // instantiation of random generator is expensive,
-    // therefore we use a static one:
-    static boost::uuids::random_generator uuidGenerator;
-    // uuid generator is not threadsafe
-    static std::mutex uuidMutex;
-    std::lock_guard<std::mutex> uuidLock(uuidMutex);
+    // instantiation of random generator is expensive and it is not threadsafe,
+    // therefore every thread uses its own, independently seeded one
+    static thread_local boost::uuids::basic_random_generator<boost::mt19937> uuidGenerator;
     return boost::uuids::to_string(uuidGenerator());
 }
 
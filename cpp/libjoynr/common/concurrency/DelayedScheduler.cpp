@@ -21,9 +21,6 @@
 #include <cassert>
 #include <utility>
 
-#include <boost/asio/io_service.hpp>
-#include <boost/system/error_code.hpp>
-
 #include "joynr/Util.h"
 
 namespace joynr
@@ -39,7 +36,7 @@ DelayedScheduler::DelayedScheduler(std::function<void(std::shared_ptr<Runnable>)
           delayedRunnables(),
           writeLock(),
           nextRunnableHandle(0),
-          ioService(ioService)
+          timerWheel(TimerWheel::getInstance(ioService))
 {
 }
 
@@ -78,12 +75,12 @@ DelayedScheduler::RunnableHandle DelayedScheduler::schedule(std::shared_ptr<Runn
             std::piecewise_construct,
             std::forward_as_tuple(newRunnableHandle),
             std::forward_as_tuple(runnable,
-                                  ioService,
+                                  timerWheel,
                                   std::chrono::milliseconds(delay),
                                   [
                                     thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
                                     newRunnableHandle
-                                  ](const boost::system::error_code& errorCode) {
+                                  ]() {
                 auto thisSharedPtr = thisWeakPtr.lock();
                 if (!thisSharedPtr) {
                     JOYNR_LOG_ERROR(logger(),
@@ -91,30 +88,24 @@ DelayedScheduler::RunnableHandle DelayedScheduler::schedule(std::shared_ptr<Runn
                                     "DelayedScheduler no longer exists");
                     return;
                 }
-                if (!errorCode) {
-                    std::lock_guard<std::mutex> lock(thisSharedPtr->writeLock);
-                    {
-                        // Look up the runnable because it might have been removed
-                        // by another thread while we were waiting for the mutex.
-                        auto it = thisSharedPtr->delayedRunnables.find(newRunnableHandle);
-
-                        if (it == thisSharedPtr->delayedRunnables.end()) {
-                            JOYNR_LOG_WARN(logger(),
-                                           "Timed runnable with ID {} not found.",
-                                           newRunnableHandle);
-                            return;
-                        }
-
-                        if (!thisSharedPtr->stoppingDelayedScheduler) {
-                            std::shared_ptr<Runnable> runnable = it->second.takeRunnable();
-                            thisSharedPtr->onWorkAvailable(runnable);
-                        }
-                        thisSharedPtr->delayedRunnables.erase(it);
+                std::lock_guard<std::mutex> lock(thisSharedPtr->writeLock);
+                {
+                    // Look up the runnable because it might have been removed
+                    // by another thread while we were waiting for the mutex.
+                    auto it = thisSharedPtr->delayedRunnables.find(newRunnableHandle);
+
+                    if (it == thisSharedPtr->delayedRunnables.end()) {
+                        JOYNR_LOG_WARN(logger(),
+                                       "Timed runnable with ID {} not found.",
+                                       newRunnableHandle);
+                        return;
                     }
-                } else if (errorCode != boost::system::errc::operation_canceled) {
-                    JOYNR_LOG_ERROR(logger(),
-                                    "Failed to schedule delayed runnable: {}",
-                                    errorCode.message());
+
+                    if (!thisSharedPtr->stoppingDelayedScheduler) {
+                        std::shared_ptr<Runnable> runnable = it->second.takeRunnable();
+                        thisSharedPtr->onWorkAvailable(runnable);
+                    }
+                    thisSharedPtr->delayedRunnables.erase(it);
                 }
             }));
 
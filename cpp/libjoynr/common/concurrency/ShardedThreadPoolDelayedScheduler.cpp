@@ -0,0 +1,217 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/ShardedThreadPoolDelayedScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+
+#include <boost/asio/io_service.hpp>
+
+#include "joynr/Runnable.h"
+#include "joynr/ThreadPool.h"
+
+namespace joynr
+{
+
+namespace
+{
+
+void updateMaximum(std::atomic<std::uint64_t>& maximum, std::uint64_t value)
+{
+    std::uint64_t current = maximum.load(std::memory_order_relaxed);
+    while (value > current &&
+           !maximum.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+struct ShardCounters
+{
+    ShardCounters()
+            : queueDepth(0),
+              maxQueueDepth(0),
+              executedRunnables(0),
+              totalLatencyUs(0),
+              maxLatencyUs(0)
+    {
+    }
+
+    void onEnqueued()
+    {
+        const std::uint64_t depth = ++queueDepth;
+        updateMaximum(maxQueueDepth, depth);
+    }
+
+    void onDequeued(std::chrono::microseconds latency)
+    {
+        const std::uint64_t latencyUs = static_cast<std::uint64_t>(latency.count());
+        --queueDepth;
+        ++executedRunnables;
+        totalLatencyUs += latencyUs;
+        updateMaximum(maxLatencyUs, latencyUs);
+    }
+
+    std::atomic<std::uint64_t> queueDepth;
+    std::atomic<std::uint64_t> maxQueueDepth;
+    std::atomic<std::uint64_t> executedRunnables;
+    std::atomic<std::uint64_t> totalLatencyUs;
+    std::atomic<std::uint64_t> maxLatencyUs;
+};
+
+/**
+ * Wraps a runnable in order to measure the time it waits in the queue of its shard
+ */
+class InstrumentedRunnable : public Runnable
+{
+public:
+    InstrumentedRunnable(std::shared_ptr<Runnable> runnable,
+                         std::shared_ptr<ShardCounters> counters)
+            : Runnable(),
+              runnable(std::move(runnable)),
+              counters(std::move(counters)),
+              enqueueTime(std::chrono::steady_clock::now())
+    {
+        this->counters->onEnqueued();
+    }
+
+    void shutdown() override
+    {
+        runnable->shutdown();
+    }
+
+    void run() override
+    {
+        counters->onDequeued(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - enqueueTime));
+        runnable->run();
+    }
+
+private:
+    std::shared_ptr<Runnable> runnable;
+    std::shared_ptr<ShardCounters> counters;
+    const std::chrono::steady_clock::time_point enqueueTime;
+};
+
+} // namespace
+
+class ShardedThreadPoolDelayedScheduler::Shard
+{
+public:
+    Shard(const std::string& name, boost::asio::io_service& ioService)
+            : counters(std::make_shared<ShardCounters>()),
+              threadPool(std::make_shared<ThreadPool>(name, 1)),
+              delayedScheduler()
+    {
+        threadPool->init();
+        delayedScheduler = std::make_shared<DelayedScheduler>(
+                [ threadPool = this->threadPool, counters = this->counters ](
+                        std::shared_ptr<Runnable> runnable) {
+                    threadPool->execute(std::make_shared<InstrumentedRunnable>(
+                            std::move(runnable), counters));
+                },
+                ioService);
+    }
+
+    ~Shard()
+    {
+        assert(!threadPool->isRunning());
+    }
+
+    DelayedScheduler::RunnableHandle schedule(std::shared_ptr<Runnable> runnable,
+                                              std::chrono::milliseconds delay)
+    {
+        return delayedScheduler->schedule(std::move(runnable), delay);
+    }
+
+    void shutdown()
+    {
+        delayedScheduler->shutdown();
+        threadPool->shutdown();
+    }
+
+    ShardStatistics getStatistics() const
+    {
+        ShardStatistics statistics;
+        statistics.queueDepth = counters->queueDepth;
+        statistics.maxQueueDepth = counters->maxQueueDepth;
+        statistics.executedRunnables = counters->executedRunnables;
+        statistics.averageLatency =
+                std::chrono::microseconds(statistics.executedRunnables == 0
+                                                  ? 0
+                                                  : counters->totalLatencyUs /
+                                                            statistics.executedRunnables);
+        statistics.maxLatency = std::chrono::microseconds(counters->maxLatencyUs);
+        return statistics;
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(Shard);
+
+    std::shared_ptr<ShardCounters> counters;
+    std::shared_ptr<ThreadPool> threadPool;
+    std::shared_ptr<DelayedScheduler> delayedScheduler;
+};
+
+ShardedThreadPoolDelayedScheduler::ShardedThreadPoolDelayedScheduler(
+        std::uint8_t numberOfShards,
+        const std::string& name,
+        boost::asio::io_service& ioService)
+        : shards()
+{
+    const std::uint8_t shardCount = std::max<std::uint8_t>(numberOfShards, 1);
+    shards.reserve(shardCount);
+    for (std::uint8_t i = 0; i < shardCount; ++i) {
+        shards.push_back(std::make_shared<Shard>(name + "-" + std::to_string(i), ioService));
+    }
+}
+
+ShardedThreadPoolDelayedScheduler::~ShardedThreadPoolDelayedScheduler() = default;
+
+DelayedScheduler::RunnableHandle ShardedThreadPoolDelayedScheduler::schedule(
+        std::shared_ptr<Runnable> runnable,
+        std::size_t shardKey,
+        std::chrono::milliseconds delay)
+{
+    return shards[shardKey % shards.size()]->schedule(std::move(runnable), delay);
+}
+
+void ShardedThreadPoolDelayedScheduler::shutdown()
+{
+    for (auto& shard : shards) {
+        shard->shutdown();
+    }
+}
+
+std::size_t ShardedThreadPoolDelayedScheduler::getNumberOfShards() const
+{
+    return shards.size();
+}
+
+std::vector<ShardedThreadPoolDelayedScheduler::ShardStatistics> ShardedThreadPoolDelayedScheduler::
+        getStatistics() const
+{
+    std::vector<ShardStatistics> statistics;
+    statistics.reserve(shards.size());
+    for (const auto& shard : shards) {
+        statistics.push_back(shard->getStatistics());
+    }
+    return statistics;
+}
+
+} // namespace joynr
@@ -20,7 +20,7 @@
 
 #include <cassert>
 #include <functional>
-#include <set>
+#include <tuple>
 
 #include "joynr/Runnable.h"
 
@@ -29,19 +29,22 @@ namespace joynr
 
 ThreadPool::ThreadPool(const std::string& name, std::uint8_t numberOfThreads)
         : threads(),
-          scheduler(),
+          scheduler(numberOfThreads),
           keepRunning(true),
           currentlyRunning(),
-          mutex(),
           numberOfThreads(numberOfThreads),
           name(name)
 {
+    for (std::uint8_t i = 0; i < numberOfThreads; ++i) {
+        currentlyRunning.push_back(std::make_unique<RunningSlot>());
+    }
 }
 
 void ThreadPool::init()
 {
     for (std::uint8_t i = 0; i < numberOfThreads; ++i) {
-        threads.emplace_back(std::bind(&ThreadPool::threadLifecycle, this, shared_from_this()));
+        threads.emplace_back(
+                std::bind(&ThreadPool::threadLifecycle, this, shared_from_this(), std::size_t(i)));
     }
 
 #if 0 // This is not working in g_SystemIntegrationTests
@@ -73,14 +76,14 @@ void ThreadPool::shutdown()
     // taken by this ThreadPool
     scheduler.shutdown();
 
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        for (std::shared_ptr<Runnable> runnable : currentlyRunning) {
-            runnable->shutdown();
+    for (auto& slot : currentlyRunning) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (slot->runnable) {
+            slot->runnable->shutdown();
         }
     }
 
-    std::set<std::shared_ptr<Runnable>>::size_type maxRunning = 0;
+    std::size_t maxRunning = 0;
     for (auto thread = threads.begin(); thread != threads.end(); ++thread) {
         // do not cause an abort waiting for ourselves
         if (std::this_thread::get_id() == thread->get_id()) {
@@ -92,13 +95,18 @@ void ThreadPool::shutdown()
     }
     threads.clear();
 
-    {
-        std::lock_guard<std::mutex> lock(mutex);
-        // Runnables should be cleaned in the thread loop
-        // except for the thread that runs this code in case
-        // it was part of the ThreadPool
-        assert(currentlyRunning.size() <= maxRunning);
+    // Runnables should be cleaned in the thread loop
+    // except for the thread that runs this code in case
+    // it was part of the ThreadPool
+    std::size_t running = 0;
+    for (auto& slot : currentlyRunning) {
+        std::lock_guard<std::mutex> lock(slot->mutex);
+        if (slot->runnable) {
+            ++running;
+        }
     }
+    assert(running <= maxRunning);
+    std::ignore = running;
 }
 
 bool ThreadPool::isRunning()
@@ -111,7 +119,8 @@ void ThreadPool::execute(std::shared_ptr<Runnable> runnable)
     scheduler.add(runnable);
 }
 
-void ThreadPool::threadLifecycle(std::shared_ptr<ThreadPool> thisSharedPtr)
+void ThreadPool::threadLifecycle(std::shared_ptr<ThreadPool> thisSharedPtr,
+                                 std::size_t workerIndex)
 {
     JOYNR_LOG_TRACE(logger(), "Thread enters lifecycle");
 
@@ -119,19 +128,21 @@ void ThreadPool::threadLifecycle(std::shared_ptr<ThreadPool> thisSharedPtr)
 
         JOYNR_LOG_TRACE(logger(), "Thread is waiting");
         // Take a runnable
-        std::shared_ptr<Runnable> runnable = scheduler.take();
+        std::shared_ptr<Runnable> runnable = scheduler.take(workerIndex);
 
         if (runnable) {
 
             JOYNR_LOG_TRACE(logger(), "Thread got runnable and will do work");
 
-            // Add runnable to the queue of currently running context
+            // Register runnable as currently running work of this thread,
+            // the slot is only contended by shutdown()
+            RunningSlot& slot = *thisSharedPtr->currentlyRunning[workerIndex];
             {
-                std::lock_guard<std::mutex> lock(thisSharedPtr->mutex);
+                std::lock_guard<std::mutex> lock(slot.mutex);
                 if (!thisSharedPtr->keepRunning) {
                     break;
                 }
-                thisSharedPtr->currentlyRunning.insert(runnable);
+                slot.runnable = runnable;
             }
 
             // Run the runnable
@@ -140,8 +151,8 @@ void ThreadPool::threadLifecycle(std::shared_ptr<ThreadPool> thisSharedPtr)
             JOYNR_LOG_TRACE(logger(), "Thread finished work");
 
             {
-                std::lock_guard<std::mutex> lock(thisSharedPtr->mutex);
-                thisSharedPtr->currentlyRunning.erase(runnable);
+                std::lock_guard<std::mutex> lock(slot.mutex);
+                slot.runnable.reset();
             }
         }
     }
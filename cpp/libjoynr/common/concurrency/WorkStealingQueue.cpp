@@ -0,0 +1,135 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/WorkStealingQueue.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "joynr/Runnable.h"
+
+namespace joynr
+{
+
+WorkStealingQueue::WorkStealingQueue(std::uint8_t numberOfWorkers)
+        : workerDeques(),
+          nextWorkerDeque(0),
+          pendingTasks(0),
+          idleWorkers(0),
+          stoppingQueue(false),
+          idleCondition(),
+          idleMutex()
+{
+    const std::size_t numberOfDeques = std::max<std::size_t>(numberOfWorkers, 1);
+    workerDeques.reserve(numberOfDeques);
+    for (std::size_t i = 0; i < numberOfDeques; ++i) {
+        workerDeques.push_back(std::make_unique<WorkerDeque>());
+    }
+}
+
+WorkStealingQueue::~WorkStealingQueue()
+{
+    shutdown();
+}
+
+void WorkStealingQueue::add(std::shared_ptr<Runnable> task)
+{
+    WorkerDeque& workerDeque = *workerDeques[nextWorkerDeque++ % workerDeques.size()];
+    {
+        std::lock_guard<std::mutex> lock(workerDeque.mutex);
+        workerDeque.queue.push_back(std::move(task));
+        ++workerDeque.size;
+        ++pendingTasks;
+    }
+
+    // Only touch the shared mutex if a worker is actually waiting.
+    // A worker increments idleWorkers before it checks pendingTasks,
+    // hence either the worker sees the new task or we see the waiting worker.
+    if (idleWorkers > 0) {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        idleCondition.notify_one();
+    }
+}
+
+std::shared_ptr<Runnable> WorkStealingQueue::tryTake(std::size_t workerIndex)
+{
+    const std::size_t numberOfDeques = workerDeques.size();
+    // start with own deque, then try to steal from the others
+    for (std::size_t i = 0; i < numberOfDeques; ++i) {
+        WorkerDeque& workerDeque = *workerDeques[(workerIndex + i) % numberOfDeques];
+        if (workerDeque.size == 0) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(workerDeque.mutex);
+        if (!workerDeque.queue.empty()) {
+            std::shared_ptr<Runnable> task = std::move(workerDeque.queue.front());
+            workerDeque.queue.pop_front();
+            --workerDeque.size;
+            --pendingTasks;
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+std::shared_ptr<Runnable> WorkStealingQueue::take(std::size_t workerIndex)
+{
+    assert(workerIndex < workerDeques.size());
+
+    while (!stoppingQueue) {
+        if (std::shared_ptr<Runnable> task = tryTake(workerIndex)) {
+            return task;
+        }
+
+        std::unique_lock<std::mutex> lock(idleMutex);
+        ++idleWorkers;
+        JOYNR_LOG_TRACE(logger(), "Wait for condition (queuelen={})", pendingTasks.load());
+        idleCondition.wait(lock, [this] { return (stoppingQueue || pendingTasks > 0); });
+        --idleWorkers;
+    }
+
+    JOYNR_LOG_TRACE(logger(), "Shutting down and returning NULL");
+    return nullptr;
+}
+
+std::size_t WorkStealingQueue::getQueueLength() const
+{
+    return pendingTasks;
+}
+
+void WorkStealingQueue::shutdown()
+{
+    JOYNR_LOG_TRACE(logger(), "Shutdown called");
+    {
+        std::lock_guard<std::mutex> lock(idleMutex);
+        stoppingQueue = true;
+    }
+
+    for (auto& workerDeque : workerDeques) {
+        std::lock_guard<std::mutex> lock(workerDeque->mutex);
+        pendingTasks -= workerDeque->queue.size();
+        workerDeque->queue.clear();
+        workerDeque->size = 0;
+    }
+
+    // unblock waiting threads
+    JOYNR_LOG_TRACE(logger(), "Shutdown, notifying all.");
+    idleCondition.notify_all();
+}
+
+} // namespace joynr
@@ -61,4 +61,13 @@ void OneWayRequest::setParamDatatypes(std::vector<std::string>&& paramDatatypes)
     this->paramDatatypes = std::move(paramDatatypes);
 }
 
+void OneWayRequest::shareContentOf(const OneWayRequest& other)
+{
+    methodName = other.methodName;
+    paramDatatypes = other.paramDatatypes;
+    if (other.params.containsOutboundData()) {
+        params = other.params.shareOutboundData();
+    }
+}
+
 } // namespace joynr
@@ -46,4 +46,12 @@ void Request::setRequestReplyId(const std::string& requestReplyId)
     this->requestReplyId = requestReplyId;
 }
 
+Request Request::createInProcessCopy() const
+{
+    Request copy;
+    copy.shareContentOf(*this);
+    copy.requestReplyId = requestReplyId;
+    return copy;
+}
+
 } // namespace joynr
@@ -35,10 +35,11 @@
 #include "joynr/ObjectWithDecayTime.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/RoutingTable.h"
+#include "joynr/RoutingTableJournal.h"
 #include "joynr/ReadWriteLock.h"
 #include "joynr/Runnable.h"
+#include "joynr/ShardedThreadPoolDelayedScheduler.h"
 #include "joynr/SteadyTimer.h"
-#include "joynr/ThreadPoolDelayedScheduler.h"
 #include "joynr/system/RoutingTypes/Address.h"
 
 namespace boost
@@ -88,6 +89,8 @@ public:
     void saveRoutingTable();
     void loadRoutingTable(std::string fileName);
     std::uint64_t getNumberOfRoutedMessages() const;
+    std::vector<ShardedThreadPoolDelayedScheduler::ShardStatistics> getMessageSchedulerStatistics()
+            const;
 
     void route(std::shared_ptr<ImmutableMessage> message, std::uint32_t tryCount = 0) final;
     virtual void shutdown();
@@ -147,6 +150,8 @@ protected:
 
     void sendMessages(std::shared_ptr<const joynr::system::RoutingTypes::Address> address) final;
 
+    void removeFromRoutingTable(const std::string& participantId);
+
     void addToRoutingTable(std::string participantId,
                            bool isGloballyVisible,
                            std::shared_ptr<const joynr::system::RoutingTypes::Address> address,
@@ -176,7 +181,7 @@ protected:
     MessagingSettings messagingSettings;
     bool persistRoutingTable;
     std::shared_ptr<IMessagingStubFactory> messagingStubFactory;
-    std::shared_ptr<ThreadPoolDelayedScheduler> messageScheduler;
+    std::shared_ptr<ShardedThreadPoolDelayedScheduler> messageScheduler;
     std::unique_ptr<MessageQueue<std::string>> messageQueue;
     // MessageQueue ReadLocker is required to protect calls to queueMessage and
     // getDestinationAddresses:
@@ -189,6 +194,7 @@ protected:
     std::unique_ptr<MessageQueue<std::shared_ptr<ITransportStatus>>> transportNotAvailableQueue;
     std::mutex transportAvailabilityMutex;
     std::string routingTableFileName;
+    std::unique_ptr<RoutingTableJournal> routingTableJournal;
     std::unique_ptr<IMulticastAddressCalculator> addressCalculator;
     SteadyTimer messageQueueCleanerTimer;
     const std::chrono::milliseconds messageQueueCleanerTimerPeriodMs;
@@ -200,6 +206,7 @@ private:
     ADD_LOGGER(AbstractMessageRouter)
 
     void checkExpiryDate(const ImmutableMessage& message);
+    void logMessageSchedulerStatistics() const;
     AddressUnorderedSet lookupAddresses(const std::unordered_set<std::string>& participantIds);
     std::atomic<bool> isShuttingDown;
     std::atomic<std::uint64_t> numberOfRoutedMessages;
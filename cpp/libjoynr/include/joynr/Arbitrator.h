@@ -20,28 +20,38 @@
 #ifndef ARBITRATOR_H
 #define ARBITRATOR_H
 
-#include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
-#include <thread>
 #include <unordered_set>
 #include <vector>
 
-#include <boost/variant.hpp>
-
 #include "joynr/ArbitrationStrategyFunction.h"
 #include "joynr/DiscoveryQos.h"
-#include "joynr/Future.h"
 #include "joynr/JoynrExport.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
-#include "joynr/Semaphore.h"
+#include "joynr/SteadyTimer.h"
 #include "joynr/exceptions/JoynrException.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
 #include "joynr/types/DiscoveryQos.h"
 #include "joynr/types/Version.h"
 
+namespace boost
+{
+namespace asio
+{
+class io_service;
+} // namespace asio
+namespace system
+{
+class error_code;
+} // namespace system
+} // namespace boost
+
 namespace joynr
 {
 
@@ -52,6 +62,10 @@ class IDiscoveryAsync;
 
 /*
  *  Base class for different arbitration strategies.
+ *
+ *  The arbitration does not occupy a thread: each attempt is completed by the result of an
+ *  asynchronous lookup and retries as well as the discovery timeout are driven by timers on
+ *  the given io_service. The callbacks are invoked by the thread completing the arbitration.
  */
 class JOYNR_EXPORT Arbitrator : public std::enable_shared_from_this<Arbitrator>
 {
@@ -70,7 +84,8 @@ public:
                const joynr::types::Version& interfaceVersion,
                std::weak_ptr<joynr::system::IDiscoveryAsync> discoveryProxy,
                const DiscoveryQos& discoveryQos,
-               std::unique_ptr<const ArbitrationStrategyFunction> arbitrationStrategyFunction);
+               std::unique_ptr<const ArbitrationStrategyFunction> arbitrationStrategyFunction,
+               boost::asio::io_service& ioService);
 
     /*
      *  Arbitrate until successful or until a timeout occurs
@@ -80,33 +95,31 @@ public:
                     onSuccess,
             std::function<void(const exceptions::DiscoveryException& exception)> onError);
 
+    /*
+     *  Stops a running arbitration and reports it as failed. No callback is invoked
+     *  after this method returns.
+     */
     void stopArbitration();
 
 private:
     /*
-     *  attemptArbitration() has to be implemented by the concrete arbitration strategy.
-     *  This method attempts arbitration and sets arbitrationStatus to indicate the
-     *  state of arbitration.
+     *  attemptArbitration() starts a lookup at the discovery. The lookup result is passed
+     *  to onLookupSucceeded or onLookupFailed, which decide whether arbitration has finished
+     *  or another attempt is scheduled.
      */
     virtual void attemptArbitration();
 
     virtual void receiveCapabilitiesLookupResults(
             const std::vector<joynr::types::DiscoveryEntryWithMetaInfo>& discoveryEntries);
 
-    std::int64_t getDurationMs() const;
-
-    /*
-     * Check that the pending future has completed successfully and reset it.
-     */
-    void validatePendingFuture();
-
-    void assertNoPendingFuture();
+    void onLookupSucceeded(
+            const std::vector<joynr::types::DiscoveryEntryWithMetaInfo>& discoveryEntries);
+    void onLookupFailed(const exceptions::JoynrException& error);
+    void onDiscoveryTimeout(const boost::system::error_code& errorCode);
+    void scheduleAttempt(std::chrono::milliseconds delay);
+    void scheduleRetry();
 
-    std::mutex pendingFutureMutex;
-    boost::variant<
-            std::shared_ptr<joynr::Future<joynr::types::DiscoveryEntryWithMetaInfo>>,
-            std::shared_ptr<joynr::Future<std::vector<joynr::types::DiscoveryEntryWithMetaInfo>>>>
-            pendingFuture;
+    std::int64_t getDurationMs() const;
 
     std::weak_ptr<joynr::system::IDiscoveryAsync> discoveryProxy;
     DiscoveryQos discoveryQos;
@@ -122,11 +135,15 @@ private:
     std::function<void(const exceptions::DiscoveryException& exception)> onErrorCallback;
 
     DISALLOW_COPY_AND_ASSIGN(Arbitrator);
-    Semaphore semaphore;
+    // guards the arbitration state, the timers and the results of the last attempt
+    std::mutex arbitrationMutex;
+    // held while a final callback is invoked
+    std::mutex callbackMutex;
+    SteadyTimer retryTimer;
+    SteadyTimer discoveryTimeoutTimer;
+    joynr::types::DiscoveryEntryWithMetaInfo selectedDiscoveryEntry;
     bool arbitrationFinished;
-    std::atomic<bool> arbitrationRunning;
-    std::atomic<bool> keepArbitrationRunning;
-    std::thread arbitrationThread;
+    bool arbitrationRunning;
     std::chrono::system_clock::time_point startTimePoint;
     ADD_LOGGER(Arbitrator)
 };
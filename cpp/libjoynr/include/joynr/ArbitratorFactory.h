@@ -25,6 +25,14 @@
 #include "joynr/Arbitrator.h"
 #include "joynr/JoynrExport.h"
 
+namespace boost
+{
+namespace asio
+{
+class io_service;
+} // namespace asio
+} // namespace boost
+
 namespace joynr
 {
 
@@ -45,7 +53,8 @@ public:
             const std::string& interfaceName,
             const types::Version& interfaceVersion,
             std::weak_ptr<joynr::system::IDiscoveryAsync> discoveryProxy,
-            const DiscoveryQos& discoveryQos);
+            const DiscoveryQos& discoveryQos,
+            boost::asio::io_service& ioService);
 };
 
 } // namespace joynr
@@ -19,18 +19,12 @@
 #ifndef DELAYEDRUNNABLE_H
 #define DELAYEDRUNNABLE_H
 
+#include <chrono>
 #include <functional>
+#include <memory>
 
 #include "joynr/Runnable.h"
-#include "joynr/SteadyTimer.h"
-
-namespace boost
-{
-namespace asio
-{
-class io_service;
-} // namespace asio
-} // namespace boost
+#include "joynr/TimerWheel.h"
 
 namespace joynr
 {
@@ -39,18 +33,18 @@ class DelayedRunnable
 {
 public:
     DelayedRunnable(std::shared_ptr<Runnable> delayedRunnable,
-                    boost::asio::io_service& ioService,
+                    std::shared_ptr<TimerWheel> timerWheel,
                     std::chrono::milliseconds delayMs,
-                    std::function<void(const boost::system::error_code&)>&& timerExpiredCallback)
-            : timer(ioService), runnable(std::move(delayedRunnable))
+                    std::function<void()>&& timerExpiredCallback)
+            : timerWheel(std::move(timerWheel)),
+              timerId(this->timerWheel->schedule(delayMs, std::move(timerExpiredCallback))),
+              runnable(std::move(delayedRunnable))
     {
-        timer.expiresFromNow(delayMs);
-        timer.asyncWait(std::move(timerExpiredCallback));
     }
 
     ~DelayedRunnable()
     {
-        timer.cancel();
+        timerWheel->cancel(timerId);
     }
 
     std::shared_ptr<Runnable> takeRunnable()
@@ -59,7 +53,8 @@ public:
     }
 
 private:
-    SteadyTimer timer;
+    std::shared_ptr<TimerWheel> timerWheel;
+    TimerWheel::TimerId timerId;
     std::shared_ptr<Runnable> runnable;
 };
 
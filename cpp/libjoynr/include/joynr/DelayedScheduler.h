@@ -31,6 +31,7 @@
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/Runnable.h"
+#include "joynr/TimerWheel.h"
 
 namespace boost
 {
@@ -45,7 +46,7 @@ namespace joynr
 
 /**
  * @class DelayedScheduler
- * @brief Using a @ref Timer and @ref BlockingQueue to execute a runnable delayed
+ * @brief Using the @ref TimerWheel of an io_service to execute a runnable delayed
  */
 class JOYNR_EXPORT DelayedScheduler : public std::enable_shared_from_this<DelayedScheduler>
 {
@@ -138,8 +139,8 @@ private:
     /*! Next runnable handle which will be returned by ::schedule */
     RunnableHandle nextRunnableHandle;
 
-    /*! Used for async timers. */
-    boost::asio::io_service& ioService;
+    /*! Timer wheel shared by all schedulers using the same io_service */
+    std::shared_ptr<TimerWheel> timerWheel;
 };
 
 } // namespace joynr
@@ -26,14 +26,12 @@
 #include <string>
 #include <unordered_map>
 
-#include <boost/asio/error.hpp>
-
 #include "joynr/IReplyCaller.h"
 #include "joynr/ITimeoutListener.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/Runnable.h"
-#include "joynr/SteadyTimer.h"
+#include "joynr/TimerWheel.h"
 #include "joynr/serializer/Serializer.h"
 
 namespace boost
@@ -74,7 +72,7 @@ public:
             : callbackMap(),
               timeoutTimerMap(),
               mutex(),
-              ioService(ioService),
+              timerWheel(TimerWheel::getInstance(ioService)),
               saveFilterFunction(std::move(fun)),
               isShutdown(false)
     {
@@ -85,7 +83,7 @@ public:
             : callbackMap(),
               timeoutTimerMap(),
               mutex(),
-              ioService(ioService),
+              timerWheel(TimerWheel::getInstance(ioService)),
               saveFilterFunction(),
               isShutdown(false)
     {
@@ -95,6 +93,8 @@ public:
     ~Directory()
     {
         JOYNR_LOG_TRACE(logger(), "destructor: number of entries = {}", callbackMap.size());
+        std::lock_guard<std::mutex> lock(mutex);
+        cancelTimeouts();
     }
 
     /*
@@ -159,31 +159,21 @@ public:
                 return;
             }
 
-            // An existing entry shall be overwritten by the new entry.
-            // When we use unordered_map::emplace, we must remove the
-            // existing entry first.
+            // An existing entry shall be overwritten by the new entry,
+            // hence its timeout must not remove the new entry.
             auto existingTimerIt = timeoutTimerMap.find(keyId);
             if (existingTimerIt != timeoutTimerMap.end()) {
-                timeoutTimerMap.erase(existingTimerIt);
+                timerWheel->cancel(existingTimerIt->second);
             }
 
-            auto insertionResult = timeoutTimerMap.emplace(std::piecewise_construct,
-                                                           std::forward_as_tuple(keyId),
-                                                           std::forward_as_tuple(ioService));
-
-            assert(insertionResult.second); // Success indication
-            auto timerIt = insertionResult.first;
-
-            timerIt->second.expiresFromNow(std::chrono::milliseconds(ttl_ms));
-            timerIt->second.asyncWait([keyId, this](const boost::system::error_code& errorCode) {
-                if (!errorCode) {
-                    this->removeAfterTimeout<T>(keyId);
-                } else if (errorCode != boost::asio::error::operation_aborted) {
-                    JOYNR_LOG_TRACE(this->logger(),
-                                    "Timer removal of entry from directory failed : {}",
-                                    errorCode.message());
-                }
-            });
+            timeoutTimerMap[keyId] =
+                    timerWheel->schedule(std::chrono::milliseconds(ttl_ms), [keyId, this]() {
+                        {
+                            std::lock_guard<std::mutex> lock(this->mutex);
+                            this->timeoutTimerMap.erase(keyId);
+                        }
+                        this->removeAfterTimeout<T>(keyId);
+                    });
 
             callbackMap[keyId] = std::move(value);
         }
@@ -197,14 +187,18 @@ public:
         std::lock_guard<std::mutex> lock(mutex);
 
         callbackMap.erase(keyId);
-        timeoutTimerMap.erase(keyId);
+        auto timerIt = timeoutTimerMap.find(keyId);
+        if (timerIt != timeoutTimerMap.end()) {
+            timerWheel->cancel(timerIt->second);
+            timeoutTimerMap.erase(timerIt);
+        }
     }
 
     void shutdown()
     {
         std::lock_guard<std::mutex> lock(mutex);
         isShutdown = true;
-        timeoutTimerMap.clear();
+        cancelTimeouts();
     }
 
     template <typename Archive>
@@ -224,6 +218,17 @@ public:
     }
 
 private:
+    void cancelTimeouts()
+    {
+        if (!timerWheel) {
+            return;
+        }
+        for (const auto& timeout : timeoutTimerMap) {
+            timerWheel->cancel(timeout.second);
+        }
+        timeoutTimerMap.clear();
+    }
+
     template <typename Archive>
     void saveImplNonFiltered(Archive& archive)
     {
@@ -260,13 +265,13 @@ private:
 
 protected:
     std::unordered_map<Key, std::shared_ptr<T>> callbackMap;
-    std::unordered_map<Key, SteadyTimer> timeoutTimerMap;
+    std::unordered_map<Key, TimerWheel::TimerId> timeoutTimerMap;
     ADD_LOGGER(Directory)
 
 private:
     DISALLOW_COPY_AND_ASSIGN(Directory);
     std::mutex mutex;
-    boost::asio::io_service& ioService;
+    std::shared_ptr<TimerWheel> timerWheel;
     SaveFilterFunction saveFilterFunction;
     bool isShutdown;
 };
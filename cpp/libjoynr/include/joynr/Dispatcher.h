@@ -42,8 +42,12 @@ namespace joynr
 
 class ImmutableMessage;
 class IReplyCaller;
+class IRequestInterpreter;
 class MessagingQos;
+class Reply;
+class Request;
 class RequestCaller;
+class TimePoint;
 class IMessageSender;
 class ThreadPool;
 
@@ -68,6 +72,12 @@ public:
 
     void receive(std::shared_ptr<ImmutableMessage> message) override;
 
+    bool deliverRequestInProcess(const std::string& senderParticipantId,
+                                 const std::string& receiverParticipantId,
+                                 const MessagingQos& qos,
+                                 const Request& request,
+                                 std::shared_ptr<IReplyCaller> replyCaller) override;
+
     void registerSubscriptionManager(
             std::shared_ptr<ISubscriptionManager> subscriptionManager) override;
 
@@ -86,6 +96,11 @@ private:
     void handleSubscriptionStopReceived(std::shared_ptr<ImmutableMessage> message);
     void handleSubscriptionReplyReceived(std::shared_ptr<ImmutableMessage> message);
     void handleMulticastSubscriptionRequestReceived(std::shared_ptr<ImmutableMessage> message);
+    void handleInProcessRequest(std::shared_ptr<RequestCaller> caller,
+                                std::shared_ptr<IRequestInterpreter> requestInterpreter,
+                                Request& request,
+                                const TimePoint& requestExpiryDate);
+    void handleInProcessReply(Reply&& reply);
 
 private:
     DISALLOW_COPY_AND_ASSIGN(Dispatcher);
@@ -101,6 +116,8 @@ private:
     ReadWriteLock isShuttingDownLock;
 
     friend class ReceivedMessageRunnable;
+    friend class InProcessRequestRunnable;
+    friend class InProcessReplyRunnable;
 };
 
 } // namespace joynr
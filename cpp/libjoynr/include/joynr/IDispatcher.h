@@ -30,6 +30,7 @@ class ISubscriptionManager;
 class PublicationManager;
 class IReplyCaller;
 class MessagingQos;
+class Request;
 class RequestCaller;
 
 class IDispatcher
@@ -45,6 +46,19 @@ public:
     virtual void removeRequestCaller(const std::string& participantId) = 0;
     virtual void receive(std::shared_ptr<ImmutableMessage> message) = 0;
 
+    /**
+     * @brief Hands a request to a provider which is registered with this dispatcher
+     * without creating a message, i.e. without serializing the request.
+     * The reply is delivered to replyCaller like a reply received as message.
+     * @return false if no provider is registered for receiverParticipantId; the request
+     *      has then to be sent as message and replyCaller has not been registered
+     */
+    virtual bool deliverRequestInProcess(const std::string& senderParticipantId,
+                                         const std::string& receiverParticipantId,
+                                         const MessagingQos& qos,
+                                         const Request& request,
+                                         std::shared_ptr<IReplyCaller> replyCaller) = 0;
+
     virtual void registerSubscriptionManager(
             std::shared_ptr<ISubscriptionManager> subscriptionManager) = 0;
     virtual void registerPublicationManager(
@@ -0,0 +1,66 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef IMESSAGEQUEUEOVERFLOWSTORE_H
+#define IMESSAGEQUEUEOVERFLOWSTORE_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace joynr
+{
+
+class ImmutableMessage;
+
+/**
+ * @brief Secondary storage a @ref MessageQueue moves messages to when its
+ * in-memory byte limit is reached, instead of discarding them.
+ */
+template <typename T>
+class IMessageQueueOverflowStore
+{
+public:
+    virtual ~IMessageQueueOverflowStore() = default;
+
+    /**
+     * @brief Stores a message for the given key.
+     * @return false if the message could not be stored, e.g. because the store is full
+     */
+    virtual bool store(const T& key, const std::shared_ptr<ImmutableMessage>& message) = 0;
+
+    /**
+     * @brief Removes all messages stored for the given key.
+     * @return the messages ordered by their expiry date, empty if there are none
+     */
+    virtual std::vector<std::shared_ptr<ImmutableMessage>> takeAllFor(const T& key) = 0;
+
+    /**
+     * @brief Removes all messages whose expiry date has passed.
+     */
+    virtual void removeOutdatedMessages() = 0;
+
+    /**
+     * @return the number of messages currently stored
+     */
+    virtual std::size_t getNumberOfMessages() const = 0;
+};
+
+} // namespace joynr
+
+#endif // IMESSAGEQUEUEOVERFLOWSTORE_H
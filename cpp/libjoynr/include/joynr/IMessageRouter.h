@@ -84,6 +84,13 @@ public:
 
     virtual void sendMessages(
             std::shared_ptr<const joynr::system::RoutingTypes::Address> address) = 0;
+
+    /**
+     * @brief Checks whether requests may be handed to providers of the same runtime
+     * without being routed as message, i.e. the router does not have to apply any
+     * checks (such as access control) to them.
+     */
+    virtual bool isInProcessShortCircuitAllowed() const = 0;
 };
 
 } // namespace joynr
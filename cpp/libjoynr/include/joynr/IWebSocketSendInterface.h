@@ -20,6 +20,7 @@
 #define IWEBSOCKETSENDINTERFACE_H
 
 #include <functional>
+#include <memory>
 #include <string>
 
 #include <smrf/ByteArrayView.h>
@@ -29,6 +30,8 @@
 namespace joynr
 {
 
+class ImmutableMessage;
+
 namespace exceptions
 {
 class JoynrRuntimeException;
@@ -54,6 +57,16 @@ public:
             const smrf::ByteArrayView& message,
             const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) = 0;
 
+    /**
+     * @brief Send a joynr message asynchronously via WebSocket
+     * Implementations may cache the WebSocket frame in the message, so that a message which is
+     * delivered to several connections (e.g. a multicast) is framed only once.
+     * @param message Message to be sent
+     */
+    virtual void send(
+            std::shared_ptr<ImmutableMessage> message,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) = 0;
+
     /**
      * @brief Returns whether the socket is initialized or not
      * @return Initialization flag
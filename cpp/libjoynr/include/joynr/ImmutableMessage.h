@@ -20,24 +20,31 @@
 #ifndef IMMUTABLEMESSAGE_H
 #define IMMUTABLEMESSAGE_H
 
+#include <memory>
 #include <string>
 #include <stdexcept>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
 
 #include <boost/optional.hpp>
 #include <smrf/ByteVector.h>
 #include <smrf/MessageDeserializer.h>
 
 #include "joynr/Logger.h"
+#include "joynr/Message.h"
+#include "joynr/ParticipantIdTable.h"
 #include "joynr/TimePoint.h"
 #include "serializer/Serializer.h"
 
 namespace joynr
 {
 
+// points into the header map of the message, hence no copies of the values are required
 struct RequiredHeaders
 {
-    std::string id;
-    std::string type;
+    const std::string* id = nullptr;
+    const std::string* type = nullptr;
     static constexpr std::size_t NUM_REQUIRED_HEADERS = 2;
 };
 
@@ -53,9 +60,17 @@ public:
 
     ~ImmutableMessage() = default;
 
-    std::string getSender() const;
+    const std::string& getSender() const;
 
-    std::string getRecipient() const;
+    const std::string& getRecipient() const;
+
+    /**
+     * @return the handle of the recipient in ParticipantIdTable::getInstance() as resolved
+     * when the message was created; ParticipantIdTable::INVALID_HANDLE if the recipient was
+     * not interned at that time or the message is a multicast. The handle does not keep the
+     * recipient interned, it no longer matches once the recipient has been released.
+     */
+    ParticipantIdTable::Handle getRecipientHandle() const;
 
     bool isTtlAbsolute() const;
 
@@ -75,12 +90,23 @@ public:
 
     const std::string& getType() const;
 
+    /**
+     * @return the type of the message, decoded once from the type header
+     */
+    MessageType getMessageType() const;
+
     const std::string& getId() const;
 
     boost::optional<std::string> getReplyTo() const;
 
     boost::optional<std::string> getEffort() const;
 
+    /**
+     * @return the id of the serializer used for the payload, not initialized for JSON payloads
+     * @see Message::HEADER_SERIALIZER()
+     */
+    boost::optional<std::string> getSerializer() const;
+
     TimePoint getExpiryDate() const;
 
     const smrf::ByteVector& getSerializedMessage() const;
@@ -114,11 +140,35 @@ public:
 
     std::string getTrackingInfo() const;
 
+    /**
+     * @brief Returns the transport frame of type Frame prepared for this message, creating it
+     * with frameFactory on first use. Transports use this to frame a message once and to share
+     * the frame between all connections a multicast is delivered to.
+     * @param frameFactory called with the serialized message if no frame of type Frame exists
+     * yet; it may be called concurrently, but only one of the created frames is kept
+     * @return the frame shared by all callers
+     */
+    template <typename Frame, typename FrameFactory>
+    std::shared_ptr<Frame> getOrCreateTransportFrame(FrameFactory frameFactory) const
+    {
+        std::shared_ptr<const TransportFrame> cached = std::atomic_load(&transportFrame);
+        if (cached && cached->type == std::type_index(typeid(Frame))) {
+            return std::static_pointer_cast<Frame>(cached->frame);
+        }
+        std::shared_ptr<Frame> frame = frameFactory(serializedMessage);
+        auto created =
+                std::make_shared<const TransportFrame>(std::type_index(typeid(Frame)), frame);
+        if (!cached && !std::atomic_compare_exchange_strong(&transportFrame, &cached, created) &&
+            cached->type == std::type_index(typeid(Frame))) {
+            // another thread was faster, use its frame so that only one copy exists
+            return std::static_pointer_cast<Frame>(cached->frame);
+        }
+        return frame;
+    }
+
     template <typename Archive>
     void save(Archive& archive)
     {
-        const auto& recipient = getRecipient();
-        const auto& sender = getSender();
         const auto expiryDate = messageDeserializer.getTtlMs();
         smrf::ByteArrayView body = getUnencryptedBody();
         const std::string payload(body.data(), body.data() + body.size());
@@ -133,15 +183,34 @@ public:
 
 private:
     boost::optional<std::string> getOptionalHeaderByKey(const std::string& key) const;
+    const std::string* findHeader(const std::string& key) const;
+
+    // a frame prepared by a transport, the type allows to tell frames of different transports
+    // apart; only the first transport framing the message keeps its frame cached
+    struct TransportFrame
+    {
+        TransportFrame(std::type_index type, std::shared_ptr<void> frame)
+                : type(type), frame(std::move(frame))
+        {
+        }
+        const std::type_index type;
+        const std::shared_ptr<void> frame;
+    };
 
     void init();
     bool isCustomHeaderKey(const std::string& key) const;
 
     smrf::ByteVector serializedMessage;
     smrf::MessageDeserializer messageDeserializer;
+    // sender and recipient are decoded once since they are queried repeatedly while routing
+    std::string sender;
+    std::string recipient;
+    ParticipantIdTable::Handle recipientHandle;
     std::unordered_map<std::string, std::string> headers;
     mutable boost::optional<smrf::ByteArrayView> bodyView;
     mutable boost::optional<smrf::ByteVector> decompressedBody;
+    // accessed with the atomic shared_ptr functions only
+    mutable std::shared_ptr<const TransportFrame> transportFrame;
 
     // receivedFromGlobal is a transient attribute which will not be serialized.
     // It is only used locally for routing decisions.
@@ -149,6 +218,7 @@ private:
 
     std::string creator;
     RequiredHeaders requiredHeaders;
+    MessageType messageType;
     ADD_LOGGER(ImmutableMessage)
 };
 
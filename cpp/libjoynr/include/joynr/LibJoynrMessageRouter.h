@@ -126,6 +126,8 @@ public:
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
 
+    bool isInProcessShortCircuitAllowed() const final;
+
     void setParentAddress(
             std::string parentParticipantId,
             std::shared_ptr<const joynr::system::RoutingTypes::Address> parentAddress);
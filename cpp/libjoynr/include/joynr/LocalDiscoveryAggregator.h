@@ -20,6 +20,7 @@
 #define LOCALDISCOVERYAGGREGATOR_H
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -43,6 +44,16 @@ class DiscoveryQos;
  * of provisioned discovery entries (for example for the discovery and routing provider). If a
  * lookup is performed by using a participant ID, these entries are checked and returned first
  * before the request is forwarded to the wrapped discovery provider.
+ *
+ * Lookups by domain and interface are cached for the cacheMaxAge of their DiscoveryQos, and
+ * concurrent lookups with the same parameters share one request to the discovery provider. Cached
+ * results are invalidated when a provider of the interface is added or removed via this
+ * aggregator, both when the request is sent and when it has been completed.
+ *
+ * Providers registered by other runtimes at the same cluster controller are not seen by this
+ * cache. Therefore lookups with DiscoveryScope::LOCAL_ONLY and results containing local providers
+ * are never cached; only results consisting of global providers, which the cluster controller
+ * caches for cacheMaxAge anyway, are.
  */
 class JOYNR_EXPORT LocalDiscoveryAggregator : public joynr::system::IDiscoveryAsync
 {
@@ -101,9 +112,20 @@ public:
 private:
     DISALLOW_COPY_AND_ASSIGN(LocalDiscoveryAggregator);
 
+    // shared with the callbacks of pending lookups which may outlive the aggregator
+    struct LookupCache;
+
+    // wraps the callback of an add or remove request so that the cache is invalidated again
+    // once the request has been completed
+    template <typename Key, typename... Args>
+    std::function<void(Args...)> invalidateOnCompletion(
+            const Key& key,
+            std::function<void(Args...)> callback) const;
+
     std::shared_ptr<joynr::system::IDiscoveryAsync> discoveryProxy;
     const std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo>
             provisionedDiscoveryEntries;
+    std::shared_ptr<LookupCache> lookupCache;
 };
 } // namespace joynr
 #endif // LOCALDISCOVERYAGGREGATOR_H
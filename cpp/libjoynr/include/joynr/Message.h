@@ -20,11 +20,29 @@
 #ifndef MESSAGE_H
 #define MESSAGE_H
 
+#include <cstdint>
 #include <string>
 
 namespace joynr
 {
 
+/**
+ * @brief Decoded value of the message type header, see Message::VALUE_MESSAGE_TYPE_*()
+ */
+enum class MessageType : std::uint8_t {
+    ONE_WAY,
+    REPLY,
+    REQUEST,
+    PUBLICATION,
+    MULTICAST,
+    SUBSCRIPTION_REPLY,
+    SUBSCRIPTION_REQUEST,
+    MULTICAST_SUBSCRIPTION_REQUEST,
+    BROADCAST_SUBSCRIPTION_REQUEST,
+    SUBSCRIPTION_STOP,
+    UNKNOWN
+};
+
 class Message
 {
 public:
@@ -66,6 +84,12 @@ public:
         return value;
     }
 
+    static const std::string& HEADER_SERIALIZER()
+    {
+        static const std::string value("se");
+        return value;
+    }
+
     static const std::string& CUSTOM_HEADER_REQUEST_REPLY_ID()
     {
         static const std::string value("z4");
@@ -129,6 +153,51 @@ public:
         static const std::string value("sst");
         return value;
     }
+
+    /**
+     * @return the MessageType for the given value of the type header or
+     * MessageType::UNKNOWN if the value is not a known message type
+     */
+    static MessageType toMessageType(const std::string& type)
+    {
+        // dispatch on the first character to compare against at most two type values
+        switch (type.size() == 0 ? '\0' : type[0]) {
+        case 'o':
+            return type == VALUE_MESSAGE_TYPE_ONE_WAY() ? MessageType::ONE_WAY
+                                                        : MessageType::UNKNOWN;
+        case 'r':
+            if (type == VALUE_MESSAGE_TYPE_REQUEST()) {
+                return MessageType::REQUEST;
+            }
+            return type == VALUE_MESSAGE_TYPE_REPLY() ? MessageType::REPLY : MessageType::UNKNOWN;
+        case 'p':
+            return type == VALUE_MESSAGE_TYPE_PUBLICATION() ? MessageType::PUBLICATION
+                                                            : MessageType::UNKNOWN;
+        case 'm':
+            if (type == VALUE_MESSAGE_TYPE_MULTICAST()) {
+                return MessageType::MULTICAST;
+            }
+            return type == VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST()
+                           ? MessageType::MULTICAST_SUBSCRIPTION_REQUEST
+                           : MessageType::UNKNOWN;
+        case 's':
+            if (type == VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()) {
+                return MessageType::SUBSCRIPTION_REPLY;
+            }
+            return type == VALUE_MESSAGE_TYPE_SUBSCRIPTION_STOP() ? MessageType::SUBSCRIPTION_STOP
+                                                                  : MessageType::UNKNOWN;
+        case 'a':
+            return type == VALUE_MESSAGE_TYPE_SUBSCRIPTION_REQUEST()
+                           ? MessageType::SUBSCRIPTION_REQUEST
+                           : MessageType::UNKNOWN;
+        case 'b':
+            return type == VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST()
+                           ? MessageType::BROADCAST_SUBSCRIPTION_REQUEST
+                           : MessageType::UNKNOWN;
+        default:
+            return MessageType::UNKNOWN;
+        }
+    }
 };
 
 } // namespace joynr
@@ -19,194 +19,326 @@
 #ifndef MESSAGEQUEUE_H
 #define MESSAGEQUEUE_H
 
-#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/composite_key.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <boost/intrusive/list.hpp>
+#include <boost/intrusive/set.hpp>
 
+#include "joynr/IMessageQueueOverflowStore.h"
+#include "joynr/ImmutableMessage.h"
 #include "joynr/JoynrExport.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
-#include "joynr/ImmutableMessage.h"
+#include "joynr/TimePoint.h"
 
 namespace joynr
 {
 
-namespace messagequeuetags
-{
-struct key;
-struct ttlAbsolute;
-struct key_and_ttlAbsolute;
-}
-
+/**
+ * @brief Queue holding messages per key (e.g. participant id or transport) until they
+ * can be delivered.
+ *
+ * Messages are kept in a FIFO list per key and additionally in a TTL index, so that
+ * expired messages and, when a limit is reached, the message with the lowest expiry
+ * date can be removed without scanning the whole queue. Keys are distributed over
+ * a fixed number of shards, each guarded by its own mutex, so that producers and
+ * consumers of different keys do not contend.
+ *
+ * When a message count or byte limit is configured, admission of new messages is
+ * serialized in order to keep these limits exact.
+ *
+ * If an overflow store is given, messages which do not fit into the byte limit are
+ * moved to the store instead of being discarded. @ref takeAllFor returns the messages
+ * of both tiers, @ref getNextMessageFor and the length and size getters only refer to
+ * the messages held in memory.
+ */
 template <typename T>
 class JOYNR_EXPORT MessageQueue
 {
 public:
     MessageQueue(std::uint64_t messageQueueLimit = 0,
                  std::uint64_t perKeyMessageQueueLimit = 0,
-                 std::uint64_t messageQueueLimitBytes = 0)
-            : queue(),
-              queueMutex(),
+                 std::uint64_t messageQueueLimitBytes = 0,
+                 std::shared_ptr<IMessageQueueOverflowStore<T>> overflowStore = nullptr)
+            : shards(),
+              admissionMutex(),
               messageQueueLimit(messageQueueLimit),
               messageQueueLimitBytes(messageQueueLimitBytes),
               perKeyMessageQueueLimit(perKeyMessageQueueLimit),
+              overflowStore(std::move(overflowStore)),
+              queueLength(0),
               queueSizeBytes(0)
     {
     }
 
+    ~MessageQueue()
+    {
+        for (Shard& shard : shards) {
+            shard.clear();
+        }
+    }
+
     std::size_t getQueueLength() const
     {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        return getQueueLengthUnlocked();
+        return queueLength;
     }
 
     std::size_t getQueueSizeBytes() const
     {
-        std::lock_guard<std::mutex> lock(queueMutex);
         return queueSizeBytes;
     }
 
-    void queueMessage(const T key, std::shared_ptr<ImmutableMessage> message)
+    void queueMessage(T key, std::shared_ptr<ImmutableMessage> message)
     {
+        const std::uint64_t messageSize = message->getMessageSize();
+        Shard& shard = getShard(key);
 
-        MessageQueueItem item;
-        item.key = std::move(key);
-        item.ttlAbsolute = message->getExpiryDate();
-        item.message = std::move(message);
+        std::unique_lock<std::mutex> admissionLock(admissionMutex, std::defer_lock);
+        if (messageQueueLimit > 0 || messageQueueLimitBytes > 0) {
+            admissionLock.lock();
+        }
 
-        std::lock_guard<std::mutex> lock(queueMutex);
-        ensureFreeQueueSlot(item.key);
-        if (!ensureFreeQueueBytes(item.message->getMessageSize())) {
+        ensureFreeQueueSlot(shard, key);
+        if (!ensureFreeQueueBytes(messageSize)) {
+            if (overflowStore && overflowStore->store(key, message)) {
+                return;
+            }
             JOYNR_LOG_WARN(logger(),
                            "queueMessage: messageSize exceeds messageQueueLimitBytes {}, "
                            "discarding message {}; queueSize(bytes) = {}, "
                            "#msgs = {}",
                            messageQueueLimitBytes,
-                           item.message->getTrackingInfo(),
-                           queueSizeBytes,
-                           getQueueLengthUnlocked());
+                           message->getTrackingInfo(),
+                           queueSizeBytes.load(),
+                           queueLength.load());
             return;
         }
-        queueSizeBytes += item.message->getMessageSize();
-        std::string trackingInfo = item.message->getTrackingInfo();
-        queue.insert(std::move(item));
-        JOYNR_LOG_TRACE(logger(),
-                        "queueMessage: message {}, new queueSize(bytes) = {}, #msgs = {}",
-                        trackingInfo,
-                        queueSizeBytes,
-                        getQueueLengthUnlocked());
+
+        auto entry = std::make_unique<Entry>(std::move(key), std::move(message), messageSize);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        JOYNR_LOG_TRACE(logger(), "queueMessage: message {}", entry->message->getId());
+        shard.insert(entry.release());
+        queueSizeBytes += messageSize;
+        ++queueLength;
     }
 
     std::shared_ptr<ImmutableMessage> getNextMessageFor(const T& key)
     {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        auto& keyIndex = boost::multi_index::get<messagequeuetags::key>(queue);
-
-        auto queueElement = keyIndex.find(key);
-        if (queueElement != keyIndex.cend()) {
-            auto message = std::move(queueElement->message);
-            queueSizeBytes -= message->getMessageSize();
-            queue.erase(queueElement);
-            JOYNR_LOG_TRACE(logger(),
-                            "getNextMessageFor: message {}, new "
-                            "queueSize(bytes) = {}, #msgs = {}",
-                            message->getTrackingInfo(),
-                            queueSizeBytes,
-                            getQueueLengthUnlocked());
-            return message;
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto keyQueue = shard.keyQueues.find(key);
+        if (keyQueue == shard.keyQueues.end()) {
+            return nullptr;
         }
-        return nullptr;
+        std::shared_ptr<ImmutableMessage> message = removeEntry(shard, keyQueue->second.front());
+        JOYNR_LOG_TRACE(logger(), "getNextMessageFor: message {}", message->getId());
+        return message;
+    }
+
+    /**
+     * @brief Removes all messages queued for the given key at once.
+     * @return the messages moved to the overflow store ordered by their expiry date,
+     * followed by the messages held in memory in the order they were queued;
+     * empty if there are none
+     */
+    std::vector<std::shared_ptr<ImmutableMessage>> takeAllFor(const T& key)
+    {
+        // Messages are only moved to the overflow store while the lock of their shard is
+        // held, hence every message is either found in memory or in the store afterwards.
+        std::vector<std::shared_ptr<ImmutableMessage>> messages = takeAllFromMemoryFor(key);
+        if (!overflowStore) {
+            return messages;
+        }
+        std::vector<std::shared_ptr<ImmutableMessage>> overflowMessages =
+                overflowStore->takeAllFor(key);
+        if (overflowMessages.empty()) {
+            return messages;
+        }
+        overflowMessages.insert(overflowMessages.end(),
+                                std::make_move_iterator(messages.begin()),
+                                std::make_move_iterator(messages.end()));
+        return overflowMessages;
     }
 
     void removeOutdatedMessages()
     {
-        std::lock_guard<std::mutex> lock(queueMutex);
-        int numberOfErasedMessages = 0;
-        std::size_t erasedBytes = 0;
+        if (overflowStore) {
+            overflowStore->removeOutdatedMessages();
+        }
+        removeOutdatedMessagesFromMemory();
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(MessageQueue);
+    ADD_LOGGER(MessageQueue);
+
+    std::vector<std::shared_ptr<ImmutableMessage>> takeAllFromMemoryFor(const T& key)
+    {
+        std::vector<std::shared_ptr<ImmutableMessage>> messages;
+        Shard& shard = getShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto keyQueue = shard.keyQueues.find(key);
+        if (keyQueue == shard.keyQueues.end()) {
+            return messages;
+        }
+
+        KeyQueue& entries = keyQueue->second;
+        messages.reserve(entries.size());
+        std::uint64_t takenBytes = 0;
+        entries.clear_and_dispose([&shard, &messages, &takenBytes](Entry* entry) {
+            shard.ttlIndex.erase(shard.ttlIndex.iterator_to(*entry));
+            takenBytes += entry->messageSize;
+            messages.push_back(std::move(entry->message));
+            delete entry;
+        });
+        shard.keyQueues.erase(keyQueue);
+        queueSizeBytes -= takenBytes;
+        queueLength -= messages.size();
+        JOYNR_LOG_TRACE(logger(), "takeAllFor: took {} messages", messages.size());
+        return messages;
+    }
 
-        if (queue.empty()) {
+    void removeOutdatedMessagesFromMemory()
+    {
+        if (queueLength == 0) {
             return;
         }
 
-        auto& ttlIndex = boost::multi_index::get<messagequeuetags::ttlAbsolute>(queue);
-        auto onePastOutdatedMsgIt = ttlIndex.lower_bound(TimePoint::now());
+        const TimePoint now = TimePoint::now();
+        int numberOfErasedMessages = 0;
+        std::size_t erasedBytes = 0;
 
-        for (auto it = ttlIndex.begin(); it != onePastOutdatedMsgIt; ++it) {
-            std::size_t msgSize = it->message->getMessageSize();
-            JOYNR_LOG_INFO(logger(),
-                           "removeOutdatedMessages: Erasing expired message {}",
-                           it->message->getTrackingInfo());
-            queueSizeBytes -= msgSize;
-            erasedBytes += msgSize;
-            numberOfErasedMessages++;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            while (!shard.ttlIndex.empty() && shard.ttlIndex.begin()->ttlAbsolute < now) {
+                Entry& entry = *shard.ttlIndex.begin();
+                JOYNR_LOG_INFO(logger(),
+                               "removeOutdatedMessages: Erasing expired message {}",
+                               entry.message->getTrackingInfo());
+                erasedBytes += entry.messageSize;
+                numberOfErasedMessages++;
+                removeEntry(shard, entry);
+            }
         }
-        ttlIndex.erase(ttlIndex.begin(), onePastOutdatedMsgIt);
+
         if (numberOfErasedMessages) {
             JOYNR_LOG_INFO(logger(),
                            "removeOutdatedMessages: Erased {} messages of size {}, new "
                            "queueSize(bytes) = {}, #msgs = {}",
                            numberOfErasedMessages,
                            erasedBytes,
-                           queueSizeBytes,
-                           getQueueLengthUnlocked());
+                           queueSizeBytes.load(),
+                           queueLength.load());
         }
     }
 
-protected:
-    DISALLOW_COPY_AND_ASSIGN(MessageQueue);
-    ADD_LOGGER(MessageQueue);
+    static constexpr std::size_t NUMBER_OF_SHARDS = 16;
 
-    struct MessageQueueItem
+    struct Entry : public boost::intrusive::list_base_hook<>,
+                   public boost::intrusive::set_base_hook<>
     {
+        Entry(T key, std::shared_ptr<ImmutableMessage> message, std::uint64_t messageSize)
+                : key(std::move(key)),
+                  ttlAbsolute(message->getExpiryDate()),
+                  messageSize(messageSize),
+                  message(std::move(message))
+        {
+        }
+
         T key;
         TimePoint ttlAbsolute;
+        std::uint64_t messageSize;
         std::shared_ptr<ImmutableMessage> message;
     };
 
-    using QueueMultiIndexContainer = boost::multi_index_container<
-            MessageQueueItem,
-            boost::multi_index::indexed_by<
-                    boost::multi_index::hashed_non_unique<
-                            boost::multi_index::tag<messagequeuetags::key>,
-                            BOOST_MULTI_INDEX_MEMBER(MessageQueueItem, T, key)>,
-                    boost::multi_index::ordered_non_unique<
-                            boost::multi_index::tag<messagequeuetags::ttlAbsolute>,
-                            BOOST_MULTI_INDEX_MEMBER(MessageQueueItem, TimePoint, ttlAbsolute)>,
-                    boost::multi_index::ordered_non_unique<
-                            boost::multi_index::tag<messagequeuetags::key_and_ttlAbsolute>,
-                            boost::multi_index::composite_key<
-                                    MessageQueueItem,
-                                    boost::multi_index::
-                                            member<MessageQueueItem, T, &MessageQueueItem::key>,
-                                    BOOST_MULTI_INDEX_MEMBER(MessageQueueItem,
-                                                             TimePoint,
-                                                             ttlAbsolute)>>>>;
-
-    QueueMultiIndexContainer queue;
-    mutable std::mutex queueMutex;
+    struct CompareTtl
+    {
+        bool operator()(const Entry& lhs, const Entry& rhs) const
+        {
+            return lhs.ttlAbsolute < rhs.ttlAbsolute;
+        }
+    };
 
-private:
+    using KeyQueue = boost::intrusive::list<Entry>;
+    // entries with equal ttl are kept in insertion order
+    using TtlIndex = boost::intrusive::multiset<Entry, boost::intrusive::compare<CompareTtl>>;
+
+    struct Shard
+    {
+        Shard() : mutex(), keyQueues(), ttlIndex()
+        {
+        }
+
+        void insert(Entry* entry)
+        {
+            // mutex must have been locked already
+            keyQueues[entry->key].push_back(*entry);
+            ttlIndex.insert(*entry);
+        }
+
+        void clear()
+        {
+            ttlIndex.clear();
+            for (auto& keyQueue : keyQueues) {
+                keyQueue.second.clear_and_dispose([](Entry* entry) { delete entry; });
+            }
+            keyQueues.clear();
+        }
+
+        std::mutex mutex;
+        std::unordered_map<T, KeyQueue> keyQueues;
+        TtlIndex ttlIndex;
+
+    private:
+        DISALLOW_COPY_AND_ASSIGN(Shard);
+    };
+
+    std::array<Shard, NUMBER_OF_SHARDS> shards;
+    // serializes admission of new messages while a limit is active
+    std::mutex admissionMutex;
     const std::uint64_t messageQueueLimit;
     const std::uint64_t messageQueueLimitBytes;
     const std::uint64_t perKeyMessageQueueLimit;
-    std::uint64_t queueSizeBytes;
+    const std::shared_ptr<IMessageQueueOverflowStore<T>> overflowStore;
+    std::atomic<std::uint64_t> queueLength;
+    std::atomic<std::uint64_t> queueSizeBytes;
 
-    std::size_t getQueueLengthUnlocked() const
+    Shard& getShard(const T& key)
     {
-        return boost::multi_index::get<messagequeuetags::key>(queue).size();
+        return shards[std::hash<T>()(key) % NUMBER_OF_SHARDS];
+    }
+
+    std::shared_ptr<ImmutableMessage> removeEntry(Shard& shard, Entry& entry)
+    {
+        // shard.mutex must have been locked already
+        auto keyQueue = shard.keyQueues.find(entry.key);
+        assert(keyQueue != shard.keyQueues.end());
+        keyQueue->second.erase(keyQueue->second.iterator_to(entry));
+        if (keyQueue->second.empty()) {
+            shard.keyQueues.erase(keyQueue);
+        }
+        shard.ttlIndex.erase(shard.ttlIndex.iterator_to(entry));
+
+        std::unique_ptr<Entry> removedEntry(&entry);
+        queueSizeBytes -= removedEntry->messageSize;
+        --queueLength;
+        return std::move(removedEntry->message);
     }
 
     bool ensureFreeQueueBytes(const std::uint64_t messageLength)
     {
-        // queueMutex must have been acquired earlier
+        // admissionMutex must have been acquired earlier
         const bool queueLimitBytesActive = messageQueueLimitBytes > 0;
         if (!queueLimitBytesActive) {
             return true;
@@ -216,15 +348,16 @@ private:
             return false;
         }
 
-        while (queueSizeBytes + messageLength > messageQueueLimitBytes) {
-            removeMessageWithLeastTtl();
+        const bool moveToOverflowStore = overflowStore != nullptr;
+        while (queueSizeBytes + messageLength > messageQueueLimitBytes &&
+               removeMessageWithLeastTtl(moveToOverflowStore)) {
         }
         return true;
     }
 
-    void ensureFreeQueueSlot(const T& key)
+    void ensureFreeQueueSlot(Shard& shard, const T& key)
     {
-        // queueMutex must have been acquired earlier
+        // admissionMutex must have been acquired earlier
         const bool queueLimitActive = messageQueueLimit > 0;
         if (!queueLimitActive) {
             return;
@@ -232,64 +365,79 @@ private:
 
         const bool perKeyQueueLimitActive = perKeyMessageQueueLimit > 0;
         if (perKeyQueueLimitActive) {
-            ensureFreePerKeyQueueSlot(key);
+            ensureFreePerKeyQueueSlot(shard, key);
         }
 
-        while (getQueueLengthUnlocked() >= messageQueueLimit) {
-            removeMessageWithLeastTtl();
+        while (queueLength >= messageQueueLimit && removeMessageWithLeastTtl(false)) {
         }
     }
 
-    void ensureFreePerKeyQueueSlot(const T& key)
+    void ensureFreePerKeyQueueSlot(Shard& shard, const T& key)
     {
-        // queueMutex must have been locked already
+        // admissionMutex must have been acquired earlier
         assert(perKeyMessageQueueLimit > 0);
 
-        auto& keyAndTtlIndex =
-                boost::multi_index::get<messagequeuetags::key_and_ttlAbsolute>(queue);
-        auto range = keyAndTtlIndex.equal_range(key);
-        const std::size_t numEntriesForKey = std::distance(range.first, range.second);
-
-        JOYNR_LOG_TRACE(logger(),
-                        "ensureFreePerKeyQueueSlot: numEntriesForKey = {}, perKeyMessageQueueLimit "
-                        "= {}",
-                        numEntriesForKey,
-                        perKeyMessageQueueLimit);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto keyQueue = shard.keyQueues.find(key);
+        if (keyQueue == shard.keyQueues.end() ||
+            keyQueue->second.size() < perKeyMessageQueueLimit) {
+            return;
+        }
 
-        if (numEntriesForKey >= perKeyMessageQueueLimit) {
-            JOYNR_LOG_WARN(logger(),
-                           "Erasing message {} since key based queue limit of "
-                           "{} was reached",
-                           range.first->message->getTrackingInfo(),
-                           perKeyMessageQueueLimit);
-            queueSizeBytes -= range.first->message->getMessageSize();
-            keyAndTtlIndex.erase(range.first);
+        // the per-key limit bounds the length of this scan
+        Entry* entryWithLowestTtl = &keyQueue->second.front();
+        for (Entry& entry : keyQueue->second) {
+            if (entry.ttlAbsolute < entryWithLowestTtl->ttlAbsolute) {
+                entryWithLowestTtl = &entry;
+            }
         }
+
+        JOYNR_LOG_WARN(logger(),
+                       "Erasing message {} since key based queue limit of "
+                       "{} was reached",
+                       entryWithLowestTtl->message->getTrackingInfo(),
+                       perKeyMessageQueueLimit);
+        removeEntry(shard, *entryWithLowestTtl);
     }
 
-    void removeMessageWithLeastTtl()
+    bool removeMessageWithLeastTtl(bool moveToOverflowStore)
     {
-        // queueMutex must have been locked already
-        if (queue.empty()) {
-            return;
+        // admissionMutex must have been acquired earlier, hence no message can be added
+        // concurrently; messages removed concurrently only free additional space
+        Shard* shardWithLowestTtl = nullptr;
+        TimePoint lowestTtl;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            if (!shard.ttlIndex.empty() &&
+                (!shardWithLowestTtl || shard.ttlIndex.begin()->ttlAbsolute < lowestTtl)) {
+                shardWithLowestTtl = &shard;
+                lowestTtl = shard.ttlIndex.begin()->ttlAbsolute;
+            }
+        }
+        if (!shardWithLowestTtl) {
+            return false;
         }
 
-        const std::size_t queueLength = getQueueLengthUnlocked();
-        auto& ttlIndex = boost::multi_index::get<messagequeuetags::ttlAbsolute>(queue);
-        auto msgWithLowestTtl = ttlIndex.cbegin();
-        assert(msgWithLowestTtl != ttlIndex.cend());
-
+        std::lock_guard<std::mutex> lock(shardWithLowestTtl->mutex);
+        if (shardWithLowestTtl->ttlIndex.empty()) {
+            return true;
+        }
+        Entry& msgWithLowestTtl = *shardWithLowestTtl->ttlIndex.begin();
+        if (moveToOverflowStore &&
+            overflowStore->store(msgWithLowestTtl.key, msgWithLowestTtl.message)) {
+            removeEntry(*shardWithLowestTtl, msgWithLowestTtl);
+            return true;
+        }
         JOYNR_LOG_WARN(logger(),
                        "Erasing message {} since either generic queue limit of "
                        "{} messages or {} bytes was reached, #msgs = {}, queueSize(bytes) = {}",
-                       msgWithLowestTtl->message->getTrackingInfo(),
+                       msgWithLowestTtl.message->getTrackingInfo(),
                        messageQueueLimit,
                        messageQueueLimitBytes,
-                       queueLength,
-                       queueSizeBytes);
-
-        queueSizeBytes -= msgWithLowestTtl->message->getMessageSize();
-        ttlIndex.erase(msgWithLowestTtl);
+                       queueLength.load(),
+                       queueSizeBytes.load());
+        removeEntry(*shardWithLowestTtl, msgWithLowestTtl);
+        return true;
     }
 };
 } // namespace joynr
@@ -86,6 +86,13 @@ public:
       */
     void registerDispatcher(std::weak_ptr<IDispatcher> dispatcher) override;
 
+    /**
+     * @brief Enables or disables handing requests to providers of the same runtime
+     * directly to the registered dispatcher, i.e. without creating and routing a
+     * message (enabled by default). Must be called before any request is sent.
+     */
+    void setInProcessShortCircuitEnabled(bool enabled);
+
     void sendRequest(const std::string& senderParticipantId,
                      const std::string& receiverParticipantId,
                      const MessagingQos& qos,
@@ -152,6 +159,7 @@ private:
     std::shared_ptr<IMessageRouter> messageRouter;
     MutableMessageFactory messageFactory;
     std::string replyToAddress;
+    bool inProcessShortCircuitEnabled;
     ADD_LOGGER(MessageSender)
 };
 
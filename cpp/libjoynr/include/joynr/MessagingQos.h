@@ -122,6 +122,18 @@ public:
      */
     void setCompress(bool compress);
 
+    /**
+     * @brief Gets the id of the serializer used for the payload of messages
+     * @return the serializer id, "json" by default
+     */
+    const std::string& getSerializer() const;
+
+    /**
+     * @brief Sets the id of the serializer used for the payload of messages
+     * @param serializer id of a registered serializer, e.g. "json" or "binary"
+     */
+    void setSerializer(const std::string& serializer);
+
     /**
      * @brief Puts a header value for the given header key, replacing an existing value
      * if necessary.
@@ -164,6 +176,9 @@ private:
     /** @brief Specifies, whether messages will be sent compressed */
     bool compress;
 
+    /** @brief Id of the serializer used for the payload of messages */
+    std::string serializer;
+
     /** @brief The map of custom message headers */
     std::unordered_map<std::string, std::string> messageHeaders;
 
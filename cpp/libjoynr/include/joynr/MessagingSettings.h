@@ -20,6 +20,7 @@
 #define MESSAGINGSETTINGS_H
 
 #include <chrono>
+#include <cstdint>
 #include <string>
 
 #include "joynr/JoynrExport.h"
@@ -75,9 +76,29 @@ public:
 
     static const std::string& SETTING_ROUTING_TABLE_GRACE_PERIOD_MS();
     static const std::string& SETTING_ROUTING_TABLE_CLEANUP_INTERVAL_MS();
+    static const std::string& SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD();
 
     static const std::string& SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS();
 
+    /**
+     * @brief SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE The key used in settings to identify
+     * the number of threads used by the message router to send outgoing messages.
+     * Messages are distributed over the threads by their destination address, hence
+     * messages to the same destination keep their order.
+     *
+     * @return the key used in settings for the message router thread pool size.
+     */
+    static const std::string& SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE();
+
+    /**
+     * @brief SETTING_IO_SERVICE_THREAD_POOL_SIZE The key used in settings to identify
+     * the number of threads running the io_service of the runtime which drives all timers.
+     * Values greater than 1 let expired timers be handled concurrently.
+     *
+     * @return the key used in settings for the io_service thread pool size.
+     */
+    static const std::string& SETTING_IO_SERVICE_THREAD_POOL_SIZE();
+
     /**
      * @brief SETTING_MAXIMUM_TTL_MS The key used in settings to identifiy the maximum allowed value
      * of the time-to-live joynr message header.
@@ -108,9 +129,12 @@ public:
     static std::int64_t DEFAULT_DISCOVERY_DEFAULT_RETRY_INTERVAL_MS();
     static std::int64_t DEFAULT_ROUTING_TABLE_GRACE_PERIOD_MS();
     static std::int64_t DEFAULT_ROUTING_TABLE_CLEANUP_INTERVAL_MS();
+    static std::uint32_t DEFAULT_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD();
     static std::int64_t DEFAULT_SEND_MESSAGE_MAX_TTL();
     static std::uint64_t DEFAULT_TTL_UPLIFT_MS();
     static bool DEFAULT_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS();
+    static std::uint8_t DEFAULT_MESSAGE_ROUTER_THREAD_POOL_SIZE();
+    static std::uint8_t DEFAULT_IO_SERVICE_THREAD_POOL_SIZE();
 
     /**
      * @brief DEFAULT_MAXIMUM_TTL_MS
@@ -182,6 +206,8 @@ public:
     void setRoutingTableGracePeriodMs(std::int64_t routingTableGracePeriodMs);
     std::int64_t getRoutingTableCleanupIntervalMs() const;
     void setRoutingTableCleanupIntervalMs(std::int64_t routingTableCleanupIntervalMs);
+    std::uint32_t getRoutingTableJournalCompactionThreshold() const;
+    void setRoutingTableJournalCompactionThreshold(std::uint32_t compactionThreshold);
 
     /**
      * @brief getMaximumTtlMs Get the maximum allowed time-to-live value in milliseconds for joynr
@@ -213,6 +239,12 @@ public:
     void setDiscardUnroutableRepliesAndPublications(
             const bool& discardUnroutableRepliesAndPublications);
 
+    std::uint8_t getMessageRouterThreadPoolSize() const;
+    void setMessageRouterThreadPoolSize(std::uint8_t messageRouterThreadPoolSize);
+
+    std::uint8_t getIOServiceThreadPoolSize() const;
+    void setIOServiceThreadPoolSize(std::uint8_t ioServiceThreadPoolSize);
+
     bool contains(const std::string& key) const;
 
     void printSettings() const;
@@ -0,0 +1,84 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef METHODDISPATCHTABLE_H
+#define METHODDISPATCHTABLE_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Maps the method name and parameter datatypes of a request to the index
+ * of the matching method of an interface.
+ *
+ * Generated RequestInterpreters create one static table per interface and
+ * switch on the returned index, so that resolving a request costs a single hash
+ * of the method name plus the comparison of the parameter datatypes of the
+ * overloads sharing that name.
+ */
+class JOYNR_EXPORT MethodDispatchTable
+{
+public:
+    static constexpr std::size_t NOT_FOUND = static_cast<std::size_t>(-1);
+
+    struct Method
+    {
+        std::string name;
+        std::size_t numberOfParams;
+        /*! Expected parameter datatypes; if empty, only the number of parameters is checked */
+        std::vector<std::string> paramDatatypes;
+    };
+
+    /**
+     * @param methods methods of the interface; the index of a method within this list
+     * is returned by find()
+     */
+    MethodDispatchTable(std::initializer_list<Method> methods);
+
+    /**
+     * @return the index of the first method which matches methodName and paramDatatypes
+     * or NOT_FOUND
+     */
+    std::size_t find(const std::string& methodName,
+                     const std::vector<std::string>& paramDatatypes) const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(MethodDispatchTable);
+
+    struct Overload
+    {
+        std::size_t index;
+        std::size_t numberOfParams;
+        std::vector<std::string> paramDatatypes;
+    };
+
+    std::unordered_map<std::string, std::vector<Overload>> methods;
+};
+
+} // namespace joynr
+
+#endif // METHODDISPATCHTABLE_H
@@ -0,0 +1,118 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef MULTITHREADEDIOSERVICE_H
+#define MULTITHREADEDIOSERVICE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+
+#include "joynr/Logger.h"
+
+namespace joynr
+{
+
+/**
+ * @brief Runs a single io_service on a pool of threads.
+ *
+ * Handlers which are posted to the io_service may run concurrently; handlers which must not
+ * overlap have to be serialized by the caller, e.g. by an io_service::strand.
+ * With one thread it behaves like SingleThreadedIOService.
+ */
+class MultiThreadedIOService : public std::enable_shared_from_this<MultiThreadedIOService>
+{
+public:
+    /**
+     * @param numberOfThreads number of threads running the io_service; 0 selects one thread per
+     * hardware thread
+     */
+    explicit MultiThreadedIOService(std::size_t numberOfThreads)
+            : std::enable_shared_from_this<MultiThreadedIOService>(),
+              numberOfThreads(numberOfThreads != 0 ? numberOfThreads
+                                                   : getNumberOfHardwareThreads()),
+              ioService(static_cast<int>(this->numberOfThreads)),
+              ioServiceWork(),
+              ioServiceThreads()
+    {
+        JOYNR_LOG_TRACE(logger(), "Created with {} threads.", this->numberOfThreads);
+    }
+
+    void start()
+    {
+        ioServiceWork = std::make_unique<boost::asio::io_service::work>(ioService);
+        ioServiceThreads.reserve(numberOfThreads);
+        for (std::size_t i = 0; i < numberOfThreads; ++i) {
+            ioServiceThreads.emplace_back(&runIOService, shared_from_this());
+        }
+        JOYNR_LOG_TRACE(logger(), "Started.");
+    }
+
+    void stop()
+    {
+        JOYNR_LOG_TRACE(logger(), "Stopping.");
+        ioServiceWork.reset();
+        ioService.stop();
+
+        // do not join a thread of the pool from itself; the destructor will not get called
+        // until all threads have ended due to the shared_ptr reference count
+        for (std::thread& ioServiceThread : ioServiceThreads) {
+            if (std::this_thread::get_id() == ioServiceThread.get_id()) {
+                ioServiceThread.detach();
+                JOYNR_LOG_TRACE(logger(), "Same thread: detach!");
+            } else if (ioServiceThread.joinable()) {
+                ioServiceThread.join();
+            }
+        }
+    }
+
+    boost::asio::io_service& getIOService()
+    {
+        return ioService;
+    }
+
+    std::size_t getNumberOfThreads() const
+    {
+        return numberOfThreads;
+    }
+
+private:
+    static void runIOService(std::shared_ptr<MultiThreadedIOService> multiThreadedIOService)
+    {
+        multiThreadedIOService->ioService.run();
+    }
+
+    static std::size_t getNumberOfHardwareThreads()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+private:
+    ADD_LOGGER(MultiThreadedIOService)
+    const std::size_t numberOfThreads;
+    boost::asio::io_service ioService;
+    std::unique_ptr<boost::asio::io_service::work> ioServiceWork;
+    std::vector<std::thread> ioServiceThreads;
+};
+
+} // namespace joynr
+#endif // MULTITHREADEDIOSERVICE_H
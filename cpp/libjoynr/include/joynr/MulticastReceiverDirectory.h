@@ -19,23 +19,34 @@
 #ifndef MULTICASTRECEIVERDIRECTORY_H
 #define MULTICASTRECEIVERDIRECTORY_H
 
-#include <mutex>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include "joynr/Logger.h"
-#include "joynr/MulticastMatcher.h"
 #include "joynr/PrivateCopyAssign.h"
+#include "joynr/ReadWriteLock.h"
 #include "joynr/serializer/Serializer.h"
 
 namespace joynr
 {
 
+/*
+ * Stores the receivers of multicasts. Registered multicastIds may contain the
+ * wildcards util::SINGLE_LEVEL_WILDCARD and util::MULTI_LEVEL_WILDCARD (last
+ * partition only). They are indexed in a trie of topic levels ('/' separated),
+ * so that the receivers of an incoming multicastId are found in time
+ * proportional to its number of levels rather than to the number of
+ * registrations.
+ */
 class MulticastReceiverDirectory
 {
 public:
-    MulticastReceiverDirectory() = default;
+    MulticastReceiverDirectory();
 
     virtual ~MulticastReceiverDirectory();
 
@@ -43,12 +54,12 @@ public:
 
     bool unregisterMulticastReceiver(const std::string& multicastId, const std::string& receiverId);
 
-    std::unordered_set<std::string> getReceivers(const std::string& multicastId);
+    std::unordered_set<std::string> getReceivers(const std::string& multicastId) const;
     std::vector<std::string> getMulticastIds() const;
 
-    bool contains(const std::string& multicastId);
+    bool contains(const std::string& multicastId) const;
 
-    bool contains(const std::string& multicastId, const std::string& receiverId);
+    bool contains(const std::string& multicastId, const std::string& receiverId) const;
 
     template <typename Archive>
     void load(Archive& archive)
@@ -59,12 +70,13 @@ public:
         archive(muesli::make_nvp("multicastReceivers", persistedMulticastReceivers));
 
         {
-            std::lock_guard<std::recursive_mutex> lock(mutex);
+            WriteLocker lock(readWriteLock);
 
-            multicastReceivers.clear();
+            root = Node();
             for (const auto& multicastReceiverEntry : persistedMulticastReceivers) {
-                multicastReceivers.emplace(MulticastMatcher(multicastReceiverEntry.first),
-                                           multicastReceiverEntry.second);
+                Node& node = findOrCreateNode(multicastReceiverEntry.first);
+                node.receivers.insert(multicastReceiverEntry.second.cbegin(),
+                                      multicastReceiverEntry.second.cend());
             }
         }
     }
@@ -76,12 +88,14 @@ public:
                 convertedMulticastReceivers;
 
         {
-            std::lock_guard<std::recursive_mutex> lock(mutex);
-
-            for (const auto& multicastReceiverEntry : multicastReceivers) {
-                convertedMulticastReceivers.emplace(
-                        multicastReceiverEntry.first.multicastId, multicastReceiverEntry.second);
-            }
+            ReadLocker lock(readWriteLock);
+            forEachMulticastId(root,
+                               std::string(),
+                               [&convertedMulticastReceivers](const std::string& multicastId,
+                                                              const Node& node) {
+                                   convertedMulticastReceivers.emplace(multicastId,
+                                                                       node.receivers);
+                               });
         }
 
         archive(muesli::make_nvp("multicastReceivers", convertedMulticastReceivers));
@@ -91,10 +105,28 @@ private:
     DISALLOW_COPY_AND_ASSIGN(MulticastReceiverDirectory);
     ADD_LOGGER(MulticastReceiverDirectory)
 
-    std::unordered_map<MulticastMatcher, std::unordered_set<std::string>, MulticastMatcherHash>
-            multicastReceivers;
-
-    mutable std::recursive_mutex mutex;
+    // A node represents one level of a multicastId. Wildcards are stored as
+    // regular children and are resolved when looking up receivers.
+    struct Node
+    {
+        std::unordered_map<std::string, std::unique_ptr<Node>> children;
+        // receivers registered for the multicastId ending at this node
+        std::unordered_set<std::string> receivers;
+    };
+
+    Node& findOrCreateNode(const std::string& multicastId);
+    const Node* findNode(const std::string& multicastId) const;
+    void collectReceivers(const Node& node,
+                          const std::vector<std::string>& levels,
+                          std::size_t depth,
+                          std::unordered_set<std::string>& foundReceivers) const;
+    void forEachMulticastId(
+            const Node& node,
+            const std::string& prefix,
+            const std::function<void(const std::string&, const Node&)>& callback) const;
+
+    Node root;
+    mutable ReadWriteLock readWriteLock;
 };
 
 } // namespace joynr
@@ -189,6 +189,22 @@ public:
      */
     const boost::optional<std::string>& getEffort() const;
 
+    /**
+     * @brief Sets the id of the serializer used for the payload of the message.
+     * If the header is not set, the payload is expected to be JSON.
+     * @param serializer the "serializer" header to be set on the message.
+     * @see Message::HEADER_SERIALIZER()
+     */
+    void setSerializer(const std::string& serializer);
+
+    /**
+     * @brief Gets the id of the serializer used for the payload of the message.
+     * @return an optional containing the "serializer" header of the message; this optional is
+     * not initialized if the header has not been set
+     * @see Message::HEADER_SERIALIZER()
+     */
+    const boost::optional<std::string>& getSerializer() const;
+
     /**
      * @brief Sets the payload of this message.
      * If the payload is already set, its value is replaced with the new one.
@@ -274,6 +290,7 @@ private:
     std::string id;
     boost::optional<std::string> replyTo;
     boost::optional<std::string> effort;
+    boost::optional<std::string> serializer;
     std::unordered_map<std::string, std::string> customHeaders;
     std::string payload;
     bool ttlAbsolute;
@@ -65,6 +65,13 @@ public:
         archive(MUESLI_NVP(methodName), MUESLI_NVP(paramDatatypes), MUESLI_NVP(params));
     }
 
+protected:
+    /**
+     * @brief Copies method name and parameter datatypes of other and shares its
+     * outbound parameters, see SerializationPlaceholder::shareOutboundData
+     */
+    void shareContentOf(const OneWayRequest& other);
+
 private:
     std::string methodName;
     std::vector<std::string> paramDatatypes;
@@ -0,0 +1,161 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef PARTICIPANTIDTABLE_H
+#define PARTICIPANTIDTABLE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/ReadWriteLock.h"
+
+namespace joynr
+{
+
+/**
+ * @class ParticipantIdTable
+ * @brief Interning table which maps participantIds to compact handles.
+ *
+ * Structures which are looked up for every message, e.g. the @ref RoutingTable,
+ * acquire a handle for each participantId they store and keep only the handle.
+ * The participantId itself is stored once in this table. The handle of a message's
+ * recipient is resolved once when the message is created, so that routing it does
+ * not need to hash the participantId again.
+ *
+ * A handle consists of a slot index (lower 32 bits) and the generation of the slot
+ * (upper 32 bits). Slots are reference counted and reused once the last reference
+ * is released; since reusing a slot increments its generation, a handle which is
+ * kept after its participantId was released never matches the new owner of the slot.
+ *
+ * The slots are stored in chunks which are never moved, so that the participantId
+ * of a handle can be read without locking. Looking up the handle of a participantId
+ * locks only one of several shards of the index.
+ */
+class JOYNR_EXPORT ParticipantIdTable
+{
+public:
+    using Handle = std::uint64_t;
+
+    /*! Handle which never refers to a participantId */
+    static constexpr Handle INVALID_HANDLE = 0;
+
+    /**
+     * @return the table used by the message routers of this process
+     */
+    static ParticipantIdTable& getInstance();
+
+    ParticipantIdTable();
+    ~ParticipantIdTable();
+
+    /**
+     * @brief Interns the participantId and adds a reference to it.
+     * @return the handle of the participantId, stable until the last reference is released
+     */
+    Handle acquire(const std::string& participantId);
+
+    /**
+     * @brief Removes a reference obtained by @ref acquire.
+     */
+    void release(Handle handle);
+
+    /**
+     * @return the handle of the participantId if it is currently interned,
+     * INVALID_HANDLE otherwise
+     */
+    Handle find(const std::string& participantId) const;
+
+    /**
+     * @return the participantId of a handle; the caller must hold a reference
+     * to the handle
+     */
+    std::string getParticipantId(Handle handle) const;
+
+    /**
+     * @return the slot index of a handle, intended for indexing dense arrays
+     */
+    static std::uint32_t getSlotIndex(Handle handle)
+    {
+        return static_cast<std::uint32_t>(handle);
+    }
+
+    /**
+     * @return the number of interned participantIds
+     */
+    std::size_t size() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ParticipantIdTable);
+
+    struct Slot
+    {
+        std::unique_ptr<char[]> participantId;
+        std::uint32_t length;
+        std::uint32_t hash;
+        std::uint32_t generation;
+        std::uint32_t referenceCount;
+    };
+
+    // open addressing index of the slots whose participantIds hash into this shard
+    struct Shard
+    {
+        ReadWriteLock lock;
+        std::vector<std::uint32_t> buckets; // slot index, 0 if the bucket is empty
+        std::size_t size = 0;
+    };
+
+    // the first chunk holds firstChunkSize slots, each further chunk twice as many as
+    // its predecessor, so that the chunks can hold all 32 bit slot indices
+    static constexpr std::uint32_t firstChunkSize = 1024;
+    static constexpr std::size_t maxChunks = 23;
+    static constexpr std::size_t numberOfShards = 16;
+
+    static Handle toHandle(std::uint32_t slotIndex, std::uint32_t generation)
+    {
+        return (static_cast<Handle>(generation) << 32) | slotIndex;
+    }
+
+    static std::uint32_t hash(const std::string& participantId);
+    Shard& getShard(std::uint32_t hash) const;
+    Slot& getSlot(std::uint32_t slotIndex) const;
+    std::uint32_t findSlot(const Shard& shard,
+                           const std::string& participantId,
+                           std::uint32_t hash) const;
+    void insertSlot(Shard& shard, std::uint32_t slotIndex);
+    void eraseSlot(Shard& shard, std::uint32_t slotIndex);
+    std::uint32_t allocateSlot();
+
+    // chunks are only added, a chunk is published before its slots are handed out
+    std::array<std::atomic<Slot*>, maxChunks> chunks;
+    mutable std::array<Shard, numberOfShards> shards;
+    std::mutex slotsMutex;
+    std::uint32_t numberOfSlots;
+    std::vector<std::uint32_t> freeSlots;
+    std::atomic<std::size_t> numberOfParticipantIds;
+};
+
+} // namespace joynr
+
+#endif // PARTICIPANTIDTABLE_H
@@ -69,6 +69,7 @@ public:
      * @param dispatcherAddress The address of the dispatcher
      * @param messageRouter A shared pointer to the message router object
      * @param messagingSettings Reference to the messaging settings object
+     * @param ioService io_service which drives the arbitration
      */
     ProxyBuilder(std::weak_ptr<JoynrRuntimeImpl> runtime,
                  ProxyFactory& proxyFactory,
@@ -77,7 +78,8 @@ public:
                  const std::string& domain,
                  std::shared_ptr<const joynr::system::RoutingTypes::Address> dispatcherAddress,
                  std::shared_ptr<IMessageRouter> messageRouter,
-                 MessagingSettings& messagingSettings);
+                 MessagingSettings& messagingSettings,
+                 boost::asio::io_service& ioService);
 
     /** Destructor */
     ~ProxyBuilder() override = default;
@@ -149,6 +151,7 @@ private:
     std::int64_t discoveryDefaultTimeoutMs;
     std::int64_t discoveryDefaultRetryIntervalMs;
     DiscoveryQos discoveryQos;
+    boost::asio::io_service& ioService;
     static const std::string runtimeAlreadyDestroyed;
 
     ADD_LOGGER(ProxyBuilder)
@@ -163,7 +166,8 @@ ProxyBuilder<T>::ProxyBuilder(
         const std::string& domain,
         std::shared_ptr<const system::RoutingTypes::Address> dispatcherAddress,
         std::shared_ptr<IMessageRouter> messageRouter,
-        MessagingSettings& messagingSettings)
+        MessagingSettings& messagingSettings,
+        boost::asio::io_service& ioService)
         : runtime(std::move(runtime)),
           domain(domain),
           messagingQos(),
@@ -178,7 +182,8 @@ ProxyBuilder<T>::ProxyBuilder(
           messagingMaximumTtlMs(messagingSettings.getMaximumTtlMs()),
           discoveryDefaultTimeoutMs(messagingSettings.getDiscoveryDefaultTimeoutMs()),
           discoveryDefaultRetryIntervalMs(messagingSettings.getDiscoveryDefaultRetryIntervalMs()),
-          discoveryQos()
+          discoveryQos(),
+          ioService(ioService)
 {
     discoveryQos.setDiscoveryTimeoutMs(discoveryDefaultTimeoutMs);
     discoveryQos.setRetryIntervalMs(discoveryDefaultRetryIntervalMs);
@@ -292,7 +297,7 @@ void ProxyBuilder<T>::buildAsync(
     };
 
     auto arbitrator = ArbitratorFactory::createArbitrator(
-            domain, T::INTERFACE_NAME(), interfaceVersion, discoveryProxy, discoveryQos);
+            domain, T::INTERFACE_NAME(), interfaceVersion, discoveryProxy, discoveryQos, ioService);
     arbitrator->startArbitration(std::move(arbitrationSucceeds), std::move(onError));
     arbitrators.push_back(std::move(arbitrator));
 }
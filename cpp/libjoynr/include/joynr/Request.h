@@ -44,6 +44,13 @@ public:
     void setRequestReplyId(std::string&& requestReplyId);
     void setRequestReplyId(const std::string& requestReplyId);
 
+    /**
+     * @brief Creates a request with the same content which shares the parameters
+     * of this request instead of copying them. Used to hand a request which has
+     * been created by a proxy to a provider in the same process.
+     */
+    Request createInProcessCopy() const;
+
     template <typename Archive>
     void serialize(Archive& archive)
     {
@@ -22,17 +22,19 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <boost/system/error_code.hpp>
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/optional.hpp>
 
 #include "joynr/InProcessMessagingAddress.h"
 #include "joynr/Logger.h"
+#include "joynr/ParticipantIdTable.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/serializer/Serializer.h"
 #include "joynr/system/RoutingTypes/Address.h"
@@ -54,8 +56,6 @@ namespace tags
 {
 // tags for accessing indices
 struct ParticipantId;
-struct Address;
-struct ExpiryDate;
 } // namespace tags
 
 // record to be stored in multi index
@@ -135,13 +135,41 @@ struct RoutingEntry
     std::int64_t expiryDateMs;
     bool isSticky; // true if entry should be protected from being purged
 };
+
+// record stored in the routing table; the participantId is kept in the ParticipantIdTable
+struct InternedRoutingEntry
+{
+    // INVALID_HANDLE if the record is unused
+    ParticipantIdTable::Handle participantIdHandle;
+    std::shared_ptr<const joynr::system::RoutingTypes::Address> address;
+    std::int64_t expiryDateMs;
+    // slot indices of the neighbours in the list of entries with the same address, 0 if none
+    std::uint32_t previousWithSameAddress;
+    std::uint32_t nextWithSameAddress;
+    bool isGloballyVisible;
+    bool isSticky;
+};
 } // namespace routingtable
 
+/**
+ * @brief Routing entries indexed by the slot index of their participantId handle.
+ *
+ * The entries are stored in chunks which are addressed by the slot index of the handle,
+ * so that the entry of a handle is found without hashing. Entries with the same address
+ * are linked into a list which starts at the address index. Expired entries are found
+ * by scanning all entries when the table is purged.
+ */
 class RoutingTable
 {
 
 public:
-    RoutingTable();
+    /*
+     * The participantIds of the entries are interned in participantIdTable. Handles of
+     * messages are resolved in ParticipantIdTable::getInstance(), so a routing table which
+     * is used to route messages must use it as well.
+     */
+    explicit RoutingTable(
+            ParticipantIdTable& participantIdTable = ParticipantIdTable::getInstance());
     ~RoutingTable();
 
     /*
@@ -151,6 +179,21 @@ public:
     boost::optional<routingtable::RoutingEntry> lookupRoutingEntryByParticipantId(
             const std::string& participantId) const;
 
+    /*
+     * Returns the address of the element with the given participantId without copying the
+     * element. In case the element could not be found nullptr is returned.
+     */
+    std::shared_ptr<const joynr::system::RoutingTypes::Address> lookupAddressByParticipantId(
+            const std::string& participantId) const;
+
+    /*
+     * Returns the address of the element with the given participantId handle. In case the
+     * element could not be found, e.g. because the handle is INVALID_HANDLE or belongs to a
+     * participantId which has since been removed, nullptr is returned.
+     */
+    std::shared_ptr<const joynr::system::RoutingTypes::Address> lookupAddressByParticipantIdHandle(
+            ParticipantIdTable::Handle participantIdHandle) const;
+
     /*
      * Returns the elements with the given address.
      */
@@ -181,28 +224,45 @@ public:
      */
     void purge();
 
+    /*
+     * Returns the number of elements
+     */
+    std::size_t size() const;
+
     template <typename Archive>
     void save(Archive& archive)
     {
-        MultiIndexContainer tempMultiIndexContainer;
-        auto& index =
-                boost::multi_index::get<routingtable::tags::ParticipantId>(multiIndexContainer);
-        auto entry = index.cbegin();
-        auto last = index.cend();
-        for (; entry != last; ++entry) {
-            const joynr::InProcessMessagingAddress* inprocessAddress =
-                    dynamic_cast<const joynr::InProcessMessagingAddress*>(entry->address.get());
-            if (inprocessAddress == nullptr) {
-                tempMultiIndexContainer.insert(*entry);
+        PersistedContainer persistedContainer;
+        for (const auto& chunk : entryChunks) {
+            for (std::uint32_t i = 0; i < entriesPerChunk; ++i) {
+                const routingtable::InternedRoutingEntry& entry = chunk[i];
+                if (entry.participantIdHandle == ParticipantIdTable::INVALID_HANDLE) {
+                    continue;
+                }
+                const joynr::InProcessMessagingAddress* inprocessAddress =
+                        dynamic_cast<const joynr::InProcessMessagingAddress*>(
+                                entry.address.get());
+                if (inprocessAddress == nullptr) {
+                    persistedContainer.insert(toRoutingEntry(entry));
+                }
             }
         }
-        archive(tempMultiIndexContainer);
+        archive(persistedContainer);
     }
 
     template <typename Archive>
     void load(Archive& archive)
     {
-        archive(multiIndexContainer);
+        PersistedContainer persistedContainer;
+        archive(persistedContainer);
+        clear();
+        for (const auto& entry : persistedContainer) {
+            insert(entry.participantId,
+                   entry.isGloballyVisible,
+                   entry.address,
+                   entry.expiryDateMs,
+                   entry.isSticky);
+        }
     }
 
 private:
@@ -225,31 +285,44 @@ private:
                 std::shared_ptr<const joynr::system::RoutingTypes::Address> address) const;
     };
 
-    using MultiIndexContainer = boost::multi_index_container<
+    // format of the persisted routing table
+    using PersistedContainer = boost::multi_index_container<
             routingtable::RoutingEntry,
-            boost::multi_index::indexed_by<
-                    boost::multi_index::hashed_unique<
-                            boost::multi_index::tag<routingtable::tags::ParticipantId>,
-                            BOOST_MULTI_INDEX_MEMBER(routingtable::RoutingEntry,
-                                                     std::string,
-                                                     participantId)>,
-                    boost::multi_index::hashed_non_unique<
-                            boost::multi_index::tag<routingtable::tags::Address>,
-                            BOOST_MULTI_INDEX_MEMBER(
-                                    routingtable::RoutingEntry,
-                                    std::shared_ptr<const joynr::system::RoutingTypes::Address>,
-                                    address),
-                            AddressHash,
-                            AddressEqual>,
-                    boost::multi_index::ordered_non_unique<
-                            boost::multi_index::tag<routingtable::tags::ExpiryDate>,
-                            BOOST_MULTI_INDEX_MEMBER(routingtable::RoutingEntry,
-                                                     std::int64_t,
-                                                     expiryDateMs)>>>;
+            boost::multi_index::indexed_by<boost::multi_index::hashed_unique<
+                    boost::multi_index::tag<routingtable::tags::ParticipantId>,
+                    BOOST_MULTI_INDEX_MEMBER(routingtable::RoutingEntry,
+                                             std::string,
+                                             participantId)>>>;
+
+    static constexpr std::uint32_t entriesPerChunk = 1024;
+
+    const routingtable::InternedRoutingEntry* findEntry(
+            ParticipantIdTable::Handle participantIdHandle) const;
+    routingtable::InternedRoutingEntry& getOrCreateEntry(std::uint32_t slotIndex);
+    routingtable::InternedRoutingEntry& getEntry(std::uint32_t slotIndex);
+    void linkToAddress(std::uint32_t slotIndex);
+    void unlinkFromAddress(std::uint32_t slotIndex);
+    void removeEntry(std::uint32_t slotIndex);
+    routingtable::RoutingEntry toRoutingEntry(
+            const routingtable::InternedRoutingEntry& entry) const;
+    // returns true if the entry was added, false if it replaced an existing one
+    bool insert(const std::string& participantId,
+                bool isGloballyVisible,
+                std::shared_ptr<const joynr::system::RoutingTypes::Address> address,
+                std::int64_t expiryDateMs,
+                bool isSticky);
+    void clear();
 
 private:
     DISALLOW_COPY_AND_ASSIGN(RoutingTable);
-    MultiIndexContainer multiIndexContainer;
+    ParticipantIdTable& participantIdTable;
+    std::vector<std::unique_ptr<routingtable::InternedRoutingEntry[]>> entryChunks;
+    // slot index of the first entry with the address
+    std::unordered_map<std::shared_ptr<const joynr::system::RoutingTypes::Address>,
+                       std::uint32_t,
+                       AddressHash,
+                       AddressEqual> addressIndex;
+    std::size_t numberOfEntries;
     ADD_LOGGER(RoutingTable)
 };
 
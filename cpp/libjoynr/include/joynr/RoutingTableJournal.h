@@ -0,0 +1,158 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef ROUTINGTABLEJOURNAL_H
+#define ROUTINGTABLEJOURNAL_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class RoutingTable;
+
+namespace routingtable
+{
+struct RoutingEntry;
+} // namespace routingtable
+
+/**
+ * @class RoutingTableJournal
+ * @brief Write-behind persistence of a @ref RoutingTable.
+ *
+ * The persisted routing table consists of a snapshot file, which contains the
+ * JSON serialized routing table, and an append-only journal file next to it
+ * (snapshot file name + ".journal") with one record per mutation.
+ *
+ * Records are queued in memory and written to the journal by a background
+ * thread, so that mutations of the routing table do not have to wait for file
+ * I/O. Once the number of journal records exceeds the compaction threshold,
+ * the background thread writes a new snapshot (provided by the
+ * SnapshotProvider) and truncates the journal.
+ *
+ * Replaying a record is idempotent (add replaces, remove ignores unknown
+ * participantIds), hence records which are already contained in the snapshot
+ * may safely be replayed again after a crash during compaction.
+ */
+class JOYNR_EXPORT RoutingTableJournal
+{
+public:
+    /**
+     * @brief Serializes the current state of the routing table. Called from
+     * the background thread, it must take care of locking the routing table.
+     */
+    using SnapshotProvider = std::function<std::string()>;
+
+    /**
+     * @brief Constructor, starts the background thread
+     * @param snapshotFileName Name of the snapshot file
+     * @param snapshotProvider Provider of the snapshot to be written on compaction
+     * @param compactionThreshold Number of journal records after which the
+     * journal is compacted into a new snapshot
+     */
+    RoutingTableJournal(std::string snapshotFileName,
+                        SnapshotProvider snapshotProvider,
+                        std::uint32_t compactionThreshold);
+
+    /**
+     * @brief Destructor, calls @ref shutdown
+     */
+    ~RoutingTableJournal();
+
+    /**
+     * @brief Loads the snapshot and replays the journal into routingTable.
+     * The caller must hold the write lock of the routing table.
+     * @return the number of replayed journal records
+     */
+    static std::size_t load(const std::string& snapshotFileName, RoutingTable& routingTable);
+
+    /**
+     * @return the name of the journal file belonging to snapshotFileName
+     */
+    static std::string getJournalFileName(const std::string& snapshotFileName);
+
+    /**
+     * @brief Queues a record for an added or updated routing entry.
+     * Must be called while the routing table is locked in order to keep the
+     * records in the same order as the mutations.
+     */
+    void logAdd(const routingtable::RoutingEntry& routingEntry);
+
+    /**
+     * @brief Queues a record for a removed routing entry.
+     * Must be called while the routing table is locked in order to keep the
+     * records in the same order as the mutations.
+     */
+    void logRemove(const std::string& participantId);
+
+    /**
+     * @brief Requests the background thread to compact the journal
+     */
+    void requestCompaction();
+
+    /**
+     * @brief Blocks until all queued records have been written and a
+     * requested compaction has been finished
+     */
+    void flush();
+
+    /**
+     * @brief Writes all queued records and stops the background thread
+     */
+    void shutdown();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(RoutingTableJournal);
+
+    void append(std::string record);
+    void run();
+    void writeRecords(const std::vector<std::string>& records);
+    void compact();
+
+    const std::string snapshotFileName;
+    const std::string journalFileName;
+    SnapshotProvider snapshotProvider;
+    const std::uint32_t compactionThreshold;
+    std::size_t numberOfJournalRecords;
+
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    std::vector<std::string> pendingRecords;
+    bool compactionRequested;
+    bool isBusy;
+    bool isShuttingDown;
+    std::thread worker;
+
+    ADD_LOGGER(RoutingTableJournal)
+};
+
+} // namespace joynr
+
+#endif // ROUTINGTABLEJOURNAL_H
@@ -0,0 +1,132 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHARDEDTHREADPOOLDELAYEDSCHEDULER_H
+#define SHARDEDTHREADPOOLDELAYEDSCHEDULER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "joynr/DelayedScheduler.h"
+#include "joynr/JoynrExport.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace boost
+{
+namespace asio
+{
+class io_service;
+} // namespace asio
+} // namespace boost
+
+namespace joynr
+{
+
+class Runnable;
+
+/**
+ * @class ShardedThreadPoolDelayedScheduler
+ * @brief A delayed scheduler which distributes @ref Runnable objects over a
+ *      number of single threaded shards.
+ *
+ * Each @ref Runnable is scheduled together with a shard key. All runnables
+ * having the same shard key are executed by the same thread in the order they
+ * became ready, while runnables with different shard keys may be executed
+ * concurrently.
+ */
+class JOYNR_EXPORT ShardedThreadPoolDelayedScheduler
+{
+
+public:
+    /**
+     * @brief Snapshot of the counters collected for a single shard
+     */
+    struct ShardStatistics
+    {
+        /*! Number of runnables which are ready but not yet started */
+        std::uint64_t queueDepth;
+        /*! Highest number of ready runnables observed so far */
+        std::uint64_t maxQueueDepth;
+        /*! Number of runnables started so far */
+        std::uint64_t executedRunnables;
+        /*! Average time between a runnable becoming ready and being started */
+        std::chrono::microseconds averageLatency;
+        /*! Highest time between a runnable becoming ready and being started */
+        std::chrono::microseconds maxLatency;
+    };
+
+    /**
+     * @brief Constructor
+     * @param numberOfShards Number of shards (and threads) to be allocated, at least 1
+     * @param name Name of the threads to be used for debugging reasons
+     * @param ioService io_service used for the timers of delayed runnables
+     */
+    ShardedThreadPoolDelayedScheduler(std::uint8_t numberOfShards,
+                                      const std::string& name,
+                                      boost::asio::io_service& ioService);
+
+    /**
+     * @brief Destructor
+     * @note @ref shutdown must be called before destroying this object
+     */
+    ~ShardedThreadPoolDelayedScheduler();
+
+    /**
+     * @brief Schedule a @ref Runnable on the shard selected by shardKey
+     * @param runnable Runnable to be executed
+     * @param shardKey Key used to select the shard, e.g. the hash of the destination
+     * @param delay Number of milliseconds to delay the execution
+     * @return Handle referencing the given @ref Runnable in the selected shard
+     *      or @ref DelayedScheduler::INVALID_RUNNABLE_HANDLE, see
+     *      @ref DelayedScheduler::schedule
+     */
+    DelayedScheduler::RunnableHandle schedule(std::shared_ptr<Runnable> runnable,
+                                              std::size_t shardKey,
+                                              std::chrono::milliseconds delay);
+
+    /**
+     * @brief Does an ordinary shutdown of all shards
+     * @note Must be called before destructor is called
+     */
+    void shutdown();
+
+    /**
+     * @return the number of shards
+     */
+    std::size_t getNumberOfShards() const;
+
+    /**
+     * @return a snapshot of the counters of every shard, indexed by shard
+     */
+    std::vector<ShardStatistics> getStatistics() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ShardedThreadPoolDelayedScheduler);
+
+    class Shard;
+
+    std::vector<std::shared_ptr<Shard>> shards;
+};
+
+} // namespace joynr
+
+#endif // SHARDEDTHREADPOOLDELAYEDSCHEDULER_H
@@ -0,0 +1,168 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYCONNECTION_H
+#define SHAREDMEMORYCONNECTION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/SharedMemoryRingBuffer.h"
+
+namespace joynr
+{
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @class SharedMemoryConnection
+ * @brief Bidirectional connection between two processes on the same host
+ * which exchanges frames via a pair of @ref SharedMemoryRingBuffer objects.
+ *
+ * The client creates an anonymous shared memory segment holding both ring
+ * buffers and two eventfds used for wakeups and passes them to the server
+ * over a unix domain socket. The socket is kept open afterwards only to
+ * detect that the peer went away; the frames themselves never pass through
+ * the kernel.
+ *
+ * The segment is sealed against resizing before it is handed over; the
+ * server rejects segments which are not sealed. A connection whose peer
+ * corrupts the shared state is closed.
+ */
+class JOYNR_EXPORT SharedMemoryConnection
+        : public std::enable_shared_from_this<SharedMemoryConnection>
+{
+public:
+    using Socket = boost::asio::local::stream_protocol::socket;
+    using AcceptHandler = std::function<void(const boost::system::error_code& error,
+                                             std::shared_ptr<SharedMemoryConnection> connection)>;
+
+    /**
+     * @brief Connects to a server listening on the given unix domain socket
+     * @param ioService io_service used for receiving frames
+     * @param path Path of the unix domain socket
+     * @param capacity Capacity of each of the ring buffers in bytes
+     * @param error Set if the connection could not be established
+     * @return the connection or nullptr on error
+     */
+    static std::shared_ptr<SharedMemoryConnection> connect(boost::asio::io_service& ioService,
+                                                           const std::string& path,
+                                                           std::size_t capacity,
+                                                           boost::system::error_code& error);
+
+    /**
+     * @brief Asynchronously takes over the shared memory segment which is
+     *      handed over by a client on a newly accepted socket
+     * @param ioService io_service used for receiving frames
+     * @param socket Accepted socket
+     * @param handler Invoked with the connection or an error
+     */
+    static void asyncAccept(boost::asio::io_service& ioService,
+                            Socket socket,
+                            AcceptHandler handler);
+
+    ~SharedMemoryConnection();
+
+    /**
+     * @brief Starts receiving frames
+     * @param onFrameReceived Invoked for every received frame; the view points
+     *      into the shared memory and is only valid during the call
+     * @param onClosed Invoked once if the peer closed the connection or
+     *      corrupted the shared state
+     */
+    void start(std::function<void(const smrf::ByteArrayView&)> onFrameReceived,
+               std::function<void()> onClosed);
+
+    /**
+     * @brief Copies a frame into the shared memory and wakes up the peer if required
+     * @param frame Frame to be sent
+     * @param onFailure Invoked if the frame could not be sent
+     */
+    void send(const smrf::ByteArrayView& frame,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+
+    /**
+     * @brief Closes the connection, onClosed is not invoked
+     */
+    void close();
+
+    bool isOpen() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SharedMemoryConnection);
+
+    SharedMemoryConnection(boost::asio::io_service& ioService,
+                           Socket socket,
+                           void* memory,
+                           std::size_t mappingSize,
+                           std::size_t capacity,
+                           bool isClient,
+                           int receiveEventFd,
+                           int sendEventFd);
+
+    void receive();
+    void waitForWakeup();
+    void waitForPeerClosed();
+    void onPeerClosed();
+    void closeAndNotify();
+    bool closeInternal();
+    bool readReceivedFrames();
+
+    boost::asio::io_service& ioService;
+    Socket socket;
+    boost::asio::posix::stream_descriptor receiveNotifier;
+    void* memory;
+    const std::size_t mappingSize;
+    SharedMemoryRingBuffer sendBuffer;
+    SharedMemoryRingBuffer receiveBuffer;
+    const int sendEventFd;
+    std::uint64_t receivedEventCount;
+    std::uint8_t receivedControlByte;
+
+    std::function<void(const smrf::ByteArrayView&)> onFrameReceived;
+    std::function<void()> onClosed;
+
+    std::mutex sendMutex;
+    std::mutex receiveMutex;
+    std::mutex stateMutex;
+    std::atomic<bool> closed;
+
+    ADD_LOGGER(SharedMemoryConnection)
+};
+
+} // namespace joynr
+
+#endif // SHAREDMEMORYCONNECTION_H
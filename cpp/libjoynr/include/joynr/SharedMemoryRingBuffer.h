@@ -0,0 +1,125 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYRINGBUFFER_H
+#define SHAREDMEMORYRINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+/**
+ * @class SharedMemoryRingBuffer
+ * @brief Single producer / single consumer queue of length prefixed frames
+ * placed in memory which may be shared between processes.
+ *
+ * The buffer does not own its memory. Producer and consumer may live in
+ * different processes which have mapped the same memory at different
+ * addresses, therefore only offsets are stored inside the buffer.
+ *
+ * Frames are never split: if a frame does not fit into the space left at
+ * the end of the buffer, the remainder is skipped and the frame is written
+ * to the beginning of the buffer.
+ */
+class JOYNR_EXPORT SharedMemoryRingBuffer
+{
+public:
+    /**
+     * @return number of bytes which have to be provided to hold a buffer
+     *      with the given capacity
+     */
+    static std::size_t getRequiredSize(std::size_t capacity);
+
+    /**
+     * @brief Constructor
+     * @param memory Start of the memory holding the buffer, must be 64 byte aligned
+     *      and at least getRequiredSize(capacity) bytes long
+     * @param capacity Number of bytes available for frames, must be a multiple of 8
+     */
+    SharedMemoryRingBuffer(void* memory, std::size_t capacity);
+
+    /**
+     * @brief Initializes the shared state of the buffer, must be called by
+     *      exactly one side before the buffer is used
+     */
+    void initialize();
+
+    /**
+     * @return the size of the largest frame which can ever be written
+     */
+    std::size_t getMaxFrameSize() const;
+
+    /**
+     * @brief Copies a frame into the buffer (producer side)
+     * @param frame Frame to be written
+     * @return false if there is currently not enough space for the frame or
+     *      if the positions in the shared state are corrupted
+     */
+    bool tryWrite(const smrf::ByteArrayView& frame);
+
+    /**
+     * @brief Must be called by the producer after a successful write
+     * @return true if the consumer is waiting and has to be woken up
+     */
+    bool consumerNeedsWakeup();
+
+    /**
+     * @brief Passes all frames available in the buffer to onFrame (consumer side)
+     *
+     * The view passed to onFrame points directly into the buffer and is only
+     * valid until onFrame returns.
+     *
+     * The shared state is written by the producer which might live in another,
+     * untrusted process. Positions and frame lengths are therefore validated
+     * before any frame is accessed.
+     * @param onFrame Callback invoked for every frame
+     * @return number of frames consumed
+     * @throw exceptions::JoynrRuntimeException if the shared state is corrupted;
+     *      the buffer must not be used any more afterwards
+     */
+    std::size_t read(const std::function<void(const smrf::ByteArrayView&)>& onFrame);
+
+    /**
+     * @brief Announces that the consumer is about to wait for a wakeup
+     * @return false if frames arrived in the meantime; the consumer must
+     *      read them instead of waiting
+     */
+    bool prepareWait();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SharedMemoryRingBuffer);
+
+    struct Header;
+
+    Header* header;
+    std::uint8_t* data;
+    const std::size_t capacity;
+};
+
+} // namespace joynr
+
+#endif // SHAREDMEMORYRINGBUFFER_H
@@ -0,0 +1,89 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYSETTINGS_H
+#define SHAREDMEMORYSETTINGS_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+
+namespace joynr
+{
+
+class Settings;
+
+namespace system
+{
+namespace RoutingTypes
+{
+class SharedMemoryAddress;
+} // namespace RoutingTypes
+} // namespace system
+
+/**
+ * @class SharedMemorySettings
+ * @brief Settings of the shared memory transport between libjoynr and the
+ * cluster controller. The transport is disabled as long as no messaging path
+ * is configured.
+ */
+class JOYNR_EXPORT SharedMemorySettings
+{
+public:
+    static const std::string& SETTING_CC_MESSAGING_PATH();
+    static const std::string& SETTING_RING_BUFFER_SIZE();
+    static const std::string& SETTING_RECONNECT_SLEEP_TIME_MS();
+
+    static std::size_t DEFAULT_RING_BUFFER_SIZE();
+    static std::chrono::milliseconds DEFAULT_RECONNECT_SLEEP_TIME_MS();
+
+    explicit SharedMemorySettings(Settings& settings);
+    SharedMemorySettings(const SharedMemorySettings&) = default;
+    SharedMemorySettings(SharedMemorySettings&&) = default;
+
+    ~SharedMemorySettings() = default;
+
+    bool isEnabled() const;
+
+    std::string getClusterControllerMessagingPath() const;
+    void setClusterControllerMessagingPath(const std::string& path);
+    system::RoutingTypes::SharedMemoryAddress createClusterControllerMessagingAddress() const;
+
+    std::size_t getRingBufferSize() const;
+    void setRingBufferSize(std::size_t ringBufferSize);
+
+    std::chrono::milliseconds getReconnectSleepTimeMs() const;
+    void setReconnectSleepTimeMs(const std::chrono::milliseconds reconnectSleepTimeMs);
+
+    void printSettings() const;
+
+    bool contains(const std::string& key) const;
+
+private:
+    void operator=(const SharedMemorySettings& other);
+
+    Settings& settings;
+    ADD_LOGGER(SharedMemorySettings)
+    void checkSettings();
+};
+
+} // namespace joynr
+#endif // SHAREDMEMORYSETTINGS_H
@@ -23,15 +23,14 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
-#include <set>
 #include <string>
 #include <thread>
 #include <vector>
 
-#include "joynr/BlockingQueue.h"
 #include "joynr/JoynrExport.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
+#include "joynr/WorkStealingQueue.h"
 
 namespace joynr
 {
@@ -88,7 +87,14 @@ private:
     DISALLOW_COPY_AND_ASSIGN(ThreadPool);
 
     /*! Lifecycle for @ref threads */
-    void threadLifecycle(std::shared_ptr<ThreadPool> thisSharedptr);
+    void threadLifecycle(std::shared_ptr<ThreadPool> thisSharedptr, std::size_t workerIndex);
+
+    /*! Work currently done by a single worker thread */
+    struct RunningSlot
+    {
+        std::mutex mutex;
+        std::shared_ptr<Runnable> runnable;
+    };
 
 private:
     /*! Logger */
@@ -97,16 +103,14 @@ private:
     /*! Worker threads */
     std::vector<std::thread> threads;
 
-    /*! FIFO queue of work that could be done right now */
-    BlockingQueue scheduler;
+    /*! FIFO queues of work that could be done right now, one per thread */
+    WorkStealingQueue scheduler;
 
     /*! Flag indicating @ref threads to keep running */
     std::atomic_bool keepRunning;
 
-    /*! Currently running work in @ref threads */
-    std::set<std::shared_ptr<Runnable>> currentlyRunning;
-
-    std::mutex mutex;
+    /*! Currently running work in @ref threads, indexed by thread */
+    std::vector<std::unique_ptr<RunningSlot>> currentlyRunning;
 
     std::uint8_t numberOfThreads;
 
@@ -0,0 +1,167 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace boost
+{
+namespace asio
+{
+class io_service;
+} // namespace asio
+} // namespace boost
+
+namespace joynr
+{
+
+class SteadyTimer;
+
+/**
+ * @class TimerWheel
+ * @brief Hierarchical timing wheel which multiplexes many timeouts onto a single asio timer
+ *
+ * Timeouts are kept in 4 levels of 256 slots each. Scheduling and cancelling a timeout
+ * is O(1); expired callbacks are invoked on the thread running the io_service, like
+ * the handlers of ordinary asio timers.
+ *
+ * Use @ref getInstance to obtain the wheel shared by all users of an io_service.
+ */
+class JOYNR_EXPORT TimerWheel : public std::enable_shared_from_this<TimerWheel>
+{
+public:
+    /*! Handle to reference a scheduled timeout */
+    using TimerId = std::uint64_t;
+
+    /*! Invalid handle */
+    static constexpr TimerId INVALID_TIMER_ID = 0;
+
+    /**
+     * @brief Constructor
+     * @param ioService io_service executing the expired callbacks
+     * @param tickDuration Resolution of the wheel
+     * @note Must be owned by a std::shared_ptr
+     */
+    explicit TimerWheel(boost::asio::io_service& ioService,
+                        std::chrono::milliseconds tickDuration = std::chrono::milliseconds(1));
+
+    ~TimerWheel();
+
+    /**
+     * @brief Returns the wheel shared by all users of the given io_service
+     * @note The wheel is shut down when the io_service is destroyed
+     */
+    static std::shared_ptr<TimerWheel> getInstance(boost::asio::io_service& ioService);
+
+    /**
+     * @brief Schedule a callback to be invoked after the given delay
+     * @param delay Delay after which the callback is invoked
+     * @param callback Callback to be invoked
+     * @return Handle referencing the timeout or @ref INVALID_TIMER_ID if the
+     *      wheel has already been shut down
+     */
+    TimerId schedule(std::chrono::milliseconds delay, std::function<void()> callback);
+
+    /**
+     * @brief Cancel a timeout
+     * @param timerId Handle returned by @ref schedule
+     * @return true if the timeout was pending and its callback will not be invoked
+     */
+    bool cancel(TimerId timerId);
+
+    /**
+     * @brief Cancels all timeouts and stops the wheel
+     */
+    void shutdown();
+
+    /**
+     * @return number of pending timeouts
+     */
+    std::size_t getNumberOfTimers() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+
+    static constexpr std::size_t SLOT_BITS = 8;
+    static constexpr std::size_t NUMBER_OF_SLOTS = 1 << SLOT_BITS;
+    static constexpr std::size_t NUMBER_OF_LEVELS = 4;
+
+    struct Entry
+    {
+        TimerId id;
+        std::uint64_t expiryTick;
+        std::function<void()> callback;
+    };
+
+    using Slot = std::list<Entry>;
+
+    struct Location
+    {
+        std::size_t level;
+        std::size_t slot;
+        Slot::iterator entry;
+    };
+
+    std::uint64_t getNowTick() const;
+    std::pair<std::size_t, std::size_t> getSlotFor(std::uint64_t expiryTick) const;
+    void relocate(Slot& source, Slot::iterator entry);
+    void cascade(std::size_t level);
+    void advance(std::uint64_t nowTick, std::vector<std::function<void()>>& expiredCallbacks);
+    std::uint64_t getNextEventTick() const;
+    void arm(std::uint64_t tick);
+    void onTimerExpired(std::uint64_t armedGeneration);
+
+    ADD_LOGGER(TimerWheel)
+
+    const std::chrono::milliseconds tickDuration;
+    const std::chrono::steady_clock::time_point startTime;
+
+    std::array<std::array<Slot, NUMBER_OF_SLOTS>, NUMBER_OF_LEVELS> slots;
+    std::unordered_map<TimerId, Location> locations;
+
+    /*! Last tick which has been processed */
+    std::uint64_t currentTick;
+    TimerId nextTimerId;
+
+    std::unique_ptr<SteadyTimer> timer;
+    bool isArmed;
+    std::uint64_t armedTick;
+    std::uint64_t armedGeneration;
+    bool isShutdown;
+
+    mutable std::mutex mutex;
+};
+
+} // namespace joynr
+
+#endif // TIMERWHEEL_H
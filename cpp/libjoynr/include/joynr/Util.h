@@ -116,7 +116,8 @@ void appendStringToFile(const std::string& fileName, const std::string& strToSav
 /**
  * Create a Uuid for use in Joynr.
  *
- * This is simply a wrapper around boost::uuid
+ * This is simply a wrapper around boost::uuid. Every thread uses its own
+ * generator, hence concurrent calls do not contend.
  */
 std::string createUuid();
 
@@ -0,0 +1,138 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef WORKSTEALINGQUEUE_H
+#define WORKSTEALINGQUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "joynr/JoynrExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class Runnable;
+
+/**
+ * @class WorkStealingQueue
+ * @brief Work queue made of one FIFO deque per worker
+ *
+ * New work is distributed round robin over the deques of the workers. A worker
+ * takes the oldest work from its own deque and steals the oldest work from the
+ * deques of the other workers if its own deque is empty. Workers only block on
+ * a shared condition if no work is available at all.
+ */
+class JOYNR_EXPORT WorkStealingQueue
+{
+public:
+    /**
+     * @brief Constructor
+     * @param numberOfWorkers Number of workers calling @ref take, at least 1
+     */
+    explicit WorkStealingQueue(std::uint8_t numberOfWorkers);
+
+    /**
+     * @brief Destructor
+     * @note Be sure to call @ref shutdown and wait for return before
+     *      destroying this object
+     */
+    ~WorkStealingQueue();
+
+    /**
+     * @brief Submit task to be done
+     * @param task Task to be added to the queue
+     */
+    void add(std::shared_ptr<Runnable> task);
+
+    /**
+     * @brief Does an ordinary shutdown of @ref WorkStealingQueue
+     * @note Must be called before destructor is called
+     */
+    void shutdown();
+
+    /**
+     * @brief Take some work
+     * @param workerIndex Index of the calling worker, less than the number of workers
+     * @return Work to be done or @c nullptr if the queue is shutting down
+     *
+     * @note This method will block until work is available or the queue is
+     *      going to shutdown. If so, this method will return @c nullptr.
+     */
+    std::shared_ptr<Runnable> take(std::size_t workerIndex);
+
+    /**
+     * @brief Returns the current size of the queue
+     * @return Number of pending @ref Runnable objects
+     */
+    std::size_t getQueueLength() const;
+
+private:
+    /*! Not allowed to copy @ref WorkStealingQueue */
+    DISALLOW_COPY_AND_ASSIGN(WorkStealingQueue);
+
+    struct WorkerDeque
+    {
+        WorkerDeque() : mutex(), queue(), size(0)
+        {
+        }
+
+        std::mutex mutex;
+        std::deque<std::shared_ptr<Runnable>> queue;
+        /*! Size of @ref queue, allows to skip empty deques without locking */
+        std::atomic<std::size_t> size;
+    };
+
+    std::shared_ptr<Runnable> tryTake(std::size_t workerIndex);
+
+private:
+    /*! Logger */
+    ADD_LOGGER(WorkStealingQueue)
+
+    /*! One deque of waiting work per worker */
+    std::vector<std::unique_ptr<WorkerDeque>> workerDeques;
+
+    /*! Index of the deque which receives the next work */
+    std::atomic<std::size_t> nextWorkerDeque;
+
+    /*! Number of pending tasks in all deques */
+    std::atomic<std::size_t> pendingTasks;
+
+    /*! Number of workers waiting on @ref idleCondition */
+    std::atomic<std::size_t> idleWorkers;
+
+    /*! Flag indicating queue is shutting down */
+    std::atomic_bool stoppingQueue;
+
+    /*! Cond to wait for work if all deques are empty */
+    std::condition_variable idleCondition;
+
+    /*! Mutual exclusion for @ref idleCondition */
+    std::mutex idleMutex;
+};
+
+} // namespace joynr
+#endif // WORKSTEALINGQUEUE_H
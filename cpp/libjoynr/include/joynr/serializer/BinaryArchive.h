@@ -0,0 +1,642 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef BINARYARCHIVE_H
+#define BINARYARCHIVE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <muesli/ArchiveRegistry.h>
+#include <muesli/BaseArchive.h>
+#include <muesli/archives/json/JsonInputArchive.h>
+#include <muesli/archives/json/JsonOutputArchive.h>
+#include <muesli/streams/StringIStream.h>
+#include <muesli/streams/StringOStream.h>
+
+namespace joynr
+{
+namespace serializer
+{
+
+namespace tags
+{
+struct binary;
+} // namespace tags
+
+/**
+ * @brief Compact binary archive for payloads exchanged between C++ runtimes
+ *
+ * Format:
+ * - bool, 8 bit integers: one byte
+ * - other integers and enums: varint, signed values are zigzag encoded
+ * - float, double: little endian IEEE 754
+ * - std::string, containers: varint length followed by the content,
+ *   vectors of 8 bit values are copied as a block
+ * - std::tuple (e.g. request parameters): 0x01, varint byte length, elements
+ * - std::nullptr_t, empty pointer: 0x00
+ * - pointer to a polymorphic type: 0x01, embedded JSON document, so that the
+ *   dynamic type is resolved by muesli's type registry like for JSON payloads
+ * - names of name-value pairs are not written, members are encoded in order
+ */
+template <typename OutputStream>
+class BinaryOutputArchive
+        : public muesli::BaseArchive<muesli::tags::OutputArchive, BinaryOutputArchive<OutputStream>>
+{
+    using Parent =
+            muesli::BaseArchive<muesli::tags::OutputArchive, BinaryOutputArchive<OutputStream>>;
+
+public:
+    explicit BinaryOutputArchive(OutputStream& stream)
+            : Parent(this), stream(stream), nestedBuffers()
+    {
+    }
+
+    void writeByte(std::uint8_t byte)
+    {
+        if (nestedBuffers.empty()) {
+            stream.Put(static_cast<char>(byte));
+        } else {
+            nestedBuffers.back().push_back(static_cast<char>(byte));
+        }
+    }
+
+    void writeBytes(const void* data, std::size_t size)
+    {
+        const char* bytes = static_cast<const char*>(data);
+        if (nestedBuffers.empty()) {
+            for (std::size_t i = 0; i < size; ++i) {
+                stream.Put(bytes[i]);
+            }
+        } else {
+            nestedBuffers.back().append(bytes, size);
+        }
+    }
+
+    void writeVarint(std::uint64_t value)
+    {
+        while (value >= 0x80) {
+            writeByte(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        writeByte(static_cast<std::uint8_t>(value));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_same<T, bool>::value> writeValue(T value)
+    {
+        writeByte(value ? 1 : 0);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                     sizeof(T) == 1>
+    writeValue(T value)
+    {
+        writeByte(static_cast<std::uint8_t>(value));
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) != 1>
+    writeValue(T value)
+    {
+        writeVarint(value);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) != 1>
+    writeValue(T value)
+    {
+        const std::int64_t extended = value;
+        writeVarint((static_cast<std::uint64_t>(extended) << 1) ^
+                    static_cast<std::uint64_t>(extended >> 63));
+    }
+
+    void writeValue(float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeLittleEndian(bits);
+    }
+
+    void writeValue(double value)
+    {
+        std::uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        writeLittleEndian(bits);
+    }
+
+    void writeValue(const std::string& value)
+    {
+        writeVarint(value.size());
+        writeBytes(value.data(), value.size());
+    }
+
+    /**
+     * @brief Starts a section whose byte length is written in front of it,
+     *      which allows the reader to skip or defer decoding it
+     */
+    void beginLengthDelimited()
+    {
+        nestedBuffers.emplace_back();
+    }
+
+    void endLengthDelimited()
+    {
+        std::string section = std::move(nestedBuffers.back());
+        nestedBuffers.pop_back();
+        writeVarint(section.size());
+        writeBytes(section.data(), section.size());
+    }
+
+private:
+    template <typename T>
+    void writeLittleEndian(T bits)
+    {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            writeByte(static_cast<std::uint8_t>(bits >> (8 * i)));
+        }
+    }
+
+    OutputStream& stream;
+    std::vector<std::string> nestedBuffers;
+};
+
+template <typename InputStream>
+class BinaryInputArchive
+        : public muesli::BaseArchive<muesli::tags::InputArchive, BinaryInputArchive<InputStream>>
+{
+    using Parent =
+            muesli::BaseArchive<muesli::tags::InputArchive, BinaryInputArchive<InputStream>>;
+
+public:
+    explicit BinaryInputArchive(InputStream& stream) : Parent(this), stream(stream)
+    {
+    }
+
+    std::uint8_t readByte()
+    {
+        const std::size_t position = stream.Tell();
+        const std::uint8_t byte = static_cast<std::uint8_t>(stream.Take());
+        if (stream.Tell() == position) {
+            throw std::invalid_argument("unexpected end of binary payload");
+        }
+        return byte;
+    }
+
+    std::uint64_t readVarint()
+    {
+        std::uint64_t value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t byte = readByte();
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        throw std::invalid_argument("malformed varint in binary payload");
+    }
+
+    std::size_t readLength()
+    {
+        const std::uint64_t length = readVarint();
+        if (length > std::numeric_limits<std::size_t>::max()) {
+            throw std::invalid_argument("length exceeds size_t in binary payload");
+        }
+        return static_cast<std::size_t>(length);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_same<T, bool>::value> readValue(T& value)
+    {
+        value = readByte() != 0;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+                     sizeof(T) == 1>
+    readValue(T& value)
+    {
+        value = static_cast<T>(readByte());
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && std::is_unsigned<T>::value && sizeof(T) != 1>
+    readValue(T& value)
+    {
+        const std::uint64_t decoded = readVarint();
+        if (decoded > std::numeric_limits<T>::max()) {
+            throw std::invalid_argument("integer out of range in binary payload");
+        }
+        value = static_cast<T>(decoded);
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) != 1>
+    readValue(T& value)
+    {
+        const std::uint64_t decoded = readVarint();
+        const std::int64_t extended =
+                static_cast<std::int64_t>(decoded >> 1) ^ -static_cast<std::int64_t>(decoded & 1);
+        if (extended < std::numeric_limits<T>::min() || extended > std::numeric_limits<T>::max()) {
+            throw std::invalid_argument("integer out of range in binary payload");
+        }
+        value = static_cast<T>(extended);
+    }
+
+    void readValue(float& value)
+    {
+        const std::uint32_t bits = readLittleEndian<std::uint32_t>();
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+
+    void readValue(double& value)
+    {
+        const std::uint64_t bits = readLittleEndian<std::uint64_t>();
+        std::memcpy(&value, &bits, sizeof(value));
+    }
+
+    void readValue(std::string& value)
+    {
+        const std::size_t length = readLength();
+        value.clear();
+        for (std::size_t i = 0; i < length; ++i) {
+            value.push_back(static_cast<char>(readByte()));
+        }
+    }
+
+private:
+    template <typename T>
+    T readLittleEndian()
+    {
+        T bits = 0;
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            bits |= static_cast<T>(readByte()) << (8 * i);
+        }
+        return bits;
+    }
+
+    InputStream& stream;
+};
+
+namespace detail
+{
+
+constexpr std::uint8_t BINARY_NULL_MARKER = 0x00;
+constexpr std::uint8_t BINARY_VALUE_MARKER = 0x01;
+constexpr std::size_t MAX_UPFRONT_RESERVATION = 64 * 1024;
+
+template <typename Archive, typename Tuple, std::size_t... Indices>
+void processTupleElements(Archive& archive, Tuple& tuple, std::index_sequence<Indices...>)
+{
+    archive(std::get<Indices>(tuple)...);
+}
+
+template <typename Archive, typename Tuple>
+void processTupleElements(Archive&, Tuple&, std::index_sequence<>)
+{
+}
+
+template <typename T>
+using IsByteSized = std::integral_constant<bool,
+                                           std::is_integral<T>::value &&
+                                                   !std::is_same<T, bool>::value &&
+                                                   sizeof(T) == 1>;
+
+template <typename T>
+std::string serializeToEmbeddedJson(const T& value)
+{
+    muesli::StringOStream stream;
+    muesli::JsonOutputArchive<muesli::StringOStream> archive(stream);
+    archive(value);
+    return stream.getString();
+}
+
+template <typename T>
+void deserializeFromEmbeddedJson(T& value, std::string&& json)
+{
+    muesli::StringIStream stream(std::move(json));
+    auto archive = std::make_shared<muesli::JsonInputArchive<muesli::StringIStream>>(stream);
+    (*archive)(value);
+}
+
+} // namespace detail
+
+// fundamental types
+
+template <typename OutputStream, typename T>
+std::enable_if_t<std::is_arithmetic<std::decay_t<T>>::value> serialize(
+        BinaryOutputArchive<OutputStream>& archive,
+        T& value)
+{
+    archive.writeValue(static_cast<std::decay_t<T>>(value));
+}
+
+template <typename InputStream, typename T>
+std::enable_if_t<std::is_arithmetic<T>::value> serialize(BinaryInputArchive<InputStream>& archive,
+                                                         T& value)
+{
+    archive.readValue(value);
+}
+
+template <typename OutputStream, typename T>
+std::enable_if_t<std::is_enum<std::decay_t<T>>::value> serialize(
+        BinaryOutputArchive<OutputStream>& archive,
+        T& value)
+{
+    using Underlying = std::underlying_type_t<std::decay_t<T>>;
+    archive.writeValue(static_cast<Underlying>(value));
+}
+
+template <typename InputStream, typename T>
+std::enable_if_t<std::is_enum<T>::value> serialize(BinaryInputArchive<InputStream>& archive,
+                                                   T& value)
+{
+    std::underlying_type_t<T> underlying;
+    archive.readValue(underlying);
+    value = static_cast<T>(underlying);
+}
+
+template <typename OutputStream, typename T>
+std::enable_if_t<std::is_same<std::decay_t<T>, std::string>::value> serialize(
+        BinaryOutputArchive<OutputStream>& archive,
+        T& value)
+{
+    archive.writeValue(value);
+}
+
+template <typename InputStream>
+void serialize(BinaryInputArchive<InputStream>& archive, std::string& value)
+{
+    archive.readValue(value);
+}
+
+template <typename OutputStream, typename T>
+std::enable_if_t<std::is_same<std::decay_t<T>, std::nullptr_t>::value> serialize(
+        BinaryOutputArchive<OutputStream>& archive,
+        T&)
+{
+    archive.writeByte(detail::BINARY_NULL_MARKER);
+}
+
+template <typename InputStream>
+void serialize(BinaryInputArchive<InputStream>& archive, std::nullptr_t&)
+{
+    if (archive.readByte() != detail::BINARY_NULL_MARKER) {
+        throw std::invalid_argument("expected null in binary payload");
+    }
+}
+
+// name-value pairs
+
+template <typename OutputStream, typename T>
+void serialize(BinaryOutputArchive<OutputStream>& archive, muesli::NameValuePair<T>& nvp)
+{
+    archive(nvp.value);
+}
+
+template <typename InputStream, typename T>
+void serialize(BinaryInputArchive<InputStream>& archive, muesli::NameValuePair<T>& nvp)
+{
+    archive(nvp.value);
+}
+
+// containers
+
+template <typename OutputStream, typename T, typename Allocator>
+void serialize(BinaryOutputArchive<OutputStream>& archive, const std::vector<T, Allocator>& vector)
+{
+    archive.writeVarint(vector.size());
+    if (detail::IsByteSized<T>::value) {
+        archive.writeBytes(vector.data(), vector.size());
+        return;
+    }
+    for (const auto& element : vector) {
+        archive(element);
+    }
+}
+
+template <typename OutputStream, typename Allocator>
+void serialize(BinaryOutputArchive<OutputStream>& archive,
+               const std::vector<bool, Allocator>& vector)
+{
+    archive.writeVarint(vector.size());
+    for (const bool element : vector) {
+        archive.writeValue(element);
+    }
+}
+
+template <typename InputStream, typename T, typename Allocator>
+void serialize(BinaryInputArchive<InputStream>& archive, std::vector<T, Allocator>& vector)
+{
+    const std::size_t size = archive.readLength();
+    vector.clear();
+    // do not trust the length prefix of a malformed payload to allocate memory upfront
+    vector.reserve(std::min<std::size_t>(size, detail::MAX_UPFRONT_RESERVATION));
+    for (std::size_t i = 0; i < size; ++i) {
+        T element;
+        archive(element);
+        vector.push_back(std::move(element));
+    }
+}
+
+template <typename InputStream, typename Allocator>
+void serialize(BinaryInputArchive<InputStream>& archive, std::vector<bool, Allocator>& vector)
+{
+    const std::size_t size = archive.readLength();
+    vector.clear();
+    for (std::size_t i = 0; i < size; ++i) {
+        bool element;
+        archive.readValue(element);
+        vector.push_back(element);
+    }
+}
+
+namespace detail
+{
+
+template <typename OutputStream, typename Map>
+void saveMap(BinaryOutputArchive<OutputStream>& archive, const Map& map)
+{
+    archive.writeVarint(map.size());
+    for (const auto& entry : map) {
+        archive(entry.first, entry.second);
+    }
+}
+
+template <typename InputStream, typename Map>
+void loadMap(BinaryInputArchive<InputStream>& archive, Map& map)
+{
+    const std::size_t size = archive.readLength();
+    map.clear();
+    for (std::size_t i = 0; i < size; ++i) {
+        typename Map::key_type key;
+        typename Map::mapped_type value;
+        archive(key, value);
+        map.emplace(std::move(key), std::move(value));
+    }
+}
+
+} // namespace detail
+
+template <typename OutputStream, typename K, typename V, typename Compare, typename Allocator>
+void serialize(BinaryOutputArchive<OutputStream>& archive,
+               const std::map<K, V, Compare, Allocator>& map)
+{
+    detail::saveMap(archive, map);
+}
+
+template <typename InputStream, typename K, typename V, typename Compare, typename Allocator>
+void serialize(BinaryInputArchive<InputStream>& archive, std::map<K, V, Compare, Allocator>& map)
+{
+    detail::loadMap(archive, map);
+}
+
+template <typename OutputStream,
+          typename K,
+          typename V,
+          typename Hash,
+          typename KeyEqual,
+          typename Allocator>
+void serialize(BinaryOutputArchive<OutputStream>& archive,
+               const std::unordered_map<K, V, Hash, KeyEqual, Allocator>& map)
+{
+    detail::saveMap(archive, map);
+}
+
+template <typename InputStream,
+          typename K,
+          typename V,
+          typename Hash,
+          typename KeyEqual,
+          typename Allocator>
+void serialize(BinaryInputArchive<InputStream>& archive,
+               std::unordered_map<K, V, Hash, KeyEqual, Allocator>& map)
+{
+    detail::loadMap(archive, map);
+}
+
+template <typename OutputStream, typename... Ts>
+void serialize(BinaryOutputArchive<OutputStream>& archive, const std::tuple<Ts...>& tuple)
+{
+    archive.writeByte(detail::BINARY_VALUE_MARKER);
+    archive.beginLengthDelimited();
+    detail::processTupleElements(archive, tuple, std::index_sequence_for<Ts...>{});
+    archive.endLengthDelimited();
+}
+
+template <typename InputStream, typename... Ts>
+void serialize(BinaryInputArchive<InputStream>& archive, std::tuple<Ts...>& tuple)
+{
+    if (archive.readByte() != detail::BINARY_VALUE_MARKER) {
+        throw std::invalid_argument("expected tuple in binary payload");
+    }
+    archive.readLength();
+    detail::processTupleElements(archive, tuple, std::index_sequence_for<Ts...>{});
+}
+
+// pointers
+
+namespace detail
+{
+
+template <typename OutputStream, typename T>
+void savePointee(BinaryOutputArchive<OutputStream>& archive,
+                 const std::shared_ptr<T>& pointer,
+                 std::true_type /*isPolymorphic*/)
+{
+    archive.writeValue(serializeToEmbeddedJson(pointer));
+}
+
+template <typename OutputStream, typename T>
+void savePointee(BinaryOutputArchive<OutputStream>& archive,
+                 const std::shared_ptr<T>& pointer,
+                 std::false_type /*isPolymorphic*/)
+{
+    archive(*pointer);
+}
+
+} // namespace detail
+
+template <typename OutputStream, typename T>
+void serialize(BinaryOutputArchive<OutputStream>& archive, const std::shared_ptr<T>& pointer)
+{
+    if (!pointer) {
+        archive.writeByte(detail::BINARY_NULL_MARKER);
+        return;
+    }
+    archive.writeByte(detail::BINARY_VALUE_MARKER);
+    detail::savePointee(archive, pointer, std::is_polymorphic<T>{});
+}
+
+namespace detail
+{
+
+template <typename InputStream, typename T>
+void loadPointee(BinaryInputArchive<InputStream>& archive,
+                 std::shared_ptr<T>& pointer,
+                 std::true_type /*isPolymorphic*/)
+{
+    std::string json;
+    archive.readValue(json);
+    deserializeFromEmbeddedJson(pointer, std::move(json));
+}
+
+template <typename InputStream, typename T>
+void loadPointee(BinaryInputArchive<InputStream>& archive,
+                 std::shared_ptr<T>& pointer,
+                 std::false_type /*isPolymorphic*/)
+{
+    auto value = std::make_shared<std::remove_const_t<T>>();
+    archive(*value);
+    pointer = std::move(value);
+}
+
+} // namespace detail
+
+template <typename InputStream, typename T>
+void serialize(BinaryInputArchive<InputStream>& archive, std::shared_ptr<T>& pointer)
+{
+    if (archive.readByte() == detail::BINARY_NULL_MARKER) {
+        pointer.reset();
+        return;
+    }
+    detail::loadPointee(archive, pointer, std::is_polymorphic<T>{});
+}
+
+} // namespace serializer
+} // namespace joynr
+
+MUESLI_REGISTER_OUTPUT_ARCHIVE(joynr::serializer::BinaryOutputArchive,
+                               joynr::serializer::tags::binary)
+MUESLI_REGISTER_INPUT_ARCHIVE(joynr::serializer::BinaryInputArchive,
+                              joynr::serializer::tags::binary)
+
+#endif // BINARYARCHIVE_H
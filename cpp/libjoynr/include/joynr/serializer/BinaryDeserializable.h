@@ -0,0 +1,93 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef BINARYDESERIALIZABLE_H
+#define BINARYDESERIALIZABLE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/serializer/BinaryArchive.h"
+#include "joynr/serializer/ByteArrayViewIStream.h"
+#include "joynr/serializer/SerializerTraits.h"
+
+namespace joynr
+{
+namespace serializer
+{
+
+template <typename Archive>
+class BinaryDeserializable
+{
+public:
+    /**
+     * The tuple is length delimited in the binary format, hence its encoded elements
+     * are kept until the expected types are known in @ref get.
+     */
+    explicit BinaryDeserializable(Archive& archive) : encodedElements()
+    {
+        if (archive.readByte() == detail::BINARY_NULL_MARKER) {
+            return;
+        }
+        const std::size_t length = archive.readLength();
+        encodedElements = std::make_shared<std::vector<std::uint8_t>>();
+        encodedElements->reserve(std::min<std::size_t>(length, detail::MAX_UPFRONT_RESERVATION));
+        for (std::size_t i = 0; i < length; ++i) {
+            encodedElements->push_back(archive.readByte());
+        }
+    }
+
+    template <typename Tuple>
+    void get(Tuple&& value)
+    {
+        assert(encodedElements);
+        ByteArrayViewIStream stream(
+                smrf::ByteArrayView(encodedElements->data(), encodedElements->size()));
+        BinaryInputArchive<ByteArrayViewIStream> archive(stream);
+        detail::processTupleElements(
+                archive,
+                value,
+                std::make_index_sequence<std::tuple_size<std::decay_t<Tuple>>::value>{});
+        encodedElements.reset();
+    }
+
+private:
+    std::shared_ptr<std::vector<std::uint8_t>> encodedElements;
+};
+
+template <>
+struct SerializerTraits<tags::binary>
+{
+    static constexpr const char* id()
+    {
+        return "binary";
+    }
+    template <typename Archive>
+    using Deserializable = BinaryDeserializable<Archive>;
+};
+
+} // namespace serializer
+} // namespace joynr
+
+#endif // BINARYDESERIALIZABLE_H
@@ -0,0 +1,105 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef BYTEARRAYVIEWISTREAM_H
+#define BYTEARRAYVIEWISTREAM_H
+
+#include <cassert>
+#include <cstddef>
+
+#include <muesli/StreamRegistry.h>
+#include <smrf/ByteArrayView.h>
+
+namespace joynr
+{
+namespace serializer
+{
+
+/**
+ * @brief Input stream which reads directly from the memory referenced by a smrf::ByteArrayView
+ *
+ * The stream fulfills the stream concept required by the muesli input archives, so a message
+ * body can be parsed in place without copying it into a std::string first.
+ * The referenced memory is not required to be null-terminated; it must outlive the stream.
+ *
+ * @note The stream is registered with muesli, hence this header must be included before
+ *      muesli/ArchiveRegistry.h (see joynr/serializer/Serializer.h).
+ */
+class ByteArrayViewIStream
+{
+public:
+    using Ch = char;
+
+    explicit ByteArrayViewIStream(const smrf::ByteArrayView& byteArrayView)
+            : begin(reinterpret_cast<const Ch*>(byteArrayView.data())),
+              current(begin),
+              end(begin + byteArrayView.size())
+    {
+    }
+
+    Ch Peek() const
+    {
+        return current == end ? '\0' : *current;
+    }
+
+    Ch Take()
+    {
+        return current == end ? '\0' : *current++;
+    }
+
+    std::size_t Tell() const
+    {
+        return static_cast<std::size_t>(current - begin);
+    }
+
+    // the following methods are required by the stream concept but are not supported
+
+    Ch* PutBegin()
+    {
+        assert(false);
+        return nullptr;
+    }
+
+    void Put(Ch)
+    {
+        assert(false);
+    }
+
+    void Flush()
+    {
+        assert(false);
+    }
+
+    std::size_t PutEnd(Ch*)
+    {
+        assert(false);
+        return 0;
+    }
+
+private:
+    const Ch* const begin;
+    const Ch* current;
+    const Ch* const end;
+};
+
+} // namespace serializer
+} // namespace joynr
+
+MUESLI_REGISTER_ISTREAM(joynr::serializer::ByteArrayViewIStream)
+
+#endif // BYTEARRAYVIEWISTREAM_H
@@ -102,10 +102,23 @@ public:
     template <typename... Ts>
     void setData(Ts&&... arg)
     {
-        serializable = std::make_unique<Serializable<OutputArchiveRefVariant, std::decay_t<Ts>...>>(
+        serializable = std::make_shared<Serializable<OutputArchiveRefVariant, std::decay_t<Ts>...>>(
                 std::forward<Ts>(arg)...);
     }
 
+    /**
+     * @brief Creates a placeholder which refers to the outbound data of this placeholder.
+     * Outbound data is not modified once it has been set, therefore it is shared instead
+     * of being copied, e.g. to hand it over to a provider in the same process.
+     */
+    SerializationPlaceholder shareOutboundData() const
+    {
+        assert(containsOutboundData());
+        SerializationPlaceholder placeholder;
+        placeholder.serializable = serializable;
+        return placeholder;
+    }
+
     bool containsOutboundData() const
     {
         return serializable != nullptr;
@@ -117,7 +130,7 @@ public:
     }
 
 private:
-    std::unique_ptr<ISerializable<OutputArchiveRefVariant>> serializable;
+    std::shared_ptr<ISerializable<OutputArchiveRefVariant>> serializable;
     boost::optional<DeserializableVariant> deserializable;
 };
 
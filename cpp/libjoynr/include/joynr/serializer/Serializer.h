@@ -25,14 +25,17 @@
 
 #include <boost/mpl/identity.hpp>
 #include <boost/mpl/transform.hpp>
+#include <boost/optional.hpp>
 #include <boost/variant.hpp>
 
 // order of includes is relevant due to muesli's registration mechanism
 // clang-format off
 #include <muesli/archives/json/JsonInputArchive.h>
 #include <muesli/archives/json/JsonOutputArchive.h>
+#include "joynr/serializer/BinaryArchive.h"
 #include <muesli/streams/StringIStream.h>
 #include <muesli/streams/StringOStream.h>
+#include "joynr/serializer/ByteArrayViewIStream.h"
 #include <muesli/ArchiveRegistry.h>
 #include <muesli/TypeRegistry.h>
 #include <muesli/Registry.h>
@@ -41,6 +44,7 @@
 #include <smrf/ByteArrayView.h>
 
 #include "joynr/Util.h"
+#include "joynr/serializer/BinaryDeserializable.h"
 #include "joynr/serializer/JsonDeserializable.h"
 
 namespace joynr
@@ -147,10 +151,8 @@ void deserializeFromJson(T& value, std::string&& str)
 template <typename T>
 void deserializeFromJson(T& value, const smrf::ByteArrayView& byteArrayView)
 {
-    // TODO we need to be able to directly parse from a smrf::ByteVector
-    // without having to copy to a string
-    std::string str(byteArrayView.data(), byteArrayView.data() + byteArrayView.size());
-    deserializeFromJson(value, std::move(str));
+    ByteArrayViewIStream stream(byteArrayView);
+    detail::deserializeFromJson(value, stream);
 }
 
 template <typename T>
@@ -164,6 +166,43 @@ std::string serializeToJson(const T& value)
     return ostream.getString();
 }
 
+/**
+ * @brief Serializes a message payload with the archive registered for serializerId
+ * @throw std::invalid_argument if no archive is registered for serializerId
+ */
+template <typename T>
+std::string serialize(const T& value, const std::string& serializerId)
+{
+    if (serializerId == SerializerTraits<muesli::tags::json>::id()) {
+        return serializeToJson(value);
+    }
+    muesli::StringOStream ostream;
+    auto oarchive = getOutputArchive(serializerId, ostream);
+    oarchive(value);
+    return ostream.getString();
+}
+
+/**
+ * @brief Deserializes a message payload with the archive registered for serializerId
+ * @param serializerId the id given by the serializer header of the message;
+ *      JSON is used if the header is not set
+ * @throw std::invalid_argument if no archive is registered for serializerId
+ *      or the payload cannot be parsed
+ */
+template <typename T>
+void deserialize(T& value,
+                 const smrf::ByteArrayView& byteArrayView,
+                 const boost::optional<std::string>& serializerId)
+{
+    if (!serializerId || *serializerId == SerializerTraits<muesli::tags::json>::id()) {
+        deserializeFromJson(value, byteArrayView);
+        return;
+    }
+    ByteArrayViewIStream stream(byteArrayView);
+    auto iarchive = getInputArchive(*serializerId, stream);
+    iarchive(value);
+}
+
 } // namespace serializer
 } // namespace joynr
 
@@ -21,6 +21,7 @@
 #include <cassert>
 #include <functional>
 #include <sstream>
+#include <vector>
 
 #include <boost/asio/io_service.hpp>
 #include <spdlog/fmt/fmt.h>
@@ -65,14 +66,16 @@ AbstractMessageRouter::AbstractMessageRouter(
           messagingSettings(messagingSettings),
           persistRoutingTable(persistRoutingTable),
           messagingStubFactory(std::move(messagingStubFactory)),
-          messageScheduler(std::make_shared<ThreadPoolDelayedScheduler>(1,
-                                                                        "AbstractMessageRouter",
-                                                                        ioService)),
+          messageScheduler(std::make_shared<ShardedThreadPoolDelayedScheduler>(
+                  messagingSettings.getMessageRouterThreadPoolSize(),
+                  "AbstractMessageRouter",
+                  ioService)),
           messageQueue(std::move(messageQueue)),
           messageQueueRetryLock(),
           transportNotAvailableQueue(std::move(transportNotAvailableQueue)),
           transportAvailabilityMutex(),
           routingTableFileName(),
+          routingTableJournal(),
           addressCalculator(std::move(addressCalculator)),
           messageQueueCleanerTimer(ioService),
           messageQueueCleanerTimerPeriodMs(std::chrono::milliseconds(1000)),
@@ -110,6 +113,9 @@ void AbstractMessageRouter::shutdown()
     messageQueueCleanerTimer.cancel();
     routingTableCleanerTimer.cancel();
     messageScheduler->shutdown();
+    if (routingTableJournal) {
+        routingTableJournal->shutdown();
+    }
     if (messagingStubFactory) {
         messagingStubFactory->shutdown();
     }
@@ -133,12 +139,10 @@ AbstractMessageRouter::AddressUnorderedSet AbstractMessageRouter::lookupAddresse
     // this method gets called from getDestinationAddresses()
     AbstractMessageRouter::AddressUnorderedSet addresses;
 
-    std::shared_ptr<const joynr::system::RoutingTypes::Address> destAddress;
     for (const auto& participantId : participantIds) {
-        const auto routingEntry = routingTable.lookupRoutingEntryByParticipantId(participantId);
-        if (routingEntry) {
-            destAddress = routingEntry->address;
-            addresses.insert(destAddress);
+        auto destAddress = routingTable.lookupAddressByParticipantId(participantId);
+        if (destAddress) {
+            addresses.insert(std::move(destAddress));
         }
     }
     assert(addresses.size() <= participantIds.size());
@@ -152,7 +156,7 @@ AbstractMessageRouter::AddressUnorderedSet AbstractMessageRouter::getDestination
     assert(messageQueueRetryReadLock.owns_lock());
     ReadLocker lock(routingTableLock);
     AbstractMessageRouter::AddressUnorderedSet addresses;
-    if (message.getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+    if (message.getMessageType() == MessageType::MULTICAST) {
         const std::string& multicastId = message.getRecipient();
 
         // lookup local multicast receivers
@@ -170,10 +174,14 @@ AbstractMessageRouter::AddressUnorderedSet AbstractMessageRouter::getDestination
             }
         }
     } else {
-        const std::string& destinationPartId = message.getRecipient();
-        const auto routingEntry = routingTable.lookupRoutingEntryByParticipantId(destinationPartId);
-        if (routingEntry) {
-            addresses.insert(routingEntry->address);
+        auto destAddress =
+                routingTable.lookupAddressByParticipantIdHandle(message.getRecipientHandle());
+        if (!destAddress) {
+            // the recipient was not known when the message was created, e.g. a queued message
+            destAddress = routingTable.lookupAddressByParticipantId(message.getRecipient());
+        }
+        if (destAddress) {
+            addresses.insert(std::move(destAddress));
         }
     }
     return addresses;
@@ -198,12 +206,11 @@ void AbstractMessageRouter::registerGlobalRoutingEntryIfRequired(const Immutable
         return;
     }
 
-    const std::string& messageType = message.getType();
+    const MessageType messageType = message.getMessageType();
 
-    if (messageType == Message::VALUE_MESSAGE_TYPE_REQUEST() ||
-        messageType == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REQUEST() ||
-        messageType == Message::VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST() ||
-        messageType == Message::VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST()) {
+    if (messageType == MessageType::REQUEST || messageType == MessageType::SUBSCRIPTION_REQUEST ||
+        messageType == MessageType::BROADCAST_SUBSCRIPTION_REQUEST ||
+        messageType == MessageType::MULTICAST_SUBSCRIPTION_REQUEST) {
 
         boost::optional<std::string> optionalReplyTo = message.getReplyTo();
 
@@ -276,26 +283,29 @@ void AbstractMessageRouter::sendMessages(
                     "sendMessages: sending messages for destinationPartId {} and {}",
                     destinationPartId,
                     address->toString());
-    while (true) {
+    std::vector<std::shared_ptr<ImmutableMessage>> messages =
+            messageQueue->takeAllFor(destinationPartId);
+    for (auto it = messages.begin(); it != messages.end(); ++it) {
         // We have to check all the time whether the messaging stub is still available because
         // it will be deleted if a disconnect occurs (this may happen while this method
         // is being executed).
         auto messagingStub = messagingStubFactory->create(address);
 
         if (messagingStub == nullptr) {
+            // put back the messages which have not been scheduled yet, keeping their order
+            for (; it != messages.end(); ++it) {
+                messageQueue->queueMessage(destinationPartId, std::move(*it));
+            }
             break;
         }
 
-        std::shared_ptr<ImmutableMessage> item(messageQueue->getNextMessageFor(destinationPartId));
-        if (!item) {
-            break;
-        }
-
+        std::shared_ptr<ImmutableMessage>& item = *it;
         try {
             const std::uint32_t tryCount = 0;
             messageScheduler->schedule(
                     std::make_shared<MessageRunnable>(
                             item, std::move(messagingStub), address, shared_from_this(), tryCount),
+                    address->hashCode(),
                     std::chrono::milliseconds(0));
             JOYNR_LOG_INFO(logger(), "Rescheduled message {}", item->getTrackingInfo());
         } catch (const exceptions::JoynrMessageNotSentException& e) {
@@ -332,11 +342,15 @@ void AbstractMessageRouter::scheduleMessage(
 
     auto stub = messagingStubFactory->create(destAddress);
     if (stub) {
+        // messages to the same destination are always executed by the same shard
+        // in order to preserve their order
+        const std::size_t shardKey = destAddress->hashCode();
         messageScheduler->schedule(std::make_shared<MessageRunnable>(std::move(message),
                                                                      std::move(stub),
                                                                      std::move(destAddress),
                                                                      shared_from_this(),
                                                                      tryCount),
+                                   shardKey,
                                    delay);
     } else {
         JOYNR_LOG_WARN(logger(),
@@ -395,8 +409,8 @@ void AbstractMessageRouter::rescheduleQueuedMessagesForTransport(
     // We need to lock the mutex to prevent other threads from adding new content for the queue
     // while we process it.
     std::lock_guard<std::mutex> lock(transportAvailabilityMutex);
-    while (auto nextImmutableMessage =
-                   transportNotAvailableQueue->getNextMessageFor(transportStatus)) {
+    for (const auto& nextImmutableMessage :
+         transportNotAvailableQueue->takeAllFor(transportStatus)) {
         try {
             route(nextImmutableMessage);
         } catch (const exceptions::JoynrRuntimeException& e) {
@@ -419,6 +433,7 @@ void AbstractMessageRouter::onMessageCleanerTimerExpired(
                        "#routedMessages[this={}]: {}",
                        thisAsHexString.str(),
                        thisSharedPtr->numberOfRoutedMessages);
+        thisSharedPtr->logMessageSchedulerStatistics();
         WriteLocker lock(thisSharedPtr->messageQueueRetryLock);
         thisSharedPtr->messageQueue->removeOutdatedMessages();
         thisSharedPtr->transportNotAvailableQueue->removeOutdatedMessages();
@@ -467,32 +482,39 @@ void AbstractMessageRouter::loadRoutingTable(std::string fileName)
         routingTableFileName = std::move(fileName);
     }
 
-    if (!joynr::util::fileExists(routingTableFileName)) {
-        return;
+    if (routingTableJournal) {
+        routingTableJournal->shutdown();
     }
 
     WriteLocker lock(routingTableLock);
-    try {
-        joynr::serializer::deserializeFromJson(
-                routingTable, joynr::util::loadStringFromFile(routingTableFileName));
-    } catch (const std::runtime_error& ex) {
-        JOYNR_LOG_ERROR(logger(), ex.what());
-    } catch (const std::invalid_argument& ex) {
-        JOYNR_LOG_ERROR(logger(), "could not deserialize from JSON: {}", ex.what());
-    }
+    RoutingTableJournal::load(routingTableFileName, routingTable);
+    routingTableJournal = std::make_unique<RoutingTableJournal>(
+            routingTableFileName,
+            [this]() {
+                ReadLocker snapshotLock(routingTableLock);
+                return joynr::serializer::serializeToJson(routingTable);
+            },
+            messagingSettings.getRoutingTableJournalCompactionThreshold());
+    // start with a fresh snapshot containing the replayed journal and all
+    // entries which have been added before the routing table has been loaded
+    routingTableJournal->requestCompaction();
 }
 
 void AbstractMessageRouter::saveRoutingTable()
 {
-    if (!persistRoutingTable) {
+    if (!persistRoutingTable || !routingTableJournal) {
         return;
     }
+    routingTableJournal->requestCompaction();
+    routingTableJournal->flush();
+}
+
+void AbstractMessageRouter::removeFromRoutingTable(const std::string& participantId)
+{
     WriteLocker lock(routingTableLock);
-    try {
-        joynr::util::saveStringToFile(
-                routingTableFileName, joynr::serializer::serializeToJson(routingTable));
-    } catch (const std::runtime_error& ex) {
-        JOYNR_LOG_INFO(logger(), ex.what());
+    routingTable.remove(participantId);
+    if (routingTableJournal) {
+        routingTableJournal->logRemove(participantId);
     }
 }
 
@@ -538,13 +560,18 @@ void AbstractMessageRouter::addToRoutingTable(
             // in case insert fails
         }
 
-        routingTable.add(
-                std::move(participantId), isGloballyVisible, address, expiryDateMs, isSticky);
-    }
-    const joynr::InProcessMessagingAddress* inprocessAddress =
-            dynamic_cast<const joynr::InProcessMessagingAddress*>(address.get());
-    if (!inprocessAddress) {
-        saveRoutingTable();
+        routingTable.add(participantId, isGloballyVisible, address, expiryDateMs, isSticky);
+
+        // journal while still holding the lock to keep the records in order of the mutations
+        const joynr::InProcessMessagingAddress* inprocessAddress =
+                dynamic_cast<const joynr::InProcessMessagingAddress*>(address.get());
+        if (routingTableJournal && !inprocessAddress) {
+            routingTableJournal->logAdd(routingtable::RoutingEntry(std::move(participantId),
+                                                                    address,
+                                                                    isGloballyVisible,
+                                                                    expiryDateMs,
+                                                                    isSticky));
+        }
     }
 }
 
@@ -553,6 +580,28 @@ std::uint64_t AbstractMessageRouter::getNumberOfRoutedMessages() const
     return numberOfRoutedMessages;
 }
 
+std::vector<ShardedThreadPoolDelayedScheduler::ShardStatistics> AbstractMessageRouter::
+        getMessageSchedulerStatistics() const
+{
+    return messageScheduler->getStatistics();
+}
+
+void AbstractMessageRouter::logMessageSchedulerStatistics() const
+{
+    const auto statistics = messageScheduler->getStatistics();
+    for (std::size_t shard = 0; shard < statistics.size(); ++shard) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "messageScheduler shard {}: queueDepth={}, maxQueueDepth={}, "
+                        "executed={}, averageLatency={}us, maxLatency={}us",
+                        shard,
+                        statistics[shard].queueDepth,
+                        statistics[shard].maxQueueDepth,
+                        statistics[shard].executedRunnables,
+                        statistics[shard].averageLatency.count(),
+                        statistics[shard].maxLatency.count());
+    }
+}
+
 /**
  * IMPLEMENTATION of MessageRunnable class
  */
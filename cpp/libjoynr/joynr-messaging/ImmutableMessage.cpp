@@ -29,12 +29,16 @@ namespace joynr
 ImmutableMessage::ImmutableMessage(smrf::ByteVector&& serializedMessage, bool verifyInput)
         : serializedMessage(std::move(serializedMessage)),
           messageDeserializer(smrf::ByteArrayView(this->serializedMessage), verifyInput),
+          sender(),
+          recipient(),
+          recipientHandle(ParticipantIdTable::INVALID_HANDLE),
           headers(),
           bodyView(),
           decompressedBody(),
           receivedFromGlobal(false),
           creator(),
-          requiredHeaders()
+          requiredHeaders(),
+          messageType(MessageType::UNKNOWN)
 {
     init();
 }
@@ -42,24 +46,33 @@ ImmutableMessage::ImmutableMessage(smrf::ByteVector&& serializedMessage, bool ve
 ImmutableMessage::ImmutableMessage(const smrf::ByteVector& serializedMessage, bool verifyInput)
         : serializedMessage(serializedMessage),
           messageDeserializer(smrf::ByteArrayView(this->serializedMessage), verifyInput),
+          sender(),
+          recipient(),
+          recipientHandle(ParticipantIdTable::INVALID_HANDLE),
           headers(),
           bodyView(),
           decompressedBody(),
           receivedFromGlobal(false),
           creator(),
-          requiredHeaders()
+          requiredHeaders(),
+          messageType(MessageType::UNKNOWN)
 {
     init();
 }
 
-std::string ImmutableMessage::getSender() const
+const std::string& ImmutableMessage::getSender() const
 {
-    return messageDeserializer.getSender();
+    return sender;
 }
 
-std::string ImmutableMessage::getRecipient() const
+const std::string& ImmutableMessage::getRecipient() const
 {
-    return messageDeserializer.getRecipient();
+    return recipient;
+}
+
+ParticipantIdTable::Handle ImmutableMessage::getRecipientHandle() const
+{
+    return recipientHandle;
 }
 
 bool ImmutableMessage::isTtlAbsolute() const
@@ -148,12 +161,17 @@ std::string ImmutableMessage::toLogMessage() const
 
 const std::string& ImmutableMessage::getType() const
 {
-    return requiredHeaders.type;
+    return *requiredHeaders.type;
+}
+
+MessageType ImmutableMessage::getMessageType() const
+{
+    return messageType;
 }
 
 const std::string& ImmutableMessage::getId() const
 {
-    return requiredHeaders.id;
+    return *requiredHeaders.id;
 }
 
 boost::optional<std::string> ImmutableMessage::getReplyTo() const
@@ -166,6 +184,11 @@ boost::optional<std::string> ImmutableMessage::getEffort() const
     return getOptionalHeaderByKey(Message::HEADER_EFFORT());
 }
 
+boost::optional<std::string> ImmutableMessage::getSerializer() const
+{
+    return getOptionalHeaderByKey(Message::HEADER_SERIALIZER());
+}
+
 TimePoint ImmutableMessage::getExpiryDate() const
 {
     // for now we only support absolute TTLs
@@ -216,27 +239,37 @@ const std::string& ImmutableMessage::getCreator() const
 boost::optional<std::string> ImmutableMessage::getOptionalHeaderByKey(const std::string& key) const
 {
     boost::optional<std::string> value;
-    auto it = headers.find(key);
-    if (it != headers.cend()) {
-        value = it->second;
+    if (const std::string* header = findHeader(key)) {
+        value = *header;
     }
     return value;
 }
 
+const std::string* ImmutableMessage::findHeader(const std::string& key) const
+{
+    auto it = headers.find(key);
+    return it != headers.cend() ? &it->second : nullptr;
+}
+
 void ImmutableMessage::init()
 {
+    sender = messageDeserializer.getSender();
+    recipient = messageDeserializer.getRecipient();
     headers = messageDeserializer.getHeaders();
-    boost::optional<std::string> optionalId = getOptionalHeaderByKey(Message::HEADER_ID());
-    boost::optional<std::string> optionalType = getOptionalHeaderByKey(Message::HEADER_TYPE());
-
-    JOYNR_LOG_TRACE(logger(), "init: {}", toLogMessage());
+    // the values stay valid when the message is moved, the nodes of the map are not reallocated
+    requiredHeaders.id = findHeader(Message::HEADER_ID());
+    requiredHeaders.type = findHeader(Message::HEADER_TYPE());
 
     // check if necessary headers are set
-    if (!optionalId.is_initialized() || !optionalType.is_initialized()) {
+    if (requiredHeaders.id == nullptr || requiredHeaders.type == nullptr) {
         throw std::invalid_argument("missing header");
-    } else {
-        requiredHeaders.id = std::move(*optionalId);
-        requiredHeaders.type = std::move(*optionalType);
+    }
+    messageType = Message::toMessageType(*requiredHeaders.type);
+
+    // resolved once on arrival, so that routing finds the entry of the recipient without
+    // hashing the participantId again
+    if (messageType != MessageType::MULTICAST) {
+        recipientHandle = ParticipantIdTable::getInstance().find(recipient);
     }
 }
 
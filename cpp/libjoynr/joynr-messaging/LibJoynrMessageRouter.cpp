@@ -35,6 +35,7 @@
 #include "joynr/system/RoutingTypes/BrowserAddress.h"
 #include "joynr/system/RoutingTypes/ChannelAddress.h"
 #include "joynr/system/RoutingTypes/MqttAddress.h"
+#include "joynr/system/RoutingTypes/SharedMemoryClientAddress.h"
 #include "joynr/system/RoutingTypes/WebSocketAddress.h"
 #include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
 
@@ -125,7 +126,7 @@ void LibJoynrMessageRouter::routeInternal(std::shared_ptr<ImmutableMessage> mess
 
         // if destination address is not known
         if (destAddresses.empty()) {
-            if (message->getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+            if (message->getMessageType() == MessageType::MULTICAST) {
                 // Do not queue multicast messages for future multicast receivers.
                 return;
             }
@@ -216,6 +217,12 @@ bool LibJoynrMessageRouter::publishToGlobal(const ImmutableMessage& message)
     return true;
 }
 
+bool LibJoynrMessageRouter::isInProcessShortCircuitAllowed() const
+{
+    // access control is only applied by the cluster controller
+    return true;
+}
+
 bool LibJoynrMessageRouter::isParentMessageRouterSet()
 {
     if (!parentRouter) {
@@ -297,6 +304,14 @@ void LibJoynrMessageRouter::addNextHopToParent(
                                       isGloballyVisible,
                                       std::move(onSuccess),
                                       std::move(onErrorWrapper));
+    } else if (auto sharedMemoryClientAddress = std::dynamic_pointer_cast<
+                       const joynr::system::RoutingTypes::SharedMemoryClientAddress>(
+                       incomingAddress)) {
+        parentRouter->addNextHopAsync(participantId,
+                                      *sharedMemoryClientAddress,
+                                      isGloballyVisible,
+                                      std::move(onSuccess),
+                                      std::move(onErrorWrapper));
     }
 }
 
@@ -324,12 +339,7 @@ void LibJoynrMessageRouter::removeNextHop(
         std::function<void()> onSuccess,
         std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
 {
-    {
-        WriteLocker lock(routingTableLock);
-        routingTable.remove(participantId);
-    }
-
-    saveRoutingTable();
+    removeFromRoutingTable(participantId);
 
     if (!isParentMessageRouterSet()) {
         if (onError) {
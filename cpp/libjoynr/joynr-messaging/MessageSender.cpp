@@ -46,7 +46,8 @@ MessageSender::MessageSender(std::shared_ptr<IMessageRouter> messageRouter,
         : dispatcher(),
           messageRouter(std::move(messageRouter)),
           messageFactory(ttlUpliftMs, std::move(keyChain)),
-          replyToAddress()
+          replyToAddress(),
+          inProcessShortCircuitEnabled(true)
 {
 }
 
@@ -60,6 +61,11 @@ void MessageSender::registerDispatcher(std::weak_ptr<IDispatcher> dispatcher)
     this->dispatcher = std::move(dispatcher);
 }
 
+void MessageSender::setInProcessShortCircuitEnabled(bool enabled)
+{
+    inProcessShortCircuitEnabled = enabled;
+}
+
 void MessageSender::sendRequest(const std::string& senderParticipantId,
                                 const std::string& receiverParticipantId,
                                 const MessagingQos& qos,
@@ -75,6 +81,20 @@ void MessageSender::sendRequest(const std::string& senderParticipantId,
         return;
     }
 
+    assert(messageRouter);
+    if (inProcessShortCircuitEnabled && messageRouter->isInProcessShortCircuitAllowed() &&
+        dispatcherSharedPtr->deliverRequestInProcess(
+                senderParticipantId, receiverParticipantId, qos, request, callback)) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "Send Request in process: method: {}, requestReplyId: {}, "
+                        "proxy participantId: {}, provider participantId: {}",
+                        request.getMethodName(),
+                        request.getRequestReplyId(),
+                        senderParticipantId,
+                        receiverParticipantId);
+        return;
+    }
+
     MutableMessage message = messageFactory.createRequest(
             senderParticipantId, receiverParticipantId, qos, request, isLocalMessage);
     dispatcherSharedPtr->addReplyCaller(request.getRequestReplyId(), std::move(callback), qos);
@@ -19,6 +19,7 @@
 #include "joynr/MessagingSettings.h"
 
 #include <cassert>
+#include <limits>
 
 #include "joynr/BrokerUrl.h"
 #include "joynr/Settings.h"
@@ -317,6 +318,12 @@ const std::string& MessagingSettings::SETTING_ROUTING_TABLE_CLEANUP_INTERVAL_MS(
     return value;
 }
 
+const std::string& MessagingSettings::SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD()
+{
+    static const std::string value("messaging/routing-table-journal-compaction-threshold");
+    return value;
+}
+
 std::int64_t MessagingSettings::DEFAULT_BROKER_TIMEOUT_MS()
 {
     // 20 seconds
@@ -371,6 +378,11 @@ std::int64_t MessagingSettings::DEFAULT_ROUTING_TABLE_CLEANUP_INTERVAL_MS()
     return (60 * 1000);
 }
 
+std::uint32_t MessagingSettings::DEFAULT_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD()
+{
+    return 1000;
+}
+
 const std::string& MessagingSettings::SETTING_SEND_MESSAGE_MAX_TTL()
 {
     static const std::string value("messaging/max-send-ttl");
@@ -400,6 +412,30 @@ bool MessagingSettings::DEFAULT_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS()
     return value;
 }
 
+const std::string& MessagingSettings::SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE()
+{
+    static const std::string value("messaging/message-router-thread-pool-size");
+    return value;
+}
+
+std::uint8_t MessagingSettings::DEFAULT_MESSAGE_ROUTER_THREAD_POOL_SIZE()
+{
+    static const std::uint8_t value = 1;
+    return value;
+}
+
+const std::string& MessagingSettings::SETTING_IO_SERVICE_THREAD_POOL_SIZE()
+{
+    static const std::string value("messaging/io-service-thread-pool-size");
+    return value;
+}
+
+std::uint8_t MessagingSettings::DEFAULT_IO_SERVICE_THREAD_POOL_SIZE()
+{
+    static const std::uint8_t value = 1;
+    return value;
+}
+
 const std::string& MessagingSettings::SETTING_TTL_UPLIFT_MS()
 {
     static const std::string value("messaging/ttl-uplift-ms");
@@ -713,6 +749,17 @@ void MessagingSettings::setRoutingTableCleanupIntervalMs(std::int64_t routingTab
     settings.set(SETTING_ROUTING_TABLE_CLEANUP_INTERVAL_MS(), routingTableCleanupIntervalMs);
 }
 
+std::uint32_t MessagingSettings::getRoutingTableJournalCompactionThreshold() const
+{
+    return settings.get<std::uint32_t>(SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD());
+}
+
+void MessagingSettings::setRoutingTableJournalCompactionThreshold(
+        std::uint32_t compactionThreshold)
+{
+    settings.set(SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD(), compactionThreshold);
+}
+
 bool MessagingSettings::getDiscardUnroutableRepliesAndPublications() const
 {
     return settings.get<bool>(SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS());
@@ -725,6 +772,47 @@ void MessagingSettings::setDiscardUnroutableRepliesAndPublications(
                  discardUnRoutableRepliesAndPublications);
 }
 
+std::uint8_t MessagingSettings::getMessageRouterThreadPoolSize() const
+{
+    const std::int64_t value =
+            settings.get<std::int64_t>(SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE());
+    if (value < 1 || value > std::numeric_limits<std::uint8_t>::max()) {
+        JOYNR_LOG_WARN(logger(),
+                       "invalid value {} for {}, using {}",
+                       value,
+                       SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE(),
+                       DEFAULT_MESSAGE_ROUTER_THREAD_POOL_SIZE());
+        return DEFAULT_MESSAGE_ROUTER_THREAD_POOL_SIZE();
+    }
+    return static_cast<std::uint8_t>(value);
+}
+
+void MessagingSettings::setMessageRouterThreadPoolSize(std::uint8_t messageRouterThreadPoolSize)
+{
+    settings.set(SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE(),
+                 static_cast<std::int64_t>(messageRouterThreadPoolSize));
+}
+
+std::uint8_t MessagingSettings::getIOServiceThreadPoolSize() const
+{
+    const std::int64_t value = settings.get<std::int64_t>(SETTING_IO_SERVICE_THREAD_POOL_SIZE());
+    if (value < 1 || value > std::numeric_limits<std::uint8_t>::max()) {
+        JOYNR_LOG_WARN(logger(),
+                       "invalid value {} for {}, using {}",
+                       value,
+                       SETTING_IO_SERVICE_THREAD_POOL_SIZE(),
+                       DEFAULT_IO_SERVICE_THREAD_POOL_SIZE());
+        return DEFAULT_IO_SERVICE_THREAD_POOL_SIZE();
+    }
+    return static_cast<std::uint8_t>(value);
+}
+
+void MessagingSettings::setIOServiceThreadPoolSize(std::uint8_t ioServiceThreadPoolSize)
+{
+    settings.set(SETTING_IO_SERVICE_THREAD_POOL_SIZE(),
+                 static_cast<std::int64_t>(ioServiceThreadPoolSize));
+}
+
 bool MessagingSettings::contains(const std::string& key) const
 {
     return settings.contains(key);
@@ -822,10 +910,22 @@ void MessagingSettings::checkSettings()
         settings.set(SETTING_ROUTING_TABLE_CLEANUP_INTERVAL_MS(),
                      DEFAULT_ROUTING_TABLE_CLEANUP_INTERVAL_MS());
     }
+    if (!settings.contains(SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD())) {
+        settings.set(SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD(),
+                     DEFAULT_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD());
+    }
     if (!settings.contains(SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS())) {
         settings.set(SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS(),
                      DEFAULT_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS());
     }
+    if (!settings.contains(SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE())) {
+        settings.set(SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE(),
+                     static_cast<std::int64_t>(DEFAULT_MESSAGE_ROUTER_THREAD_POOL_SIZE()));
+    }
+    if (!settings.contains(SETTING_IO_SERVICE_THREAD_POOL_SIZE())) {
+        settings.set(SETTING_IO_SERVICE_THREAD_POOL_SIZE(),
+                     static_cast<std::int64_t>(DEFAULT_IO_SERVICE_THREAD_POOL_SIZE()));
+    }
 }
 
 void MessagingSettings::printSettings() const
@@ -916,11 +1016,23 @@ void MessagingSettings::printSettings() const
                    "SETTING: {} = {})",
                    SETTING_ROUTING_TABLE_CLEANUP_INTERVAL_MS(),
                    settings.get<std::int64_t>(SETTING_ROUTING_TABLE_CLEANUP_INTERVAL_MS()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_ROUTING_TABLE_JOURNAL_COMPACTION_THRESHOLD(),
+                   getRoutingTableJournalCompactionThreshold());
     JOYNR_LOG_INFO(
             logger(),
             "SETTING: {} = {})",
             SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS(),
             settings.get<std::string>(SETTING_DISCARD_UNROUTABLE_REPLIES_AND_PUBLICATIONS()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE(),
+                   settings.get<std::int64_t>(SETTING_MESSAGE_ROUTER_THREAD_POOL_SIZE()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_IO_SERVICE_THREAD_POOL_SIZE(),
+                   settings.get<std::int64_t>(SETTING_IO_SERVICE_THREAD_POOL_SIZE()));
 }
 
 } // namespace joynr
@@ -36,6 +36,7 @@ MutableMessage::MutableMessage()
           id(util::createUuid()),
           replyTo(),
           effort(),
+          serializer(),
           customHeaders(),
           payload(),
           ttlAbsolute(true),
@@ -68,6 +69,9 @@ std::unique_ptr<ImmutableMessage> MutableMessage::getImmutableMessage() const
     if (effort) {
         keyValuePairHeaders.insert({Message::HEADER_EFFORT(), *effort});
     }
+    if (serializer) {
+        keyValuePairHeaders.insert({Message::HEADER_SERIALIZER(), *serializer});
+    }
     keyValuePairHeaders.insert(customHeaders.cbegin(), customHeaders.cend());
     messageSerializer.setHeaders(keyValuePairHeaders);
 
@@ -166,6 +170,16 @@ const boost::optional<std::string>& MutableMessage::getEffort() const
     return effort;
 }
 
+void MutableMessage::setSerializer(const std::string& serializer)
+{
+    this->serializer = serializer;
+}
+
+const boost::optional<std::string>& MutableMessage::getSerializer() const
+{
+    return serializer;
+}
+
 void MutableMessage::setPayload(const std::string& payload)
 {
     this->payload = payload;
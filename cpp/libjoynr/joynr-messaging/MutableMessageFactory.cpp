@@ -41,6 +41,24 @@
 namespace joynr
 {
 
+namespace
+{
+
+// serializes the payload of a request or reply with the serializer selected in qos;
+// the header is only set for non-JSON payloads so that JSON messages stay unchanged
+template <typename Payload>
+std::string serializePayload(MutableMessage& msg, const MessagingQos& qos, const Payload& payload)
+{
+    const std::string& serializerId = qos.getSerializer();
+    if (serializerId == serializer::SerializerTraits<muesli::tags::json>::id()) {
+        return joynr::serializer::serializeToJson(payload);
+    }
+    msg.setSerializer(serializerId);
+    return joynr::serializer::serialize(payload, serializerId);
+}
+
+} // namespace
+
 MutableMessageFactory::MutableMessageFactory(std::uint64_t ttlUpliftMs,
                                              std::shared_ptr<IKeychain> keyChain)
         : securityManager(std::make_unique<DummyPlatformSecurityManager>()),
@@ -63,7 +81,7 @@ MutableMessage MutableMessageFactory::createRequest(const std::string& senderId,
     msg.setType(Message::VALUE_MESSAGE_TYPE_REQUEST());
     msg.setCustomHeader(Message::CUSTOM_HEADER_REQUEST_REPLY_ID(), payload.getRequestReplyId());
     msg.setLocalMessage(isLocalMessage);
-    initMsg(msg, senderId, receiverId, qos, joynr::serializer::serializeToJson(payload));
+    initMsg(msg, senderId, receiverId, qos, serializePayload(msg, qos, payload));
     return msg;
 }
 
@@ -78,7 +96,7 @@ MutableMessage MutableMessageFactory::createReply(
     msg.setType(Message::VALUE_MESSAGE_TYPE_REPLY());
     msg.setCustomHeader(Message::CUSTOM_HEADER_REQUEST_REPLY_ID(), payload.getRequestReplyId());
     msg.setPrefixedCustomHeaders(std::move(prefixedCustomHeaders));
-    initMsg(msg, senderId, receiverId, qos, joynr::serializer::serializeToJson(payload), false);
+    initMsg(msg, senderId, receiverId, qos, serializePayload(msg, qos, payload), false);
     return msg;
 }
 
@@ -91,7 +109,7 @@ MutableMessage MutableMessageFactory::createOneWayRequest(const std::string& sen
     MutableMessage msg;
     msg.setType(Message::VALUE_MESSAGE_TYPE_ONE_WAY());
     msg.setLocalMessage(isLocalMessage);
-    initMsg(msg, senderId, receiverId, qos, joynr::serializer::serializeToJson(payload));
+    initMsg(msg, senderId, receiverId, qos, serializePayload(msg, qos, payload));
     return msg;
 }
 
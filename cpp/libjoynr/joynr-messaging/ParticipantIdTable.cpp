@@ -0,0 +1,257 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/ParticipantIdTable.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+#include <utility>
+
+namespace joynr
+{
+
+constexpr ParticipantIdTable::Handle ParticipantIdTable::INVALID_HANDLE;
+constexpr std::uint32_t ParticipantIdTable::firstChunkSize;
+constexpr std::size_t ParticipantIdTable::maxChunks;
+constexpr std::size_t ParticipantIdTable::numberOfShards;
+
+namespace
+{
+// returns the chunk of a slot and the position of the slot within the chunk
+std::pair<std::size_t, std::uint32_t> locateSlot(std::uint32_t slotIndex,
+                                                 std::uint32_t firstChunkSize)
+{
+    const std::uint64_t position = static_cast<std::uint64_t>(slotIndex) + firstChunkSize;
+    std::size_t chunk = 0;
+    while ((static_cast<std::uint64_t>(firstChunkSize) << (chunk + 1)) <= position) {
+        ++chunk;
+    }
+    return {chunk,
+            static_cast<std::uint32_t>(position - (static_cast<std::uint64_t>(firstChunkSize)
+                                                   << chunk))};
+}
+} // namespace
+
+ParticipantIdTable& ParticipantIdTable::getInstance()
+{
+    static ParticipantIdTable instance;
+    return instance;
+}
+
+ParticipantIdTable::ParticipantIdTable()
+        : chunks(),
+          shards(),
+          slotsMutex(),
+          numberOfSlots(0),
+          freeSlots(),
+          numberOfParticipantIds(0)
+{
+    for (auto& chunk : chunks) {
+        chunk.store(nullptr, std::memory_order_relaxed);
+    }
+    // slot 0 with generation 0 is never handed out, so that INVALID_HANDLE is never valid
+    allocateSlot();
+}
+
+ParticipantIdTable::~ParticipantIdTable()
+{
+    for (auto& chunk : chunks) {
+        delete[] chunk.load(std::memory_order_relaxed);
+    }
+}
+
+ParticipantIdTable::Handle ParticipantIdTable::acquire(const std::string& participantId)
+{
+    const std::uint32_t participantIdHash = hash(participantId);
+    Shard& shard = getShard(participantIdHash);
+    WriteLocker locker(shard.lock);
+    std::uint32_t slotIndex = findSlot(shard, participantId, participantIdHash);
+    if (slotIndex != 0) {
+        Slot& slot = getSlot(slotIndex);
+        slot.referenceCount++;
+        return toHandle(slotIndex, slot.generation);
+    }
+
+    slotIndex = allocateSlot();
+    Slot& slot = getSlot(slotIndex);
+    slot.participantId = std::make_unique<char[]>(participantId.size());
+    std::memcpy(slot.participantId.get(), participantId.data(), participantId.size());
+    slot.length = static_cast<std::uint32_t>(participantId.size());
+    slot.hash = participantIdHash;
+    slot.generation++;
+    slot.referenceCount = 1;
+    insertSlot(shard, slotIndex);
+    numberOfParticipantIds++;
+    return toHandle(slotIndex, slot.generation);
+}
+
+void ParticipantIdTable::release(Handle handle)
+{
+    const std::uint32_t slotIndex = getSlotIndex(handle);
+    assert(slotIndex != 0);
+    Slot& slot = getSlot(slotIndex);
+    // the hash of the slot does not change as long as the caller holds a reference
+    Shard& shard = getShard(slot.hash);
+    {
+        WriteLocker locker(shard.lock);
+        assert(slot.participantId && toHandle(slotIndex, slot.generation) == handle);
+        assert(slot.referenceCount > 0);
+        if (--slot.referenceCount > 0) {
+            return;
+        }
+        eraseSlot(shard, slotIndex);
+        slot.participantId.reset();
+        numberOfParticipantIds--;
+    }
+    std::lock_guard<std::mutex> slotsLock(slotsMutex);
+    freeSlots.push_back(slotIndex);
+}
+
+ParticipantIdTable::Handle ParticipantIdTable::find(const std::string& participantId) const
+{
+    const std::uint32_t participantIdHash = hash(participantId);
+    Shard& shard = getShard(participantIdHash);
+    ReadLocker locker(shard.lock);
+    const std::uint32_t slotIndex = findSlot(shard, participantId, participantIdHash);
+    if (slotIndex == 0) {
+        return INVALID_HANDLE;
+    }
+    return toHandle(slotIndex, getSlot(slotIndex).generation);
+}
+
+std::string ParticipantIdTable::getParticipantId(Handle handle) const
+{
+    const std::uint32_t slotIndex = getSlotIndex(handle);
+    const Slot& slot = getSlot(slotIndex);
+    assert(slot.participantId && toHandle(slotIndex, slot.generation) == handle);
+    return std::string(slot.participantId.get(), slot.length);
+}
+
+std::size_t ParticipantIdTable::size() const
+{
+    return numberOfParticipantIds;
+}
+
+std::uint32_t ParticipantIdTable::hash(const std::string& participantId)
+{
+    const std::size_t fullHash = std::hash<std::string>()(participantId);
+    return static_cast<std::uint32_t>(fullHash ^ (static_cast<std::uint64_t>(fullHash) >> 32));
+}
+
+ParticipantIdTable::Shard& ParticipantIdTable::getShard(std::uint32_t hash) const
+{
+    // the upper bits select the shard, the lower bits the bucket within the shard
+    return shards[hash >> 28];
+}
+
+ParticipantIdTable::Slot& ParticipantIdTable::getSlot(std::uint32_t slotIndex) const
+{
+    const auto location = locateSlot(slotIndex, firstChunkSize);
+    return chunks[location.first].load(std::memory_order_acquire)[location.second];
+}
+
+std::uint32_t ParticipantIdTable::findSlot(const Shard& shard,
+                                           const std::string& participantId,
+                                           std::uint32_t hash) const
+{
+    if (shard.buckets.empty()) {
+        return 0;
+    }
+    const std::size_t mask = shard.buckets.size() - 1;
+    for (std::size_t bucket = hash & mask;; bucket = (bucket + 1) & mask) {
+        const std::uint32_t slotIndex = shard.buckets[bucket];
+        if (slotIndex == 0) {
+            return 0;
+        }
+        const Slot& slot = getSlot(slotIndex);
+        if (slot.hash == hash && slot.length == participantId.size() &&
+            std::memcmp(slot.participantId.get(), participantId.data(), slot.length) == 0) {
+            return slotIndex;
+        }
+    }
+}
+
+void ParticipantIdTable::insertSlot(Shard& shard, std::uint32_t slotIndex)
+{
+    // keep the load factor at or below 1/2 so that probe sequences stay short
+    if ((shard.size + 1) * 2 > shard.buckets.size()) {
+        std::vector<std::uint32_t> oldBuckets(std::max<std::size_t>(16, shard.buckets.size() * 2));
+        oldBuckets.swap(shard.buckets);
+        const std::size_t mask = shard.buckets.size() - 1;
+        for (const std::uint32_t oldSlotIndex : oldBuckets) {
+            if (oldSlotIndex != 0) {
+                std::size_t bucket = getSlot(oldSlotIndex).hash & mask;
+                while (shard.buckets[bucket] != 0) {
+                    bucket = (bucket + 1) & mask;
+                }
+                shard.buckets[bucket] = oldSlotIndex;
+            }
+        }
+    }
+    const std::size_t mask = shard.buckets.size() - 1;
+    std::size_t bucket = getSlot(slotIndex).hash & mask;
+    while (shard.buckets[bucket] != 0) {
+        bucket = (bucket + 1) & mask;
+    }
+    shard.buckets[bucket] = slotIndex;
+    shard.size++;
+}
+
+void ParticipantIdTable::eraseSlot(Shard& shard, std::uint32_t slotIndex)
+{
+    const std::size_t mask = shard.buckets.size() - 1;
+    std::size_t bucket = getSlot(slotIndex).hash & mask;
+    while (shard.buckets[bucket] != slotIndex) {
+        bucket = (bucket + 1) & mask;
+    }
+    // shift the following entries of the probe sequence back, so that no tombstones are needed
+    std::size_t next = (bucket + 1) & mask;
+    while (shard.buckets[next] != 0) {
+        const std::size_t home = getSlot(shard.buckets[next]).hash & mask;
+        const bool homeIsOutsideGap = (bucket <= next) ? (home <= bucket || home > next)
+                                                       : (home <= bucket && home > next);
+        if (homeIsOutsideGap) {
+            shard.buckets[bucket] = shard.buckets[next];
+            bucket = next;
+        }
+        next = (next + 1) & mask;
+    }
+    shard.buckets[bucket] = 0;
+    shard.size--;
+}
+
+std::uint32_t ParticipantIdTable::allocateSlot()
+{
+    std::lock_guard<std::mutex> slotsLock(slotsMutex);
+    if (!freeSlots.empty()) {
+        const std::uint32_t slotIndex = freeSlots.back();
+        freeSlots.pop_back();
+        return slotIndex;
+    }
+    const std::uint32_t slotIndex = numberOfSlots++;
+    const auto location = locateSlot(slotIndex, firstChunkSize);
+    if (location.second == 0) {
+        chunks[location.first].store(new Slot[firstChunkSize << location.first](),
+                                     std::memory_order_release);
+    }
+    return slotIndex;
+}
+
+} // namespace joynr
@@ -19,47 +19,76 @@
 
 #include "joynr/RoutingTable.h"
 
+#include <cassert>
+#include <chrono>
+#include <vector>
+
 namespace joynr
 {
 
-RoutingTable::RoutingTable() : multiIndexContainer()
+constexpr std::uint32_t RoutingTable::entriesPerChunk;
+
+RoutingTable::RoutingTable(ParticipantIdTable& participantIdTable)
+        : participantIdTable(participantIdTable),
+          entryChunks(),
+          addressIndex(),
+          numberOfEntries(0)
 {
 }
 
 RoutingTable::~RoutingTable()
 {
-    JOYNR_LOG_TRACE(logger(), "destructor: number of entries = {}", multiIndexContainer.size());
+    JOYNR_LOG_TRACE(logger(), "destructor: number of entries = {}", numberOfEntries);
+    clear();
 }
 
 boost::optional<routingtable::RoutingEntry> RoutingTable::lookupRoutingEntryByParticipantId(
         const std::string& participantId) const
 {
-    auto& index = boost::multi_index::get<routingtable::tags::ParticipantId>(multiIndexContainer);
-    auto found = index.find(participantId);
-    if (found == index.end()) {
+    const routingtable::InternedRoutingEntry* entry =
+            findEntry(participantIdTable.find(participantId));
+    if (entry == nullptr) {
         return boost::none;
     }
-    return *found;
+    return toRoutingEntry(*entry);
+}
+
+std::shared_ptr<const joynr::system::RoutingTypes::Address> RoutingTable::
+        lookupAddressByParticipantId(const std::string& participantId) const
+{
+    return lookupAddressByParticipantIdHandle(participantIdTable.find(participantId));
+}
+
+std::shared_ptr<const joynr::system::RoutingTypes::Address> RoutingTable::
+        lookupAddressByParticipantIdHandle(ParticipantIdTable::Handle participantIdHandle) const
+{
+    const routingtable::InternedRoutingEntry* entry = findEntry(participantIdHandle);
+    if (entry == nullptr) {
+        return nullptr;
+    }
+    return entry->address;
 }
 
 std::unordered_set<std::string> RoutingTable::lookupParticipantIdsByAddress(
         std::shared_ptr<const joynr::system::RoutingTypes::Address> searchValue) const
 {
     std::unordered_set<std::string> result;
-    const auto& addressIndex =
-            boost::multi_index::get<routingtable::tags::Address>(multiIndexContainer);
-    auto found = addressIndex.equal_range(searchValue);
-    for (auto it = found.first; it != found.second; ++it) {
-        result.insert(it->participantId);
+    auto found = addressIndex.find(searchValue);
+    if (found == addressIndex.cend()) {
+        return result;
+    }
+    for (std::uint32_t slotIndex = found->second; slotIndex != 0;) {
+        const routingtable::InternedRoutingEntry& entry =
+                entryChunks[slotIndex / entriesPerChunk][slotIndex % entriesPerChunk];
+        result.insert(participantIdTable.getParticipantId(entry.participantIdHandle));
+        slotIndex = entry.nextWithSameAddress;
     }
     return result;
 }
 
 bool RoutingTable::containsParticipantId(const std::string& participantId) const
 {
-    auto& index = boost::multi_index::get<routingtable::tags::ParticipantId>(multiIndexContainer);
-    auto found = index.find(participantId);
-    return found != index.end();
+    return findEntry(participantIdTable.find(participantId)) != nullptr;
 }
 
 void RoutingTable::add(const std::string& participantId,
@@ -68,24 +97,48 @@ void RoutingTable::add(const std::string& participantId,
                        std::int64_t expiryDateMs,
                        bool isSticky)
 {
-    routingtable::RoutingEntry routingEntry(participantId,
-                                            std::move(address),
-                                            std::move(isGloballyVisible),
-                                            std::move(expiryDateMs),
-                                            std::move(isSticky));
-    auto result = multiIndexContainer.insert(routingEntry);
-    if (!result.second) {
-        multiIndexContainer.replace(result.first, routingEntry);
+    routingtable::RoutingEntry routingEntry(
+            participantId, std::move(address), isGloballyVisible, expiryDateMs, isSticky);
+    if (insert(participantId, isGloballyVisible, routingEntry.address, expiryDateMs, isSticky)) {
         JOYNR_LOG_INFO(logger(),
-                       "Replaced routing entry: {}, #entries: {}",
+                       "Added routing entry: {}, #entries: {}",
                        routingEntry.toString(),
-                       multiIndexContainer.size());
+                       numberOfEntries);
     } else {
         JOYNR_LOG_INFO(logger(),
-                       "Added routing entry: {}, #entries: {}",
+                       "Replaced routing entry: {}, #entries: {}",
                        routingEntry.toString(),
-                       multiIndexContainer.size());
+                       numberOfEntries);
+    }
+}
+
+bool RoutingTable::insert(const std::string& participantId,
+                          bool isGloballyVisible,
+                          std::shared_ptr<const joynr::system::RoutingTypes::Address> address,
+                          std::int64_t expiryDateMs,
+                          bool isSticky)
+{
+    const ParticipantIdTable::Handle participantIdHandle = participantIdTable.acquire(participantId);
+    const std::uint32_t slotIndex = ParticipantIdTable::getSlotIndex(participantIdHandle);
+    routingtable::InternedRoutingEntry& entry = getOrCreateEntry(slotIndex);
+    const bool isNewEntry = entry.participantIdHandle != participantIdHandle;
+    if (isNewEntry) {
+        // the slot cannot belong to another participantId since this table holds a
+        // reference to the participantId of each of its entries
+        assert(entry.participantIdHandle == ParticipantIdTable::INVALID_HANDLE);
+        entry.participantIdHandle = participantIdHandle;
+        numberOfEntries++;
+    } else {
+        // the replaced entry already holds a reference to the participantId
+        participantIdTable.release(participantIdHandle);
+        unlinkFromAddress(slotIndex);
     }
+    entry.address = std::move(address);
+    entry.expiryDateMs = expiryDateMs;
+    entry.isGloballyVisible = isGloballyVisible;
+    entry.isSticky = isSticky;
+    linkToAddress(slotIndex);
+    return isNewEntry;
 }
 
 void RoutingTable::remove(const std::string& participantId)
@@ -93,31 +146,149 @@ void RoutingTable::remove(const std::string& participantId)
     JOYNR_LOG_INFO(logger(),
                    "Removing routing entry for participantId: {}, #entries before removal: {}",
                    participantId,
-                   multiIndexContainer.size());
-    multiIndexContainer.erase(participantId);
+                   numberOfEntries);
+    const ParticipantIdTable::Handle participantIdHandle = participantIdTable.find(participantId);
+    if (findEntry(participantIdHandle) != nullptr) {
+        removeEntry(ParticipantIdTable::getSlotIndex(participantIdHandle));
+    }
 }
 
 void RoutingTable::purge()
 {
-    bool expiredEntriesFound = false;
-    auto& index = boost::multi_index::get<routingtable::tags::ExpiryDate>(multiIndexContainer);
     auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
                        std::chrono::system_clock::now().time_since_epoch()).count();
-    auto last = index.upper_bound(now);
-    std::vector<std::string> expiredParticipantIds;
-    for (auto routingEntryIterator = index.lower_bound(0); routingEntryIterator != last;
-         ++routingEntryIterator) {
-        if (!routingEntryIterator->isSticky) {
-            expiredParticipantIds.push_back(routingEntryIterator->participantId);
-            expiredEntriesFound = true;
+    std::vector<std::uint32_t> expiredSlotIndices;
+    for (std::uint32_t chunkIndex = 0; chunkIndex < entryChunks.size(); ++chunkIndex) {
+        const routingtable::InternedRoutingEntry* chunk = entryChunks[chunkIndex].get();
+        for (std::uint32_t i = 0; i < entriesPerChunk; ++i) {
+            const routingtable::InternedRoutingEntry& entry = chunk[i];
+            if (entry.participantIdHandle != ParticipantIdTable::INVALID_HANDLE &&
+                !entry.isSticky && entry.expiryDateMs >= 0 && entry.expiryDateMs <= now) {
+                expiredSlotIndices.push_back(chunkIndex * entriesPerChunk + i);
+            }
         }
     }
-    if (expiredEntriesFound) {
+    if (!expiredSlotIndices.empty()) {
         JOYNR_LOG_INFO(logger(), "Purging expired routing entries");
     }
-    for (auto& participantId : expiredParticipantIds) {
-        remove(participantId);
+    for (const std::uint32_t slotIndex : expiredSlotIndices) {
+        JOYNR_LOG_INFO(logger(),
+                       "Removing routing entry for participantId: {}, #entries before removal: {}",
+                       participantIdTable.getParticipantId(getEntry(slotIndex).participantIdHandle),
+                       numberOfEntries);
+        removeEntry(slotIndex);
+    }
+}
+
+std::size_t RoutingTable::size() const
+{
+    return numberOfEntries;
+}
+
+const routingtable::InternedRoutingEntry* RoutingTable::findEntry(
+        ParticipantIdTable::Handle participantIdHandle) const
+{
+    if (participantIdHandle == ParticipantIdTable::INVALID_HANDLE) {
+        return nullptr;
+    }
+    const std::uint32_t slotIndex = ParticipantIdTable::getSlotIndex(participantIdHandle);
+    const std::uint32_t chunkIndex = slotIndex / entriesPerChunk;
+    if (chunkIndex >= entryChunks.size()) {
+        return nullptr;
+    }
+    const routingtable::InternedRoutingEntry& entry =
+            entryChunks[chunkIndex][slotIndex % entriesPerChunk];
+    // a handle of a removed participantId differs in the generation of the slot
+    if (entry.participantIdHandle != participantIdHandle) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+routingtable::InternedRoutingEntry& RoutingTable::getOrCreateEntry(std::uint32_t slotIndex)
+{
+    const std::uint32_t chunkIndex = slotIndex / entriesPerChunk;
+    while (entryChunks.size() <= chunkIndex) {
+        entryChunks.push_back(
+                std::make_unique<routingtable::InternedRoutingEntry[]>(entriesPerChunk));
+    }
+    return getEntry(slotIndex);
+}
+
+routingtable::InternedRoutingEntry& RoutingTable::getEntry(std::uint32_t slotIndex)
+{
+    return entryChunks[slotIndex / entriesPerChunk][slotIndex % entriesPerChunk];
+}
+
+void RoutingTable::linkToAddress(std::uint32_t slotIndex)
+{
+    routingtable::InternedRoutingEntry& entry = getEntry(slotIndex);
+    auto inserted = addressIndex.emplace(entry.address, slotIndex);
+    entry.previousWithSameAddress = 0;
+    if (inserted.second) {
+        entry.nextWithSameAddress = 0;
+        return;
+    }
+    std::uint32_t& firstSlotIndex = inserted.first->second;
+    entry.nextWithSameAddress = firstSlotIndex;
+    getEntry(firstSlotIndex).previousWithSameAddress = slotIndex;
+    firstSlotIndex = slotIndex;
+}
+
+void RoutingTable::unlinkFromAddress(std::uint32_t slotIndex)
+{
+    routingtable::InternedRoutingEntry& entry = getEntry(slotIndex);
+    if (entry.nextWithSameAddress != 0) {
+        getEntry(entry.nextWithSameAddress).previousWithSameAddress =
+                entry.previousWithSameAddress;
+    }
+    if (entry.previousWithSameAddress != 0) {
+        getEntry(entry.previousWithSameAddress).nextWithSameAddress = entry.nextWithSameAddress;
+    } else {
+        auto found = addressIndex.find(entry.address);
+        assert(found != addressIndex.end() && found->second == slotIndex);
+        if (entry.nextWithSameAddress == 0) {
+            addressIndex.erase(found);
+        } else {
+            found->second = entry.nextWithSameAddress;
+        }
+    }
+    entry.previousWithSameAddress = 0;
+    entry.nextWithSameAddress = 0;
+}
+
+void RoutingTable::removeEntry(std::uint32_t slotIndex)
+{
+    unlinkFromAddress(slotIndex);
+    routingtable::InternedRoutingEntry& entry = getEntry(slotIndex);
+    const ParticipantIdTable::Handle participantIdHandle = entry.participantIdHandle;
+    entry = routingtable::InternedRoutingEntry();
+    numberOfEntries--;
+    participantIdTable.release(participantIdHandle);
+}
+
+routingtable::RoutingEntry RoutingTable::toRoutingEntry(
+        const routingtable::InternedRoutingEntry& entry) const
+{
+    return routingtable::RoutingEntry(participantIdTable.getParticipantId(entry.participantIdHandle),
+                                      entry.address,
+                                      entry.isGloballyVisible,
+                                      entry.expiryDateMs,
+                                      entry.isSticky);
+}
+
+void RoutingTable::clear()
+{
+    for (const auto& chunk : entryChunks) {
+        for (std::uint32_t i = 0; i < entriesPerChunk; ++i) {
+            if (chunk[i].participantIdHandle != ParticipantIdTable::INVALID_HANDLE) {
+                participantIdTable.release(chunk[i].participantIdHandle);
+            }
+        }
     }
+    entryChunks.clear();
+    addressIndex.clear();
+    numberOfEntries = 0;
 }
 
 bool RoutingTable::AddressEqual::operator()(
@@ -0,0 +1,239 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/RoutingTableJournal.h"
+
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+
+#include "joynr/RoutingTable.h"
+#include "joynr/Util.h"
+#include "joynr/serializer/Serializer.h"
+
+namespace joynr
+{
+
+namespace
+{
+constexpr char ADD_RECORD = '+';
+constexpr char REMOVE_RECORD = '-';
+} // namespace
+
+RoutingTableJournal::RoutingTableJournal(std::string snapshotFileName,
+                                         SnapshotProvider snapshotProvider,
+                                         std::uint32_t compactionThreshold)
+        : snapshotFileName(std::move(snapshotFileName)),
+          journalFileName(getJournalFileName(this->snapshotFileName)),
+          snapshotProvider(std::move(snapshotProvider)),
+          compactionThreshold(compactionThreshold),
+          numberOfJournalRecords(0),
+          mutex(),
+          workAvailable(),
+          workDone(),
+          pendingRecords(),
+          compactionRequested(false),
+          isBusy(false),
+          isShuttingDown(false),
+          worker()
+{
+    worker = std::thread(&RoutingTableJournal::run, this);
+}
+
+RoutingTableJournal::~RoutingTableJournal()
+{
+    shutdown();
+}
+
+std::string RoutingTableJournal::getJournalFileName(const std::string& snapshotFileName)
+{
+    return snapshotFileName + ".journal";
+}
+
+std::size_t RoutingTableJournal::load(const std::string& snapshotFileName,
+                                      RoutingTable& routingTable)
+{
+    if (util::fileExists(snapshotFileName)) {
+        try {
+            joynr::serializer::deserializeFromJson(
+                    routingTable, util::loadStringFromFile(snapshotFileName));
+        } catch (const std::runtime_error& ex) {
+            JOYNR_LOG_ERROR(logger(), ex.what());
+        } catch (const std::invalid_argument& ex) {
+            JOYNR_LOG_ERROR(logger(), "could not deserialize from JSON: {}", ex.what());
+        }
+    }
+
+    std::ifstream journal(getJournalFileName(snapshotFileName));
+    std::size_t numberOfReplayedRecords = 0;
+    std::string record;
+    while (std::getline(journal, record)) {
+        if (record.empty()) {
+            continue;
+        }
+        if (record[0] == REMOVE_RECORD) {
+            routingTable.remove(record.substr(1));
+        } else if (record[0] == ADD_RECORD) {
+            routingtable::RoutingEntry routingEntry;
+            try {
+                joynr::serializer::deserializeFromJson(routingEntry, record.substr(1));
+            } catch (const std::invalid_argument& ex) {
+                // the last record might have been written partially, ignore the rest
+                JOYNR_LOG_ERROR(logger(),
+                                "could not deserialize journal record {}: {}",
+                                record,
+                                ex.what());
+                break;
+            }
+            routingTable.add(routingEntry.participantId,
+                             routingEntry.isGloballyVisible,
+                             routingEntry.address,
+                             routingEntry.expiryDateMs,
+                             routingEntry.isSticky);
+        } else {
+            JOYNR_LOG_ERROR(logger(), "unknown journal record {}", record);
+            break;
+        }
+        ++numberOfReplayedRecords;
+    }
+    return numberOfReplayedRecords;
+}
+
+void RoutingTableJournal::logAdd(const routingtable::RoutingEntry& routingEntry)
+{
+    append(ADD_RECORD + joynr::serializer::serializeToJson(routingEntry));
+}
+
+void RoutingTableJournal::logRemove(const std::string& participantId)
+{
+    append(REMOVE_RECORD + participantId);
+}
+
+void RoutingTableJournal::append(std::string record)
+{
+    record += '\n';
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isShuttingDown) {
+            JOYNR_LOG_WARN(logger(), "journal already shut down, dropping record {}", record);
+            return;
+        }
+        pendingRecords.push_back(std::move(record));
+    }
+    workAvailable.notify_one();
+}
+
+void RoutingTableJournal::requestCompaction()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isShuttingDown) {
+            return;
+        }
+        compactionRequested = true;
+    }
+    workAvailable.notify_one();
+}
+
+void RoutingTableJournal::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    workDone.wait(lock,
+                  [this]() { return pendingRecords.empty() && !compactionRequested && !isBusy; });
+}
+
+void RoutingTableJournal::shutdown()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (isShuttingDown) {
+            return;
+        }
+        isShuttingDown = true;
+    }
+    workAvailable.notify_one();
+    if (worker.joinable()) {
+        worker.join();
+    }
+}
+
+void RoutingTableJournal::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        workAvailable.wait(lock, [this]() {
+            return isShuttingDown || compactionRequested || !pendingRecords.empty();
+        });
+        if (pendingRecords.empty() && !compactionRequested) {
+            break;
+        }
+
+        std::vector<std::string> records;
+        records.swap(pendingRecords);
+        const bool compactionDue = compactionRequested;
+        compactionRequested = false;
+        isBusy = true;
+        lock.unlock();
+
+        writeRecords(records);
+        // records which are queued while the snapshot is taken end up in the
+        // truncated journal and are replayed on top of the snapshot
+        if (compactionDue || numberOfJournalRecords >= compactionThreshold) {
+            compact();
+        }
+
+        lock.lock();
+        isBusy = false;
+        workDone.notify_all();
+    }
+}
+
+void RoutingTableJournal::writeRecords(const std::vector<std::string>& records)
+{
+    if (records.empty()) {
+        return;
+    }
+    std::string data;
+    for (const auto& record : records) {
+        data += record;
+    }
+    try {
+        util::appendStringToFile(journalFileName, data);
+        numberOfJournalRecords += records.size();
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_ERROR(logger(), "could not append to journal: {}", ex.what());
+    }
+}
+
+void RoutingTableJournal::compact()
+{
+    const std::string temporaryFileName = snapshotFileName + ".tmp";
+    try {
+        util::saveStringToFile(temporaryFileName, snapshotProvider());
+        // rename is atomic, the old snapshot stays valid until the new one is complete
+        boost::filesystem::rename(temporaryFileName, snapshotFileName);
+        util::saveStringToFile(journalFileName, std::string());
+        numberOfJournalRecords = 0;
+    } catch (const std::runtime_error& ex) {
+        JOYNR_LOG_ERROR(logger(), "could not compact routing table journal: {}", ex.what());
+    }
+}
+
+} // namespace joynr
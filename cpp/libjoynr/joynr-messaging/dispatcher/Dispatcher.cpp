@@ -39,9 +39,12 @@
 #include "joynr/SubscriptionRequest.h"
 #include "joynr/SubscriptionStop.h"
 #include "joynr/ThreadPool.h"
+#include "joynr/TimePoint.h"
 #include "joynr/exceptions/JoynrException.h"
 #include "joynr/exceptions/JoynrExceptionUtil.h"
 #include "joynr/serializer/Serializer.h"
+#include "libjoynr/joynr-messaging/dispatcher/InProcessReplyRunnable.h"
+#include "libjoynr/joynr-messaging/dispatcher/InProcessRequestRunnable.h"
 #include "libjoynr/joynr-messaging/dispatcher/ReceivedMessageRunnable.h"
 
 namespace joynr
@@ -157,6 +160,46 @@ void Dispatcher::receive(std::shared_ptr<ImmutableMessage> message)
     handleReceivedMessageThreadPool->execute(receivedMessageRunnable);
 }
 
+bool Dispatcher::deliverRequestInProcess(const std::string& senderParticipantId,
+                                         const std::string& receiverParticipantId,
+                                         const MessagingQos& qos,
+                                         const Request& request,
+                                         std::shared_ptr<IReplyCaller> replyCaller)
+{
+    ReadLocker locker(isShuttingDownLock);
+    if (isShuttingDown) {
+        JOYNR_LOG_TRACE(logger(), "deliverRequestInProcess cancelled, shutting down");
+        return false;
+    }
+
+    std::shared_ptr<RequestCaller> caller = requestCallerDirectory.lookup(receiverParticipantId);
+    if (!caller) {
+        return false;
+    }
+
+    std::shared_ptr<IRequestInterpreter> requestInterpreter =
+            InterfaceRegistrar::instance().getRequestInterpreter(
+                    caller->getInterfaceName() +
+                    std::to_string(caller->getProviderVersion().getMajorVersion()));
+    if (!requestInterpreter) {
+        return false;
+    }
+
+    JOYNR_LOG_TRACE(logger(),
+                    "deliver request in process: requestReplyId: {}, sender: {}, receiver: {}",
+                    request.getRequestReplyId(),
+                    senderParticipantId,
+                    receiverParticipantId);
+    replyCallerDirectory.add(request.getRequestReplyId(), std::move(replyCaller), qos.getTtl());
+    handleReceivedMessageThreadPool->execute(std::make_shared<InProcessRequestRunnable>(
+            request.createInProcessCopy(),
+            std::move(caller),
+            std::move(requestInterpreter),
+            TimePoint::fromRelativeMs(qos.getTtl()),
+            shared_from_this()));
+    return true;
+}
+
 void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message)
 {
     ReadLocker locker(isShuttingDownLock);
@@ -191,7 +234,8 @@ void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message
     // deserialize Request
     Request request;
     try {
-        joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
+        joynr::serializer::deserialize(
+                request, message->getUnencryptedBody(), message->getSerializer());
     } catch (const std::invalid_argument& e) {
         JOYNR_LOG_ERROR(logger(),
                         "Unable to deserialize request object from: {} - error: {}",
@@ -222,6 +266,9 @@ void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message
             const std::chrono::milliseconds ttl = requestExpiryDate.relativeFromNow();
             MessagingQos messagingQos(ttl.count());
             messagingQos.setCompress(message->isCompressed());
+            if (const boost::optional<std::string> serializer = message->getSerializer()) {
+                messagingQos.setSerializer(*serializer);
+            }
             const boost::optional<std::string> effort = message->getEffort();
             if (effort) {
                 try {
@@ -264,6 +311,9 @@ void Dispatcher::handleRequestReceived(std::shared_ptr<ImmutableMessage> message
             const std::chrono::milliseconds ttl = requestExpiryDate.relativeFromNow();
             MessagingQos messagingQos(ttl.count());
             messagingQos.setCompress(message->isCompressed());
+            if (const boost::optional<std::string> serializer = message->getSerializer()) {
+                messagingQos.setSerializer(*serializer);
+            }
             thisSharedPtr->messageSender->sendReply(
                     receiverId, // receiver of the request is sender of reply
                     senderId,   // sender of request is receiver of reply
@@ -316,7 +366,8 @@ void Dispatcher::handleOneWayRequestReceived(std::shared_ptr<ImmutableMessage> m
     // deserialize json
     OneWayRequest request;
     try {
-        joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
+        joynr::serializer::deserialize(
+                request, message->getUnencryptedBody(), message->getSerializer());
     } catch (const std::invalid_argument& e) {
         JOYNR_LOG_ERROR(logger(),
                         "Unable to deserialize request object from: {} - error: {}",
@@ -340,7 +391,8 @@ void Dispatcher::handleReplyReceived(std::shared_ptr<ImmutableMessage> message)
     // deserialize the Reply
     Reply reply;
     try {
-        joynr::serializer::deserializeFromJson(reply, message->getUnencryptedBody());
+        joynr::serializer::deserialize(
+                reply, message->getUnencryptedBody(), message->getSerializer());
     } catch (const std::invalid_argument& e) {
         JOYNR_LOG_ERROR(logger(),
                         "Unable to deserialize reply object from: {} - error {}",
@@ -366,6 +418,85 @@ void Dispatcher::handleReplyReceived(std::shared_ptr<ImmutableMessage> message)
     caller->execute(std::move(reply));
 }
 
+void Dispatcher::handleInProcessRequest(std::shared_ptr<RequestCaller> caller,
+                                        std::shared_ptr<IRequestInterpreter> requestInterpreter,
+                                        Request& request,
+                                        const TimePoint& requestExpiryDate)
+{
+    ReadLocker locker(isShuttingDownLock);
+    if (isShuttingDown) {
+        JOYNR_LOG_TRACE(logger(), "handleInProcessRequest cancelled, shutting down");
+        return;
+    }
+
+    // replies are handed back in the same way, their ttl is the remaining ttl of the request
+    const std::string& requestReplyId = request.getRequestReplyId();
+    auto onSuccess = [
+        requestReplyId,
+        requestExpiryDate,
+        thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())
+    ](Reply && reply) mutable
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            JOYNR_LOG_TRACE(logger(),
+                            "Got in process reply from RequestInterpreter for requestReplyId {}",
+                            requestReplyId);
+            reply.setRequestReplyId(std::move(requestReplyId));
+            thisSharedPtr->handleReceivedMessageThreadPool->execute(
+                    std::make_shared<InProcessReplyRunnable>(
+                            std::move(reply), requestExpiryDate, thisSharedPtr));
+        }
+    };
+
+    auto onError = [
+        requestReplyId,
+        requestExpiryDate,
+        thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())
+    ](const std::shared_ptr<exceptions::JoynrException>& exception) mutable
+    {
+        assert(exception);
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            JOYNR_LOG_WARN(logger(),
+                           "Got error '{}' from RequestInterpreter for requestReplyId {}",
+                           exception->getMessage(),
+                           requestReplyId);
+            Reply reply;
+            reply.setRequestReplyId(std::move(requestReplyId));
+            reply.setError(exception);
+            thisSharedPtr->handleReceivedMessageThreadPool->execute(
+                    std::make_shared<InProcessReplyRunnable>(
+                            std::move(reply), requestExpiryDate, thisSharedPtr));
+        }
+    };
+    locker.unlock();
+
+    // execute request
+    requestInterpreter->execute(
+            std::move(caller), request, std::move(onSuccess), std::move(onError));
+}
+
+void Dispatcher::handleInProcessReply(Reply&& reply)
+{
+    ReadLocker locker(isShuttingDownLock);
+    if (isShuttingDown) {
+        JOYNR_LOG_TRACE(logger(), "handleInProcessReply cancelled, shutting down");
+        return;
+    }
+
+    const std::string& requestReplyId = reply.getRequestReplyId();
+    std::shared_ptr<IReplyCaller> caller = replyCallerDirectory.take(requestReplyId);
+    if (!caller) {
+        // the caller has been removed because its lifetime exceeded TTL
+        JOYNR_LOG_WARN(logger(),
+                       "caller not found in the ReplyCallerDirectory for requestid {}, ignoring",
+                       requestReplyId);
+        return;
+    }
+    locker.unlock();
+
+    caller->execute(std::move(reply));
+}
+
 void Dispatcher::handleSubscriptionRequestReceived(std::shared_ptr<ImmutableMessage> message)
 {
     ReadLocker locker(isShuttingDownLock);
@@ -0,0 +1,55 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/joynr-messaging/dispatcher/InProcessReplyRunnable.h"
+
+#include "joynr/Dispatcher.h"
+
+namespace joynr
+{
+
+InProcessReplyRunnable::InProcessReplyRunnable(Reply&& reply,
+                                               const TimePoint& requestExpiryDate,
+                                               std::weak_ptr<Dispatcher> dispatcher)
+        : Runnable(),
+          ObjectWithDecayTime(requestExpiryDate),
+          reply(std::move(reply)),
+          dispatcher(std::move(dispatcher))
+{
+}
+
+void InProcessReplyRunnable::shutdown()
+{
+}
+
+void InProcessReplyRunnable::run()
+{
+    // a reply message would have been discarded by the message router in this case
+    if (isExpired()) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "Dropping in process reply with requestReplyId {}, because it is expired",
+                        reply.getRequestReplyId());
+        return;
+    }
+
+    if (auto dispatcherSharedPtr = dispatcher.lock()) {
+        dispatcherSharedPtr->handleInProcessReply(std::move(reply));
+    }
+}
+
+} // namespace joynr
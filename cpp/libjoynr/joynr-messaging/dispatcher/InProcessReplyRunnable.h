@@ -0,0 +1,59 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef INPROCESSREPLYRUNNABLE_H
+#define INPROCESSREPLYRUNNABLE_H
+
+#include <memory>
+
+#include "joynr/Logger.h"
+#include "joynr/ObjectWithDecayTime.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/Reply.h"
+#include "joynr/Runnable.h"
+
+namespace joynr
+{
+
+class Dispatcher;
+
+/**
+  * InProcessReplyRunnable is used to hand the reply to a request, which has been
+  * executed by a provider of the same runtime, to the reply caller via the ThreadPool
+  * of the Dispatcher.
+  */
+class InProcessReplyRunnable : public Runnable, public ObjectWithDecayTime
+{
+public:
+    InProcessReplyRunnable(Reply&& reply,
+                           const TimePoint& requestExpiryDate,
+                           std::weak_ptr<Dispatcher> dispatcher);
+    ~InProcessReplyRunnable() = default;
+
+    void shutdown() override;
+    void run() override;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(InProcessReplyRunnable);
+    Reply reply;
+    std::weak_ptr<Dispatcher> dispatcher;
+    ADD_LOGGER(InProcessReplyRunnable)
+};
+
+} // namespace joynr
+#endif // INPROCESSREPLYRUNNABLE_H
@@ -0,0 +1,72 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/joynr-messaging/dispatcher/InProcessRequestRunnable.h"
+
+#include "joynr/CallContext.h"
+#include "joynr/CallContextStorage.h"
+#include "joynr/Dispatcher.h"
+#include "joynr/IRequestInterpreter.h"
+#include "joynr/RequestCaller.h"
+
+namespace joynr
+{
+
+InProcessRequestRunnable::InProcessRequestRunnable(
+        Request&& request,
+        std::shared_ptr<RequestCaller> caller,
+        std::shared_ptr<IRequestInterpreter> requestInterpreter,
+        const TimePoint& requestExpiryDate,
+        std::weak_ptr<Dispatcher> dispatcher)
+        : Runnable(),
+          ObjectWithDecayTime(requestExpiryDate),
+          request(std::move(request)),
+          caller(std::move(caller)),
+          requestInterpreter(std::move(requestInterpreter)),
+          dispatcher(std::move(dispatcher))
+{
+}
+
+void InProcessRequestRunnable::shutdown()
+{
+}
+
+void InProcessRequestRunnable::run()
+{
+    if (isExpired()) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "Dropping in process request with requestReplyId {}, because it is expired",
+                        request.getRequestReplyId());
+        return;
+    }
+
+    auto dispatcherSharedPtr = dispatcher.lock();
+    if (!dispatcherSharedPtr) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "Dropping in process request, because dispatcher not available");
+        return;
+    }
+
+    // requests of the same runtime do not carry a creator, like in process messages
+    CallContextStorage::set(CallContext());
+    dispatcherSharedPtr->handleInProcessRequest(
+            std::move(caller), std::move(requestInterpreter), request, getDecayTime());
+    CallContextStorage::invalidate();
+}
+
+} // namespace joynr
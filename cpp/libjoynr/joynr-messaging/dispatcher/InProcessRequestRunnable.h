@@ -0,0 +1,64 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef INPROCESSREQUESTRUNNABLE_H
+#define INPROCESSREQUESTRUNNABLE_H
+
+#include <memory>
+
+#include "joynr/Logger.h"
+#include "joynr/ObjectWithDecayTime.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/Request.h"
+#include "joynr/Runnable.h"
+
+namespace joynr
+{
+
+class Dispatcher;
+class IRequestInterpreter;
+class RequestCaller;
+
+/**
+  * InProcessRequestRunnable is used to execute a request, which has been handed over
+  * by a proxy of the same runtime, via the ThreadPool of the Dispatcher.
+  */
+class InProcessRequestRunnable : public Runnable, public ObjectWithDecayTime
+{
+public:
+    InProcessRequestRunnable(Request&& request,
+                             std::shared_ptr<RequestCaller> caller,
+                             std::shared_ptr<IRequestInterpreter> requestInterpreter,
+                             const TimePoint& requestExpiryDate,
+                             std::weak_ptr<Dispatcher> dispatcher);
+    ~InProcessRequestRunnable() = default;
+
+    void shutdown() override;
+    void run() override;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(InProcessRequestRunnable);
+    Request request;
+    std::shared_ptr<RequestCaller> caller;
+    std::shared_ptr<IRequestInterpreter> requestInterpreter;
+    std::weak_ptr<Dispatcher> dispatcher;
+    ADD_LOGGER(InProcessRequestRunnable)
+};
+
+} // namespace joynr
+#endif // INPROCESSREQUESTRUNNABLE_H
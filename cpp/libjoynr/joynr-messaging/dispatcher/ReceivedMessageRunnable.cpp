@@ -76,28 +76,40 @@ void ReceivedMessageRunnable::run()
     callContext.setPrincipal(message->getCreator());
     CallContextStorage::set(std::move(callContext));
 
-    if (messageType == Message::VALUE_MESSAGE_TYPE_REQUEST()) {
+    switch (message->getMessageType()) {
+    case MessageType::REQUEST:
         dispatcherSharedPtr->handleRequestReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_REPLY()) {
+        break;
+    case MessageType::REPLY:
         dispatcherSharedPtr->handleReplyReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_ONE_WAY()) {
+        break;
+    case MessageType::ONE_WAY:
         dispatcherSharedPtr->handleOneWayRequestReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REQUEST()) {
+        break;
+    case MessageType::SUBSCRIPTION_REQUEST:
         dispatcherSharedPtr->handleSubscriptionRequestReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST()) {
+        break;
+    case MessageType::BROADCAST_SUBSCRIPTION_REQUEST:
         dispatcherSharedPtr->handleBroadcastSubscriptionRequestReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST()) {
+        break;
+    case MessageType::MULTICAST_SUBSCRIPTION_REQUEST:
         dispatcherSharedPtr->handleMulticastSubscriptionRequestReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()) {
+        break;
+    case MessageType::SUBSCRIPTION_REPLY:
         dispatcherSharedPtr->handleSubscriptionReplyReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+        break;
+    case MessageType::MULTICAST:
         dispatcherSharedPtr->handleMulticastReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_PUBLICATION()) {
+        break;
+    case MessageType::PUBLICATION:
         dispatcherSharedPtr->handlePublicationReceived(std::move(message));
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_STOP()) {
+        break;
+    case MessageType::SUBSCRIPTION_STOP:
         dispatcherSharedPtr->handleSubscriptionStopReceived(std::move(message));
-    } else {
+        break;
+    case MessageType::UNKNOWN:
         JOYNR_LOG_ERROR(logger(), "unknown message type: {}", messageType);
+        break;
     }
 
     CallContextStorage::invalidate();
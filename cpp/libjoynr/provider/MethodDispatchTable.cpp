@@ -0,0 +1,54 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/MethodDispatchTable.h"
+
+namespace joynr
+{
+
+constexpr std::size_t MethodDispatchTable::NOT_FOUND;
+
+MethodDispatchTable::MethodDispatchTable(std::initializer_list<Method> methods) : methods()
+{
+    std::size_t index = 0;
+    for (const Method& method : methods) {
+        // overloads keep the declaration order so that the first matching method wins
+        this->methods[method.name].push_back(
+                Overload{index++, method.numberOfParams, method.paramDatatypes});
+    }
+}
+
+std::size_t MethodDispatchTable::find(const std::string& methodName,
+                                      const std::vector<std::string>& paramDatatypes) const
+{
+    auto overloads = methods.find(methodName);
+    if (overloads == methods.cend()) {
+        return NOT_FOUND;
+    }
+    for (const Overload& overload : overloads->second) {
+        if (overload.numberOfParams != paramDatatypes.size()) {
+            continue;
+        }
+        if (overload.paramDatatypes.empty() || overload.paramDatatypes == paramDatatypes) {
+            return overload.index;
+        }
+    }
+    return NOT_FOUND;
+}
+
+} // namespace joynr
@@ -18,14 +18,16 @@
  */
 #include "joynr/Arbitrator.h"
 
-#include <cassert>
+#include <atomic>
 #include <vector>
 
 #include <boost/algorithm/string/join.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/system/error_code.hpp>
 
 #include "joynr/Future.h"
 #include "joynr/Logger.h"
-#include "joynr/Semaphore.h"
+#include "joynr/Util.h"
 #include "joynr/exceptions/JoynrException.h"
 #include "joynr/exceptions/NoCompatibleProviderFoundException.h"
 #include "joynr/system/IDiscovery.h"
@@ -33,16 +35,68 @@
 
 namespace joynr
 {
+
+namespace
+{
+
+/*
+ * Invokes the given handler with the result of a lookup. The result is taken from the
+ * callbacks or from the returned future, whichever is available first.
+ */
+template <typename Result>
+class LookupCompletion
+{
+public:
+    using Handler = std::function<void(std::shared_ptr<Future<Result>> future)>;
+
+    explicit LookupCompletion(Handler handler) : completed(false), handler(std::move(handler))
+    {
+    }
+
+    void complete(std::shared_ptr<Future<Result>> future)
+    {
+        if (!completed.exchange(true)) {
+            handler(std::move(future));
+        }
+    }
+
+    void completeIfReady(std::shared_ptr<Future<Result>> future)
+    {
+        if (future && future->getStatus() != StatusCodeEnum::IN_PROGRESS) {
+            complete(std::move(future));
+        }
+    }
+
+    void onSuccess(const Result& result)
+    {
+        auto future = std::make_shared<Future<Result>>();
+        future->onSuccess(result);
+        complete(std::move(future));
+    }
+
+    void onError(const exceptions::JoynrRuntimeException& error)
+    {
+        auto future = std::make_shared<Future<Result>>();
+        future->onError(std::make_shared<exceptions::JoynrRuntimeException>(error));
+        complete(std::move(future));
+    }
+
+private:
+    std::atomic<bool> completed;
+    Handler handler;
+};
+
+} // namespace
+
 Arbitrator::Arbitrator(
         const std::string& domain,
         const std::string& interfaceName,
         const joynr::types::Version& interfaceVersion,
         std::weak_ptr<joynr::system::IDiscoveryAsync> discoveryProxy,
         const DiscoveryQos& discoveryQos,
-        std::unique_ptr<const ArbitrationStrategyFunction> arbitrationStrategyFunction)
+        std::unique_ptr<const ArbitrationStrategyFunction> arbitrationStrategyFunction,
+        boost::asio::io_service& ioService)
         : std::enable_shared_from_this<Arbitrator>(),
-          pendingFutureMutex(),
-          pendingFuture(),
           discoveryProxy(discoveryProxy),
           discoveryQos(discoveryQos),
           systemDiscoveryQos(discoveryQos.getCacheMaxAgeMs(),
@@ -55,11 +109,13 @@ Arbitrator::Arbitrator(
           discoveredIncompatibleVersions(),
           arbitrationError("Arbitration could not be finished in time."),
           arbitrationStrategyFunction(std::move(arbitrationStrategyFunction)),
-          semaphore(0),
+          arbitrationMutex(),
+          callbackMutex(),
+          retryTimer(ioService),
+          discoveryTimeoutTimer(ioService),
+          selectedDiscoveryEntry(),
           arbitrationFinished(false),
-          arbitrationRunning(false),
-          keepArbitrationRunning(false),
-          arbitrationThread()
+          arbitrationRunning(false)
 {
 }
 
@@ -72,6 +128,7 @@ void Arbitrator::startArbitration(
         std::function<void(const types::DiscoveryEntryWithMetaInfo& discoveryEntry)> onSuccess,
         std::function<void(const exceptions::DiscoveryException& exception)> onError)
 {
+    std::lock_guard<std::mutex> lock(arbitrationMutex);
     if (arbitrationRunning) {
         JOYNR_LOG_ERROR(logger(),
                         "Arbitration already running for domain = {} and interface = {}. A second "
@@ -88,200 +145,208 @@ void Arbitrator::startArbitration(
                    interfaceName);
 
     arbitrationRunning = true;
-    keepArbitrationRunning = true;
+    arbitrationFinished = false;
 
     onSuccessCallback = onSuccess;
     onErrorCallback = onError;
 
-    arbitrationThread = std::thread([thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())]() {
-
-        auto thisSharedPtr = thisWeakPtr.lock();
-        if (!thisSharedPtr) {
-            return;
-        }
-
-        thisSharedPtr->arbitrationFinished = false;
-
-        std::string serializedDomainsList = boost::algorithm::join(thisSharedPtr->domains, ", ");
-        JOYNR_LOG_DEBUG(logger(),
-                        "DISCOVERY lookup for domain: [{}], interface: {}",
-                        serializedDomainsList,
-                        thisSharedPtr->interfaceName);
-
-        while (thisSharedPtr->keepArbitrationRunning) {
-            thisSharedPtr->attemptArbitration();
-
-            // exit if arbitration has finished successfully
-            if (thisSharedPtr->arbitrationFinished) {
-                thisSharedPtr->assertNoPendingFuture();
-                return;
-            }
-
-            // check if we should break the keepArbitrationRunning loop and report errors to the
-            // user
-            if (!thisSharedPtr->keepArbitrationRunning) {
-                // stopArbitration has been invoked
-                break;
-            }
-
-            // If there are no suitable providers, retry the arbitration after the retry interval
-            // elapsed
-            const std::int64_t durationMs = thisSharedPtr->getDurationMs();
-
-            if (thisSharedPtr->discoveryQos.getDiscoveryTimeoutMs() <= durationMs) {
-                // discovery timeout reached
-                break;
-            } else if (thisSharedPtr->discoveryQos.getDiscoveryTimeoutMs() - durationMs <=
-                       thisSharedPtr->discoveryQos.getRetryIntervalMs()) {
-                /*
-                 * no retry possible -> wait until discoveryTimeout is reached and inform caller
-                 * about
-                 * cancelled arbitration
-                 */
-                auto waitIntervalMs = std::chrono::milliseconds(
-                        thisSharedPtr->discoveryQos.getDiscoveryTimeoutMs() - durationMs);
-                thisSharedPtr->semaphore.waitFor(waitIntervalMs);
-                break;
-            } else {
-                // wait for retry interval and attempt a new arbitration
-                auto waitIntervalMs =
-                        std::chrono::milliseconds(thisSharedPtr->discoveryQos.getRetryIntervalMs());
-                thisSharedPtr->semaphore.waitFor(waitIntervalMs);
-            }
-        }
-
-        if (thisSharedPtr->onErrorCallback) {
-            if (!thisSharedPtr->keepArbitrationRunning) {
-                thisSharedPtr->arbitrationError.setMessage(
-                        "Shutting Down Arbitration for interface " + thisSharedPtr->interfaceName);
-                thisSharedPtr->onErrorCallback(thisSharedPtr->arbitrationError);
-                // If this point is reached the arbitration timed out
-            } else if (thisSharedPtr->discoveredIncompatibleVersions.empty()) {
-                thisSharedPtr->onErrorCallback(thisSharedPtr->arbitrationError);
-            } else {
-                thisSharedPtr->onErrorCallback(exceptions::NoCompatibleProviderFoundException(
-                        thisSharedPtr->discoveredIncompatibleVersions));
-            }
+    std::string serializedDomainsList = boost::algorithm::join(domains, ", ");
+    JOYNR_LOG_DEBUG(logger(),
+                    "DISCOVERY lookup for domain: [{}], interface: {}",
+                    serializedDomainsList,
+                    interfaceName);
+
+    discoveryTimeoutTimer.expiresFromNow(
+            std::chrono::milliseconds(discoveryQos.getDiscoveryTimeoutMs()));
+    discoveryTimeoutTimer.asyncWait([thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())](
+            const boost::system::error_code& errorCode) {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->onDiscoveryTimeout(errorCode);
         }
-
-        thisSharedPtr->arbitrationRunning = false;
-        JOYNR_LOG_DEBUG(logger(),
-                        "Exiting arbitration thread for interface={}",
-                        thisSharedPtr->interfaceName);
-        thisSharedPtr->assertNoPendingFuture();
     });
+
+    // the first attempt is started by the io_service as well, so the caller is never
+    // blocked by the lookup
+    scheduleAttempt(std::chrono::milliseconds::zero());
 }
 
 void Arbitrator::stopArbitration()
 {
     JOYNR_LOG_DEBUG(logger(), "StopArbitrator for interface={}", interfaceName);
-    {
-        std::unique_lock<std::mutex> lock(pendingFutureMutex);
-        keepArbitrationRunning = false;
-
-        // check if there is a pending future and stop it if still in progress
-        auto error = std::make_shared<joynr::exceptions::JoynrRuntimeException>(
-                "Shutting Down Arbitration for interface " + interfaceName);
-        boost::apply_visitor([error](auto& future) {
-                                 if (future) {
-                                     if (future->getStatus() == StatusCodeEnum::IN_PROGRESS) {
-                                         future->onError(error);
-                                     }
-                                     future.reset();
-                                 }
-                             },
-                             pendingFuture);
-    }
-
-    semaphore.notify();
-
-    if (arbitrationThread.joinable()) {
-        JOYNR_LOG_DEBUG(logger(), "Thread can be joined. Joining thread ({}) ...", interfaceName);
-        arbitrationThread.join();
+    std::unique_lock<std::mutex> lock(arbitrationMutex);
+    const bool notifyError = arbitrationRunning && !arbitrationFinished;
+    arbitrationRunning = false;
+    retryTimer.cancel();
+    discoveryTimeoutTimer.cancel();
+
+    // wait for a callback which is currently being invoked
+    std::lock_guard<std::mutex> callbackLock(callbackMutex);
+    lock.unlock();
+    if (notifyError && onErrorCallback) {
+        arbitrationError.setMessage("Shutting Down Arbitration for interface " + interfaceName);
+        onErrorCallback(arbitrationError);
     }
 }
 
-void Arbitrator::validatePendingFuture()
+void Arbitrator::scheduleAttempt(std::chrono::milliseconds delay)
 {
-    std::unique_lock<std::mutex> lock(pendingFutureMutex);
-    boost::apply_visitor([](auto& future) {
-                             if (future) {
-                                 assert(future->getStatus() != StatusCodeEnum::IN_PROGRESS);
-                                 future.reset();
-                             }
-                         },
-                         pendingFuture);
+    retryTimer.expiresFromNow(delay);
+    retryTimer.asyncWait([thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())](
+            const boost::system::error_code& errorCode) {
+        if (errorCode == boost::asio::error::operation_aborted) {
+            return;
+        }
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            {
+                std::lock_guard<std::mutex> lock(thisSharedPtr->arbitrationMutex);
+                if (!thisSharedPtr->arbitrationRunning) {
+                    return;
+                }
+            }
+            thisSharedPtr->attemptArbitration();
+        }
+    });
 }
 
-void Arbitrator::assertNoPendingFuture()
+void Arbitrator::scheduleRetry()
 {
-    std::unique_lock<std::mutex> lock(pendingFutureMutex);
-    boost::apply_visitor([](auto& future) { assert(!future); }, pendingFuture);
+    // If there are no suitable providers, retry the arbitration after the retry interval
+    // elapsed. If no retry is possible anymore, the discovery timeout reports the result.
+    const std::int64_t durationMs = getDurationMs();
+    if (discoveryQos.getDiscoveryTimeoutMs() - durationMs > discoveryQos.getRetryIntervalMs()) {
+        scheduleAttempt(std::chrono::milliseconds(discoveryQos.getRetryIntervalMs()));
+    }
 }
 
-void Arbitrator::attemptArbitration()
+void Arbitrator::onDiscoveryTimeout(const boost::system::error_code& errorCode)
 {
-    assertNoPendingFuture();
-    std::vector<joynr::types::DiscoveryEntryWithMetaInfo> result;
-    try {
-        auto discoveryProxySharedPtr = discoveryProxy.lock();
-        if (!discoveryProxySharedPtr) {
-            throw exceptions::JoynrRuntimeException("discoveryProxy not available");
-        }
-        const std::int64_t durationMs = getDurationMs();
-        const std::int64_t waitTimeMs = discoveryQos.getDiscoveryTimeoutMs() - durationMs;
-
-        if (waitTimeMs <= 0) {
-            throw exceptions::JoynrTimeOutException("arbitration timed out");
+    if (errorCode == boost::asio::error::operation_aborted) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(arbitrationMutex);
+    if (!arbitrationRunning) {
+        return;
+    }
+    arbitrationRunning = false;
+    retryTimer.cancel();
+
+    std::lock_guard<std::mutex> callbackLock(callbackMutex);
+    lock.unlock();
+    JOYNR_LOG_DEBUG(logger(), "Arbitration timed out for interface={}", interfaceName);
+    if (onErrorCallback) {
+        if (discoveredIncompatibleVersions.empty()) {
+            onErrorCallback(arbitrationError);
+        } else {
+            onErrorCallback(exceptions::NoCompatibleProviderFoundException(
+                    discoveredIncompatibleVersions));
         }
+    }
+}
 
-        if (discoveryQos.getArbitrationStrategy() ==
-            DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT) {
-            types::DiscoveryEntryWithMetaInfo fixedParticipantResult;
-            std::string fixedParticipantId =
-                    discoveryQos.getCustomParameter("fixedParticipantId").getValue();
+void Arbitrator::attemptArbitration()
+{
+    auto discoveryProxySharedPtr = discoveryProxy.lock();
+    if (!discoveryProxySharedPtr) {
+        onLookupFailed(exceptions::JoynrRuntimeException("discoveryProxy not available"));
+        return;
+    }
+    if (discoveryQos.getDiscoveryTimeoutMs() - getDurationMs() <= 0) {
+        onLookupFailed(exceptions::JoynrTimeOutException("arbitration timed out"));
+        return;
+    }
 
-            auto future = discoveryProxySharedPtr->lookupAsync(fixedParticipantId);
-            {
-                std::unique_lock<std::mutex> lock(pendingFutureMutex);
-                if (!keepArbitrationRunning) {
-                    return;
-                } else {
-                    pendingFuture = future;
-                }
+    auto thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this());
+    if (discoveryQos.getArbitrationStrategy() ==
+        DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT) {
+        using Result = types::DiscoveryEntryWithMetaInfo;
+        auto completion = std::make_shared<LookupCompletion<Result>>([thisWeakPtr](
+                std::shared_ptr<Future<Result>> future) {
+            auto thisSharedPtr = thisWeakPtr.lock();
+            if (!thisSharedPtr) {
+                return;
             }
-
-            future->get(waitTimeMs, fixedParticipantResult);
-            validatePendingFuture();
-            result.push_back(fixedParticipantResult);
-        } else {
-            auto future = discoveryProxySharedPtr->lookupAsync(
-                    domains, interfaceName, systemDiscoveryQos);
-            {
-                std::unique_lock<std::mutex> lock(pendingFutureMutex);
-                if (!keepArbitrationRunning) {
-                    return;
-                } else {
-                    pendingFuture = future;
-                }
+            try {
+                Result fixedParticipantResult;
+                future->get(fixedParticipantResult);
+                thisSharedPtr->onLookupSucceeded({fixedParticipantResult});
+            } catch (const exceptions::JoynrException& e) {
+                thisSharedPtr->onLookupFailed(e);
             }
+        });
+        std::string fixedParticipantId =
+                discoveryQos.getCustomParameter("fixedParticipantId").getValue();
+        // the callbacks keep the completion alive until the lookup has finished
+        auto future = discoveryProxySharedPtr->lookupAsync(
+                fixedParticipantId,
+                [completion](const Result& result) { completion->onSuccess(result); },
+                [completion](const exceptions::JoynrRuntimeException& error) {
+                    completion->onError(error);
+                });
+        completion->completeIfReady(std::move(future));
+    } else {
+        using Result = std::vector<types::DiscoveryEntryWithMetaInfo>;
+        auto completion = std::make_shared<LookupCompletion<Result>>([thisWeakPtr](
+                std::shared_ptr<Future<Result>> future) {
+            auto thisSharedPtr = thisWeakPtr.lock();
+            if (!thisSharedPtr) {
+                return;
+            }
+            try {
+                Result result;
+                future->get(result);
+                thisSharedPtr->onLookupSucceeded(result);
+            } catch (const exceptions::JoynrException& e) {
+                thisSharedPtr->onLookupFailed(e);
+            }
+        });
+        auto future = discoveryProxySharedPtr->lookupAsync(
+                domains,
+                interfaceName,
+                systemDiscoveryQos,
+                [completion](const Result& result) { completion->onSuccess(result); },
+                [completion](const exceptions::JoynrRuntimeException& error) {
+                    completion->onError(error);
+                });
+        completion->completeIfReady(std::move(future));
+    }
+}
 
-            future->get(waitTimeMs, result);
-            validatePendingFuture();
-        }
-
-        receiveCapabilitiesLookupResults(result);
+void Arbitrator::onLookupSucceeded(
+        const std::vector<joynr::types::DiscoveryEntryWithMetaInfo>& discoveryEntries)
+{
+    std::unique_lock<std::mutex> lock(arbitrationMutex);
+    if (!arbitrationRunning) {
+        return;
+    }
+    receiveCapabilitiesLookupResults(discoveryEntries);
+    if (!arbitrationFinished) {
+        scheduleRetry();
+        return;
+    }
+    arbitrationRunning = false;
+    retryTimer.cancel();
+    discoveryTimeoutTimer.cancel();
+
+    std::lock_guard<std::mutex> callbackLock(callbackMutex);
+    lock.unlock();
+    if (onSuccessCallback) {
+        onSuccessCallback(selectedDiscoveryEntry);
+    }
+}
 
-    } catch (const exceptions::JoynrException& e) {
-        std::string errorMsg = "Unable to lookup provider (domain: " +
-                               (domains.empty() ? std::string("EMPTY") : domains.at(0)) +
-                               ", interface: " + interfaceName + ") from discovery. Error: " +
-                               e.getMessage();
-        JOYNR_LOG_ERROR(logger(), errorMsg);
-        arbitrationError.setMessage(errorMsg);
-        validatePendingFuture();
+void Arbitrator::onLookupFailed(const exceptions::JoynrException& error)
+{
+    std::lock_guard<std::mutex> lock(arbitrationMutex);
+    if (!arbitrationRunning) {
+        return;
     }
-    assertNoPendingFuture();
+    std::string errorMsg = "Unable to lookup provider (domain: " +
+                           (domains.empty() ? std::string("EMPTY") : domains.at(0)) +
+                           ", interface: " + interfaceName + ") from discovery. Error: " +
+                           error.getMessage();
+    JOYNR_LOG_ERROR(logger(), errorMsg);
+    arbitrationError.setMessage(errorMsg);
+    scheduleRetry();
 }
 
 void Arbitrator::receiveCapabilitiesLookupResults(
@@ -351,9 +416,7 @@ void Arbitrator::receiveCapabilitiesLookupResults(
             arbitrationError = e;
         }
         if (!res.getParticipantId().empty()) {
-            if (onSuccessCallback) {
-                onSuccessCallback(res);
-            }
+            selectedDiscoveryEntry = std::move(res);
             arbitrationFinished = true;
         }
     }
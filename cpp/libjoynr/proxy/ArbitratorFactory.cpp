@@ -34,7 +34,8 @@ std::shared_ptr<Arbitrator> ArbitratorFactory::createArbitrator(
         const std::string& interfaceName,
         const joynr::types::Version& interfaceVersion,
         std::weak_ptr<joynr::system::IDiscoveryAsync> discoveryProxy,
-        const DiscoveryQos& discoveryQos)
+        const DiscoveryQos& discoveryQos,
+        boost::asio::io_service& ioService)
 {
     std::unique_ptr<ArbitrationStrategyFunction> arbitrationStrategyFunction;
     DiscoveryQos::ArbitrationStrategy strategy = discoveryQos.getArbitrationStrategy();
@@ -65,7 +66,8 @@ std::shared_ptr<Arbitrator> ArbitratorFactory::createArbitrator(
                                         interfaceVersion,
                                         discoveryProxy,
                                         discoveryQos,
-                                        std::move(arbitrationStrategyFunction));
+                                        std::move(arbitrationStrategyFunction),
+                                        ioService);
 }
 
 } // namespace joynr
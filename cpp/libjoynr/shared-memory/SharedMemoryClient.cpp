@@ -0,0 +1,253 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shared-memory/SharedMemoryClient.h"
+
+#include <cassert>
+
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/SharedMemorySettings.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/shared-memory/SharedMemorySender.h"
+
+namespace joynr
+{
+
+SharedMemoryClient::SharedMemoryClient(const SharedMemorySettings& settings,
+                                       boost::asio::io_service& ioService)
+        : ioService(ioService),
+          reconnectTimer(ioService),
+          ringBufferSize(settings.getRingBufferSize()),
+          reconnectSleepTimeMs(settings.getReconnectSleepTimeMs()),
+          address(),
+          performingInitialConnect(true),
+          onConnectionOpenedCallback(),
+          onConnectionClosedCallback(),
+          onConnectionReestablishedCallback(),
+          onMessageReceivedCallback(),
+          connection(),
+          connectionMutex(),
+          sender(std::make_shared<SharedMemorySender>()),
+          isRunning(true),
+          isShuttingDown(false)
+{
+}
+
+SharedMemoryClient::~SharedMemoryClient()
+{
+    // make sure stop() has been invoked earlier
+    assert(isShuttingDown);
+}
+
+void SharedMemoryClient::stop()
+{
+    // make sure stop() is not called multiple times
+    assert(!isShuttingDown);
+    isShuttingDown = true;
+    isRunning = false;
+
+    boost::system::error_code timerError;
+    // ignore errors
+    reconnectTimer.cancel(timerError);
+
+    std::shared_ptr<SharedMemoryConnection> closedConnection;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        closedConnection = std::move(connection);
+    }
+    sender->resetConnection();
+
+    if (closedConnection) {
+        closedConnection->close();
+        JOYNR_LOG_INFO(logger(), "connection closed");
+        if (onConnectionClosedCallback) {
+            onConnectionClosedCallback();
+        }
+    }
+}
+
+void SharedMemoryClient::registerConnectCallback(std::function<void()> callback)
+{
+    onConnectionOpenedCallback = std::move(callback);
+}
+
+void SharedMemoryClient::registerReconnectCallback(std::function<void()> callback)
+{
+    onConnectionReestablishedCallback = std::move(callback);
+}
+
+void SharedMemoryClient::registerDisconnectCallback(std::function<void()> onDisconnected)
+{
+    onConnectionClosedCallback = std::move(onDisconnected);
+}
+
+void SharedMemoryClient::registerReceiveCallback(
+        std::function<void(smrf::ByteVector&&)> onMessageReceived)
+{
+    onMessageReceivedCallback = std::move(onMessageReceived);
+}
+
+void SharedMemoryClient::connect(const system::RoutingTypes::SharedMemoryAddress& address)
+{
+    this->address = address;
+
+    performingInitialConnect = true;
+    ioService.post([thisWeakPtr = std::weak_ptr<SharedMemoryClient>(shared_from_this())]() {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->reconnect();
+        }
+    });
+}
+
+bool SharedMemoryClient::isConnected() const
+{
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    return connection && connection->isOpen();
+}
+
+void SharedMemoryClient::send(
+        const smrf::ByteArrayView& frame,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    std::shared_ptr<SharedMemoryConnection> currentConnection;
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        currentConnection = connection;
+    }
+    if (!currentConnection) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "Error sending message via SharedMemoryClient: not connected"));
+        return;
+    }
+    currentConnection->send(frame, onFailure);
+}
+
+std::shared_ptr<SharedMemorySender> SharedMemoryClient::getSender() const
+{
+    return sender;
+}
+
+void SharedMemoryClient::reconnect(const boost::system::error_code& reconnectTimerError)
+{
+    if (reconnectTimerError == boost::asio::error::operation_aborted) {
+        // Assume stop() has been called
+        JOYNR_LOG_INFO(logger(),
+                       "reconnect aborted after shutdown, error code from reconnect timer: {}",
+                       reconnectTimerError.message());
+        return;
+    } else if (reconnectTimerError) {
+        JOYNR_LOG_ERROR(logger(),
+                        "reconnect called with error code from reconnect timer: {}",
+                        reconnectTimerError.message());
+    }
+    if (!isRunning) {
+        return;
+    }
+
+    JOYNR_LOG_INFO(logger(), "Connecting to shared memory server {}", address.getPath());
+
+    boost::system::error_code connectError;
+    std::shared_ptr<SharedMemoryConnection> newConnection = SharedMemoryConnection::connect(
+            ioService, address.getPath(), ringBufferSize, connectError);
+    if (connectError) {
+        JOYNR_LOG_WARN(logger(),
+                       "shared memory connection to {} failed - error: {}. Trying to reconnect...",
+                       address.getPath(),
+                       connectError.message());
+        delayedReconnect();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        if (!isRunning) {
+            newConnection->close();
+            return;
+        }
+        connection = newConnection;
+    }
+
+    std::weak_ptr<SharedMemoryClient> thisWeakPtr(shared_from_this());
+    newConnection->start(
+            [thisWeakPtr](const smrf::ByteArrayView& frame) {
+                auto thisSharedPtr = thisWeakPtr.lock();
+                if (thisSharedPtr && thisSharedPtr->onMessageReceivedCallback) {
+                    // the frame only lives in the ring buffer until this call returns
+                    thisSharedPtr->onMessageReceivedCallback(
+                            smrf::ByteVector(frame.data(), frame.data() + frame.size()));
+                }
+            },
+            [thisWeakPtr]() {
+                if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                    thisSharedPtr->onConnectionClosed();
+                }
+            });
+    JOYNR_LOG_INFO(logger(), "connection established");
+
+    // the callbacks send the initialization message, which must be the first frame on
+    // the new connection, hence the sender is connected only afterwards
+    if (performingInitialConnect) {
+        if (onConnectionOpenedCallback) {
+            onConnectionOpenedCallback();
+        }
+    } else {
+        if (onConnectionReestablishedCallback) {
+            onConnectionReestablishedCallback();
+        }
+    }
+
+    performingInitialConnect = false;
+    sender->setConnection(std::move(newConnection));
+}
+
+void SharedMemoryClient::delayedReconnect()
+{
+    boost::system::error_code reconnectTimerError;
+    reconnectTimer.expires_from_now(reconnectSleepTimeMs, reconnectTimerError);
+    if (reconnectTimerError) {
+        JOYNR_LOG_FATAL(logger(),
+                        "Error from reconnect timer: {}: {}",
+                        reconnectTimerError.value(),
+                        reconnectTimerError.message());
+    } else {
+        reconnectTimer.async_wait([thisWeakPtr = std::weak_ptr<SharedMemoryClient>(
+                                           shared_from_this())](
+                const boost::system::error_code& error) {
+            if (auto thisSharedPtr = thisWeakPtr.lock()) {
+                thisSharedPtr->reconnect(error);
+            }
+        });
+    }
+}
+
+void SharedMemoryClient::onConnectionClosed()
+{
+    {
+        std::lock_guard<std::mutex> lock(connectionMutex);
+        connection.reset();
+    }
+    sender->resetConnection();
+    if (!isRunning) {
+        JOYNR_LOG_INFO(logger(), "connection closed");
+        return;
+    }
+    JOYNR_LOG_WARN(logger(), "connection closed unexpectedly. Trying to reconnect...");
+    delayedReconnect();
+}
+
+} // namespace joynr
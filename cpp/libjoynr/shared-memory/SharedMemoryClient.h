@@ -0,0 +1,142 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYCLIENT_H
+#define SHAREDMEMORYCLIENT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+
+namespace joynr
+{
+
+class SharedMemoryConnection;
+class SharedMemorySender;
+class SharedMemorySettings;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @class SharedMemoryClient
+ * @brief Client side of the shared memory transport to the cluster controller.
+ *
+ * Behaves like the websocket client: a lost connection is re-established
+ * after the configured reconnect sleep time until @ref stop is called, the
+ * sender returned by @ref getSender stays valid across reconnects.
+ */
+class SharedMemoryClient : public std::enable_shared_from_this<SharedMemoryClient>
+{
+public:
+    SharedMemoryClient(const SharedMemorySettings& settings, boost::asio::io_service& ioService);
+    ~SharedMemoryClient();
+
+    /**
+     * @brief Closes the connection and stops reconnecting
+     * @note Must be called before the destructor
+     */
+    void stop();
+
+    /**
+     * @brief Register method called after the initial connection was established
+     * @note Frames sent from within the callback are guaranteed to reach the
+     *      server before any frame sent via the sender
+     */
+    void registerConnectCallback(std::function<void()> callback);
+
+    /**
+     * @brief Register method called after the connection was re-established
+     * @note Frames sent from within the callback are guaranteed to reach the
+     *      server before any frame sent via the sender
+     */
+    void registerReconnectCallback(std::function<void()> callback);
+
+    /**
+     * @brief Register method called on final disconnect (shutdown)
+     */
+    void registerDisconnectCallback(std::function<void()> onDisconnected);
+
+    /**
+     * @brief Register method called on message received
+     */
+    void registerReceiveCallback(std::function<void(smrf::ByteVector&&)> onMessageReceived);
+
+    void connect(const system::RoutingTypes::SharedMemoryAddress& address);
+
+    bool isConnected() const;
+
+    /**
+     * @brief Sends a frame over the current connection
+     */
+    void send(const smrf::ByteArrayView& frame,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+
+    std::shared_ptr<SharedMemorySender> getSender() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SharedMemoryClient);
+
+    void reconnect(
+            const boost::system::error_code& reconnectTimerError = boost::system::error_code());
+    void delayedReconnect();
+    void onConnectionClosed();
+
+    boost::asio::io_service& ioService;
+    boost::asio::steady_timer reconnectTimer;
+    const std::size_t ringBufferSize;
+    const std::chrono::milliseconds reconnectSleepTimeMs;
+
+    // store address for reconnect
+    system::RoutingTypes::SharedMemoryAddress address;
+    bool performingInitialConnect;
+
+    std::function<void()> onConnectionOpenedCallback;
+    std::function<void()> onConnectionClosedCallback;
+    std::function<void()> onConnectionReestablishedCallback;
+    std::function<void(smrf::ByteVector&&)> onMessageReceivedCallback;
+
+    std::shared_ptr<SharedMemoryConnection> connection;
+    mutable std::mutex connectionMutex;
+    std::shared_ptr<SharedMemorySender> sender;
+    std::atomic<bool> isRunning;
+    std::atomic<bool> isShuttingDown;
+
+    ADD_LOGGER(SharedMemoryClient)
+};
+
+} // namespace joynr
+
+#endif // SHAREDMEMORYCLIENT_H
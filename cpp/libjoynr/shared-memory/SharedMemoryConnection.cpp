@@ -0,0 +1,572 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/SharedMemoryConnection.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <boost/asio/buffer.hpp>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+namespace
+{
+
+constexpr std::uint32_t segmentMagic = 0x6a6f796e; // "joyn"
+constexpr std::uint32_t segmentVersion = 1;
+constexpr std::size_t segmentAlignment = 64;
+constexpr std::size_t numberOfHandedOverFds = 3;
+// the size of the segment must not change after it has been handed over,
+// otherwise the peer could make accesses to the mapping fail with SIGBUS
+constexpr int requiredSeals = F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL;
+
+struct SegmentHeader
+{
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t capacity;
+};
+
+std::size_t alignUp(std::size_t value, std::size_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+std::size_t getRingBufferSize(std::size_t capacity)
+{
+    return alignUp(SharedMemoryRingBuffer::getRequiredSize(capacity), segmentAlignment);
+}
+
+std::size_t getMappingSize(std::size_t capacity)
+{
+    return alignUp(sizeof(SegmentHeader), segmentAlignment) + 2 * getRingBufferSize(capacity);
+}
+
+// ring buffer 0 carries frames from client to server, ring buffer 1 from server to client
+void* getRingBufferMemory(void* memory, std::size_t capacity, std::size_t index)
+{
+    return static_cast<std::uint8_t*>(memory) + alignUp(sizeof(SegmentHeader), segmentAlignment) +
+           index * getRingBufferSize(capacity);
+}
+
+boost::system::error_code lastError()
+{
+    return boost::system::error_code(errno, boost::system::system_category());
+}
+
+/**
+ * Closes the owned file descriptor unless it is released
+ */
+class FileDescriptor
+{
+public:
+    explicit FileDescriptor(int fd = -1) : fd(fd)
+    {
+    }
+
+    ~FileDescriptor()
+    {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    int get() const
+    {
+        return fd;
+    }
+
+    void reset(int newFd)
+    {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        fd = newFd;
+    }
+
+    int release()
+    {
+        const int released = fd;
+        fd = -1;
+        return released;
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(FileDescriptor);
+    int fd;
+};
+
+void* mapSegment(int memoryFd, std::size_t mappingSize, boost::system::error_code& error)
+{
+    void* memory = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFd, 0);
+    if (memory == MAP_FAILED) {
+        error = lastError();
+        return nullptr;
+    }
+    return memory;
+}
+
+// the peer might hand over any kind of descriptor; only an eventfd never blocks a nonblocking
+// write of a single increment and is safe to wait on
+bool isEventFd(int fd)
+{
+    std::ifstream fdInfo("/proc/self/fdinfo/" + std::to_string(fd));
+    std::string line;
+    while (std::getline(fdInfo, line)) {
+        if (line.compare(0, 14, "eventfd-count:") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool setNonBlocking(int fd)
+{
+    const int flags = ::fcntl(fd, F_GETFL);
+    return flags >= 0 && ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+} // namespace
+
+std::shared_ptr<SharedMemoryConnection> SharedMemoryConnection::connect(
+        boost::asio::io_service& ioService,
+        const std::string& path,
+        std::size_t capacity,
+        boost::system::error_code& error)
+{
+    capacity = alignUp(capacity, 8);
+    const std::size_t mappingSize = getMappingSize(capacity);
+
+    Socket socket(ioService);
+    socket.connect(boost::asio::local::stream_protocol::endpoint(path), error);
+    if (error) {
+        return nullptr;
+    }
+
+    FileDescriptor memoryFd(static_cast<int>(::syscall(
+            SYS_memfd_create, "joynr-shared-memory", MFD_CLOEXEC | MFD_ALLOW_SEALING)));
+    if (memoryFd.get() < 0 || ::ftruncate(memoryFd.get(), static_cast<off_t>(mappingSize)) != 0 ||
+        ::fcntl(memoryFd.get(), F_ADD_SEALS, requiredSeals) != 0) {
+        error = lastError();
+        return nullptr;
+    }
+    FileDescriptor clientEventFd(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    FileDescriptor serverEventFd(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK));
+    if (clientEventFd.get() < 0 || serverEventFd.get() < 0) {
+        error = lastError();
+        return nullptr;
+    }
+
+    void* memory = mapSegment(memoryFd.get(), mappingSize, error);
+    if (!memory) {
+        return nullptr;
+    }
+    auto segmentHeader = static_cast<SegmentHeader*>(memory);
+    segmentHeader->magic = segmentMagic;
+    segmentHeader->version = segmentVersion;
+    segmentHeader->capacity = capacity;
+    for (std::size_t index = 0; index < 2; ++index) {
+        SharedMemoryRingBuffer(getRingBufferMemory(memory, capacity, index), capacity)
+                .initialize();
+    }
+
+    // hand over the segment and both eventfds; the server receives duplicates of them
+    const int fds[numberOfHandedOverFds] = {
+            memoryFd.get(), clientEventFd.get(), serverEventFd.get()};
+    std::uint8_t version = segmentVersion;
+    struct iovec iov;
+    iov.iov_base = &version;
+    iov.iov_len = sizeof(version);
+    union {
+        char buffer[CMSG_SPACE(sizeof(fds))];
+        struct cmsghdr align;
+    } control;
+    std::memset(&control, 0, sizeof(control));
+    struct msghdr message;
+    std::memset(&message, 0, sizeof(message));
+    message.msg_iov = &iov;
+    message.msg_iovlen = 1;
+    message.msg_control = control.buffer;
+    message.msg_controllen = sizeof(control.buffer);
+    struct cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+    controlMessage->cmsg_level = SOL_SOCKET;
+    controlMessage->cmsg_type = SCM_RIGHTS;
+    controlMessage->cmsg_len = CMSG_LEN(sizeof(fds));
+    std::memcpy(CMSG_DATA(controlMessage), fds, sizeof(fds));
+
+    if (::sendmsg(socket.native_handle(), &message, MSG_NOSIGNAL) < 0) {
+        error = lastError();
+        ::munmap(memory, mappingSize);
+        return nullptr;
+    }
+
+    return std::shared_ptr<SharedMemoryConnection>(
+            new SharedMemoryConnection(ioService,
+                                       std::move(socket),
+                                       memory,
+                                       mappingSize,
+                                       capacity,
+                                       true,
+                                       clientEventFd.release(),
+                                       serverEventFd.release()));
+}
+
+void SharedMemoryConnection::asyncAccept(boost::asio::io_service& ioService,
+                                         Socket socket,
+                                         AcceptHandler handler)
+{
+    auto acceptedSocket = std::make_shared<Socket>(std::move(socket));
+    acceptedSocket->async_read_some(
+            boost::asio::null_buffers(),
+            [&ioService, acceptedSocket, handler = std::move(handler)](
+                    const boost::system::error_code& readError, std::size_t) {
+                if (readError) {
+                    handler(readError, nullptr);
+                    return;
+                }
+
+                std::uint8_t version = 0;
+                struct iovec iov;
+                iov.iov_base = &version;
+                iov.iov_len = sizeof(version);
+                union {
+                    char buffer[CMSG_SPACE(sizeof(int) * numberOfHandedOverFds)];
+                    struct cmsghdr align;
+                } control;
+                struct msghdr message;
+                std::memset(&message, 0, sizeof(message));
+                message.msg_iov = &iov;
+                message.msg_iovlen = 1;
+                message.msg_control = control.buffer;
+                message.msg_controllen = sizeof(control.buffer);
+
+                const ssize_t received = ::recvmsg(acceptedSocket->native_handle(),
+                                                   &message,
+                                                   MSG_DONTWAIT | MSG_CMSG_CLOEXEC);
+                if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    asyncAccept(ioService, std::move(*acceptedSocket), handler);
+                    return;
+                }
+                if (received <= 0) {
+                    handler(received < 0 ? lastError()
+                                         : boost::asio::error::make_error_code(
+                                                   boost::asio::error::eof),
+                            nullptr);
+                    return;
+                }
+
+                FileDescriptor fds[numberOfHandedOverFds];
+                std::size_t numberOfFds = 0;
+                for (struct cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+                     controlMessage != nullptr;
+                     controlMessage = CMSG_NXTHDR(&message, controlMessage)) {
+                    if (controlMessage->cmsg_level != SOL_SOCKET ||
+                        controlMessage->cmsg_type != SCM_RIGHTS) {
+                        continue;
+                    }
+                    const std::size_t count =
+                            (controlMessage->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+                    const int* data = reinterpret_cast<const int*>(CMSG_DATA(controlMessage));
+                    for (std::size_t i = 0; i < count; ++i) {
+                        if (numberOfFds < numberOfHandedOverFds) {
+                            fds[numberOfFds++].reset(data[i]);
+                        } else {
+                            ::close(data[i]);
+                        }
+                    }
+                }
+
+                const auto invalidArgument = boost::system::errc::make_error_code(
+                        boost::system::errc::invalid_argument);
+                if (version != segmentVersion || numberOfFds != numberOfHandedOverFds ||
+                    (message.msg_flags & MSG_CTRUNC) != 0) {
+                    handler(invalidArgument, nullptr);
+                    return;
+                }
+                // only a sealed segment keeps its size, checking it once is not sufficient
+                const int seals = ::fcntl(fds[0].get(), F_GET_SEALS);
+                if (seals < 0 || (seals & requiredSeals) != requiredSeals) {
+                    JOYNR_LOG_ERROR(logger(), "shared memory segment is not sealed");
+                    handler(invalidArgument, nullptr);
+                    return;
+                }
+                for (std::size_t i = 1; i < numberOfHandedOverFds; ++i) {
+                    if (!isEventFd(fds[i].get()) || !setNonBlocking(fds[i].get())) {
+                        JOYNR_LOG_ERROR(logger(), "handed over descriptor is not an eventfd");
+                        handler(invalidArgument, nullptr);
+                        return;
+                    }
+                }
+                struct stat segmentStat;
+                if (::fstat(fds[0].get(), &segmentStat) != 0 ||
+                    static_cast<std::size_t>(segmentStat.st_size) < sizeof(SegmentHeader)) {
+                    handler(invalidArgument, nullptr);
+                    return;
+                }
+
+                boost::system::error_code error;
+                const std::size_t mappingSize = static_cast<std::size_t>(segmentStat.st_size);
+                void* memory = mapSegment(fds[0].get(), mappingSize, error);
+                if (!memory) {
+                    handler(error, nullptr);
+                    return;
+                }
+                const auto segmentHeader = static_cast<const SegmentHeader*>(memory);
+                const std::size_t capacity = static_cast<std::size_t>(segmentHeader->capacity);
+                if (segmentHeader->magic != segmentMagic || capacity % 8 != 0 ||
+                    capacity > mappingSize || getMappingSize(capacity) != mappingSize) {
+                    ::munmap(memory, mappingSize);
+                    handler(invalidArgument, nullptr);
+                    return;
+                }
+
+                auto connection = std::shared_ptr<SharedMemoryConnection>(
+                        new SharedMemoryConnection(ioService,
+                                                   std::move(*acceptedSocket),
+                                                   memory,
+                                                   mappingSize,
+                                                   capacity,
+                                                   false,
+                                                   fds[2].release(),
+                                                   fds[1].release()));
+                handler(error, std::move(connection));
+            });
+}
+
+SharedMemoryConnection::SharedMemoryConnection(boost::asio::io_service& ioService,
+                                               Socket socket,
+                                               void* memory,
+                                               std::size_t mappingSize,
+                                               std::size_t capacity,
+                                               bool isClient,
+                                               int receiveEventFd,
+                                               int sendEventFd)
+        : std::enable_shared_from_this<SharedMemoryConnection>(),
+          ioService(ioService),
+          socket(std::move(socket)),
+          receiveNotifier(ioService, receiveEventFd),
+          memory(memory),
+          mappingSize(mappingSize),
+          sendBuffer(getRingBufferMemory(memory, capacity, isClient ? 0 : 1), capacity),
+          receiveBuffer(getRingBufferMemory(memory, capacity, isClient ? 1 : 0), capacity),
+          sendEventFd(sendEventFd),
+          receivedEventCount(0),
+          receivedControlByte(0),
+          onFrameReceived(),
+          onClosed(),
+          sendMutex(),
+          receiveMutex(),
+          stateMutex(),
+          closed(false)
+{
+}
+
+SharedMemoryConnection::~SharedMemoryConnection()
+{
+    close();
+    ::close(sendEventFd);
+    ::munmap(memory, mappingSize);
+}
+
+void SharedMemoryConnection::start(
+        std::function<void(const smrf::ByteArrayView&)> onFrameReceived,
+        std::function<void()> onClosed)
+{
+    this->onFrameReceived = std::move(onFrameReceived);
+    this->onClosed = std::move(onClosed);
+    waitForPeerClosed();
+    // frames might have been written before start was called
+    ioService.post([thisSharedPtr = shared_from_this()]() {
+        thisSharedPtr->receive();
+    });
+}
+
+void SharedMemoryConnection::send(
+        const smrf::ByteArrayView& frame,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    if (closed) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "Shared memory connection closed. Unable to send message"));
+        return;
+    }
+    if (frame.size() > sendBuffer.getMaxFrameSize()) {
+        onFailure(exceptions::JoynrMessageNotSentException(
+                "Message of size " + std::to_string(frame.size()) +
+                " exceeds the maximum frame size of the shared memory connection"));
+        return;
+    }
+
+    bool written;
+    bool wakeup = false;
+    {
+        std::lock_guard<std::mutex> lock(sendMutex);
+        written = sendBuffer.tryWrite(frame);
+        if (written) {
+            wakeup = sendBuffer.consumerNeedsWakeup();
+        }
+    }
+
+    if (!written) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "Shared memory ring buffer full. Unable to send message"));
+        return;
+    }
+    if (wakeup) {
+        const std::uint64_t increment = 1;
+        if (::write(sendEventFd, &increment, sizeof(increment)) < 0 && errno != EAGAIN) {
+            JOYNR_LOG_ERROR(logger(), "Unable to wake up peer: {}", std::strerror(errno));
+        }
+    }
+}
+
+void SharedMemoryConnection::close()
+{
+    closeInternal();
+}
+
+bool SharedMemoryConnection::closeInternal()
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (closed) {
+        return false;
+    }
+    closed = true;
+    boost::system::error_code ignored;
+    socket.close(ignored);
+    receiveNotifier.close(ignored);
+    return true;
+}
+
+bool SharedMemoryConnection::isOpen() const
+{
+    return !closed;
+}
+
+void SharedMemoryConnection::receive()
+{
+    if (closed) {
+        return;
+    }
+    if (!readReceivedFrames()) {
+        closeAndNotify();
+        return;
+    }
+    if (receiveBuffer.prepareWait()) {
+        waitForWakeup();
+    } else {
+        // more frames arrived, give other handlers a chance before reading them
+        ioService.post([thisSharedPtr = shared_from_this()]() {
+            thisSharedPtr->receive();
+        });
+    }
+}
+
+void SharedMemoryConnection::waitForWakeup()
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (closed) {
+        return;
+    }
+    receiveNotifier.async_read_some(
+            boost::asio::buffer(&receivedEventCount, sizeof(receivedEventCount)),
+            [thisSharedPtr = shared_from_this()](const boost::system::error_code& error,
+                                                 std::size_t) {
+                if (error) {
+                    if (error != boost::asio::error::operation_aborted) {
+                        JOYNR_LOG_ERROR(logger(),
+                                        "Waiting for shared memory wakeup failed: {}",
+                                        error.message());
+                    }
+                    return;
+                }
+                thisSharedPtr->receive();
+            });
+}
+
+void SharedMemoryConnection::waitForPeerClosed()
+{
+    std::lock_guard<std::mutex> lock(stateMutex);
+    if (closed) {
+        return;
+    }
+    // the peer never writes to the socket after the handshake, hence any
+    // completion means that the peer went away
+    socket.async_read_some(boost::asio::buffer(&receivedControlByte, sizeof(receivedControlByte)),
+                           [thisSharedPtr = shared_from_this()](
+                                   const boost::system::error_code& error, std::size_t) {
+                               if (error != boost::asio::error::operation_aborted) {
+                                   thisSharedPtr->onPeerClosed();
+                               }
+                           });
+}
+
+void SharedMemoryConnection::onPeerClosed()
+{
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (closed) {
+            return;
+        }
+    }
+    // deliver what the peer wrote before it went away
+    readReceivedFrames();
+    closeAndNotify();
+}
+
+void SharedMemoryConnection::closeAndNotify()
+{
+    if (closeInternal() && onClosed) {
+        onClosed();
+    }
+}
+
+bool SharedMemoryConnection::readReceivedFrames()
+{
+    // the ring buffer supports a single consumer only, while the io_service
+    // might be run by several threads
+    std::lock_guard<std::mutex> lock(receiveMutex);
+    if (closed) {
+        return false;
+    }
+    try {
+        receiveBuffer.read(onFrameReceived);
+    } catch (const exceptions::JoynrRuntimeException& e) {
+        // the peer wrote garbage into the segment, it cannot be trusted any more
+        JOYNR_LOG_ERROR(logger(), "Closing shared memory connection: {}", e.getMessage());
+        return false;
+    }
+    return true;
+}
+
+} // namespace joynr
@@ -0,0 +1,54 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shared-memory/SharedMemoryMessagingStub.h"
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/ImmutableMessage.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "libjoynr/shared-memory/SharedMemorySender.h"
+
+namespace joynr
+{
+
+SharedMemoryMessagingStub::SharedMemoryMessagingStub(std::shared_ptr<SharedMemorySender> sender)
+        : sender(std::move(sender))
+{
+}
+
+void SharedMemoryMessagingStub::transmit(
+        std::shared_ptr<ImmutableMessage> message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    if (!sender->isConnected()) {
+        JOYNR_LOG_WARN(logger(),
+                       "Shared memory connection not ready. Unable to send message {}",
+                       message->toLogMessage());
+        onFailure(exceptions::JoynrDelayMessageException(
+                "Shared memory connection not ready. Unable to send message"));
+        return;
+    }
+
+    JOYNR_LOG_DEBUG(logger(), ">>> OUTGOING >>> {}", message->toLogMessage());
+    // the serialized SMRF message is copied into the ring buffer as is
+    smrf::ByteArrayView serializedMessageView(message->getSerializedMessage());
+    sender->send(serializedMessageView, onFailure);
+}
+
+} // namespace joynr
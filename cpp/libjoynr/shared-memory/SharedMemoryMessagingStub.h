@@ -0,0 +1,66 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYMESSAGINGSTUB_H
+#define SHAREDMEMORYMESSAGINGSTUB_H
+
+#include <functional>
+#include <memory>
+
+#include "joynr/IMessagingStub.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class SharedMemorySender;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @class SharedMemoryMessagingStub
+ * @brief Represents an outgoing shared memory connection
+ */
+class SharedMemoryMessagingStub : public IMessagingStub
+{
+public:
+    /**
+     * @brief Constructor
+     * @param sender Sender to be used to send data
+     */
+    explicit SharedMemoryMessagingStub(std::shared_ptr<SharedMemorySender> sender);
+
+    ~SharedMemoryMessagingStub() final = default;
+    void transmit(
+            std::shared_ptr<ImmutableMessage> message,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) final;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SharedMemoryMessagingStub);
+
+    std::shared_ptr<SharedMemorySender> sender;
+
+    ADD_LOGGER(SharedMemoryMessagingStub)
+};
+
+} // namespace joynr
+#endif // SHAREDMEMORYMESSAGINGSTUB_H
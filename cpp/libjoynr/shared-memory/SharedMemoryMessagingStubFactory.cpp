@@ -0,0 +1,144 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shared-memory/SharedMemoryMessagingStubFactory.h"
+
+#include "libjoynr/shared-memory/SharedMemoryMessagingStub.h"
+#include "libjoynr/shared-memory/SharedMemorySender.h"
+
+namespace joynr
+{
+
+SharedMemoryMessagingStubFactory::SharedMemoryMessagingStubFactory()
+        : serverStubMap(),
+          serverStubMapMutex(),
+          clientStubMap(),
+          clientStubMapMutex(),
+          onMessagingStubClosedCallback(nullptr)
+{
+}
+
+bool SharedMemoryMessagingStubFactory::canCreate(
+        const joynr::system::RoutingTypes::Address& destAddress)
+{
+    return dynamic_cast<const system::RoutingTypes::SharedMemoryAddress*>(&destAddress) !=
+                   nullptr ||
+           dynamic_cast<const system::RoutingTypes::SharedMemoryClientAddress*>(&destAddress) !=
+                   nullptr;
+}
+
+std::shared_ptr<IMessagingStub> SharedMemoryMessagingStubFactory::create(
+        const joynr::system::RoutingTypes::Address& destAddress)
+{
+    // if destination is a shared memory client address
+    if (auto clientAddress =
+                dynamic_cast<const system::RoutingTypes::SharedMemoryClientAddress*>(
+                        &destAddress)) {
+        std::lock_guard<std::mutex> lock(clientStubMapMutex);
+        auto stub = clientStubMap.find(*clientAddress);
+        if (stub == clientStubMap.cend()) {
+            JOYNR_LOG_ERROR(logger(),
+                            "No shared memory connection found for address {}",
+                            clientAddress->toString());
+            return std::shared_ptr<IMessagingStub>();
+        }
+        return stub->second;
+    }
+    // if destination is a shared memory server address
+    if (auto serverAddress =
+                dynamic_cast<const system::RoutingTypes::SharedMemoryAddress*>(&destAddress)) {
+        std::lock_guard<std::mutex> lock(serverStubMapMutex);
+        auto stub = serverStubMap.find(*serverAddress);
+        if (stub == serverStubMap.cend()) {
+            JOYNR_LOG_ERROR(logger(),
+                            "No shared memory connection found for address {}",
+                            serverAddress->toString());
+            return std::shared_ptr<IMessagingStub>();
+        }
+        return stub->second;
+    }
+
+    return std::shared_ptr<IMessagingStub>();
+}
+
+void SharedMemoryMessagingStubFactory::addClient(
+        const system::RoutingTypes::SharedMemoryClientAddress& clientAddress,
+        std::shared_ptr<SharedMemorySender> sender)
+{
+    std::lock_guard<std::mutex> lock(clientStubMapMutex);
+    if (clientStubMap.count(clientAddress) == 0) {
+        JOYNR_LOG_INFO(logger(), "adding messaging stub for address: {}", clientAddress.toString());
+        clientStubMap[clientAddress] =
+                std::make_shared<SharedMemoryMessagingStub>(std::move(sender));
+    } else {
+        JOYNR_LOG_ERROR(logger(),
+                        "Client with address {} already exists in the clientStubMap",
+                        clientAddress.toString());
+    }
+}
+
+void SharedMemoryMessagingStubFactory::removeClient(
+        const joynr::system::RoutingTypes::SharedMemoryClientAddress& clientAddress)
+{
+    std::lock_guard<std::mutex> lock(clientStubMapMutex);
+    clientStubMap.erase(clientAddress);
+}
+
+void SharedMemoryMessagingStubFactory::addServer(
+        const joynr::system::RoutingTypes::SharedMemoryAddress& serverAddress,
+        std::shared_ptr<SharedMemorySender> sender)
+{
+    auto serverStub = std::make_shared<SharedMemoryMessagingStub>(std::move(sender));
+    {
+        std::lock_guard<std::mutex> lock(serverStubMapMutex);
+        serverStubMap[serverAddress] = std::move(serverStub);
+    }
+}
+
+void SharedMemoryMessagingStubFactory::onMessagingStubClosed(
+        const system::RoutingTypes::Address& address)
+{
+    JOYNR_LOG_INFO(logger(), "removing messaging stub for address: {}", address.toString());
+    std::shared_ptr<const system::RoutingTypes::Address> addressPtr = nullptr;
+    if (auto clientAddress =
+                dynamic_cast<const system::RoutingTypes::SharedMemoryClientAddress*>(&address)) {
+        std::lock_guard<std::mutex> lock(clientStubMapMutex);
+        addressPtr =
+                std::make_shared<const system::RoutingTypes::SharedMemoryClientAddress>(
+                        *clientAddress);
+        clientStubMap.erase(*clientAddress);
+    } else if (auto serverAddress =
+                       dynamic_cast<const system::RoutingTypes::SharedMemoryAddress*>(&address)) {
+        std::lock_guard<std::mutex> lock(serverStubMapMutex);
+        addressPtr =
+                std::make_shared<const system::RoutingTypes::SharedMemoryAddress>(*serverAddress);
+        serverStubMap.erase(*serverAddress);
+    }
+    if (onMessagingStubClosedCallback) {
+        onMessagingStubClosedCallback(addressPtr);
+    }
+}
+
+void SharedMemoryMessagingStubFactory::registerOnMessagingStubClosedCallback(
+        std::function<void(std::shared_ptr<const joynr::system::RoutingTypes::Address>
+                                   destinationAddress)> onMessagingStubClosedCallback)
+{
+    this->onMessagingStubClosedCallback = std::move(onMessagingStubClosedCallback);
+}
+
+} // namespace joynr
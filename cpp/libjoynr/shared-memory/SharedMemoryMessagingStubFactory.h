@@ -0,0 +1,77 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYMESSAGINGSTUBFACTORY_H
+#define SHAREDMEMORYMESSAGINGSTUBFACTORY_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "joynr/IMiddlewareMessagingStubFactory.h"
+#include "joynr/Logger.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+#include "joynr/system/RoutingTypes/SharedMemoryClientAddress.h"
+
+namespace joynr
+{
+
+class IMessagingStub;
+class SharedMemorySender;
+
+namespace system
+{
+namespace RoutingTypes
+{
+class Address;
+} // namespace RoutingTypes
+} // namespace system
+
+class SharedMemoryMessagingStubFactory : public IMiddlewareMessagingStubFactory
+{
+
+public:
+    SharedMemoryMessagingStubFactory();
+    std::shared_ptr<IMessagingStub> create(
+            const joynr::system::RoutingTypes::Address& destAddress) override;
+    bool canCreate(const joynr::system::RoutingTypes::Address& destAddress) override;
+    void addClient(const joynr::system::RoutingTypes::SharedMemoryClientAddress& clientAddress,
+                   std::shared_ptr<SharedMemorySender> sender);
+    void removeClient(const joynr::system::RoutingTypes::SharedMemoryClientAddress& clientAddress);
+    void addServer(const joynr::system::RoutingTypes::SharedMemoryAddress& serverAddress,
+                   std::shared_ptr<SharedMemorySender> sender);
+    void onMessagingStubClosed(const joynr::system::RoutingTypes::Address& address);
+    void registerOnMessagingStubClosedCallback(std::function<
+            void(std::shared_ptr<const joynr::system::RoutingTypes::Address> destinationAddress)>
+                                                       onMessagingStubClosedCallback) override;
+
+private:
+    std::unordered_map<joynr::system::RoutingTypes::SharedMemoryAddress,
+                       std::shared_ptr<IMessagingStub>> serverStubMap;
+    std::mutex serverStubMapMutex;
+    std::unordered_map<joynr::system::RoutingTypes::SharedMemoryClientAddress,
+                       std::shared_ptr<IMessagingStub>> clientStubMap;
+    std::mutex clientStubMapMutex;
+    std::function<void(std::shared_ptr<const joynr::system::RoutingTypes::Address>
+                               destinationAddress)> onMessagingStubClosedCallback;
+
+    ADD_LOGGER(SharedMemoryMessagingStubFactory)
+};
+
+} // namespace joynr
+#endif // SHAREDMEMORYMESSAGINGSTUBFACTORY_H
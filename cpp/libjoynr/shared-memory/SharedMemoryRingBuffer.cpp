@@ -0,0 +1,188 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/SharedMemoryRingBuffer.h"
+
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+namespace
+{
+
+// every frame is preceded by its length and padded to a multiple of the frame alignment
+constexpr std::size_t frameAlignment = 8;
+constexpr std::size_t frameHeaderSize = 8;
+// length marking the unused remainder at the end of the buffer
+constexpr std::uint32_t paddingMarker = std::numeric_limits<std::uint32_t>::max();
+
+std::size_t getRecordSize(std::size_t frameSize)
+{
+    return (frameHeaderSize + frameSize + frameAlignment - 1) & ~(frameAlignment - 1);
+}
+
+} // namespace
+
+struct SharedMemoryRingBuffer::Header
+{
+    Header() : writePosition(0), readPosition(0), consumerWaiting(0)
+    {
+    }
+
+    // positions are increased monotonically and taken modulo the capacity;
+    // each one is written by one side only and lives in its own cache line
+    alignas(64) std::atomic<std::uint64_t> writePosition;
+    alignas(64) std::atomic<std::uint64_t> readPosition;
+    alignas(64) std::atomic<std::uint32_t> consumerWaiting;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "shared memory requires lock free 64 bit atomics");
+
+std::size_t SharedMemoryRingBuffer::getRequiredSize(std::size_t capacity)
+{
+    return sizeof(Header) + capacity;
+}
+
+SharedMemoryRingBuffer::SharedMemoryRingBuffer(void* memory, std::size_t capacity)
+        : header(static_cast<Header*>(memory)),
+          data(static_cast<std::uint8_t*>(memory) + sizeof(Header)),
+          capacity(capacity)
+{
+    assert(capacity % frameAlignment == 0);
+    assert(capacity >= 2 * frameHeaderSize);
+}
+
+void SharedMemoryRingBuffer::initialize()
+{
+    new (header) Header();
+}
+
+std::size_t SharedMemoryRingBuffer::getMaxFrameSize() const
+{
+    // a frame of this size fits in even if the remainder at the end of the buffer
+    // has to be skipped
+    return capacity / 2 - frameHeaderSize;
+}
+
+bool SharedMemoryRingBuffer::tryWrite(const smrf::ByteArrayView& frame)
+{
+    if (frame.size() > getMaxFrameSize()) {
+        return false;
+    }
+    const std::size_t recordSize = getRecordSize(frame.size());
+    std::uint64_t writePosition = header->writePosition.load(std::memory_order_relaxed);
+    const std::uint64_t readPosition = header->readPosition.load(std::memory_order_acquire);
+    if (writePosition - readPosition > capacity || writePosition % frameAlignment != 0) {
+        // corrupted by the peer, never write outside of the buffer
+        return false;
+    }
+    const std::size_t freeSpace = capacity - static_cast<std::size_t>(writePosition - readPosition);
+    std::size_t offset = static_cast<std::size_t>(writePosition % capacity);
+    const std::size_t remainder = capacity - offset;
+    const bool wrap = remainder < recordSize;
+
+    if (recordSize + (wrap ? remainder : 0) > freeSpace) {
+        return false;
+    }
+
+    if (wrap) {
+        const std::uint32_t marker = paddingMarker;
+        std::memcpy(data + offset, &marker, sizeof(marker));
+        writePosition += remainder;
+        offset = 0;
+    }
+
+    const std::uint32_t length = static_cast<std::uint32_t>(frame.size());
+    std::memcpy(data + offset, &length, sizeof(length));
+    std::memcpy(data + offset + frameHeaderSize, frame.data(), frame.size());
+
+    // sequentially consistent in order to pair with prepareWait of the consumer
+    header->writePosition.store(writePosition + recordSize);
+    return true;
+}
+
+bool SharedMemoryRingBuffer::consumerNeedsWakeup()
+{
+    return header->consumerWaiting.load() != 0 && header->consumerWaiting.exchange(0) != 0;
+}
+
+std::size_t SharedMemoryRingBuffer::read(
+        const std::function<void(const smrf::ByteArrayView&)>& onFrame)
+{
+    std::size_t numberOfFrames = 0;
+    std::uint64_t readPosition = header->readPosition.load(std::memory_order_relaxed);
+    const std::uint64_t writePosition = header->writePosition.load(std::memory_order_acquire);
+
+    // the positions and lengths are written by the peer and must not be trusted
+    if (writePosition - readPosition > capacity || readPosition % frameAlignment != 0) {
+        throw exceptions::JoynrRuntimeException(
+                "Shared memory ring buffer corrupted: read position " +
+                std::to_string(readPosition) + ", write position " +
+                std::to_string(writePosition));
+    }
+
+    while (readPosition != writePosition) {
+        const std::size_t offset = static_cast<std::size_t>(readPosition % capacity);
+        std::uint32_t length;
+        std::memcpy(&length, data + offset, sizeof(length));
+        std::size_t recordSize;
+        if (length == paddingMarker) {
+            recordSize = capacity - offset;
+        } else if (length > capacity - offset - frameHeaderSize) {
+            throw exceptions::JoynrRuntimeException(
+                    "Shared memory ring buffer corrupted: frame length " +
+                    std::to_string(length) + " at offset " + std::to_string(offset) +
+                    " exceeds the buffer");
+        } else {
+            recordSize = getRecordSize(length);
+        }
+        if (recordSize > writePosition - readPosition) {
+            throw exceptions::JoynrRuntimeException(
+                    "Shared memory ring buffer corrupted: record at offset " +
+                    std::to_string(offset) + " exceeds the write position");
+        }
+        if (length != paddingMarker) {
+            onFrame(smrf::ByteArrayView(data + offset + frameHeaderSize, length));
+            ++numberOfFrames;
+        }
+        readPosition += recordSize;
+        // release the space right away so that the producer can continue
+        header->readPosition.store(readPosition, std::memory_order_release);
+    }
+    return numberOfFrames;
+}
+
+bool SharedMemoryRingBuffer::prepareWait()
+{
+    header->consumerWaiting.store(1);
+    if (header->writePosition.load() != header->readPosition.load(std::memory_order_relaxed)) {
+        header->consumerWaiting.store(0);
+        return false;
+    }
+    return true;
+}
+
+} // namespace joynr
@@ -0,0 +1,70 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynr/shared-memory/SharedMemorySender.h"
+
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+SharedMemorySender::SharedMemorySender(std::shared_ptr<SharedMemoryConnection> connection)
+        : connection(std::move(connection)), connectionMutex()
+{
+}
+
+void SharedMemorySender::send(
+        const smrf::ByteArrayView& frame,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    std::shared_ptr<SharedMemoryConnection> currentConnection = getConnection();
+    if (!currentConnection) {
+        onFailure(exceptions::JoynrDelayMessageException(
+                "Error sending message via SharedMemorySender: not connected"));
+        return;
+    }
+    JOYNR_LOG_TRACE(logger(), "outgoing frame of size {}", frame.size());
+    currentConnection->send(frame, onFailure);
+}
+
+bool SharedMemorySender::isConnected() const
+{
+    std::shared_ptr<SharedMemoryConnection> currentConnection = getConnection();
+    return currentConnection && currentConnection->isOpen();
+}
+
+void SharedMemorySender::setConnection(std::shared_ptr<SharedMemoryConnection> connection)
+{
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    this->connection = std::move(connection);
+}
+
+void SharedMemorySender::resetConnection()
+{
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    connection.reset();
+}
+
+std::shared_ptr<SharedMemoryConnection> SharedMemorySender::getConnection() const
+{
+    std::lock_guard<std::mutex> lock(connectionMutex);
+    return connection;
+}
+
+} // namespace joynr
@@ -0,0 +1,76 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYSENDER_H
+#define SHAREDMEMORYSENDER_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class SharedMemoryConnection;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @class SharedMemorySender
+ * @brief Sends frames over the current @ref SharedMemoryConnection.
+ *
+ * The sender outlives reconnects: messaging stubs keep using the same sender
+ * while the connection it refers to is replaced.
+ */
+class SharedMemorySender
+{
+public:
+    SharedMemorySender() = default;
+    explicit SharedMemorySender(std::shared_ptr<SharedMemoryConnection> connection);
+    ~SharedMemorySender() = default;
+
+    void send(const smrf::ByteArrayView& frame,
+              const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+
+    bool isConnected() const;
+
+    void setConnection(std::shared_ptr<SharedMemoryConnection> connection);
+    void resetConnection();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SharedMemorySender);
+
+    std::shared_ptr<SharedMemoryConnection> getConnection() const;
+
+    std::shared_ptr<SharedMemoryConnection> connection;
+    mutable std::mutex connectionMutex;
+
+    ADD_LOGGER(SharedMemorySender)
+};
+
+} // namespace joynr
+
+#endif // SHAREDMEMORYSENDER_H
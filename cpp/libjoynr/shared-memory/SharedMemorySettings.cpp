@@ -0,0 +1,140 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/SharedMemorySettings.h"
+
+#include <cstdint>
+
+#include "joynr/Settings.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+
+namespace joynr
+{
+
+SharedMemorySettings::SharedMemorySettings(Settings& settings) : settings(settings)
+{
+    checkSettings();
+}
+
+void SharedMemorySettings::checkSettings()
+{
+    if (!settings.contains(SETTING_CC_MESSAGING_PATH())) {
+        setClusterControllerMessagingPath("");
+    }
+
+    if (!settings.contains(SETTING_RING_BUFFER_SIZE())) {
+        setRingBufferSize(DEFAULT_RING_BUFFER_SIZE());
+    }
+
+    if (!settings.contains(SETTING_RECONNECT_SLEEP_TIME_MS())) {
+        setReconnectSleepTimeMs(DEFAULT_RECONNECT_SLEEP_TIME_MS());
+    }
+}
+
+const std::string& SharedMemorySettings::SETTING_CC_MESSAGING_PATH()
+{
+    static const std::string value("shared-memory/cluster-controller-messaging-path");
+    return value;
+}
+
+const std::string& SharedMemorySettings::SETTING_RING_BUFFER_SIZE()
+{
+    static const std::string value("shared-memory/ring-buffer-size");
+    return value;
+}
+
+const std::string& SharedMemorySettings::SETTING_RECONNECT_SLEEP_TIME_MS()
+{
+    static const std::string value("shared-memory/reconnect-sleep-time-ms");
+    return value;
+}
+
+std::size_t SharedMemorySettings::DEFAULT_RING_BUFFER_SIZE()
+{
+    return 1024 * 1024;
+}
+
+std::chrono::milliseconds SharedMemorySettings::DEFAULT_RECONNECT_SLEEP_TIME_MS()
+{
+    return std::chrono::milliseconds(100);
+}
+
+bool SharedMemorySettings::isEnabled() const
+{
+    return !getClusterControllerMessagingPath().empty();
+}
+
+std::string SharedMemorySettings::getClusterControllerMessagingPath() const
+{
+    return settings.get<std::string>(SETTING_CC_MESSAGING_PATH());
+}
+
+void SharedMemorySettings::setClusterControllerMessagingPath(const std::string& path)
+{
+    settings.set(SETTING_CC_MESSAGING_PATH(), path);
+}
+
+system::RoutingTypes::SharedMemoryAddress SharedMemorySettings::
+        createClusterControllerMessagingAddress() const
+{
+    return system::RoutingTypes::SharedMemoryAddress(getClusterControllerMessagingPath());
+}
+
+std::size_t SharedMemorySettings::getRingBufferSize() const
+{
+    return static_cast<std::size_t>(settings.get<std::uint64_t>(SETTING_RING_BUFFER_SIZE()));
+}
+
+void SharedMemorySettings::setRingBufferSize(std::size_t ringBufferSize)
+{
+    settings.set(SETTING_RING_BUFFER_SIZE(), static_cast<std::uint64_t>(ringBufferSize));
+}
+
+std::chrono::milliseconds SharedMemorySettings::getReconnectSleepTimeMs() const
+{
+    return std::chrono::milliseconds(
+            settings.get<std::int64_t>(SETTING_RECONNECT_SLEEP_TIME_MS()));
+}
+
+void SharedMemorySettings::setReconnectSleepTimeMs(
+        const std::chrono::milliseconds reconnectSleepTimeMs)
+{
+    settings.set(SETTING_RECONNECT_SLEEP_TIME_MS(), reconnectSleepTimeMs.count());
+}
+
+bool SharedMemorySettings::contains(const std::string& key) const
+{
+    return settings.contains(key);
+}
+
+void SharedMemorySettings::printSettings() const
+{
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_CC_MESSAGING_PATH(),
+                   getClusterControllerMessagingPath());
+
+    JOYNR_LOG_INFO(logger(), "SETTING: {} = {}", SETTING_RING_BUFFER_SIZE(), getRingBufferSize());
+
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_RECONNECT_SLEEP_TIME_MS(),
+                   getReconnectSleepTimeMs().count());
+}
+
+} // namespace joynr
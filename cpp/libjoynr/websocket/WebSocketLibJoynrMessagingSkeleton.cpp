@@ -63,7 +63,7 @@ void WebSocketLibJoynrMessagingSkeleton::onMessageReceived(smrf::ByteVector&& me
         return;
     }
 
-    if (immutableMessage->getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+    if (immutableMessage->getMessageType() == MessageType::MULTICAST) {
         immutableMessage->setReceivedFromGlobal(true);
     }
 
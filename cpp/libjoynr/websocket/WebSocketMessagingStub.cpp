@@ -18,8 +18,6 @@
  */
 #include "libjoynr/websocket/WebSocketMessagingStub.h"
 
-#include <smrf/ByteArrayView.h>
-
 #include "joynr/ImmutableMessage.h"
 #include "joynr/IWebSocketSendInterface.h"
 #include "joynr/exceptions/JoynrException.h"
@@ -50,8 +48,7 @@ void WebSocketMessagingStub::transmit(
     }
 
     JOYNR_LOG_DEBUG(logger(), ">>> OUTGOING >>> {}", message->toLogMessage());
-    smrf::ByteArrayView serializedMessageView(message->getSerializedMessage());
-    webSocket->send(serializedMessageView, onFailure);
+    webSocket->send(std::move(message), onFailure);
 }
 
 } // namespace joynr
@@ -19,25 +19,44 @@
 #ifndef WEBSOCKETPPSENDER_H
 #define WEBSOCKETPPSENDER_H
 
+#include <cstddef>
 #include <functional>
+#include <memory>
+#include <string>
 
 #include <smrf/ByteVector.h>
 #include <websocketpp/error.hpp>
+#include <websocketpp/frame.hpp>
 
 #include "joynr/IWebSocketSendInterface.h"
+#include "joynr/ImmutableMessage.h"
 #include "joynr/Logger.h"
+#include "joynr/exceptions/JoynrException.h"
 
 namespace joynr
 {
 
+/**
+ * @brief Sends messages via a websocketpp connection
+ *
+ * Messages sent by a server are framed only once: the prepared frame is cached in the
+ * ImmutableMessage and the same frame is queued on every connection the message is delivered
+ * to. Clients have to mask every frame with a fresh key, hence they frame each message anew.
+ *
+ * If sendQueueLimitBytes is not 0, messages are rejected with a JoynrDelayMessageException while
+ * the data buffered for the connection exceeds the limit, so that a slow peer cannot make the
+ * send queue grow without bounds; the message router retries delayed messages later.
+ */
 template <typename Endpoint>
 class WebSocketPpSender : public IWebSocketSendInterface
 {
 protected:
     using ConnectionHandle = websocketpp::connection_hdl;
+    using Frame = typename Endpoint::message_ptr::element_type;
 
 public:
-    WebSocketPpSender(Endpoint& endpoint) : endpoint(endpoint), connectionHandle()
+    explicit WebSocketPpSender(Endpoint& endpoint, std::size_t sendQueueLimitBytes = 0)
+            : endpoint(endpoint), connectionHandle(), sendQueueLimitBytes(sendQueueLimitBytes)
     {
     }
 
@@ -48,17 +67,35 @@ public:
             const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) override
     {
         JOYNR_LOG_TRACE(logger(), "outgoing binary message of size {}", msg.size());
+        if (isSendQueueFull(onFailure)) {
+            return;
+        }
         websocketpp::lib::error_code websocketError;
         endpoint.send(connectionHandle,
                       msg.data(),
                       msg.size(),
                       websocketpp::frame::opcode::binary,
                       websocketError);
-        if (websocketError) {
-            onFailure(exceptions::JoynrDelayMessageException(
-                    "Error sending binary message via WebSocketPpSender: " +
-                    websocketError.message()));
+        handleSendError(websocketError, onFailure);
+    }
+
+    void send(
+            std::shared_ptr<ImmutableMessage> message,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) override
+    {
+        if (!endpoint.is_server()) {
+            send(smrf::ByteArrayView(message->getSerializedMessage()), onFailure);
+            return;
+        }
+        JOYNR_LOG_TRACE(logger(), "outgoing prepared binary message of size {}",
+                        message->getMessageSize());
+        if (isSendQueueFull(onFailure)) {
+            return;
         }
+        std::shared_ptr<Frame> frame = message->getOrCreateTransportFrame<Frame>(&prepareFrame);
+        websocketpp::lib::error_code websocketError;
+        endpoint.send(connectionHandle, std::move(frame), websocketError);
+        handleSendError(websocketError, onFailure);
     }
 
     /**
@@ -100,8 +137,63 @@ public:
     }
 
 private:
+    // frames the message as unmasked binary websocket message which can be sent by a server
+    static std::shared_ptr<Frame> prepareFrame(const smrf::ByteVector& serializedMessage)
+    {
+        namespace frame = websocketpp::frame;
+        const std::size_t size = serializedMessage.size();
+        // the frame is not bound to the message manager of a connection, hence it is not
+        // recycled and can be shared between connections
+        auto prepared = std::make_shared<Frame>(
+                typename Frame::con_msg_man_ptr(), frame::opcode::binary, size);
+        prepared->set_header(frame::prepare_header(
+                frame::basic_header(frame::opcode::binary, size, true, false),
+                frame::extended_header(size)));
+        prepared->set_payload(serializedMessage.data(), size);
+        prepared->set_prepared(true);
+        return prepared;
+    }
+
+    bool isSendQueueFull(
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) const
+    {
+        if (sendQueueLimitBytes == 0) {
+            return false;
+        }
+        websocketpp::lib::error_code websocketError;
+        typename Endpoint::connection_ptr connection =
+                endpoint.get_con_from_hdl(connectionHandle, websocketError);
+        if (websocketError || !connection) {
+            // reported by the subsequent send
+            return false;
+        }
+        const std::size_t bufferedAmount = connection->get_buffered_amount();
+        if (bufferedAmount < sendQueueLimitBytes) {
+            return false;
+        }
+        JOYNR_LOG_DEBUG(logger(),
+                        "send queue of websocket connection is full ({} bytes buffered)",
+                        bufferedAmount);
+        onFailure(exceptions::JoynrDelayMessageException(
+                "Send queue of websocket connection is full: " + std::to_string(bufferedAmount) +
+                " bytes buffered"));
+        return true;
+    }
+
+    void handleSendError(
+            const websocketpp::lib::error_code& websocketError,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) const
+    {
+        if (websocketError) {
+            onFailure(exceptions::JoynrDelayMessageException(
+                    "Error sending binary message via WebSocketPpSender: " +
+                    websocketError.message()));
+        }
+    }
+
     Endpoint& endpoint;
     ConnectionHandle connectionHandle;
+    const std::size_t sendQueueLimitBytes;
     ADD_LOGGER(WebSocketPpSender)
 };
 
@@ -63,6 +63,18 @@ void ClusterControllerSettings::checkSettings()
         setMqttClientIdPrefix(DEFAULT_MQTT_CLIENT_ID_PREFIX());
     }
 
+    if (!settings.contains(SETTING_MQTT_NUMBER_OF_CONNECTIONS())) {
+        setMqttNumberOfConnections(DEFAULT_MQTT_NUMBER_OF_CONNECTIONS());
+    }
+
+    if (!settings.contains(SETTING_WS_IO_SERVICE_THREAD_POOL_SIZE())) {
+        setWsIOServiceThreadPoolSize(DEFAULT_WS_IO_SERVICE_THREAD_POOL_SIZE());
+    }
+
+    if (!settings.contains(SETTING_WS_SEND_QUEUE_LIMIT_BYTES())) {
+        setWsSendQueueLimitBytes(DEFAULT_WS_SEND_QUEUE_LIMIT_BYTES());
+    }
+
     if (!settings.contains(SETTING_LOCAL_DOMAIN_ACCESS_STORE_PERSISTENCE_FILENAME())) {
         setLocalDomainAccessStorePersistenceFilename(
                 DEFAULT_LOCAL_DOMAIN_ACCESS_STORE_PERSISTENCE_FILENAME());
@@ -89,6 +101,32 @@ void ClusterControllerSettings::checkSettings()
                 DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES());
     }
 
+    if (!settings.contains(SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED())) {
+        setMessageQueueOverflowEnabled(DEFAULT_MESSAGE_QUEUE_OVERFLOW_ENABLED());
+    }
+
+    if (!settings.contains(SETTING_MESSAGE_QUEUE_OVERFLOW_DIRECTORY())) {
+        setMessageQueueOverflowDirectory(DEFAULT_MESSAGE_QUEUE_OVERFLOW_DIRECTORY());
+    }
+
+    if (!settings.contains(SETTING_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES())) {
+        setMessageQueueOverflowLimitBytes(DEFAULT_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES());
+    }
+
+    if (!settings.contains(SETTING_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES())) {
+        setMessageQueueOverflowSegmentSizeBytes(
+                DEFAULT_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES());
+    }
+
+    // messages are only moved to the overflow store when the byte limit of the queue is reached
+    if (isMessageQueueOverflowEnabled() && getMessageQueueLimitBytes() == 0) {
+        const std::string message = SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED() + " is set but " +
+                                    SETTING_MESSAGE_QUEUE_LIMIT_BYTES() +
+                                    " is 0, the overflow store would never be used";
+        JOYNR_LOG_ERROR(logger(), message);
+        throw joynr::exceptions::JoynrConfigurationException(message);
+    }
+
     if (!settings.contains(SETTING_MQTT_MULTICAST_TOPIC_PREFIX())) {
         setMqttMulticastTopicPrefix(DEFAULT_MQTT_MULTICAST_TOPIC_PREFIX());
     }
@@ -110,6 +148,10 @@ void ClusterControllerSettings::checkSettings()
                      DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS().count());
     }
 
+    if (!settings.contains(SETTING_CAPABILITIES_CLIENT_BATCH_WINDOW_MS())) {
+        setCapabilitiesClientBatchWindowMs(DEFAULT_CAPABILITIES_CLIENT_BATCH_WINDOW_MS());
+    }
+
     if (!settings.contains(SETTING_MQTT_TLS_ENABLED())) {
         settings.set(SETTING_MQTT_TLS_ENABLED(), DEFAULT_MQTT_TLS_ENABLED());
     }
@@ -126,6 +168,11 @@ void ClusterControllerSettings::checkSettings()
         settings.set(SETTING_ACCESS_CONTROL_AUDIT(), DEFAULT_ACCESS_CONTROL_AUDIT());
     }
 
+    if (!settings.contains(SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE())) {
+        settings.set(SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE(),
+                     DEFAULT_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE());
+    }
+
     if (isMqttTlsEnabled()) {
         if (!isMqttCertificateAuthorityCertificateFolderPathSet() &&
             !isMqttCertificateAuthorityPemFilenameSet()) {
@@ -233,6 +280,18 @@ const std::string& ClusterControllerSettings::SETTING_WS_PORT()
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_WS_IO_SERVICE_THREAD_POOL_SIZE()
+{
+    static const std::string value("cluster-controller/ws-io-service-thread-pool-size");
+    return value;
+}
+
+const std::string& ClusterControllerSettings::SETTING_WS_SEND_QUEUE_LIMIT_BYTES()
+{
+    static const std::string value("cluster-controller/ws-send-queue-limit-bytes");
+    return value;
+}
+
 const std::string& ClusterControllerSettings::SETTING_USE_ONLY_LDAS()
 {
     static const std::string value("access-control/use-ldas-only");
@@ -251,6 +310,12 @@ const std::string& ClusterControllerSettings::SETTING_ACCESS_CONTROL_AUDIT()
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE()
+{
+    static const std::string value("access-control/consumer-permission-cache-size");
+    return value;
+}
+
 const std::string& ClusterControllerSettings::
         SETTING_ACCESS_CONTROL_GLOBAL_DOMAIN_ACCESS_CONTROLLER_ADDRESS()
 {
@@ -271,6 +336,12 @@ const std::string& ClusterControllerSettings::SETTING_MQTT_CLIENT_ID_PREFIX()
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_MQTT_NUMBER_OF_CONNECTIONS()
+{
+    static const std::string value("cluster-controller/mqtt-number-of-connections");
+    return value;
+}
+
 const std::string& ClusterControllerSettings::SETTING_MQTT_MULTICAST_TOPIC_PREFIX()
 {
     static const std::string value("cluster-controller/mqtt-multicast-topic-prefix");
@@ -352,6 +423,12 @@ const std::string& ClusterControllerSettings::SETTING_CAPABILITIES_FRESHNESS_UPD
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_CAPABILITIES_CLIENT_BATCH_WINDOW_MS()
+{
+    static const std::string value("cluster-controller/capabilities-client-batch-window-ms");
+    return value;
+}
+
 int ClusterControllerSettings::DEFAULT_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS()
 {
     return 60 * 60 * 1000; // 1 hour
@@ -364,12 +441,34 @@ std::chrono::milliseconds ClusterControllerSettings::
     return value;
 }
 
+std::chrono::milliseconds ClusterControllerSettings::DEFAULT_CAPABILITIES_CLIENT_BATCH_WINDOW_MS()
+{
+    static const std::chrono::milliseconds value(10);
+    return value;
+}
+
 const std::string& ClusterControllerSettings::DEFAULT_MQTT_CLIENT_ID_PREFIX()
 {
     static const std::string value("joynr");
     return value;
 }
 
+std::uint16_t ClusterControllerSettings::DEFAULT_MQTT_NUMBER_OF_CONNECTIONS()
+{
+    return 1;
+}
+
+std::uint16_t ClusterControllerSettings::DEFAULT_WS_IO_SERVICE_THREAD_POOL_SIZE()
+{
+    // one thread per hardware thread
+    return 0;
+}
+
+std::uint64_t ClusterControllerSettings::DEFAULT_WS_SEND_QUEUE_LIMIT_BYTES()
+{
+    return 8 * 1024 * 1024;
+}
+
 bool ClusterControllerSettings::DEFAULT_MQTT_TLS_ENABLED()
 {
     return false;
@@ -392,6 +491,11 @@ bool ClusterControllerSettings::DEFAULT_ACCESS_CONTROL_AUDIT()
     return false;
 }
 
+std::size_t ClusterControllerSettings::DEFAULT_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE()
+{
+    return 1000;
+}
+
 std::uint64_t ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_LIMIT()
 {
     return 0;
@@ -417,6 +521,27 @@ std::uint64_t ClusterControllerSettings::DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_L
     return 0;
 }
 
+bool ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_ENABLED()
+{
+    return false;
+}
+
+const std::string& ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_DIRECTORY()
+{
+    static const std::string value("MessageQueueOverflow");
+    return value;
+}
+
+std::uint64_t ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES()
+{
+    return 64 * 1024 * 1024;
+}
+
+std::uint64_t ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES()
+{
+    return 1024 * 1024;
+}
+
 const std::string& ClusterControllerSettings::DEFAULT_MQTT_MULTICAST_TOPIC_PREFIX()
 {
     static const std::string value("");
@@ -508,6 +633,26 @@ void ClusterControllerSettings::setWsPort(std::uint16_t port)
     settings.set(SETTING_WS_PORT(), port);
 }
 
+std::uint16_t ClusterControllerSettings::getWsIOServiceThreadPoolSize() const
+{
+    return settings.get<std::uint16_t>(SETTING_WS_IO_SERVICE_THREAD_POOL_SIZE());
+}
+
+void ClusterControllerSettings::setWsIOServiceThreadPoolSize(std::uint16_t threadPoolSize)
+{
+    settings.set(SETTING_WS_IO_SERVICE_THREAD_POOL_SIZE(), threadPoolSize);
+}
+
+std::uint64_t ClusterControllerSettings::getWsSendQueueLimitBytes() const
+{
+    return settings.get<std::uint64_t>(SETTING_WS_SEND_QUEUE_LIMIT_BYTES());
+}
+
+void ClusterControllerSettings::setWsSendQueueLimitBytes(std::uint64_t sendQueueLimitBytes)
+{
+    settings.set(SETTING_WS_SEND_QUEUE_LIMIT_BYTES(), sendQueueLimitBytes);
+}
+
 bool ClusterControllerSettings::isMqttClientIdPrefixSet() const
 {
     return settings.contains(SETTING_MQTT_CLIENT_ID_PREFIX());
@@ -535,6 +680,16 @@ void ClusterControllerSettings::setMqttClientIdPrefix(const std::string& mqttCli
     settings.set(SETTING_MQTT_CLIENT_ID_PREFIX(), mqttClientId);
 }
 
+std::uint16_t ClusterControllerSettings::getMqttNumberOfConnections() const
+{
+    return settings.get<std::uint16_t>(SETTING_MQTT_NUMBER_OF_CONNECTIONS());
+}
+
+void ClusterControllerSettings::setMqttNumberOfConnections(std::uint16_t numberOfConnections)
+{
+    settings.set(SETTING_MQTT_NUMBER_OF_CONNECTIONS(), numberOfConnections);
+}
+
 std::string ClusterControllerSettings::getMqttMulticastTopicPrefix() const
 {
     return settings.get<std::string>(SETTING_MQTT_MULTICAST_TOPIC_PREFIX());
@@ -705,6 +860,30 @@ const std::string& ClusterControllerSettings::SETTING_TRANSPORT_NOT_AVAILABLE_QU
     return value;
 }
 
+const std::string& ClusterControllerSettings::SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED()
+{
+    static const std::string value("cluster-controller/message-queue-overflow-enabled");
+    return value;
+}
+
+const std::string& ClusterControllerSettings::SETTING_MESSAGE_QUEUE_OVERFLOW_DIRECTORY()
+{
+    static const std::string value("cluster-controller/message-queue-overflow-directory");
+    return value;
+}
+
+const std::string& ClusterControllerSettings::SETTING_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES()
+{
+    static const std::string value("cluster-controller/message-queue-overflow-limit-bytes");
+    return value;
+}
+
+const std::string& ClusterControllerSettings::SETTING_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES()
+{
+    static const std::string value("cluster-controller/message-queue-overflow-segment-size-bytes");
+    return value;
+}
+
 const std::string& ClusterControllerSettings::
         SETTING_LOCAL_DOMAIN_ACCESS_STORE_PERSISTENCE_FILENAME()
 {
@@ -787,6 +966,47 @@ void ClusterControllerSettings::setTransportNotAvailableQueueLimitBytes(std::uin
     settings.set(SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES(), limitBytes);
 }
 
+bool ClusterControllerSettings::isMessageQueueOverflowEnabled() const
+{
+    return settings.get<bool>(SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED());
+}
+
+void ClusterControllerSettings::setMessageQueueOverflowEnabled(bool enabled)
+{
+    settings.set(SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED(), enabled);
+}
+
+std::string ClusterControllerSettings::getMessageQueueOverflowDirectory() const
+{
+    return settings.get<std::string>(SETTING_MESSAGE_QUEUE_OVERFLOW_DIRECTORY());
+}
+
+void ClusterControllerSettings::setMessageQueueOverflowDirectory(const std::string& directory)
+{
+    settings.set(SETTING_MESSAGE_QUEUE_OVERFLOW_DIRECTORY(), directory);
+}
+
+std::uint64_t ClusterControllerSettings::getMessageQueueOverflowLimitBytes() const
+{
+    return settings.get<std::uint64_t>(SETTING_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES());
+}
+
+void ClusterControllerSettings::setMessageQueueOverflowLimitBytes(std::uint64_t limitBytes)
+{
+    settings.set(SETTING_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES(), limitBytes);
+}
+
+std::uint64_t ClusterControllerSettings::getMessageQueueOverflowSegmentSizeBytes() const
+{
+    return settings.get<std::uint64_t>(SETTING_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES());
+}
+
+void ClusterControllerSettings::setMessageQueueOverflowSegmentSizeBytes(
+        std::uint64_t segmentSizeBytes)
+{
+    settings.set(SETTING_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES(), segmentSizeBytes);
+}
+
 void ClusterControllerSettings::setAclEntriesDirectory(const std::string& directoryPath)
 {
     settings.set(SETTING_ACL_ENTRIES_DIRECTORY(), directoryPath);
@@ -817,6 +1037,16 @@ void ClusterControllerSettings::setAclAudit(bool audit)
     settings.set(SETTING_ACCESS_CONTROL_AUDIT(), audit);
 }
 
+std::size_t ClusterControllerSettings::getConsumerPermissionCacheSize() const
+{
+    return settings.get<std::size_t>(SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE());
+}
+
+void ClusterControllerSettings::setConsumerPermissionCacheSize(std::size_t cacheSize)
+{
+    settings.set(SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE(), cacheSize);
+}
+
 std::string ClusterControllerSettings::getGlobalDomainAccessControlAddress() const
 {
     return settings.get<std::string>(
@@ -874,6 +1104,18 @@ void ClusterControllerSettings::setCapabilitiesFreshnessUpdateIntervalMs(
                         capabilitiesFreshnessUpdateIntervalMs.count());
 }
 
+std::chrono::milliseconds ClusterControllerSettings::getCapabilitiesClientBatchWindowMs() const
+{
+    return std::chrono::milliseconds(
+            settings.get<std::uint64_t>(SETTING_CAPABILITIES_CLIENT_BATCH_WINDOW_MS()));
+}
+
+void ClusterControllerSettings::setCapabilitiesClientBatchWindowMs(
+        std::chrono::milliseconds batchWindowMs)
+{
+    settings.set(SETTING_CAPABILITIES_CLIENT_BATCH_WINDOW_MS(), batchWindowMs.count());
+}
+
 void ClusterControllerSettings::printSettings() const
 {
     JOYNR_LOG_INFO(logger(),
@@ -902,6 +1144,22 @@ void ClusterControllerSettings::printSettings() const
                    "SETTING: {} = {}",
                    SETTING_MESSAGE_QUEUE_LIMIT_BYTES(),
                    getMessageQueueLimitBytes());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED(),
+                   isMessageQueueOverflowEnabled());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MESSAGE_QUEUE_OVERFLOW_DIRECTORY(),
+                   getMessageQueueOverflowDirectory());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES(),
+                   getMessageQueueOverflowLimitBytes());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES(),
+                   getMessageQueueOverflowSegmentSizeBytes());
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {}",
                    SETTING_PER_PARTICIPANTID_MESSAGE_QUEUE_LIMIT(),
@@ -918,6 +1176,11 @@ void ClusterControllerSettings::printSettings() const
     JOYNR_LOG_INFO(
             logger(), "SETTING: {} = {}", SETTING_MQTT_CLIENT_ID_PREFIX(), getMqttClientIdPrefix());
 
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_MQTT_NUMBER_OF_CONNECTIONS(),
+                   getMqttNumberOfConnections());
+
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {}",
                    SETTING_MQTT_MULTICAST_TOPIC_PREFIX(),
@@ -940,6 +1203,15 @@ void ClusterControllerSettings::printSettings() const
         JOYNR_LOG_INFO(logger(), "SETTING: {} = NOT SET", SETTING_WS_PORT());
     }
 
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_WS_IO_SERVICE_THREAD_POOL_SIZE(),
+                   getWsIOServiceThreadPoolSize());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {}",
+                   SETTING_WS_SEND_QUEUE_LIMIT_BYTES(),
+                   getWsSendQueueLimitBytes());
+
     JOYNR_LOG_INFO(logger(), "SETTING: {} = {}", SETTING_MQTT_TLS_ENABLED(), isMqttTlsEnabled());
 
     if (isMqttCertificateAuthorityPemFilenameSet()) {
@@ -1009,10 +1281,18 @@ void ClusterControllerSettings::printSettings() const
                    "SETTING: {} = {})",
                    SETTING_ACCESS_CONTROL_AUDIT(),
                    settings.get<std::string>(SETTING_ACCESS_CONTROL_AUDIT()));
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE(),
+                   getConsumerPermissionCacheSize());
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {})",
                    SETTING_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS(),
                    getCapabilitiesFreshnessUpdateIntervalMs().count());
+    JOYNR_LOG_INFO(logger(),
+                   "SETTING: {} = {})",
+                   SETTING_CAPABILITIES_CLIENT_BATCH_WINDOW_MS(),
+                   getCapabilitiesClientBatchWindowMs().count());
     JOYNR_LOG_INFO(logger(),
                    "SETTING: {} = {})",
                    SETTING_GLOBAL_CAPABILITIES_DIRECTORY_COMPRESSED_MESSAGES_ENABLED(),
@@ -50,6 +50,9 @@ void AccessControlListEditor::updateMasterAccessControlEntry(
     } else {
         bool updateSuccess =
                 localDomainAccessStore->updateMasterAccessControlEntry(updatedMasterAce);
+        if (updateSuccess) {
+            localDomainAccessController->notifyAccessControlChanged();
+        }
         onSuccess(updateSuccess);
     }
 }
@@ -68,6 +71,9 @@ void AccessControlListEditor::removeMasterAccessControlEntry(
     } else {
         bool updateSuccess = localDomainAccessStore->removeMasterAccessControlEntry(
                 uid, domain, interfaceName, operation);
+        if (updateSuccess) {
+            localDomainAccessController->notifyAccessControlChanged();
+        }
         onSuccess(updateSuccess);
     }
 }
@@ -84,6 +90,9 @@ void AccessControlListEditor::updateMediatorAccessControlEntry(
     } else {
         bool updateSuccess =
                 localDomainAccessStore->updateMediatorAccessControlEntry(updatedMediatorAce);
+        if (updateSuccess) {
+            localDomainAccessController->notifyAccessControlChanged();
+        }
         onSuccess(updateSuccess);
     }
 }
@@ -102,6 +111,9 @@ void AccessControlListEditor::removeMediatorAccessControlEntry(
     } else {
         bool updateSuccess = localDomainAccessStore->removeMediatorAccessControlEntry(
                 uid, domain, interfaceName, operation);
+        if (updateSuccess) {
+            localDomainAccessController->notifyAccessControlChanged();
+        }
         onSuccess(updateSuccess);
     }
 }
@@ -116,6 +128,9 @@ void AccessControlListEditor::updateOwnerAccessControlEntry(
         onSuccess(false);
     } else {
         bool updateSuccess = localDomainAccessStore->updateOwnerAccessControlEntry(updatedOwnerAce);
+        if (updateSuccess) {
+            localDomainAccessController->notifyAccessControlChanged();
+        }
         onSuccess(updateSuccess);
     }
 }
@@ -134,6 +149,9 @@ void AccessControlListEditor::removeOwnerAccessControlEntry(
     } else {
         bool updateSuccess = localDomainAccessStore->removeOwnerAccessControlEntry(
                 uid, domain, interfaceName, operation);
+        if (updateSuccess) {
+            localDomainAccessController->notifyAccessControlChanged();
+        }
         onSuccess(updateSuccess);
     }
 }
@@ -21,6 +21,7 @@
 
 #include <tuple>
 
+#include "ConsumerPermissionCache.h"
 #include "LocalDomainAccessController.h"
 #include "joynr/BroadcastSubscriptionRequest.h"
 #include "joynr/ImmutableMessage.h"
@@ -55,7 +56,8 @@ public:
             const std::string& domain,
             const std::string& interfaceName,
             TrustLevel::Enum trustlevel,
-            std::shared_ptr<IAccessController::IHasConsumerPermissionCallback> callback);
+            std::shared_ptr<IAccessController::IHasConsumerPermissionCallback> callback,
+            std::uint64_t cacheGeneration);
 
     // Callbacks made from the LocalDomainAccessController
     void permission(Permission::Enum permission) override;
@@ -68,6 +70,7 @@ private:
     std::string interfaceName;
     TrustLevel::Enum trustlevel;
     std::shared_ptr<IAccessController::IHasConsumerPermissionCallback> callback;
+    std::uint64_t cacheGeneration;
 
     bool convertToBool(Permission::Enum permission);
 };
@@ -78,13 +81,15 @@ AccessController::LdacConsumerPermissionCallback::LdacConsumerPermissionCallback
         const std::string& domain,
         const std::string& interfaceName,
         TrustLevel::Enum trustlevel,
-        std::shared_ptr<IAccessController::IHasConsumerPermissionCallback> callback)
+        std::shared_ptr<IAccessController::IHasConsumerPermissionCallback> callback,
+        std::uint64_t cacheGeneration)
         : owningAccessController(parent),
           message(std::move(message)),
           domain(domain),
           interfaceName(interfaceName),
           trustlevel(trustlevel),
-          callback(callback)
+          callback(callback),
+          cacheGeneration(cacheGeneration)
 {
 }
 
@@ -100,6 +105,11 @@ void AccessController::LdacConsumerPermissionCallback::permission(Permission::En
                         interfaceName,
                         message->getCreator());
     }
+    owningAccessController.consumerPermissionCache->insert(message->getCreator(),
+                                                           message->getRecipient(),
+                                                           trustlevel,
+                                                           hasPermission,
+                                                           cacheGeneration);
     callback->hasConsumerPermission(hasPermission);
 }
 
@@ -109,24 +119,26 @@ void AccessController::LdacConsumerPermissionCallback::operationNeeded()
 
     assert(!message->isEncrypted());
     std::string operation;
-    const std::string& messageType = message->getType();
-    if (messageType == Message::VALUE_MESSAGE_TYPE_ONE_WAY()) {
+    const MessageType messageType = message->getMessageType();
+    if (messageType == MessageType::ONE_WAY) {
         try {
             OneWayRequest request;
-            joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
+            joynr::serializer::deserialize(
+                    request, message->getUnencryptedBody(), message->getSerializer());
             operation = request.getMethodName();
         } catch (const std::exception& e) {
             JOYNR_LOG_ERROR(logger(), "could not deserialize OneWayRequest - error {}", e.what());
         }
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_REQUEST()) {
+    } else if (messageType == MessageType::REQUEST) {
         try {
             Request request;
-            joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
+            joynr::serializer::deserialize(
+                    request, message->getUnencryptedBody(), message->getSerializer());
             operation = request.getMethodName();
         } catch (const std::exception& e) {
             JOYNR_LOG_ERROR(logger(), "could not deserialize Request - error {}", e.what());
         }
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REQUEST()) {
+    } else if (messageType == MessageType::SUBSCRIPTION_REQUEST) {
         try {
             SubscriptionRequest request;
             joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
@@ -136,7 +148,7 @@ void AccessController::LdacConsumerPermissionCallback::operationNeeded()
             JOYNR_LOG_ERROR(
                     logger(), "could not deserialize SubscriptionRequest - error {}", e.what());
         }
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST()) {
+    } else if (messageType == MessageType::BROADCAST_SUBSCRIPTION_REQUEST) {
         try {
             BroadcastSubscriptionRequest request;
             joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
@@ -147,7 +159,7 @@ void AccessController::LdacConsumerPermissionCallback::operationNeeded()
                             "could not deserialize BroadcastSubscriptionRequest - error {}",
                             e.what());
         }
-    } else if (messageType == Message::VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST()) {
+    } else if (messageType == MessageType::MULTICAST_SUBSCRIPTION_REQUEST) {
         try {
             MulticastSubscriptionRequest request;
             joynr::serializer::deserializeFromJson(request, message->getUnencryptedBody());
@@ -207,9 +219,11 @@ class AccessController::ProviderRegistrationObserver
         : public LocalCapabilitiesDirectory::IProviderRegistrationObserver
 {
 public:
-    explicit ProviderRegistrationObserver(
-            std::shared_ptr<LocalDomainAccessController> localDomainAccessController)
-            : localDomainAccessController(localDomainAccessController)
+    ProviderRegistrationObserver(
+            std::shared_ptr<LocalDomainAccessController> localDomainAccessController,
+            std::shared_ptr<ConsumerPermissionCache> consumerPermissionCache)
+            : localDomainAccessController(localDomainAccessController),
+              consumerPermissionCache(consumerPermissionCache)
     {
     }
     void onProviderAdd(const DiscoveryEntry& discoveryEntry) override
@@ -220,28 +234,41 @@ public:
 
     void onProviderRemove(const DiscoveryEntry& discoveryEntry) override
     {
+        consumerPermissionCache->invalidate(discoveryEntry.getParticipantId());
         localDomainAccessController->unregisterProvider(
                 discoveryEntry.getDomain(), discoveryEntry.getInterfaceName());
     }
 
 private:
     std::shared_ptr<LocalDomainAccessController> localDomainAccessController;
+    std::shared_ptr<ConsumerPermissionCache> consumerPermissionCache;
 };
 
 AccessController::AccessController(
         std::shared_ptr<LocalCapabilitiesDirectory> localCapabilitiesDirectory,
-        std::shared_ptr<LocalDomainAccessController> localDomainAccessController)
+        std::shared_ptr<LocalDomainAccessController> localDomainAccessController,
+        std::size_t consumerPermissionCacheSize)
         : localCapabilitiesDirectory(localCapabilitiesDirectory),
           localDomainAccessController(localDomainAccessController),
-          providerRegistrationObserver(
-                  std::make_shared<ProviderRegistrationObserver>(localDomainAccessController)),
+          consumerPermissionCache(
+                  std::make_shared<ConsumerPermissionCache>(consumerPermissionCacheSize)),
+          providerRegistrationObserver(std::make_shared<ProviderRegistrationObserver>(
+                  localDomainAccessController,
+                  consumerPermissionCache)),
           whitelistParticipantIds()
 {
     localCapabilitiesDirectory->addProviderRegistrationObserver(providerRegistrationObserver);
+    localDomainAccessController->setAccessControlChangedCallback(
+            [cache = std::weak_ptr<ConsumerPermissionCache>(consumerPermissionCache)]() {
+                if (auto consumerPermissionCache = cache.lock()) {
+                    consumerPermissionCache->invalidate();
+                }
+            });
 }
 
 AccessController::~AccessController()
 {
+    localDomainAccessController->setAccessControlChangedCallback(nullptr);
     localCapabilitiesDirectory->removeProviderRegistrationObserver(providerRegistrationObserver);
 }
 
@@ -256,18 +283,18 @@ bool AccessController::needsHasConsumerPermissionCheck(const ImmutableMessage& m
         return false;
     }
 
-    const std::string& messageType = message.getType();
-    if (messageType == Message::VALUE_MESSAGE_TYPE_MULTICAST() ||
-        messageType == Message::VALUE_MESSAGE_TYPE_PUBLICATION() ||
-        messageType == Message::VALUE_MESSAGE_TYPE_REPLY() ||
-        messageType == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()) {
+    switch (message.getMessageType()) {
+    case MessageType::MULTICAST:
+    case MessageType::PUBLICATION:
+    case MessageType::REPLY:
+    case MessageType::SUBSCRIPTION_REPLY:
         // reply messages don't need permission check
         // they are filtered by request reply ID or subscritpion ID
         return false;
+    default:
+        // If this point is reached, checking is required
+        return true;
     }
-
-    // If this point is reached, checking is required
-    return true;
 }
 
 bool AccessController::needsHasProviderPermissionCheck() const
@@ -290,9 +317,19 @@ void AccessController::hasConsumerPermission(
         return;
     }
 
+    boost::optional<bool> cachedPermission = consumerPermissionCache->lookup(
+            message->getCreator(), message->getRecipient(), TrustLevel::HIGH);
+    if (cachedPermission) {
+        callback->hasConsumerPermission(*cachedPermission);
+        return;
+    }
+    // decisions computed from outdated access control data are not cached
+    const std::uint64_t cacheGeneration = consumerPermissionCache->getGeneration();
+
     // Get the domain and interface of the message destination
     std::function<void(const types::DiscoveryEntry&)> lookupSuccessCallback =
-            [message, this, callback](const types::DiscoveryEntry& discoveryEntry) {
+            [message, this, callback, cacheGeneration](
+                    const types::DiscoveryEntry& discoveryEntry) {
         const std::string& participantId = message->getRecipient();
         if (discoveryEntry.getParticipantId() != participantId) {
             JOYNR_LOG_ERROR(
@@ -305,8 +342,13 @@ void AccessController::hasConsumerPermission(
         std::string interfaceName = discoveryEntry.getInterfaceName();
 
         // Create a callback object
-        auto ldacCallback = std::make_shared<LdacConsumerPermissionCallback>(
-                *this, message, domain, interfaceName, TrustLevel::HIGH, callback);
+        auto ldacCallback = std::make_shared<LdacConsumerPermissionCallback>(*this,
+                                                                             message,
+                                                                             domain,
+                                                                             interfaceName,
+                                                                             TrustLevel::HIGH,
+                                                                             callback,
+                                                                             cacheGeneration);
 
         // Try to determine permission without expensive message deserialization
         // For now TrustLevel::HIGH is assumed.
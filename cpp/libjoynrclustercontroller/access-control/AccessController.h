@@ -20,10 +20,12 @@
 #ifndef ACCESSCONTROLLER_H
 #define ACCESSCONTROLLER_H
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "joynr/JoynrClusterControllerExport.h"
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/access-control/IAccessController.h"
@@ -31,17 +33,19 @@
 
 namespace joynr
 {
+class ConsumerPermissionCache;
 class LocalCapabilitiesDirectory;
 class LocalDomainAccessController;
 
 /**
  * Object that controls access to providers
  */
-class AccessController : public IAccessController
+class JOYNRCLUSTERCONTROLLER_EXPORT AccessController : public IAccessController
 {
 public:
     AccessController(std::shared_ptr<LocalCapabilitiesDirectory> localCapabilitiesDirectory,
-                     std::shared_ptr<LocalDomainAccessController> localDomainAccessController);
+                     std::shared_ptr<LocalDomainAccessController> localDomainAccessController,
+                     std::size_t consumerPermissionCacheSize);
 
     ~AccessController() override;
 
@@ -67,6 +71,8 @@ private:
 
     std::shared_ptr<LocalCapabilitiesDirectory> localCapabilitiesDirectory;
     std::shared_ptr<LocalDomainAccessController> localDomainAccessController;
+    // interface level decisions, operation level decisions are not cached
+    std::shared_ptr<ConsumerPermissionCache> consumerPermissionCache;
     std::shared_ptr<ProviderRegistrationObserver> providerRegistrationObserver;
     std::vector<std::string> whitelistParticipantIds;
 
@@ -0,0 +1,117 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "ConsumerPermissionCache.h"
+
+#include <boost/functional/hash.hpp>
+
+namespace joynr
+{
+
+using namespace infrastructure::DacTypes;
+
+std::size_t ConsumerPermissionCache::KeyHash::operator()(const Key& key) const
+{
+    std::size_t seed = 0;
+    boost::hash_combine(seed, key.userId);
+    boost::hash_combine(seed, key.participantId);
+    boost::hash_combine(seed, static_cast<int>(key.trustLevel));
+    return seed;
+}
+
+ConsumerPermissionCache::ConsumerPermissionCache(std::size_t maxSize)
+        : maxSize(maxSize), generation(0), lruList(), entries(), mutex()
+{
+}
+
+boost::optional<bool> ConsumerPermissionCache::lookup(const std::string& userId,
+                                                      const std::string& participantId,
+                                                      TrustLevel::Enum trustLevel)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto entry = entries.find(Key{userId, participantId, trustLevel});
+    if (entry == entries.cend()) {
+        return boost::none;
+    }
+    // move to the front, the least recently used decision is evicted first
+    lruList.splice(lruList.begin(), lruList, entry->second);
+    return entry->second->second;
+}
+
+void ConsumerPermissionCache::insert(const std::string& userId,
+                                     const std::string& participantId,
+                                     TrustLevel::Enum trustLevel,
+                                     bool hasPermission,
+                                     std::uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (maxSize == 0 || generation != this->generation) {
+        return;
+    }
+
+    Key key{userId, participantId, trustLevel};
+    auto entry = entries.find(key);
+    if (entry != entries.cend()) {
+        entry->second->second = hasPermission;
+        lruList.splice(lruList.begin(), lruList, entry->second);
+        return;
+    }
+
+    if (entries.size() >= maxSize) {
+        entries.erase(lruList.back().first);
+        lruList.pop_back();
+    }
+    lruList.emplace_front(key, hasPermission);
+    entries.emplace(std::move(key), lruList.begin());
+}
+
+std::uint64_t ConsumerPermissionCache::getGeneration() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return generation;
+}
+
+void ConsumerPermissionCache::invalidate()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++generation;
+    entries.clear();
+    lruList.clear();
+}
+
+void ConsumerPermissionCache::invalidate(const std::string& participantId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    ++generation;
+    for (auto it = lruList.begin(); it != lruList.end();) {
+        if (it->first.participantId == participantId) {
+            entries.erase(it->first);
+            it = lruList.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+std::size_t ConsumerPermissionCache::size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+} // namespace joynr
@@ -0,0 +1,103 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef CONSUMERPERMISSIONCACHE_H
+#define CONSUMERPERMISSIONCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <boost/optional.hpp>
+
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/infrastructure/DacTypes/TrustLevel.h"
+
+namespace joynr
+{
+
+/**
+ * Bounded LRU cache of interface level consumer permission decisions keyed by
+ * (creator userId, recipient participantId, trust level).
+ *
+ * Decisions are computed asynchronously. To avoid caching a decision which was
+ * computed from access control data that changed in the meantime, the caller
+ * obtains the current generation before starting the computation and passes it
+ * to insert(); invalidate() increments the generation.
+ */
+class ConsumerPermissionCache
+{
+public:
+    explicit ConsumerPermissionCache(std::size_t maxSize);
+
+    boost::optional<bool> lookup(const std::string& userId,
+                                 const std::string& participantId,
+                                 infrastructure::DacTypes::TrustLevel::Enum trustLevel);
+
+    void insert(const std::string& userId,
+                const std::string& participantId,
+                infrastructure::DacTypes::TrustLevel::Enum trustLevel,
+                bool hasPermission,
+                std::uint64_t generation);
+
+    std::uint64_t getGeneration() const;
+
+    // drop all decisions, e.g. after ACEs or domain roles have changed
+    void invalidate();
+
+    // drop all decisions for the given recipient, e.g. after the provider has been removed
+    void invalidate(const std::string& participantId);
+
+    std::size_t size() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(ConsumerPermissionCache);
+
+    struct Key
+    {
+        std::string userId;
+        std::string participantId;
+        infrastructure::DacTypes::TrustLevel::Enum trustLevel;
+
+        bool operator==(const Key& other) const
+        {
+            return trustLevel == other.trustLevel && userId == other.userId &&
+                   participantId == other.participantId;
+        }
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const;
+    };
+
+    using LruList = std::list<std::pair<Key, bool>>;
+
+    const std::size_t maxSize;
+    std::uint64_t generation;
+    LruList lruList;
+    std::unordered_map<Key, LruList::iterator, KeyHash> entries;
+    mutable std::mutex mutex;
+};
+
+} // namespace joynr
+
+#endif // CONSUMERPERMISSIONCACHE_H
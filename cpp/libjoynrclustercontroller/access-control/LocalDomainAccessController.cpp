@@ -242,7 +242,9 @@ LocalDomainAccessController::LocalDomainAccessController(
           ownerRegistrationControlEntryChangedBroadcastListener(
                   std::make_shared<OwnerRegistrationControlEntryChangedBroadcastListener>(*this)),
           multicastSubscriptionQos(std::make_shared<joynr::MulticastSubscriptionQos>(
-                  broadcastSubscriptionValidity.count()))
+                  broadcastSubscriptionValidity.count())),
+          accessControlChangedCallback(),
+          accessControlChangedCallbackMutex()
 {
 }
 
@@ -1100,6 +1102,11 @@ void LocalDomainAccessController::abortInitialization(const std::string& domain,
         }
     }
 
+    if (handleAces) {
+        // the denials above must not outlive the failed initialization
+        notifyAccessControlChanged();
+    }
+
     if (handleRces) {
         std::vector<ProviderPermissionRequest> requests;
         std::lock_guard<std::mutex> lock(initStateMutex);
@@ -1269,6 +1276,20 @@ std::string LocalDomainAccessController::createCompoundKey(const std::string& do
     return subscriptionMapKey;
 }
 
+void LocalDomainAccessController::setAccessControlChangedCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(accessControlChangedCallbackMutex);
+    accessControlChangedCallback = std::move(callback);
+}
+
+void LocalDomainAccessController::notifyAccessControlChanged()
+{
+    std::lock_guard<std::mutex> lock(accessControlChangedCallbackMutex);
+    if (accessControlChangedCallback) {
+        accessControlChangedCallback();
+    }
+}
+
 //--- Implementation of DomainRoleEntryChangedBroadcastListener ----------------
 
 LocalDomainAccessController::DomainRoleEntryChangedBroadcastListener::
@@ -1293,6 +1314,7 @@ void LocalDomainAccessController::DomainRoleEntryChangedBroadcastListener::onRec
         parent.localDomainAccessStore->removeDomainRole(changedDre.getUid(), changedDre.getRole());
     }
     JOYNR_LOG_TRACE(parent.logger(), "Changed DRE: {}", changedDre.toString());
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::DomainRoleEntryChangedBroadcastListener::onError(
@@ -1329,6 +1351,7 @@ void LocalDomainAccessController::MasterAccessControlEntryChangedBroadcastListen
                 changedMasterAce.getOperation());
         JOYNR_LOG_TRACE(parent.logger(), "Removed MasterAce: {}", changedMasterAce.toString());
     }
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::MasterAccessControlEntryChangedBroadcastListener::onError(
@@ -1364,6 +1387,7 @@ void LocalDomainAccessController::MediatorAccessControlEntryChangedBroadcastList
                 changedMediatorAce.getOperation());
     }
     JOYNR_LOG_TRACE(parent.logger(), "Changed MediatorAce: {}", changedMediatorAce.toString());
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::MediatorAccessControlEntryChangedBroadcastListener::onError(
@@ -1399,6 +1423,7 @@ void LocalDomainAccessController::OwnerAccessControlEntryChangedBroadcastListene
                 changedOwnerAce.getOperation());
     }
     JOYNR_LOG_TRACE(parent.logger(), "Changed OwnerAce: {}", changedOwnerAce.toString());
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::OwnerAccessControlEntryChangedBroadcastListener::onError(
@@ -1434,6 +1459,7 @@ void LocalDomainAccessController::MasterRegistrationControlEntryChangedBroadcast
                 changedMasterRce.getInterfaceName());
         JOYNR_LOG_TRACE(parent.logger(), "Removed MasterAce: {}", changedMasterRce.toString());
     }
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::MasterRegistrationControlEntryChangedBroadcastListener::onError(
@@ -1469,6 +1495,7 @@ void LocalDomainAccessController::MediatorRegistrationControlEntryChangedBroadca
                 changedMediatorRce.getInterfaceName());
     }
     JOYNR_LOG_TRACE(parent.logger(), "Changed MediatorRce: {}", changedMediatorRce.toString());
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::MediatorRegistrationControlEntryChangedBroadcastListener::onError(
@@ -1503,6 +1530,7 @@ void LocalDomainAccessController::OwnerRegistrationControlEntryChangedBroadcastL
                 changedOwnerRce.getInterfaceName());
     }
     JOYNR_LOG_TRACE(parent.logger(), "Changed OwnerRce: {}", changedOwnerRce.toString());
+    parent.notifyAccessControlChanged();
 }
 
 void LocalDomainAccessController::OwnerRegistrationControlEntryChangedBroadcastListener::onError(
@@ -22,6 +22,7 @@
 
 #include <chrono>
 #include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -471,6 +472,19 @@ public:
      */
     void unregisterProvider(const std::string& domain, const std::string& interfaceName);
 
+    /**
+     * Sets the callback which is invoked whenever ACEs or domain roles have changed,
+     * i.e. whenever previously determined consumer permissions may be outdated.
+     */
+    void setAccessControlChangedCallback(std::function<void()> callback);
+
+    /**
+     * Invokes the callback set by setAccessControlChangedCallback. Called on
+     * received ACE/RCE/DRE change broadcasts and by local modifications of the
+     * LocalDomainAccessStore.
+     */
+    void notifyAccessControlChanged();
+
 private:
     DISALLOW_COPY_AND_ASSIGN(LocalDomainAccessController);
 
@@ -665,6 +679,9 @@ private:
 
     std::shared_ptr<joynr::MulticastSubscriptionQos> multicastSubscriptionQos;
 
+    std::function<void()> accessControlChangedCallback;
+    std::mutex accessControlChangedCallbackMutex;
+
     static std::string sanitizeForPartition(const std::string& value);
 };
 } // namespace joynr
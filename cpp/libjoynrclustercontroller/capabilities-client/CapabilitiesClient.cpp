@@ -21,25 +21,80 @@
  * Client for the global capabilities directory.
  */
 
-#include "joynr/ClusterControllerSettings.h"
 #include "libjoynrclustercontroller/capabilities-client/CapabilitiesClient.h"
 
+#include <algorithm>
+#include <iterator>
+
+#include <boost/asio/io_service.hpp>
+
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/Util.h"
+
 namespace joynr
 {
 
-CapabilitiesClient::CapabilitiesClient(const ClusterControllerSettings& clusterControllerSettings)
+CapabilitiesClient::CapabilitiesClient(const ClusterControllerSettings& clusterControllerSettings,
+                                       boost::asio::io_service& ioService)
         : capabilitiesProxy(nullptr),
           messagingQos(),
-          touchTtl(clusterControllerSettings.getCapabilitiesFreshnessUpdateIntervalMs().count())
+          touchTtl(clusterControllerSettings.getCapabilitiesFreshnessUpdateIntervalMs().count()),
+          batchWindow(clusterControllerSettings.getCapabilitiesClientBatchWindowMs()),
+          pendingRequestsMutex(),
+          pendingAdds(),
+          pendingRemoves(),
+          isFlushScheduled(false),
+          isShutDown(false),
+          flushTimer(ioService),
+          startTime(std::chrono::steady_clock::now()),
+          isStartupRegistrationFinished(false),
+          numberOfStartupAdds(0),
+          numberOfUnfinishedStartupAdds(0)
 {
 }
 
+CapabilitiesClient::~CapabilitiesClient()
+{
+    shutdown();
+}
+
+void CapabilitiesClient::shutdown()
+{
+    std::vector<PendingAdd> adds;
+    std::vector<std::string> removes;
+    {
+        std::lock_guard<std::mutex> lock(pendingRequestsMutex);
+        if (isShutDown) {
+            return;
+        }
+        isShutDown = true;
+        flushTimer.cancel();
+        adds.swap(pendingAdds);
+        removes.swap(pendingRemoves);
+        isFlushScheduled = false;
+    }
+    // requests issued after the shutdown are sent immediately
+    sendPendingRequests(std::move(adds), std::move(removes));
+}
+
 void CapabilitiesClient::add(
         const types::GlobalDiscoveryEntry& entry,
         std::function<void()> onSuccess,
         std::function<void(const exceptions::JoynrRuntimeException& error)> onError)
 {
-    capabilitiesProxy->addAsync(entry, onSuccess, onError);
+    trackStartupRegistration(onSuccess, onError);
+    if (batchWindow.count() != 0) {
+        std::lock_guard<std::mutex> lock(pendingRequestsMutex);
+        if (!isShutDown) {
+            // the queued removes are sent before the adds, a pending remove of the same
+            // participant is superseded by this add
+            util::removeAll(pendingRemoves, entry.getParticipantId());
+            pendingAdds.push_back(PendingAdd{entry, std::move(onSuccess), std::move(onError)});
+            scheduleFlush();
+            return;
+        }
+    }
+    capabilitiesProxy->addAsync(entry, std::move(onSuccess), std::move(onError));
 }
 
 void CapabilitiesClient::add(
@@ -47,17 +102,236 @@ void CapabilitiesClient::add(
         std::function<void()> onSuccess,
         std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError)
 {
+    trackStartupRegistration(onSuccess, onRuntimeError);
+    if (batchWindow.count() != 0) {
+        // the batch is sent right away; the queued requests are sent before it so that it
+        // does not overtake them, and pending removes of the same participants are superseded
+        std::vector<PendingAdd> adds;
+        std::vector<std::string> removes;
+        {
+            std::lock_guard<std::mutex> lock(pendingRequestsMutex);
+            for (const auto& entry : globalDiscoveryEntries) {
+                util::removeAll(pendingRemoves, entry.getParticipantId());
+            }
+            adds.swap(pendingAdds);
+            removes.swap(pendingRemoves);
+        }
+        sendPendingRequests(std::move(adds), std::move(removes));
+    }
     capabilitiesProxy->addAsync(globalDiscoveryEntries, onSuccess, onRuntimeError);
 }
 
 void CapabilitiesClient::remove(const std::string& participantId)
 {
-    capabilitiesProxy->removeAsync(participantId);
+    remove(std::vector<std::string>{participantId});
 }
 
 void CapabilitiesClient::remove(std::vector<std::string> participantIdList)
 {
-    capabilitiesProxy->removeAsync(participantIdList);
+    std::vector<PendingAdd> supersededAdds;
+    bool isQueued = false;
+    if (batchWindow.count() != 0) {
+        std::lock_guard<std::mutex> lock(pendingRequestsMutex);
+        if (!isShutDown) {
+            // adds which have not been sent yet must not overtake the remove
+            auto isRemoved = [&participantIdList](const PendingAdd& pendingAdd) {
+                return std::find(participantIdList.cbegin(),
+                                 participantIdList.cend(),
+                                 pendingAdd.entry.getParticipantId()) != participantIdList.cend();
+            };
+            auto firstRemoved = std::stable_partition(
+                    pendingAdds.begin(), pendingAdds.end(), [&isRemoved](const PendingAdd& add) {
+                        return !isRemoved(add);
+                    });
+            std::move(firstRemoved, pendingAdds.end(), std::back_inserter(supersededAdds));
+            pendingAdds.erase(firstRemoved, pendingAdds.end());
+
+            for (auto& participantId : participantIdList) {
+                if (std::find(pendingRemoves.cbegin(), pendingRemoves.cend(), participantId) ==
+                    pendingRemoves.cend()) {
+                    pendingRemoves.push_back(std::move(participantId));
+                }
+            }
+            scheduleFlush();
+            isQueued = true;
+        }
+    }
+    if (!isQueued) {
+        sendRemoves(std::move(participantIdList));
+        return;
+    }
+
+    for (const auto& supersededAdd : supersededAdds) {
+        JOYNR_LOG_DEBUG(logger(),
+                        "add of participantId {} superseded by remove",
+                        supersededAdd.entry.getParticipantId());
+        if (supersededAdd.onError) {
+            supersededAdd.onError(exceptions::JoynrRuntimeException(
+                    "add of participantId " + supersededAdd.entry.getParticipantId() +
+                    " superseded by remove before it was sent"));
+        }
+    }
+}
+
+void CapabilitiesClient::trackStartupRegistration(
+        std::function<void()>& onSuccess,
+        std::function<void(const exceptions::JoynrRuntimeException& error)>& onError)
+{
+    if (isStartupRegistrationFinished) {
+        return;
+    }
+    ++numberOfStartupAdds;
+    ++numberOfUnfinishedStartupAdds;
+    auto onFinished = [thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())]() {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->onStartupRegistrationFinished();
+        }
+    };
+    onSuccess = [onSuccess = std::move(onSuccess), onFinished]() {
+        if (onSuccess) {
+            onSuccess();
+        }
+        onFinished();
+    };
+    onError = [onError = std::move(onError), onFinished](
+            const exceptions::JoynrRuntimeException& error) {
+        if (onError) {
+            onError(error);
+        }
+        onFinished();
+    };
+}
+
+void CapabilitiesClient::onStartupRegistrationFinished()
+{
+    if (--numberOfUnfinishedStartupAdds != 0 || isStartupRegistrationFinished.exchange(true)) {
+        return;
+    }
+    const auto startupToReady = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime);
+    JOYNR_LOG_INFO(logger(),
+                   "{} global registrations issued since startup finished after {} ms "
+                   "(batch window {} ms)",
+                   numberOfStartupAdds.load(),
+                   startupToReady.count(),
+                   batchWindow.count());
+}
+
+void CapabilitiesClient::scheduleFlush()
+{
+    // must be called with pendingRequestsMutex held
+    if (isFlushScheduled) {
+        return;
+    }
+    isFlushScheduled = true;
+
+    boost::system::error_code timerError;
+    flushTimer.expires_from_now(batchWindow, timerError);
+    if (timerError) {
+        JOYNR_LOG_ERROR(logger(),
+                        "Error from batch flush timer: {}: {}",
+                        timerError.value(),
+                        timerError.message());
+    }
+    flushTimer.async_wait([thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this())](
+            const boost::system::error_code& timerError) {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->flush(timerError);
+        }
+    });
+}
+
+void CapabilitiesClient::flush(const boost::system::error_code& timerError)
+{
+    if (timerError == boost::asio::error::operation_aborted) {
+        // Assume Destructor has been called
+        JOYNR_LOG_DEBUG(logger(),
+                        "batch flush aborted after shutdown, error code from batch flush timer: {}",
+                        timerError.message());
+        return;
+    } else if (timerError) {
+        JOYNR_LOG_ERROR(logger(),
+                        "flush called with error code from batch flush timer: {}",
+                        timerError.message());
+    }
+
+    std::vector<PendingAdd> adds;
+    std::vector<std::string> removes;
+    {
+        std::lock_guard<std::mutex> lock(pendingRequestsMutex);
+        adds.swap(pendingAdds);
+        removes.swap(pendingRemoves);
+        isFlushScheduled = false;
+    }
+    sendPendingRequests(std::move(adds), std::move(removes));
+}
+
+void CapabilitiesClient::sendPendingRequests(std::vector<PendingAdd> adds,
+                                             std::vector<std::string> removes)
+{
+    if (!removes.empty()) {
+        sendRemoves(std::move(removes));
+    }
+    if (!adds.empty()) {
+        sendAdds(std::move(adds));
+    }
+}
+
+void CapabilitiesClient::sendRemoves(std::vector<std::string> participantIds)
+{
+    JOYNR_LOG_DEBUG(logger(), "removing {} global discovery entries", participantIds.size());
+    if (participantIds.size() == 1) {
+        capabilitiesProxy->removeAsync(participantIds.front());
+    } else {
+        capabilitiesProxy->removeAsync(participantIds);
+    }
+}
+
+void CapabilitiesClient::sendAdds(std::vector<PendingAdd> adds)
+{
+    if (adds.size() == 1) {
+        PendingAdd& add = adds.front();
+        capabilitiesProxy->addAsync(add.entry, std::move(add.onSuccess), std::move(add.onError));
+        return;
+    }
+
+    JOYNR_LOG_DEBUG(logger(), "adding {} global discovery entries in one batch", adds.size());
+    std::vector<types::GlobalDiscoveryEntry> entries;
+    entries.reserve(adds.size());
+    for (const auto& add : adds) {
+        entries.push_back(add.entry);
+    }
+
+    auto batch = std::make_shared<std::vector<PendingAdd>>(std::move(adds));
+    auto onSuccess = [batch]() {
+        for (const auto& add : *batch) {
+            if (add.onSuccess) {
+                add.onSuccess();
+            }
+        }
+    };
+    // a batch rejected by the directory is retried entry by entry so that a
+    // single invalid entry does not fail the adds of all other providers
+    auto onError = [batch, proxy = capabilitiesProxy](
+            const exceptions::JoynrRuntimeException& error) {
+        if (error.getTypeName() == exceptions::ProviderRuntimeException::TYPE_NAME()) {
+            JOYNR_LOG_WARN(logger(),
+                           "batched add of {} global discovery entries failed: {}, "
+                           "retrying entries one by one",
+                           batch->size(),
+                           error.getMessage());
+            for (auto& add : *batch) {
+                proxy->addAsync(add.entry, std::move(add.onSuccess), std::move(add.onError));
+            }
+            return;
+        }
+        for (const auto& add : *batch) {
+            if (add.onError) {
+                add.onError(error);
+            }
+        }
+    };
+    capabilitiesProxy->addAsync(entries, std::move(onSuccess), std::move(onError));
 }
 
 void CapabilitiesClient::lookup(
@@ -19,11 +19,18 @@
 #ifndef CAPABILITIESCLIENT_H
 #define CAPABILITIESCLIENT_H
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include <boost/asio/steady_timer.hpp>
+
 #include "joynr/JoynrClusterControllerExport.h"
 #include "joynr/Logger.h"
 #include "joynr/MessagingQos.h"
@@ -38,13 +45,32 @@
 *   Client for the global capabilities directory. Registration and lookup
 *   requests are sent in serialized JsonFunctionCalls. The capabilities directory
 *   executes the function call and responds with a JsonFunctionResponse.
+*
+*   Adds and removes issued within the configured batch window are coalesced
+*   into one call to the directory each; the callbacks of the single adds are
+*   resolved from the result of the batch. Requests which are still queued are
+*   sent when the client is shut down or destroyed.
+*
+*   The time from the creation of the client until the adds issued since then
+*   have all been answered for the first time is logged once, it measures how
+*   long the cluster controller takes to register its providers after startup.
 */
 
+namespace boost
+{
+namespace asio
+{
+class io_service;
+} // namespace asio
+} // namespace boost
+
 namespace joynr
 {
 class ClusterControllerSettings;
 
-class JOYNRCLUSTERCONTROLLER_EXPORT CapabilitiesClient : public ICapabilitiesClient
+class JOYNRCLUSTERCONTROLLER_EXPORT CapabilitiesClient
+        : public ICapabilitiesClient,
+          public std::enable_shared_from_this<CapabilitiesClient>
 {
 
 public:
@@ -54,9 +80,10 @@ public:
        To upgrade to a complete CapabilitiesClient the setProxy method must be called, and a
        Proxy must be provided.
     */
-    CapabilitiesClient(const ClusterControllerSettings& clusterControllerSettings);
+    CapabilitiesClient(const ClusterControllerSettings& clusterControllerSettings,
+                       boost::asio::io_service& ioService);
 
-    ~CapabilitiesClient() override = default;
+    ~CapabilitiesClient() override;
 
     /*
        Add a capabilities record to the directory
@@ -65,6 +92,10 @@ public:
              std::function<void()> onSuccess,
              std::function<void(const exceptions::JoynrRuntimeException& error)> onError) override;
 
+    /*
+       Add capabilities records to the directory; the vector is already a batch
+       and therefore sent immediately, after the queued requests
+      */
     void add(const std::vector<joynr::types::GlobalDiscoveryEntry>& globalDiscoveryEntries,
              std::function<void()> onSuccess,
              std::function<void(const joynr::exceptions::JoynrRuntimeException& error)>
@@ -102,15 +133,50 @@ public:
                std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError =
                        nullptr) override;
 
+    /*
+      Send the queued requests without waiting for the batch window to elapse;
+      requests issued afterwards are sent immediately.
+     */
+    void shutdown() override;
+
     void setProxy(
             std::shared_ptr<infrastructure::GlobalCapabilitiesDirectoryProxy> capabilitiesProxy,
             MessagingQos messagingQos);
 
 private:
     DISALLOW_COPY_AND_ASSIGN(CapabilitiesClient);
+
+    struct PendingAdd
+    {
+        types::GlobalDiscoveryEntry entry;
+        std::function<void()> onSuccess;
+        std::function<void(const exceptions::JoynrRuntimeException& error)> onError;
+    };
+
+    void scheduleFlush();
+    void flush(const boost::system::error_code& timerError);
+    void sendPendingRequests(std::vector<PendingAdd> adds, std::vector<std::string> removes);
+    void trackStartupRegistration(
+            std::function<void()>& onSuccess,
+            std::function<void(const exceptions::JoynrRuntimeException& error)>& onError);
+    void onStartupRegistrationFinished();
+    void sendAdds(std::vector<PendingAdd> adds);
+    void sendRemoves(std::vector<std::string> participantIds);
+
     std::shared_ptr<infrastructure::GlobalCapabilitiesDirectoryProxy> capabilitiesProxy;
     MessagingQos messagingQos;
     const std::uint64_t touchTtl;
+    const std::chrono::milliseconds batchWindow;
+    std::mutex pendingRequestsMutex;
+    std::vector<PendingAdd> pendingAdds;
+    std::vector<std::string> pendingRemoves;
+    bool isFlushScheduled;
+    bool isShutDown;
+    boost::asio::steady_timer flushTimer;
+    const std::chrono::steady_clock::time_point startTime;
+    std::atomic<bool> isStartupRegistrationFinished;
+    std::atomic<std::size_t> numberOfStartupAdds;
+    std::atomic<std::size_t> numberOfUnfinishedStartupAdds;
     ADD_LOGGER(CapabilitiesClient)
 };
 
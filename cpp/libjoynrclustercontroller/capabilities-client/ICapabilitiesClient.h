@@ -68,6 +68,8 @@ public:
             const std::string& clusterControllerId,
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError) = 0;
+
+    virtual void shutdown() = 0;
 };
 
 } // namespace joynr
@@ -66,6 +66,19 @@ struct DiscoveryEntryKeyEq
     }
 };
 
+namespace
+{
+// publishes a modified copy of a storage snapshot, callers have to serialize updates; readers
+// keep using the previous snapshot until they load the snapshot again
+template <typename Storage, typename Update>
+void updateSnapshot(std::shared_ptr<const Storage>& snapshot, Update update)
+{
+    auto modifiedStorage = std::make_shared<Storage>(*std::atomic_load(&snapshot));
+    update(*modifiedStorage);
+    std::atomic_store(&snapshot, std::shared_ptr<const Storage>(std::move(modifiedStorage)));
+}
+} // namespace
+
 LocalCapabilitiesDirectory::LocalCapabilitiesDirectory(
         ClusterControllerSettings& clusterControllerSettings,
         std::shared_ptr<ICapabilitiesClient> capabilitiesClientPtr,
@@ -81,6 +94,8 @@ LocalCapabilitiesDirectory::LocalCapabilitiesDirectory(
           localAddress(localAddress),
           cacheLock(),
           pendingLookupsLock(),
+          locallyRegisteredCapabilities(std::make_shared<capabilities::Storage>()),
+          globalLookupCache(std::make_shared<capabilities::CachingStorage>()),
           messageRouter(messageRouter),
           observers(),
           pendingLookups(),
@@ -103,6 +118,9 @@ void LocalCapabilitiesDirectory::shutdown()
 {
     checkExpiredDiscoveryEntriesTimer.cancel();
     freshnessUpdateTimer.cancel();
+    if (capabilitiesClient) {
+        capabilitiesClient->shutdown();
+    }
 }
 
 void LocalCapabilitiesDirectory::scheduleFreshnessUpdate()
@@ -215,14 +233,11 @@ void LocalCapabilitiesDirectory::addInternal(
         ]()
         {
             if (auto thisSharedPtr = thisWeakPtr.lock()) {
-                {
-                    std::lock_guard<std::mutex> lock(thisSharedPtr->cacheLock);
-                    JOYNR_LOG_INFO(logger(),
-                                   "Global capability '{}' added successfully, "
-                                   "#registeredGlobalCapabilities {}",
-                                   globalDiscoveryEntry.toString(),
-                                   thisSharedPtr->countGlobalCapabilities());
-                }
+                JOYNR_LOG_INFO(logger(),
+                               "Global capability '{}' added successfully, "
+                               "#registeredGlobalCapabilities {}",
+                               globalDiscoveryEntry.toString(),
+                               thisSharedPtr->countGlobalCapabilities());
                 if (awaitGlobalRegistration) {
                     thisSharedPtr->insertInLocallyRegisteredCapabilitiesCache(globalDiscoveryEntry);
                     thisSharedPtr->insertInGlobalLookupCache(globalDiscoveryEntry);
@@ -274,8 +289,8 @@ void LocalCapabilitiesDirectory::remove(const std::string& participantId,
     {
         std::lock_guard<std::mutex> lock(cacheLock);
 
-        boost::optional<types::DiscoveryEntry> optionalEntry =
-                locallyRegisteredCapabilities.lookupByParticipantId(participantId);
+        std::shared_ptr<const types::DiscoveryEntry> optionalEntry =
+                findLocallyRegisteredCapability(participantId);
         if (!optionalEntry) {
             JOYNR_LOG_INFO(
                     logger(), "participantId '{}' not found, cannot be removed", participantId);
@@ -287,7 +302,10 @@ void LocalCapabilitiesDirectory::remove(const std::string& participantId,
             JOYNR_LOG_INFO(
                     logger(), "Removing globally registered participantId: {}", participantId);
             if (removeFromGlobalLookupCache) {
-                globalLookupCache.removeByParticipantId(participantId);
+                updateSnapshot(globalLookupCache,
+                               [&participantId](capabilities::CachingStorage& storage) {
+                                   storage.removeByParticipantId(participantId);
+                               });
             }
             if (removeGlobally) {
                 capabilitiesClient->remove(participantId);
@@ -301,8 +319,11 @@ void LocalCapabilitiesDirectory::remove(const std::string& participantId,
                        "Removing locally registered participantId: {}, #localCapabilities before "
                        "removal: {}",
                        participantId,
-                       locallyRegisteredCapabilities.size());
-        locallyRegisteredCapabilities.removeByParticipantId(participantId);
+                       getLocallyRegisteredCapabilities()->size());
+        updateSnapshot(locallyRegisteredCapabilities,
+                       [&participantId](capabilities::Storage& storage) {
+                           storage.removeByParticipantId(participantId);
+                       });
         informObserversOnRemove(entry);
 
         if (auto messageRouterSharedPtr = messageRouter.lock()) {
@@ -322,12 +343,9 @@ void LocalCapabilitiesDirectory::triggerGlobalProviderReregistration(
 {
     std::ignore = onError;
 
-    {
-        std::lock_guard<std::mutex> lock(cacheLock);
-        for (const auto& capability : locallyRegisteredCapabilities) {
-            if (capability.getQos().getScope() == types::ProviderScope::GLOBAL) {
-                capabilitiesClient->add(toGlobalDiscoveryEntry(capability), nullptr, nullptr);
-            }
+    for (const auto& capability : *getLocallyRegisteredCapabilities()) {
+        if (capability.getQos().getScope() == types::ProviderScope::GLOBAL) {
+            capabilitiesClient->add(toGlobalDiscoveryEntry(capability), nullptr, nullptr);
         }
     }
 
@@ -337,15 +355,16 @@ void LocalCapabilitiesDirectory::triggerGlobalProviderReregistration(
 std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::getCachedGlobalDiscoveryEntries()
         const
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
-
-    return std::vector<types::DiscoveryEntry>(globalLookupCache.cbegin(), globalLookupCache.cend());
+    std::shared_ptr<const capabilities::CachingStorage> cachedGlobalCapabilities =
+            getGlobalLookupCache();
+    return std::vector<types::DiscoveryEntry>(
+            cachedGlobalCapabilities->cbegin(), cachedGlobalCapabilities->cend());
 }
 
 std::size_t LocalCapabilitiesDirectory::countGlobalCapabilities() const
 {
     std::size_t counter = 0;
-    for (const auto& capability : locallyRegisteredCapabilities) {
+    for (const auto& capability : *getLocallyRegisteredCapabilities()) {
         if (capability.getQos().getScope() == types::ProviderScope::GLOBAL) {
             counter++;
         }
@@ -378,12 +397,16 @@ bool LocalCapabilitiesDirectory::getLocalAndCachedCapabilities(
 {
     joynr::types::DiscoveryScope::Enum scope = discoveryQos.getDiscoveryScope();
 
-    boost::optional<types::DiscoveryEntry> globalCapability =
-            searchCache(participantId, std::chrono::milliseconds(discoveryQos.getCacheMaxAge()));
+    std::shared_ptr<const types::DiscoveryEntry> localCapability =
+            findLocallyRegisteredCapability(participantId);
+    std::shared_ptr<const types::DiscoveryEntry> globalCapability =
+            localCapability ? localCapability
+                            : searchCache(participantId,
+                                          std::chrono::milliseconds(discoveryQos.getCacheMaxAge()));
 
     return callReceiverIfPossible(scope,
-                                  getCachedLocalCapabilities(participantId),
-                                  optionalToVector(std::move(globalCapability)),
+                                  toVector(localCapability),
+                                  toVector(globalCapability),
                                   std::move(callback));
 }
 
@@ -687,8 +710,7 @@ void LocalCapabilitiesDirectory::callbackCalled(
 std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::getCachedLocalCapabilities(
         const std::string& participantId)
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
-    return optionalToVector(locallyRegisteredCapabilities.lookupByParticipantId(participantId));
+    return toVector(findLocallyRegisteredCapability(participantId));
 }
 
 std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::getCachedLocalCapabilities(
@@ -700,13 +722,17 @@ std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::getCachedLocalCap
 void LocalCapabilitiesDirectory::clear()
 {
     std::lock_guard<std::mutex> lock(cacheLock);
-    locallyRegisteredCapabilities.clear();
-    globalLookupCache.clear();
+    updateSnapshot(locallyRegisteredCapabilities,
+                   [](capabilities::Storage& storage) { storage.clear(); });
+    updateSnapshot(globalLookupCache,
+                   [](capabilities::CachingStorage& storage) { storage.clear(); });
 }
 
 void LocalCapabilitiesDirectory::registerReceivedCapabilities(
         const std::unordered_multimap<std::string, types::DiscoveryEntry>&& capabilityEntries)
 {
+    std::vector<types::DiscoveryEntry> receivedEntries;
+    receivedEntries.reserve(capabilityEntries.size());
     for (auto it = capabilityEntries.cbegin(); it != capabilityEntries.cend(); ++it) {
         const std::string& serializedAddress = it->first;
         std::shared_ptr<const system::RoutingTypes::Address> address;
@@ -736,10 +762,11 @@ void LocalCapabilitiesDirectory::registerReceivedCapabilities(
                             "could not addNextHop {} to {} because messageRouter is not available",
                             currentEntry.getParticipantId(),
                             serializedAddress);
-            return;
+            break;
         }
-        insertInGlobalLookupCache(currentEntry);
+        receivedEntries.push_back(currentEntry);
     }
+    insertInGlobalLookupCache(receivedEntries);
 }
 
 // inherited method from joynr::system::DiscoveryProvider
@@ -810,12 +837,12 @@ bool LocalCapabilitiesDirectory::hasProviderPermission(const types::DiscoveryEnt
     return false;
 }
 
-std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::optionalToVector(
-        boost::optional<types::DiscoveryEntry> optionalEntry)
+std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::toVector(
+        const std::shared_ptr<const types::DiscoveryEntry>& entry) const
 {
     std::vector<types::DiscoveryEntry> vec;
-    if (optionalEntry) {
-        vec.push_back(std::move(*optionalEntry));
+    if (entry) {
+        vec.push_back(*entry);
     }
     return vec;
 }
@@ -923,9 +950,8 @@ void LocalCapabilitiesDirectory::saveLocalCapabilitiesToFile(const std::string&
     }
 
     try {
-        std::lock_guard<std::mutex> lock(cacheLock);
         joynr::util::saveStringToFile(
-                fileName, joynr::serializer::serializeToJson(locallyRegisteredCapabilities));
+                fileName, joynr::serializer::serializeToJson(*getLocallyRegisteredCapabilities()));
     } catch (const std::runtime_error& ex) {
         JOYNR_LOG_ERROR(logger(), ex.what());
     }
@@ -957,18 +983,24 @@ void LocalCapabilitiesDirectory::loadPersistedFile()
 
     std::lock_guard<std::mutex> lock(cacheLock);
 
-    try {
-        joynr::serializer::deserializeFromJson(locallyRegisteredCapabilities, jsonString);
-    } catch (const std::invalid_argument& ex) {
-        JOYNR_LOG_ERROR(logger(), ex.what());
-    }
+    updateSnapshot(locallyRegisteredCapabilities, [&jsonString](capabilities::Storage& storage) {
+        try {
+            joynr::serializer::deserializeFromJson(storage, jsonString);
+        } catch (const std::invalid_argument& ex) {
+            JOYNR_LOG_ERROR(logger(), ex.what());
+        }
+    });
 
     // insert all global capability entries into global cache
-    for (const auto& entry : locallyRegisteredCapabilities) {
-        if (entry.getQos().getScope() == types::ProviderScope::GLOBAL) {
-            globalLookupCache.insert(entry);
+    std::shared_ptr<const capabilities::Storage> localCapabilities =
+            getLocallyRegisteredCapabilities();
+    updateSnapshot(globalLookupCache, [&localCapabilities](capabilities::CachingStorage& storage) {
+        for (const auto& entry : *localCapabilities) {
+            if (entry.getQos().getScope() == types::ProviderScope::GLOBAL) {
+                storage.insert(entry);
+            }
         }
-    }
+    });
 }
 
 void LocalCapabilitiesDirectory::injectGlobalCapabilitiesFromFile(const std::string& fileName)
@@ -1023,11 +1055,12 @@ void LocalCapabilitiesDirectory::insertInLocallyRegisteredCapabilitiesCache(
 {
     std::lock_guard<std::mutex> lock(cacheLock);
 
-    locallyRegisteredCapabilities.insert(entry);
+    updateSnapshot(locallyRegisteredCapabilities,
+                   [&entry](capabilities::Storage& storage) { storage.insert(entry); });
     JOYNR_LOG_INFO(logger(),
                    "Added local capability to cache {}, #localCapabilities: {}",
                    entry.toString(),
-                   locallyRegisteredCapabilities.size());
+                   getLocallyRegisteredCapabilities()->size());
 }
 
 /**
@@ -1035,21 +1068,53 @@ void LocalCapabilitiesDirectory::insertInLocallyRegisteredCapabilitiesCache(
  */
 void LocalCapabilitiesDirectory::insertInGlobalLookupCache(const types::DiscoveryEntry& entry)
 {
+    insertInGlobalLookupCache(std::vector<types::DiscoveryEntry>{entry});
+}
+
+void LocalCapabilitiesDirectory::insertInGlobalLookupCache(
+        const std::vector<types::DiscoveryEntry>& entries)
+{
+    if (entries.empty()) {
+        return;
+    }
+
     std::lock_guard<std::mutex> lock(cacheLock);
 
-    globalLookupCache.insert(entry);
-    JOYNR_LOG_INFO(logger(),
-                   "Added global capability to cache {}, #globalLookupCache: {}",
-                   entry.toString(),
-                   globalLookupCache.size());
+    // entries received together are published in one snapshot to copy the storage only once
+    updateSnapshot(globalLookupCache, [&entries](capabilities::CachingStorage& storage) {
+        for (const types::DiscoveryEntry& entry : entries) {
+            storage.insert(entry);
+        }
+    });
+    for (const types::DiscoveryEntry& entry : entries) {
+        JOYNR_LOG_INFO(logger(),
+                       "Added global capability to cache {}, #globalLookupCache: {}",
+                       entry.toString(),
+                       getGlobalLookupCache()->size());
+    }
+}
+
+std::shared_ptr<const capabilities::Storage> LocalCapabilitiesDirectory::
+        getLocallyRegisteredCapabilities() const
+{
+    return std::atomic_load(&locallyRegisteredCapabilities);
+}
+
+std::shared_ptr<const capabilities::CachingStorage> LocalCapabilitiesDirectory::
+        getGlobalLookupCache() const
+{
+    return std::atomic_load(&globalLookupCache);
 }
 
 std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
         const std::vector<InterfaceAddress>& interfaceAddresses,
         std::chrono::milliseconds maxCacheAge,
-        bool localEntries)
+        bool localEntries) const
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
+    std::shared_ptr<const capabilities::Storage> localCapabilities =
+            getLocallyRegisteredCapabilities();
+    std::shared_ptr<const capabilities::CachingStorage> cachedGlobalCapabilities =
+            getGlobalLookupCache();
 
     std::vector<types::DiscoveryEntry> result;
     for (std::size_t i = 0; i < interfaceAddresses.size(); i++) {
@@ -1058,11 +1123,9 @@ std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
         const std::string& interface = interfaceAddress.getInterface();
 
         std::vector<types::DiscoveryEntry> entries =
-                localEntries
-                        ? locallyRegisteredCapabilities.lookupByDomainAndInterface(
-                                  domain, interface)
-                        : globalLookupCache.lookupCacheByDomainAndInterface(
-                                  domain, interface, maxCacheAge);
+                localEntries ? localCapabilities->lookupByDomainAndInterface(domain, interface)
+                             : cachedGlobalCapabilities->lookupCacheByDomainAndInterface(
+                                       domain, interface, maxCacheAge);
         result.insert(result.end(),
                       std::make_move_iterator(entries.begin()),
                       std::make_move_iterator(entries.end()));
@@ -1070,22 +1133,39 @@ std::vector<types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
     return result;
 }
 
-boost::optional<types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
-        const std::string& participantId,
-        std::chrono::milliseconds maxCacheAge)
+std::shared_ptr<const types::DiscoveryEntry> LocalCapabilitiesDirectory::
+        findLocallyRegisteredCapability(const std::string& participantId) const
 {
-    std::lock_guard<std::mutex> lock(cacheLock);
+    std::shared_ptr<const capabilities::Storage> localCapabilities =
+            getLocallyRegisteredCapabilities();
+    const types::DiscoveryEntry* entry = localCapabilities->findByParticipantId(participantId);
+    if (!entry) {
+        return nullptr;
+    }
+    // the entry keeps the snapshot it belongs to alive
+    return std::shared_ptr<const types::DiscoveryEntry>(localCapabilities, entry);
+}
 
+std::shared_ptr<const types::DiscoveryEntry> LocalCapabilitiesDirectory::searchCache(
+        const std::string& participantId,
+        std::chrono::milliseconds maxCacheAge) const
+{
     // first search locally
-    auto entry = locallyRegisteredCapabilities.lookupByParticipantId(participantId);
+    if (auto entry = findLocallyRegisteredCapability(participantId)) {
+        return entry;
+    }
+
+    std::shared_ptr<const capabilities::CachingStorage> cachedGlobalCapabilities =
+            getGlobalLookupCache();
+    const types::DiscoveryEntry* entry =
+            (maxCacheAge == std::chrono::milliseconds(-1))
+                    ? cachedGlobalCapabilities->findByParticipantId(participantId)
+                    : cachedGlobalCapabilities->findCacheByParticipantId(participantId,
+                                                                         maxCacheAge);
     if (!entry) {
-        if (maxCacheAge == std::chrono::milliseconds(-1)) {
-            entry = globalLookupCache.lookupByParticipantId(participantId);
-        } else {
-            entry = globalLookupCache.lookupCacheByParticipantId(participantId, maxCacheAge);
-        }
+        return nullptr;
     }
-    return entry;
+    return std::shared_ptr<const types::DiscoveryEntry>(cachedGlobalCapabilities, entry);
 }
 
 void LocalCapabilitiesDirectory::informObserversOnAdd(const types::DiscoveryEntry& discoveryEntry)
@@ -1150,8 +1230,22 @@ void LocalCapabilitiesDirectory::checkExpiredDiscoveryEntries(
     {
         std::lock_guard<std::mutex> lock(cacheLock);
 
-        auto removedLocalCapabilities = locallyRegisteredCapabilities.removeExpired();
-        auto removedGlobalCapabilities = globalLookupCache.removeExpired();
+        // a new snapshot is only published if the current one contains expired entries,
+        // most ticks find nothing to remove and must not copy the storages
+        std::vector<types::DiscoveryEntry> removedLocalCapabilities;
+        std::vector<types::DiscoveryEntry> removedGlobalCapabilities;
+        if (getLocallyRegisteredCapabilities()->hasExpired()) {
+            updateSnapshot(locallyRegisteredCapabilities,
+                           [&removedLocalCapabilities](capabilities::Storage& storage) {
+                               removedLocalCapabilities = storage.removeExpired();
+                           });
+        }
+        if (getGlobalLookupCache()->hasExpired()) {
+            updateSnapshot(globalLookupCache,
+                           [&removedGlobalCapabilities](capabilities::CachingStorage& storage) {
+                               removedGlobalCapabilities = storage.removeExpired();
+                           });
+        }
 
         if (!removedLocalCapabilities.empty() || !removedGlobalCapabilities.empty()) {
             fileUpdateRequired = true;
@@ -1160,9 +1254,9 @@ void LocalCapabilitiesDirectory::checkExpiredDiscoveryEntries(
                                "Following discovery entries expired: local: {}, "
                                "#localCapabilities: {}, global: {}, #globalLookupCache: {}",
                                joinToString(removedLocalCapabilities),
-                               locallyRegisteredCapabilities.size(),
+                               getLocallyRegisteredCapabilities()->size(),
                                joinToString(removedGlobalCapabilities),
-                               globalLookupCache.size());
+                               getGlobalLookupCache()->size());
 
                 for (const auto& capability :
                      boost::join(removedLocalCapabilities, removedGlobalCapabilities)) {
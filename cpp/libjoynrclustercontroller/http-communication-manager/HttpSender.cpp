@@ -30,6 +30,7 @@
 #include "joynr/Util.h"
 #include "joynr/serializer/Serializer.h"
 #include "joynr/system/RoutingTypes/ChannelAddress.h"
+#include "libjoynrclustercontroller/httpnetworking/CurlMultiHttpClient.h"
 #include "libjoynrclustercontroller/httpnetworking/HttpNetworking.h"
 #include "libjoynrclustercontroller/httpnetworking/HttpResult.h"
 
@@ -48,10 +49,12 @@ std::int64_t HttpSender::FRACTION_OF_MESSAGE_TTL_USED_PER_CONNECTION_TRIAL()
 
 HttpSender::HttpSender(const BrokerUrl& brokerUrl,
                        std::chrono::milliseconds maxAttemptTtl,
-                       std::chrono::milliseconds messageSendRetryInterval)
+                       std::chrono::milliseconds messageSendRetryInterval,
+                       std::shared_ptr<CurlMultiHttpClient> httpClient)
         : brokerUrl(brokerUrl),
           maxAttemptTtl(maxAttemptTtl),
-          messageSendRetryInterval(messageSendRetryInterval)
+          messageSendRetryInterval(messageSendRetryInterval),
+          httpClient(std::move(httpClient))
 {
 }
 
@@ -94,9 +97,37 @@ void HttpSender::sendMessage(
 
     // TODO transmit message->getSerializedMessage() instead
     std::string serializedMessage = "FIX ME I AM EMPTY";
-    HttpResult sendMessageResult = buildRequestAndSend(
-            serializedMessage, toUrl(*channelAddress), std::chrono::milliseconds(curlTimeout));
+    const std::string url = toUrl(*channelAddress);
 
+    if (httpClient) {
+        httpClient->post(url,
+                         std::move(serializedMessage),
+                         "application/json",
+                         std::min(maxAttemptTtl, std::chrono::milliseconds(curlTimeout)),
+                         [
+                           url,
+                           startTime,
+                           messageSendRetryInterval = this->messageSendRetryInterval,
+                           onFailure
+                         ](const HttpResult& sendMessageResult) {
+            handleResult(
+                    sendMessageResult, url, startTime, messageSendRetryInterval, onFailure);
+        });
+        return;
+    }
+
+    HttpResult sendMessageResult =
+            buildRequestAndSend(serializedMessage, url, std::chrono::milliseconds(curlTimeout));
+    handleResult(sendMessageResult, url, startTime, messageSendRetryInterval, onFailure);
+}
+
+void HttpSender::handleResult(
+        const HttpResult& sendMessageResult,
+        const std::string& url,
+        std::chrono::system_clock::time_point startTime,
+        std::chrono::milliseconds messageSendRetryInterval,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
     // Delay the next request if an error occurs
     auto now = std::chrono::system_clock::now();
     auto timeDiff = std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime);
@@ -129,7 +160,7 @@ void HttpSender::sendMessage(
     } else {
         JOYNR_LOG_DEBUG(logger(),
                         "sending message - success; url: {} status code: {}",
-                        toUrl(*channelAddress),
+                        url,
                         sendMessageResult.getStatusCode());
     }
 }
@@ -173,7 +204,7 @@ std::string HttpSender::toUrl(const system::RoutingTypes::ChannelAddress& channe
 void HttpSender::handleCurlError(
         const HttpResult& sendMessageResult,
         const std::chrono::milliseconds& delay,
-        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) const
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
 {
     std::int32_t curlError = sendMessageResult.getCurlError();
     if (curlError == CURLcode::CURLE_HTTP_RETURNED_ERROR && sendMessageResult.getStatusCode()) {
@@ -296,7 +327,7 @@ void HttpSender::handleCurlError(
 void HttpSender::handleHttpError(
         const HttpResult& sendMessageResult,
         const std::chrono::milliseconds& delay,
-        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) const
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
 {
     const std::int64_t statusCode = sendMessageResult.getStatusCode();
     if (statusCode >= 400) {
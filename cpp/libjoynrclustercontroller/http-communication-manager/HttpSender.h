@@ -35,6 +35,7 @@ namespace joynr
 
 class MessagingSettings;
 class HttpResult;
+class CurlMultiHttpClient;
 
 class HttpSender : public ITransportMessageSender
 {
@@ -42,9 +43,14 @@ public:
     static std::chrono::milliseconds MIN_ATTEMPT_TTL();
     static std::int64_t FRACTION_OF_MESSAGE_TTL_USED_PER_CONNECTION_TRIAL();
 
+    /**
+    * @param httpClient if set, messages are sent asynchronously by this client instead of
+    * blocking the calling thread until the request is completed
+    */
     HttpSender(const BrokerUrl& brokerUrl,
                std::chrono::milliseconds maxAttemptTtl,
-               std::chrono::milliseconds messageSendRetryInterval);
+               std::chrono::milliseconds messageSendRetryInterval,
+               std::shared_ptr<CurlMultiHttpClient> httpClient = nullptr);
     ~HttpSender() override;
     /**
     * @brief Sends the message to the given channel.
@@ -59,20 +65,27 @@ private:
     const BrokerUrl brokerUrl;
     const std::chrono::milliseconds maxAttemptTtl;
     const std::chrono::milliseconds messageSendRetryInterval;
+    std::shared_ptr<CurlMultiHttpClient> httpClient;
     ADD_LOGGER(HttpSender)
 
     HttpResult buildRequestAndSend(const std::string& data,
                                    const std::string& url,
                                    std::chrono::milliseconds curlTimeout);
 
-    void handleCurlError(
+    static void handleResult(
+            const HttpResult& sendMessageResult,
+            const std::string& url,
+            std::chrono::system_clock::time_point startTime,
+            std::chrono::milliseconds messageSendRetryInterval,
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+    static void handleCurlError(
             const HttpResult& sendMessageResult,
             const std::chrono::milliseconds& delay,
-            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) const;
-    void handleHttpError(
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+    static void handleHttpError(
             const HttpResult& sendMessageResult,
             const std::chrono::milliseconds& delay,
-            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure) const;
+            const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
 
     std::string toUrl(const system::RoutingTypes::ChannelAddress& channelAddress) const;
 };
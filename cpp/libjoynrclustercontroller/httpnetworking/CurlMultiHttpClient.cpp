@@ -0,0 +1,399 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynrclustercontroller/httpnetworking/CurlMultiHttpClient.h"
+
+#include <cassert>
+#include <future>
+#include <tuple>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <curl/curl.h>
+
+#include "libjoynrclustercontroller/httpnetworking/HttpNetworking.h"
+#include "libjoynrclustercontroller/httpnetworking/HttpResult.h"
+
+namespace joynr
+{
+
+struct CurlMultiHttpClient::Transfer
+{
+    Transfer() : easy(nullptr), headerList(nullptr), content(), body(), headers(), callback()
+    {
+    }
+
+    ~Transfer()
+    {
+        if (headerList != nullptr) {
+            curl_slist_free_all(headerList);
+        }
+    }
+
+    void* easy;
+    curl_slist* headerList;
+    std::string content;
+    // handed over to the HttpResult when the transfer is completed
+    std::unique_ptr<std::string> body;
+    std::unique_ptr<std::unordered_multimap<std::string, std::string>> headers;
+    ResultCallback callback;
+};
+
+struct CurlMultiHttpClient::Socket
+{
+    Socket(boost::asio::io_service& ioService, int socketFd)
+            : descriptor(ioService, socketFd),
+              socketFd(socketFd),
+              what(CURL_POLL_NONE),
+              isReadPending(false),
+              isWritePending(false)
+    {
+    }
+
+    // the socket is owned by curl, hence the descriptor must be released instead of closed
+    boost::asio::posix::stream_descriptor descriptor;
+    const int socketFd;
+    int what;
+    bool isReadPending;
+    bool isWritePending;
+};
+
+CurlMultiHttpClient::CurlMultiHttpClient(boost::asio::io_service& ioService,
+                                         std::size_t maxConnectionsPerHost)
+        : ioService(ioService),
+          strand(ioService),
+          timer(ioService),
+          multi(curl_multi_init()),
+          sockets(),
+          transfers(),
+          idleEasyHandles(),
+          isShutdown(false)
+{
+    // makes sure curl_global_init has been called
+    HttpNetworking::getInstance();
+
+    curl_multi_setopt(multi, CURLMOPT_SOCKETFUNCTION, onSocketUpdate);
+    curl_multi_setopt(multi, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(multi, CURLMOPT_TIMERFUNCTION, onTimerUpdate);
+    curl_multi_setopt(multi, CURLMOPT_TIMERDATA, this);
+    curl_multi_setopt(
+            multi, CURLMOPT_MAX_HOST_CONNECTIONS, static_cast<long>(maxConnectionsPerHost));
+    if (maxConnectionsPerHost > 0) {
+        // the default cache size follows the number of running transfers, connections opened
+        // for a burst of requests would be closed when it has been sent
+        curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(maxConnectionsPerHost));
+    }
+}
+
+CurlMultiHttpClient::~CurlMultiHttpClient()
+{
+    assert(isShutdown);
+}
+
+void CurlMultiHttpClient::post(const std::string& url,
+                               std::string content,
+                               const std::string& contentType,
+                               std::chrono::milliseconds timeout,
+                               ResultCallback callback)
+{
+    // the transfer is configured on the strand since the easy handles are owned by the strand
+    auto self = shared_from_this();
+    strand.post([
+        self,
+        url,
+        content = std::move(content),
+        contentType,
+        timeout,
+        callback = std::move(callback)
+    ]() mutable {
+        if (self->isShutdown) {
+            return;
+        }
+        auto transfer = std::make_unique<Transfer>();
+        transfer->content = std::move(content);
+        transfer->body = std::make_unique<std::string>();
+        transfer->headers =
+                std::make_unique<std::unordered_multimap<std::string, std::string>>();
+        transfer->headerList =
+                curl_slist_append(nullptr, ("Content-Type: " + contentType).c_str());
+        // see HttpRequestBuilder::asPost
+        transfer->headerList = curl_slist_append(transfer->headerList, "Expect:");
+        transfer->callback = std::move(callback);
+
+        void* easy = self->takeEasyHandle();
+        transfer->easy = easy;
+        curl_easy_setopt(easy, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(easy, CURLOPT_POST, 1L);
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDS, transfer->content.data());
+        curl_easy_setopt(easy, CURLOPT_POSTFIELDSIZE, static_cast<long>(transfer->content.size()));
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->headerList);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout.count()));
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, writeBody);
+        curl_easy_setopt(easy, CURLOPT_WRITEDATA, transfer.get());
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, writeHeader);
+        curl_easy_setopt(easy, CURLOPT_HEADERDATA, transfer.get());
+        self->startTransfer(std::move(transfer));
+    });
+}
+
+void CurlMultiHttpClient::shutdown()
+{
+    if (ioService.stopped()) {
+        // no handler can run concurrently
+        cleanup();
+        return;
+    }
+    std::promise<void> cleanedUp;
+    auto self = shared_from_this();
+    strand.dispatch([self, &cleanedUp]() {
+        self->cleanup();
+        cleanedUp.set_value();
+    });
+    cleanedUp.get_future().wait();
+}
+
+void CurlMultiHttpClient::cleanup()
+{
+    if (isShutdown) {
+        return;
+    }
+    isShutdown = true;
+    if (!transfers.empty()) {
+        JOYNR_LOG_INFO(logger(), "aborting {} pending http requests", transfers.size());
+    }
+    for (auto& entry : transfers) {
+        curl_multi_remove_handle(multi, entry.first);
+        curl_easy_cleanup(entry.first);
+    }
+    transfers.clear();
+    for (void* easy : idleEasyHandles) {
+        curl_easy_cleanup(easy);
+    }
+    idleEasyHandles.clear();
+    // closes the cached connections, curl might still invoke the callbacks while doing so
+    curl_multi_cleanup(multi);
+    multi = nullptr;
+    while (!sockets.empty()) {
+        removeSocket(sockets.begin()->first);
+    }
+    boost::system::error_code ignored;
+    timer.cancel(ignored);
+}
+
+void* CurlMultiHttpClient::takeEasyHandle()
+{
+    void* easy;
+    if (idleEasyHandles.empty()) {
+        easy = curl_easy_init();
+    } else {
+        easy = idleEasyHandles.back();
+        idleEasyHandles.pop_back();
+        curl_easy_reset(easy);
+    }
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    HttpNetworking::getInstance()->applyGlobalSettings(easy);
+    return easy;
+}
+
+void CurlMultiHttpClient::returnEasyHandle(void* easy)
+{
+    idleEasyHandles.push_back(easy);
+}
+
+void CurlMultiHttpClient::startTransfer(std::unique_ptr<Transfer> transfer)
+{
+    void* easy = transfer->easy;
+    transfers.emplace(easy, std::move(transfer));
+    const CURLMcode result = curl_multi_add_handle(multi, easy);
+    if (result != CURLM_OK) {
+        JOYNR_LOG_ERROR(logger(), "unable to start http request: {}", curl_multi_strerror(result));
+        auto failedTransfer = std::move(transfers[easy]);
+        transfers.erase(easy);
+        returnEasyHandle(easy);
+        failedTransfer->callback(HttpResult(CURLE_FAILED_INIT,
+                                            0,
+                                            failedTransfer->body.release(),
+                                            failedTransfer->headers.release()));
+    }
+    // curl requests a timeout of 0 through onTimerUpdate to kick off the transfer
+}
+
+int CurlMultiHttpClient::onSocketUpdate(void* easy,
+                                        int socketFd,
+                                        int what,
+                                        void* clientPtr,
+                                        void* socketPtr)
+{
+    std::ignore = easy;
+    std::ignore = socketPtr;
+    auto* client = static_cast<CurlMultiHttpClient*>(clientPtr);
+    if (what == CURL_POLL_REMOVE) {
+        client->removeSocket(socketFd);
+        return 0;
+    }
+    std::shared_ptr<Socket>& socket = client->sockets[socketFd];
+    if (!socket) {
+        socket = std::make_shared<Socket>(client->ioService, socketFd);
+    }
+    socket->what = what;
+    client->watchSocket(socket);
+    return 0;
+}
+
+void CurlMultiHttpClient::watchSocket(const std::shared_ptr<Socket>& socket)
+{
+    auto self = shared_from_this();
+    std::weak_ptr<Socket> weakSocket(socket);
+    if ((socket->what & CURL_POLL_IN) && !socket->isReadPending) {
+        socket->isReadPending = true;
+        socket->descriptor.async_read_some(
+                boost::asio::null_buffers(),
+                strand.wrap([self, weakSocket](const boost::system::error_code& error,
+                                               std::size_t) {
+                    self->onSocketEvent(weakSocket, CURL_CSELECT_IN, error);
+                }));
+    }
+    if ((socket->what & CURL_POLL_OUT) && !socket->isWritePending) {
+        socket->isWritePending = true;
+        socket->descriptor.async_write_some(
+                boost::asio::null_buffers(),
+                strand.wrap([self, weakSocket](const boost::system::error_code& error,
+                                               std::size_t) {
+                    self->onSocketEvent(weakSocket, CURL_CSELECT_OUT, error);
+                }));
+    }
+}
+
+void CurlMultiHttpClient::onSocketEvent(const std::weak_ptr<Socket>& weakSocket,
+                                        int event,
+                                        const boost::system::error_code& error)
+{
+    std::shared_ptr<Socket> socket = weakSocket.lock();
+    if (!socket || isShutdown || error == boost::asio::error::operation_aborted) {
+        return;
+    }
+    if (event == CURL_CSELECT_IN) {
+        socket->isReadPending = false;
+    } else {
+        socket->isWritePending = false;
+    }
+
+    int runningTransfers = 0;
+    curl_multi_socket_action(
+            multi, socket->socketFd, error ? CURL_CSELECT_ERR : event, &runningTransfers);
+    processCompletedTransfers();
+
+    // curl might have removed or replaced the socket while handling the event
+    auto found = sockets.find(socket->socketFd);
+    if (found != sockets.end() && found->second == socket) {
+        watchSocket(socket);
+    }
+}
+
+void CurlMultiHttpClient::removeSocket(int socketFd)
+{
+    auto found = sockets.find(socketFd);
+    if (found == sockets.end()) {
+        return;
+    }
+    boost::system::error_code ignored;
+    found->second->descriptor.cancel(ignored);
+    found->second->descriptor.release();
+    sockets.erase(found);
+}
+
+int CurlMultiHttpClient::onTimerUpdate(void* multi, long timeoutMs, void* clientPtr)
+{
+    std::ignore = multi;
+    auto* client = static_cast<CurlMultiHttpClient*>(clientPtr);
+    boost::system::error_code ignored;
+    client->timer.cancel(ignored);
+    if (timeoutMs >= 0 && !client->isShutdown) {
+        auto self = client->shared_from_this();
+        client->timer.expires_from_now(std::chrono::milliseconds(timeoutMs));
+        client->timer.async_wait(client->strand.wrap(
+                [self](const boost::system::error_code& error) { self->onTimeout(error); }));
+    }
+    return 0;
+}
+
+void CurlMultiHttpClient::onTimeout(const boost::system::error_code& error)
+{
+    if (error == boost::asio::error::operation_aborted || isShutdown) {
+        return;
+    }
+    int runningTransfers = 0;
+    curl_multi_socket_action(multi, CURL_SOCKET_TIMEOUT, 0, &runningTransfers);
+    processCompletedTransfers();
+}
+
+void CurlMultiHttpClient::processCompletedTransfers()
+{
+    int pendingMessages = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi, &pendingMessages)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+        void* easy = message->easy_handle;
+        const CURLcode curlError = message->data.result;
+        curl_multi_remove_handle(multi, easy);
+
+        auto found = transfers.find(easy);
+        assert(found != transfers.end());
+        std::unique_ptr<Transfer> transfer = std::move(found->second);
+        transfers.erase(found);
+
+        long statusCode = 0;
+        curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &statusCode);
+        returnEasyHandle(easy);
+
+        transfer->callback(HttpResult(
+                curlError, statusCode, transfer->body.release(), transfer->headers.release()));
+    }
+}
+
+std::size_t CurlMultiHttpClient::writeBody(char* data,
+                                           std::size_t size,
+                                           std::size_t nmemb,
+                                           void* transfer)
+{
+    const std::size_t numBytes = size * nmemb;
+    static_cast<Transfer*>(transfer)->body->append(data, numBytes);
+    return numBytes;
+}
+
+std::size_t CurlMultiHttpClient::writeHeader(char* data,
+                                             std::size_t size,
+                                             std::size_t nmemb,
+                                             void* transfer)
+{
+    const std::size_t numBytes = size * nmemb;
+    std::string header(data, numBytes);
+    const std::string::size_type separatorPosition = header.find(':');
+    if (separatorPosition != std::string::npos) {
+        std::string headerName = header.substr(0, separatorPosition);
+        std::string headerValue = header.substr(separatorPosition + 1);
+        boost::algorithm::trim(headerName);
+        boost::algorithm::trim(headerValue);
+        static_cast<Transfer*>(transfer)->headers->insert(
+                {std::move(headerName), std::move(headerValue)});
+    }
+    return numBytes;
+}
+
+} // namespace joynr
@@ -0,0 +1,126 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef CURLMULTIHTTPCLIENT_H
+#define CURLMULTIHTTPCLIENT_H
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+
+#include "joynr/JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+
+namespace joynr
+{
+
+class HttpResult;
+
+/**
+  * Event driven http client based on the curl multi interface.
+  *
+  * All transfers are driven by the given io_service: curl reports the sockets it waits for and
+  * its timeouts, which are watched with asio, so any number of requests can be in flight without
+  * blocking a thread per request. Connections are kept in the connection cache of the multi
+  * handle and reused for subsequent requests to the same host.
+  *
+  * Requests can be started from any thread. All interaction with curl and all result callbacks
+  * are serialized on a strand of the io_service.
+  */
+class JOYNRCLUSTERCONTROLLER_EXPORT CurlMultiHttpClient
+        : public std::enable_shared_from_this<CurlMultiHttpClient>
+{
+public:
+    using ResultCallback = std::function<void(const HttpResult& result)>;
+
+    /**
+      * @param ioService io_service which drives the transfers
+      * @param maxConnectionsPerHost maximum number of parallel connections to a single host,
+      * further requests to the host wait for a free connection; 0 for no limit
+      */
+    CurlMultiHttpClient(boost::asio::io_service& ioService, std::size_t maxConnectionsPerHost);
+
+    /**
+      * @note shutdown must be called before the client is destroyed
+      */
+    ~CurlMultiHttpClient();
+
+    /**
+      * Starts a POST request. The callback is invoked on the io_service once the request
+      * completed or failed, it is not invoked for requests which are pending on shutdown.
+      */
+    void post(const std::string& url,
+              std::string content,
+              const std::string& contentType,
+              std::chrono::milliseconds timeout,
+              ResultCallback callback);
+
+    /**
+      * Aborts all pending requests. Must not be called from a thread of the io_service.
+      */
+    void shutdown();
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(CurlMultiHttpClient);
+
+    struct Transfer;
+    struct Socket;
+
+    static int onSocketUpdate(void* easy, int socketFd, int what, void* clientPtr, void* socketPtr);
+    static int onTimerUpdate(void* multi, long timeoutMs, void* clientPtr);
+    static std::size_t writeBody(char* data, std::size_t size, std::size_t nmemb, void* transfer);
+    static std::size_t writeHeader(char* data,
+                                   std::size_t size,
+                                   std::size_t nmemb,
+                                   void* transfer);
+
+    void startTransfer(std::unique_ptr<Transfer> transfer);
+    void watchSocket(const std::shared_ptr<Socket>& socket);
+    void onSocketEvent(const std::weak_ptr<Socket>& weakSocket,
+                       int event,
+                       const boost::system::error_code& error);
+    void onTimeout(const boost::system::error_code& error);
+    void processCompletedTransfers();
+    void removeSocket(int socketFd);
+    void* takeEasyHandle();
+    void returnEasyHandle(void* easy);
+    void cleanup();
+
+    boost::asio::io_service& ioService;
+    boost::asio::io_service::strand strand;
+    boost::asio::steady_timer timer;
+    void* multi;
+    std::unordered_map<int, std::shared_ptr<Socket>> sockets;
+    std::unordered_map<void*, std::unique_ptr<Transfer>> transfers;
+    std::vector<void*> idleEasyHandles;
+    bool isShutdown;
+
+    ADD_LOGGER(CurlMultiHttpClient)
+};
+
+} // namespace joynr
+#endif // CURLMULTIHTTPCLIENT_H
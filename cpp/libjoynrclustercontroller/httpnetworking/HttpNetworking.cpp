@@ -122,4 +122,24 @@ std::shared_ptr<ICurlHandlePool> HttpNetworking::getCurlHandlePool() const
     return curlHandlePool;
 }
 
+void HttpNetworking::applyGlobalSettings(void* handle) const
+{
+    if (!proxy.empty()) {
+        curl_easy_setopt(handle, CURLOPT_PROXY, proxy.c_str());
+    }
+    if (httpDebug) {
+        curl_easy_setopt(handle, CURLOPT_VERBOSE, 1L);
+    }
+    curl_easy_setopt(handle, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(connectTimeout.count()));
+    if (!certificateAuthority.empty()) {
+        curl_easy_setopt(handle, CURLOPT_CAINFO, certificateAuthority.c_str());
+    }
+    if (!clientCertificate.empty()) {
+        curl_easy_setopt(handle, CURLOPT_SSLCERT, clientCertificate.c_str());
+    }
+    if (!clientCertificatePassword.empty()) {
+        curl_easy_setopt(handle, CURLOPT_KEYPASSWD, clientCertificatePassword.c_str());
+    }
+}
+
 } // namespace joynr
@@ -195,6 +195,12 @@ public:
       */
     std::shared_ptr<ICurlHandlePool> getCurlHandlePool() const;
 
+    /**
+      * Used internally: applies the global settings (proxy, connect timeout, HTTPS options) to a
+      * curl handle which is not created by a builder.
+      */
+    void applyGlobalSettings(void* handle) const;
+
     /**
       * Sets the global proxy to the specified string in the format "host:port".
       * If the string is empty the proxy is unset.
@@ -19,6 +19,8 @@
 #ifndef CAPABILITIESSTORAGE_H
 #define CAPABILITIESSTORAGE_H
 
+#include <chrono>
+#include <cstdint>
 #include <string>
 
 #include <boost/multi_index_container.hpp>
@@ -108,6 +110,15 @@ public:
         return lookupByParticipantIdFiltered(participantId, NoFilter());
     }
 
+    /**
+     * @return the entry of participantId without copying it, nullptr if there is none;
+     * the entry is valid until the storage is modified or destroyed
+     */
+    const DiscoveryEntry* findByParticipantId(const std::string& participantId) const
+    {
+        return findByParticipantIdFiltered(participantId, NoFilter());
+    }
+
     void removeByParticipantId(const std::string& participantId)
     {
         auto& index = container.template get<tags::ParticipantId>();
@@ -163,6 +174,16 @@ public:
         return container.size();
     }
 
+    /**
+     * @brief checks whether any entry has expired based on expiryDate
+     * @return true if removeExpired would remove at least one entry
+     */
+    bool hasExpired() const
+    {
+        const auto& index = container.template get<tags::ExpiryDate>();
+        return !index.empty() && index.begin()->getExpiryDateMs() < nowMs();
+    }
+
     /**
      * @brief removes expired entries based on expiryDate
      * @return expired/removed entries
@@ -170,15 +191,19 @@ public:
     std::vector<DiscoveryEntry> removeExpired()
     {
         auto& index = container.template get<tags::ExpiryDate>();
-        auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
-                           std::chrono::system_clock::now().time_since_epoch()).count();
-        auto last = index.lower_bound(now);
+        auto last = index.lower_bound(nowMs());
         std::vector<DiscoveryEntry> removedEntries(index.begin(), last);
         index.erase(index.begin(), last);
         return removedEntries;
     }
 
 protected:
+    static std::int64_t nowMs()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
     template <typename FilterFun>
     std::vector<DiscoveryEntry> lookupByDomainAndInterfaceFiltered(const std::string& domain,
                                                                    const std::string& interface,
@@ -198,15 +223,22 @@ protected:
                                                                   FilterFun filterFun) const
     {
         boost::optional<DiscoveryEntry> result;
+        if (const DiscoveryEntry* entry = findByParticipantIdFiltered(participantId, filterFun)) {
+            result = *entry;
+        }
+        return result;
+    }
 
+    template <typename FilterFun>
+    const DiscoveryEntry* findByParticipantIdFiltered(const std::string& participantId,
+                                                      FilterFun filterFun) const
+    {
         auto& index = container.template get<tags::ParticipantId>();
         auto it = index.find(participantId);
-        if (it != index.end()) {
-            if (filterFun(*it)) {
-                result = *it;
-            }
+        if (it != index.end() && filterFun(*it)) {
+            return &*it;
         }
-        return result;
+        return nullptr;
     }
 
     struct NoFilter
@@ -291,6 +323,12 @@ public:
         return lookupByParticipantIdFiltered(participantId, filterByAge(maxAge));
     }
 
+    const DiscoveryEntry* findCacheByParticipantId(const std::string& participantId,
+                                                   std::chrono::milliseconds maxAge) const
+    {
+        return findByParticipantIdFiltered(participantId, filterByAge(maxAge));
+    }
+
     std::vector<DiscoveryEntry> lookupCacheByDomainAndInterface(
             const std::string& domain,
             const std::string& interface,
@@ -149,6 +149,14 @@ public:
             std::function<void()> onSuccess,
             std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
 
+    void addNextHop(
+            const std::string& participantId,
+            const joynr::system::RoutingTypes::SharedMemoryClientAddress&
+                    sharedMemoryClientAddress,
+            const bool& isGloballyVisible,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError) final;
+
     void removeNextHop(const std::string& participantId,
                        std::function<void()> onSuccess = nullptr,
                        std::function<void(const joynr::exceptions::ProviderRuntimeException&)>
@@ -188,6 +196,7 @@ public:
      * Public methods specific to CcMessageRouter
      */
     bool publishToGlobal(const ImmutableMessage& message) final;
+    bool isInProcessShortCircuitAllowed() const final;
     void setAccessController(std::weak_ptr<IAccessController> accessController);
     void saveMulticastReceiverDirectory() const;
     void loadMulticastReceiverDirectory(std::string filename);
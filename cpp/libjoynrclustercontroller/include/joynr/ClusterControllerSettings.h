@@ -20,6 +20,7 @@
 #define CLUSTERCONTROLLERSETTINGS_H
 
 #include <chrono>
+#include <cstddef>
 #include <string>
 
 #include "joynr/JoynrExport.h"
@@ -34,6 +35,7 @@ class JOYNR_EXPORT ClusterControllerSettings
 {
 public:
     static const std::string& SETTING_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS();
+    static const std::string& SETTING_CAPABILITIES_CLIENT_BATCH_WINDOW_MS();
     static const std::string& SETTING_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCE_FILENAME();
     static const std::string& SETTING_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCY_ENABLED();
     static const std::string& SETTING_LOCAL_DOMAIN_ACCESS_STORE_PERSISTENCE_FILENAME();
@@ -42,7 +44,12 @@ public:
     static const std::string& SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT();
     static const std::string& SETTING_MESSAGE_QUEUE_LIMIT_BYTES();
     static const std::string& SETTING_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES();
+    static const std::string& SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED();
+    static const std::string& SETTING_MESSAGE_QUEUE_OVERFLOW_DIRECTORY();
+    static const std::string& SETTING_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES();
+    static const std::string& SETTING_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES();
     static const std::string& SETTING_MQTT_CLIENT_ID_PREFIX();
+    static const std::string& SETTING_MQTT_NUMBER_OF_CONNECTIONS();
     static const std::string& SETTING_MQTT_TLS_ENABLED();
     static const std::string& SETTING_MQTT_TLS_VERSION();
     static const std::string& SETTING_MQTT_TLS_CIPHERS();
@@ -59,8 +66,11 @@ public:
     static const std::string& SETTING_PURGE_EXPIRED_DISCOVERY_ENTRIES_INTERVAL_MS();
     static const std::string& SETTING_WS_TLS_PORT();
     static const std::string& SETTING_WS_PORT();
+    static const std::string& SETTING_WS_IO_SERVICE_THREAD_POOL_SIZE();
+    static const std::string& SETTING_WS_SEND_QUEUE_LIMIT_BYTES();
     static const std::string& SETTING_USE_ONLY_LDAS();
     static const std::string& SETTING_ACCESS_CONTROL_AUDIT();
+    static const std::string& SETTING_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE();
 
     static const std::string& SETTING_ACCESS_CONTROL_ENABLE();
     static const std::string& SETTING_ACCESS_CONTROL_GLOBAL_DOMAIN_ACCESS_CONTROLLER_ADDRESS();
@@ -70,11 +80,15 @@ public:
     static const std::string& SETTING_GLOBAL_CAPABILITIES_DIRECTORY_COMPRESSED_MESSAGES_ENABLED();
 
     static std::chrono::milliseconds DEFAULT_CAPABILITIES_FRESHNESS_UPDATE_INTERVAL_MS();
+    static std::chrono::milliseconds DEFAULT_CAPABILITIES_CLIENT_BATCH_WINDOW_MS();
     static const std::string& DEFAULT_CLUSTERCONTROLLER_SETTINGS_FILENAME();
     static const std::string& DEFAULT_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCE_FILENAME();
     static bool DEFAULT_LOCAL_CAPABILITIES_DIRECTORY_PERSISTENCY_ENABLED();
     static const std::string& DEFAULT_LOCAL_DOMAIN_ACCESS_STORE_PERSISTENCE_FILENAME();
     static const std::string& DEFAULT_MQTT_CLIENT_ID_PREFIX();
+    static std::uint16_t DEFAULT_MQTT_NUMBER_OF_CONNECTIONS();
+    static std::uint16_t DEFAULT_WS_IO_SERVICE_THREAD_POOL_SIZE();
+    static std::uint64_t DEFAULT_WS_SEND_QUEUE_LIMIT_BYTES();
     static bool DEFAULT_MQTT_TLS_ENABLED();
     static const std::string& DEFAULT_MQTT_TLS_VERSION();
     static const std::string& DEFAULT_MQTT_TLS_CIPHERS();
@@ -86,11 +100,16 @@ public:
     static bool DEFAULT_ENABLE_ACCESS_CONTROLLER();
     static bool DEFAULT_USE_ONLY_LDAS();
     static bool DEFAULT_ACCESS_CONTROL_AUDIT();
+    static std::size_t DEFAULT_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE();
     static std::uint64_t DEFAULT_MESSAGE_QUEUE_LIMIT();
     static std::uint64_t DEFAULT_PER_PARTICIPANTID_MESSAGE_QUEUE_LIMIT();
     static std::uint64_t DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT();
     static std::uint64_t DEFAULT_MESSAGE_QUEUE_LIMIT_BYTES();
     static std::uint64_t DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES();
+    static bool DEFAULT_MESSAGE_QUEUE_OVERFLOW_ENABLED();
+    static const std::string& DEFAULT_MESSAGE_QUEUE_OVERFLOW_DIRECTORY();
+    static std::uint64_t DEFAULT_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES();
+    static std::uint64_t DEFAULT_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES();
     static bool DEFAULT_GLOBAL_CAPABILITIES_DIRECTORY_COMPRESSED_MESSAGES_ENABLED();
 
     explicit ClusterControllerSettings(Settings& settings);
@@ -112,10 +131,19 @@ public:
     std::uint16_t getWsPort() const;
     void setWsPort(std::uint16_t port);
 
+    std::uint16_t getWsIOServiceThreadPoolSize() const;
+    void setWsIOServiceThreadPoolSize(std::uint16_t threadPoolSize);
+
+    std::uint64_t getWsSendQueueLimitBytes() const;
+    void setWsSendQueueLimitBytes(std::uint64_t sendQueueLimitBytes);
+
     bool isMqttClientIdPrefixSet() const;
     std::string getMqttClientIdPrefix() const;
     void setMqttClientIdPrefix(const std::string& mqttClientId);
 
+    std::uint16_t getMqttNumberOfConnections() const;
+    void setMqttNumberOfConnections(std::uint16_t numberOfConnections);
+
     std::string getMqttMulticastTopicPrefix() const;
     void setMqttMulticastTopicPrefix(const std::string& mqttMulticastTopicPrefix);
 
@@ -167,12 +195,24 @@ public:
     std::uint64_t getTransportNotAvailableQueueLimitBytes() const;
     void setTransportNotAvailableQueueLimitBytes(std::uint64_t limitBytes);
 
+    bool isMessageQueueOverflowEnabled() const;
+    void setMessageQueueOverflowEnabled(bool enabled);
+    std::string getMessageQueueOverflowDirectory() const;
+    void setMessageQueueOverflowDirectory(const std::string& directory);
+    std::uint64_t getMessageQueueOverflowLimitBytes() const;
+    void setMessageQueueOverflowLimitBytes(std::uint64_t limitBytes);
+    std::uint64_t getMessageQueueOverflowSegmentSizeBytes() const;
+    void setMessageQueueOverflowSegmentSizeBytes(std::uint64_t segmentSizeBytes);
+
     bool enableAccessController() const;
     void setEnableAccessController(bool enable);
 
     bool aclAudit() const;
     void setAclAudit(bool enable);
 
+    std::size_t getConsumerPermissionCacheSize() const;
+    void setConsumerPermissionCacheSize(std::size_t cacheSize);
+
     std::string getGlobalDomainAccessControlAddress() const;
     std::string getGlobalDomainAccessControlParticipantId() const;
 
@@ -194,6 +234,9 @@ public:
     void setCapabilitiesFreshnessUpdateIntervalMs(
             std::chrono::milliseconds capabilitiesFreshnessUpdateIntervalMs);
 
+    std::chrono::milliseconds getCapabilitiesClientBatchWindowMs() const;
+    void setCapabilitiesClientBatchWindowMs(std::chrono::milliseconds batchWindowMs);
+
     void setAclEntriesDirectory(const std::string& directoryPath);
     std::string getAclEntriesDirectory() const;
 
@@ -248,21 +248,36 @@ private:
     void insertInLocallyRegisteredCapabilitiesCache(const types::DiscoveryEntry& entry);
     void insertInGlobalLookupCache(const types::DiscoveryEntry& entry);
 
+    void insertInGlobalLookupCache(const std::vector<types::DiscoveryEntry>& entries);
+
     std::vector<types::DiscoveryEntry> searchCache(
             const std::vector<InterfaceAddress>& interfaceAddress,
             std::chrono::milliseconds maxCacheAge,
-            bool localEntries);
-    boost::optional<types::DiscoveryEntry> searchCache(const std::string& participantId,
-                                                       std::chrono::milliseconds maxCacheAge);
+            bool localEntries) const;
+    /*
+     * The returned entries are not copied, they share ownership of the snapshot of the storage
+     * they were found in.
+     */
+    std::shared_ptr<const types::DiscoveryEntry> findLocallyRegisteredCapability(
+            const std::string& participantId) const;
+    std::shared_ptr<const types::DiscoveryEntry> searchCache(
+            const std::string& participantId,
+            std::chrono::milliseconds maxCacheAge) const;
+
+    std::shared_ptr<const capabilities::Storage> getLocallyRegisteredCapabilities() const;
+    std::shared_ptr<const capabilities::CachingStorage> getGlobalLookupCache() const;
 
     ADD_LOGGER(LocalCapabilitiesDirectory)
     std::shared_ptr<ICapabilitiesClient> capabilitiesClient;
     std::string localAddress;
+    // serializes writers of the storages below
     mutable std::mutex cacheLock;
     std::mutex pendingLookupsLock;
 
-    capabilities::Storage locallyRegisteredCapabilities;
-    capabilities::CachingStorage globalLookupCache;
+    // immutable snapshots, readers load them without locking, writers modify a copy and publish
+    // it; both are accessed with the atomic shared_ptr functions only
+    std::shared_ptr<const capabilities::Storage> locallyRegisteredCapabilities;
+    std::shared_ptr<const capabilities::CachingStorage> globalLookupCache;
 
     std::weak_ptr<IMessageRouter> messageRouter;
     std::vector<std::shared_ptr<IProviderRegistrationObserver>> observers;
@@ -302,8 +317,8 @@ private:
     bool hasProviderPermission(const types::DiscoveryEntry& discoveryEntry);
     std::size_t countGlobalCapabilities() const;
 
-    std::vector<types::DiscoveryEntry> optionalToVector(
-            boost::optional<types::DiscoveryEntry> optionalEntry);
+    std::vector<types::DiscoveryEntry> toVector(
+            const std::shared_ptr<const types::DiscoveryEntry>& entry) const;
     std::vector<types::DiscoveryEntryWithMetaInfo> filterDuplicates(
             std::vector<types::DiscoveryEntryWithMetaInfo>&& globalCapabilitiesWithMetaInfo,
             std::vector<types::DiscoveryEntryWithMetaInfo>&& localCapabilitiesWithMetaInfo);
@@ -19,7 +19,9 @@
 #ifndef MQTTRECEIVER_H
 #define MQTTRECEIVER_H
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "joynr/PrivateCopyAssign.h"
 
@@ -41,6 +43,15 @@ public:
                           const std::string& channelIdForMqttTopic,
                           const std::string& unicastTopicPrefix);
 
+    /**
+     * @brief Creates a receiver which spreads the multicast subscriptions over several
+     * connections. The channel topic is subscribed by the first connection only.
+     */
+    MqttReceiver(std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections,
+                 const MessagingSettings& settings,
+                 const std::string& channelIdForMqttTopic,
+                 const std::string& unicastTopicPrefix);
+
     ~MqttReceiver() override = default;
 
     /**
@@ -82,7 +93,9 @@ private:
     std::string channelIdForMqttTopic; // currently channelId is used to subscribe
     std::string globalClusterControllerAddress;
 
-    std::shared_ptr<MosquittoConnection> mosquittoConnection;
+    MosquittoConnection& selectConnection(const std::string& topic) const;
+
+    std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections;
 
     ADD_LOGGER(MqttReceiver)
 };
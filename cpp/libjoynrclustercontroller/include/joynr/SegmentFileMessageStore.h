@@ -0,0 +1,123 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SEGMENTFILEMESSAGESTORE_H
+#define SEGMENTFILEMESSAGESTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "joynr/IMessageQueueOverflowStore.h"
+#include "joynr/JoynrClusterControllerExport.h"
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/TimePoint.h"
+
+namespace joynr
+{
+
+/**
+ * @class SegmentFileMessageStore
+ * @brief Overflow store of the cluster controller message queue which keeps
+ * messages in segment files on disk.
+ *
+ * Serialized messages are appended to the current segment file; once it reaches
+ * the configured segment size, a new segment is started. Messages are read back
+ * through a read-only memory mapping of their segment. The index (key, position
+ * and expiry date of each message) is kept in memory only, hence segment files
+ * found in the directory at startup are removed.
+ *
+ * A segment file is deleted as soon as none of its messages is left, which for
+ * expired messages requires no more than dropping their index entries.
+ */
+class JOYNRCLUSTERCONTROLLER_EXPORT SegmentFileMessageStore
+        : public IMessageQueueOverflowStore<std::string>
+{
+public:
+    /**
+     * @param directory Directory holding the segment files, created if necessary
+     * @param limitBytes Maximum size of all segment files together
+     * @param segmentSizeBytes Size after which a new segment file is started
+     * @throws JoynrRuntimeException if the directory cannot be created
+     */
+    SegmentFileMessageStore(const std::string& directory,
+                            std::uint64_t limitBytes,
+                            std::uint64_t segmentSizeBytes);
+    ~SegmentFileMessageStore() override;
+
+    bool store(const std::string& key, const std::shared_ptr<ImmutableMessage>& message) override;
+    std::vector<std::shared_ptr<ImmutableMessage>> takeAllFor(const std::string& key) override;
+    void removeOutdatedMessages() override;
+    std::size_t getNumberOfMessages() const override;
+
+    /**
+     * @return the size of all segment files together
+     */
+    std::uint64_t getSizeBytes() const;
+
+    /**
+     * @return the number of segment files
+     */
+    std::size_t getNumberOfSegments() const;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SegmentFileMessageStore);
+    ADD_LOGGER(SegmentFileMessageStore);
+
+    struct Segment
+    {
+        std::string fileName;
+        int fileDescriptor;
+        std::uint64_t sizeBytes;
+        std::size_t numberOfMessages;
+    };
+
+    struct Record
+    {
+        std::uint64_t segmentId;
+        std::uint64_t offset;
+        std::uint64_t length;
+    };
+
+    // records of a key ordered by the expiry date of their message
+    using Records = std::multimap<TimePoint, Record>;
+
+    bool openNewSegment();
+    void releaseRecord(const Record& record);
+    void deleteSegment(std::map<std::uint64_t, Segment>::iterator segment);
+
+    const std::string directory;
+    const std::uint64_t limitBytes;
+    const std::uint64_t segmentSizeBytes;
+    std::map<std::uint64_t, Segment> segments;
+    std::unordered_map<std::string, Records> recordsByKey;
+    std::uint64_t currentSegmentId;
+    std::uint64_t sizeBytes;
+    std::size_t numberOfMessages;
+    mutable std::mutex mutex;
+};
+
+} // namespace joynr
+
+#endif // SEGMENTFILEMESSAGESTORE_H
@@ -46,6 +46,7 @@
 #include "joynr/system/RoutingTypes/BrowserAddress.h"
 #include "joynr/system/RoutingTypes/ChannelAddress.h"
 #include "joynr/system/RoutingTypes/MqttAddress.h"
+#include "joynr/system/RoutingTypes/SharedMemoryClientAddress.h"
 #include "joynr/system/RoutingTypes/WebSocketAddress.h"
 #include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
 
@@ -161,6 +162,12 @@ void CcMessageRouter::setAccessController(std::weak_ptr<IAccessController> acces
     this->accessController = std::move(accessController);
 }
 
+bool CcMessageRouter::isInProcessShortCircuitAllowed() const
+{
+    // requests have to pass the access controller if it is enabled
+    return accessController.expired();
+}
+
 void CcMessageRouter::saveMulticastReceiverDirectory() const
 {
     if (!multicastReceiverDirectoryPersistencyEnabled) {
@@ -307,15 +314,16 @@ void CcMessageRouter::routeInternal(std::shared_ptr<ImmutableMessage> message,
         destAddresses = getDestinationAddresses(*message, lock);
         // if destination address is not known
         if (destAddresses.empty()) {
-            if (message->getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+            const MessageType messageType = message->getMessageType();
+            if (messageType == MessageType::MULTICAST) {
                 // Do not queue multicast messages for future multicast receivers.
                 return;
             }
 
             if (messagingSettings.getDiscardUnroutableRepliesAndPublications() &&
-                ((message->getType() == Message::VALUE_MESSAGE_TYPE_REPLY()) ||
-                 (message->getType() == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()) ||
-                 (message->getType() == Message::VALUE_MESSAGE_TYPE_PUBLICATION()))) {
+                (messageType == MessageType::REPLY ||
+                 messageType == MessageType::SUBSCRIPTION_REPLY ||
+                 messageType == MessageType::PUBLICATION)) {
                 // Do not queue reply & publication messages if the proxy is not known.
                 // Prequisite is that for every proxy the associated routing entry has
                 // been added before any request is made.
@@ -379,12 +387,7 @@ void CcMessageRouter::removeNextHop(
 {
     std::ignore = onError;
 
-    {
-        WriteLocker lock(routingTableLock);
-        routingTable.remove(participantId);
-    }
-
-    saveRoutingTable();
+    removeFromRoutingTable(participantId);
 
     if (onSuccess) {
         onSuccess();
@@ -522,6 +525,28 @@ void CcMessageRouter::addNextHop(
                std::move(onSuccess));
 }
 
+// inherited from joynr::system::RoutingProvider
+void CcMessageRouter::addNextHop(
+        const std::string& participantId,
+        const system::RoutingTypes::SharedMemoryClientAddress& sharedMemoryClientAddress,
+        const bool& isGloballyVisible,
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::ProviderRuntimeException&)> onError)
+{
+    std::ignore = onError;
+    constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    const bool isSticky = false;
+    auto address = std::make_shared<const joynr::system::RoutingTypes::SharedMemoryClientAddress>(
+            sharedMemoryClientAddress);
+    addNextHop(participantId,
+               std::move(address),
+               isGloballyVisible,
+               expiryDateMs,
+               isSticky,
+               false,
+               std::move(onSuccess));
+}
+
 void CcMessageRouter::resolveNextHop(
         const std::string& participantId,
         std::function<void(const bool& resolved)> onSuccess,
@@ -0,0 +1,358 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "joynr/SegmentFileMessageStore.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem.hpp>
+#include <smrf/ByteVector.h>
+#include <smrf/exceptions.h>
+
+#include "joynr/ImmutableMessage.h"
+#include "joynr/exceptions/JoynrException.h"
+
+namespace joynr
+{
+
+namespace
+{
+const std::string SEGMENT_FILE_PREFIX("segment-");
+const std::string SEGMENT_FILE_EXTENSION(".bin");
+
+bool writeFully(int fileDescriptor,
+                const std::uint8_t* data,
+                std::size_t length,
+                std::uint64_t offset)
+{
+    while (length > 0) {
+        const ssize_t written = ::pwrite(fileDescriptor, data, length, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        length -= static_cast<std::size_t>(written);
+        offset += static_cast<std::uint64_t>(written);
+    }
+    return true;
+}
+
+/**
+ * Read-only mapping of a segment file which is unmapped on destruction
+ */
+class MappedSegment
+{
+public:
+    MappedSegment(int fileDescriptor, std::uint64_t length)
+            : address(::mmap(nullptr, length, PROT_READ, MAP_SHARED, fileDescriptor, 0)),
+              length(length)
+    {
+    }
+
+    ~MappedSegment()
+    {
+        if (isValid()) {
+            ::munmap(address, length);
+        }
+    }
+
+    bool isValid() const
+    {
+        return address != MAP_FAILED;
+    }
+
+    const std::uint8_t* data() const
+    {
+        return static_cast<const std::uint8_t*>(address);
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(MappedSegment);
+
+    void* address;
+    const std::uint64_t length;
+};
+
+} // namespace
+
+SegmentFileMessageStore::SegmentFileMessageStore(const std::string& directory,
+                                                 std::uint64_t limitBytes,
+                                                 std::uint64_t segmentSizeBytes)
+        : directory(directory),
+          limitBytes(limitBytes),
+          segmentSizeBytes(segmentSizeBytes),
+          segments(),
+          recordsByKey(),
+          currentSegmentId(0),
+          sizeBytes(0),
+          numberOfMessages(0),
+          mutex()
+{
+    boost::system::error_code error;
+    boost::filesystem::create_directories(directory, error);
+    if (error) {
+        throw exceptions::JoynrRuntimeException("could not create message store directory " +
+                                                directory + ": " + error.message());
+    }
+
+    for (const auto& entry : boost::filesystem::directory_iterator(directory)) {
+        const std::string fileName = entry.path().filename().string();
+        if (boost::starts_with(fileName, SEGMENT_FILE_PREFIX) &&
+            boost::ends_with(fileName, SEGMENT_FILE_EXTENSION)) {
+            JOYNR_LOG_INFO(logger(), "removing stale segment file {}", entry.path().string());
+            boost::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+SegmentFileMessageStore::~SegmentFileMessageStore()
+{
+    while (!segments.empty()) {
+        deleteSegment(segments.begin());
+    }
+}
+
+bool SegmentFileMessageStore::store(const std::string& key,
+                                    const std::shared_ptr<ImmutableMessage>& message)
+{
+    const smrf::ByteVector& serializedMessage = message->getSerializedMessage();
+    const std::uint64_t length = serializedMessage.size();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (sizeBytes + length > limitBytes) {
+        JOYNR_LOG_WARN(logger(),
+                       "message store limit of {} bytes reached, cannot store message {}; "
+                       "size(bytes) = {}, #msgs = {}",
+                       limitBytes,
+                       message->getTrackingInfo(),
+                       sizeBytes,
+                       numberOfMessages);
+        return false;
+    }
+
+    auto segment = segments.find(currentSegmentId);
+    if (segment == segments.end() ||
+        (segment->second.sizeBytes > 0 &&
+         segment->second.sizeBytes + length > segmentSizeBytes)) {
+        if (!openNewSegment()) {
+            return false;
+        }
+        segment = segments.find(currentSegmentId);
+    }
+
+    Segment& currentSegment = segment->second;
+    if (!writeFully(currentSegment.fileDescriptor,
+                    serializedMessage.data(),
+                    length,
+                    currentSegment.sizeBytes)) {
+        JOYNR_LOG_ERROR(logger(),
+                        "could not write message {} to segment file {}: {}",
+                        message->getTrackingInfo(),
+                        currentSegment.fileName,
+                        std::strerror(errno));
+        if (::ftruncate(currentSegment.fileDescriptor,
+                        static_cast<off_t>(currentSegment.sizeBytes)) != 0) {
+            JOYNR_LOG_ERROR(logger(),
+                            "could not truncate segment file {}: {}",
+                            currentSegment.fileName,
+                            std::strerror(errno));
+        }
+        return false;
+    }
+
+    recordsByKey[key].emplace(message->getExpiryDate(),
+                              Record{currentSegmentId, currentSegment.sizeBytes, length});
+    currentSegment.sizeBytes += length;
+    currentSegment.numberOfMessages++;
+    sizeBytes += length;
+    numberOfMessages++;
+    return true;
+}
+
+std::vector<std::shared_ptr<ImmutableMessage>> SegmentFileMessageStore::takeAllFor(
+        const std::string& key)
+{
+    std::vector<std::shared_ptr<ImmutableMessage>> messages;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto records = recordsByKey.find(key);
+    if (records == recordsByKey.end()) {
+        return messages;
+    }
+
+    messages.reserve(records->second.size());
+    {
+        std::unordered_map<std::uint64_t, std::unique_ptr<MappedSegment>> mappedSegments;
+        for (const auto& entry : records->second) {
+            const Record& record = entry.second;
+            const Segment& segment = segments.at(record.segmentId);
+            std::unique_ptr<MappedSegment>& mappedSegment = mappedSegments[record.segmentId];
+            if (!mappedSegment) {
+                mappedSegment =
+                        std::make_unique<MappedSegment>(segment.fileDescriptor, segment.sizeBytes);
+            }
+            if (!mappedSegment->isValid()) {
+                JOYNR_LOG_ERROR(logger(),
+                                "could not map segment file {}: {}",
+                                segment.fileName,
+                                std::strerror(errno));
+                continue;
+            }
+
+            const std::uint8_t* begin = mappedSegment->data() + record.offset;
+            smrf::ByteVector serializedMessage(begin, begin + record.length);
+            try {
+                messages.push_back(
+                        std::make_shared<ImmutableMessage>(std::move(serializedMessage), false));
+            } catch (const smrf::EncodingException& e) {
+                JOYNR_LOG_ERROR(logger(), "Unable to deserialize message - error: {}", e.what());
+            } catch (const std::invalid_argument& e) {
+                JOYNR_LOG_ERROR(
+                        logger(), "deserialized message is not valid - error: {}", e.what());
+            }
+        }
+    }
+
+    for (const auto& entry : records->second) {
+        releaseRecord(entry.second);
+    }
+    recordsByKey.erase(records);
+    return messages;
+}
+
+void SegmentFileMessageStore::removeOutdatedMessages()
+{
+    const TimePoint now = TimePoint::now();
+    std::size_t numberOfErasedMessages = 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto records = recordsByKey.begin(); records != recordsByKey.end();) {
+        Records& recordsOfKey = records->second;
+        const auto onePastOutdatedRecord = recordsOfKey.lower_bound(now);
+        for (auto it = recordsOfKey.begin(); it != onePastOutdatedRecord; ++it) {
+            releaseRecord(it->second);
+            numberOfErasedMessages++;
+        }
+        recordsOfKey.erase(recordsOfKey.begin(), onePastOutdatedRecord);
+        records = recordsOfKey.empty() ? recordsByKey.erase(records) : std::next(records);
+    }
+
+    if (numberOfErasedMessages > 0) {
+        JOYNR_LOG_INFO(logger(),
+                       "removeOutdatedMessages: Erased {} messages, new size(bytes) = {}, "
+                       "#msgs = {}, #segments = {}",
+                       numberOfErasedMessages,
+                       sizeBytes,
+                       numberOfMessages,
+                       segments.size());
+    }
+}
+
+std::size_t SegmentFileMessageStore::getNumberOfMessages() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return numberOfMessages;
+}
+
+std::uint64_t SegmentFileMessageStore::getSizeBytes() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return sizeBytes;
+}
+
+std::size_t SegmentFileMessageStore::getNumberOfSegments() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return segments.size();
+}
+
+bool SegmentFileMessageStore::openNewSegment()
+{
+    // mutex must have been locked already
+    const std::uint64_t segmentId = currentSegmentId + 1;
+    const std::string fileName = directory + "/" + SEGMENT_FILE_PREFIX +
+                                 std::to_string(segmentId) + SEGMENT_FILE_EXTENSION;
+    const int fileDescriptor =
+            ::open(fileName.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fileDescriptor < 0) {
+        JOYNR_LOG_ERROR(
+                logger(), "could not open segment file {}: {}", fileName, std::strerror(errno));
+        return false;
+    }
+    currentSegmentId = segmentId;
+    segments.emplace(segmentId, Segment{fileName, fileDescriptor, 0, 0});
+    JOYNR_LOG_DEBUG(logger(), "opened segment file {}", fileName);
+    return true;
+}
+
+void SegmentFileMessageStore::releaseRecord(const Record& record)
+{
+    // mutex must have been locked already
+    auto segment = segments.find(record.segmentId);
+    assert(segment != segments.end());
+    numberOfMessages--;
+    if (--segment->second.numberOfMessages > 0) {
+        return;
+    }
+
+    if (record.segmentId != currentSegmentId) {
+        deleteSegment(segment);
+        return;
+    }
+
+    // the current segment is reused from its start instead of creating a new file
+    Segment& currentSegment = segment->second;
+    if (::ftruncate(currentSegment.fileDescriptor, 0) != 0) {
+        JOYNR_LOG_ERROR(logger(),
+                        "could not truncate segment file {}: {}",
+                        currentSegment.fileName,
+                        std::strerror(errno));
+        deleteSegment(segment);
+        return;
+    }
+    sizeBytes -= currentSegment.sizeBytes;
+    currentSegment.sizeBytes = 0;
+}
+
+void SegmentFileMessageStore::deleteSegment(std::map<std::uint64_t, Segment>::iterator segment)
+{
+    // mutex must have been locked already
+    ::close(segment->second.fileDescriptor);
+    if (::unlink(segment->second.fileName.c_str()) != 0) {
+        JOYNR_LOG_ERROR(logger(),
+                        "could not remove segment file {}: {}",
+                        segment->second.fileName,
+                        std::strerror(errno));
+    }
+    sizeBytes -= segment->second.sizeBytes;
+    segments.erase(segment);
+}
+
+} // namespace joynr
@@ -31,11 +31,13 @@ namespace joynr
 
 MosquittoConnection::MosquittoConnection(const MessagingSettings& messagingSettings,
                                          const ClusterControllerSettings& ccSettings,
-                                         const std::string& clientId)
+                                         const std::string& clientId,
+                                         bool channelTopicSubscriptionEnabled)
         : mosquittopp(clientId.c_str(), false),
           messagingSettings(messagingSettings),
           host(messagingSettings.getBrokerUrl().getBrokerChannelsBaseUrl().getHost()),
           port(messagingSettings.getBrokerUrl().getBrokerChannelsBaseUrl().getPort()),
+          channelTopicSubscriptionEnabled(channelTopicSubscriptionEnabled),
           channelId(),
           subscribeChannelMid(),
           topic(),
@@ -318,7 +320,9 @@ void MosquittoConnection::createSubscriptions()
         std::this_thread::sleep_for(std::chrono::milliseconds(25));
     }
     try {
-        subscribeToTopicInternal(topic, true);
+        if (channelTopicSubscriptionEnabled) {
+            subscribeToTopicInternal(topic, true);
+        }
         std::lock_guard<std::recursive_mutex> lock(additionalTopicsMutex);
         for (const std::string& additionalTopic : additionalTopics) {
             subscribeToTopicInternal(additionalTopic);
@@ -326,6 +330,10 @@ void MosquittoConnection::createSubscriptions()
     } catch (const exceptions::JoynrRuntimeException& error) {
         JOYNR_LOG_ERROR(logger(), "Error subscribing to Mqtt topic, error: ", error.getMessage());
     }
+    if (!channelTopicSubscriptionEnabled) {
+        // no reply is expected on this connection, hence it is ready once it is connected
+        setReadyToSend(isConnected);
+    }
 }
 
 void MosquittoConnection::subscribeToTopicInternal(const std::string& topic,
@@ -47,9 +47,15 @@ class MosquittoConnection : public mosqpp::mosquittopp
 {
 
 public:
+    /**
+     * @param channelTopicSubscriptionEnabled true if the connection receives the messages sent
+     * to the channel topic. Additional connections of a sharded transport only carry outgoing
+     * messages and multicast subscriptions, they are ready to send as soon as they are connected.
+     */
     explicit MosquittoConnection(const MessagingSettings& messagingSettings,
                                  const ClusterControllerSettings& ccSettings,
-                                 const std::string& clientId);
+                                 const std::string& clientId,
+                                 bool channelTopicSubscriptionEnabled = true);
 
     ~MosquittoConnection() override;
 
@@ -116,6 +122,7 @@ private:
     const std::uint16_t mqttQos = 1;
     const bool mqttRetain = false;
 
+    const bool channelTopicSubscriptionEnabled;
     std::string channelId;
     int subscribeChannelMid;
     std::string topic;
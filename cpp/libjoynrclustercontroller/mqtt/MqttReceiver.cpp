@@ -18,6 +18,9 @@
  */
 #include "joynr/MqttReceiver.h"
 
+#include <cassert>
+#include <functional>
+
 #include "joynr/MessagingSettings.h"
 #include "joynr/serializer/Serializer.h"
 #include "joynr/system/RoutingTypes/MqttAddress.h"
@@ -31,10 +34,22 @@ MqttReceiver::MqttReceiver(std::shared_ptr<MosquittoConnection> mosquittoConnect
                            const MessagingSettings& settings,
                            const std::string& channelIdForMqttTopic,
                            const std::string& unicastTopicPrefix)
+        : MqttReceiver(std::vector<std::shared_ptr<MosquittoConnection>>{mosquittoConnection},
+                       settings,
+                       channelIdForMqttTopic,
+                       unicastTopicPrefix)
+{
+}
+
+MqttReceiver::MqttReceiver(std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections,
+                           const MessagingSettings& settings,
+                           const std::string& channelIdForMqttTopic,
+                           const std::string& unicastTopicPrefix)
         : channelIdForMqttTopic(channelIdForMqttTopic),
           globalClusterControllerAddress(),
-          mosquittoConnection(std::move(mosquittoConnection))
+          mosquittoConnections(std::move(mosquittoConnections))
 {
+    assert(!this->mosquittoConnections.empty());
     std::string brokerUri =
             "tcp://" + settings.getBrokerUrl().getBrokerChannelsBaseUrl().getHost() + ":" +
             std::to_string(settings.getBrokerUrl().getBrokerChannelsBaseUrl().getPort());
@@ -42,7 +57,15 @@ MqttReceiver::MqttReceiver(std::shared_ptr<MosquittoConnection> mosquittoConnect
     std::string unicastChannelIdForMqttTopic = unicastTopicPrefix + channelIdForMqttTopic;
     system::RoutingTypes::MqttAddress receiveMqttAddress(brokerUri, unicastChannelIdForMqttTopic);
     globalClusterControllerAddress = joynr::serializer::serializeToJson(receiveMqttAddress);
-    this->mosquittoConnection->registerChannelId(unicastChannelIdForMqttTopic);
+    for (const auto& mosquittoConnection : this->mosquittoConnections) {
+        mosquittoConnection->registerChannelId(unicastChannelIdForMqttTopic);
+    }
+}
+
+MosquittoConnection& MqttReceiver::selectConnection(const std::string& topic) const
+{
+    const std::size_t index = std::hash<std::string>{}(topic) % mosquittoConnections.size();
+    return *mosquittoConnections[index];
 }
 
 void MqttReceiver::updateSettings()
@@ -71,23 +94,25 @@ bool MqttReceiver::tryToDeleteChannel()
 
 bool MqttReceiver::isConnected()
 {
-    return mosquittoConnection->isSubscribedToChannelTopic();
+    return mosquittoConnections.front()->isSubscribedToChannelTopic();
 }
 
 void MqttReceiver::registerReceiveCallback(
         std::function<void(smrf::ByteVector&&)> onMessageReceived)
 {
-    mosquittoConnection->registerReceiveCallback(std::move(onMessageReceived));
+    for (const auto& mosquittoConnection : mosquittoConnections) {
+        mosquittoConnection->registerReceiveCallback(onMessageReceived);
+    }
 }
 
 void MqttReceiver::subscribeToTopic(const std::string& topic)
 {
-    mosquittoConnection->subscribeToTopic(topic);
+    selectConnection(topic).subscribeToTopic(topic);
 }
 
 void MqttReceiver::unsubscribeFromTopic(const std::string& topic)
 {
-    mosquittoConnection->unsubscribeFromTopic(topic);
+    selectConnection(topic).unsubscribeFromTopic(topic);
 }
 
 } // namespace joynr
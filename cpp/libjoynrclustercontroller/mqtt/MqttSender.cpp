@@ -18,6 +18,9 @@
  */
 #include "libjoynrclustercontroller/mqtt/MqttSender.h"
 
+#include <cassert>
+#include <functional>
+
 #include "joynr/ITransportMessageReceiver.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Message.h"
@@ -34,10 +37,29 @@ namespace joynr
 
 MqttSender::MqttSender(std::shared_ptr<MosquittoConnection> mosquittoConnection,
                        const MessagingSettings& settings)
-        : mosquittoConnection(mosquittoConnection),
+        : MqttSender(std::vector<std::shared_ptr<MosquittoConnection>>{mosquittoConnection},
+                     settings)
+{
+}
+
+MqttSender::MqttSender(std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections,
+                       const MessagingSettings& settings)
+        : mosquittoConnections(std::move(mosquittoConnections)),
+          mosquittoConnection(),
           receiver(),
           mqttMaxMessageSizeBytes(settings.getMqttMaxMessageSizeBytes())
 {
+    assert(!this->mosquittoConnections.empty());
+    mosquittoConnection = this->mosquittoConnections.front();
+}
+
+MosquittoConnection& MqttSender::selectConnection(const std::string& shardKey) const
+{
+    if (mosquittoConnections.size() == 1) {
+        return *mosquittoConnection;
+    }
+    const std::size_t index = std::hash<std::string>{}(shardKey) % mosquittoConnections.size();
+    return *mosquittoConnections[index];
 }
 
 void MqttSender::sendMessage(
@@ -61,11 +83,14 @@ void MqttSender::sendMessage(
         return;
     }
     std::string topic;
-    if (message->getType() == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+    MosquittoConnection* shardConnection;
+    if (message->getMessageType() == MessageType::MULTICAST) {
         topic = mqttAddress->getTopic();
+        shardConnection = &selectConnection(topic);
     } else {
         topic = mqttAddress->getTopic() + "/" + mosquittoConnection->getMqttPrio() + "/" +
                 message->getRecipient();
+        shardConnection = &selectConnection(message->getRecipient());
     }
 
     int qosLevel = mosquittoConnection->getMqttQos();
@@ -90,7 +115,7 @@ void MqttSender::sendMessage(
         return;
     }
 
-    mosquittoConnection->publishMessage(
+    shardConnection->publishMessage(
             topic, qosLevel, onFailure, rawMessage.size(), rawMessage.data());
 }
 
@@ -19,6 +19,10 @@
 #ifndef MQTTSENDER_H
 #define MQTTSENDER_H
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "joynr/PrivateCopyAssign.h"
 
 #include "joynr/ITransportMessageSender.h"
@@ -37,6 +41,15 @@ public:
     explicit MqttSender(std::shared_ptr<MosquittoConnection> mosquittoConnection,
                         const MessagingSettings& settings);
 
+    /**
+     * @brief Creates a sender which distributes the outgoing messages over several connections.
+     * Messages to the same recipient (multicasts: to the same topic) are always published via the
+     * same connection, so their order is preserved. The first connection is the one subscribed to
+     * the channel topic of the cluster controller.
+     */
+    MqttSender(std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections,
+               const MessagingSettings& settings);
+
     ~MqttSender() override = default;
 
     /**
@@ -50,6 +63,9 @@ public:
 private:
     DISALLOW_COPY_AND_ASSIGN(MqttSender);
 
+    MosquittoConnection& selectConnection(const std::string& shardKey) const;
+
+    std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections;
     std::shared_ptr<MosquittoConnection> mosquittoConnection;
     std::shared_ptr<ITransportMessageReceiver> receiver;
     const std::int64_t mqttMaxMessageSizeBytes;
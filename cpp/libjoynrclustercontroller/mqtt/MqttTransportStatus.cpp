@@ -26,18 +26,41 @@ namespace joynr
 {
 
 MqttTransportStatus::MqttTransportStatus(std::shared_ptr<MosquittoConnection> mosquittoConnection)
-        : mosquittoConnection(std::move(mosquittoConnection)), availabilityChangedCallback()
+        : MqttTransportStatus(
+                  std::vector<std::shared_ptr<MosquittoConnection>>{mosquittoConnection})
 {
-    this->mosquittoConnection->registerReadyToSendChangedCallback([this](bool readyToSend) {
-        if (availabilityChangedCallback) {
-            availabilityChangedCallback(readyToSend);
-        }
-    });
+}
+
+MqttTransportStatus::MqttTransportStatus(
+        std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections)
+        : mosquittoConnections(std::move(mosquittoConnections)),
+          availabilityMutex(),
+          lastAvailability(false),
+          availabilityChangedCallback()
+{
+    for (const auto& mosquittoConnection : this->mosquittoConnections) {
+        mosquittoConnection->registerReadyToSendChangedCallback(
+                [this](bool) { onReadyToSendChanged(); });
+    }
 }
 
 MqttTransportStatus::~MqttTransportStatus()
 {
-    mosquittoConnection->registerReadyToSendChangedCallback(nullptr);
+    for (const auto& mosquittoConnection : mosquittoConnections) {
+        mosquittoConnection->registerReadyToSendChangedCallback(nullptr);
+    }
+}
+
+void MqttTransportStatus::onReadyToSendChanged()
+{
+    std::lock_guard<std::mutex> lock(availabilityMutex);
+    const bool available = isAvailable();
+    if (available != lastAvailability) {
+        lastAvailability = available;
+        if (availabilityChangedCallback) {
+            availabilityChangedCallback(available);
+        }
+    }
 }
 
 bool MqttTransportStatus::isReponsibleFor(
@@ -48,7 +71,12 @@ bool MqttTransportStatus::isReponsibleFor(
 
 bool MqttTransportStatus::isAvailable()
 {
-    return mosquittoConnection->isReadyToSend();
+    for (const auto& mosquittoConnection : mosquittoConnections) {
+        if (!mosquittoConnection->isReadyToSend()) {
+            return false;
+        }
+    }
+    return true;
 }
 
 void MqttTransportStatus::setAvailabilityChangedCallback(
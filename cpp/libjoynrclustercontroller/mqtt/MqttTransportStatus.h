@@ -19,7 +19,10 @@
 #ifndef MQTTTRANSPORTSTATUS_H
 #define MQTTTRANSPORTSTATUS_H
 
+#include <functional>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include "joynr/PrivateCopyAssign.h"
 
@@ -33,6 +36,13 @@ class MqttTransportStatus : public ITransportStatus
 {
 public:
     explicit MqttTransportStatus(std::shared_ptr<MosquittoConnection> mosquittoConnection);
+
+    /**
+     * @brief The transport is available if all connections are ready to send, since
+     * the messages are assigned to the connections by their recipient.
+     */
+    explicit MqttTransportStatus(
+            std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections);
     ~MqttTransportStatus() override;
 
     bool isReponsibleFor(std::shared_ptr<const joynr::system::RoutingTypes::Address>) override;
@@ -44,7 +54,11 @@ public:
 private:
     DISALLOW_COPY_AND_ASSIGN(MqttTransportStatus);
 
-    std::shared_ptr<MosquittoConnection> mosquittoConnection;
+    void onReadyToSendChanged();
+
+    std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections;
+    std::mutex availabilityMutex;
+    bool lastAvailability;
     std::function<void(bool)> availabilityChangedCallback;
 };
 
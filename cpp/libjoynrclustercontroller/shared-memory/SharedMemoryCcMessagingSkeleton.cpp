@@ -0,0 +1,383 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "libjoynrclustercontroller/shared-memory/SharedMemoryCcMessagingSkeleton.h"
+
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <sys/stat.h>
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <smrf/ByteVector.h>
+#include <smrf/exceptions.h>
+
+#include "joynr/IMessageRouter.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/serializer/Serializer.h"
+#include "joynr/Util.h"
+#include "libjoynr/shared-memory/SharedMemoryMessagingStubFactory.h"
+#include "libjoynr/shared-memory/SharedMemorySender.h"
+
+namespace joynr
+{
+
+struct SharedMemoryCcMessagingSkeleton::ClientState
+{
+    /*! Set once the initialization message has been received */
+    std::shared_ptr<const system::RoutingTypes::SharedMemoryClientAddress> clientAddress;
+};
+
+SharedMemoryCcMessagingSkeleton::SharedMemoryCcMessagingSkeleton(
+        boost::asio::io_service& ioService,
+        std::shared_ptr<IMessageRouter> messageRouter,
+        std::shared_ptr<SharedMemoryMessagingStubFactory> messagingStubFactory,
+        const system::RoutingTypes::SharedMemoryAddress& serverAddress)
+        : ioService(ioService),
+          acceptor(ioService),
+          path(serverAddress.getPath()),
+          clientsMutex(),
+          clients(),
+          messageRouter(std::move(messageRouter)),
+          messagingStubFactory(std::move(messagingStubFactory)),
+          listening(false),
+          shuttingDown(false)
+{
+}
+
+SharedMemoryCcMessagingSkeleton::~SharedMemoryCcMessagingSkeleton()
+{
+    // make sure shutdown() has been invoked earlier
+    assert(shuttingDown || !listening);
+}
+
+void SharedMemoryCcMessagingSkeleton::init()
+{
+    // a socket file left behind by a previous instance would make bind fail
+    removeStaleSocket();
+
+    boost::system::error_code error;
+    acceptor.open(boost::asio::local::stream_protocol(), error);
+    if (!error) {
+        acceptor.bind(boost::asio::local::stream_protocol::endpoint(path), error);
+    }
+    if (!error) {
+        listening = true;
+        acceptor.listen(boost::asio::socket_base::max_connections, error);
+    }
+    if (error) {
+        JOYNR_LOG_FATAL(logger(),
+                        "shared memory server could not be started on {}: \"{}\"",
+                        path,
+                        error.message());
+        if (listening) {
+            boost::system::error_code ignored;
+            acceptor.close(ignored);
+            std::remove(path.c_str());
+            listening = false;
+        }
+        throw exceptions::JoynrRuntimeException("shared memory server could not be started on " +
+                                                path + ": " + error.message());
+    }
+    JOYNR_LOG_INFO(logger(), "shared memory server listening on {}", path);
+    startAccept();
+}
+
+void SharedMemoryCcMessagingSkeleton::removeStaleSocket() const
+{
+    struct stat pathStat;
+    if (::lstat(path.c_str(), &pathStat) != 0) {
+        // nothing to remove; any other problem is reported by bind
+        return;
+    }
+    if (!S_ISSOCK(pathStat.st_mode)) {
+        JOYNR_LOG_FATAL(logger(), "shared memory server path {} is not a socket", path);
+        throw exceptions::JoynrRuntimeException("shared memory server path " + path +
+                                                " exists and is not a socket");
+    }
+
+    // only a socket which refuses connections has been left behind; removing the
+    // socket of a running server would silently orphan all of its clients
+    boost::asio::io_service probeIoService;
+    boost::asio::local::stream_protocol::socket probe(probeIoService);
+    boost::system::error_code error;
+    probe.connect(boost::asio::local::stream_protocol::endpoint(path), error);
+    if (error == boost::system::errc::no_such_file_or_directory) {
+        // removed in the meantime
+        return;
+    }
+    if (!error) {
+        JOYNR_LOG_FATAL(logger(), "another shared memory server is listening on {}", path);
+        throw exceptions::JoynrRuntimeException("another shared memory server is listening on " +
+                                                path);
+    }
+    if (error != boost::asio::error::connection_refused) {
+        JOYNR_LOG_FATAL(logger(),
+                        "unable to check shared memory server path {}: \"{}\"",
+                        path,
+                        error.message());
+        throw exceptions::JoynrRuntimeException("unable to check shared memory server path " +
+                                                path + ": " + error.message());
+    }
+
+    JOYNR_LOG_INFO(logger(), "removing stale shared memory server socket {}", path);
+    if (std::remove(path.c_str()) != 0 && errno != ENOENT) {
+        JOYNR_LOG_ERROR(logger(),
+                        "unable to remove stale socket {}: {}",
+                        path,
+                        std::strerror(errno));
+    }
+}
+
+void SharedMemoryCcMessagingSkeleton::shutdown()
+{
+    std::map<std::shared_ptr<SharedMemoryConnection>,
+             std::shared_ptr<const system::RoutingTypes::SharedMemoryClientAddress>>
+            closedClients;
+    {
+        // make sure shutdown() is called only once
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        assert(!shuttingDown);
+        shuttingDown = true;
+        closedClients.swap(clients);
+    }
+
+    boost::system::error_code error;
+    acceptor.close(error);
+    if (error) {
+        JOYNR_LOG_ERROR(logger(),
+                        "error during SharedMemoryCcMessagingSkeleton shutdown: {}",
+                        error.message());
+    }
+    if (listening) {
+        std::remove(path.c_str());
+    }
+
+    for (const auto& client : closedClients) {
+        client.first->close();
+    }
+}
+
+void SharedMemoryCcMessagingSkeleton::transmit(
+        std::shared_ptr<ImmutableMessage> message,
+        const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure)
+{
+    try {
+        messageRouter->route(std::move(message));
+    } catch (exceptions::JoynrRuntimeException& e) {
+        onFailure(e);
+    }
+}
+
+void SharedMemoryCcMessagingSkeleton::startAccept()
+{
+    auto socket = std::make_shared<SharedMemoryConnection::Socket>(ioService);
+    acceptor.async_accept(*socket, [
+        thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this()),
+        socket
+    ](const boost::system::error_code& error) {
+        auto thisSharedPtr = thisWeakPtr.lock();
+        if (!thisSharedPtr || error == boost::asio::error::operation_aborted ||
+            thisSharedPtr->shuttingDown) {
+            return;
+        }
+        if (error) {
+            JOYNR_LOG_ERROR(logger(), "accepting connection failed: {}", error.message());
+        } else {
+            SharedMemoryConnection::asyncAccept(
+                    thisSharedPtr->ioService,
+                    std::move(*socket),
+                    [thisWeakPtr](const boost::system::error_code& acceptError,
+                                  std::shared_ptr<SharedMemoryConnection> connection) {
+                        auto thisSharedPtr = thisWeakPtr.lock();
+                        if (!thisSharedPtr) {
+                            return;
+                        }
+                        if (acceptError) {
+                            JOYNR_LOG_ERROR(logger(),
+                                            "shared memory handshake failed: {}",
+                                            acceptError.message());
+                            return;
+                        }
+                        thisSharedPtr->onConnectionAccepted(std::move(connection));
+                    });
+        }
+        thisSharedPtr->startAccept();
+    });
+}
+
+void SharedMemoryCcMessagingSkeleton::onConnectionAccepted(
+        std::shared_ptr<SharedMemoryConnection> connection)
+{
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        if (shuttingDown) {
+            connection->close();
+            return;
+        }
+        clients[connection] = nullptr;
+    }
+
+    // frames of a single connection are delivered one after another, hence the
+    // state of the connection is not shared with other threads
+    auto clientState = std::make_shared<ClientState>();
+    auto thisWeakPtr = joynr::util::as_weak_ptr(shared_from_this());
+    std::weak_ptr<SharedMemoryConnection> connectionWeakPtr(connection);
+    connection->start(
+            [thisWeakPtr, connectionWeakPtr, clientState](const smrf::ByteArrayView& frame) {
+                auto thisSharedPtr = thisWeakPtr.lock();
+                auto connection = connectionWeakPtr.lock();
+                if (thisSharedPtr && connection) {
+                    thisSharedPtr->onFrameReceived(connection, *clientState, frame);
+                }
+            },
+            [thisWeakPtr, connectionWeakPtr]() {
+                auto thisSharedPtr = thisWeakPtr.lock();
+                auto connection = connectionWeakPtr.lock();
+                if (thisSharedPtr && connection) {
+                    thisSharedPtr->onConnectionClosed(connection);
+                }
+            });
+}
+
+void SharedMemoryCcMessagingSkeleton::onFrameReceived(
+        const std::shared_ptr<SharedMemoryConnection>& connection,
+        ClientState& clientState,
+        const smrf::ByteArrayView& frame)
+{
+    // new connections are handled in onInitMessageReceived; if initialization was successful,
+    // any further messages for this connection are handled in onMessageReceived
+    if (clientState.clientAddress) {
+        onMessageReceived(frame);
+    } else {
+        onInitMessageReceived(connection, clientState, frame);
+    }
+}
+
+void SharedMemoryCcMessagingSkeleton::onInitMessageReceived(
+        const std::shared_ptr<SharedMemoryConnection>& connection,
+        ClientState& clientState,
+        const smrf::ByteArrayView& frame)
+{
+    const std::string initMessage(reinterpret_cast<const char*>(frame.data()), frame.size());
+    if (!isInitializationMessage(initMessage)) {
+        JOYNR_LOG_ERROR(
+                logger(), "received an initial message with wrong format: \"{}\"", initMessage);
+        return;
+    }
+
+    JOYNR_LOG_DEBUG(
+            logger(), "received initialization message from shared memory client: {}", initMessage);
+    std::shared_ptr<system::RoutingTypes::SharedMemoryClientAddress> clientAddress;
+    try {
+        joynr::serializer::deserializeFromJson(clientAddress, initMessage);
+    } catch (const std::invalid_argument& e) {
+        JOYNR_LOG_FATAL(logger(),
+                        "client address must be valid, otherwise libjoynr and CC are deployed "
+                        "in different versions - raw: {} - error: {}",
+                        initMessage,
+                        e.what());
+        return;
+    }
+
+    JOYNR_LOG_INFO(
+            logger(), "Init connection for shared memory client id: {}", clientAddress->getId());
+
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        auto it = clients.find(connection);
+        if (it == clients.cend()) {
+            // connection has been closed in the meantime
+            return;
+        }
+        it->second = clientAddress;
+    }
+    clientState.clientAddress = clientAddress;
+
+    messagingStubFactory->addClient(*clientAddress,
+                                    std::make_shared<SharedMemorySender>(connection));
+    messageRouter->sendMessages(std::move(clientAddress));
+}
+
+void SharedMemoryCcMessagingSkeleton::onMessageReceived(const smrf::ByteArrayView& frame)
+{
+    // deserialize message and transmit; the frame only lives in the ring buffer
+    // until this call returns, hence the message takes a copy
+    std::shared_ptr<ImmutableMessage> immutableMessage;
+    try {
+        immutableMessage = std::make_shared<ImmutableMessage>(
+                smrf::ByteVector(frame.data(), frame.data() + frame.size()));
+    } catch (const smrf::EncodingException& e) {
+        JOYNR_LOG_ERROR(logger(), "Unable to deserialize message - error: {}", e.what());
+        return;
+    } catch (const std::invalid_argument& e) {
+        JOYNR_LOG_ERROR(logger(), "deserialized message is not valid - error: {}", e.what());
+        return;
+    }
+
+    JOYNR_LOG_DEBUG(logger(), "<<< INCOMING <<< {}", immutableMessage->toLogMessage());
+
+    auto onFailure = [trackingInfo = immutableMessage->getTrackingInfo()](
+            const exceptions::JoynrRuntimeException& e)
+    {
+        JOYNR_LOG_ERROR(logger(),
+                        "Incoming Message {} could not be sent! reason: {}",
+                        trackingInfo,
+                        e.getMessage());
+    };
+    transmit(std::move(immutableMessage), std::move(onFailure));
+}
+
+void SharedMemoryCcMessagingSkeleton::onConnectionClosed(
+        const std::shared_ptr<SharedMemoryConnection>& connection)
+{
+    std::shared_ptr<const system::RoutingTypes::SharedMemoryClientAddress> clientAddress;
+    {
+        std::lock_guard<std::mutex> lock(clientsMutex);
+        if (shuttingDown) {
+            return;
+        }
+        auto it = clients.find(connection);
+        if (it == clients.cend()) {
+            return;
+        }
+        clientAddress = std::move(it->second);
+        clients.erase(it);
+    }
+    if (clientAddress) {
+        JOYNR_LOG_INFO(logger(),
+                       "Closed connection for shared memory client id: {}",
+                       clientAddress->getId());
+        messagingStubFactory->onMessagingStubClosed(*clientAddress);
+    }
+}
+
+bool SharedMemoryCcMessagingSkeleton::isInitializationMessage(const std::string& message) const
+{
+    return boost::starts_with(
+            message, "{\"_typeName\":\"joynr.system.RoutingTypes.SharedMemoryClientAddress\"");
+}
+
+} // namespace joynr
@@ -0,0 +1,126 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef SHAREDMEMORYCCMESSAGINGSKELETON_H
+#define SHAREDMEMORYCCMESSAGINGSKELETON_H
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <smrf/ByteArrayView.h>
+
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+#include "joynr/system/RoutingTypes/SharedMemoryClientAddress.h"
+
+namespace joynr
+{
+
+class IMessageRouter;
+class ImmutableMessage;
+class SharedMemoryConnection;
+class SharedMemoryMessagingStubFactory;
+
+namespace exceptions
+{
+class JoynrRuntimeException;
+} // namespace exceptions
+
+/**
+ * @class SharedMemoryCcMessagingSkeleton
+ * @brief Messaging skeleton for the cluster controller accepting shared
+ * memory connections of libjoynr runtimes on the same host.
+ *
+ * As with websockets, the first frame of every connection has to be the
+ * serialized @ref system::RoutingTypes::SharedMemoryClientAddress of the
+ * client; all further frames are SMRF messages.
+ */
+class SharedMemoryCcMessagingSkeleton
+        : public std::enable_shared_from_this<SharedMemoryCcMessagingSkeleton>
+{
+public:
+    SharedMemoryCcMessagingSkeleton(
+            boost::asio::io_service& ioService,
+            std::shared_ptr<IMessageRouter> messageRouter,
+            std::shared_ptr<SharedMemoryMessagingStubFactory> messagingStubFactory,
+            const system::RoutingTypes::SharedMemoryAddress& serverAddress);
+
+    ~SharedMemoryCcMessagingSkeleton();
+
+    /**
+     * @brief Starts listening on the configured path
+     *
+     * A socket file left behind by a previous instance is removed. If another
+     * server is still listening on the path, it is left untouched.
+     * @throw exceptions::JoynrRuntimeException if the server could not be started
+     */
+    void init();
+    void shutdown();
+
+    void transmit(std::shared_ptr<ImmutableMessage> message,
+                  const std::function<void(const exceptions::JoynrRuntimeException&)>& onFailure);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SharedMemoryCcMessagingSkeleton);
+
+    struct ClientState;
+    using Acceptor = boost::asio::local::stream_protocol::acceptor;
+
+    void startAccept();
+    void onConnectionAccepted(std::shared_ptr<SharedMemoryConnection> connection);
+    void onFrameReceived(const std::shared_ptr<SharedMemoryConnection>& connection,
+                         ClientState& clientState,
+                         const smrf::ByteArrayView& frame);
+    void onInitMessageReceived(const std::shared_ptr<SharedMemoryConnection>& connection,
+                               ClientState& clientState,
+                               const smrf::ByteArrayView& frame);
+    void onMessageReceived(const smrf::ByteArrayView& frame);
+    void onConnectionClosed(const std::shared_ptr<SharedMemoryConnection>& connection);
+    bool isInitializationMessage(const std::string& message) const;
+    void removeStaleSocket() const;
+
+    boost::asio::io_service& ioService;
+    Acceptor acceptor;
+    const std::string path;
+
+    std::mutex clientsMutex;
+    std::map<std::shared_ptr<SharedMemoryConnection>,
+             std::shared_ptr<const system::RoutingTypes::SharedMemoryClientAddress>> clients;
+
+    /*! Router for incoming messages */
+    std::shared_ptr<IMessageRouter> messageRouter;
+    /*! Factory to build outgoing messaging stubs */
+    std::shared_ptr<SharedMemoryMessagingStubFactory> messagingStubFactory;
+    /*! Set once the socket has been bound, only then the path belongs to this instance */
+    bool listening;
+    std::atomic<bool> shuttingDown;
+
+    ADD_LOGGER(SharedMemoryCcMessagingSkeleton)
+};
+
+} // namespace joynr
+#endif // SHAREDMEMORYCCMESSAGINGSKELETON_H
@@ -23,6 +23,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/asio/io_service.hpp>
@@ -34,9 +35,8 @@
 #include "joynr/IMessageRouter.h"
 #include "joynr/ImmutableMessage.h"
 #include "joynr/Logger.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/PrivateCopyAssign.h"
-#include "joynr/Semaphore.h"
-#include "joynr/SingleThreadedIOService.h"
 #include "joynr/serializer/Serializer.h"
 #include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
 #include "joynr/Util.h"
@@ -64,6 +64,10 @@ public:
 /**
  * @class WebSocketCcMessagingSkeleton
  * @brief Messaging skeleton for the cluster controller
+ *
+ * The websocket endpoint is driven by its own pool of threads. websocketpp wraps all handlers
+ * of a connection into a strand of that connection, so frames of one client are processed in
+ * order while different clients are served concurrently.
  */
 template <typename Config>
 class WebSocketCcMessagingSkeleton
@@ -75,16 +79,24 @@ public:
      * @brief Constructor
      * @param messageRouter Router
      * @param messagingStubFactory Factory
+     * @param port Port the server listens on
+     * @param numberOfThreads Number of threads driving the websocket endpoint, 0 selects one
+     * thread per hardware thread
+     * @param sendQueueLimitBytes Maximum amount of data buffered for a client connection before
+     * further messages are delayed, 0 means unlimited
      */
     WebSocketCcMessagingSkeleton(
             boost::asio::io_service& ioService,
             std::shared_ptr<IMessageRouter> messageRouter,
             std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory,
-            std::uint16_t port)
+            std::uint16_t port,
+            std::size_t numberOfThreads,
+            std::size_t sendQueueLimitBytes)
             : IWebsocketCcMessagingSkeleton(),
               std::enable_shared_from_this<WebSocketCcMessagingSkeleton<Config>>(),
               ioService(ioService),
-              webSocketPpSingleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              webSocketPpMultiThreadedIOService(
+                      std::make_shared<MultiThreadedIOService>(numberOfThreads)),
               endpoint(),
               clientsMutex(),
               clients(),
@@ -92,15 +104,16 @@ public:
               messageRouter(std::move(messageRouter)),
               messagingStubFactory(std::move(messagingStubFactory)),
               port(port),
+              sendQueueLimitBytes(sendQueueLimitBytes),
               shuttingDown(false)
     {
     }
 
     virtual void init() override
     {
-        webSocketPpSingleThreadedIOService->start();
+        webSocketPpMultiThreadedIOService->start();
         boost::asio::io_service& endpointIoService =
-                webSocketPpSingleThreadedIOService->getIOService();
+                webSocketPpMultiThreadedIOService->getIOService();
         websocketpp::lib::error_code initializationError;
 
         endpoint.init_asio(&endpointIoService, initializationError);
@@ -151,11 +164,17 @@ public:
 
     void shutdown() override
     {
-        // make sure shutdown() is called only once
+        // make sure shutdown() is called only once; connections may still be initialized
+        // concurrently by the endpoint threads, hence close a snapshot of the clients
+        std::vector<ConnectionHandle> connections;
         {
             std::lock_guard<std::mutex> lock(clientsMutex);
             assert(!shuttingDown);
             shuttingDown = true;
+            connections.reserve(clients.size());
+            for (const auto& elem : clients) {
+                connections.push_back(elem.first);
+            }
         }
 
         websocketpp::lib::error_code shutdownError;
@@ -166,9 +185,9 @@ public:
                             shutdownError.message());
         }
 
-        for (const auto& elem : clients) {
+        for (const ConnectionHandle& hdl : connections) {
             websocketpp::lib::error_code websocketError;
-            endpoint.close(elem.first, websocketpp::close::status::normal, "", websocketError);
+            endpoint.close(hdl, websocketpp::close::status::normal, "", websocketError);
             if (websocketError) {
                 if (websocketError != websocketpp::error::bad_connection) {
                     JOYNR_LOG_ERROR(logger(),
@@ -178,14 +197,14 @@ public:
             }
         }
 
-        // prior to destruction of the endpoint, the background thread
-        // under direct control of the webSocketPpSingleThreadedIOService
-        // must have finished its work, thus wait for it here;
+        // prior to destruction of the endpoint, the background threads
+        // under direct control of the webSocketPpMultiThreadedIOService
+        // must have finished their work, thus wait for them here;
         // however do not destruct the ioService since it is still
         // referenced within the endpoint by an internally created
         // thread from tcp::resolver which is joined by the endpoint
         // destructor
-        webSocketPpSingleThreadedIOService->stop();
+        webSocketPpMultiThreadedIOService->stop();
     }
 
     void transmit(
@@ -206,7 +225,7 @@ protected:
 
     ADD_LOGGER(WebSocketCcMessagingSkeleton)
     boost::asio::io_service& ioService;
-    std::shared_ptr<SingleThreadedIOService> webSocketPpSingleThreadedIOService;
+    std::shared_ptr<MultiThreadedIOService> webSocketPpMultiThreadedIOService;
     Server endpoint;
 
     virtual bool validateIncomingMessage(const ConnectionHandle& hdl,
@@ -296,7 +315,7 @@ private:
                            "Init connection for websocket client id: {}",
                            clientAddress->getId());
 
-            auto sender = std::make_shared<WebSocketPpSender<Server>>(endpoint);
+            auto sender = std::make_shared<WebSocketPpSender<Server>>(endpoint, sendQueueLimitBytes);
             sender->setConnectionHandle(hdl);
 
             messagingStubFactory->addClient(*clientAddress, std::move(sender));
@@ -373,7 +392,6 @@ private:
                 message, "{\"_typeName\":\"joynr.system.RoutingTypes.WebSocketClientAddress\"");
     }
 
-    std::shared_ptr<Semaphore> webSocketPpSingleThreadedIOServiceDestructed;
     WebSocketPpReceiver<Server> receiver;
 
     /*! Router for incoming messages */
@@ -381,6 +399,7 @@ private:
     /*! Factory to build outgoing messaging stubs */
     std::shared_ptr<WebSocketMessagingStubFactory> messagingStubFactory;
     std::uint16_t port;
+    const std::size_t sendQueueLimitBytes;
     std::atomic<bool> shuttingDown;
 
     DISALLOW_COPY_AND_ASSIGN(WebSocketCcMessagingSkeleton);
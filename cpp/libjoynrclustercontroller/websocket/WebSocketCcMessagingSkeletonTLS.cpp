@@ -32,12 +32,16 @@ WebSocketCcMessagingSkeletonTLS::WebSocketCcMessagingSkeletonTLS(
         const std::string& caPemFile,
         const std::string& certPemFile,
         const std::string& privateKeyPemFile,
-        bool useEncryptedTls)
+        bool useEncryptedTls,
+        std::size_t numberOfThreads,
+        std::size_t sendQueueLimitBytes)
         : WebSocketCcMessagingSkeleton<websocketpp::config::asio_tls>(
                   ioService,
                   std::move(messageRouter),
                   std::move(messagingStubFactory),
-                  serverAddress.getPort()),
+                  serverAddress.getPort(),
+                  numberOfThreads,
+                  sendQueueLimitBytes),
           useEncryptedTls{useEncryptedTls},
           caPemFile(caPemFile),
           certPemFile(certPemFile),
@@ -42,7 +42,9 @@ public:
             const std::string& caPemFile,
             const std::string& certPemFile,
             const std::string& privateKeyPemFile,
-            bool useEncryptedTls);
+            bool useEncryptedTls,
+            std::size_t numberOfThreads,
+            std::size_t sendQueueLimitBytes);
 
     virtual void init() override;
 
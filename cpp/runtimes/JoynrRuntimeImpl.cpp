@@ -19,7 +19,7 @@
 #include "joynr/JoynrRuntimeImpl.h"
 
 #include "joynr/IKeychain.h"
-#include "joynr/SingleThreadedIOService.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/Util.h"
 #include "joynr/system/IRouting.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
@@ -28,7 +28,8 @@ namespace joynr
 {
 
 JoynrRuntimeImpl::JoynrRuntimeImpl(Settings& settings, std::shared_ptr<IKeychain> keyChain)
-        : singleThreadIOService(std::make_shared<SingleThreadedIOService>()),
+        : multiThreadedIOService(std::make_shared<MultiThreadedIOService>(
+                  MessagingSettings(settings).getIOServiceThreadPoolSize())),
           proxyFactory(nullptr),
           requestCallerDirectory(nullptr),
           participantIdStorage(nullptr),
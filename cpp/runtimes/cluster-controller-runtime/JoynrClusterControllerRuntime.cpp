@@ -18,6 +18,7 @@
  */
 #include "joynr/JoynrClusterControllerRuntime.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdint>
@@ -48,13 +49,14 @@
 #include "joynr/MessagingQos.h"
 #include "joynr/MessagingStubFactory.h"
 #include "joynr/MqttMulticastAddressCalculator.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/MulticastMessagingSkeletonDirectory.h"
 #include "joynr/ParticipantIdStorage.h"
 #include "joynr/ProxyBuilder.h"
 #include "joynr/ProxyFactory.h"
 #include "joynr/PublicationManager.h"
+#include "joynr/SegmentFileMessageStore.h"
 #include "joynr/Settings.h"
-#include "joynr/SingleThreadedIOService.h"
 #include "joynr/SubscriptionManager.h"
 #include "joynr/SystemServicesSettings.h"
 #include "joynr/exceptions/JoynrException.h"
@@ -76,6 +78,7 @@
 #include "libjoynr/in-process/InProcessMessagingSkeleton.h"
 #include "libjoynr/in-process/InProcessMessagingStubFactory.h"
 #include "libjoynr/joynr-messaging/DummyPlatformSecurityManager.h"
+#include "libjoynr/shared-memory/SharedMemoryMessagingStubFactory.h"
 #include "libjoynr/websocket/WebSocketMessagingStubFactory.h"
 #include "libjoynrclustercontroller/access-control/AccessController.h"
 #include "libjoynrclustercontroller/access-control/AccessControlListEditor.h"
@@ -85,6 +88,7 @@
 #include "libjoynrclustercontroller/http-communication-manager/HttpMessagingSkeleton.h"
 #include "libjoynrclustercontroller/http-communication-manager/HttpReceiver.h"
 #include "libjoynrclustercontroller/http-communication-manager/HttpSender.h"
+#include "libjoynrclustercontroller/httpnetworking/CurlMultiHttpClient.h"
 #include "libjoynrclustercontroller/messaging/MessagingPropertiesPersistence.h"
 #include "libjoynrclustercontroller/messaging/joynr-messaging/HttpMessagingStubFactory.h"
 #include "libjoynrclustercontroller/messaging/joynr-messaging/MqttMessagingStubFactory.h"
@@ -93,6 +97,7 @@
 #include "joynr/MqttReceiver.h"
 #include "libjoynrclustercontroller/mqtt/MqttSender.h"
 #include "libjoynrclustercontroller/mqtt/MqttTransportStatus.h"
+#include "libjoynrclustercontroller/shared-memory/SharedMemoryCcMessagingSkeleton.h"
 #include "libjoynrclustercontroller/websocket/WebSocketCcMessagingSkeletonNonTLS.h"
 #include "libjoynrclustercontroller/websocket/WebSocketCcMessagingSkeletonTLS.h"
 #include "libjoynrclustercontroller/ClusterControllerCallContextStorage.h"
@@ -117,8 +122,9 @@ JoynrClusterControllerRuntime::JoynrClusterControllerRuntime(
           libJoynrMessagingSkeleton(nullptr),
           httpMessageReceiver(httpMessageReceiver),
           httpMessageSender(httpMessageSender),
+          httpClient(),
           httpMessagingSkeleton(nullptr),
-          mosquittoConnection(nullptr),
+          mosquittoConnections(),
           mqttMessageReceiver(mqttMessageReceiver),
           mqttMessageSender(mqttMessageSender),
           mqttMessagingSkeletonFactory(std::move(mqttMessagingSkeletonFactory)),
@@ -136,6 +142,9 @@ JoynrClusterControllerRuntime::JoynrClusterControllerRuntime(
           doMqttMessaging(false),
           doHttpMessaging(false),
           wsMessagingStubFactory(),
+          sharedMemorySettings(*(this->settings)),
+          sharedMemoryCcMessagingSkeleton(nullptr),
+          sharedMemoryMessagingStubFactory(),
           multicastMessagingSkeletonDirectory(
                   std::make_shared<MulticastMessagingSkeletonDirectory>()),
           ccMessageRouter(nullptr),
@@ -212,6 +221,7 @@ void JoynrClusterControllerRuntime::init()
     messagingSettings.printSettings();
     libjoynrSettings.printSettings();
     wsSettings.printSettings();
+    sharedMemorySettings.printSettings();
 
     const BrokerUrl brokerUrl = messagingSettings.getBrokerUrl();
     assert(brokerUrl.getBrokerChannelsBaseUrl().isValid());
@@ -290,11 +300,23 @@ void JoynrClusterControllerRuntime::init()
                         clusterControllerSettings.getMqttClientIdPrefix();
                 const std::string mqttCliendId = ccMqttClientIdPrefix + clusterControllerId;
 
-                mosquittoConnection = std::make_shared<MosquittoConnection>(
-                        messagingSettings, clusterControllerSettings, mqttCliendId);
+                // only the first connection subscribes to the channel topic, the additional
+                // connections carry a share of the outgoing messages and multicast subscriptions
+                const std::uint16_t numberOfConnections = std::max<std::uint16_t>(
+                        clusterControllerSettings.getMqttNumberOfConnections(), 1);
+                mosquittoConnections.push_back(std::make_shared<MosquittoConnection>(
+                        messagingSettings, clusterControllerSettings, mqttCliendId));
+                for (std::uint16_t i = 1; i < numberOfConnections; ++i) {
+                    const bool channelTopicSubscriptionEnabled = false;
+                    mosquittoConnections.push_back(std::make_shared<MosquittoConnection>(
+                            messagingSettings,
+                            clusterControllerSettings,
+                            mqttCliendId + "-" + std::to_string(i),
+                            channelTopicSubscriptionEnabled));
+                }
 
                 auto mqttTransportStatus =
-                        std::make_unique<MqttTransportStatus>(mosquittoConnection);
+                        std::make_unique<MqttTransportStatus>(mosquittoConnections);
                 transportStatuses.emplace_back(std::move(mqttTransportStatus));
             }
             if (!mqttMessageReceiver) {
@@ -303,7 +325,7 @@ void JoynrClusterControllerRuntime::init()
                                 "mqtt MessageReceiver");
 
                 mqttMessageReceiver = std::make_shared<MqttReceiver>(
-                        mosquittoConnection,
+                        mosquittoConnections,
                         messagingSettings,
                         clusterControllerId,
                         clusterControllerSettings.getMqttUnicastTopicPrefix());
@@ -321,11 +343,19 @@ void JoynrClusterControllerRuntime::init()
     const std::string globalClusterControllerAddress =
             getSerializedGlobalClusterControllerAddress();
 
+    std::shared_ptr<SegmentFileMessageStore> messageQueueOverflowStore;
+    if (clusterControllerSettings.isMessageQueueOverflowEnabled()) {
+        messageQueueOverflowStore = std::make_shared<SegmentFileMessageStore>(
+                clusterControllerSettings.getMessageQueueOverflowDirectory(),
+                clusterControllerSettings.getMessageQueueOverflowLimitBytes(),
+                clusterControllerSettings.getMessageQueueOverflowSegmentSizeBytes());
+    }
     std::unique_ptr<MessageQueue<std::string>> messageQueue =
             std::make_unique<MessageQueue<std::string>>(
                     clusterControllerSettings.getMessageQueueLimit(),
                     clusterControllerSettings.getPerParticipantIdMessageQueueLimit(),
-                    clusterControllerSettings.getMessageQueueLimitBytes());
+                    clusterControllerSettings.getMessageQueueLimitBytes(),
+                    std::move(messageQueueOverflowStore));
     std::unique_ptr<MessageQueue<std::shared_ptr<ITransportStatus>>> transportStatusQueue =
             std::make_unique<MessageQueue<std::shared_ptr<ITransportStatus>>>(
                     clusterControllerSettings.getTransportNotAvailableQueueLimit(),
@@ -338,7 +368,7 @@ void JoynrClusterControllerRuntime::init()
             messagingStubFactory,
             multicastMessagingSkeletonDirectory,
             std::move(securityManager),
-            singleThreadIOService->getIOService(),
+            multiThreadedIOService->getIOService(),
             std::move(addressCalculator),
             globalClusterControllerAddress,
             systemServicesSettings.getCcMessageNotificationProviderParticipantId(),
@@ -391,12 +421,21 @@ void JoynrClusterControllerRuntime::init()
 
     messagingStubFactory->registerStubFactory(wsMessagingStubFactory);
 
+    // setup CC shared memory interface
+    sharedMemoryMessagingStubFactory = std::make_shared<SharedMemoryMessagingStubFactory>();
+    sharedMemoryMessagingStubFactory->registerOnMessagingStubClosedCallback([messagingStubFactory](
+            const std::shared_ptr<const joynr::system::RoutingTypes::Address>& destinationAddress) {
+        messagingStubFactory->remove(destinationAddress);
+    });
+
+    messagingStubFactory->registerStubFactory(sharedMemoryMessagingStubFactory);
+
     /* LibJoynr */
     assert(ccMessageRouter);
     messageSender = std::make_shared<MessageSender>(
             ccMessageRouter, keyChain, messagingSettings.getTtlUpliftMs());
     joynrDispatcher =
-            std::make_shared<Dispatcher>(messageSender, singleThreadIOService->getIOService());
+            std::make_shared<Dispatcher>(messageSender, multiThreadedIOService->getIOService());
     messageSender->registerDispatcher(joynrDispatcher);
     messageSender->setReplyToAddress(globalClusterControllerAddress);
 
@@ -424,10 +463,15 @@ void JoynrClusterControllerRuntime::init()
                             "The http message sender supplied is NULL, creating the default "
                             "http MessageSender");
 
+            // requests are driven by the io_service, connections to the same host are reused
+            constexpr std::size_t maxHttpConnectionsPerHost = 8;
+            httpClient = std::make_shared<CurlMultiHttpClient>(
+                    multiThreadedIOService->getIOService(), maxHttpConnectionsPerHost);
             httpMessageSender = std::make_shared<HttpSender>(
                     messagingSettings.getBrokerUrl(),
                     std::chrono::milliseconds(messagingSettings.getSendMsgMaxTtl()),
-                    std::chrono::milliseconds(messagingSettings.getSendMsgRetryInterval()));
+                    std::chrono::milliseconds(messagingSettings.getSendMsgRetryInterval()),
+                    httpClient);
         }
 
         messagingStubFactory->registerStubFactory(
@@ -473,7 +517,7 @@ void JoynrClusterControllerRuntime::init()
                             "mqtt MessageSender");
 
             mqttMessageSender =
-                    std::make_shared<MqttSender>(mosquittoConnection, messagingSettings);
+                    std::make_shared<MqttSender>(mosquittoConnections, messagingSettings);
         }
 
         messagingStubFactory->registerStubFactory(
@@ -485,7 +529,7 @@ void JoynrClusterControllerRuntime::init()
       *
       */
     publicationManager = std::make_shared<PublicationManager>(
-            singleThreadIOService->getIOService(),
+            multiThreadedIOService->getIOService(),
             messageSender,
             libjoynrSettings.isSubscriptionPersistencyEnabled(),
             messagingSettings.getTtlUpliftMs());
@@ -495,7 +539,7 @@ void JoynrClusterControllerRuntime::init()
             libjoynrSettings.getBroadcastSubscriptionRequestPersistenceFilename());
 
     subscriptionManager = std::make_shared<SubscriptionManager>(
-            singleThreadIOService->getIOService(), ccMessageRouter);
+            multiThreadedIOService->getIOService(), ccMessageRouter);
 
     dispatcherAddress = std::make_shared<InProcessMessagingAddress>(libJoynrMessagingSkeleton);
 
@@ -513,13 +557,14 @@ void JoynrClusterControllerRuntime::init()
     auto provisionedDiscoveryEntries = getProvisionedEntries();
     discoveryProxy = std::make_shared<LocalDiscoveryAggregator>(provisionedDiscoveryEntries);
 
-    auto capabilitiesClient = std::make_shared<CapabilitiesClient>(clusterControllerSettings);
+    auto capabilitiesClient = std::make_shared<CapabilitiesClient>(
+            clusterControllerSettings, multiThreadedIOService->getIOService());
     localCapabilitiesDirectory =
             std::make_shared<LocalCapabilitiesDirectory>(clusterControllerSettings,
                                                          capabilitiesClient,
                                                          globalClusterControllerAddress,
                                                          ccMessageRouter,
-                                                         singleThreadIOService->getIOService(),
+                                                         multiThreadedIOService->getIOService(),
                                                          clusterControllerId);
     localCapabilitiesDirectory->init();
     localCapabilitiesDirectory->loadPersistedFile();
@@ -680,7 +725,9 @@ void JoynrClusterControllerRuntime::enableAccessController(
     }
 
     accessController = std::make_shared<joynr::AccessController>(
-            localCapabilitiesDirectory, localDomainAccessController);
+            localCapabilitiesDirectory,
+            localDomainAccessController,
+            clusterControllerSettings.getConsumerPermissionCacheSize());
 
     // whitelist provisioned entries into access controller
     for (const auto& entry : provisionedEntries) {
@@ -815,14 +862,16 @@ void JoynrClusterControllerRuntime::startLocalCommunication()
             bool useEncryptedTls = wsSettings.getEncryptedTlsUsage();
 
             wsTLSCcMessagingSkeleton = std::make_shared<WebSocketCcMessagingSkeletonTLS>(
-                    singleThreadIOService->getIOService(),
+                    multiThreadedIOService->getIOService(),
                     ccMessageRouter,
                     wsMessagingStubFactory,
                     wsAddress,
                     certificateAuthorityPemFilename,
                     certificatePemFilename,
                     privateKeyPemFilename,
-                    useEncryptedTls);
+                    useEncryptedTls,
+                    clusterControllerSettings.getWsIOServiceThreadPoolSize(),
+                    clusterControllerSettings.getWsSendQueueLimitBytes());
             wsTLSCcMessagingSkeleton->init();
         }
     }
@@ -835,12 +884,23 @@ void JoynrClusterControllerRuntime::startLocalCommunication()
                 "");
 
         wsCcMessagingSkeleton = std::make_shared<WebSocketCcMessagingSkeletonNonTLS>(
-                singleThreadIOService->getIOService(),
+                multiThreadedIOService->getIOService(),
                 ccMessageRouter,
                 wsMessagingStubFactory,
-                wsAddress);
+                wsAddress,
+                clusterControllerSettings.getWsIOServiceThreadPoolSize(),
+                clusterControllerSettings.getWsSendQueueLimitBytes());
         wsCcMessagingSkeleton->init();
     }
+
+    if (sharedMemorySettings.isEnabled()) {
+        sharedMemoryCcMessagingSkeleton = std::make_shared<SharedMemoryCcMessagingSkeleton>(
+                multiThreadedIOService->getIOService(),
+                ccMessageRouter,
+                sharedMemoryMessagingStubFactory,
+                sharedMemorySettings.createClusterControllerMessagingAddress());
+        sharedMemoryCcMessagingSkeleton->init();
+    }
 }
 
 JoynrClusterControllerRuntime::~JoynrClusterControllerRuntime()
@@ -863,8 +923,10 @@ void JoynrClusterControllerRuntime::startExternalCommunication()
         }
     }
     if (doMqttMessaging) {
-        if (mosquittoConnection && !mqttMessagingIsRunning) {
-            mosquittoConnection->start();
+        if (!mosquittoConnections.empty() && !mqttMessagingIsRunning) {
+            for (const auto& mosquittoConnection : mosquittoConnections) {
+                mosquittoConnection->start();
+            }
             mqttMessagingIsRunning = true;
         }
     }
@@ -880,8 +942,10 @@ void JoynrClusterControllerRuntime::stopExternalCommunication()
         }
     }
     if (doMqttMessaging) {
-        if (mosquittoConnection && mqttMessagingIsRunning) {
-            mosquittoConnection->stop();
+        if (!mosquittoConnections.empty() && mqttMessagingIsRunning) {
+            for (const auto& mosquittoConnection : mosquittoConnections) {
+                mosquittoConnection->stop();
+            }
             mqttMessagingIsRunning = false;
         }
     }
@@ -904,9 +968,20 @@ void JoynrClusterControllerRuntime::shutdown()
     if (wsTLSCcMessagingSkeleton) {
         wsTLSCcMessagingSkeleton->shutdown();
     }
+    if (sharedMemoryCcMessagingSkeleton) {
+        sharedMemoryCcMessagingSkeleton->shutdown();
+    }
 
     unregisterInternalSystemServiceProviders();
 
+    // sends the global adds and removes which are still queued while messaging is available
+    if (localCapabilitiesDirectory) {
+        localCapabilitiesDirectory->shutdown();
+    }
+
+    if (httpClient) {
+        httpClient->shutdown();
+    }
     if (ccMessageRouter) {
         ccMessageRouter->shutdown();
     }
@@ -916,9 +991,6 @@ void JoynrClusterControllerRuntime::shutdown()
     if (subscriptionManager) {
         subscriptionManager->shutdown();
     }
-    if (localCapabilitiesDirectory) {
-        localCapabilitiesDirectory->shutdown();
-    }
 
     stop(true);
 
@@ -964,7 +1036,7 @@ std::shared_ptr<JoynrClusterControllerRuntime> JoynrClusterControllerRuntime::cr
 
 void JoynrClusterControllerRuntime::start()
 {
-    singleThreadIOService->start();
+    multiThreadedIOService->start();
     startLocalCommunication();
     startExternalCommunication();
 }
@@ -980,8 +1052,8 @@ void JoynrClusterControllerRuntime::stop(bool deleteHttpChannel)
     // synchronously stop the underlying boost::asio::io_service
     // this ensures all asynchronous operations are stopped now
     // which allows a safe shutdown
-    if (singleThreadIOService) {
-        singleThreadIOService->stop();
+    if (multiThreadedIOService) {
+        multiThreadedIOService->stop();
     }
 }
 
@@ -33,6 +33,7 @@
 #include "joynr/Logger.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/Semaphore.h"
+#include "joynr/SharedMemorySettings.h"
 #include "joynr/WebSocketSettings.h"
 
 class JoynrClusterControllerRuntimeTest;
@@ -59,8 +60,11 @@ class Settings;
 class IMessageRouter;
 class IMessageSender;
 class IWebsocketCcMessagingSkeleton;
+class SharedMemoryCcMessagingSkeleton;
 class CcMessageRouter;
+class CurlMultiHttpClient;
 class WebSocketMessagingStubFactory;
+class SharedMemoryMessagingStubFactory;
 class MosquittoConnection;
 class LocalDomainAccessController;
 
@@ -143,9 +147,10 @@ protected:
 
     std::shared_ptr<ITransportMessageReceiver> httpMessageReceiver;
     std::shared_ptr<ITransportMessageSender> httpMessageSender;
+    std::shared_ptr<CurlMultiHttpClient> httpClient;
     std::shared_ptr<HttpMessagingSkeleton> httpMessagingSkeleton;
 
-    std::shared_ptr<MosquittoConnection> mosquittoConnection;
+    std::vector<std::shared_ptr<MosquittoConnection>> mosquittoConnections;
     std::shared_ptr<ITransportMessageReceiver> mqttMessageReceiver;
     std::shared_ptr<ITransportMessageSender> mqttMessageSender;
     MqttMessagingSkeletonFactory mqttMessagingSkeletonFactory;
@@ -166,6 +171,9 @@ protected:
     bool doMqttMessaging;
     bool doHttpMessaging;
     std::shared_ptr<WebSocketMessagingStubFactory> wsMessagingStubFactory;
+    SharedMemorySettings sharedMemorySettings;
+    std::shared_ptr<SharedMemoryCcMessagingSkeleton> sharedMemoryCcMessagingSkeleton;
+    std::shared_ptr<SharedMemoryMessagingStubFactory> sharedMemoryMessagingStubFactory;
 
     ADD_LOGGER(JoynrClusterControllerRuntime)
 
@@ -30,6 +30,7 @@
 #include "joynr/JoynrClusterControllerRuntimeExport.h"
 #include "joynr/LocalDiscoveryAggregator.h"
 #include "joynr/MessagingSettings.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/ParticipantIdStorage.h"
 #include "joynr/PrivateCopyAssign.h"
 #include "joynr/ProxyBuilder.h"
@@ -43,8 +44,6 @@
 namespace joynr
 {
 
-class SingleThreadedIOService;
-
 /**
  * @brief Class representing the central Joynr Api object,
  * used to register / unregister providers and create proxy builders
@@ -245,14 +244,16 @@ public:
                     "runtime is not yet fully initialized.");
         }
 
-        auto proxyBuilder = std::make_shared<ProxyBuilder<TIntfProxy>>(shared_from_this(),
-                                                                       *proxyFactory,
-                                                                       requestCallerDirectory,
-                                                                       discoveryProxy,
-                                                                       domain,
-                                                                       dispatcherAddress,
-                                                                       getMessageRouter(),
-                                                                       messagingSettings);
+        auto proxyBuilder = std::make_shared<ProxyBuilder<TIntfProxy>>(
+                shared_from_this(),
+                *proxyFactory,
+                requestCallerDirectory,
+                discoveryProxy,
+                domain,
+                dispatcherAddress,
+                getMessageRouter(),
+                messagingSettings,
+                multiThreadedIOService->getIOService());
         std::lock_guard<std::mutex> lock(proxyBuildersMutex);
         proxyBuilders.push_back(proxyBuilder);
         return proxyBuilder;
@@ -286,7 +287,7 @@ protected:
     virtual std::map<std::string, joynr::types::DiscoveryEntryWithMetaInfo> getProvisionedEntries()
             const;
 
-    std::shared_ptr<SingleThreadedIOService> singleThreadIOService;
+    std::shared_ptr<MultiThreadedIOService> multiThreadedIOService;
 
     /** @brief Factory for creating proxy instances */
     std::unique_ptr<ProxyFactory> proxyFactory;
@@ -31,10 +31,10 @@
 #include "joynr/LibJoynrMessageRouter.h"
 #include "joynr/MessagingSettings.h"
 #include "joynr/MessagingStubFactory.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/PublicationManager.h"
 #include "joynr/ProxyBuilder.h"
 #include "joynr/Settings.h"
-#include "joynr/SingleThreadedIOService.h"
 #include "joynr/SubscriptionManager.h"
 #include "joynr/Util.h"
 #include "joynr/system/DiscoveryProxy.h"
@@ -60,7 +60,7 @@ LibJoynrRuntime::LibJoynrRuntime(std::unique_ptr<Settings> settings,
           libJoynrRuntimeIsShuttingDown(false)
 {
     libjoynrSettings->printSettings();
-    singleThreadIOService->start();
+    multiThreadedIOService->start();
 }
 
 LibJoynrRuntime::~LibJoynrRuntime()
@@ -130,7 +130,7 @@ void LibJoynrRuntime::init(
             messagingSettings,
             libjoynrMessagingAddress,
             std::move(messagingStubFactory),
-            singleThreadIOService->getIOService(),
+            multiThreadedIOService->getIOService(),
             std::move(addressCalculator),
             libjoynrSettings->isMessageRouterPersistencyEnabled(),
             std::vector<std::shared_ptr<ITransportStatus>>{},
@@ -146,7 +146,7 @@ void LibJoynrRuntime::init(
     messageSender = std::make_shared<MessageSender>(
             libJoynrMessageRouter, keyChain, messagingSettings.getTtlUpliftMs());
     joynrDispatcher =
-            std::make_shared<Dispatcher>(messageSender, singleThreadIOService->getIOService());
+            std::make_shared<Dispatcher>(messageSender, multiThreadedIOService->getIOService());
     messageSender->registerDispatcher(joynrDispatcher);
 
     // create the inprocess skeleton for the dispatcher
@@ -154,7 +154,7 @@ void LibJoynrRuntime::init(
     dispatcherAddress = std::make_shared<InProcessMessagingAddress>(dispatcherMessagingSkeleton);
 
     publicationManager = std::make_shared<PublicationManager>(
-            singleThreadIOService->getIOService(),
+            multiThreadedIOService->getIOService(),
             messageSender,
             libjoynrSettings->isSubscriptionPersistencyEnabled(),
             messagingSettings.getTtlUpliftMs());
@@ -164,7 +164,7 @@ void LibJoynrRuntime::init(
             libjoynrSettings->getBroadcastSubscriptionRequestPersistenceFilename());
 
     subscriptionManager = std::make_shared<SubscriptionManager>(
-            singleThreadIOService->getIOService(), libJoynrMessageRouter);
+            multiThreadedIOService->getIOService(), libJoynrMessageRouter);
 
     auto joynrMessagingConnectorFactory =
             std::make_shared<JoynrMessagingConnectorFactory>(messageSender, subscriptionManager);
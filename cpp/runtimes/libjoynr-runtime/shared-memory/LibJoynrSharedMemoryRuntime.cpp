@@ -0,0 +1,165 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include "runtimes/libjoynr-runtime/shared-memory/LibJoynrSharedMemoryRuntime.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "joynr/MultiThreadedIOService.h"
+#include "joynr/SharedMemoryMulticastAddressCalculator.h"
+#include "joynr/Util.h"
+#include "joynr/serializer/Serializer.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+#include "joynr/system/RoutingTypes/SharedMemoryClientAddress.h"
+#include "libjoynr/shared-memory/SharedMemoryClient.h"
+#include "libjoynr/shared-memory/SharedMemoryMessagingStubFactory.h"
+#include "libjoynr/websocket/WebSocketLibJoynrMessagingSkeleton.h"
+
+namespace joynr
+{
+
+LibJoynrSharedMemoryRuntime::LibJoynrSharedMemoryRuntime(std::unique_ptr<Settings> settings)
+        : LibJoynrRuntime(std::move(settings)),
+          sharedMemorySettings(*this->settings),
+          sharedMemoryClient(std::make_shared<SharedMemoryClient>(
+                  sharedMemorySettings,
+                  multiThreadedIOService->getIOService())),
+          initializationMsg(),
+          isShuttingDown(false)
+{
+    sharedMemorySettings.printSettings();
+}
+
+LibJoynrSharedMemoryRuntime::~LibJoynrSharedMemoryRuntime()
+{
+    assert(isShuttingDown);
+}
+
+void LibJoynrSharedMemoryRuntime::shutdown()
+{
+    assert(!isShuttingDown);
+    isShuttingDown = true;
+    assert(sharedMemoryClient);
+    sharedMemoryClient->stop();
+
+    // synchronously stop the underlying boost::asio::io_service
+    // this ensures all asynchronous operations are stopped now
+    // which allows a safe shutdown
+    assert(multiThreadedIOService);
+    multiThreadedIOService->stop();
+    LibJoynrRuntime::shutdown();
+}
+
+void LibJoynrSharedMemoryRuntime::connect(
+        std::function<void()> onSuccess,
+        std::function<void(const joynr::exceptions::JoynrRuntimeException&)> onError)
+{
+    std::string uuid = util::createUuid();
+    // remove dashes
+    uuid.erase(std::remove(uuid.begin(), uuid.end(), '-'), uuid.end());
+    std::string libjoynrMessagingId = "libjoynr.messaging.participantid_" + uuid;
+    auto libjoynrMessagingAddress =
+            std::make_shared<const joynr::system::RoutingTypes::SharedMemoryClientAddress>(
+                    libjoynrMessagingId);
+
+    // send initialization message containing libjoynr messaging address
+    initializationMsg = joynr::serializer::serializeToJson(*libjoynrMessagingAddress);
+    JOYNR_LOG_TRACE(logger(),
+                    "OUTGOING sending shared memory intialization message\nmessage: {}\nto: {}",
+                    initializationMsg,
+                    libjoynrMessagingAddress->toString());
+
+    // create connection to parent routing service
+    auto ccMessagingAddress =
+            std::make_shared<const joynr::system::RoutingTypes::SharedMemoryAddress>(
+                    sharedMemorySettings.createClusterControllerMessagingAddress());
+
+    auto factory = std::make_shared<SharedMemoryMessagingStubFactory>();
+    factory->addServer(*ccMessagingAddress, sharedMemoryClient->getSender());
+
+    std::weak_ptr<SharedMemoryMessagingStubFactory> weakFactoryRef(factory);
+    sharedMemoryClient->registerDisconnectCallback([weakFactoryRef, ccMessagingAddress]() {
+        if (auto factory = weakFactoryRef.lock()) {
+            factory->onMessagingStubClosed(*ccMessagingAddress);
+        }
+    });
+
+    auto connectCallback = [
+        thisWeakPtr = joynr::util::as_weak_ptr(
+                std::dynamic_pointer_cast<LibJoynrSharedMemoryRuntime>(this->shared_from_this())),
+        onSuccess = std::move(onSuccess),
+        onError = std::move(onError),
+        factory,
+        libjoynrMessagingAddress,
+        ccMessagingAddress
+    ]() mutable
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->sendInitializationMsg();
+
+            std::unique_ptr<IMulticastAddressCalculator> addressCalculator =
+                    std::make_unique<joynr::SharedMemoryMulticastAddressCalculator>(
+                            ccMessagingAddress);
+            thisSharedPtr->init(factory,
+                                libjoynrMessagingAddress,
+                                ccMessagingAddress,
+                                std::move(addressCalculator),
+                                std::move(onSuccess),
+                                std::move(onError));
+        }
+    };
+
+    auto reconnectCallback = [thisWeakPtr = joynr::util::as_weak_ptr(std::dynamic_pointer_cast<
+                                      LibJoynrSharedMemoryRuntime>(this->shared_from_this()))]()
+    {
+        if (auto thisSharedPtr = thisWeakPtr.lock()) {
+            thisSharedPtr->sendInitializationMsg();
+        }
+    };
+
+    sharedMemoryClient->registerConnectCallback(connectCallback);
+    sharedMemoryClient->registerReconnectCallback(reconnectCallback);
+    sharedMemoryClient->connect(*ccMessagingAddress);
+}
+
+void LibJoynrSharedMemoryRuntime::sendInitializationMsg()
+{
+    auto onFailure = [](const exceptions::JoynrRuntimeException& e) {
+        // initialization message will be sent after reconnect
+        JOYNR_LOG_ERROR(LibJoynrSharedMemoryRuntime::logger(),
+                        "Sending shared memory initialization message failed. Error: {}",
+                        e.getMessage());
+    };
+    smrf::ByteVector rawMessage(initializationMsg.begin(), initializationMsg.end());
+    sharedMemoryClient->send(smrf::ByteArrayView(rawMessage), std::move(onFailure));
+}
+
+void LibJoynrSharedMemoryRuntime::startLibJoynrMessagingSkeleton(
+        std::shared_ptr<IMessageRouter> messageRouter)
+{
+    // incoming SMRF messages are handled exactly like the ones received via websocket
+    auto libJoynrMessagingSkeleton =
+            std::make_shared<WebSocketLibJoynrMessagingSkeleton>(util::as_weak_ptr(messageRouter));
+    sharedMemoryClient->registerReceiveCallback(
+            [libJoynrMessagingSkeleton](smrf::ByteVector&& msg) {
+                libJoynrMessagingSkeleton->onMessageReceived(std::move(msg));
+            });
+}
+
+} // namespace joynr
@@ -0,0 +1,65 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef LIBJOYNRSHAREDMEMORYRUNTIME_H
+#define LIBJOYNRSHAREDMEMORYRUNTIME_H
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "joynr/Logger.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/Settings.h"
+#include "joynr/SharedMemorySettings.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "runtimes/libjoynr-runtime/LibJoynrRuntime.h"
+
+namespace joynr
+{
+class SharedMemoryClient;
+
+class LibJoynrSharedMemoryRuntime : public LibJoynrRuntime
+{
+public:
+    explicit LibJoynrSharedMemoryRuntime(std::unique_ptr<Settings> settings);
+    ~LibJoynrSharedMemoryRuntime() override;
+
+    void shutdown() override;
+
+protected:
+    void startLibJoynrMessagingSkeleton(std::shared_ptr<IMessageRouter> messageRouter) override;
+    void connect(std::function<void()> onSuccess,
+                 std::function<void(const joynr::exceptions::JoynrRuntimeException&)> onError);
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(LibJoynrSharedMemoryRuntime);
+
+    void sendInitializationMsg();
+
+    SharedMemorySettings sharedMemorySettings;
+    std::shared_ptr<SharedMemoryClient> sharedMemoryClient;
+    std::string initializationMsg;
+    bool isShuttingDown;
+    ADD_LOGGER(LibJoynrSharedMemoryRuntime)
+
+    friend class JoynrRuntime;
+};
+
+} // namespace joynr
+#endif // LIBJOYNRSHAREDMEMORYRUNTIME_H
@@ -24,7 +24,9 @@
 #include "joynr/Future.h"
 #include "joynr/IKeychain.h"
 #include "joynr/Settings.h"
+#include "joynr/SharedMemorySettings.h"
 #include "joynr/exceptions/JoynrException.h"
+#include "runtimes/libjoynr-runtime/shared-memory/LibJoynrSharedMemoryRuntime.h"
 #include "runtimes/libjoynr-runtime/websocket/LibJoynrWebSocketRuntime.h"
 
 namespace joynr
@@ -81,12 +83,21 @@ std::shared_ptr<JoynrRuntime> JoynrRuntime::createRuntimeAsync(
         std::function<void(const exceptions::JoynrRuntimeException& exception)> onError,
         std::shared_ptr<IKeychain> keyChain) noexcept
 {
-    std::shared_ptr<LibJoynrWebSocketRuntime> runtimeImpl;
+    std::shared_ptr<LibJoynrRuntime> runtimeImpl;
 
     try {
-        runtimeImpl = std::make_shared<LibJoynrWebSocketRuntime>(
-                std::move(settings), std::move(keyChain));
-        runtimeImpl->connect(std::move(onSuccess), onError);
+        // the shared memory transport takes precedence if a cluster controller path is configured
+        if (SharedMemorySettings(*settings).isEnabled()) {
+            auto sharedMemoryRuntime =
+                    std::make_shared<LibJoynrSharedMemoryRuntime>(std::move(settings));
+            runtimeImpl = sharedMemoryRuntime;
+            sharedMemoryRuntime->connect(std::move(onSuccess), onError);
+        } else {
+            auto webSocketRuntime = std::make_shared<LibJoynrWebSocketRuntime>(
+                    std::move(settings), std::move(keyChain));
+            runtimeImpl = webSocketRuntime;
+            webSocketRuntime->connect(std::move(onSuccess), onError);
+        }
     } catch (const exceptions::JoynrRuntimeException& exception) {
         JOYNR_LOG_ERROR(
                 JoynrRuntime::logger(), "caught JoynrRuntimeException: {}", exception.what());
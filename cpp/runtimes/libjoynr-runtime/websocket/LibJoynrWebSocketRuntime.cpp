@@ -22,7 +22,7 @@
 
 #include <websocketpp/common/connection_hdl.hpp>
 
-#include "joynr/SingleThreadedIOService.h"
+#include "joynr/MultiThreadedIOService.h"
 #include "joynr/Util.h"
 #include "joynr/WebSocketMulticastAddressCalculator.h"
 #include "joynr/exceptions/JoynrException.h"
@@ -63,8 +63,8 @@ void LibJoynrWebSocketRuntime::shutdown()
     // synchronously stop the underlying boost::asio::io_service
     // this ensures all asynchronous operations are stopped now
     // which allows a safe shutdown
-    assert(singleThreadIOService);
-    singleThreadIOService->stop();
+    assert(multiThreadedIOService);
+    multiThreadedIOService->stop();
     LibJoynrRuntime::shutdown();
 }
 
@@ -166,11 +166,11 @@ void LibJoynrWebSocketRuntime::createWebsocketClient()
 
         JOYNR_LOG_INFO(logger(), "Using TLS connection");
         websocket = std::make_shared<WebSocketPpClientTLS>(
-                wsSettings, singleThreadIOService->getIOService(), keyChain);
+                wsSettings, multiThreadedIOService->getIOService(), keyChain);
     } else if (webSocketAddress.getProtocol() == system::RoutingTypes::WebSocketProtocol::WS) {
         JOYNR_LOG_INFO(logger(), "Using non-TLS connection");
         websocket = std::make_shared<WebSocketPpClientNonTLS>(
-                wsSettings, singleThreadIOService->getIOService());
+                wsSettings, multiThreadedIOService->getIOService());
     } else {
         throw exceptions::JoynrRuntimeException(
                 "Unknown protocol used for settings property 'cluster-controller-messaging-url'");
@@ -226,6 +226,63 @@ TEST_F(DispatcherTest, receive_interpreteRequestAndCallOperation)
     EXPECT_TRUE(getLocationCalledSemaphore.waitFor(std::chrono::milliseconds(5000)));
 }
 
+TEST_F(DispatcherTest, sendRequest_providerInSameRuntime_requestIsNotRouted)
+{
+    EXPECT_CALL(*mockRequestCaller,
+                getLocationMock(
+                        A<std::function<void(const joynr::types::Localisation::GpsLocation&)>>(),
+                        A<std::function<void(const std::shared_ptr<
+                                joynr::exceptions::ProviderRuntimeException>&)>>()))
+            .WillOnce(Invoke(this, &DispatcherTest::invokeOnSuccessWithGpsLocation));
+    EXPECT_CALL(*mockCallback, onSuccess(Eq(gpsLocation1)))
+            .WillOnce(ReleaseSemaphore(&getLocationCalledSemaphore));
+    EXPECT_CALL(*mockMessageRouter, isInProcessShortCircuitAllowed()).WillRepeatedly(Return(true));
+    EXPECT_CALL(*mockMessageRouter, route(_, _)).Times(0);
+
+    messageSender->registerDispatcher(dispatcher);
+    dispatcher->addRequestCaller(providerParticipantId, mockRequestCaller);
+
+    Request request;
+    request.setRequestReplyId(requestReplyId);
+    request.setMethodName("getLocation");
+    request.setParams();
+    request.setParamDatatypes(std::vector<std::string>());
+
+    messageSender->sendRequest(proxyParticipantId,
+                               providerParticipantId,
+                               qos,
+                               request,
+                               mockReplyCaller,
+                               isLocalMessage);
+    EXPECT_TRUE(getLocationCalledSemaphore.waitFor(std::chrono::milliseconds(5000)));
+}
+
+TEST_F(DispatcherTest, sendRequest_shortCircuitNotAllowed_requestIsRouted)
+{
+    EXPECT_CALL(*mockRequestCaller, getLocationMock(_, _)).Times(0);
+    EXPECT_CALL(*mockMessageRouter, isInProcessShortCircuitAllowed())
+            .WillRepeatedly(Return(false));
+    EXPECT_CALL(*mockMessageRouter,
+                route(MessageHasType(joynr::Message::VALUE_MESSAGE_TYPE_REQUEST()), _))
+            .WillOnce(ReleaseSemaphore(&getLocationCalledSemaphore));
+
+    messageSender->registerDispatcher(dispatcher);
+    dispatcher->addRequestCaller(providerParticipantId, mockRequestCaller);
+
+    Request request;
+    request.setRequestReplyId(requestReplyId);
+    request.setMethodName("getLocation");
+    request.setParams();
+
+    messageSender->sendRequest(proxyParticipantId,
+                               providerParticipantId,
+                               qos,
+                               request,
+                               mockReplyCaller,
+                               isLocalMessage);
+    EXPECT_TRUE(getLocationCalledSemaphore.waitFor(std::chrono::milliseconds(5000)));
+}
+
 TEST_F(DispatcherTest, receive_customHeadersCopied)
 {
     const std::string customHeaderKey = "custom-header-key";
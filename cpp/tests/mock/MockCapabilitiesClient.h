@@ -47,6 +47,7 @@ public:
     MOCK_METHOD3(touch, void(const std::string& clusterControllerId,
                      std::function<void()> onSuccess,
                      std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onError));
+    MOCK_METHOD0(shutdown, void());
 };
 
 #endif // TESTS_MOCK_MOCKCAPABILITIESCLIENT_H
@@ -22,6 +22,8 @@
 #include <gmock/gmock.h>
 
 #include "joynr/IDispatcher.h"
+#include "joynr/MessagingQos.h"
+#include "joynr/Request.h"
 
 class MockDispatcher : public joynr::IDispatcher {
 public:
@@ -31,6 +33,11 @@ public:
     MOCK_METHOD2(addRequestCaller, void(const std::string& participantId, std::shared_ptr<joynr::RequestCaller> requestCaller));
     MOCK_METHOD1(removeRequestCaller, void(const std::string& participantId));
     MOCK_METHOD1(receive, void(std::shared_ptr<joynr::ImmutableMessage> message));
+    MOCK_METHOD5(deliverRequestInProcess, bool(const std::string& senderParticipantId,
+                                               const std::string& receiverParticipantId,
+                                               const joynr::MessagingQos& qos,
+                                               const joynr::Request& request,
+                                               std::shared_ptr<joynr::IReplyCaller> replyCaller));
     MOCK_METHOD1(registerSubscriptionManager, void(std::shared_ptr<joynr::ISubscriptionManager> subscriptionManager));
     MOCK_METHOD1(registerPublicationManager,void(std::weak_ptr<joynr::PublicationManager> publicationManager));
     MOCK_METHOD0(shutdown, void ());
@@ -0,0 +1,139 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#ifndef TESTS_MOCK_MOCKGLOBALCAPABILITIESDIRECTORYPROXY_H
+#define TESTS_MOCK_MOCKGLOBALCAPABILITIESDIRECTORYPROXY_H
+
+#include <gmock/gmock.h>
+
+#include "joynr/MessagingQos.h"
+#include "joynr/infrastructure/GlobalCapabilitiesDirectoryProxy.h"
+
+namespace joynr
+{
+class JoynrRuntimeImpl;
+} // namespace joynr
+
+class MockGlobalCapabilitiesDirectoryProxy : public virtual joynr::infrastructure::GlobalCapabilitiesDirectoryProxy {
+public:
+    MockGlobalCapabilitiesDirectoryProxy(std::weak_ptr<joynr::JoynrRuntimeImpl> runtime) :
+        ProxyBase(
+                runtime,
+                nullptr,
+                "domain",
+                joynr::MessagingQos()),
+        GlobalCapabilitiesDirectoryProxyBase(
+                runtime,
+                nullptr,
+                "domain",
+                joynr::MessagingQos()),
+        GlobalCapabilitiesDirectorySyncProxy(
+                runtime,
+                nullptr,
+                "domain",
+                joynr::MessagingQos()),
+        GlobalCapabilitiesDirectoryAsyncProxy(
+                runtime,
+                nullptr,
+                "domain",
+                joynr::MessagingQos()),
+        GlobalCapabilitiesDirectoryProxy(
+                runtime,
+                nullptr,
+                "domain",
+                joynr::MessagingQos())
+    { }
+
+    std::shared_ptr<joynr::Future<void>> addAsync(
+            const joynr::types::GlobalDiscoveryEntry& globalDiscoveryEntry,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return addAsyncMock(
+                globalDiscoveryEntry,
+                std::move(onSuccess),
+                std::move(onRuntimeError),
+                std::move(qos));
+    }
+    MOCK_METHOD4(addAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const joynr::types::GlobalDiscoveryEntry& globalDiscoveryEntry,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+
+    std::shared_ptr<joynr::Future<void>> addAsync(
+            const std::vector<joynr::types::GlobalDiscoveryEntry>& globalDiscoveryEntries,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return addListAsyncMock(
+                globalDiscoveryEntries,
+                std::move(onSuccess),
+                std::move(onRuntimeError),
+                std::move(qos));
+    }
+    MOCK_METHOD4(addListAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const std::vector<joynr::types::GlobalDiscoveryEntry>& globalDiscoveryEntries,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+
+    std::shared_ptr<joynr::Future<void>> removeAsync(
+            const std::string& participantId,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return removeAsyncMock(
+                participantId,
+                std::move(onSuccess),
+                std::move(onRuntimeError),
+                std::move(qos));
+    }
+    MOCK_METHOD4(removeAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const std::string& participantId,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+
+    std::shared_ptr<joynr::Future<void>> removeAsync(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos
+        ) noexcept override
+    {
+        return removeListAsyncMock(
+                participantIds,
+                std::move(onSuccess),
+                std::move(onRuntimeError),
+                std::move(qos));
+    }
+    MOCK_METHOD4(removeListAsyncMock, std::shared_ptr<joynr::Future<void>>(
+            const std::vector<std::string>& participantIds,
+            std::function<void()> onSuccess,
+            std::function<void(const joynr::exceptions::JoynrRuntimeException& error)> onRuntimeError,
+            boost::optional<joynr::MessagingQos> qos));
+};
+
+#endif // TESTS_MOCK_MOCKGLOBALCAPABILITIESDIRECTORYPROXY_H
@@ -21,12 +21,15 @@
 
 #include <gmock/gmock.h>
 
+#include "joynr/ImmutableMessage.h"
 #include "joynr/IWebSocketSendInterface.h"
 
 class MockWebSocketSendInterface : public joynr::IWebSocketSendInterface {
 public:
     MOCK_METHOD2(send, void (const smrf::ByteArrayView& message,
                              const std::function<void(const joynr::exceptions::JoynrRuntimeException&)>& onFailure));
+    MOCK_METHOD2(send, void (std::shared_ptr<joynr::ImmutableMessage> message,
+                             const std::function<void(const joynr::exceptions::JoynrRuntimeException&)>& onFailure));
     MOCK_CONST_METHOD0(isInitialized, bool ());
     MOCK_CONST_METHOD0(isConnected, bool ());
 };
@@ -27,7 +27,9 @@
 #include "joynr/JoynrClusterControllerRuntime.h"
 #include "joynr/infrastructure/IGlobalCapabilitiesDirectory.h"
 #include "joynr/types/Version.h"
+#include "joynr/Semaphore.h"
 #include "joynr/Settings.h"
+#include "joynr/SingleThreadedIOService.h"
 
 #include "libjoynrclustercontroller/capabilities-client/CapabilitiesClient.h"
 #include "libjoynrclustercontroller/messaging/MessagingPropertiesPersistence.h"
@@ -58,12 +60,14 @@ public:
     std::unique_ptr<Settings> settings;
     MessagingSettings messagingSettings;
     ClusterControllerSettings clusterControllerSettings;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
 
     CapabilitiesClientTest()
             : runtime(),
               settings(std::make_unique<Settings>(GetParam())),
               messagingSettings(*settings),
-              clusterControllerSettings(*settings)
+              clusterControllerSettings(*settings),
+              singleThreadedIOService(std::make_shared<SingleThreadedIOService>())
     {
         messagingSettings.setMessagingPropertiesPersistenceFilename(
                 messagingPropertiesPersistenceFileName);
@@ -78,11 +82,13 @@ public:
 
     void SetUp() override
     {
+        singleThreadedIOService->start();
         runtime->start();
     }
 
     ~CapabilitiesClientTest() override
     {
+        singleThreadedIOService->stop();
         runtime->shutdown();
         test::util::resetAndWaitUntilDestroyed(runtime);
 
@@ -90,30 +96,37 @@ public:
         test::util::removeAllCreatedSettingsAndPersistencyFiles();
     }
 
+protected:
+    std::shared_ptr<CapabilitiesClient> createCapabilitiesClient()
+    {
+        std::shared_ptr<ProxyBuilder<infrastructure::GlobalCapabilitiesDirectoryProxy>>
+                capabilitiesProxyBuilder = runtime->createProxyBuilder<
+                        infrastructure::GlobalCapabilitiesDirectoryProxy>(
+                        messagingSettings.getDiscoveryDirectoriesDomain());
+
+        DiscoveryQos discoveryQos(10000);
+        discoveryQos.setArbitrationStrategy(DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT);
+        discoveryQos.addCustomParameter(
+                "fixedParticipantId", messagingSettings.getCapabilitiesDirectoryParticipantId());
+        const MessagingQos messagingQos(10000);
+        std::shared_ptr<infrastructure::GlobalCapabilitiesDirectoryProxy> cabilitiesProxy(
+                capabilitiesProxyBuilder->setMessagingQos(messagingQos)
+                        ->setDiscoveryQos(discoveryQos)
+                        ->build());
+
+        auto capabilitiesClient = std::make_shared<CapabilitiesClient>(
+                clusterControllerSettings, singleThreadedIOService->getIOService());
+        capabilitiesClient->setProxy(cabilitiesProxy, messagingQos);
+        return capabilitiesClient;
+    }
+
 private:
     DISALLOW_COPY_AND_ASSIGN(CapabilitiesClientTest);
 };
 
 TEST_P(CapabilitiesClientTest, registerAndRetrieveCapability)
 {
-    std::shared_ptr<ProxyBuilder<infrastructure::GlobalCapabilitiesDirectoryProxy>>
-            capabilitiesProxyBuilder =
-                    runtime->createProxyBuilder<infrastructure::GlobalCapabilitiesDirectoryProxy>(
-                            messagingSettings.getDiscoveryDirectoriesDomain());
-
-    DiscoveryQos discoveryQos(10000);
-    discoveryQos.setArbitrationStrategy(DiscoveryQos::ArbitrationStrategy::FIXED_PARTICIPANT);
-    discoveryQos.addCustomParameter(
-            "fixedParticipantId", messagingSettings.getCapabilitiesDirectoryParticipantId());
-    const MessagingQos messagingQos(10000);
-    std::shared_ptr<infrastructure::GlobalCapabilitiesDirectoryProxy> cabilitiesProxy(
-            capabilitiesProxyBuilder->setMessagingQos(messagingQos)
-                    ->setDiscoveryQos(discoveryQos)
-                    ->build());
-
-    std::unique_ptr<CapabilitiesClient> capabilitiesClient(
-            std::make_unique<CapabilitiesClient>(clusterControllerSettings));
-    capabilitiesClient->setProxy(cabilitiesProxy, messagingQos);
+    std::shared_ptr<CapabilitiesClient> capabilitiesClient = createCapabilitiesClient();
 
     std::string capDomain("testDomain");
     std::string capInterface("testInterface");
@@ -159,6 +172,39 @@ TEST_P(CapabilitiesClientTest, registerAndRetrieveCapability)
     JOYNR_LOG_DEBUG(logger(), "finished get capabilities");
 }
 
+TEST_P(CapabilitiesClientTest, batchedAddsResolveCallbackOfEachEntry)
+{
+    clusterControllerSettings.setCapabilitiesClientBatchWindowMs(std::chrono::milliseconds(100));
+    std::shared_ptr<CapabilitiesClient> capabilitiesClient = createCapabilitiesClient();
+
+    const std::size_t numberOfEntries = 5;
+    const std::string capDomain("testDomain");
+    const std::string capInterface("testBatchInterface");
+    const joynr::types::Version providerVersion(47, 11);
+    Semaphore addsFinished(0);
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        types::GlobalDiscoveryEntry globalDiscoveryEntry(providerVersion,
+                                                         capDomain,
+                                                         capInterface,
+                                                         "testBatchParticipantId" +
+                                                                 std::to_string(i),
+                                                         types::ProviderQos(),
+                                                         0,
+                                                         1000,
+                                                         "publicKeyId",
+                                                         "testChannelId");
+        capabilitiesClient->add(globalDiscoveryEntry,
+                                [&addsFinished]() { addsFinished.notify(); },
+                                [](const joynr::exceptions::JoynrRuntimeException& exception) {
+                                    FAIL() << "add failed: " << exception.getMessage();
+                                });
+    }
+
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        EXPECT_TRUE(addsFinished.waitFor(std::chrono::seconds(10)));
+    }
+}
+
 using namespace std::string_literals;
 
 INSTANTIATE_TEST_CASE_P(DISABLED_Http,
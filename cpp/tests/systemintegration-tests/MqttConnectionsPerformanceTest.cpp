@@ -0,0 +1,193 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/BrokerUrl.h"
+#include "joynr/Url.h"
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/Logger.h"
+#include "joynr/MessagingSettings.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Semaphore.h"
+#include "joynr/Settings.h"
+#include "joynr/Util.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/system/RoutingTypes/MqttAddress.h"
+
+#include "libjoynrclustercontroller/mqtt/MosquittoConnection.h"
+#include "libjoynrclustercontroller/mqtt/MqttSender.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+/*
+ * Measures the throughput of the MqttSender against the broker configured in the settings,
+ * depending on the number of connections the outgoing messages are distributed over.
+ * All messages are received by a single connection, which corresponds to a cluster controller
+ * being flooded with requests from another one.
+ */
+class MqttConnectionsPerformanceTest : public TestWithParam<std::uint16_t>
+{
+public:
+    ADD_LOGGER(MqttConnectionsPerformanceTest)
+
+    MqttConnectionsPerformanceTest()
+            : settings("test-resources/MqttSystemIntegrationTest1.settings"),
+              messagingSettings(settings),
+              clusterControllerSettings(settings),
+              uuid(util::createUuid()),
+              receiverConnection(),
+              senderConnections(),
+              receivedMessages(0),
+              allMessagesReceived(0)
+    {
+    }
+
+    ~MqttConnectionsPerformanceTest() override
+    {
+        for (auto& connection : senderConnections) {
+            connection->stop();
+        }
+        if (receiverConnection) {
+            receiverConnection->stop();
+        }
+    }
+
+protected:
+    static bool waitUntilReadyToSend(const MosquittoConnection& connection)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!connection.isReadyToSend()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return true;
+    }
+
+    Settings settings;
+    MessagingSettings messagingSettings;
+    ClusterControllerSettings clusterControllerSettings;
+    const std::string uuid;
+    std::shared_ptr<MosquittoConnection> receiverConnection;
+    std::vector<std::shared_ptr<MosquittoConnection>> senderConnections;
+    std::atomic<std::uint64_t> receivedMessages;
+    Semaphore allMessagesReceived;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(MqttConnectionsPerformanceTest);
+};
+
+TEST_P(MqttConnectionsPerformanceTest, publishManyMessages)
+{
+    const std::uint16_t numberOfConnections = GetParam();
+    constexpr std::uint64_t numberOfRecipients = 64;
+    constexpr std::uint64_t messagesPerRecipient = 100;
+    constexpr std::uint64_t numberOfMessages = numberOfRecipients * messagesPerRecipient;
+    const std::string payload(1024, 'x');
+
+    const std::string receiverChannelId = "mqttPerformanceReceiver-" + uuid;
+    receiverConnection = std::make_shared<MosquittoConnection>(
+            messagingSettings, clusterControllerSettings, receiverChannelId);
+    receiverConnection->registerChannelId(receiverChannelId);
+    receiverConnection->registerReceiveCallback([this](smrf::ByteVector&&) {
+        if (++receivedMessages == numberOfMessages) {
+            allMessagesReceived.notify();
+        }
+    });
+    receiverConnection->start();
+    ASSERT_TRUE(waitUntilReadyToSend(*receiverConnection));
+
+    const std::string senderChannelId = "mqttPerformanceSender-" + uuid;
+    for (std::uint16_t i = 0; i < numberOfConnections; ++i) {
+        const std::string clientId = senderChannelId + "-" + std::to_string(i);
+        const bool channelTopicSubscriptionEnabled = (i == 0);
+        auto connection = std::make_shared<MosquittoConnection>(messagingSettings,
+                                                                clusterControllerSettings,
+                                                                clientId,
+                                                                channelTopicSubscriptionEnabled);
+        connection->registerChannelId(senderChannelId);
+        connection->start();
+        senderConnections.push_back(std::move(connection));
+    }
+    for (const auto& connection : senderConnections) {
+        ASSERT_TRUE(waitUntilReadyToSend(*connection));
+    }
+    MqttSender mqttSender(senderConnections, messagingSettings);
+
+    const Url brokerUrl = messagingSettings.getBrokerUrl().getBrokerChannelsBaseUrl();
+    const std::string brokerUri =
+            "tcp://" + brokerUrl.getHost() + ":" + std::to_string(brokerUrl.getPort());
+    const system::RoutingTypes::MqttAddress receiverAddress(brokerUri, receiverChannelId);
+
+    std::vector<std::shared_ptr<ImmutableMessage>> messages;
+    messages.reserve(numberOfMessages);
+    for (std::uint64_t j = 0; j < messagesPerRecipient; ++j) {
+        for (std::uint64_t i = 0; i < numberOfRecipients; ++i) {
+            MutableMessage mutableMessage;
+            mutableMessage.setType(Message::VALUE_MESSAGE_TYPE_ONE_WAY());
+            mutableMessage.setSender("mqttPerformanceSender");
+            mutableMessage.setRecipient("mqttPerformanceRecipient" + std::to_string(i));
+            mutableMessage.setPayload(payload);
+            messages.push_back(mutableMessage.getImmutableMessage());
+        }
+    }
+
+    std::atomic<std::uint64_t> failedMessages(0);
+    auto onFailure = [&failedMessages](const exceptions::JoynrRuntimeException&) {
+        ++failedMessages;
+    };
+
+    const auto start = std::chrono::steady_clock::now();
+    for (auto& message : messages) {
+        mqttSender.sendMessage(receiverAddress, std::move(message), onFailure);
+    }
+    const auto published = std::chrono::steady_clock::now();
+    ASSERT_TRUE(allMessagesReceived.waitFor(std::chrono::seconds(60)));
+    const auto received = std::chrono::steady_clock::now();
+    EXPECT_EQ(0, failedMessages.load());
+
+    const auto publishDurationMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(published - start).count();
+    const auto totalDurationMs =
+            std::chrono::duration_cast<std::chrono::milliseconds>(received - start).count();
+    JOYNR_LOG_INFO(logger(),
+                   "{} connections: published {} messages in {} ms, received all after {} ms "
+                   "({} messages/s)",
+                   numberOfConnections,
+                   numberOfMessages,
+                   publishDurationMs,
+                   totalDurationMs,
+                   totalDurationMs == 0 ? numberOfMessages * 1000
+                                        : numberOfMessages * 1000 / totalDurationMs);
+}
+
+INSTANTIATE_TEST_CASE_P(NumberOfConnections,
+                        MqttConnectionsPerformanceTest,
+                        Values(1, 2, 4));
@@ -17,6 +17,7 @@
  * #L%
  */
 
+#include <cstddef>
 #include <tuple>
 #include <string>
 
@@ -124,7 +125,9 @@ public:
                       clusterControllerSettings,
                       messageRouter,
                       singleThreadedIOService->getIOService())),
-              accessController(localCapabilitiesDirectoryMock, localDomainAccessControllerMock),
+              accessController(localCapabilitiesDirectoryMock,
+                               localDomainAccessControllerMock,
+                               clusterControllerSettings.getConsumerPermissionCacheSize()),
               messagingQos(MessagingQos(5000))
     {
         singleThreadedIOService->start();
@@ -338,6 +341,127 @@ TEST_F(AccessControllerTest, hasNoProviderPermission)
     EXPECT_FALSE(retval);
 }
 
+TEST_F(AccessControllerTest, interfaceLevelPermissionIsCached)
+{
+    prepareConsumerTest();
+    ConsumerPermissionCallbackMaker makeCallback(Permission::YES);
+    EXPECT_CALL(
+            *localDomainAccessControllerMock,
+            getConsumerPermission(DUMMY_USERID, TEST_DOMAIN, TEST_INTERFACE, TrustLevel::HIGH, _))
+            .Times(1)
+            .WillOnce(Invoke(&makeCallback, &ConsumerPermissionCallbackMaker::consumerPermission));
+
+    EXPECT_CALL(*accessControllerCallback, hasConsumerPermission(true)).Times(2);
+
+    for (int i = 0; i < 2; ++i) {
+        accessController.hasConsumerPermission(
+                getImmutableMessage(),
+                std::dynamic_pointer_cast<IAccessController::IHasConsumerPermissionCallback>(
+                        accessControllerCallback));
+    }
+}
+
+TEST_F(AccessControllerTest, permissionIsNotCachedIfCacheIsDisabled)
+{
+    const std::size_t consumerPermissionCacheSize = 0;
+    AccessController accessControllerWithoutCache(localCapabilitiesDirectoryMock,
+                                                  localDomainAccessControllerMock,
+                                                  consumerPermissionCacheSize);
+    EXPECT_CALL(*localCapabilitiesDirectoryMock,
+                lookup(toParticipantId,
+                       A<std::function<void(const joynr::types::DiscoveryEntryWithMetaInfo&)>>(),
+                       A<std::function<void(const joynr::exceptions::ProviderRuntimeException&)>>()))
+            .Times(2)
+            .WillRepeatedly(Invoke(this, &AccessControllerTest::invokeOnSuccessCallbackFct));
+    ConsumerPermissionCallbackMaker makeCallback(Permission::YES);
+    EXPECT_CALL(
+            *localDomainAccessControllerMock,
+            getConsumerPermission(DUMMY_USERID, TEST_DOMAIN, TEST_INTERFACE, TrustLevel::HIGH, _))
+            .Times(2)
+            .WillRepeatedly(
+                    Invoke(&makeCallback, &ConsumerPermissionCallbackMaker::consumerPermission));
+
+    EXPECT_CALL(*accessControllerCallback, hasConsumerPermission(true)).Times(2);
+
+    for (int i = 0; i < 2; ++i) {
+        accessControllerWithoutCache.hasConsumerPermission(
+                getImmutableMessage(),
+                std::dynamic_pointer_cast<IAccessController::IHasConsumerPermissionCallback>(
+                        accessControllerCallback));
+    }
+}
+
+TEST_F(AccessControllerTest, cachedPermissionIsInvalidatedWhenAccessControlChanges)
+{
+    ConsumerPermissionCallbackMaker makeCallbackYes(Permission::YES);
+    ConsumerPermissionCallbackMaker makeCallbackNo(Permission::NO);
+    EXPECT_CALL(
+            *localCapabilitiesDirectoryMock,
+            lookup(toParticipantId,
+                   A<std::function<void(const joynr::types::DiscoveryEntryWithMetaInfo&)>>(),
+                   A<std::function<void(const joynr::exceptions::ProviderRuntimeException&)>>()))
+            .Times(2)
+            .WillRepeatedly(Invoke(this, &AccessControllerTest::invokeOnSuccessCallbackFct));
+    EXPECT_CALL(
+            *localDomainAccessControllerMock,
+            getConsumerPermission(DUMMY_USERID, TEST_DOMAIN, TEST_INTERFACE, TrustLevel::HIGH, _))
+            .Times(2)
+            .WillOnce(Invoke(&makeCallbackYes, &ConsumerPermissionCallbackMaker::consumerPermission))
+            .WillOnce(Invoke(&makeCallbackNo, &ConsumerPermissionCallbackMaker::consumerPermission));
+
+    {
+        InSequence inSequence;
+        EXPECT_CALL(*accessControllerCallback, hasConsumerPermission(true)).Times(1);
+        EXPECT_CALL(*accessControllerCallback, hasConsumerPermission(false)).Times(1);
+    }
+
+    accessController.hasConsumerPermission(
+            getImmutableMessage(),
+            std::dynamic_pointer_cast<IAccessController::IHasConsumerPermissionCallback>(
+                    accessControllerCallback));
+    localDomainAccessControllerMock->notifyAccessControlChanged();
+    accessController.hasConsumerPermission(
+            getImmutableMessage(),
+            std::dynamic_pointer_cast<IAccessController::IHasConsumerPermissionCallback>(
+                    accessControllerCallback));
+}
+
+TEST_F(AccessControllerTest, operationLevelPermissionIsNotCached)
+{
+    ConsumerPermissionCallbackMaker makeCallback(Permission::YES);
+    EXPECT_CALL(
+            *localCapabilitiesDirectoryMock,
+            lookup(toParticipantId,
+                   A<std::function<void(const joynr::types::DiscoveryEntryWithMetaInfo&)>>(),
+                   A<std::function<void(const joynr::exceptions::ProviderRuntimeException&)>>()))
+            .Times(2)
+            .WillRepeatedly(Invoke(this, &AccessControllerTest::invokeOnSuccessCallbackFct));
+    EXPECT_CALL(
+            *localDomainAccessControllerMock,
+            getConsumerPermission(DUMMY_USERID, TEST_DOMAIN, TEST_INTERFACE, TrustLevel::HIGH, _))
+            .Times(2)
+            .WillRepeatedly(
+                    Invoke(&makeCallback, &ConsumerPermissionCallbackMaker::operationNeeded));
+
+    Permission::Enum permissionYes = Permission::YES;
+    DefaultValue<Permission::Enum>::Set(permissionYes);
+    EXPECT_CALL(
+            *localDomainAccessControllerMock,
+            getConsumerPermission(
+                    DUMMY_USERID, TEST_DOMAIN, TEST_INTERFACE, TEST_OPERATION, TrustLevel::HIGH))
+            .Times(2)
+            .WillRepeatedly(Return(permissionYes));
+
+    EXPECT_CALL(*accessControllerCallback, hasConsumerPermission(true)).Times(2);
+
+    for (int i = 0; i < 2; ++i) {
+        accessController.hasConsumerPermission(
+                getImmutableMessage(),
+                std::dynamic_pointer_cast<IAccessController::IHasConsumerPermissionCallback>(
+                        accessControllerCallback));
+    }
+}
+
 //----- Test Types --------------------------------------------------------------
 typedef ::testing::Types<SubscriptionRequest,
                          MulticastSubscriptionRequest,
@@ -16,9 +16,13 @@
  * limitations under the License.
  * #L%
  */
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_set>
-#include <memory>
+#include <vector>
 
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -34,6 +38,7 @@
 #include "joynr/FixedParticipantArbitrationStrategyFunction.h"
 #include "joynr/KeywordArbitrationStrategyFunction.h"
 #include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
 #include "joynr/Future.h"
 
@@ -45,6 +50,7 @@ using ::testing::Throw;
 using ::testing::Return;
 using ::testing::_;
 using ::testing::A;
+using ::testing::Invoke;
 using ::testing::InvokeWithoutArgs;
 using ::testing::DoAll;
 
@@ -66,13 +72,15 @@ public:
                    const joynr::types::Version& interfaceVersion,
                    std::weak_ptr<joynr::system::IDiscoveryAsync> discoveryProxy,
                    const DiscoveryQos& discoveryQos,
-                   std::unique_ptr<const ArbitrationStrategyFunction> arbitrationStrategyFunction)
+                   std::unique_ptr<const ArbitrationStrategyFunction> arbitrationStrategyFunction,
+                   boost::asio::io_service& ioService)
             : Arbitrator(domain,
                          interfaceName,
                          interfaceVersion,
                          discoveryProxy,
                          discoveryQos,
-                         std::move(arbitrationStrategyFunction)){};
+                         std::move(arbitrationStrategyFunction),
+                         ioService){};
 
     MOCK_METHOD0(attemptArbitration, void(void));
 };
@@ -94,8 +102,15 @@ public:
               defaultDiscoveryTimeoutMs(30000),
               defaultRetryIntervalMs(1000),
               publicKeyId("publicKeyId"),
-              mockDiscovery(std::make_shared<MockDiscovery>())
+              mockDiscovery(std::make_shared<MockDiscovery>()),
+              singleThreadedIOService(std::make_shared<SingleThreadedIOService>())
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~ArbitratorTest() override
     {
+        singleThreadedIOService->stop();
     }
 
     void testExceptionEmptyResult(std::shared_ptr<Arbitrator> arbitrator,
@@ -115,6 +130,7 @@ protected:
     std::string publicKeyId;
     ADD_LOGGER(ArbitratorTest)
     std::shared_ptr<MockDiscovery> mockDiscovery;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
     Semaphore semaphore;
 };
 
@@ -132,7 +148,8 @@ TEST_F(ArbitratorTest, arbitrationTimeout)
                                              providerVersion,
                                              mockDiscovery,
                                              discoveryQos,
-                                             move(lastSeenArbitrationStrategyFunction));
+                                             move(lastSeenArbitrationStrategyFunction),
+                                             singleThreadedIOService->getIOService());
 
     auto onSuccess = [](const types::DiscoveryEntryWithMetaInfo&) { FAIL(); };
 
@@ -176,7 +193,8 @@ TEST_F(ArbitratorTest, getLastSeen)
                                          providerVersion,
                                          mockDiscovery,
                                          discoveryQos,
-                                         move(lastSeenArbitrationStrategyFunction));
+                                         move(lastSeenArbitrationStrategyFunction),
+                                         singleThreadedIOService->getIOService());
 
     std::int64_t latestLastSeenDateMs = 7;
     std::string lastSeenParticipantId = std::to_string(latestLastSeenDateMs);
@@ -235,7 +253,8 @@ TEST_F(ArbitratorTest, getHighestPriority)
                                                       providerVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(qosArbitrationStrategyFunction));
+                                                      move(qosArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     // Create a list of provider Qos and participant ids
     std::vector<types::ProviderQos> qosEntries;
@@ -297,7 +316,8 @@ TEST_F(ArbitratorTest, getHighestPriorityChecksVersion)
                                                       expectedVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(qosArbitrationStrategyFunction));
+                                                      move(qosArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     // Create a list of discovery entries
     types::ProviderQos providerQos(
@@ -368,7 +388,8 @@ TEST_F(ArbitratorTest, getHighestPriorityOnChange)
                                                       providerVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(qosArbitrationStrategyFunction));
+                                                      move(qosArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     // Create a list of provider Qos and participant ids
     std::vector<types::ProviderQos> qosEntries;
@@ -439,7 +460,8 @@ TEST_F(ArbitratorTest, getKeywordProvider)
                                                       providerVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(keywordArbitrationStrategyFunction));
+                                                      move(keywordArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     // Create a list of provider Qos and participant ids
     std::vector<types::ProviderQos> qosEntries;
@@ -519,7 +541,8 @@ TEST_F(ArbitratorTest, getKeywordProviderChecksVersion)
                                                       expectedVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(keywordArbitrationStrategyFunction));
+                                                      move(keywordArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     // Create a list of discovery entries with the correct keyword
     std::vector<types::CustomParameter> parameterList;
@@ -601,7 +624,8 @@ TEST_F(ArbitratorTest, retryFiveTimes)
                                          providerVersion,
                                          mockDiscovery,
                                          discoveryQos,
-                                         move(lastSeenArbitrationStrategyFunction));
+                                         move(lastSeenArbitrationStrategyFunction),
+                                         singleThreadedIOService->getIOService());
 
     auto onSuccess = [](const types::DiscoveryEntryWithMetaInfo&) { FAIL(); };
     auto onError = [this](const exceptions::DiscoveryException&) { semaphore.notify(); };
@@ -661,7 +685,8 @@ TEST_F(ArbitratorTest, getHighestPriorityReturnsNoCompatibleProviderFoundExcepti
                                                       expectedVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(qosArbitrationStrategyFunction));
+                                                      move(qosArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     // Create a list of discovery entries
     types::ProviderQos providerQos(
@@ -752,7 +777,8 @@ TEST_F(ArbitratorTest, getKeywordProviderReturnsNoCompatibleProviderFoundExcepti
                                                           expectedVersion,
                                                           mockDiscovery,
                                                           discoveryQos,
-                                                          move(keywordArbitrationStrategyFunction));
+                                                          move(keywordArbitrationStrategyFunction),
+                                                          singleThreadedIOService->getIOService());
 
     // Create a list of discovery entries with the correct keyword
     std::vector<types::CustomParameter> parameterList;
@@ -845,7 +871,8 @@ TEST_F(ArbitratorTest, getFixedParticipantProviderReturnsNoCompatibleProviderFou
                                          expectedVersion,
                                          mockDiscovery,
                                          discoveryQos,
-                                         move(fixedParticipantArbitrationStrategyFunction));
+                                         move(fixedParticipantArbitrationStrategyFunction),
+                                         singleThreadedIOService->getIOService());
 
     // Create a discovery entries with the correct participantId
     std::vector<types::CustomParameter> parameterList;
@@ -917,7 +944,8 @@ TEST_F(ArbitratorTest, getDefaultReturnsNoCompatibleProviderFoundException)
                                          expectedVersion,
                                          mockDiscovery,
                                          discoveryQos,
-                                         move(lastSeenArbitrationStrategyFunction));
+                                         move(lastSeenArbitrationStrategyFunction),
+                                         singleThreadedIOService->getIOService());
 
     // Create a list of discovery entries
     types::ProviderQos providerQos(
@@ -1052,8 +1080,12 @@ TEST_P(ArbitratorTestWithParams, exceptionFromDiscoveryProxy)
                 .WillRepeatedly(Return(mockFuture2));
     }
 
-    auto arbitrator = ArbitratorFactory::createArbitrator(
-            domain, interfaceName, version, mockDiscovery, discoveryQos);
+    auto arbitrator = ArbitratorFactory::createArbitrator(domain,
+                                                          interfaceName,
+                                                          version,
+                                                          mockDiscovery,
+                                                          discoveryQos,
+                                                          singleThreadedIOService->getIOService());
 
     auto onSuccess = [](const types::DiscoveryEntryWithMetaInfo&) { FAIL(); };
 
@@ -1142,7 +1174,8 @@ TEST_F(ArbitratorTest, getHighestPriorityReturnsExceptionEmptyResult)
                                                       expectedVersion,
                                                       mockDiscovery,
                                                       discoveryQos,
-                                                      move(qosArbitrationStrategyFunction));
+                                                      move(qosArbitrationStrategyFunction),
+                                                      singleThreadedIOService->getIOService());
 
     testExceptionEmptyResult(qosArbitrator, discoveryQos);
 }
@@ -1163,7 +1196,8 @@ TEST_F(ArbitratorTest, getKeywordProviderReturnsExceptionEmptyResult)
                                                           expectedVersion,
                                                           mockDiscovery,
                                                           discoveryQos,
-                                                          move(keywordArbitrationStrategyFunction));
+                                                          move(keywordArbitrationStrategyFunction),
+                                                          singleThreadedIOService->getIOService());
 
     testExceptionEmptyResult(keywordArbitrator, discoveryQos);
 }
@@ -1183,7 +1217,8 @@ TEST_F(ArbitratorTest, getLastSeenReturnsExceptionEmptyResult)
                                          expectedVersion,
                                          mockDiscovery,
                                          discoveryQos,
-                                         move(lastSeenArbitrationStrategyFunction));
+                                         move(lastSeenArbitrationStrategyFunction),
+                                         singleThreadedIOService->getIOService());
 
     testExceptionEmptyResult(lastSeenArbitrator, discoveryQos);
 }
@@ -1224,7 +1259,8 @@ void ArbitratorTest::testArbitrationStopsOnShutdown(bool testRetry)
                                                 providerVersion,
                                                 mockDiscovery,
                                                 discoveryQos,
-                                                move(lastSeenArbitrationStrategyFunction));
+                                                move(lastSeenArbitrationStrategyFunction),
+                                                singleThreadedIOService->getIOService());
 
     auto onSuccess = [](const types::DiscoveryEntryWithMetaInfo&) { FAIL(); };
 
@@ -1265,3 +1301,145 @@ TEST_F(ArbitratorTest, arbitrationRetryStopsOnShutdown)
     const bool testRetry(true);
     testArbitrationStopsOnShutdown(testRetry);
 }
+
+TEST_F(ArbitratorTest, lookupCallbackCompletesArbitration)
+{
+    DiscoveryQos discoveryQos;
+    discoveryQos.setDiscoveryTimeoutMs(defaultDiscoveryTimeoutMs);
+    discoveryQos.setRetryIntervalMs(defaultRetryIntervalMs);
+    joynr::types::Version providerVersion(47, 11);
+    types::ProviderQos providerQos;
+    std::vector<joynr::types::DiscoveryEntryWithMetaInfo> discoveryEntries;
+    discoveryEntries.push_back(joynr::types::DiscoveryEntryWithMetaInfo(providerVersion,
+                                                                        domain,
+                                                                        interfaceName,
+                                                                        "testParticipantId",
+                                                                        providerQos,
+                                                                        lastSeenDateMs,
+                                                                        expiryDateMs,
+                                                                        publicKeyId,
+                                                                        true));
+
+    // the result is only reported via the callback, the returned future stays in progress
+    std::thread discoveryThread;
+    EXPECT_CALL(*mockDiscovery, lookupAsyncMock(_, _, _, _, _, _))
+            .WillOnce(Invoke([&discoveryThread, &discoveryEntries](
+                    const std::vector<std::string>&,
+                    const std::string&,
+                    const joynr::types::DiscoveryQos&,
+                    std::function<void(
+                            const std::vector<joynr::types::DiscoveryEntryWithMetaInfo>& result)>
+                            onSuccess,
+                    std::function<void(const exceptions::JoynrRuntimeException&)>,
+                    boost::optional<joynr::MessagingQos>) {
+                discoveryThread = std::thread([onSuccess, &discoveryEntries]() {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    onSuccess(discoveryEntries);
+                });
+                return std::make_shared<
+                        joynr::Future<std::vector<joynr::types::DiscoveryEntryWithMetaInfo>>>();
+            }));
+
+    auto arbitrator = std::make_shared<Arbitrator>(domain,
+                                                   interfaceName,
+                                                   providerVersion,
+                                                   mockDiscovery,
+                                                   discoveryQos,
+                                                   move(lastSeenArbitrationStrategyFunction),
+                                                   singleThreadedIOService->getIOService());
+
+    auto onSuccess = [this](const types::DiscoveryEntryWithMetaInfo& discoveryEntry) {
+        EXPECT_EQ("testParticipantId", discoveryEntry.getParticipantId());
+        semaphore.notify();
+    };
+    auto onError = [](const exceptions::DiscoveryException&) { FAIL(); };
+
+    arbitrator->startArbitration(onSuccess, onError);
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(1000)));
+    arbitrator->stopArbitration();
+    discoveryThread.join();
+}
+
+/*
+ * Tests that pending lookups do not block the arbitration of other proxies:
+ * all lookups are issued by the single io_service thread before any result arrives
+ */
+TEST_F(ArbitratorTest, concurrentArbitrationsDoNotBlockEachOther)
+{
+    constexpr std::size_t numberOfArbitrators = 1000;
+    DiscoveryQos discoveryQos;
+    discoveryQos.setDiscoveryTimeoutMs(defaultDiscoveryTimeoutMs);
+    discoveryQos.setRetryIntervalMs(defaultRetryIntervalMs);
+    joynr::types::Version providerVersion(47, 11);
+    types::ProviderQos providerQos;
+    std::vector<joynr::types::DiscoveryEntryWithMetaInfo> discoveryEntries;
+    discoveryEntries.push_back(joynr::types::DiscoveryEntryWithMetaInfo(providerVersion,
+                                                                        domain,
+                                                                        interfaceName,
+                                                                        "testParticipantId",
+                                                                        providerQos,
+                                                                        lastSeenDateMs,
+                                                                        expiryDateMs,
+                                                                        publicKeyId,
+                                                                        true));
+
+    using LookupCallback =
+            std::function<void(const std::vector<joynr::types::DiscoveryEntryWithMetaInfo>&)>;
+    std::mutex pendingLookupsMutex;
+    std::vector<LookupCallback> pendingLookups;
+    Semaphore lookupIssued(0);
+    EXPECT_CALL(*mockDiscovery, lookupAsyncMock(_, _, _, _, _, _))
+            .Times(numberOfArbitrators)
+            .WillRepeatedly(Invoke([&pendingLookupsMutex, &pendingLookups, &lookupIssued](
+                    const std::vector<std::string>&,
+                    const std::string&,
+                    const joynr::types::DiscoveryQos&,
+                    LookupCallback onSuccess,
+                    std::function<void(const exceptions::JoynrRuntimeException&)>,
+                    boost::optional<joynr::MessagingQos>) {
+                {
+                    std::lock_guard<std::mutex> lock(pendingLookupsMutex);
+                    pendingLookups.push_back(std::move(onSuccess));
+                }
+                lookupIssued.notify();
+                return std::make_shared<
+                        joynr::Future<std::vector<joynr::types::DiscoveryEntryWithMetaInfo>>>();
+            }));
+
+    std::atomic<std::size_t> succeededArbitrations(0);
+    auto onSuccess = [this, &succeededArbitrations](const types::DiscoveryEntryWithMetaInfo&) {
+        if (++succeededArbitrations == numberOfArbitrators) {
+            semaphore.notify();
+        }
+    };
+    auto onError = [](const exceptions::DiscoveryException&) { FAIL(); };
+
+    std::vector<std::shared_ptr<Arbitrator>> arbitrators;
+    for (std::size_t i = 0; i < numberOfArbitrators; ++i) {
+        auto arbitrator = ArbitratorFactory::createArbitrator(
+                domain,
+                interfaceName,
+                providerVersion,
+                mockDiscovery,
+                discoveryQos,
+                singleThreadedIOService->getIOService());
+        arbitrator->startArbitration(onSuccess, onError);
+        arbitrators.push_back(std::move(arbitrator));
+    }
+
+    for (std::size_t i = 0; i < numberOfArbitrators; ++i) {
+        ASSERT_TRUE(lookupIssued.waitFor(std::chrono::milliseconds(1000)));
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingLookupsMutex);
+        for (const auto& pendingLookup : pendingLookups) {
+            pendingLookup(discoveryEntries);
+        }
+    }
+
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(1000)));
+    EXPECT_EQ(numberOfArbitrators, succeededArbitrations);
+    for (auto& arbitrator : arbitrators) {
+        arbitrator->stopArbitration();
+    }
+}
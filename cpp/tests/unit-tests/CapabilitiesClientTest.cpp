@@ -0,0 +1,328 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2017 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/MessagingQos.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/Semaphore.h"
+#include "joynr/Settings.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/types/GlobalDiscoveryEntry.h"
+#include "libjoynrclustercontroller/capabilities-client/CapabilitiesClient.h"
+
+#include "tests/JoynrTest.h"
+#include "tests/mock/MockCallback.h"
+#include "tests/mock/MockGlobalCapabilitiesDirectoryProxy.h"
+#include "tests/mock/MockJoynrRuntime.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class CapabilitiesClientTest : public ::testing::Test
+{
+public:
+    CapabilitiesClientTest()
+            : settings(),
+              clusterControllerSettings(settings),
+              singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              runtime(std::make_shared<MockJoynrRuntime>(settings)),
+              mockProxy(std::make_shared<MockGlobalCapabilitiesDirectoryProxy>(runtime)),
+              capabilitiesClient(),
+              entry1(createEntry("participantId1")),
+              entry2(createEntry("participantId2")),
+              callback1(std::make_shared<MockCallback<void>>()),
+              callback2(std::make_shared<MockCallback<void>>()),
+              semaphore(std::make_shared<Semaphore>(0))
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~CapabilitiesClientTest() override
+    {
+        capabilitiesClient.reset();
+        singleThreadedIOService->stop();
+    }
+
+protected:
+    void createCapabilitiesClient(std::chrono::milliseconds batchWindowMs)
+    {
+        clusterControllerSettings.setCapabilitiesClientBatchWindowMs(batchWindowMs);
+        capabilitiesClient = std::make_shared<CapabilitiesClient>(
+                clusterControllerSettings, singleThreadedIOService->getIOService());
+        capabilitiesClient->setProxy(mockProxy, MessagingQos());
+    }
+
+    void add(const types::GlobalDiscoveryEntry& entry, std::shared_ptr<MockCallback<void>> callback)
+    {
+        capabilitiesClient->add(
+                entry,
+                [callback]() { callback->onSuccess(); },
+                [callback](const exceptions::JoynrRuntimeException& error) {
+                    callback->onError(error);
+                });
+    }
+
+    static types::GlobalDiscoveryEntry createEntry(const std::string& participantId)
+    {
+        types::GlobalDiscoveryEntry entry;
+        entry.setParticipantId(participantId);
+        return entry;
+    }
+
+    const std::chrono::milliseconds batchWindow = std::chrono::milliseconds(100);
+    Settings settings;
+    ClusterControllerSettings clusterControllerSettings;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    std::shared_ptr<MockJoynrRuntime> runtime;
+    std::shared_ptr<MockGlobalCapabilitiesDirectoryProxy> mockProxy;
+    std::shared_ptr<CapabilitiesClient> capabilitiesClient;
+    const types::GlobalDiscoveryEntry entry1;
+    const types::GlobalDiscoveryEntry entry2;
+    std::shared_ptr<MockCallback<void>> callback1;
+    std::shared_ptr<MockCallback<void>> callback2;
+    std::shared_ptr<Semaphore> semaphore;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(CapabilitiesClientTest);
+};
+
+TEST_F(CapabilitiesClientTest, addsWithinBatchWindowAreSentInOneCall)
+{
+    createCapabilitiesClient(batchWindow);
+    EXPECT_CALL(*mockProxy, addAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, addListAsyncMock(ElementsAre(entry1, entry2), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    EXPECT_CALL(*callback1, onSuccess());
+    EXPECT_CALL(*callback2, onSuccess()).WillOnce(ReleaseSemaphore(semaphore));
+
+    add(entry1, callback1);
+    add(entry2, callback2);
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, singleAddWithinBatchWindowIsSentWithoutList)
+{
+    createCapabilitiesClient(batchWindow);
+    EXPECT_CALL(*mockProxy, addListAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    EXPECT_CALL(*callback1, onSuccess()).WillOnce(ReleaseSemaphore(semaphore));
+
+    add(entry1, callback1);
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, removesAreSentBeforeAdds)
+{
+    createCapabilitiesClient(batchWindow);
+    {
+        InSequence inSequence;
+        EXPECT_CALL(*mockProxy,
+                    removeListAsyncMock(
+                            ElementsAre(std::string("participantId3"), std::string("participantId4")),
+                            _,
+                            _,
+                            _)).WillOnce(Return(nullptr));
+        EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _))
+                .WillOnce(DoAll(ReleaseSemaphore(semaphore), Return(nullptr)));
+    }
+
+    add(entry1, callback1);
+    capabilitiesClient->remove("participantId3");
+    capabilitiesClient->remove("participantId4");
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, addSupersedesQueuedRemoveOfSameParticipant)
+{
+    createCapabilitiesClient(batchWindow);
+    EXPECT_CALL(*mockProxy, removeAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, removeListAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _))
+            .WillOnce(DoAll(ReleaseSemaphore(semaphore), Return(nullptr)));
+
+    capabilitiesClient->remove(entry1.getParticipantId());
+    add(entry1, callback1);
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, removeSupersedesQueuedAddOfSameParticipant)
+{
+    createCapabilitiesClient(batchWindow);
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry2), _, _, _)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*mockProxy, addListAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(entry1.getParticipantId()), _, _, _))
+            .WillOnce(DoAll(ReleaseSemaphore(semaphore), Return(nullptr)));
+    EXPECT_CALL(*callback1, onSuccess()).Times(0);
+    EXPECT_CALL(*callback1, onError(_));
+
+    add(entry1, callback1);
+    add(entry2, callback2);
+    capabilitiesClient->remove(entry1.getParticipantId());
+    // the superseded add is reported before the remove is sent
+    Mock::VerifyAndClearExpectations(callback1.get());
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, batchRejectedByDirectoryIsRetriedOneByOne)
+{
+    createCapabilitiesClient(batchWindow);
+    EXPECT_CALL(*mockProxy, addListAsyncMock(ElementsAre(entry1, entry2), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(
+                                    exceptions::ProviderRuntimeException("invalid entry")),
+                            Return(nullptr)));
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry2), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(
+                                    exceptions::ProviderRuntimeException("invalid entry")),
+                            Return(nullptr)));
+    EXPECT_CALL(*callback1, onSuccess());
+    EXPECT_CALL(*callback1, onError(_)).Times(0);
+    EXPECT_CALL(*callback2, onSuccess()).Times(0);
+    EXPECT_CALL(*callback2, onError(_)).WillOnce(ReleaseSemaphore(semaphore));
+
+    add(entry1, callback1);
+    add(entry2, callback2);
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, otherBatchErrorIsReportedToEveryAdd)
+{
+    createCapabilitiesClient(batchWindow);
+    EXPECT_CALL(*mockProxy, addListAsyncMock(ElementsAre(entry1, entry2), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<2>(exceptions::JoynrTimeOutException("timeout")),
+                            Return(nullptr)));
+    EXPECT_CALL(*mockProxy, addAsyncMock(_, _, _, _)).Times(0);
+    EXPECT_CALL(*callback1, onError(_));
+    EXPECT_CALL(*callback2, onError(_)).WillOnce(ReleaseSemaphore(semaphore));
+
+    add(entry1, callback1);
+    add(entry2, callback2);
+
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(1)));
+}
+
+TEST_F(CapabilitiesClientTest, zeroBatchWindowSendsImmediately)
+{
+    createCapabilitiesClient(std::chrono::milliseconds(0));
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry2), _, _, _))
+            .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(entry1.getParticipantId()), _, _, _))
+            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*callback1, onSuccess());
+    EXPECT_CALL(*callback2, onSuccess());
+
+    add(entry1, callback1);
+    add(entry2, callback2);
+    capabilitiesClient->remove(entry1.getParticipantId());
+
+    // all calls reached the proxy on the calling thread
+    Mock::VerifyAndClearExpectations(mockProxy.get());
+    Mock::VerifyAndClearExpectations(callback1.get());
+    Mock::VerifyAndClearExpectations(callback2.get());
+}
+
+TEST_F(CapabilitiesClientTest, queuedRequestsAreSentOnShutdown)
+{
+    createCapabilitiesClient(std::chrono::milliseconds(10000));
+    {
+        InSequence inSequence;
+        EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(std::string("participantId3")), _, _, _))
+                .WillOnce(Return(nullptr));
+        EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _))
+                .WillOnce(DoAll(InvokeArgument<1>(), Return(nullptr)));
+    }
+    EXPECT_CALL(*callback1, onSuccess());
+
+    add(entry1, callback1);
+    capabilitiesClient->remove("participantId3");
+    capabilitiesClient->shutdown();
+
+    // the queued requests reached the proxy before the batch window elapsed
+    Mock::VerifyAndClearExpectations(mockProxy.get());
+    Mock::VerifyAndClearExpectations(callback1.get());
+}
+
+TEST_F(CapabilitiesClientTest, queuedRequestsAreSentOnDestruction)
+{
+    createCapabilitiesClient(std::chrono::milliseconds(10000));
+    EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(entry2.getParticipantId()), _, _, _))
+            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _)).WillOnce(Return(nullptr));
+
+    add(entry1, callback1);
+    capabilitiesClient->remove(entry2.getParticipantId());
+    capabilitiesClient.reset();
+
+    Mock::VerifyAndClearExpectations(mockProxy.get());
+}
+
+TEST_F(CapabilitiesClientTest, requestsAfterShutdownAreSentImmediately)
+{
+    createCapabilitiesClient(std::chrono::milliseconds(10000));
+    capabilitiesClient->shutdown();
+    EXPECT_CALL(*mockProxy, addAsyncMock(Eq(entry1), _, _, _)).WillOnce(Return(nullptr));
+    EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(entry2.getParticipantId()), _, _, _))
+            .WillOnce(Return(nullptr));
+
+    add(entry1, callback1);
+    capabilitiesClient->remove(entry2.getParticipantId());
+
+    Mock::VerifyAndClearExpectations(mockProxy.get());
+}
+
+TEST_F(CapabilitiesClientTest, addListSupersedesQueuedRemoveOfSameParticipant)
+{
+    createCapabilitiesClient(std::chrono::milliseconds(10000));
+    {
+        InSequence inSequence;
+        // the queued remove of another participant is sent first, not overtaken by the list
+        EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(std::string("participantId3")), _, _, _))
+                .WillOnce(Return(nullptr));
+        EXPECT_CALL(*mockProxy, addListAsyncMock(ElementsAre(entry1, entry2), _, _, _))
+                .WillOnce(Return(nullptr));
+    }
+    EXPECT_CALL(*mockProxy, removeAsyncMock(Eq(entry1.getParticipantId()), _, _, _)).Times(0);
+    EXPECT_CALL(*mockProxy, removeListAsyncMock(_, _, _, _)).Times(0);
+
+    capabilitiesClient->remove(entry1.getParticipantId());
+    capabilitiesClient->remove("participantId3");
+    capabilitiesClient->add(
+            std::vector<types::GlobalDiscoveryEntry>{entry1, entry2}, nullptr, nullptr);
+
+    Mock::VerifyAndClearExpectations(mockProxy.get());
+}
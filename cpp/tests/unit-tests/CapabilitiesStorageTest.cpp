@@ -82,6 +82,19 @@ TYPED_TEST(CapabilitiesStorageTest, insertThenLookup)
     EXPECT_EQ(this->entry, *optionalEntry);
 }
 
+TYPED_TEST(CapabilitiesStorageTest, findByParticipantIdDoesNotCopyEntry)
+{
+    TypeParam storage;
+    EXPECT_EQ(nullptr, storage.findByParticipantId(this->participantId));
+
+    storage.insert(this->entry);
+    const types::DiscoveryEntry* foundEntry = storage.findByParticipantId(this->participantId);
+    ASSERT_NE(nullptr, foundEntry);
+    EXPECT_EQ(foundEntry, storage.findByParticipantId(this->participantId));
+    EXPECT_EQ(this->participantId, foundEntry->getParticipantId());
+    EXPECT_EQ(this->domain, foundEntry->getDomain());
+}
+
 TYPED_TEST(CapabilitiesStorageTest, lookupNonExistingParticipantId)
 {
     const std::string nonExistingParticipantId = "non-existing";
@@ -144,3 +157,38 @@ TYPED_TEST(CapabilitiesStorageTest, removeExpiredEntries)
     EXPECT_THAT(removedEntries, Contains(entry1));
     EXPECT_THAT(removedEntries, Not(Contains(entry2)));
 }
+
+TYPED_TEST(CapabilitiesStorageTest, hasExpiredOnlyIfAnEntryExpired)
+{
+    TypeParam storage;
+    EXPECT_FALSE(storage.hasExpired());
+
+    auto now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::system_clock::now().time_since_epoch()).count();
+    joynr::types::DiscoveryEntry entry1(this->version,
+                                        this->domain,
+                                        "interface1",
+                                        "participantId1",
+                                        types::ProviderQos(),
+                                        0,
+                                        now + 100,
+                                        "publicKeyId");
+    joynr::types::DiscoveryEntry entry2(this->version,
+                                        this->domain,
+                                        "interface2",
+                                        "participantId2",
+                                        types::ProviderQos(),
+                                        0,
+                                        now + 10000,
+                                        "publicKeyId");
+    storage.insert(entry1);
+    storage.insert(entry2);
+    EXPECT_FALSE(storage.hasExpired());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_TRUE(storage.hasExpired());
+
+    storage.removeExpired();
+    EXPECT_FALSE(storage.hasExpired());
+    EXPECT_EQ(1, storage.size());
+}
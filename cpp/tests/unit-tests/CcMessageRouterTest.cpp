@@ -33,6 +33,7 @@
 #include "joynr/MessagingStubFactory.h"
 #include "joynr/MqttMulticastAddressCalculator.h"
 #include "joynr/MulticastMessagingSkeletonDirectory.h"
+#include "joynr/RoutingTableJournal.h"
 #include "joynr/Semaphore.h"
 #include "joynr/SingleThreadedIOService.h"
 #include "joynr/WebSocketMulticastAddressCalculator.h"
@@ -514,6 +515,7 @@ TEST_F(CcMessageRouterTest, doNotSaveInProcessMessagingAddressToFile)
     const std::string providerParticipantId("providerParticipantId");
     const std::string routingTablePersistenceFilename = "test-RoutingTable.persist";
     std::remove(routingTablePersistenceFilename.c_str());
+    std::remove(RoutingTableJournal::getJournalFileName(routingTablePersistenceFilename).c_str());
 
     messageRouter->loadRoutingTable(routingTablePersistenceFilename);
     {
@@ -549,6 +551,7 @@ TEST_F(CcMessageRouterTest, routingTableGetsCleaned)
     const std::string providerParticipantId("providerParticipantId");
     const std::string routingTablePersistenceFilename = "test-RoutingTable.persist";
     std::remove(routingTablePersistenceFilename.c_str());
+    std::remove(RoutingTableJournal::getJournalFileName(routingTablePersistenceFilename).c_str());
 
     auto dispatcher = std::make_shared<MockDispatcher>();
     auto skeleton = std::make_shared<MockInProcessMessagingSkeleton>(dispatcher);
@@ -23,6 +23,7 @@
 
 #include "joynr/Settings.h"
 #include "joynr/ClusterControllerSettings.h"
+#include "joynr/exceptions/JoynrException.h"
 
 using namespace joynr;
 
@@ -181,6 +182,50 @@ TEST(ClusterControllerSettingsTest, defaultTransportNotAvailableQueueLimitBytesI
               ClusterControllerSettings::DEFAULT_TRANSPORT_NOT_AVAILABLE_QUEUE_LIMIT_BYTES());
 }
 
+TEST(ClusterControllerSettingsTest, defaultMessageQueueOverflowSettingsAreSet)
+{
+    Settings settings;
+    ClusterControllerSettings clusterControllerSettings(settings);
+
+    EXPECT_EQ(clusterControllerSettings.isMessageQueueOverflowEnabled(),
+              ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_ENABLED());
+    EXPECT_EQ(clusterControllerSettings.getMessageQueueOverflowDirectory(),
+              ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_DIRECTORY());
+    EXPECT_EQ(clusterControllerSettings.getMessageQueueOverflowLimitBytes(),
+              ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_LIMIT_BYTES());
+    EXPECT_EQ(clusterControllerSettings.getMessageQueueOverflowSegmentSizeBytes(),
+              ClusterControllerSettings::DEFAULT_MESSAGE_QUEUE_OVERFLOW_SEGMENT_SIZE_BYTES());
+}
+
+TEST(ClusterControllerSettingsTest, messageQueueOverflowWithoutLimitBytesIsRejected)
+{
+    Settings settings;
+    settings.set(ClusterControllerSettings::SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED(), true);
+    settings.set(ClusterControllerSettings::SETTING_MESSAGE_QUEUE_LIMIT_BYTES(), 0);
+
+    EXPECT_THROW(ClusterControllerSettings clusterControllerSettings(settings),
+                 exceptions::JoynrConfigurationException);
+}
+
+TEST(ClusterControllerSettingsTest, messageQueueOverflowWithLimitBytesIsAccepted)
+{
+    Settings settings;
+    settings.set(ClusterControllerSettings::SETTING_MESSAGE_QUEUE_OVERFLOW_ENABLED(), true);
+    settings.set(ClusterControllerSettings::SETTING_MESSAGE_QUEUE_LIMIT_BYTES(), 1024);
+
+    ClusterControllerSettings clusterControllerSettings(settings);
+    EXPECT_TRUE(clusterControllerSettings.isMessageQueueOverflowEnabled());
+}
+
+TEST(ClusterControllerSettingsTest, defaultMqttNumberOfConnectionsIsSet)
+{
+    Settings settings;
+    ClusterControllerSettings clusterControllerSettings(settings);
+
+    EXPECT_EQ(clusterControllerSettings.getMqttNumberOfConnections(),
+              ClusterControllerSettings::DEFAULT_MQTT_NUMBER_OF_CONNECTIONS());
+}
+
 TEST(ClusterControllerSettingsTest,
      defaultGlobalCapabilitiesDirectoryCompressedMessagesEnabledIsSet)
 {
@@ -0,0 +1,91 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "libjoynrclustercontroller/access-control/ConsumerPermissionCache.h"
+
+using namespace joynr;
+using namespace joynr::infrastructure::DacTypes;
+
+TEST(ConsumerPermissionCacheTest, lookupReturnsInsertedDecision)
+{
+    ConsumerPermissionCache cache(10);
+    EXPECT_FALSE(cache.lookup("user", "participant", TrustLevel::HIGH));
+
+    cache.insert("user", "participant", TrustLevel::HIGH, false, cache.getGeneration());
+
+    auto cachedPermission = cache.lookup("user", "participant", TrustLevel::HIGH);
+    ASSERT_TRUE(cachedPermission);
+    EXPECT_FALSE(*cachedPermission);
+    EXPECT_FALSE(cache.lookup("otherUser", "participant", TrustLevel::HIGH));
+    EXPECT_FALSE(cache.lookup("user", "participant", TrustLevel::LOW));
+}
+
+TEST(ConsumerPermissionCacheTest, leastRecentlyUsedDecisionIsEvicted)
+{
+    ConsumerPermissionCache cache(2);
+    cache.insert("user", "participant1", TrustLevel::HIGH, true, cache.getGeneration());
+    cache.insert("user", "participant2", TrustLevel::HIGH, true, cache.getGeneration());
+    EXPECT_TRUE(cache.lookup("user", "participant1", TrustLevel::HIGH));
+
+    cache.insert("user", "participant3", TrustLevel::HIGH, true, cache.getGeneration());
+
+    EXPECT_EQ(2, cache.size());
+    EXPECT_TRUE(cache.lookup("user", "participant1", TrustLevel::HIGH));
+    EXPECT_FALSE(cache.lookup("user", "participant2", TrustLevel::HIGH));
+    EXPECT_TRUE(cache.lookup("user", "participant3", TrustLevel::HIGH));
+}
+
+TEST(ConsumerPermissionCacheTest, invalidateForParticipantKeepsOtherDecisions)
+{
+    ConsumerPermissionCache cache(10);
+    cache.insert("user1", "participant1", TrustLevel::HIGH, true, cache.getGeneration());
+    cache.insert("user2", "participant1", TrustLevel::HIGH, true, cache.getGeneration());
+    cache.insert("user1", "participant2", TrustLevel::HIGH, true, cache.getGeneration());
+
+    cache.invalidate("participant1");
+
+    EXPECT_EQ(1, cache.size());
+    EXPECT_TRUE(cache.lookup("user1", "participant2", TrustLevel::HIGH));
+
+    cache.invalidate();
+    EXPECT_EQ(0, cache.size());
+}
+
+TEST(ConsumerPermissionCacheTest, decisionOfOutdatedGenerationIsNotInserted)
+{
+    ConsumerPermissionCache cache(10);
+    const std::uint64_t generation = cache.getGeneration();
+
+    cache.invalidate();
+    cache.insert("user", "participant", TrustLevel::HIGH, true, generation);
+
+    EXPECT_FALSE(cache.lookup("user", "participant", TrustLevel::HIGH));
+}
+
+TEST(ConsumerPermissionCacheTest, cacheOfSizeZeroIsDisabled)
+{
+    ConsumerPermissionCache cache(0);
+    cache.insert("user", "participant", TrustLevel::HIGH, true, cache.getGeneration());
+
+    EXPECT_EQ(0, cache.size());
+    EXPECT_FALSE(cache.lookup("user", "participant", TrustLevel::HIGH));
+}
@@ -0,0 +1,318 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+#include <gtest/gtest.h>
+
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "libjoynrclustercontroller/httpnetworking/CurlMultiHttpClient.h"
+#include "libjoynrclustercontroller/httpnetworking/HttpResult.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+namespace
+{
+
+/**
+ * Minimal local stand-in for the http bounceproxy: answers every POST with 201 and keeps
+ * the connection alive
+ */
+class HttpServerStandIn
+{
+public:
+    HttpServerStandIn()
+            : ioService(),
+              work(ioService),
+              acceptor(ioService,
+                       boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+              thread(),
+              acceptedConnections(0),
+              receivedRequests(0)
+    {
+        accept();
+        thread = std::thread([this]() { ioService.run(); });
+    }
+
+    ~HttpServerStandIn()
+    {
+        ioService.stop();
+        thread.join();
+    }
+
+    std::string getUrl() const
+    {
+        return "http://127.0.0.1:" + std::to_string(acceptor.local_endpoint().port()) +
+               "/message/";
+    }
+
+    std::size_t getAcceptedConnections() const
+    {
+        return acceptedConnections;
+    }
+
+    std::size_t getReceivedRequests() const
+    {
+        return receivedRequests;
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(HttpServerStandIn);
+
+    struct Connection
+    {
+        explicit Connection(boost::asio::io_service& ioService) : socket(ioService), buffer()
+        {
+        }
+        boost::asio::ip::tcp::socket socket;
+        boost::asio::streambuf buffer;
+    };
+
+    void accept()
+    {
+        auto connection = std::make_shared<Connection>(ioService);
+        acceptor.async_accept(
+                connection->socket, [this, connection](const boost::system::error_code& error) {
+                    if (!error) {
+                        ++acceptedConnections;
+                        readRequest(connection);
+                    }
+                    accept();
+                });
+    }
+
+    void readRequest(std::shared_ptr<Connection> connection)
+    {
+        boost::asio::async_read_until(
+                connection->socket,
+                connection->buffer,
+                "\r\n\r\n",
+                [this, connection](const boost::system::error_code& error, std::size_t length) {
+                    if (error) {
+                        return;
+                    }
+                    const std::string header(
+                            boost::asio::buffers_begin(connection->buffer.data()),
+                            boost::asio::buffers_begin(connection->buffer.data()) + length);
+                    connection->buffer.consume(length);
+                    readContent(connection, getContentLength(header));
+                });
+    }
+
+    void readContent(std::shared_ptr<Connection> connection, std::size_t contentLength)
+    {
+        const std::size_t buffered = connection->buffer.size();
+        const std::size_t missing = contentLength > buffered ? contentLength - buffered : 0;
+        boost::asio::async_read(
+                connection->socket,
+                connection->buffer,
+                boost::asio::transfer_exactly(missing),
+                [this, connection, contentLength](const boost::system::error_code& error,
+                                                  std::size_t) {
+                    if (error) {
+                        return;
+                    }
+                    connection->buffer.consume(contentLength);
+                    ++receivedRequests;
+                    static const std::string response(
+                            "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n");
+                    boost::asio::async_write(
+                            connection->socket,
+                            boost::asio::buffer(response),
+                            [this, connection](const boost::system::error_code& error,
+                                               std::size_t) {
+                                if (!error) {
+                                    readRequest(connection);
+                                }
+                            });
+                });
+    }
+
+    static std::size_t getContentLength(const std::string& header)
+    {
+        static const std::string contentLengthField("\r\ncontent-length:");
+        auto it = std::search(header.cbegin(),
+                              header.cend(),
+                              contentLengthField.cbegin(),
+                              contentLengthField.cend(),
+                              [](char a, char b) { return std::tolower(a) == b; });
+        if (it == header.cend()) {
+            return 0;
+        }
+        return std::stoul(std::string(it + contentLengthField.size(), header.cend()));
+    }
+
+    boost::asio::io_service ioService;
+    boost::asio::io_service::work work;
+    boost::asio::ip::tcp::acceptor acceptor;
+    std::thread thread;
+    std::atomic<std::size_t> acceptedConnections;
+    std::atomic<std::size_t> receivedRequests;
+};
+
+} // namespace
+
+class CurlMultiHttpClientTest : public TestWithParam<std::size_t>
+{
+public:
+    CurlMultiHttpClientTest()
+            : server(), singleThreadedIOService(std::make_shared<SingleThreadedIOService>())
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~CurlMultiHttpClientTest() override
+    {
+        singleThreadedIOService->stop();
+    }
+
+protected:
+    std::shared_ptr<CurlMultiHttpClient> createClient(std::size_t maxConnectionsPerHost)
+    {
+        return std::make_shared<CurlMultiHttpClient>(
+                singleThreadedIOService->getIOService(), maxConnectionsPerHost);
+    }
+
+    // posts the requests at once and returns how many were answered with 201
+    std::size_t postConcurrently(CurlMultiHttpClient& client, std::size_t numberOfRequests)
+    {
+        const std::string content(1024, 'x');
+        Semaphore allCompleted(0);
+        std::atomic<std::size_t> created(0);
+        std::atomic<std::size_t> completed(0);
+        for (std::size_t i = 0; i < numberOfRequests; ++i) {
+            client.post(server.getUrl(),
+                        content,
+                        "application/json",
+                        std::chrono::milliseconds(10000),
+                        [&](const HttpResult& result) {
+                            if (result.getStatusCode() == 201) {
+                                ++created;
+                            }
+                            if (++completed == numberOfRequests) {
+                                allCompleted.notify();
+                            }
+                        });
+        }
+        EXPECT_TRUE(allCompleted.waitFor(std::chrono::milliseconds(20000)));
+        return created;
+    }
+
+    HttpServerStandIn server;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(CurlMultiHttpClientTest);
+};
+
+TEST_F(CurlMultiHttpClientTest, postReportsStatusCode)
+{
+    auto client = createClient(1);
+    Semaphore completed(0);
+    std::int64_t statusCode = 0;
+    bool isCurlError = true;
+
+    client->post(server.getUrl(),
+                 "content",
+                 "application/json",
+                 std::chrono::milliseconds(1000),
+                 [&](const HttpResult& result) {
+                     statusCode = result.getStatusCode();
+                     isCurlError = result.isCurlError();
+                     completed.notify();
+                 });
+
+    ASSERT_TRUE(completed.waitFor(std::chrono::milliseconds(2000)));
+    EXPECT_FALSE(isCurlError);
+    EXPECT_EQ(201, statusCode);
+    EXPECT_EQ(1, server.getReceivedRequests());
+    client->shutdown();
+}
+
+TEST_F(CurlMultiHttpClientTest, unreachableHostReportsCurlError)
+{
+    auto client = createClient(1);
+    Semaphore completed(0);
+    bool isCurlError = false;
+
+    client->post("http://127.0.0.1:1/message/",
+                 "content",
+                 "application/json",
+                 std::chrono::milliseconds(1000),
+                 [&](const HttpResult& result) {
+                     isCurlError = result.isCurlError();
+                     completed.notify();
+                 });
+
+    ASSERT_TRUE(completed.waitFor(std::chrono::milliseconds(2000)));
+    EXPECT_TRUE(isCurlError);
+    client->shutdown();
+}
+
+TEST_F(CurlMultiHttpClientTest, shutdownWithoutRequests)
+{
+    auto client = createClient(0);
+    client->shutdown();
+}
+
+TEST_P(CurlMultiHttpClientTest, concurrentPostsReuseConnections)
+{
+    const std::size_t maxConnectionsPerHost = GetParam();
+    const std::size_t numberOfRequests = 500;
+    auto client = createClient(maxConnectionsPerHost);
+
+    EXPECT_EQ(numberOfRequests, postConcurrently(*client, numberOfRequests));
+    EXPECT_EQ(numberOfRequests, server.getReceivedRequests());
+    EXPECT_LE(server.getAcceptedConnections(), maxConnectionsPerHost);
+    client->shutdown();
+}
+
+TEST_P(CurlMultiHttpClientTest, connectionsAreKeptOpenBetweenBursts)
+{
+    const std::size_t maxConnectionsPerHost = GetParam();
+    const std::size_t numberOfRequests = 200;
+    auto client = createClient(maxConnectionsPerHost);
+
+    for (int burst = 0; burst < 3; ++burst) {
+        EXPECT_EQ(numberOfRequests, postConcurrently(*client, numberOfRequests));
+    }
+    EXPECT_LE(server.getAcceptedConnections(), maxConnectionsPerHost);
+    client->shutdown();
+}
+
+INSTANTIATE_TEST_CASE_P(SingleAndMultipleConnections,
+                        CurlMultiHttpClientTest,
+                        Values(std::size_t(1), std::size_t(4), std::size_t(16)));
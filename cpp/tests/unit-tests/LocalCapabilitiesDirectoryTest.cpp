@@ -2009,7 +2009,9 @@ public:
         auto localDomainAccessController =
                 std::make_shared<joynr::LocalDomainAccessController>(localDomainAccessStore, true);
         accessController = std::make_shared<joynr::AccessController>(
-                localCapabilitiesDirectory, localDomainAccessController);
+                localCapabilitiesDirectory,
+                localDomainAccessController,
+                clusterControllerSettings.getConsumerPermissionCacheSize());
         localCapabilitiesDirectory->setAccessController(util::as_weak_ptr(accessController));
 
         localDomainAccessStore->logContent();
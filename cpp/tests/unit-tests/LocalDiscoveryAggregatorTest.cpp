@@ -21,6 +21,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -29,8 +30,11 @@
 
 #include "joynr/Future.h"
 #include "joynr/Semaphore.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/types/DiscoveryEntry.h"
 #include "joynr/types/DiscoveryEntryWithMetaInfo.h"
 #include "joynr/types/DiscoveryQos.h"
+#include "joynr/types/DiscoveryScope.h"
 
 #include "tests/mock/MockDiscovery.h"
 
@@ -109,10 +113,8 @@ TEST_F(LocalDiscoveryAggregatorTest, lookupAsyncDomainInterface_callsProxy)
     const std::string interfaceName("testInterfaceName");
     types::DiscoveryQos discoveryQos;
     discoveryQos.setDiscoveryTimeout(42421);
-    EXPECT_CALL(
-            *discoveryMock,
-            lookupAsyncMock(
-                    Eq(domains), Eq(interfaceName), Eq(discoveryQos), Eq(nullptr), Eq(nullptr), _));
+    EXPECT_CALL(*discoveryMock,
+                lookupAsyncMock(Eq(domains), Eq(interfaceName), Eq(discoveryQos), _, _, _));
     localDiscoveryAggregator.lookupAsync(domains, interfaceName, discoveryQos, nullptr, nullptr);
 }
 
@@ -162,3 +164,240 @@ TEST_F(LocalDiscoveryAggregatorTest, lookupAsyncParticipantId_provisionedEntry_d
 
     EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
 }
+
+class LocalDiscoveryAggregatorLookupCacheTest : public LocalDiscoveryAggregatorTest
+{
+public:
+    LocalDiscoveryAggregatorLookupCacheTest()
+            : domains{"testDomain"}, interfaceName("testInterfaceName"), discoveryQos(), result()
+    {
+        discoveryQos.setCacheMaxAge(60000);
+        discoveryQos.setDiscoveryScope(types::DiscoveryScope::LOCAL_THEN_GLOBAL);
+        types::DiscoveryEntryWithMetaInfo discoveryEntry;
+        discoveryEntry.setDomain(domains.front());
+        discoveryEntry.setInterfaceName(interfaceName);
+        discoveryEntry.setParticipantId("testParticipantId");
+        result.push_back(discoveryEntry);
+        localDiscoveryAggregator.setDiscoveryProxy(discoveryMock);
+    }
+
+protected:
+    std::vector<types::DiscoveryEntryWithMetaInfo> lookup()
+    {
+        auto future = localDiscoveryAggregator.lookupAsync(
+                domains, interfaceName, discoveryQos, nullptr, nullptr);
+        std::vector<types::DiscoveryEntryWithMetaInfo> lookupResult;
+        future->get(100, lookupResult);
+        return lookupResult;
+    }
+
+    using OnLookupSuccess =
+            std::function<void(const std::vector<types::DiscoveryEntryWithMetaInfo>&)>;
+    using OnError = std::function<void(const exceptions::JoynrRuntimeException&)>;
+
+    types::DiscoveryEntry createDiscoveryEntry() const
+    {
+        types::DiscoveryEntry discoveryEntry;
+        discoveryEntry.setDomain(domains.front());
+        discoveryEntry.setInterfaceName(interfaceName);
+        discoveryEntry.setParticipantId("newParticipantId");
+        return discoveryEntry;
+    }
+
+    const std::vector<std::string> domains;
+    const std::string interfaceName;
+    types::DiscoveryQos discoveryQos;
+    std::vector<types::DiscoveryEntryWithMetaInfo> result;
+};
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, resultIsCachedForCacheMaxAge)
+{
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .WillOnce(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    EXPECT_EQ(result, lookup());
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, cacheIsNotUsedWithoutCacheMaxAge)
+{
+    discoveryQos.setCacheMaxAge(0);
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    EXPECT_EQ(result, lookup());
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, concurrentLookupsAreCoalesced)
+{
+    using OnSuccess = std::function<void(const std::vector<types::DiscoveryEntryWithMetaInfo>&)>;
+    OnSuccess onLookupSuccess;
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .WillOnce(DoAll(SaveArg<3>(&onLookupSuccess), Return(nullptr)));
+
+    Semaphore semaphore(0);
+    auto onSuccess = [this, &semaphore](
+            const std::vector<types::DiscoveryEntryWithMetaInfo>& lookupResult) {
+        EXPECT_EQ(result, lookupResult);
+        semaphore.notify();
+    };
+    auto future1 = localDiscoveryAggregator.lookupAsync(
+            domains, interfaceName, discoveryQos, onSuccess, nullptr);
+    auto future2 = localDiscoveryAggregator.lookupAsync(
+            domains, interfaceName, discoveryQos, onSuccess, nullptr);
+    ASSERT_TRUE(onLookupSuccess);
+    onLookupSuccess(result);
+
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
+    std::vector<types::DiscoveryEntryWithMetaInfo> lookupResult;
+    future1->get(100, lookupResult);
+    EXPECT_EQ(result, lookupResult);
+    future2->get(100, lookupResult);
+    EXPECT_EQ(result, lookupResult);
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, errorIsReportedToAllCoalescedLookups)
+{
+    using OnError = std::function<void(const exceptions::JoynrRuntimeException&)>;
+    OnError onLookupError;
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .WillOnce(DoAll(SaveArg<4>(&onLookupError), Return(nullptr)));
+
+    Semaphore semaphore(0);
+    auto onError = [&semaphore](const exceptions::JoynrRuntimeException&) { semaphore.notify(); };
+    localDiscoveryAggregator.lookupAsync(domains, interfaceName, discoveryQos, nullptr, onError);
+    localDiscoveryAggregator.lookupAsync(domains, interfaceName, discoveryQos, nullptr, onError);
+    ASSERT_TRUE(onLookupError);
+    onLookupError(exceptions::JoynrRuntimeException("lookup failed"));
+
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, removeAsyncInvalidatesCachedResult)
+{
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+    EXPECT_CALL(*discoveryMock, removeAsyncMock(Eq(result.front().getParticipantId()), _, _, _));
+
+    EXPECT_EQ(result, lookup());
+    localDiscoveryAggregator.removeAsync(result.front().getParticipantId(), nullptr, nullptr);
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, addAsyncInvalidatesCachedResult)
+{
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+    EXPECT_CALL(*discoveryMock, addAsyncMock(_, _, _, _, _));
+
+    types::DiscoveryEntry discoveryEntry;
+    discoveryEntry.setDomain(domains.front());
+    discoveryEntry.setInterfaceName(interfaceName);
+    discoveryEntry.setParticipantId("newParticipantId");
+
+    EXPECT_EQ(result, lookup());
+    localDiscoveryAggregator.addAsync(discoveryEntry, false, nullptr, nullptr);
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, lookupRepliedBeforeAddCompletesIsNotCached)
+{
+    OnLookupSuccess onLookupSuccess;
+    std::function<void()> onAddSuccess;
+    EXPECT_CALL(*discoveryMock, addAsyncMock(_, _, _, _, _))
+            .WillOnce(DoAll(SaveArg<2>(&onAddSuccess), Return(nullptr)));
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .WillOnce(DoAll(SaveArg<3>(&onLookupSuccess), Return(nullptr)))
+            .WillOnce(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    // the lookup is started after the add was sent, but before the CC processed it
+    localDiscoveryAggregator.addAsync(createDiscoveryEntry(), false, nullptr, nullptr);
+    auto future = localDiscoveryAggregator.lookupAsync(
+            domains, interfaceName, discoveryQos, nullptr, nullptr);
+    ASSERT_TRUE(onLookupSuccess);
+    onLookupSuccess(result);
+    ASSERT_TRUE(onAddSuccess);
+    onAddSuccess();
+
+    std::vector<types::DiscoveryEntryWithMetaInfo> lookupResult;
+    future->get(100, lookupResult);
+    EXPECT_EQ(result, lookupResult);
+    // the result might not contain the added provider and must be looked up again
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, lookupRepliedAfterAddCompletedIsNotCached)
+{
+    OnLookupSuccess onLookupSuccess;
+    std::function<void()> onAddSuccess;
+    EXPECT_CALL(*discoveryMock, addAsyncMock(_, _, _, _, _))
+            .WillOnce(DoAll(SaveArg<2>(&onAddSuccess), Return(nullptr)));
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .WillOnce(DoAll(SaveArg<3>(&onLookupSuccess), Return(nullptr)))
+            .WillOnce(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    localDiscoveryAggregator.addAsync(createDiscoveryEntry(), false, nullptr, nullptr);
+    localDiscoveryAggregator.lookupAsync(domains, interfaceName, discoveryQos, nullptr, nullptr);
+    ASSERT_TRUE(onAddSuccess);
+    onAddSuccess();
+    ASSERT_TRUE(onLookupSuccess);
+    onLookupSuccess(result);
+
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, failedRemoveInvalidatesLookupRepliedMeanwhile)
+{
+    OnLookupSuccess onLookupSuccess;
+    OnError onRemoveError;
+    EXPECT_CALL(*discoveryMock, removeAsyncMock(Eq(result.front().getParticipantId()), _, _, _))
+            .WillOnce(DoAll(SaveArg<2>(&onRemoveError), Return(nullptr)));
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .WillOnce(DoAll(SaveArg<3>(&onLookupSuccess), Return(nullptr)))
+            .WillOnce(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    Semaphore semaphore(0);
+    localDiscoveryAggregator.removeAsync(
+            result.front().getParticipantId(),
+            nullptr,
+            [&semaphore](const exceptions::JoynrRuntimeException&) { semaphore.notify(); });
+    localDiscoveryAggregator.lookupAsync(domains, interfaceName, discoveryQos, nullptr, nullptr);
+    ASSERT_TRUE(onLookupSuccess);
+    onLookupSuccess(result);
+    ASSERT_TRUE(onRemoveError);
+    onRemoveError(exceptions::JoynrRuntimeException("remove failed"));
+
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(100)));
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, localOnlyLookupIsNotCached)
+{
+    discoveryQos.setDiscoveryScope(types::DiscoveryScope::LOCAL_ONLY);
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    EXPECT_EQ(result, lookup());
+    EXPECT_EQ(result, lookup());
+}
+
+TEST_F(LocalDiscoveryAggregatorLookupCacheTest, resultWithLocalEntriesIsNotCached)
+{
+    types::DiscoveryEntryWithMetaInfo localEntry = result.front();
+    localEntry.setParticipantId("localParticipantId");
+    localEntry.setIsLocal(true);
+    result.push_back(localEntry);
+    EXPECT_CALL(*discoveryMock, lookupAsyncMock(Eq(domains), Eq(interfaceName), _, _, _, _))
+            .Times(2)
+            .WillRepeatedly(DoAll(InvokeArgument<3>(result), Return(nullptr)));
+
+    EXPECT_EQ(result, lookup());
+    EXPECT_EQ(result, lookup());
+}
@@ -168,6 +168,33 @@ TEST_F(MessageQueueTest, queueDequeueMultipleMessagesForOneParticipant)
     EXPECT_EQ(messageQueue.getQueueLength(), 0);
 }
 
+TEST_F(MessageQueueTest, takeAllForInvalidParticipantId)
+{
+    EXPECT_TRUE(messageQueue.takeAllFor("TEST").empty());
+}
+
+TEST_F(MessageQueueTest, takeAllForRemovesOnlyMessagesOfGivenParticipant)
+{
+    const std::string participantId1("participantId1");
+    const std::string participantId2("participantId2");
+    MutableMessage mutableMessage;
+    mutableMessage.setExpiryDate(expiryDate);
+    auto message = mutableMessage.getImmutableMessage();
+    const std::size_t messageSize = message->getMessageSize();
+
+    messageQueue.queueMessage(participantId1, message);
+    messageQueue.queueMessage(participantId2, message);
+    messageQueue.queueMessage(participantId1, message);
+    EXPECT_EQ(3, messageQueue.getQueueLength());
+
+    auto messages = messageQueue.takeAllFor(participantId1);
+    EXPECT_EQ(2, messages.size());
+    EXPECT_EQ(1, messageQueue.getQueueLength());
+    EXPECT_EQ(messageSize, messageQueue.getQueueSizeBytes());
+    EXPECT_TRUE(messageQueue.takeAllFor(participantId1).empty());
+    EXPECT_EQ(message, messageQueue.getNextMessageFor(participantId2));
+}
+
 TEST_F(MessageQueueTest, dequeueInvalidParticipantId)
 {
     EXPECT_EQ(messageQueue.getNextMessageFor("TEST"), nullptr);
@@ -300,8 +327,9 @@ TEST_F(MessageQueueWithLimitTest, testPerKeyQueueLimit_overallQueueIsFull)
     EXPECT_NE(nullptr, recipient1Message2);
     EXPECT_EQ(nullptr, recipient2Message1);
 
-    EXPECT_EQ(msgRecipient1Payload2, payloadAsString(recipient1Message1));
-    EXPECT_EQ(msgRecipient1Payload1, payloadAsString(recipient1Message2));
+    // messages for the same key are dequeued in the order they were queued
+    EXPECT_EQ(msgRecipient1Payload1, payloadAsString(recipient1Message1));
+    EXPECT_EQ(msgRecipient1Payload2, payloadAsString(recipient1Message2));
 }
 
 TEST_F(MessageQueueWithLimitTest, testMessageQueueLimitBytes)
@@ -369,3 +397,44 @@ TEST_F(MessageQueueWithLimitTest, testMessageQueueHandlesTooLargeMessage)
 
     EXPECT_EQ(0, queue.getQueueLength());
 }
+
+TEST_F(MessageQueueWithLimitTest, messagesOfOneKeyAreTakenInQueueOrder)
+{
+    const std::string recipient("recipient");
+    const auto now = TimePoint::now();
+    MessageQueue<std::string> queue;
+
+    // expiry dates decrease in order to ensure the queue order is not derived from them
+    constexpr int messageCount = 10;
+    for (int i = 0; i < messageCount; i++) {
+        createAndQueueMessage(queue, now + (10000 - i), recipient, std::to_string(i));
+    }
+
+    auto messages = queue.takeAllFor(recipient);
+    ASSERT_EQ(messageCount, messages.size());
+    for (int i = 0; i < messageCount; i++) {
+        EXPECT_EQ(std::to_string(i), payloadAsString(messages[i]));
+    }
+    EXPECT_EQ(0, queue.getQueueLength());
+    EXPECT_EQ(0, queue.getQueueSizeBytes());
+}
+
+TEST_F(MessageQueueWithLimitTest, messageLimitAppliesAcrossKeys)
+{
+    constexpr std::uint64_t messageQueueLimit = 3;
+    MessageQueue<std::string> queue(messageQueueLimit);
+    const auto now = TimePoint::now();
+
+    // the recipients are spread over different shards of the queue; the message
+    // with the lowest expiry date has to be removed regardless of its shard
+    createAndQueueMessage(queue, now + 400, "recipient1");
+    createAndQueueMessage(queue, now + 100, "recipient2");
+    createAndQueueMessage(queue, now + 300, "recipient3");
+    createAndQueueMessage(queue, now + 200, "recipient4");
+
+    EXPECT_EQ(messageQueueLimit, queue.getQueueLength());
+    EXPECT_EQ(nullptr, queue.getNextMessageFor("recipient2"));
+    EXPECT_EQ(1, queue.takeAllFor("recipient1").size());
+    EXPECT_EQ(1, queue.takeAllFor("recipient3").size());
+    EXPECT_EQ(1, queue.takeAllFor("recipient4").size());
+}
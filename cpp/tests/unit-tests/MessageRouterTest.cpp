@@ -25,6 +25,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 
+#include "joynr/RoutingTableJournal.h"
 #include "joynr/Semaphore.h"
 #include "joynr/InProcessMessagingAddress.h"
 #include "joynr/system/RoutingTypes/ChannelAddress.h"
@@ -361,6 +362,7 @@ TYPED_TEST(MessageRouterTest, restoreRoutingTable)
     const std::string participantId = "myParticipantId";
     const std::string routingTablePersistenceFilename = "test-RoutingTable.persist";
     std::remove(routingTablePersistenceFilename.c_str());
+    std::remove(RoutingTableJournal::getJournalFileName(routingTablePersistenceFilename).c_str());
 
     // Load and set RoutingTable persistence filename
     this->messageRouter->loadRoutingTable(routingTablePersistenceFilename);
@@ -17,6 +17,10 @@
  * #L%
  */
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "joynr/ImmutableMessage.h"
@@ -147,3 +151,85 @@ TEST_F(ImmutableMessageTest, isCompressed)
     auto immutableMessage = mutableMessage.getImmutableMessage();
     EXPECT_EQ(immutableMessage->isCompressed(), expectedValue);
 }
+
+TEST_F(ImmutableMessageTest, headerAccessorsReturnStableReferences)
+{
+    mutableMessage.setType(Message::VALUE_MESSAGE_TYPE_REQUEST());
+    auto immutableMessage = mutableMessage.getImmutableMessage();
+
+    const std::string& recipient = immutableMessage->getRecipient();
+    EXPECT_EQ(&recipient, &immutableMessage->getRecipient());
+    EXPECT_EQ(&immutableMessage->getSender(), &immutableMessage->getSender());
+
+    ImmutableMessage movedMessage(std::move(*immutableMessage));
+    EXPECT_EQ(mutableMessage.getSender(), movedMessage.getSender());
+    EXPECT_EQ(mutableMessage.getRecipient(), movedMessage.getRecipient());
+    EXPECT_EQ(mutableMessage.getId(), movedMessage.getId());
+    EXPECT_EQ(Message::VALUE_MESSAGE_TYPE_REQUEST(), movedMessage.getType());
+    EXPECT_EQ(mutableMessage.getId(), movedMessage.getHeaders().at(Message::HEADER_ID()));
+}
+
+TEST_F(ImmutableMessageTest, messageTypeIsDecoded)
+{
+    const std::vector<std::pair<std::string, MessageType>> messageTypes = {
+            {Message::VALUE_MESSAGE_TYPE_ONE_WAY(), MessageType::ONE_WAY},
+            {Message::VALUE_MESSAGE_TYPE_REPLY(), MessageType::REPLY},
+            {Message::VALUE_MESSAGE_TYPE_REQUEST(), MessageType::REQUEST},
+            {Message::VALUE_MESSAGE_TYPE_PUBLICATION(), MessageType::PUBLICATION},
+            {Message::VALUE_MESSAGE_TYPE_MULTICAST(), MessageType::MULTICAST},
+            {Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY(), MessageType::SUBSCRIPTION_REPLY},
+            {Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REQUEST(),
+             MessageType::SUBSCRIPTION_REQUEST},
+            {Message::VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST(),
+             MessageType::MULTICAST_SUBSCRIPTION_REQUEST},
+            {Message::VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST(),
+             MessageType::BROADCAST_SUBSCRIPTION_REQUEST},
+            {Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_STOP(), MessageType::SUBSCRIPTION_STOP},
+            {"unknownType", MessageType::UNKNOWN}};
+
+    for (const auto& messageType : messageTypes) {
+        mutableMessage.setType(messageType.first);
+        auto immutableMessage = mutableMessage.getImmutableMessage();
+        EXPECT_EQ(messageType.second, immutableMessage->getMessageType()) << messageType.first;
+        EXPECT_EQ(messageType.first, immutableMessage->getType());
+    }
+}
+
+TEST_F(ImmutableMessageTest, transportFrameIsCreatedOnce)
+{
+    auto immutableMessage = mutableMessage.getImmutableMessage();
+    int numberOfCreatedFrames = 0;
+    auto frameFactory = [&numberOfCreatedFrames](const smrf::ByteVector& serializedMessage) {
+        ++numberOfCreatedFrames;
+        return std::make_shared<std::string>(serializedMessage.begin(), serializedMessage.end());
+    };
+
+    std::shared_ptr<std::string> frame =
+            immutableMessage->getOrCreateTransportFrame<std::string>(frameFactory);
+    ASSERT_TRUE(frame);
+    EXPECT_EQ(immutableMessage->getMessageSize(), frame->size());
+    EXPECT_EQ(frame, immutableMessage->getOrCreateTransportFrame<std::string>(frameFactory));
+    EXPECT_EQ(1, numberOfCreatedFrames);
+}
+
+TEST_F(ImmutableMessageTest, transportFramesOfOtherTypesAreNotCached)
+{
+    auto immutableMessage = mutableMessage.getImmutableMessage();
+    auto stringFrameFactory = [](const smrf::ByteVector&) {
+        return std::make_shared<std::string>("frame");
+    };
+    auto byteVectorFrameFactory = [](const smrf::ByteVector& serializedMessage) {
+        return std::make_shared<smrf::ByteVector>(serializedMessage);
+    };
+
+    std::shared_ptr<std::string> stringFrame =
+            immutableMessage->getOrCreateTransportFrame<std::string>(stringFrameFactory);
+    std::shared_ptr<smrf::ByteVector> byteVectorFrame =
+            immutableMessage->getOrCreateTransportFrame<smrf::ByteVector>(byteVectorFrameFactory);
+    EXPECT_EQ(immutableMessage->getSerializedMessage(), *byteVectorFrame);
+    EXPECT_NE(byteVectorFrame,
+              immutableMessage->getOrCreateTransportFrame<smrf::ByteVector>(
+                      byteVectorFrameFactory));
+    EXPECT_EQ(stringFrame,
+              immutableMessage->getOrCreateTransportFrame<std::string>(stringFrameFactory));
+}
@@ -0,0 +1,74 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/MethodDispatchTable.h"
+
+using namespace joynr;
+
+class MethodDispatchTableTest : public ::testing::Test
+{
+public:
+    MethodDispatchTableTest()
+            : methodDispatchTable{{"getAttribute", 0, {}},
+                                  {"setAttribute", 1, {}},
+                                  {"method", 0, {}},
+                                  {"method", 1, {"String"}},
+                                  {"method", 1, {"Integer"}},
+                                  {"method", 2, {"String", "Integer[]"}}}
+    {
+    }
+
+protected:
+    MethodDispatchTable methodDispatchTable;
+};
+
+TEST_F(MethodDispatchTableTest, findsAttributeAccessors)
+{
+    EXPECT_EQ(0, methodDispatchTable.find("getAttribute", {}));
+    EXPECT_EQ(1, methodDispatchTable.find("setAttribute", {"Integer"}));
+    EXPECT_EQ(1, methodDispatchTable.find("setAttribute", {"String"}));
+    EXPECT_EQ(MethodDispatchTable::NOT_FOUND, methodDispatchTable.find("getAttribute", {"String"}));
+    EXPECT_EQ(MethodDispatchTable::NOT_FOUND, methodDispatchTable.find("setAttribute", {}));
+}
+
+TEST_F(MethodDispatchTableTest, resolvesOverloadsByParameterDatatypes)
+{
+    EXPECT_EQ(2, methodDispatchTable.find("method", {}));
+    EXPECT_EQ(3, methodDispatchTable.find("method", {"String"}));
+    EXPECT_EQ(4, methodDispatchTable.find("method", {"Integer"}));
+    EXPECT_EQ(5, methodDispatchTable.find("method", {"String", "Integer[]"}));
+    EXPECT_EQ(MethodDispatchTable::NOT_FOUND, methodDispatchTable.find("method", {"Boolean"}));
+    EXPECT_EQ(MethodDispatchTable::NOT_FOUND,
+              methodDispatchTable.find("method", {"Integer[]", "String"}));
+}
+
+TEST_F(MethodDispatchTableTest, unknownMethodIsNotFound)
+{
+    EXPECT_EQ(MethodDispatchTable::NOT_FOUND, methodDispatchTable.find("unknownMethod", {}));
+}
+
+TEST(MethodDispatchTableOrderTest, firstMatchingMethodWins)
+{
+    MethodDispatchTable methodDispatchTable{{"method", 1, {}}, {"method", 1, {"String"}}};
+    EXPECT_EQ(0, methodDispatchTable.find("method", {"String"}));
+}
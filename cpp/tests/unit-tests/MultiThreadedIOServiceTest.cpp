@@ -0,0 +1,118 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <boost/asio/strand.hpp>
+
+#include "joynr/MultiThreadedIOService.h"
+#include "joynr/Semaphore.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class MultiThreadedIOServiceTest : public testing::Test
+{
+public:
+    MultiThreadedIOServiceTest()
+            : numberOfThreads(4),
+              multiThreadedIOService(std::make_shared<MultiThreadedIOService>(numberOfThreads))
+    {
+        multiThreadedIOService->start();
+    }
+
+    ~MultiThreadedIOServiceTest()
+    {
+        multiThreadedIOService->stop();
+    }
+
+protected:
+    const std::size_t numberOfThreads;
+    std::shared_ptr<MultiThreadedIOService> multiThreadedIOService;
+};
+
+TEST(MultiThreadedIOServiceNumberOfThreadsTest, zeroSelectsOneThreadPerHardwareThread)
+{
+    auto multiThreadedIOService = std::make_shared<MultiThreadedIOService>(0);
+    EXPECT_EQ(std::max(1u, std::thread::hardware_concurrency()),
+              multiThreadedIOService->getNumberOfThreads());
+}
+
+TEST_F(MultiThreadedIOServiceTest, handlersRunConcurrently)
+{
+    // every handler blocks until all handlers have started, which only succeeds if each of them
+    // runs on a thread of its own
+    std::atomic<std::size_t> started(0);
+    auto allStarted = std::make_shared<Semaphore>(0);
+    auto finished = std::make_shared<Semaphore>(0);
+    for (std::size_t i = 0; i < numberOfThreads; ++i) {
+        multiThreadedIOService->getIOService().post([this, &started, allStarted, finished]() {
+            if (++started == numberOfThreads) {
+                for (std::size_t j = 0; j < numberOfThreads; ++j) {
+                    allStarted->notify();
+                }
+            }
+            if (allStarted->waitFor(std::chrono::seconds(5))) {
+                finished->notify();
+            }
+        });
+    }
+    for (std::size_t i = 0; i < numberOfThreads; ++i) {
+        EXPECT_TRUE(finished->waitFor(std::chrono::seconds(5)));
+    }
+}
+
+TEST_F(MultiThreadedIOServiceTest, handlersOfOneStrandDoNotOverlap)
+{
+    constexpr int numberOfHandlers = 1000;
+    boost::asio::io_service::strand strand(multiThreadedIOService->getIOService());
+    std::atomic<int> running(0);
+    std::atomic<int> overlaps(0);
+    std::atomic<int> invoked(0);
+    auto semaphore = std::make_shared<Semaphore>(0);
+    for (int i = 0; i < numberOfHandlers; ++i) {
+        strand.post([&running, &overlaps, &invoked, semaphore]() {
+            if (++running != 1) {
+                ++overlaps;
+            }
+            std::this_thread::yield();
+            --running;
+            if (++invoked == numberOfHandlers) {
+                semaphore->notify();
+            }
+        });
+    }
+    ASSERT_TRUE(semaphore->waitFor(std::chrono::seconds(5)));
+    EXPECT_EQ(0, overlaps);
+}
+
+TEST_F(MultiThreadedIOServiceTest, canBeStoppedFromWithinAHandler)
+{
+    auto semaphore = std::make_shared<Semaphore>(0);
+    multiThreadedIOService->getIOService().post([this, semaphore]() {
+        multiThreadedIOService->stop();
+        semaphore->notify();
+    });
+    EXPECT_TRUE(semaphore->waitFor(std::chrono::seconds(5)));
+}
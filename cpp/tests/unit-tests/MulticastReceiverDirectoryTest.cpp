@@ -217,6 +217,34 @@ TEST_F(MulticastReceiverDirectoryTest, getReceiversWithWildCards)
     EXPECT_EQ(expectedReceivers, receivers);
 }
 
+TEST_F(MulticastReceiverDirectoryTest, unregisterDoesNotAffectMulticastIdsWithCommonPrefix)
+{
+    const std::string multicastId1 = "provider/brod/a";
+    const std::string multicastId2 = "provider/brod/a/+";
+    const std::string receiverId2 = "testReceiverId_TWO";
+    multicastReceiverDirectory.registerMulticastReceiver(multicastId1, receiverId);
+    multicastReceiverDirectory.registerMulticastReceiver(multicastId2, receiverId2);
+
+    EXPECT_TRUE(multicastReceiverDirectory.unregisterMulticastReceiver(multicastId1, receiverId));
+    EXPECT_FALSE(multicastReceiverDirectory.contains(multicastId1));
+    EXPECT_TRUE(multicastReceiverDirectory.contains(multicastId2));
+
+    std::unordered_set<std::string> expectedReceivers = {receiverId2};
+    EXPECT_EQ(expectedReceivers, multicastReceiverDirectory.getReceivers("provider/brod/a/z"));
+    EXPECT_TRUE(multicastReceiverDirectory.getReceivers(multicastId1).empty());
+}
+
+TEST_F(MulticastReceiverDirectoryTest, wildcardsDoNotMatchEmptyOrNonAlphanumericPartitions)
+{
+    multicastReceiverDirectory.registerMulticastReceiver("provider/brod/+", receiverId);
+    multicastReceiverDirectory.registerMulticastReceiver("provider/other/*", receiverId);
+
+    EXPECT_TRUE(multicastReceiverDirectory.getReceivers("provider/brod/").empty());
+    EXPECT_TRUE(multicastReceiverDirectory.getReceivers("provider/brod/a-b").empty());
+    EXPECT_TRUE(multicastReceiverDirectory.getReceivers("provider/other/a/").empty());
+    EXPECT_FALSE(multicastReceiverDirectory.getReceivers("provider/other").empty());
+}
+
 TEST_F(MulticastReceiverDirectoryTest, getMulticastIds)
 {
     const std::string multicastId2("part1/name1/a/b/c");
@@ -0,0 +1,152 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/ParticipantIdTable.h"
+
+using namespace joynr;
+
+TEST(ParticipantIdTableTest, acquireReturnsSameHandleForSameParticipantId)
+{
+    ParticipantIdTable participantIdTable;
+    const ParticipantIdTable::Handle handle1 = participantIdTable.acquire("participantId1");
+    const ParticipantIdTable::Handle handle2 = participantIdTable.acquire("participantId2");
+
+    EXPECT_NE(ParticipantIdTable::INVALID_HANDLE, handle1);
+    EXPECT_NE(ParticipantIdTable::INVALID_HANDLE, handle2);
+    EXPECT_NE(handle1, handle2);
+    EXPECT_EQ(handle1, participantIdTable.acquire("participantId1"));
+    EXPECT_EQ(handle1, participantIdTable.find("participantId1"));
+    EXPECT_EQ(2, participantIdTable.size());
+}
+
+TEST(ParticipantIdTableTest, findDoesNotIntern)
+{
+    ParticipantIdTable participantIdTable;
+    EXPECT_EQ(ParticipantIdTable::INVALID_HANDLE, participantIdTable.find("participantId"));
+    EXPECT_EQ(0, participantIdTable.size());
+}
+
+TEST(ParticipantIdTableTest, participantIdIsRemovedWhenLastReferenceIsReleased)
+{
+    ParticipantIdTable participantIdTable;
+    const ParticipantIdTable::Handle handle = participantIdTable.acquire("participantId");
+    participantIdTable.acquire("participantId");
+
+    participantIdTable.release(handle);
+    EXPECT_EQ(handle, participantIdTable.find("participantId"));
+
+    participantIdTable.release(handle);
+    EXPECT_EQ(ParticipantIdTable::INVALID_HANDLE, participantIdTable.find("participantId"));
+    EXPECT_EQ(0, participantIdTable.size());
+}
+
+TEST(ParticipantIdTableTest, reusedSlotGetsNewHandle)
+{
+    ParticipantIdTable participantIdTable;
+    const ParticipantIdTable::Handle oldHandle = participantIdTable.acquire("participantId1");
+    participantIdTable.release(oldHandle);
+
+    const ParticipantIdTable::Handle newHandle = participantIdTable.acquire("participantId2");
+    EXPECT_EQ(ParticipantIdTable::getSlotIndex(oldHandle),
+              ParticipantIdTable::getSlotIndex(newHandle));
+    EXPECT_NE(oldHandle, newHandle);
+}
+
+TEST(ParticipantIdTableTest, concurrentAcquireAndRelease)
+{
+    ParticipantIdTable participantIdTable;
+    constexpr int numberOfThreads = 4;
+    constexpr int numberOfIterations = 1000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; ++i) {
+        threads.emplace_back([&participantIdTable, i]() {
+            const std::string participantId = "participantId" + std::to_string(i % 2);
+            for (int j = 0; j < numberOfIterations; ++j) {
+                const ParticipantIdTable::Handle handle = participantIdTable.acquire(participantId);
+                ASSERT_EQ(handle, participantIdTable.find(participantId));
+                participantIdTable.release(handle);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, participantIdTable.size());
+}
+
+TEST(ParticipantIdTableTest, getParticipantIdReturnsInternedString)
+{
+    ParticipantIdTable participantIdTable;
+    const ParticipantIdTable::Handle handle1 = participantIdTable.acquire("participantId1");
+    const ParticipantIdTable::Handle handle2 = participantIdTable.acquire("participantId2");
+
+    EXPECT_EQ("participantId1", participantIdTable.getParticipantId(handle1));
+    EXPECT_EQ("participantId2", participantIdTable.getParticipantId(handle2));
+}
+
+TEST(ParticipantIdTableTest, manyParticipantIdsAreFoundAfterReleasingSome)
+{
+    ParticipantIdTable participantIdTable;
+    // spans several chunks of slots and grows the index of each shard repeatedly
+    constexpr int numberOfParticipantIds = 10000;
+    std::vector<ParticipantIdTable::Handle> handles;
+    for (int i = 0; i < numberOfParticipantIds; ++i) {
+        handles.push_back(participantIdTable.acquire("participantId" + std::to_string(i)));
+    }
+    for (int i = 0; i < numberOfParticipantIds; i += 2) {
+        participantIdTable.release(handles[i]);
+    }
+
+    EXPECT_EQ(numberOfParticipantIds / 2, participantIdTable.size());
+    for (int i = 0; i < numberOfParticipantIds; ++i) {
+        const std::string participantId = "participantId" + std::to_string(i);
+        if (i % 2 == 0) {
+            EXPECT_EQ(ParticipantIdTable::INVALID_HANDLE, participantIdTable.find(participantId));
+        } else {
+            EXPECT_EQ(handles[i], participantIdTable.find(participantId));
+            EXPECT_EQ(participantId, participantIdTable.getParticipantId(handles[i]));
+        }
+    }
+}
+
+TEST(ParticipantIdTableTest, getParticipantIdWhileOtherParticipantIdsAreAcquired)
+{
+    ParticipantIdTable participantIdTable;
+    const ParticipantIdTable::Handle handle = participantIdTable.acquire("participantId");
+    std::atomic<bool> stop(false);
+
+    // getParticipantId does not lock, the slots must not move while further chunks are added
+    std::thread reader([&participantIdTable, &stop, handle]() {
+        while (!stop) {
+            ASSERT_EQ("participantId", participantIdTable.getParticipantId(handle));
+        }
+    });
+    for (int i = 0; i < 10000; ++i) {
+        participantIdTable.acquire("other" + std::to_string(i));
+    }
+    stop = true;
+    reader.join();
+}
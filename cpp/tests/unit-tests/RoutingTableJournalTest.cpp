@@ -0,0 +1,164 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "joynr/RoutingTable.h"
+#include "joynr/RoutingTableJournal.h"
+#include "joynr/Util.h"
+#include "joynr/serializer/Serializer.h"
+#include "joynr/system/RoutingTypes/MqttAddress.h"
+
+using namespace joynr;
+using MqttAddress = joynr::system::RoutingTypes::MqttAddress;
+
+class RoutingTableJournalTest : public ::testing::Test
+{
+public:
+    RoutingTableJournalTest()
+            : snapshotFileName("test-RoutingTableJournal.persist"),
+              journalFileName(RoutingTableJournal::getJournalFileName(snapshotFileName)),
+              routingTable(),
+              routingTableMutex()
+    {
+        removeFiles();
+    }
+
+    ~RoutingTableJournalTest()
+    {
+        removeFiles();
+    }
+
+protected:
+    std::unique_ptr<RoutingTableJournal> createJournal(std::uint32_t compactionThreshold)
+    {
+        return std::make_unique<RoutingTableJournal>(snapshotFileName,
+                                                     [this]() {
+                                                         std::lock_guard<std::mutex> lock(
+                                                                 routingTableMutex);
+                                                         return serializer::serializeToJson(
+                                                                 routingTable);
+                                                     },
+                                                     compactionThreshold);
+    }
+
+    void add(RoutingTableJournal& journal, const std::string& participantId)
+    {
+        std::lock_guard<std::mutex> lock(routingTableMutex);
+        auto address = std::make_shared<const MqttAddress>("brokerUri", participantId);
+        routingTable.add(participantId, isGloballyVisible, address, expiryDateMs, isSticky);
+        journal.logAdd(routingtable::RoutingEntry(
+                participantId, address, isGloballyVisible, expiryDateMs, isSticky));
+    }
+
+    void remove(RoutingTableJournal& journal, const std::string& participantId)
+    {
+        std::lock_guard<std::mutex> lock(routingTableMutex);
+        routingTable.remove(participantId);
+        journal.logRemove(participantId);
+    }
+
+    void removeFiles()
+    {
+        std::remove(snapshotFileName.c_str());
+        std::remove(journalFileName.c_str());
+    }
+
+    const std::string snapshotFileName;
+    const std::string journalFileName;
+    RoutingTable routingTable;
+    std::mutex routingTableMutex;
+    static constexpr std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+    static constexpr bool isGloballyVisible = true;
+    static constexpr bool isSticky = false;
+};
+
+TEST_F(RoutingTableJournalTest, mutationsAreAppendedToJournal)
+{
+    auto journal = createJournal(1000);
+    add(*journal, "participant1");
+    add(*journal, "participant2");
+    remove(*journal, "participant1");
+    journal->flush();
+
+    EXPECT_FALSE(util::fileExists(snapshotFileName));
+    RoutingTable restoredRoutingTable;
+    EXPECT_EQ(3, RoutingTableJournal::load(snapshotFileName, restoredRoutingTable));
+    EXPECT_FALSE(restoredRoutingTable.containsParticipantId("participant1"));
+    EXPECT_TRUE(restoredRoutingTable.containsParticipantId("participant2"));
+}
+
+TEST_F(RoutingTableJournalTest, journalIsCompactedIntoSnapshot)
+{
+    const std::uint32_t compactionThreshold = 5;
+    auto journal = createJournal(compactionThreshold);
+    for (std::uint32_t i = 0; i < compactionThreshold; ++i) {
+        add(*journal, "participant" + std::to_string(i));
+    }
+    journal->flush();
+
+    EXPECT_TRUE(util::fileExists(snapshotFileName));
+    EXPECT_TRUE(util::loadStringFromFile(journalFileName).empty());
+
+    remove(*journal, "participant0");
+    journal->shutdown();
+
+    RoutingTable restoredRoutingTable;
+    EXPECT_EQ(1, RoutingTableJournal::load(snapshotFileName, restoredRoutingTable));
+    EXPECT_FALSE(restoredRoutingTable.containsParticipantId("participant0"));
+    for (std::uint32_t i = 1; i < compactionThreshold; ++i) {
+        EXPECT_TRUE(
+                restoredRoutingTable.containsParticipantId("participant" + std::to_string(i)));
+    }
+}
+
+TEST_F(RoutingTableJournalTest, replayingJournalOnTopOfNewerSnapshotIsIdempotent)
+{
+    auto journal = createJournal(1000);
+    add(*journal, "participant1");
+    remove(*journal, "participant1");
+    add(*journal, "participant2");
+    journal->flush();
+    // simulate a crash after writing the snapshot but before truncating the journal
+    const std::string journalContent = util::loadStringFromFile(journalFileName);
+    journal->requestCompaction();
+    journal->shutdown();
+    util::saveStringToFile(journalFileName, journalContent);
+
+    RoutingTable restoredRoutingTable;
+    EXPECT_EQ(3, RoutingTableJournal::load(snapshotFileName, restoredRoutingTable));
+    EXPECT_FALSE(restoredRoutingTable.containsParticipantId("participant1"));
+    EXPECT_TRUE(restoredRoutingTable.containsParticipantId("participant2"));
+}
+
+TEST_F(RoutingTableJournalTest, partiallyWrittenRecordIsIgnored)
+{
+    auto journal = createJournal(1000);
+    add(*journal, "participant1");
+    journal->shutdown();
+    util::appendStringToFile(journalFileName, "+{\"participantId\":\"partic");
+
+    RoutingTable restoredRoutingTable;
+    EXPECT_EQ(1, RoutingTableJournal::load(snapshotFileName, restoredRoutingTable));
+    EXPECT_TRUE(restoredRoutingTable.containsParticipantId("participant1"));
+}
@@ -18,6 +18,10 @@
  */
 
 #include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unordered_set>
 
 #include <gtest/gtest.h>
 
@@ -34,7 +38,8 @@ class RoutingTableTest : public ::testing::Test
 {
 public:
     RoutingTableTest()
-            : routingTable(),
+            : participantIdTable(),
+              routingTable(participantIdTable),
               testValue(nullptr),
               secondTestValue(nullptr),
               firstKey(""),
@@ -53,6 +58,7 @@ public:
     }
 
 protected:
+    ParticipantIdTable participantIdTable;
     RoutingTable routingTable;
     std::shared_ptr<Address> testValue;
     std::shared_ptr<Address> secondTestValue;
@@ -173,3 +179,94 @@ TEST_F(RoutingTableTest, purge)
     ASSERT_TRUE(routingTable.containsParticipantId(secondKey));
     ASSERT_TRUE(routingTable.containsParticipantId(thirdKey));
 }
+
+TEST_F(RoutingTableTest, lookupAddressByParticipantId)
+{
+    const bool isGloballyVisible = true;
+    routingTable.add(firstKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+
+    auto address = routingTable.lookupAddressByParticipantId(firstKey);
+    ASSERT_NE(nullptr, address);
+    EXPECT_EQ(*testValue, *address);
+
+    routingTable.add(firstKey, isGloballyVisible, secondTestValue, expiryDateMaxMs, isStickyFalse);
+    address = routingTable.lookupAddressByParticipantId(firstKey);
+    ASSERT_NE(nullptr, address);
+    EXPECT_EQ(*secondTestValue, *address);
+
+    EXPECT_EQ(nullptr, routingTable.lookupAddressByParticipantId(secondKey));
+}
+
+TEST_F(RoutingTableTest, participantIdIsInternedWhileEntryExists)
+{
+    const bool isGloballyVisible = true;
+    routingTable.add(firstKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+    const ParticipantIdTable::Handle handle = participantIdTable.find(firstKey);
+    ASSERT_NE(ParticipantIdTable::INVALID_HANDLE, handle);
+
+    // replacing the entry keeps a single reference
+    routingTable.add(firstKey, isGloballyVisible, secondTestValue, expiryDateMaxMs, isStickyFalse);
+    EXPECT_EQ(handle, participantIdTable.find(firstKey));
+    EXPECT_EQ(1, participantIdTable.size());
+    auto routingEntry = routingTable.lookupRoutingEntryByParticipantId(firstKey);
+    ASSERT_TRUE(routingEntry);
+    EXPECT_EQ(firstKey, routingEntry->participantId);
+
+    routingTable.remove(firstKey);
+    EXPECT_EQ(ParticipantIdTable::INVALID_HANDLE, participantIdTable.find(firstKey));
+    EXPECT_EQ(0, participantIdTable.size());
+    EXPECT_FALSE(routingTable.lookupRoutingEntryByParticipantId(firstKey));
+}
+
+TEST_F(RoutingTableTest, lookupAddressByParticipantIdHandle)
+{
+    const bool isGloballyVisible = true;
+    routingTable.add(firstKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+    const ParticipantIdTable::Handle handle = participantIdTable.find(firstKey);
+
+    auto address = routingTable.lookupAddressByParticipantIdHandle(handle);
+    ASSERT_NE(nullptr, address);
+    EXPECT_EQ(*testValue, *address);
+    EXPECT_EQ(nullptr,
+              routingTable.lookupAddressByParticipantIdHandle(ParticipantIdTable::INVALID_HANDLE));
+}
+
+TEST_F(RoutingTableTest, handleOfRemovedParticipantIdIsNotFound)
+{
+    const bool isGloballyVisible = true;
+    routingTable.add(firstKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+    const ParticipantIdTable::Handle oldHandle = participantIdTable.find(firstKey);
+    routingTable.remove(firstKey);
+
+    // the slot of the removed participantId is reused with a new generation
+    routingTable.add(secondKey, isGloballyVisible, secondTestValue, expiryDateMaxMs, isStickyFalse);
+    const ParticipantIdTable::Handle newHandle = participantIdTable.find(secondKey);
+    ASSERT_EQ(ParticipantIdTable::getSlotIndex(oldHandle),
+              ParticipantIdTable::getSlotIndex(newHandle));
+
+    EXPECT_EQ(nullptr, routingTable.lookupAddressByParticipantIdHandle(oldHandle));
+    auto address = routingTable.lookupAddressByParticipantIdHandle(newHandle);
+    ASSERT_NE(nullptr, address);
+    EXPECT_EQ(*secondTestValue, *address);
+}
+
+TEST_F(RoutingTableTest, lookupParticipantIdsByAddressAfterReplaceAndRemove)
+{
+    const bool isGloballyVisible = true;
+    routingTable.add(firstKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+    routingTable.add(secondKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+    routingTable.add(thirdKey, isGloballyVisible, testValue, expiryDateMaxMs, isStickyFalse);
+
+    routingTable.add(secondKey, isGloballyVisible, secondTestValue, expiryDateMaxMs, isStickyFalse);
+    EXPECT_EQ(std::unordered_set<std::string>({firstKey, thirdKey}),
+              routingTable.lookupParticipantIdsByAddress(testValue));
+    EXPECT_EQ(std::unordered_set<std::string>({secondKey}),
+              routingTable.lookupParticipantIdsByAddress(secondTestValue));
+
+    routingTable.remove(thirdKey);
+    EXPECT_EQ(std::unordered_set<std::string>({firstKey}),
+              routingTable.lookupParticipantIdsByAddress(testValue));
+    routingTable.remove(firstKey);
+    EXPECT_TRUE(routingTable.lookupParticipantIdsByAddress(testValue).empty());
+    EXPECT_EQ(1, routingTable.size());
+}
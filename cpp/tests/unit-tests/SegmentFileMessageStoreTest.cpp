@@ -0,0 +1,207 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "joynr/ImmutableMessage.h"
+#include "joynr/MessageQueue.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/SegmentFileMessageStore.h"
+#include "joynr/TimePoint.h"
+
+using namespace joynr;
+
+class SegmentFileMessageStoreTest : public ::testing::Test
+{
+public:
+    SegmentFileMessageStoreTest() : directory("SegmentFileMessageStoreTest"), now(TimePoint::now())
+    {
+        boost::filesystem::remove_all(directory);
+    }
+
+    void TearDown() override
+    {
+        boost::filesystem::remove_all(directory);
+    }
+
+protected:
+    const std::string directory;
+    const TimePoint now;
+
+    std::shared_ptr<ImmutableMessage> createMessage(const TimePoint& expiryDate,
+                                                    const std::string& payload)
+    {
+        MutableMessage mutableMsg;
+        mutableMsg.setExpiryDate(expiryDate);
+        mutableMsg.setRecipient("recipient");
+        mutableMsg.setPayload(payload);
+        return mutableMsg.getImmutableMessage();
+    }
+
+    std::string payloadAsString(std::shared_ptr<ImmutableMessage> message)
+    {
+        const smrf::ByteArrayView& byteArrayView = message->getUnencryptedBody();
+        return std::string(
+                reinterpret_cast<const char*>(byteArrayView.data()), byteArrayView.size());
+    }
+
+    std::size_t numberOfFilesInDirectory()
+    {
+        return std::distance(boost::filesystem::directory_iterator(directory),
+                             boost::filesystem::directory_iterator());
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(SegmentFileMessageStoreTest);
+};
+
+TEST_F(SegmentFileMessageStoreTest, takeAllForUnknownKey)
+{
+    SegmentFileMessageStore store(directory, 1024 * 1024, 1024);
+    EXPECT_TRUE(store.takeAllFor("unknown").empty());
+}
+
+TEST_F(SegmentFileMessageStoreTest, messagesAreTakenInTtlOrder)
+{
+    SegmentFileMessageStore store(directory, 1024 * 1024, 1024);
+    EXPECT_TRUE(store.store("key1", createMessage(now + 3000, "payload3")));
+    EXPECT_TRUE(store.store("key1", createMessage(now + 1000, "payload1")));
+    EXPECT_TRUE(store.store("key2", createMessage(now + 1000, "other")));
+    EXPECT_TRUE(store.store("key1", createMessage(now + 2000, "payload2")));
+    EXPECT_EQ(4, store.getNumberOfMessages());
+
+    auto messages = store.takeAllFor("key1");
+    ASSERT_EQ(3, messages.size());
+    EXPECT_EQ("payload1", payloadAsString(messages[0]));
+    EXPECT_EQ("payload2", payloadAsString(messages[1]));
+    EXPECT_EQ("payload3", payloadAsString(messages[2]));
+    EXPECT_EQ(1, store.getNumberOfMessages());
+    EXPECT_TRUE(store.takeAllFor("key1").empty());
+}
+
+TEST_F(SegmentFileMessageStoreTest, messageIsRejectedWhenLimitIsReached)
+{
+    auto message = createMessage(now + 1000, std::string(100, 'x'));
+    const std::uint64_t messageSize = message->getSerializedMessage().size();
+    SegmentFileMessageStore store(directory, messageSize * 2 - 1, 1024 * 1024);
+
+    EXPECT_TRUE(store.store("key", message));
+    EXPECT_FALSE(store.store("key", message));
+    EXPECT_EQ(1, store.getNumberOfMessages());
+    EXPECT_EQ(messageSize, store.getSizeBytes());
+}
+
+TEST_F(SegmentFileMessageStoreTest, segmentIsDeletedWhenAllItsMessagesAreTaken)
+{
+    auto message = createMessage(now + 1000, std::string(100, 'x'));
+    const std::uint64_t messageSize = message->getSerializedMessage().size();
+    // two messages fit into one segment
+    SegmentFileMessageStore store(directory, 1024 * 1024, messageSize * 2);
+
+    for (int i = 0; i < 3; i++) {
+        EXPECT_TRUE(store.store("key1", message));
+        EXPECT_TRUE(store.store("key2", message));
+    }
+    EXPECT_EQ(3, store.getNumberOfSegments());
+    EXPECT_EQ(3, numberOfFilesInDirectory());
+
+    // every segment still holds a message of key2
+    EXPECT_EQ(3, store.takeAllFor("key1").size());
+    EXPECT_EQ(3, store.getNumberOfSegments());
+
+    // only the current segment is kept for further messages
+    EXPECT_EQ(3, store.takeAllFor("key2").size());
+    EXPECT_EQ(1, store.getNumberOfSegments());
+    EXPECT_EQ(1, numberOfFilesInDirectory());
+    EXPECT_EQ(0, store.getSizeBytes());
+}
+
+TEST_F(SegmentFileMessageStoreTest, removeOutdatedMessagesDeletesExpiredSegments)
+{
+    auto expiredMessage =
+            createMessage(now - std::chrono::milliseconds(1000), std::string(100, 'x'));
+    const std::uint64_t messageSize = expiredMessage->getSerializedMessage().size();
+    SegmentFileMessageStore store(directory, 1024 * 1024, messageSize * 2);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(store.store("key", expiredMessage));
+    }
+    EXPECT_TRUE(store.store("key", createMessage(now + 10000, "valid")));
+    EXPECT_EQ(3, store.getNumberOfSegments());
+
+    store.removeOutdatedMessages();
+
+    EXPECT_EQ(1, store.getNumberOfMessages());
+    EXPECT_EQ(1, store.getNumberOfSegments());
+    EXPECT_EQ(1, numberOfFilesInDirectory());
+    auto messages = store.takeAllFor("key");
+    ASSERT_EQ(1, messages.size());
+    EXPECT_EQ("valid", payloadAsString(messages[0]));
+}
+
+TEST_F(SegmentFileMessageStoreTest, staleSegmentFilesAreRemovedOnStartup)
+{
+    boost::filesystem::create_directories(directory);
+    std::ofstream(directory + "/segment-42.bin") << "stale";
+    std::ofstream(directory + "/unrelated") << "keep";
+
+    SegmentFileMessageStore store(directory, 1024 * 1024, 1024);
+
+    EXPECT_FALSE(boost::filesystem::exists(directory + "/segment-42.bin"));
+    EXPECT_TRUE(boost::filesystem::exists(directory + "/unrelated"));
+}
+
+TEST_F(SegmentFileMessageStoreTest, messageQueueMovesMessagesExceedingLimitBytesToStore)
+{
+    const std::string recipient("recipient");
+    auto store = std::make_shared<SegmentFileMessageStore>(directory, 1024 * 1024, 1024 * 1024);
+    const std::string payload(1000, 'x');
+    const std::uint64_t sizeOfSingleMessage =
+            createMessage(now + 1000, payload)->getMessageSize();
+    // two messages fit into memory
+    MessageQueue<std::string> queue(0, 0, sizeOfSingleMessage * 2 + 10, store);
+
+    queue.queueMessage(recipient, createMessage(now + 3000, payload + "1"));
+    queue.queueMessage(recipient, createMessage(now + 1000, payload + "2"));
+    // exceeds the byte limit, the message with the lowest expiry date is moved to the store
+    queue.queueMessage(recipient, createMessage(now + 2000, payload + "3"));
+    EXPECT_EQ(2, queue.getQueueLength());
+    EXPECT_EQ(1, store->getNumberOfMessages());
+
+    // does not fit into memory at all
+    queue.queueMessage(recipient, createMessage(now + 500, payload + payload + payload));
+    EXPECT_EQ(2, store->getNumberOfMessages());
+
+    auto messages = queue.takeAllFor(recipient);
+    ASSERT_EQ(4, messages.size());
+    EXPECT_EQ(payload + payload + payload, payloadAsString(messages[0]));
+    EXPECT_EQ(payload + "2", payloadAsString(messages[1]));
+    EXPECT_EQ(payload + "1", payloadAsString(messages[2]));
+    EXPECT_EQ(payload + "3", payloadAsString(messages[3]));
+    EXPECT_EQ(0, queue.getQueueLength());
+    EXPECT_EQ(0, store->getNumberOfMessages());
+}
@@ -0,0 +1,173 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/ShardedThreadPoolDelayedScheduler.h"
+#include "joynr/SingleThreadedIOService.h"
+
+#include "tests/mock/MockRunnable.h"
+#include "tests/mock/MockRunnableBlocking.h"
+#include "tests/utils/PtrUtils.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+using ::testing::StrictMock;
+
+class ShardedThreadPoolDelayedSchedulerTest : public testing::Test
+{
+public:
+    ShardedThreadPoolDelayedSchedulerTest()
+            : singleThreadedIOService(std::make_shared<SingleThreadedIOService>())
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~ShardedThreadPoolDelayedSchedulerTest()
+    {
+        singleThreadedIOService->stop();
+    }
+
+protected:
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+};
+
+TEST_F(ShardedThreadPoolDelayedSchedulerTest, startAndShutdownWithoutWork)
+{
+    auto scheduler = std::make_shared<ShardedThreadPoolDelayedScheduler>(
+            4, "ShardedThreadPoolDelayedScheduler", singleThreadedIOService->getIOService());
+    EXPECT_EQ(4, scheduler->getNumberOfShards());
+    scheduler->shutdown();
+}
+
+TEST_F(ShardedThreadPoolDelayedSchedulerTest, atLeastOneShardIsCreated)
+{
+    auto scheduler = std::make_shared<ShardedThreadPoolDelayedScheduler>(
+            0, "ShardedThreadPoolDelayedScheduler", singleThreadedIOService->getIOService());
+    EXPECT_EQ(1, scheduler->getNumberOfShards());
+    scheduler->shutdown();
+}
+
+TEST_F(ShardedThreadPoolDelayedSchedulerTest, runnablesWithSameShardKeyAreExecutedInOrder)
+{
+    auto scheduler = std::make_shared<ShardedThreadPoolDelayedScheduler>(
+            4, "ShardedThreadPoolDelayedScheduler", singleThreadedIOService->getIOService());
+
+    constexpr std::size_t numberOfRunnables = 100;
+    constexpr std::size_t shardKey = 42;
+    std::mutex mutex;
+    std::vector<std::size_t> executionOrder;
+    Semaphore allExecuted(0);
+
+    std::vector<std::shared_ptr<StrictMock<MockRunnable>>> runnables;
+    for (std::size_t i = 0; i < numberOfRunnables; ++i) {
+        auto runnable = std::make_shared<StrictMock<MockRunnable>>();
+        EXPECT_CALL(*runnable, run()).WillOnce(InvokeWithoutArgs([&, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            executionOrder.push_back(i);
+            if (executionOrder.size() == numberOfRunnables) {
+                allExecuted.notify();
+            }
+        }));
+        EXPECT_CALL(*runnable, dtorCalled()).Times(1);
+        runnables.push_back(runnable);
+        scheduler->schedule(runnable, shardKey, std::chrono::milliseconds::zero());
+    }
+
+    EXPECT_TRUE(allExecuted.waitFor(std::chrono::milliseconds(1000)));
+    for (std::size_t i = 0; i < numberOfRunnables; ++i) {
+        EXPECT_EQ(i, executionOrder[i]);
+    }
+
+    scheduler->shutdown();
+    for (auto& runnable : runnables) {
+        test::util::resetAndWaitUntilDestroyed(runnable);
+    }
+}
+
+TEST_F(ShardedThreadPoolDelayedSchedulerTest, blockedShardDoesNotBlockOtherShards)
+{
+    auto scheduler = std::make_shared<ShardedThreadPoolDelayedScheduler>(
+            2, "ShardedThreadPoolDelayedScheduler", singleThreadedIOService->getIOService());
+
+    Semaphore blockingRunnableEntered(0);
+    auto blockingRunnable = std::make_shared<StrictMock<MockRunnableBlocking>>();
+    EXPECT_CALL(*blockingRunnable, runEntry())
+            .WillOnce(InvokeWithoutArgs(&blockingRunnableEntered, &Semaphore::notify));
+    EXPECT_CALL(*blockingRunnable, runExit()).Times(1);
+    EXPECT_CALL(*blockingRunnable, shutdownCalled()).Times(AtMost(1));
+    EXPECT_CALL(*blockingRunnable, dtorCalled()).Times(1);
+
+    Semaphore runnableExecuted(0);
+    auto runnable = std::make_shared<StrictMock<MockRunnable>>();
+    EXPECT_CALL(*runnable, run())
+            .WillOnce(InvokeWithoutArgs(&runnableExecuted, &Semaphore::notify));
+    EXPECT_CALL(*runnable, dtorCalled()).Times(1);
+
+    scheduler->schedule(blockingRunnable, 0, std::chrono::milliseconds::zero());
+    EXPECT_TRUE(blockingRunnableEntered.waitFor(std::chrono::milliseconds(1000)));
+
+    scheduler->schedule(runnable, 1, std::chrono::milliseconds::zero());
+    EXPECT_TRUE(runnableExecuted.waitFor(std::chrono::milliseconds(1000)));
+
+    blockingRunnable->manualShutdown();
+    scheduler->shutdown();
+
+    test::util::resetAndWaitUntilDestroyed(blockingRunnable);
+    test::util::resetAndWaitUntilDestroyed(runnable);
+}
+
+TEST_F(ShardedThreadPoolDelayedSchedulerTest, statisticsAreCollectedPerShard)
+{
+    auto scheduler = std::make_shared<ShardedThreadPoolDelayedScheduler>(
+            2, "ShardedThreadPoolDelayedScheduler", singleThreadedIOService->getIOService());
+
+    Semaphore executed(0);
+    auto runnable1 = std::make_shared<StrictMock<MockRunnable>>();
+    auto runnable2 = std::make_shared<StrictMock<MockRunnable>>();
+    EXPECT_CALL(*runnable1, run()).WillOnce(InvokeWithoutArgs(&executed, &Semaphore::notify));
+    EXPECT_CALL(*runnable2, run()).WillOnce(InvokeWithoutArgs(&executed, &Semaphore::notify));
+    EXPECT_CALL(*runnable1, dtorCalled()).Times(1);
+    EXPECT_CALL(*runnable2, dtorCalled()).Times(1);
+
+    scheduler->schedule(runnable1, 1, std::chrono::milliseconds::zero());
+    scheduler->schedule(runnable2, 1, std::chrono::milliseconds(5));
+
+    EXPECT_TRUE(executed.waitFor(std::chrono::milliseconds(1000)));
+    EXPECT_TRUE(executed.waitFor(std::chrono::milliseconds(1000)));
+
+    const auto statistics = scheduler->getStatistics();
+    ASSERT_EQ(2, statistics.size());
+    EXPECT_EQ(0, statistics[0].executedRunnables);
+    EXPECT_EQ(0, statistics[0].maxQueueDepth);
+    EXPECT_EQ(2, statistics[1].executedRunnables);
+    EXPECT_EQ(0, statistics[1].queueDepth);
+    EXPECT_LE(1, statistics[1].maxQueueDepth);
+    EXPECT_LE(statistics[1].averageLatency, statistics[1].maxLatency);
+
+    scheduler->shutdown();
+    test::util::resetAndWaitUntilDestroyed(runnable1);
+    test::util::resetAndWaitUntilDestroyed(runnable2);
+}
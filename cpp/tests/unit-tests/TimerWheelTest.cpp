@@ -0,0 +1,150 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/TimerWheel.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class TimerWheelTest : public testing::Test
+{
+public:
+    TimerWheelTest()
+            : singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              timerWheel(std::make_shared<TimerWheel>(singleThreadedIOService->getIOService()))
+    {
+        singleThreadedIOService->start();
+    }
+
+    ~TimerWheelTest()
+    {
+        timerWheel->shutdown();
+        singleThreadedIOService->stop();
+    }
+
+protected:
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    std::shared_ptr<TimerWheel> timerWheel;
+};
+
+TEST_F(TimerWheelTest, callbackIsInvokedAfterDelay)
+{
+    Semaphore semaphore(0);
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point invoked;
+    timerWheel->schedule(std::chrono::milliseconds(20), [&semaphore, &invoked]() {
+        invoked = std::chrono::steady_clock::now();
+        semaphore.notify();
+    });
+    EXPECT_EQ(1, timerWheel->getNumberOfTimers());
+
+    ASSERT_TRUE(semaphore.waitFor(std::chrono::milliseconds(1000)));
+    EXPECT_GE(invoked - start, std::chrono::milliseconds(20));
+    EXPECT_LT(invoked - start, std::chrono::milliseconds(100));
+    EXPECT_EQ(0, timerWheel->getNumberOfTimers());
+}
+
+TEST_F(TimerWheelTest, callbacksAreInvokedInOrderOfExpiry)
+{
+    Semaphore semaphore(0);
+    std::vector<int> order;
+    // the delays span all levels which are reachable in a reasonable time
+    timerWheel->schedule(std::chrono::milliseconds(600), [&]() {
+        order.push_back(3);
+        semaphore.notify();
+    });
+    timerWheel->schedule(std::chrono::milliseconds(300), [&]() { order.push_back(2); });
+    timerWheel->schedule(std::chrono::milliseconds(5), [&]() { order.push_back(1); });
+
+    ASSERT_TRUE(semaphore.waitFor(std::chrono::milliseconds(2000)));
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), order);
+}
+
+TEST_F(TimerWheelTest, cancelledCallbackIsNotInvoked)
+{
+    std::atomic<bool> invoked(false);
+    const TimerWheel::TimerId timerId =
+            timerWheel->schedule(std::chrono::milliseconds(10), [&invoked]() { invoked = true; });
+    EXPECT_TRUE(timerWheel->cancel(timerId));
+    EXPECT_FALSE(timerWheel->cancel(timerId));
+    EXPECT_EQ(0, timerWheel->getNumberOfTimers());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(invoked);
+}
+
+TEST_F(TimerWheelTest, earlierTimeoutRearmsWheel)
+{
+    Semaphore semaphore(0);
+    timerWheel->schedule(std::chrono::milliseconds(5000), []() {});
+    const auto start = std::chrono::steady_clock::now();
+    timerWheel->schedule(std::chrono::milliseconds(10), [&semaphore]() { semaphore.notify(); });
+
+    ASSERT_TRUE(semaphore.waitFor(std::chrono::milliseconds(1000)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    EXPECT_EQ(1, timerWheel->getNumberOfTimers());
+}
+
+TEST_F(TimerWheelTest, callbackMayScheduleFurtherTimeouts)
+{
+    Semaphore semaphore(0);
+    timerWheel->schedule(std::chrono::milliseconds(5), [this, &semaphore]() {
+        timerWheel->schedule(std::chrono::milliseconds(5), [&semaphore]() { semaphore.notify(); });
+    });
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(1000)));
+}
+
+TEST_F(TimerWheelTest, manyTimeoutsExpire)
+{
+    constexpr int numberOfTimeouts = 10000;
+    std::atomic<int> expired(0);
+    Semaphore semaphore(0);
+    for (int i = 0; i < numberOfTimeouts; ++i) {
+        timerWheel->schedule(std::chrono::milliseconds(i % 400), [&]() {
+            if (++expired == numberOfTimeouts) {
+                semaphore.notify();
+            }
+        });
+    }
+    EXPECT_TRUE(semaphore.waitFor(std::chrono::milliseconds(2000)));
+    EXPECT_EQ(0, timerWheel->getNumberOfTimers());
+}
+
+TEST_F(TimerWheelTest, scheduleAfterShutdownFails)
+{
+    timerWheel->shutdown();
+    EXPECT_EQ(TimerWheel::INVALID_TIMER_ID,
+              timerWheel->schedule(std::chrono::milliseconds(5), []() {}));
+}
+
+TEST_F(TimerWheelTest, getInstanceReturnsSameWheelForSameIOService)
+{
+    auto wheel1 = TimerWheel::getInstance(singleThreadedIOService->getIOService());
+    auto wheel2 = TimerWheel::getInstance(singleThreadedIOService->getIOService());
+    EXPECT_EQ(wheel1, wheel2);
+    EXPECT_NE(timerWheel, wheel1);
+}
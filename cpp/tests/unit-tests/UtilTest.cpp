@@ -18,6 +18,8 @@
  */
 #include <limits>
 #include <string>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -127,6 +129,33 @@ TEST(UtilTest, checkFileExists)
     EXPECT_FALSE(util::fileExists(fileToTest));
 }
 
+TEST(UtilTest, createUuidIsUniqueAcrossThreads)
+{
+    constexpr std::size_t numberOfThreads = 8;
+    constexpr std::size_t uuidsPerThread = 10000;
+    std::vector<std::vector<std::string>> uuidsOfThread(numberOfThreads);
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < numberOfThreads; ++i) {
+        threads.emplace_back([&uuids = uuidsOfThread[i]]() {
+            for (std::size_t j = 0; j < uuidsPerThread; ++j) {
+                uuids.push_back(util::createUuid());
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    std::unordered_set<std::string> uuids;
+    for (const auto& uuidsCreatedByThread : uuidsOfThread) {
+        for (const auto& uuid : uuidsCreatedByThread) {
+            EXPECT_EQ(36, uuid.size());
+            EXPECT_TRUE(uuids.insert(uuid).second) << "duplicate uuid " << uuid;
+        }
+    }
+    EXPECT_EQ(numberOfThreads * uuidsPerThread, uuids.size());
+}
+
 TEST(UtilTest, extractParticipantIdFromMulticastId)
 {
     EXPECT_EQ("participantId",
@@ -0,0 +1,95 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "joynr/WorkStealingQueue.h"
+
+#include "tests/mock/MockRunnable.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+TEST(WorkStealingQueueTest, takeReturnsWorkInFifoOrder)
+{
+    WorkStealingQueue queue(1);
+    std::vector<std::shared_ptr<MockRunnable>> runnables;
+    for (int i = 0; i < 5; ++i) {
+        runnables.push_back(std::make_shared<NiceMock<MockRunnable>>());
+        queue.add(runnables.back());
+    }
+    EXPECT_EQ(5, queue.getQueueLength());
+
+    for (const auto& runnable : runnables) {
+        EXPECT_EQ(runnable, queue.take(0));
+    }
+    EXPECT_EQ(0, queue.getQueueLength());
+    queue.shutdown();
+}
+
+TEST(WorkStealingQueueTest, idleWorkerStealsWorkOfOtherWorkers)
+{
+    WorkStealingQueue queue(4);
+    std::vector<std::shared_ptr<MockRunnable>> runnables;
+    for (int i = 0; i < 4; ++i) {
+        runnables.push_back(std::make_shared<NiceMock<MockRunnable>>());
+        queue.add(runnables.back());
+    }
+
+    // all work is taken by worker 0 although it is distributed over all deques
+    for (const auto& runnable : runnables) {
+        EXPECT_EQ(runnable, queue.take(0));
+    }
+    EXPECT_EQ(0, queue.getQueueLength());
+    queue.shutdown();
+}
+
+TEST(WorkStealingQueueTest, blockedTakeReturnsAddedWork)
+{
+    WorkStealingQueue queue(2);
+    auto runnable = std::make_shared<NiceMock<MockRunnable>>();
+
+    auto takenRunnable = std::async(std::launch::async, [&queue]() { return queue.take(1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.add(runnable);
+
+    ASSERT_EQ(std::future_status::ready, takenRunnable.wait_for(std::chrono::milliseconds(1000)));
+    EXPECT_EQ(runnable, takenRunnable.get());
+    queue.shutdown();
+}
+
+TEST(WorkStealingQueueTest, shutdownUnblocksTakeAndDropsPendingWork)
+{
+    WorkStealingQueue queue(2);
+
+    auto takenRunnable = std::async(std::launch::async, [&queue]() { return queue.take(0); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.shutdown();
+
+    ASSERT_EQ(std::future_status::ready, takenRunnable.wait_for(std::chrono::milliseconds(1000)));
+    EXPECT_EQ(nullptr, takenRunnable.get());
+
+    queue.add(std::make_shared<NiceMock<MockRunnable>>());
+    EXPECT_EQ(nullptr, queue.take(0));
+}
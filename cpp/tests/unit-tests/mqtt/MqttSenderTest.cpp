@@ -16,6 +16,10 @@
  * limitations under the License.
  * #L%
  */
+#include <map>
+#include <string>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "joynr/ClusterControllerSettings.h"
@@ -152,4 +156,62 @@ TEST_F(MqttSenderTest, TestWithDisabledMessageSizeCheck)
     EXPECT_FALSE(gotCalled);
 }
 
+TEST_F(MqttSenderTest, messagesToSameRecipientArePublishedViaSameConnection)
+{
+    Settings testSettings("test-resources/MqttSenderTestWithMaxMessageSizeLimits2.settings");
+    MessagingSettings messagingSettings(testSettings);
+    ClusterControllerSettings ccSettings(testSettings);
+
+    constexpr std::size_t numberOfConnections = 3;
+    std::vector<std::shared_ptr<MosquittoConnection>> connections;
+    std::map<std::string, std::vector<std::size_t>> connectionsByTopic;
+    for (std::size_t i = 0; i < numberOfConnections; ++i) {
+        auto connection = std::make_shared<NiceMock<MockMosquittoConnection>>(
+                messagingSettings, ccSettings, "testClientId-" + std::to_string(i));
+        ON_CALL(*connection, isSubscribedToChannelTopic()).WillByDefault(Return(i == 0));
+        ON_CALL(*connection, getMqttQos()).WillByDefault(Return(0));
+        ON_CALL(*connection, getMqttPrio()).WillByDefault(Return("low"));
+        auto recordTopic = [&connectionsByTopic, i](const std::string& topic) {
+            connectionsByTopic[topic].push_back(i);
+        };
+        ON_CALL(*connection, publishMessage(_, _, _, _, _))
+                .WillByDefault(WithArg<0>(Invoke(recordTopic)));
+        connections.push_back(connection);
+    }
+    mqttSender = std::make_shared<MqttSender>(connections, messagingSettings);
+
+    constexpr std::size_t numberOfRecipients = 32;
+    constexpr std::size_t messagesPerRecipient = 4;
+    for (std::size_t j = 0; j < messagesPerRecipient; ++j) {
+        for (std::size_t i = 0; i < numberOfRecipients; ++i) {
+            MutableMessage mutableMessage;
+            mutableMessage.setType(joynr::Message::VALUE_MESSAGE_TYPE_REQUEST());
+            mutableMessage.setSender("testSender");
+            mutableMessage.setRecipient("testRecipient" + std::to_string(i));
+            mutableMessage.setPayload("shortMessage");
+            bool gotCalled = false;
+            mqttSender->sendMessage(mqttAddress,
+                                    mutableMessage.getImmutableMessage(),
+                                    [&gotCalled](const exceptions::JoynrRuntimeException&) {
+                gotCalled = true;
+            });
+            EXPECT_FALSE(gotCalled);
+        }
+    }
+
+    ASSERT_EQ(numberOfRecipients, connectionsByTopic.size());
+    std::vector<bool> usedConnections(numberOfConnections, false);
+    for (const auto& entry : connectionsByTopic) {
+        const std::vector<std::size_t>& usedForTopic = entry.second;
+        ASSERT_EQ(messagesPerRecipient, usedForTopic.size());
+        for (std::size_t connectionIndex : usedForTopic) {
+            EXPECT_EQ(usedForTopic.front(), connectionIndex);
+        }
+        usedConnections[usedForTopic.front()] = true;
+    }
+    for (std::size_t i = 0; i < numberOfConnections; ++i) {
+        EXPECT_TRUE(usedConnections[i]);
+    }
+}
+
 } // namespace joynr
@@ -0,0 +1,76 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/Request.h"
+#include "joynr/serializer/ByteArrayViewIStream.h"
+#include "joynr/serializer/Serializer.h"
+
+using namespace joynr;
+
+TEST(ByteArrayViewIStreamTest, readsOnlyReferencedBytes)
+{
+    const std::string content = "abcdef";
+    const smrf::ByteVector bytes(content.cbegin(), content.cend());
+    serializer::ByteArrayViewIStream stream(smrf::ByteArrayView(bytes.data(), 3));
+
+    EXPECT_EQ('a', stream.Peek());
+    EXPECT_EQ(0, stream.Tell());
+    EXPECT_EQ('a', stream.Take());
+    EXPECT_EQ('b', stream.Take());
+    EXPECT_EQ('c', stream.Take());
+    EXPECT_EQ(3, stream.Tell());
+    EXPECT_EQ('\0', stream.Peek());
+    EXPECT_EQ('\0', stream.Take());
+    EXPECT_EQ(3, stream.Tell());
+}
+
+TEST(ByteArrayViewIStreamTest, deserializeRequestFromByteArrayView)
+{
+    Request request;
+    request.setMethodName("methodName");
+    request.setRequestReplyId("requestReplyId");
+    request.setParamDatatypes({"String", "Integer"});
+    request.setParams(std::string("Hello World"), 42);
+    const std::string json = serializer::serializeToJson(request);
+
+    // the body of a message is not null-terminated, so let the view
+    // reference only a part of the underlying buffer
+    smrf::ByteVector bytes(json.cbegin(), json.cend());
+    bytes.push_back('}');
+    bytes.push_back('#');
+    const smrf::ByteArrayView view(bytes.data(), json.size());
+
+    Request deserializedRequest;
+    serializer::deserializeFromJson(deserializedRequest, view);
+
+    EXPECT_EQ(request.getMethodName(), deserializedRequest.getMethodName());
+    EXPECT_EQ(request.getRequestReplyId(), deserializedRequest.getRequestReplyId());
+    EXPECT_EQ(request.getParamDatatypes(), deserializedRequest.getParamDatatypes());
+    std::string stringParam;
+    int intParam;
+    deserializedRequest.getParams(stringParam, intParam);
+    EXPECT_EQ("Hello World", stringParam);
+    EXPECT_EQ(42, intParam);
+}
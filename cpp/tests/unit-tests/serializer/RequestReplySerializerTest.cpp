@@ -228,6 +228,8 @@ protected:
 
 struct JsonSerializer
 {
+    using Tag = muesli::tags::json;
+
     template <typename Stream>
     using OutputArchive = muesli::JsonOutputArchive<Stream>;
 
@@ -235,8 +237,19 @@ struct JsonSerializer
     using InputArchive = muesli::JsonInputArchive<Stream>;
 };
 
+struct BinarySerializer
+{
+    using Tag = joynr::serializer::tags::binary;
+
+    template <typename Stream>
+    using OutputArchive = joynr::serializer::BinaryOutputArchive<Stream>;
+
+    template <typename Stream>
+    using InputArchive = joynr::serializer::BinaryInputArchive<Stream>;
+};
+
 // typelist of serializers which shall be tested in the following tests
-using Serializers = ::testing::Types<JsonSerializer>;
+using Serializers = ::testing::Types<JsonSerializer, BinarySerializer>;
 
 TYPED_TEST_CASE(RequestReplySerializerTest, Serializers);
 
@@ -301,8 +314,10 @@ TYPED_TEST(RequestReplySerializerTest, serializeMessage)
     // Create a Request
     const bool isLocalMessage = true;
     joynr::Request outgoingRequest = this->initializeRequestWithPrimitiveValues();
+    joynr::MessagingQos qos;
+    qos.setSerializer(joynr::serializer::SerializerTraits<typename TypeParam::Tag>::id());
     joynr::MutableMessage outgoingMessage = joynr::MutableMessageFactory().createRequest(
-            "sender", "receiver", joynr::MessagingQos(), outgoingRequest, isLocalMessage);
+            "sender", "receiver", qos, outgoingRequest, isLocalMessage);
     std::unique_ptr<joynr::ImmutableMessage> incomingMessage =
             outgoingMessage.getImmutableMessage();
 
@@ -377,3 +392,46 @@ TYPED_TEST(RequestReplySerializerTest, serialize_deserialize_ReplyWithArrayAsRes
     joynr::Reply reply = this->initReply(requestReplyId, responseTuple);
     this->compareReplyData(reply, responseTuple, this->getIndicesForTuple(responseTuple));
 }
+
+TEST(BinarySerializerTest, requestIsDeserializedWithSerializerOfMessage)
+{
+    joynr::Request outgoingRequest;
+    outgoingRequest.setMethodName("realMethod");
+    outgoingRequest.setRequestReplyId("000-10000-01012");
+    outgoingRequest.setParamDatatypes({"String", "Integer"});
+    outgoingRequest.setParams(std::string("Hello World"), 101);
+
+    joynr::MessagingQos qos;
+    qos.setSerializer(joynr::serializer::SerializerTraits<joynr::serializer::tags::binary>::id());
+    const bool isLocalMessage = false;
+    joynr::MutableMessage outgoingMessage = joynr::MutableMessageFactory().createRequest(
+            "sender", "receiver", qos, outgoingRequest, isLocalMessage);
+    std::unique_ptr<joynr::ImmutableMessage> incomingMessage =
+            outgoingMessage.getImmutableMessage();
+    ASSERT_TRUE(incomingMessage->getSerializer().is_initialized());
+    EXPECT_EQ("binary", *incomingMessage->getSerializer());
+
+    joynr::Request incomingRequest;
+    joynr::serializer::deserialize(incomingRequest,
+                                   incomingMessage->getUnencryptedBody(),
+                                   incomingMessage->getSerializer());
+    EXPECT_EQ(outgoingRequest.getMethodName(), incomingRequest.getMethodName());
+    EXPECT_EQ(outgoingRequest.getRequestReplyId(), incomingRequest.getRequestReplyId());
+
+    std::string stringParam;
+    int intParam;
+    incomingRequest.getParams(stringParam, intParam);
+    EXPECT_EQ("Hello World", stringParam);
+    EXPECT_EQ(101, intParam);
+}
+
+TEST(BinarySerializerTest, jsonMessagesDoNotCarrySerializerHeader)
+{
+    joynr::Request outgoingRequest;
+    outgoingRequest.setMethodName("realMethod");
+    const bool isLocalMessage = false;
+    joynr::MutableMessage outgoingMessage = joynr::MutableMessageFactory().createRequest(
+            "sender", "receiver", joynr::MessagingQos(), outgoingRequest, isLocalMessage);
+    EXPECT_FALSE(outgoingMessage.getSerializer().is_initialized());
+    EXPECT_FALSE(outgoingMessage.getImmutableMessage()->getSerializer().is_initialized());
+}
@@ -0,0 +1,125 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <unistd.h>
+
+#include <boost/asio/local/stream_protocol.hpp>
+
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+#include "libjoynr/shared-memory/SharedMemoryMessagingStubFactory.h"
+#include "libjoynrclustercontroller/shared-memory/SharedMemoryCcMessagingSkeleton.h"
+#include "tests/mock/MockMessageRouter.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class SharedMemoryCcMessagingSkeletonTest : public ::testing::Test
+{
+public:
+    SharedMemoryCcMessagingSkeletonTest()
+            : path("/tmp/joynr-shm-skeleton-test-" + std::to_string(::getpid()) + "-" +
+                   std::to_string(counter++)),
+              singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              messageRouter(
+                      std::make_shared<MockMessageRouter>(singleThreadedIOService->getIOService()))
+    {
+        std::remove(path.c_str());
+        singleThreadedIOService->start();
+    }
+
+    ~SharedMemoryCcMessagingSkeletonTest()
+    {
+        singleThreadedIOService->stop();
+        std::remove(path.c_str());
+    }
+
+protected:
+    std::shared_ptr<SharedMemoryCcMessagingSkeleton> createSkeleton()
+    {
+        return std::make_shared<SharedMemoryCcMessagingSkeleton>(
+                singleThreadedIOService->getIOService(),
+                messageRouter,
+                std::make_shared<SharedMemoryMessagingStubFactory>(),
+                system::RoutingTypes::SharedMemoryAddress(path));
+    }
+
+    bool isListening()
+    {
+        boost::asio::local::stream_protocol::socket socket(
+                singleThreadedIOService->getIOService());
+        boost::system::error_code error;
+        socket.connect(boost::asio::local::stream_protocol::endpoint(path), error);
+        return !error;
+    }
+
+    static std::atomic<int> counter;
+    const std::string path;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    std::shared_ptr<MockMessageRouter> messageRouter;
+};
+
+std::atomic<int> SharedMemoryCcMessagingSkeletonTest::counter(0);
+
+TEST_F(SharedMemoryCcMessagingSkeletonTest, staleSocketIsReplaced)
+{
+    {
+        // bound, but nobody accepts connections any more
+        boost::asio::local::stream_protocol::acceptor acceptor(
+                singleThreadedIOService->getIOService());
+        acceptor.open();
+        acceptor.bind(boost::asio::local::stream_protocol::endpoint(path));
+    }
+    ASSERT_FALSE(isListening());
+
+    auto skeleton = createSkeleton();
+    EXPECT_NO_THROW(skeleton->init());
+    EXPECT_TRUE(isListening());
+    skeleton->shutdown();
+}
+
+TEST_F(SharedMemoryCcMessagingSkeletonTest, socketOfRunningServerIsNotTakenOver)
+{
+    auto runningSkeleton = createSkeleton();
+    runningSkeleton->init();
+
+    auto secondSkeleton = createSkeleton();
+    EXPECT_THROW(secondSkeleton->init(), exceptions::JoynrRuntimeException);
+    EXPECT_TRUE(isListening());
+
+    runningSkeleton->shutdown();
+    EXPECT_FALSE(isListening());
+}
+
+TEST_F(SharedMemoryCcMessagingSkeletonTest, pathWhichIsNotASocketIsNotRemoved)
+{
+    std::ofstream(path) << "data";
+
+    auto skeleton = createSkeleton();
+    EXPECT_THROW(skeleton->init(), exceptions::JoynrRuntimeException);
+    EXPECT_TRUE(std::ifstream(path).good());
+}
@@ -0,0 +1,229 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/Settings.h"
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/SharedMemorySettings.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/exceptions/JoynrException.h"
+#include "joynr/system/RoutingTypes/SharedMemoryAddress.h"
+#include "libjoynr/shared-memory/SharedMemoryClient.h"
+#include "libjoynr/shared-memory/SharedMemorySender.h"
+
+using namespace joynr;
+
+class SharedMemoryClientTest : public ::testing::Test
+{
+public:
+    SharedMemoryClientTest()
+            : path("/tmp/joynr-shm-client-test-" + std::to_string(::getpid()) + "-" +
+                   std::to_string(counter++)),
+              settings(),
+              sharedMemorySettings(settings),
+              singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              acceptor(singleThreadedIOService->getIOService()),
+              serverConnection(),
+              serverConnected(0),
+              client()
+    {
+        sharedMemorySettings.setClusterControllerMessagingPath(path);
+        sharedMemorySettings.setRingBufferSize(4096);
+        sharedMemorySettings.setReconnectSleepTimeMs(std::chrono::milliseconds(10));
+
+        std::remove(path.c_str());
+        acceptor.open();
+        acceptor.bind(boost::asio::local::stream_protocol::endpoint(path));
+        acceptor.listen();
+        singleThreadedIOService->start();
+
+        client = std::make_shared<SharedMemoryClient>(
+                sharedMemorySettings, singleThreadedIOService->getIOService());
+    }
+
+    ~SharedMemoryClientTest()
+    {
+        client->stop();
+        boost::system::error_code ignored;
+        acceptor.close(ignored);
+        if (serverConnection) {
+            serverConnection->close();
+        }
+        singleThreadedIOService->stop();
+        std::remove(path.c_str());
+    }
+
+protected:
+    void acceptClient(std::function<void(const smrf::ByteArrayView&)> onFrameReceived = nullptr)
+    {
+        auto socket = std::make_shared<SharedMemoryConnection::Socket>(
+                singleThreadedIOService->getIOService());
+        acceptor.async_accept(*socket, [this, socket, onFrameReceived](
+                                               const boost::system::error_code& error) {
+            ASSERT_FALSE(error);
+            SharedMemoryConnection::asyncAccept(
+                    singleThreadedIOService->getIOService(),
+                    std::move(*socket),
+                    [this, onFrameReceived](const boost::system::error_code& acceptError,
+                                            std::shared_ptr<SharedMemoryConnection> connection) {
+                        ASSERT_FALSE(acceptError);
+                        serverConnection = std::move(connection);
+                        serverConnection->start(onFrameReceived ? onFrameReceived
+                                                                : [](const smrf::ByteArrayView&) {},
+                                                nullptr);
+                        serverConnected.notify();
+                    });
+        });
+    }
+
+    static std::function<void(const exceptions::JoynrRuntimeException&)> failOnError()
+    {
+        return [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); };
+    }
+
+    static std::atomic<int> counter;
+    const std::string path;
+    Settings settings;
+    SharedMemorySettings sharedMemorySettings;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    boost::asio::local::stream_protocol::acceptor acceptor;
+    std::shared_ptr<SharedMemoryConnection> serverConnection;
+    Semaphore serverConnected;
+    std::shared_ptr<SharedMemoryClient> client;
+};
+
+std::atomic<int> SharedMemoryClientTest::counter(0);
+
+TEST_F(SharedMemoryClientTest, connectCallbackIsInvokedOnceConnected)
+{
+    auto connected = std::make_shared<Semaphore>(0);
+    client->registerConnectCallback([connected]() { connected->notify(); });
+    acceptClient();
+
+    client->connect(sharedMemorySettings.createClusterControllerMessagingAddress());
+
+    EXPECT_TRUE(serverConnected.waitFor(std::chrono::seconds(5)));
+    EXPECT_TRUE(connected->waitFor(std::chrono::seconds(5)));
+    EXPECT_TRUE(client->isConnected());
+}
+
+TEST_F(SharedMemoryClientTest, clientRetriesUntilServerIsAvailable)
+{
+    auto connected = std::make_shared<Semaphore>(0);
+    client->registerConnectCallback([connected]() { connected->notify(); });
+    boost::system::error_code ignored;
+    acceptor.close(ignored);
+    std::remove(path.c_str());
+
+    client->connect(sharedMemorySettings.createClusterControllerMessagingAddress());
+    EXPECT_FALSE(connected->waitFor(std::chrono::milliseconds(50)));
+
+    acceptor.open();
+    acceptor.bind(boost::asio::local::stream_protocol::endpoint(path));
+    acceptor.listen();
+    acceptClient();
+
+    EXPECT_TRUE(connected->waitFor(std::chrono::seconds(5)));
+}
+
+TEST_F(SharedMemoryClientTest, reconnectCallbackIsInvokedAfterConnectionLoss)
+{
+    auto connected = std::make_shared<Semaphore>(0);
+    auto reconnected = std::make_shared<Semaphore>(0);
+    auto disconnected = std::make_shared<Semaphore>(0);
+    client->registerConnectCallback([connected]() { connected->notify(); });
+    client->registerReconnectCallback([reconnected]() { reconnected->notify(); });
+    client->registerDisconnectCallback([disconnected]() { disconnected->notify(); });
+    acceptClient();
+
+    client->connect(sharedMemorySettings.createClusterControllerMessagingAddress());
+    ASSERT_TRUE(connected->waitFor(std::chrono::seconds(5)));
+    ASSERT_TRUE(serverConnected.waitFor(std::chrono::seconds(5)));
+
+    std::shared_ptr<SharedMemoryConnection> firstConnection = serverConnection;
+    acceptClient();
+    firstConnection->close();
+
+    EXPECT_TRUE(reconnected->waitFor(std::chrono::seconds(5)));
+    EXPECT_TRUE(serverConnected.waitFor(std::chrono::seconds(5)));
+    EXPECT_FALSE(connected->waitFor(std::chrono::milliseconds(10)));
+    // the disconnect callback is reserved for the final close
+    EXPECT_FALSE(disconnected->waitFor(std::chrono::milliseconds(10)));
+}
+
+TEST_F(SharedMemoryClientTest, framesSentFromConnectCallbackArriveFirst)
+{
+    const std::string initMessage("init");
+    const std::string message("message");
+    auto firstFrame = std::make_shared<std::string>();
+    auto received = std::make_shared<Semaphore>(0);
+    acceptClient([firstFrame, received](const smrf::ByteArrayView& frame) {
+        if (firstFrame->empty()) {
+            firstFrame->assign(reinterpret_cast<const char*>(frame.data()), frame.size());
+        }
+        received->notify();
+    });
+
+    // the sender is not usable before the connect callback has finished
+    std::weak_ptr<SharedMemoryClient> weakClient(client);
+    client->registerConnectCallback([weakClient, &initMessage]() {
+        if (auto client = weakClient.lock()) {
+            EXPECT_FALSE(client->getSender()->isConnected());
+            smrf::ByteVector frame(initMessage.begin(), initMessage.end());
+            client->send(smrf::ByteArrayView(frame), failOnError());
+        }
+    });
+    client->connect(sharedMemorySettings.createClusterControllerMessagingAddress());
+
+    ASSERT_TRUE(received->waitFor(std::chrono::seconds(5)));
+    EXPECT_EQ(initMessage, *firstFrame);
+    EXPECT_TRUE(client->getSender()->isConnected());
+
+    smrf::ByteVector frame(message.begin(), message.end());
+    client->getSender()->send(smrf::ByteArrayView(frame), failOnError());
+    EXPECT_TRUE(received->waitFor(std::chrono::seconds(5)));
+}
+
+TEST_F(SharedMemoryClientTest, receivedFramesAreForwarded)
+{
+    auto received = std::make_shared<Semaphore>(0);
+    const smrf::ByteVector payload{1, 2, 3, 4};
+    client->registerReceiveCallback([received, payload](smrf::ByteVector&& message) {
+        EXPECT_EQ(payload, message);
+        received->notify();
+    });
+    acceptClient();
+
+    client->connect(sharedMemorySettings.createClusterControllerMessagingAddress());
+    ASSERT_TRUE(serverConnected.waitFor(std::chrono::seconds(5)));
+
+    serverConnection->send(smrf::ByteArrayView(payload), failOnError());
+    EXPECT_TRUE(received->waitFor(std::chrono::seconds(5)));
+}
@@ -0,0 +1,340 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <linux/memfd.h>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/Semaphore.h"
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/SharedMemoryRingBuffer.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/exceptions/JoynrException.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class SharedMemoryConnectionTest : public ::testing::Test
+{
+public:
+    SharedMemoryConnectionTest()
+            : capacity(4096),
+              path("/tmp/joynr-shm-test-" + std::to_string(::getpid()) + "-" +
+                   std::to_string(counter++)),
+              singleThreadedIOService(std::make_shared<SingleThreadedIOService>()),
+              acceptor(singleThreadedIOService->getIOService()),
+              serverConnection(),
+              serverConnected(0),
+              handshakeClient()
+    {
+        std::remove(path.c_str());
+        acceptor.open();
+        acceptor.bind(boost::asio::local::stream_protocol::endpoint(path));
+        acceptor.listen();
+        singleThreadedIOService->start();
+    }
+
+    ~SharedMemoryConnectionTest()
+    {
+        boost::system::error_code ignored;
+        acceptor.close(ignored);
+        if (serverConnection) {
+            serverConnection->close();
+        }
+        singleThreadedIOService->stop();
+        std::remove(path.c_str());
+    }
+
+protected:
+    void acceptOneClient(std::function<void(const smrf::ByteArrayView&)> onFrameReceived,
+                         std::function<void()> onClosed = nullptr)
+    {
+        auto socket = std::make_shared<SharedMemoryConnection::Socket>(
+                singleThreadedIOService->getIOService());
+        acceptor.async_accept(*socket, [this, socket, onFrameReceived, onClosed](
+                                               const boost::system::error_code& error) {
+            ASSERT_FALSE(error);
+            SharedMemoryConnection::asyncAccept(
+                    singleThreadedIOService->getIOService(),
+                    std::move(*socket),
+                    [this, onFrameReceived, onClosed](
+                            const boost::system::error_code& acceptError,
+                            std::shared_ptr<SharedMemoryConnection> connection) {
+                        ASSERT_FALSE(acceptError);
+                        serverConnection = std::move(connection);
+                        serverConnection->start(onFrameReceived, onClosed);
+                        serverConnected.notify();
+                    });
+        });
+    }
+
+    std::shared_ptr<SharedMemoryConnection> connectClient()
+    {
+        boost::system::error_code error;
+        auto connection = SharedMemoryConnection::connect(
+                singleThreadedIOService->getIOService(), path, capacity, error);
+        EXPECT_FALSE(error) << error.message();
+        EXPECT_TRUE(serverConnected.waitFor(std::chrono::seconds(5)));
+        return connection;
+    }
+
+    std::shared_ptr<Semaphore> expectHandshakeFailure()
+    {
+        auto handshakeFailed = std::make_shared<Semaphore>(0);
+        auto socket = std::make_shared<SharedMemoryConnection::Socket>(
+                singleThreadedIOService->getIOService());
+        acceptor.async_accept(*socket, [this, socket, handshakeFailed](
+                                               const boost::system::error_code& error) {
+            ASSERT_FALSE(error);
+            SharedMemoryConnection::asyncAccept(
+                    singleThreadedIOService->getIOService(),
+                    std::move(*socket),
+                    [handshakeFailed](const boost::system::error_code& acceptError,
+                                      std::shared_ptr<SharedMemoryConnection> connection) {
+                        EXPECT_TRUE(acceptError);
+                        EXPECT_EQ(nullptr, connection);
+                        handshakeFailed->notify();
+                    });
+        });
+        return handshakeFailed;
+    }
+
+    // connects and hands over the given segment and eventfds like SharedMemoryConnection::connect
+    void sendHandshake(const int (&fds)[3])
+    {
+        handshakeClient = std::make_unique<SharedMemoryConnection::Socket>(
+                singleThreadedIOService->getIOService());
+        handshakeClient->connect(boost::asio::local::stream_protocol::endpoint(path));
+        std::uint8_t version = 1;
+        struct iovec iov;
+        iov.iov_base = &version;
+        iov.iov_len = sizeof(version);
+        union {
+            char buffer[CMSG_SPACE(sizeof(fds))];
+            struct cmsghdr align;
+        } control;
+        std::memset(&control, 0, sizeof(control));
+        struct msghdr message;
+        std::memset(&message, 0, sizeof(message));
+        message.msg_iov = &iov;
+        message.msg_iovlen = 1;
+        message.msg_control = control.buffer;
+        message.msg_controllen = sizeof(control.buffer);
+        struct cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+        controlMessage->cmsg_level = SOL_SOCKET;
+        controlMessage->cmsg_type = SCM_RIGHTS;
+        controlMessage->cmsg_len = CMSG_LEN(sizeof(fds));
+        std::memcpy(CMSG_DATA(controlMessage), fds, sizeof(fds));
+        EXPECT_LT(0, ::sendmsg(handshakeClient->native_handle(), &message, MSG_NOSIGNAL));
+    }
+
+    static std::function<void(const exceptions::JoynrRuntimeException&)> failOnError()
+    {
+        return [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); };
+    }
+
+    static std::atomic<int> counter;
+    const std::size_t capacity;
+    const std::string path;
+    std::shared_ptr<SingleThreadedIOService> singleThreadedIOService;
+    boost::asio::local::stream_protocol::acceptor acceptor;
+    std::shared_ptr<SharedMemoryConnection> serverConnection;
+    Semaphore serverConnected;
+    std::unique_ptr<SharedMemoryConnection::Socket> handshakeClient;
+};
+
+std::atomic<int> SharedMemoryConnectionTest::counter(0);
+
+TEST_F(SharedMemoryConnectionTest, connectFailsWithoutServer)
+{
+    boost::system::error_code error;
+    auto connection = SharedMemoryConnection::connect(
+            singleThreadedIOService->getIOService(), path + "-missing", capacity, error);
+    EXPECT_TRUE(error);
+    EXPECT_EQ(nullptr, connection);
+}
+
+TEST_F(SharedMemoryConnectionTest, framesAreEchoed)
+{
+    constexpr std::size_t numberOfFrames = 10000;
+
+    acceptOneClient([this](const smrf::ByteArrayView& frame) {
+        serverConnection->send(frame, [](const exceptions::JoynrRuntimeException&) {
+            FAIL() << "echo failed";
+        });
+    });
+
+    std::atomic<std::size_t> received(0);
+    auto allReceived = std::make_shared<Semaphore>(0);
+    auto client = connectClient();
+    ASSERT_TRUE(client);
+    const smrf::ByteVector payload(200, 42);
+    client->start(
+            [&payload, &received, allReceived](const smrf::ByteArrayView& frame) {
+                EXPECT_EQ(payload, smrf::ByteVector(frame.data(), frame.data() + frame.size()));
+                if (++received == numberOfFrames) {
+                    allReceived->notify();
+                }
+            },
+            nullptr);
+
+    // limit the frames in flight so that the echoes always fit into the ring buffer
+    constexpr std::size_t maxFramesInFlight = 8;
+    std::size_t sent = 0;
+    while (sent < numberOfFrames) {
+        if (sent - received >= maxFramesInFlight) {
+            std::this_thread::yield();
+            continue;
+        }
+        bool delayed = false;
+        client->send(smrf::ByteArrayView(payload),
+                     [&delayed](const exceptions::JoynrRuntimeException& e) {
+                         EXPECT_EQ(exceptions::JoynrDelayMessageException::TYPE_NAME(),
+                                   e.getTypeName());
+                         delayed = true;
+                     });
+        if (delayed) {
+            std::this_thread::yield();
+        } else {
+            ++sent;
+        }
+    }
+
+    EXPECT_TRUE(allReceived->waitFor(std::chrono::seconds(10)));
+    client->close();
+}
+
+TEST_F(SharedMemoryConnectionTest, tooLargeFrameIsNotSent)
+{
+    acceptOneClient([](const smrf::ByteArrayView&) {});
+    auto client = connectClient();
+    ASSERT_TRUE(client);
+
+    const smrf::ByteVector payload(capacity, 0);
+    bool failed = false;
+    client->send(smrf::ByteArrayView(payload),
+                 [&failed](const exceptions::JoynrRuntimeException& e) {
+                     EXPECT_EQ(exceptions::JoynrMessageNotSentException::TYPE_NAME(),
+                               e.getTypeName());
+                     failed = true;
+                 });
+    EXPECT_TRUE(failed);
+    client->close();
+}
+
+TEST_F(SharedMemoryConnectionTest, peerIsNotifiedWhenConnectionIsClosed)
+{
+    auto serverClosed = std::make_shared<Semaphore>(0);
+    auto frameReceived = std::make_shared<Semaphore>(0);
+    acceptOneClient([frameReceived](const smrf::ByteArrayView&) { frameReceived->notify(); },
+                    [serverClosed]() { serverClosed->notify(); });
+    auto client = connectClient();
+    ASSERT_TRUE(client);
+    client->start([](const smrf::ByteArrayView&) {}, nullptr);
+
+    const smrf::ByteVector payload(10, 1);
+    client->send(smrf::ByteArrayView(payload), failOnError());
+    EXPECT_TRUE(frameReceived->waitFor(std::chrono::seconds(5)));
+
+    client->close();
+    EXPECT_TRUE(serverClosed->waitFor(std::chrono::seconds(5)));
+    EXPECT_FALSE(serverConnection->isOpen());
+
+    bool delayed = false;
+    serverConnection->send(smrf::ByteArrayView(payload),
+                           [&delayed](const exceptions::JoynrRuntimeException& e) {
+                               EXPECT_EQ(exceptions::JoynrDelayMessageException::TYPE_NAME(),
+                                         e.getTypeName());
+                               delayed = true;
+                           });
+    EXPECT_TRUE(delayed);
+}
+
+TEST_F(SharedMemoryConnectionTest, unsealedSegmentIsRejected)
+{
+    auto handshakeFailed = expectHandshakeFailure();
+
+    // hand over a segment which the client could still resize at any time
+    const int fds[3] = {static_cast<int>(::syscall(SYS_memfd_create, "test", MFD_CLOEXEC)),
+                        ::eventfd(0, EFD_CLOEXEC),
+                        ::eventfd(0, EFD_CLOEXEC)};
+    ASSERT_EQ(0, ::ftruncate(fds[0], 65536));
+    sendHandshake(fds);
+
+    EXPECT_TRUE(handshakeFailed->waitFor(std::chrono::seconds(5)));
+    for (const int fd : fds) {
+        ::close(fd);
+    }
+}
+
+TEST_F(SharedMemoryConnectionTest, pipeInsteadOfEventFdIsRejected)
+{
+    auto handshakeFailed = expectHandshakeFailure();
+
+    // a blocking pipe would block the server as soon as it is full
+    int pipeFds[2];
+    ASSERT_EQ(0, ::pipe2(pipeFds, O_CLOEXEC));
+    const int fds[3] = {static_cast<int>(::syscall(SYS_memfd_create,
+                                                   "test",
+                                                   MFD_CLOEXEC | MFD_ALLOW_SEALING)),
+                        pipeFds[1],
+                        pipeFds[0]};
+    // apart from the eventfds the segment is valid
+    const std::size_t ringBufferSize =
+            (SharedMemoryRingBuffer::getRequiredSize(capacity) + 63) / 64 * 64;
+    const std::size_t mappingSize = 64 + 2 * ringBufferSize;
+    ASSERT_EQ(0, ::ftruncate(fds[0], static_cast<off_t>(mappingSize)));
+    void* memory = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fds[0], 0);
+    ASSERT_NE(MAP_FAILED, memory);
+    // magic, version and the 64 bit capacity
+    const std::uint32_t segmentHeader[4] = {
+            0x6a6f796e, 1, static_cast<std::uint32_t>(capacity), 0};
+    std::memcpy(memory, segmentHeader, sizeof(segmentHeader));
+    for (std::size_t index = 0; index < 2; ++index) {
+        void* ringBufferMemory =
+                static_cast<std::uint8_t*>(memory) + 64 + index * ringBufferSize;
+        SharedMemoryRingBuffer(ringBufferMemory, capacity).initialize();
+    }
+    ::munmap(memory, mappingSize);
+    ASSERT_EQ(0, ::fcntl(fds[0], F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL));
+    sendHandshake(fds);
+
+    EXPECT_TRUE(handshakeFailed->waitFor(std::chrono::seconds(5)));
+    for (const int fd : fds) {
+        ::close(fd);
+    }
+}
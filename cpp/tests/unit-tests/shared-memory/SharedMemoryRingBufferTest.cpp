@@ -0,0 +1,274 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <smrf/ByteArrayView.h>
+#include <smrf/ByteVector.h>
+
+#include "joynr/SharedMemoryRingBuffer.h"
+#include "joynr/exceptions/JoynrException.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class SharedMemoryRingBufferTest : public ::testing::Test
+{
+public:
+    SharedMemoryRingBufferTest()
+            : capacity(256),
+              memory(static_cast<std::uint8_t*>(
+                      aligned_alloc(64, SharedMemoryRingBuffer::getRequiredSize(capacity))),
+                     &std::free),
+              producer(memory.get(), capacity),
+              consumer(memory.get(), capacity)
+    {
+        producer.initialize();
+    }
+
+protected:
+    static smrf::ByteVector createFrame(std::size_t size, std::uint8_t seed)
+    {
+        smrf::ByteVector frame(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            frame[i] = static_cast<std::uint8_t>(seed + i);
+        }
+        return frame;
+    }
+
+    std::vector<smrf::ByteVector> readAll()
+    {
+        std::vector<smrf::ByteVector> frames;
+        consumer.read([&frames](const smrf::ByteArrayView& frame) {
+            frames.emplace_back(frame.data(), frame.data() + frame.size());
+        });
+        return frames;
+    }
+
+    // the peer owning the other end may write arbitrary values into the shared
+    // state; these helpers simulate that based on the layout of the buffer:
+    // write position, read position and the waiting flag in separate cache lines
+    // followed by the frames, each preceded by its 32 bit length
+    void setWritePosition(std::uint64_t position)
+    {
+        std::memcpy(memory.get(), &position, sizeof(position));
+    }
+
+    void setReadPosition(std::uint64_t position)
+    {
+        std::memcpy(memory.get() + 64, &position, sizeof(position));
+    }
+
+    void setFrameLength(std::size_t offset, std::uint32_t length)
+    {
+        const std::size_t dataOffset = SharedMemoryRingBuffer::getRequiredSize(capacity) - capacity;
+        std::memcpy(memory.get() + dataOffset + offset, &length, sizeof(length));
+    }
+
+    void expectReadIsRejected()
+    {
+        bool onFrameInvoked = false;
+        EXPECT_THROW(consumer.read([&onFrameInvoked](const smrf::ByteArrayView&) {
+            onFrameInvoked = true;
+        }),
+                     exceptions::JoynrRuntimeException);
+        EXPECT_FALSE(onFrameInvoked);
+    }
+
+    const std::size_t capacity;
+    std::unique_ptr<std::uint8_t, decltype(&std::free)> memory;
+    // producer and consumer share the memory like two processes would do
+    SharedMemoryRingBuffer producer;
+    SharedMemoryRingBuffer consumer;
+};
+
+TEST_F(SharedMemoryRingBufferTest, framesAreReadInOrder)
+{
+    const smrf::ByteVector frame1 = createFrame(10, 1);
+    const smrf::ByteVector frame2 = createFrame(0, 2);
+    const smrf::ByteVector frame3 = createFrame(33, 3);
+
+    EXPECT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame1)));
+    EXPECT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame2)));
+    EXPECT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame3)));
+
+    const std::vector<smrf::ByteVector> frames = readAll();
+    ASSERT_EQ(3, frames.size());
+    EXPECT_EQ(frame1, frames[0]);
+    EXPECT_EQ(frame2, frames[1]);
+    EXPECT_EQ(frame3, frames[2]);
+    EXPECT_TRUE(readAll().empty());
+}
+
+TEST_F(SharedMemoryRingBufferTest, writeFailsWhileBufferIsFull)
+{
+    const smrf::ByteVector frame = createFrame(56, 0);
+    std::size_t written = 0;
+    while (producer.tryWrite(smrf::ByteArrayView(frame))) {
+        ++written;
+    }
+    EXPECT_EQ(capacity / (frame.size() + 8), written);
+
+    EXPECT_EQ(written, readAll().size());
+    EXPECT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+}
+
+TEST_F(SharedMemoryRingBufferTest, tooLargeFrameIsRejected)
+{
+    const smrf::ByteVector largestFrame = createFrame(producer.getMaxFrameSize(), 0);
+    const smrf::ByteVector tooLargeFrame = createFrame(producer.getMaxFrameSize() + 1, 0);
+
+    EXPECT_FALSE(producer.tryWrite(smrf::ByteArrayView(tooLargeFrame)));
+    EXPECT_TRUE(producer.tryWrite(smrf::ByteArrayView(largestFrame)));
+}
+
+TEST_F(SharedMemoryRingBufferTest, framesWrapAroundAtTheEndOfTheBuffer)
+{
+    for (std::uint8_t i = 0; i < 200; ++i) {
+        const smrf::ByteVector frame = createFrame(1 + (i * 7) % 100, i);
+        ASSERT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+
+        const std::vector<smrf::ByteVector> frames = readAll();
+        ASSERT_EQ(1, frames.size());
+        EXPECT_EQ(frame, frames[0]);
+    }
+}
+
+TEST_F(SharedMemoryRingBufferTest, consumerIsWokenUpOnlyIfWaiting)
+{
+    const smrf::ByteVector frame = createFrame(8, 0);
+
+    ASSERT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+    EXPECT_FALSE(producer.consumerNeedsWakeup());
+
+    // pending frames have to be read before waiting
+    EXPECT_FALSE(consumer.prepareWait());
+    readAll();
+    EXPECT_TRUE(consumer.prepareWait());
+
+    ASSERT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+    EXPECT_TRUE(producer.consumerNeedsWakeup());
+    EXPECT_FALSE(producer.consumerNeedsWakeup());
+}
+
+TEST_F(SharedMemoryRingBufferTest, concurrentProducerAndConsumer)
+{
+    constexpr std::uint32_t numberOfFrames = 10000;
+
+    std::thread producerThread([this]() {
+        for (std::uint32_t i = 0; i < numberOfFrames; ++i) {
+            const smrf::ByteVector frame = createFrame(4 + i % 50, static_cast<std::uint8_t>(i));
+            while (!producer.tryWrite(smrf::ByteArrayView(frame))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::uint32_t received = 0;
+    bool framesAreIntact = true;
+    while (received < numberOfFrames) {
+        const std::size_t numberOfFramesRead =
+                consumer.read([&](const smrf::ByteArrayView& frame) {
+                    const smrf::ByteVector expected =
+                            createFrame(4 + received % 50, static_cast<std::uint8_t>(received));
+                    framesAreIntact &=
+                            smrf::ByteVector(frame.data(), frame.data() + frame.size()) ==
+                            expected;
+                    ++received;
+                });
+        if (numberOfFramesRead == 0) {
+            std::this_thread::yield();
+        }
+    }
+    producerThread.join();
+
+    EXPECT_TRUE(framesAreIntact);
+    EXPECT_TRUE(readAll().empty());
+}
+
+TEST_F(SharedMemoryRingBufferTest, frameLengthExceedingTheBufferIsRejected)
+{
+    const smrf::ByteVector frame = createFrame(16, 0);
+    ASSERT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+    setFrameLength(0, static_cast<std::uint32_t>(capacity));
+
+    expectReadIsRejected();
+}
+
+TEST_F(SharedMemoryRingBufferTest, frameLengthExceedingTheRemainderOfTheBufferIsRejected)
+{
+    // move the positions close to the end of the buffer
+    setWritePosition(capacity - 16);
+    setReadPosition(capacity - 16);
+    const smrf::ByteVector frame = createFrame(8, 0);
+    ASSERT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+    setFrameLength(capacity - 16, 9);
+
+    expectReadIsRejected();
+}
+
+TEST_F(SharedMemoryRingBufferTest, frameBeyondTheWritePositionIsRejected)
+{
+    const smrf::ByteVector frame = createFrame(8, 0);
+    ASSERT_TRUE(producer.tryWrite(smrf::ByteArrayView(frame)));
+    // fits into the buffer, but would make the consumer skip the write position
+    setFrameLength(0, 100);
+
+    expectReadIsRejected();
+}
+
+TEST_F(SharedMemoryRingBufferTest, positionsFurtherApartThanTheCapacityAreRejected)
+{
+    setWritePosition(capacity + 8);
+
+    expectReadIsRejected();
+}
+
+TEST_F(SharedMemoryRingBufferTest, readPositionAheadOfTheWritePositionIsRejected)
+{
+    setReadPosition(8);
+
+    expectReadIsRejected();
+}
+
+TEST_F(SharedMemoryRingBufferTest, misalignedReadPositionIsRejected)
+{
+    setWritePosition(16);
+    setReadPosition(3);
+
+    expectReadIsRejected();
+}
+
+TEST_F(SharedMemoryRingBufferTest, producerDoesNotWriteIfPositionsAreCorrupted)
+{
+    const smrf::ByteVector frame = createFrame(8, 0);
+
+    setReadPosition(64);
+    EXPECT_FALSE(producer.tryWrite(smrf::ByteArrayView(frame)));
+
+    setReadPosition(0);
+    setWritePosition(5);
+    EXPECT_FALSE(producer.tryWrite(smrf::ByteArrayView(frame)));
+}
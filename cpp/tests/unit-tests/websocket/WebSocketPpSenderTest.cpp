@@ -0,0 +1,248 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <smrf/ByteVector.h>
+#include <websocketpp/client.hpp>
+#include <websocketpp/config/asio_no_tls.hpp>
+#include <websocketpp/config/asio_no_tls_client.hpp>
+#include <websocketpp/server.hpp>
+
+#include "joynr/ImmutableMessage.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/Semaphore.h"
+#include "joynr/exceptions/JoynrException.h"
+
+#include "libjoynr/websocket/WebSocketPpSender.h"
+
+using namespace ::testing;
+using namespace joynr;
+
+class WebSocketPpSenderTest : public ::testing::Test
+{
+protected:
+    using Server = websocketpp::server<websocketpp::config::asio>;
+    using Client = websocketpp::client<websocketpp::config::asio_client>;
+    using Frame = Server::message_ptr::element_type;
+    using ConnectionHandle = websocketpp::connection_hdl;
+
+public:
+    WebSocketPpSenderTest()
+            : server(),
+              client(),
+              serverThread(),
+              clientThread(),
+              mutex(),
+              serverConnections(),
+              receivedPayloads(),
+              connected(0),
+              received(0)
+    {
+        server.clear_access_channels(websocketpp::log::alevel::all);
+        server.clear_error_channels(websocketpp::log::elevel::all);
+        server.init_asio();
+        server.set_open_handler([this](ConnectionHandle connectionHandle) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                serverConnections.push_back(connectionHandle);
+            }
+            connected.notify();
+        });
+        // listen on random free port
+        server.listen(0);
+        server.start_accept();
+        serverThread = std::thread(&Server::run, &server);
+
+        client.clear_access_channels(websocketpp::log::alevel::all);
+        client.clear_error_channels(websocketpp::log::elevel::all);
+        client.init_asio();
+        client.start_perpetual();
+        clientThread = std::thread(&Client::run, &client);
+    }
+
+    ~WebSocketPpSenderTest() override
+    {
+        server.stop();
+        client.stop();
+        serverThread.join();
+        clientThread.join();
+    }
+
+protected:
+    // connects a client which stores every received payload in receivedPayloads[index]
+    void connectClient()
+    {
+        websocketpp::lib::error_code websocketError;
+        boost::system::error_code error;
+        const std::uint16_t port = server.get_local_endpoint(error).port();
+        ASSERT_FALSE(error);
+        Client::connection_ptr connection =
+                client.get_connection("ws://localhost:" + std::to_string(port), websocketError);
+        ASSERT_FALSE(websocketError) << websocketError.message();
+        std::size_t index;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            index = receivedPayloads.size();
+            receivedPayloads.emplace_back();
+        }
+        connection->set_message_handler(
+                [this, index](ConnectionHandle, Client::message_ptr message) {
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        receivedPayloads[index].push_back(message->get_payload());
+                    }
+                    received.notify();
+                });
+        client.connect(connection);
+        ASSERT_TRUE(connected.waitFor(std::chrono::seconds(5)));
+    }
+
+    std::shared_ptr<WebSocketPpSender<Server>> createSender(std::size_t connectionIndex,
+                                                            std::size_t sendQueueLimitBytes = 0)
+    {
+        auto sender = std::make_shared<WebSocketPpSender<Server>>(server, sendQueueLimitBytes);
+        std::lock_guard<std::mutex> lock(mutex);
+        sender->setConnectionHandle(serverConnections.at(connectionIndex));
+        return sender;
+    }
+
+    std::vector<std::string> getReceivedPayloads(std::size_t connectionIndex)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return receivedPayloads.at(connectionIndex);
+    }
+
+    static std::shared_ptr<ImmutableMessage> createMessage(std::size_t payloadSize)
+    {
+        MutableMessage mutableMessage;
+        mutableMessage.setPayload(std::string(payloadSize, 'x'));
+        return mutableMessage.getImmutableMessage();
+    }
+
+    static std::function<void(const exceptions::JoynrRuntimeException&)> failOnError()
+    {
+        return [](const exceptions::JoynrRuntimeException& e) { FAIL() << e.getMessage(); };
+    }
+
+    Server server;
+    Client client;
+    std::thread serverThread;
+    std::thread clientThread;
+    std::mutex mutex;
+    std::vector<ConnectionHandle> serverConnections;
+    std::vector<std::vector<std::string>> receivedPayloads;
+    Semaphore connected;
+    Semaphore received;
+};
+
+TEST_F(WebSocketPpSenderTest, messageIsFramedOnceForAllConnections)
+{
+    connectClient();
+    connectClient();
+    auto sender1 = createSender(0);
+    auto sender2 = createSender(1);
+    std::shared_ptr<ImmutableMessage> message = createMessage(64 * 1024);
+    const smrf::ByteVector& serializedMessage = message->getSerializedMessage();
+    const std::string expectedPayload(serializedMessage.cbegin(), serializedMessage.cend());
+
+    sender1->send(message, failOnError());
+    sender2->send(message, failOnError());
+
+    ASSERT_TRUE(received.waitFor(std::chrono::seconds(5)));
+    ASSERT_TRUE(received.waitFor(std::chrono::seconds(5)));
+    const std::vector<std::string> payloads1 = getReceivedPayloads(0);
+    const std::vector<std::string> payloads2 = getReceivedPayloads(1);
+    ASSERT_EQ(1u, payloads1.size());
+    ASSERT_EQ(1u, payloads2.size());
+    EXPECT_EQ(expectedPayload, payloads1[0]);
+    EXPECT_EQ(payloads1[0], payloads2[0]);
+
+    // the frame built by the first send is cached in the message and was reused by the second
+    std::size_t framesCreated = 0;
+    std::shared_ptr<Frame> frame = message->getOrCreateTransportFrame<Frame>(
+            [&framesCreated](const smrf::ByteVector&) {
+                ++framesCreated;
+                return std::shared_ptr<Frame>();
+            });
+    EXPECT_EQ(0u, framesCreated);
+    ASSERT_TRUE(frame);
+    EXPECT_TRUE(frame->get_prepared());
+    EXPECT_EQ(expectedPayload, frame->get_payload());
+}
+
+TEST_F(WebSocketPpSenderTest, fullSendQueueRejectsMessageWithDelay)
+{
+    connectClient();
+    auto sender = createSender(0, 1);
+    std::shared_ptr<ImmutableMessage> message = createMessage(1024);
+
+    // block the server thread so that the first message stays in the send queue
+    Semaphore serverBlocked(0);
+    auto releaseServer = std::make_shared<Semaphore>(0);
+    server.get_io_service().post([&serverBlocked, releaseServer]() {
+        serverBlocked.notify();
+        releaseServer->wait();
+    });
+    ASSERT_TRUE(serverBlocked.waitFor(std::chrono::seconds(5)));
+
+    sender->send(message, failOnError());
+    bool delayed = false;
+    sender->send(message, [&delayed](const exceptions::JoynrRuntimeException& e) {
+        EXPECT_EQ(exceptions::JoynrDelayMessageException::TYPE_NAME(), e.getTypeName());
+        delayed = true;
+    });
+    releaseServer->notify();
+
+    EXPECT_TRUE(delayed);
+    ASSERT_TRUE(received.waitFor(std::chrono::seconds(5)));
+    EXPECT_FALSE(received.waitFor(std::chrono::milliseconds(100)));
+    EXPECT_EQ(1u, getReceivedPayloads(0).size());
+}
+
+TEST_F(WebSocketPpSenderTest, sendQueueWithoutLimitAcceptsMessages)
+{
+    connectClient();
+    auto sender = createSender(0);
+    std::shared_ptr<ImmutableMessage> message = createMessage(1024);
+
+    Semaphore serverBlocked(0);
+    auto releaseServer = std::make_shared<Semaphore>(0);
+    server.get_io_service().post([&serverBlocked, releaseServer]() {
+        serverBlocked.notify();
+        releaseServer->wait();
+    });
+    ASSERT_TRUE(serverBlocked.waitFor(std::chrono::seconds(5)));
+
+    sender->send(message, failOnError());
+    sender->send(message, failOnError());
+    releaseServer->notify();
+
+    ASSERT_TRUE(received.waitFor(std::chrono::seconds(5)));
+    ASSERT_TRUE(received.waitFor(std::chrono::seconds(5)));
+    EXPECT_EQ(2u, getReceivedPayloads(0).size());
+}
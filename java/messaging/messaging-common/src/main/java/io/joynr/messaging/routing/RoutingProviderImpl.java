@@ -34,6 +34,7 @@ import joynr.system.RoutingTypes.BrowserAddress;
 import joynr.system.RoutingTypes.ChannelAddress;
 import joynr.system.RoutingTypes.MqttAddress;
 import joynr.system.RoutingTypes.RoutingTypesUtil;
+import joynr.system.RoutingTypes.SharedMemoryClientAddress;
 import joynr.system.RoutingTypes.WebSocketAddress;
 import joynr.system.RoutingTypes.WebSocketClientAddress;
 
@@ -123,6 +124,14 @@ public class RoutingProviderImpl extends RoutingAbstractProvider {
         return resolvedDeferred();
     }
 
+    @Override
+    public Promise<DeferredVoid> addNextHop(String participantId,
+                                            SharedMemoryClientAddress address,
+                                            Boolean isGloballyVisible) {
+        messageRouter.addNextHop(participantId, address, isGloballyVisible);
+        return resolvedDeferred();
+    }
+
     @Override
     public Promise<DeferredVoid> removeNextHop(String participantId) {
         messageRouter.removeNextHop(participantId);
@@ -0,0 +1,194 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+/*
+ * Measures the consumer permission check which the cluster controller performs for every
+ * routed request if access control is enabled. The check is executed with the consumer
+ * permission cache disabled and with the default cache size.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "joynr/ClusterControllerSettings.h"
+#include "joynr/ImmutableMessage.h"
+#include "joynr/LocalCapabilitiesDirectory.h"
+#include "joynr/MessagingQos.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/MutableMessageFactory.h"
+#include "joynr/Request.h"
+#include "joynr/Settings.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "joynr/access-control/IAccessController.h"
+#include "joynr/infrastructure/DacTypes/MasterAccessControlEntry.h"
+#include "joynr/types/DiscoveryEntryWithMetaInfo.h"
+#include "libjoynrclustercontroller/access-control/AccessController.h"
+#include "libjoynrclustercontroller/access-control/LocalDomainAccessController.h"
+#include "libjoynrclustercontroller/access-control/LocalDomainAccessStore.h"
+
+#include "../common/PerformanceTest.h"
+
+namespace
+{
+
+using namespace joynr;
+using namespace joynr::infrastructure::DacTypes;
+
+const std::string user("testUser");
+const std::string domain("testDomain");
+const std::string interfaceName("testInterface");
+const std::string proxyParticipantId("proxyParticipantId");
+const std::string providerParticipantId("providerParticipantId");
+
+/**
+ * answers the participantId lookup of the AccessController without a capabilities directory
+ */
+class LocalCapabilitiesDirectoryStub : public LocalCapabilitiesDirectory
+{
+public:
+    LocalCapabilitiesDirectoryStub(ClusterControllerSettings& clusterControllerSettings,
+                                   boost::asio::io_service& ioService,
+                                   const types::DiscoveryEntryWithMetaInfo& discoveryEntry)
+            : LocalCapabilitiesDirectory(clusterControllerSettings,
+                                         nullptr,
+                                         "localAddress",
+                                         std::weak_ptr<IMessageRouter>(),
+                                         ioService,
+                                         "clusterControllerId"),
+              discoveryEntry(discoveryEntry)
+    {
+    }
+
+    void lookup(const std::string& participantId,
+                std::function<void(const types::DiscoveryEntryWithMetaInfo&)> onSuccess,
+                std::function<void(const exceptions::ProviderRuntimeException&)> onError) override
+    {
+        std::ignore = participantId;
+        std::ignore = onError;
+        onSuccess(discoveryEntry);
+    }
+
+private:
+    const types::DiscoveryEntryWithMetaInfo discoveryEntry;
+};
+
+class CountingConsumerPermissionCallback
+        : public IAccessController::IHasConsumerPermissionCallback
+{
+public:
+    void hasConsumerPermission(bool hasPermission) override
+    {
+        if (hasPermission) {
+            ++granted;
+        }
+    }
+
+    std::uint64_t granted = 0;
+};
+
+std::shared_ptr<ImmutableMessage> createRequestMessage()
+{
+    MutableMessageFactory messageFactory;
+    Request request;
+    request.setMethodName("testOperation");
+    MutableMessage mutableMessage = messageFactory.createRequest(
+            proxyParticipantId, providerParticipantId, MessagingQos(60000), request, true);
+    std::shared_ptr<ImmutableMessage> immutableMessage = mutableMessage.getImmutableMessage();
+    immutableMessage->setCreator(user);
+    return immutableMessage;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::uint64_t runs = 100;
+    std::uint64_t messagesPerRun = 1000;
+    if (argc > 1) {
+        runs = std::stoull(argv[1]);
+    }
+    if (argc > 2) {
+        messagesPerRun = std::stoull(argv[2]);
+    }
+    std::cerr << "runs: " << runs << ", messages per run: " << messagesPerRun << std::endl;
+
+    Settings emptySettings;
+    ClusterControllerSettings clusterControllerSettings(emptySettings);
+    auto singleThreadedIOService = std::make_shared<SingleThreadedIOService>();
+    singleThreadedIOService->start();
+
+    types::DiscoveryEntryWithMetaInfo discoveryEntry;
+    discoveryEntry.setDomain(domain);
+    discoveryEntry.setInterfaceName(interfaceName);
+    discoveryEntry.setParticipantId(providerParticipantId);
+    auto localCapabilitiesDirectory = std::make_shared<LocalCapabilitiesDirectoryStub>(
+            clusterControllerSettings, singleThreadedIOService->getIOService(), discoveryEntry);
+    localCapabilitiesDirectory->init();
+
+    auto localDomainAccessStore = std::make_shared<LocalDomainAccessStore>();
+    const std::vector<TrustLevel::Enum> trustLevels = {
+            TrustLevel::LOW, TrustLevel::MID, TrustLevel::HIGH};
+    const std::vector<Permission::Enum> permissions = {
+            Permission::NO, Permission::ASK, Permission::YES};
+    localDomainAccessStore->updateMasterAccessControlEntry(
+            MasterAccessControlEntry(user,
+                                     domain,
+                                     interfaceName,
+                                     TrustLevel::LOW,
+                                     trustLevels,
+                                     TrustLevel::LOW,
+                                     trustLevels,
+                                     access_control::WILDCARD,
+                                     Permission::YES,
+                                     permissions));
+    const bool useOnlyLocalDomainAccessStore = true;
+    auto localDomainAccessController = std::make_shared<LocalDomainAccessController>(
+            localDomainAccessStore, useOnlyLocalDomainAccessStore);
+
+    std::shared_ptr<ImmutableMessage> message = createRequestMessage();
+    const std::vector<std::size_t> cacheSizes = {
+            0, ClusterControllerSettings::DEFAULT_ACCESS_CONTROL_CONSUMER_PERMISSION_CACHE_SIZE()};
+    for (const std::size_t cacheSize : cacheSizes) {
+        AccessController accessController(
+                localCapabilitiesDirectory, localDomainAccessController, cacheSize);
+        auto callback = std::make_shared<CountingConsumerPermissionCallback>();
+        PerformanceTest::runAndPrintAverage(
+                runs, "hasConsumerPermission, cache size " + std::to_string(cacheSize), [&]() {
+                    for (std::uint64_t i = 0; i < messagesPerRun; ++i) {
+                        accessController.hasConsumerPermission(message, callback);
+                    }
+                    return callback->granted;
+                });
+        std::cerr << "checks/run:\t\t" << messagesPerRun << std::endl;
+        if (callback->granted != runs * messagesPerRun) {
+            std::cerr << "permission was not granted for all messages" << std::endl;
+            return 1;
+        }
+    }
+
+    localCapabilitiesDirectory->shutdown();
+    singleThreadedIOService->stop();
+    return 0;
+}
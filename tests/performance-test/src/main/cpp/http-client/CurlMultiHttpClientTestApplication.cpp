@@ -0,0 +1,252 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+/*
+ * Measures the throughput of CurlMultiHttpClient against a local http server which answers
+ * every POST immediately. Each run posts a batch of requests concurrently and waits until all
+ * of them are answered; the batch is sent over 1, 4 and 16 connections per host.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/streambuf.hpp>
+#include <boost/asio/write.hpp>
+
+#include "joynr/PrivateCopyAssign.h"
+#include "joynr/Semaphore.h"
+#include "joynr/SingleThreadedIOService.h"
+#include "libjoynrclustercontroller/httpnetworking/CurlMultiHttpClient.h"
+#include "libjoynrclustercontroller/httpnetworking/HttpResult.h"
+
+#include "../common/PerformanceTest.h"
+
+namespace
+{
+
+/**
+ * Minimal local stand-in for the http bounceproxy: answers every POST with 201 and keeps
+ * the connection alive
+ */
+class HttpServerStandIn
+{
+public:
+    HttpServerStandIn()
+            : ioService(),
+              work(ioService),
+              acceptor(ioService,
+                       boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0)),
+              thread(),
+              acceptedConnections(0),
+              receivedRequests(0)
+    {
+        accept();
+        thread = std::thread([this]() { ioService.run(); });
+    }
+
+    ~HttpServerStandIn()
+    {
+        ioService.stop();
+        thread.join();
+    }
+
+    std::string getUrl() const
+    {
+        return "http://127.0.0.1:" + std::to_string(acceptor.local_endpoint().port()) +
+               "/message/";
+    }
+
+    std::size_t getAcceptedConnections() const
+    {
+        return acceptedConnections;
+    }
+
+    std::size_t getReceivedRequests() const
+    {
+        return receivedRequests;
+    }
+
+private:
+    DISALLOW_COPY_AND_ASSIGN(HttpServerStandIn);
+
+    struct Connection
+    {
+        explicit Connection(boost::asio::io_service& ioService) : socket(ioService), buffer()
+        {
+        }
+        boost::asio::ip::tcp::socket socket;
+        boost::asio::streambuf buffer;
+    };
+
+    void accept()
+    {
+        auto connection = std::make_shared<Connection>(ioService);
+        acceptor.async_accept(
+                connection->socket, [this, connection](const boost::system::error_code& error) {
+                    if (!error) {
+                        ++acceptedConnections;
+                        readRequest(connection);
+                    }
+                    accept();
+                });
+    }
+
+    void readRequest(std::shared_ptr<Connection> connection)
+    {
+        boost::asio::async_read_until(
+                connection->socket,
+                connection->buffer,
+                "\r\n\r\n",
+                [this, connection](const boost::system::error_code& error, std::size_t length) {
+                    if (error) {
+                        return;
+                    }
+                    const std::string header(
+                            boost::asio::buffers_begin(connection->buffer.data()),
+                            boost::asio::buffers_begin(connection->buffer.data()) + length);
+                    connection->buffer.consume(length);
+                    readContent(connection, getContentLength(header));
+                });
+    }
+
+    void readContent(std::shared_ptr<Connection> connection, std::size_t contentLength)
+    {
+        const std::size_t buffered = connection->buffer.size();
+        const std::size_t missing = contentLength > buffered ? contentLength - buffered : 0;
+        boost::asio::async_read(
+                connection->socket,
+                connection->buffer,
+                boost::asio::transfer_exactly(missing),
+                [this, connection, contentLength](const boost::system::error_code& error,
+                                                  std::size_t) {
+                    if (error) {
+                        return;
+                    }
+                    connection->buffer.consume(contentLength);
+                    ++receivedRequests;
+                    static const std::string response(
+                            "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n");
+                    boost::asio::async_write(
+                            connection->socket,
+                            boost::asio::buffer(response),
+                            [this, connection](const boost::system::error_code& error,
+                                               std::size_t) {
+                                if (!error) {
+                                    readRequest(connection);
+                                }
+                            });
+                });
+    }
+
+    static std::size_t getContentLength(const std::string& header)
+    {
+        static const std::string contentLengthField("\r\ncontent-length:");
+        auto it = std::search(header.cbegin(),
+                              header.cend(),
+                              contentLengthField.cbegin(),
+                              contentLengthField.cend(),
+                              [](char a, char b) { return std::tolower(a) == b; });
+        if (it == header.cend()) {
+            return 0;
+        }
+        return std::stoul(std::string(it + contentLengthField.size(), header.cend()));
+    }
+
+    boost::asio::io_service ioService;
+    boost::asio::io_service::work work;
+    boost::asio::ip::tcp::acceptor acceptor;
+    std::thread thread;
+    std::atomic<std::size_t> acceptedConnections;
+    std::atomic<std::size_t> receivedRequests;
+};
+
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t requestsPerRun = 2000;
+    std::uint64_t runs = 10;
+    if (argc > 1) {
+        requestsPerRun = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        runs = std::stoull(argv[2]);
+    }
+    std::cerr << "requests per run: " << requestsPerRun << ", runs: " << runs << std::endl;
+
+    const std::string content(1024, 'x');
+    const std::vector<std::size_t> maxConnectionsPerHostValues = {1, 4, 16};
+    for (const std::size_t maxConnectionsPerHost : maxConnectionsPerHostValues) {
+        HttpServerStandIn server;
+        auto singleThreadedIOService = std::make_shared<joynr::SingleThreadedIOService>();
+        singleThreadedIOService->start();
+        auto client = std::make_shared<joynr::CurlMultiHttpClient>(
+                singleThreadedIOService->getIOService(), maxConnectionsPerHost);
+        std::atomic<std::size_t> created(0);
+
+        PerformanceTest::runAndPrintAverage(
+                runs,
+                "post, max connections per host " + std::to_string(maxConnectionsPerHost),
+                [&]() {
+                    joynr::Semaphore allCompleted(0);
+                    std::atomic<std::size_t> completed(0);
+                    for (std::size_t i = 0; i < requestsPerRun; ++i) {
+                        client->post(server.getUrl(),
+                                     content,
+                                     "application/json",
+                                     std::chrono::milliseconds(10000),
+                                     [&](const joynr::HttpResult& result) {
+                                         if (result.getStatusCode() == 201) {
+                                             ++created;
+                                         }
+                                         if (++completed == requestsPerRun) {
+                                             allCompleted.notify();
+                                         }
+                                     });
+                    }
+                    allCompleted.wait();
+                    return created.load();
+                });
+        std::cerr << "requests/run:\t\t" << requestsPerRun << std::endl;
+        std::cerr << "connections:\t\t" << server.getAcceptedConnections() << std::endl;
+
+        client->shutdown();
+        singleThreadedIOService->stop();
+        if (created != runs * requestsPerRun) {
+            std::cerr << "not all requests were answered with 201" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
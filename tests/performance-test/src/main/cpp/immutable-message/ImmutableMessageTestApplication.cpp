@@ -0,0 +1,233 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+/*
+ * Counts the heap allocations caused by an ImmutableMessage while it is routed by the
+ * cluster controller: once for the construction from the serialized message received
+ * from the transport and once for the header accesses performed by the AccessController,
+ * the CcMessageRouter and the MqttSender / WebSocket stubs while forwarding a request.
+ *
+ * Additionally compares the message type checks of the routing pipeline when comparing
+ * the type header against the Message::VALUE_MESSAGE_TYPE_*() strings with switching
+ * on the decoded MessageType.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "joynr/ImmutableMessage.h"
+#include "joynr/Message.h"
+#include "joynr/MutableMessage.h"
+#include "joynr/TimePoint.h"
+#include "joynr/Util.h"
+
+#include "../common/PerformanceTest.h"
+
+namespace
+{
+std::atomic<std::uint64_t> numberOfAllocations(0);
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    ++numberOfAllocations;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+
+smrf::ByteVector createSerializedMessage(const std::string& type)
+{
+    joynr::MutableMessage mutableMessage;
+    mutableMessage.setType(type);
+    mutableMessage.setSender(joynr::util::createUuid());
+    mutableMessage.setRecipient(joynr::util::createUuid());
+    mutableMessage.setReplyTo(R"({"_typeName":"joynr.system.RoutingTypes.MqttAddress",)"
+                              R"("brokerUri":"tcp://localhost:1883","topic":"replyToTopic"})");
+    mutableMessage.setEffort("NORMAL");
+    mutableMessage.setExpiryDate(joynr::TimePoint::fromRelativeMs(60000));
+    mutableMessage.setCustomHeader("z4", joynr::util::createUuid());
+    mutableMessage.setPayload(std::string(256, 'x'));
+    return mutableMessage.getImmutableMessage()->getSerializedMessage();
+}
+
+std::size_t routeMessage(const joynr::ImmutableMessage& message)
+{
+    std::size_t result = 0;
+    // AccessController::hasConsumerPermission
+    result += message.getType().size();
+    result += message.getRecipient().size();
+    result += message.getCreator().size();
+    // AbstractMessageRouter::registerGlobalRoutingEntryIfRequired
+    result += message.getType().size();
+    if (const boost::optional<std::string> replyTo = message.getReplyTo()) {
+        result += replyTo->size();
+    }
+    result += message.getSender().size();
+    // CcMessageRouter::routeInternal / AbstractMessageRouter::getDestinationAddresses
+    result += message.getRecipient().size();
+    result += message.getRecipient().size();
+    result += message.getId().size();
+    // MqttSender::sendMessage
+    result += message.getType().size();
+    result += message.getRecipient().size();
+    if (const boost::optional<std::string> effort = message.getEffort()) {
+        result += effort->size();
+    }
+    return result;
+}
+
+// type checks done per message by AccessController, AbstractMessageRouter, CcMessageRouter and
+// MqttSender before MessageType was introduced
+std::size_t classifyByTypeString(const joynr::ImmutableMessage& message)
+{
+    using joynr::Message;
+    std::size_t result = 0;
+    const std::string& type = message.getType();
+    if (type == Message::VALUE_MESSAGE_TYPE_MULTICAST() ||
+        type == Message::VALUE_MESSAGE_TYPE_PUBLICATION() ||
+        type == Message::VALUE_MESSAGE_TYPE_REPLY() ||
+        type == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()) {
+        result += 1;
+    }
+    if (type == Message::VALUE_MESSAGE_TYPE_REQUEST() ||
+        type == Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REQUEST() ||
+        type == Message::VALUE_MESSAGE_TYPE_BROADCAST_SUBSCRIPTION_REQUEST() ||
+        type == Message::VALUE_MESSAGE_TYPE_MULTICAST_SUBSCRIPTION_REQUEST()) {
+        result += 2;
+    }
+    if (type == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+        result += 4;
+    }
+    if (type == Message::VALUE_MESSAGE_TYPE_MULTICAST()) {
+        result += 8;
+    }
+    return result;
+}
+
+std::size_t classifyByMessageType(const joynr::ImmutableMessage& message)
+{
+    using joynr::MessageType;
+    std::size_t result = 0;
+    const MessageType type = message.getMessageType();
+    switch (type) {
+    case MessageType::MULTICAST:
+    case MessageType::PUBLICATION:
+    case MessageType::REPLY:
+    case MessageType::SUBSCRIPTION_REPLY:
+        result += 1;
+        break;
+    default:
+        break;
+    }
+    switch (type) {
+    case MessageType::REQUEST:
+    case MessageType::SUBSCRIPTION_REQUEST:
+    case MessageType::BROADCAST_SUBSCRIPTION_REQUEST:
+    case MessageType::MULTICAST_SUBSCRIPTION_REQUEST:
+        result += 2;
+        break;
+    default:
+        break;
+    }
+    if (type == MessageType::MULTICAST) {
+        result += 4;
+    }
+    if (type == MessageType::MULTICAST) {
+        result += 8;
+    }
+    return result;
+}
+
+} // namespace
+
+int main()
+{
+    const std::uint64_t runs = 100000;
+    const smrf::ByteVector serializedMessage =
+            createSerializedMessage(joynr::Message::VALUE_MESSAGE_TYPE_REQUEST());
+
+    std::uint64_t allocationsBefore = numberOfAllocations;
+    auto message = std::make_unique<joynr::ImmutableMessage>(serializedMessage);
+    const std::uint64_t constructionAllocations = numberOfAllocations - allocationsBefore;
+
+    allocationsBefore = numberOfAllocations;
+    routeMessage(*message);
+    const std::uint64_t routingAllocations = numberOfAllocations - allocationsBefore;
+
+    std::cerr << "heap allocations per message" << std::endl;
+    std::cerr << "construction:\t\t" << constructionAllocations << std::endl;
+    std::cerr << "routing accesses:\t" << routingAllocations << std::endl;
+
+    PerformanceTest::runAndPrintAverage(runs,
+                                        "construct ImmutableMessage",
+                                        [&serializedMessage]() {
+                                            joynr::ImmutableMessage message(serializedMessage);
+                                            return message.getMessageSize();
+                                        });
+    PerformanceTest::runAndPrintAverage(
+            runs, "route ImmutableMessage", [&message]() { return routeMessage(*message); });
+
+    std::vector<std::unique_ptr<joynr::ImmutableMessage>> messages;
+    for (const std::string& type : {joynr::Message::VALUE_MESSAGE_TYPE_REQUEST(),
+                                    joynr::Message::VALUE_MESSAGE_TYPE_REPLY(),
+                                    joynr::Message::VALUE_MESSAGE_TYPE_PUBLICATION(),
+                                    joynr::Message::VALUE_MESSAGE_TYPE_MULTICAST(),
+                                    joynr::Message::VALUE_MESSAGE_TYPE_SUBSCRIPTION_REPLY()}) {
+        messages.push_back(
+                std::make_unique<joynr::ImmutableMessage>(createSerializedMessage(type)));
+    }
+    auto classifyAll = [&messages](auto classify) {
+        std::size_t result = 0;
+        for (const auto& message : messages) {
+            result += classify(*message);
+        }
+        return result;
+    };
+    PerformanceTest::runAndPrintAverage(runs,
+                                        "classify message type by string compare",
+                                        classifyAll,
+                                        classifyByTypeString);
+    PerformanceTest::runAndPrintAverage(runs,
+                                        "classify message type by MessageType",
+                                        classifyAll,
+                                        classifyByMessageType);
+
+    return 0;
+}
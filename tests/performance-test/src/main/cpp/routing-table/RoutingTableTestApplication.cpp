@@ -0,0 +1,275 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+/*
+ * Compares the RoutingTable, which stores its entries in a dense array indexed by the
+ * interned participantId handle, with the previous implementation which kept them in a
+ * multi index container keyed by the participantId string. Reports the heap bytes per
+ * entry and the time of an address lookup by string and by handle.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+#include "joynr/ParticipantIdTable.h"
+#include "joynr/RoutingTable.h"
+#include "joynr/system/RoutingTypes/WebSocketClientAddress.h"
+
+#include "../common/PerformanceTest.h"
+
+namespace
+{
+std::atomic<std::int64_t> allocatedBytes(0);
+} // namespace
+
+// count the heap usage of the containers under test; the size is stored in front of each block
+void* operator new(std::size_t size)
+{
+    auto block = static_cast<std::size_t*>(std::malloc(size + sizeof(std::max_align_t)));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *block = size;
+    allocatedBytes += static_cast<std::int64_t>(size);
+    return reinterpret_cast<char*>(block) + sizeof(std::max_align_t);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    if (pointer == nullptr) {
+        return;
+    }
+    auto block = reinterpret_cast<std::size_t*>(static_cast<char*>(pointer) -
+                                                sizeof(std::max_align_t));
+    allocatedBytes -= static_cast<std::int64_t>(*block);
+    std::free(block);
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    operator delete(pointer);
+}
+
+namespace
+{
+
+using Address = joynr::system::RoutingTypes::Address;
+
+/**
+ * the RoutingTable storage as it was implemented before participantIds were interned
+ */
+struct BaselineRoutingEntry
+{
+    std::string participantId;
+    std::shared_ptr<const Address> address;
+    bool isGloballyVisible;
+    std::int64_t expiryDateMs;
+    bool isSticky;
+};
+
+struct AddressEqual
+{
+    bool operator()(const std::shared_ptr<const Address>& lhs,
+                    const std::shared_ptr<const Address>& rhs) const
+    {
+        return *lhs == *rhs;
+    }
+};
+
+struct AddressHash
+{
+    std::size_t operator()(const std::shared_ptr<const Address>& address) const
+    {
+        return address->hashCode();
+    }
+};
+
+struct ParticipantIdTag;
+struct AddressTag;
+struct ExpiryDateTag;
+
+using BaselineRoutingTable = boost::multi_index_container<
+        BaselineRoutingEntry,
+        boost::multi_index::indexed_by<
+                boost::multi_index::hashed_unique<
+                        boost::multi_index::tag<ParticipantIdTag>,
+                        BOOST_MULTI_INDEX_MEMBER(BaselineRoutingEntry,
+                                                 std::string,
+                                                 participantId)>,
+                boost::multi_index::hashed_non_unique<
+                        boost::multi_index::tag<AddressTag>,
+                        BOOST_MULTI_INDEX_MEMBER(BaselineRoutingEntry,
+                                                 std::shared_ptr<const Address>,
+                                                 address),
+                        AddressHash,
+                        AddressEqual>,
+                boost::multi_index::ordered_non_unique<
+                        boost::multi_index::tag<ExpiryDateTag>,
+                        BOOST_MULTI_INDEX_MEMBER(BaselineRoutingEntry,
+                                                 std::int64_t,
+                                                 expiryDateMs)>>>;
+
+std::shared_ptr<const Address> baselineLookup(const BaselineRoutingTable& table,
+                                              const std::string& participantId)
+{
+    const auto& index = boost::multi_index::get<ParticipantIdTag>(table);
+    const auto found = index.find(participantId);
+    if (found == index.cend()) {
+        return nullptr;
+    }
+    return found->address;
+}
+
+std::vector<std::string> createParticipantIds(std::size_t numberOfEntries)
+{
+    std::vector<std::string> participantIds;
+    participantIds.reserve(numberOfEntries);
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        // same length as the uuids used as participantIds
+        std::string participantId = "00000000-0000-0000-0000-000000000000";
+        const std::string number = std::to_string(i);
+        participantId.replace(participantId.size() - number.size(), number.size(), number);
+        participantIds.push_back(std::move(participantId));
+    }
+    return participantIds;
+}
+
+void printBytesPerEntry(const std::string& name, std::int64_t bytes, std::size_t numberOfEntries)
+{
+    std::cerr << "Testcase: " << name << std::endl;
+    std::cerr << "bytes/entry:\t\t" << static_cast<double>(bytes) / numberOfEntries << std::endl;
+}
+
+template <typename Function>
+void runLookups(const std::string& name,
+                const std::vector<std::string>& participantIds,
+                std::uint64_t runs,
+                Function lookup)
+{
+    std::size_t index = 0;
+    PerformanceTest::runAndPrintAverage(runs, name, [&]() {
+        std::size_t found = 0;
+        for (const auto& participantId : participantIds) {
+            found += lookup(participantId, index++) ? 1 : 0;
+        }
+        return found;
+    });
+    std::cerr << "lookups/run:\t\t" << participantIds.size() << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::size_t numberOfEntries = 100000;
+    std::uint64_t runs = 50;
+    if (argc > 1) {
+        numberOfEntries = std::stoul(argv[1]);
+    }
+    if (argc > 2) {
+        runs = std::stoull(argv[2]);
+    }
+    std::cerr << "entries: " << numberOfEntries << ", runs: " << runs << std::endl;
+
+    const std::vector<std::string> participantIds = createParticipantIds(numberOfEntries);
+    // routing entries share the address of the connection they were registered over
+    std::vector<std::shared_ptr<const Address>> addresses;
+    for (std::size_t i = 0; i < 64; ++i) {
+        addresses.push_back(std::make_shared<const joynr::system::RoutingTypes::WebSocketClientAddress>(
+                "client-" + std::to_string(i)));
+    }
+    const std::int64_t expiryDateMs = std::numeric_limits<std::int64_t>::max();
+
+    std::int64_t bytesBefore = allocatedBytes;
+    BaselineRoutingTable baselineTable;
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        baselineTable.insert(BaselineRoutingEntry{
+                participantIds[i], addresses[i % addresses.size()], true, expiryDateMs, false});
+    }
+    printBytesPerEntry("multi index keyed by participantId string",
+                       allocatedBytes - bytesBefore,
+                       numberOfEntries);
+
+    bytesBefore = allocatedBytes;
+    joynr::ParticipantIdTable participantIdTable;
+    joynr::RoutingTable routingTable(participantIdTable);
+    for (std::size_t i = 0; i < numberOfEntries; ++i) {
+        routingTable.add(
+                participantIds[i], true, addresses[i % addresses.size()], expiryDateMs, false);
+    }
+    printBytesPerEntry("dense array indexed by participantId handle (incl. ParticipantIdTable)",
+                       allocatedBytes - bytesBefore,
+                       numberOfEntries);
+
+    // the handles are resolved once per message by ImmutableMessage
+    std::vector<joynr::ParticipantIdTable::Handle> handles;
+    handles.reserve(numberOfEntries);
+    for (const auto& participantId : participantIds) {
+        handles.push_back(participantIdTable.find(participantId));
+    }
+
+    runLookups("lookup by participantId string (multi index)",
+               participantIds,
+               runs,
+               [&](const std::string& participantId, std::size_t) {
+                   return baselineLookup(baselineTable, participantId);
+               });
+    runLookups("lookup by participantId string (RoutingTable)",
+               participantIds,
+               runs,
+               [&](const std::string& participantId, std::size_t) {
+                   return routingTable.lookupAddressByParticipantId(participantId);
+               });
+    runLookups("lookup by participantId handle (RoutingTable)",
+               participantIds,
+               runs,
+               [&](const std::string&, std::size_t index) {
+                   return routingTable.lookupAddressByParticipantIdHandle(
+                           handles[index % handles.size()]);
+               });
+    return 0;
+}
@@ -105,6 +105,30 @@ public:
         runAndPrintAverage(runs, getTestName("full message deserialization"), fun);
     }
 
+    template <typename ParamType>
+    void runFullMessageInPlaceDeSerializationBenchmark() const
+    {
+        // same as runFullMessageDeSerializationBenchmark, but the request is parsed
+        // directly from the message body instead of from a copy of it
+        joynr::MutableMessage mutableMessage = createMessage();
+        std::unique_ptr<joynr::ImmutableMessage> immutableMessage =
+                mutableMessage.getImmutableMessage();
+        const smrf::ByteVector& rawMessage = immutableMessage->getSerializedMessage();
+        auto fun = [&rawMessage]() {
+            joynr::ImmutableMessage deserializedMessage(rawMessage);
+
+            joynr::Request deserializedRequest;
+            joynr::serializer::deserializeFromJson(
+                    deserializedRequest, deserializedMessage.getUnencryptedBody());
+
+            ParamType param;
+            deserializedRequest.getParams(param);
+            return param;
+        };
+
+        runAndPrintAverage(runs, getTestName("full message in-place deserialization"), fun);
+    }
+
 private:
     joynr::MutableMessage createMessage() const
     {
@@ -18,6 +18,8 @@
  */
 
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <boost/fusion/adapted/std_tuple.hpp>
 #include <boost/fusion/include/for_each.hpp>
@@ -46,5 +48,15 @@ int main()
 
     boost::fusion::for_each(Generators(), fun);
 
+    // compare deserialization from a copy of the message body with in-place
+    // deserialization for 1 KB, 64 KB and 1 MB payloads
+    const std::vector<std::pair<std::size_t, std::uint64_t>> payloadSizes = {
+            {1024, 10000}, {64 * 1024, 1000}, {1024 * 1024, 100}};
+    for (const auto& payloadSize : payloadSizes) {
+        SerializerPerformanceTest<String> test(payloadSize.second, payloadSize.first);
+        test.runFullMessageDeSerializationBenchmark<String::type>();
+        test.runFullMessageInPlaceDeSerializationBenchmark<String::type>();
+    }
+
     return 0;
 }
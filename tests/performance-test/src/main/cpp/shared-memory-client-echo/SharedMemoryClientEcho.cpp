@@ -0,0 +1,195 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/program_options.hpp>
+
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/exceptions/JoynrException.h"
+
+using joynr::SharedMemoryConnection;
+
+class BenchmarkTest
+{
+public:
+    BenchmarkTest(SharedMemoryConnection& connection, int numberOfMessagesToSend)
+            : connection(connection),
+              numberOfMessagesToSend(numberOfMessagesToSend),
+              numberOfReceivedMessages(0),
+              payload(R"({)"
+                      R"("_typeName":"joynr.types.TestTypes.TStructExtended",)"
+                      R"("tDouble":0.123456789,)"
+                      R"("tInt64":64,)"
+                      R"("tString":"myTestString",)"
+                      R"("tEnum":"TLITERALA",)"
+                      R"("tInt32":32)"
+                      R"(})"),
+              finishedPromise()
+    {
+    }
+
+    void run()
+    {
+        std::future<void> finishedFuture = finishedPromise.get_future();
+        startedTimestamp = std::chrono::high_resolution_clock::now();
+        sendMessages();
+        finishedFuture.wait();
+    }
+
+    void onMessageReceived()
+    {
+        if (++numberOfReceivedMessages == numberOfMessagesToSend) {
+            finishedTimestamp = std::chrono::high_resolution_clock::now();
+            finishedPromise.set_value();
+        }
+    }
+
+    std::chrono::microseconds getDurationUs() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(finishedTimestamp -
+                                                                     startedTimestamp);
+    }
+
+    double getNumMessagesPerSecond() const
+    {
+        auto durationUs = getDurationUs();
+
+        if (durationUs == std::chrono::microseconds(0)) {
+            return 0.0;
+        }
+
+        return static_cast<double>(numberOfMessagesToSend) /
+               (static_cast<double>(durationUs.count()) / 1e6);
+    }
+
+private:
+    void sendMessages()
+    {
+        const smrf::ByteArrayView frame(
+                reinterpret_cast<const std::uint8_t*>(payload.data()), payload.size());
+
+        for (int i = 0; i < numberOfMessagesToSend; i++) {
+            // a full ring buffer is reported as delay, retry until the server caught up
+            bool retry = true;
+            while (retry && connection.isOpen()) {
+                retry = false;
+                connection.send(
+                        frame, [&retry, i](const joynr::exceptions::JoynrRuntimeException& e) {
+                            if (dynamic_cast<const joynr::exceptions::JoynrDelayMessageException*>(
+                                        &e)) {
+                                retry = true;
+                            } else {
+                                std::cout << "Failed to send message #" << i << ": "
+                                          << e.getMessage() << std::endl;
+                            }
+                        });
+                if (retry) {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    SharedMemoryConnection& connection;
+
+    int numberOfMessagesToSend;
+    std::atomic<int> numberOfReceivedMessages;
+
+    std::chrono::high_resolution_clock::time_point startedTimestamp;
+    std::chrono::high_resolution_clock::time_point finishedTimestamp;
+
+    std::string payload;
+    std::promise<void> finishedPromise;
+};
+
+int main(int argc, char* argv[])
+{
+    namespace po = boost::program_options;
+
+    std::string path;
+    int numberOfMessages = 0;
+    std::size_t ringBufferSize = 0;
+
+    po::options_description desc("parameters");
+
+    desc.add_options()("help", "show usage")(
+            "path,p",
+            po::value<std::string>(&path)->default_value("/tmp/joynr-shared-memory-echo"),
+            "path of the unix domain socket")(
+            "numberofmessages,n",
+            po::value<int>(&numberOfMessages)->default_value(10000),
+            "number of messages to transmit")(
+            "ringbuffersize,s",
+            po::value<std::size_t>(&ringBufferSize)->default_value(1024 * 1024),
+            "size of each ring buffer in bytes");
+
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << desc << std::endl;
+        std::exit(EXIT_SUCCESS);
+    }
+
+    try {
+        boost::asio::io_service ioService;
+        boost::asio::io_service::work work(ioService);
+        auto thread = std::thread([&ioService]() { ioService.run(); });
+
+        boost::system::error_code errorCode;
+        auto connection =
+                SharedMemoryConnection::connect(ioService, path, ringBufferSize, errorCode);
+
+        if (errorCode) {
+            std::cout << "Failed to create connection: " << errorCode.message() << std::endl;
+            ioService.stop();
+            thread.join();
+            std::exit(EXIT_FAILURE);
+        }
+
+        BenchmarkTest benchmark(*connection, numberOfMessages);
+        connection->start(
+                [&benchmark](const smrf::ByteArrayView&) { benchmark.onMessageReceived(); },
+                []() { std::cout << "Connection closed by server" << std::endl; });
+
+        benchmark.run();
+
+        connection->close();
+        ioService.stop();
+        thread.join();
+
+        std::cout << "Duration: " << static_cast<double>(benchmark.getDurationUs().count()) / 1e6
+                  << " sec" << std::endl;
+        std::cout << "Msgs/s: " << benchmark.getNumMessagesPerSecond() << std::endl;
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,152 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <boost/asio/io_service.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/program_options.hpp>
+
+#include "joynr/SharedMemoryConnection.h"
+#include "joynr/exceptions/JoynrException.h"
+
+using joynr::SharedMemoryConnection;
+
+int messageCount = 0;
+
+// sends the frame back, waiting for the client to drain its ring buffer if necessary
+void echo(SharedMemoryConnection& connection, const smrf::ByteArrayView& frame)
+{
+    bool retry = true;
+    while (retry && connection.isOpen()) {
+        retry = false;
+        connection.send(frame, [&retry](const joynr::exceptions::JoynrRuntimeException& e) {
+            if (dynamic_cast<const joynr::exceptions::JoynrDelayMessageException*>(&e)) {
+                retry = true;
+            } else {
+                std::cout << "send failed: " << e.getMessage() << std::endl;
+            }
+        });
+        if (retry) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void startAccept(boost::asio::io_service& ioService,
+                 boost::asio::local::stream_protocol::acceptor& acceptor,
+                 std::set<std::shared_ptr<SharedMemoryConnection>>& connections)
+{
+    auto socket = std::make_shared<SharedMemoryConnection::Socket>(ioService);
+    acceptor.async_accept(*socket, [&ioService, &acceptor, &connections, socket](
+                                           const boost::system::error_code& error) {
+        if (error) {
+            return;
+        }
+        SharedMemoryConnection::asyncAccept(
+                ioService,
+                std::move(*socket),
+                [&ioService, &connections](const boost::system::error_code& acceptError,
+                                          std::shared_ptr<SharedMemoryConnection> connection) {
+                    if (acceptError) {
+                        std::cout << "handshake failed: " << acceptError.message() << std::endl;
+                        return;
+                    }
+                    connections.insert(connection);
+                    std::weak_ptr<SharedMemoryConnection> weakConnection(connection);
+                    connection->start(
+                            [&ioService, weakConnection](const smrf::ByteArrayView& frame) {
+                                messageCount++;
+#ifndef NDEBUG
+                                std::cout << "received: " << messageCount << std::endl;
+#endif
+                                // killServer message
+                                const std::string killServer("killServer");
+                                if (frame.size() == killServer.size() &&
+                                    std::equal(killServer.begin(),
+                                               killServer.end(),
+                                               frame.data())) {
+                                    std::cout << "killServer" << std::endl;
+                                    ioService.stop();
+                                    return;
+                                }
+                                if (auto connection = weakConnection.lock()) {
+                                    echo(*connection, frame);
+                                }
+                            },
+                            [&connections, weakConnection]() {
+                                connections.erase(weakConnection.lock());
+                            });
+                });
+        startAccept(ioService, acceptor, connections);
+    });
+}
+
+std::string getPath(int argc, char* argv[])
+{
+    std::string path;
+    namespace po = boost::program_options;
+    po::options_description desc("parameters");
+    desc.add_options()("help", "show usage")(
+            "path,p",
+            po::value<std::string>(&path)->default_value("/tmp/joynr-shared-memory-echo"),
+            "path of the unix domain socket");
+    po::variables_map vm;
+    po::store(po::parse_command_line(argc, argv, desc), vm);
+    po::notify(vm);
+
+    if (vm.count("help")) {
+        std::cout << "usage: shared-memory-server-echo path" << std::endl;
+        std::_Exit(0);
+    }
+    return path;
+}
+
+int main(int argc, char* argv[])
+{
+    const std::string path = getPath(argc, argv);
+    std::cout << "listening on path:" << path << std::endl;
+
+    try {
+        boost::asio::io_service ioService;
+        boost::asio::local::stream_protocol::acceptor acceptor(ioService);
+        std::set<std::shared_ptr<SharedMemoryConnection>> connections;
+
+        std::remove(path.c_str());
+        acceptor.open();
+        acceptor.bind(boost::asio::local::stream_protocol::endpoint(path));
+        acceptor.listen();
+        startAccept(ioService, acceptor, connections);
+
+        ioService.run();
+        for (const auto& connection : connections) {
+            connection->close();
+        }
+        std::remove(path.c_str());
+    } catch (const std::exception& e) {
+        std::cout << e.what() << std::endl;
+    } catch (...) {
+        std::cout << "other exception" << std::endl;
+    }
+}
@@ -37,6 +37,7 @@ int main(int argc, char* argv[])
 
     std::size_t runs;
     TestCase testCase;
+    bool inProcess;
 
     auto validateRuns = [](std::size_t value) {
         if (value == 0) {
@@ -50,7 +51,11 @@ int main(int argc, char* argv[])
             "runs,r", po::value(&runs)->required()->notifier(validateRuns), "number of runs")(
             "testCase,t",
             po::value(&testCase)->required(),
-            "SEND_STRING|SEND_BYTEARRAY|SEND_STRUCT");
+            "SEND_STRING|SEND_BYTEARRAY|SEND_STRUCT")(
+            "inProcess,i",
+            po::value(&inProcess)->default_value(true),
+            "hand requests to the provider without creating messages, "
+            "set to false to measure the serialization and routing overhead");
 
     try {
         po::variables_map vm;
@@ -61,7 +66,7 @@ int main(int argc, char* argv[])
             return EXIT_FAILURE;
         }
 
-        ShortCircuitTest test(runs);
+        ShortCircuitTest test(runs, inProcess);
 
         switch (testCase) {
         case TestCase::SEND_BYTEARRAY:
@@ -42,7 +42,8 @@ namespace joynr
 class ITransportStatus;
 
 ShortCircuitRuntime::ShortCircuitRuntime(std::unique_ptr<Settings> settings,
-                                         std::shared_ptr<IKeychain> keyChain)
+                                         std::shared_ptr<IKeychain> keyChain,
+                                         bool enableInProcessShortCircuit)
         : JoynrRuntimeImpl(*settings),
           keyChain(std::move(keyChain)),
           clusterControllerSettings(*settings),
@@ -77,7 +78,9 @@ ShortCircuitRuntime::ShortCircuitRuntime(std::unique_ptr<Settings> settings,
             std::make_unique<MessageQueue<std::string>>(),
             std::make_unique<MessageQueue<std::shared_ptr<ITransportStatus>>>());
 
-    messageSender = std::make_shared<MessageSender>(messageRouter, keyChain);
+    auto joynrMessageSender = std::make_shared<MessageSender>(messageRouter, keyChain);
+    joynrMessageSender->setInProcessShortCircuitEnabled(enableInProcessShortCircuit);
+    messageSender = joynrMessageSender;
     joynrDispatcher =
             std::make_shared<Dispatcher>(messageSender, singleThreadedIOService.getIOService());
     messageSender->registerDispatcher(joynrDispatcher);
@@ -158,7 +158,8 @@ class ShortCircuitRuntime : public JoynrRuntimeImpl
 {
 public:
     ShortCircuitRuntime(std::unique_ptr<Settings> settings,
-                        std::shared_ptr<IKeychain> keyChain = nullptr);
+                        std::shared_ptr<IKeychain> keyChain = nullptr,
+                        bool enableInProcessShortCircuit = true);
 
     template <class TIntfProvider>
     std::string registerProvider(const std::string& domain,
@@ -35,9 +35,11 @@ struct ShortCircuitTest : public PerformanceTest
 {
     using ByteArray = std::vector<std::int8_t>;
 
-    ShortCircuitTest(std::uint64_t runs)
+    ShortCircuitTest(std::uint64_t runs, bool enableInProcessShortCircuit)
             : runs(runs),
-              runtime(std::make_shared<ShortCircuitRuntime>(std::make_unique<joynr::Settings>()))
+              runtime(std::make_shared<ShortCircuitRuntime>(std::make_unique<joynr::Settings>(),
+                                                            nullptr,
+                                                            enableInProcessShortCircuit))
     {
         echoProvider = std::make_shared<PerformanceTestEchoProvider>();
         // default uses a priority that is the current time,
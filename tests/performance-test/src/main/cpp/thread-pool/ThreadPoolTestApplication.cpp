@@ -0,0 +1,234 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+/*
+ * Compares the work-stealing ThreadPool with the previous implementation which
+ * used a single BlockingQueue and tracked running work in a mutex protected std::set.
+ *
+ * Several producer threads submit runnables which record the time between
+ * submission and start of execution (queueing delay). For each implementation
+ * the throughput and the p50/p99/max queueing delay are printed.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "joynr/BlockingQueue.h"
+#include "joynr/Runnable.h"
+#include "joynr/ThreadPool.h"
+
+#include "../common/PerformanceTest.h"
+
+namespace
+{
+
+/**
+ * Thread pool as it was implemented before the introduction of the WorkStealingQueue
+ */
+class LegacyThreadPool : public std::enable_shared_from_this<LegacyThreadPool>
+{
+public:
+    explicit LegacyThreadPool(std::uint8_t numberOfThreads)
+            : threads(),
+              scheduler(),
+              keepRunning(true),
+              currentlyRunning(),
+              mutex(),
+              numberOfThreads(numberOfThreads)
+    {
+    }
+
+    void init()
+    {
+        for (std::uint8_t i = 0; i < numberOfThreads; ++i) {
+            threads.emplace_back(&LegacyThreadPool::threadLifecycle, this);
+        }
+    }
+
+    void shutdown()
+    {
+        keepRunning = false;
+        scheduler.shutdown();
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        threads.clear();
+    }
+
+    void execute(std::shared_ptr<joynr::Runnable> runnable)
+    {
+        scheduler.add(std::move(runnable));
+    }
+
+private:
+    void threadLifecycle()
+    {
+        while (keepRunning) {
+            std::shared_ptr<joynr::Runnable> runnable = scheduler.take();
+            if (runnable) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!keepRunning) {
+                        break;
+                    }
+                    currentlyRunning.insert(runnable);
+                }
+                runnable->run();
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    currentlyRunning.erase(runnable);
+                }
+            }
+        }
+    }
+
+    std::vector<std::thread> threads;
+    joynr::BlockingQueue scheduler;
+    std::atomic_bool keepRunning;
+    std::set<std::shared_ptr<joynr::Runnable>> currentlyRunning;
+    std::mutex mutex;
+    std::uint8_t numberOfThreads;
+};
+
+class DelayRecordingRunnable : public joynr::Runnable
+{
+public:
+    DelayRecordingRunnable(ClockResolution& delay,
+                           std::atomic<std::uint64_t>& finished,
+                           std::uint32_t workIterations)
+            : joynr::Runnable(),
+              submitTime(Clock::now()),
+              delay(delay),
+              finished(finished),
+              workIterations(workIterations)
+    {
+    }
+
+    void shutdown() override
+    {
+    }
+
+    void run() override
+    {
+        delay = std::chrono::duration_cast<ClockResolution>(Clock::now() - submitTime);
+        // simulate some work, e.g. deserialization of a message
+        volatile std::uint64_t sum = 0;
+        for (std::uint32_t i = 0; i < workIterations; ++i) {
+            sum = sum + i;
+        }
+        ++finished;
+    }
+
+private:
+    const Clock::time_point submitTime;
+    ClockResolution& delay;
+    std::atomic<std::uint64_t>& finished;
+    const std::uint32_t workIterations;
+};
+
+struct BenchmarkParameters
+{
+    std::uint8_t numberOfWorkerThreads;
+    std::uint32_t numberOfProducerThreads;
+    std::uint64_t runnablesPerProducer;
+    std::uint32_t workIterations;
+};
+
+template <typename Pool>
+void runBenchmark(const std::string& name, const BenchmarkParameters& parameters)
+{
+    const std::uint64_t totalRunnables =
+            parameters.numberOfProducerThreads * parameters.runnablesPerProducer;
+    std::vector<ClockResolution> delays(totalRunnables);
+    std::atomic<std::uint64_t> finished(0);
+
+    auto pool = std::make_shared<Pool>(parameters.numberOfWorkerThreads);
+    pool->init();
+
+    const auto start = Clock::now();
+    std::vector<std::thread> producers;
+    for (std::uint32_t producer = 0; producer < parameters.numberOfProducerThreads; ++producer) {
+        producers.emplace_back([&, producer]() {
+            const std::uint64_t offset = producer * parameters.runnablesPerProducer;
+            for (std::uint64_t i = 0; i < parameters.runnablesPerProducer; ++i) {
+                pool->execute(std::make_shared<DelayRecordingRunnable>(
+                        delays[offset + i], finished, parameters.workIterations));
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    while (finished < totalRunnables) {
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    const auto end = Clock::now();
+    pool->shutdown();
+
+    std::sort(delays.begin(), delays.end());
+    using DoubleMilliSeconds = std::chrono::duration<double, std::milli>;
+    auto percentile = [&delays](double p) {
+        const std::size_t index = static_cast<std::size_t>(p * (delays.size() - 1));
+        return std::chrono::duration_cast<DoubleMilliSeconds>(delays[index]).count();
+    };
+    const double totalDurationSec = std::chrono::duration<double>(end - start).count();
+
+    std::cerr << "Testcase: " << name << " workers=" << +parameters.numberOfWorkerThreads
+              << " producers=" << parameters.numberOfProducerThreads
+              << " runnables=" << totalRunnables << " work=" << parameters.workIterations
+              << std::endl;
+    std::cerr << "----- statistics -----" << std::endl;
+    std::cerr << "totalDuration:\t" << totalDurationSec << " [s]" << std::endl;
+    std::cerr << "p50Delay:\t\t" << percentile(0.5) << " [ms]" << std::endl;
+    std::cerr << "p99Delay:\t\t" << percentile(0.99) << " [ms]" << std::endl;
+    std::cerr << "maxDelay:\t\t" << percentile(1.0) << " [ms]" << std::endl;
+    std::cerr << "runnables/sec:\t" << totalRunnables / totalDurationSec << std::endl;
+}
+
+struct JoynrThreadPool : public joynr::ThreadPool
+{
+    explicit JoynrThreadPool(std::uint8_t numberOfThreads)
+            : joynr::ThreadPool("performance-thread-pool", numberOfThreads)
+    {
+    }
+};
+
+} // namespace
+
+int main()
+{
+    const std::vector<BenchmarkParameters> parameterSets = {
+            {1, 1, 200000, 0}, {4, 4, 100000, 0}, {8, 16, 50000, 0}, {8, 16, 20000, 2000}};
+
+    for (const auto& parameters : parameterSets) {
+        runBenchmark<LegacyThreadPool>("BlockingQueue thread pool", parameters);
+        runBenchmark<JoynrThreadPool>("WorkStealingQueue thread pool", parameters);
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+/*
+ * #%L
+ * %%
+ * Copyright (C) 2018 BMW Car IT GmbH
+ * %%
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ * 
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ * #L%
+ */
+
+/*
+ * Compares the throughput of util::createUuid, which uses a generator per thread,
+ * with the previous implementation which shared a single generator protected by a
+ * mutex, for an increasing number of concurrently calling threads.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/uuid/random_generator.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include "joynr/Util.h"
+
+#include "../common/PerformanceTest.h"
+
+namespace
+{
+
+/**
+ * util::createUuid as it was implemented before generators were kept per thread
+ */
+std::string createUuidWithSharedGenerator()
+{
+    static boost::uuids::random_generator uuidGenerator;
+    static std::mutex uuidMutex;
+    std::lock_guard<std::mutex> uuidLock(uuidMutex);
+    return boost::uuids::to_string(uuidGenerator());
+}
+
+template <typename Function>
+void runBenchmark(const std::string& name,
+                  Function createUuid,
+                  std::uint32_t numberOfThreads,
+                  std::uint64_t uuidsPerThread)
+{
+    std::atomic<bool> startSignal(false);
+    std::atomic<std::uint64_t> totalLength(0);
+    std::vector<std::thread> threads;
+    for (std::uint32_t i = 0; i < numberOfThreads; ++i) {
+        threads.emplace_back([&]() {
+            // create the thread's generator before the measurement starts
+            std::uint64_t length = createUuid().size();
+            while (!startSignal) {
+                std::this_thread::yield();
+            }
+            for (std::uint64_t j = 0; j < uuidsPerThread; ++j) {
+                length += createUuid().size();
+            }
+            totalLength += length;
+        });
+    }
+
+    const auto start = Clock::now();
+    startSignal = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto end = Clock::now();
+
+    const std::uint64_t totalUuids = numberOfThreads * uuidsPerThread;
+    const double totalDurationSec = std::chrono::duration<double>(end - start).count();
+    std::cerr << "Testcase: " << name << " threads=" << numberOfThreads
+              << " uuids=" << totalUuids << std::endl;
+    std::cerr << "----- statistics -----" << std::endl;
+    std::cerr << "totalDuration:\t" << totalDurationSec << " [s]" << std::endl;
+    std::cerr << "uuids/sec:\t\t" << totalUuids / totalDurationSec << std::endl;
+    // use the result in order to prevent the calls from being optimized away
+    std::cerr << "characters:\t\t" << totalLength << std::endl;
+}
+
+} // namespace
+
+int main()
+{
+    constexpr std::uint64_t totalUuids = 1600000;
+    for (const std::uint32_t numberOfThreads : {1, 4, 16}) {
+        const std::uint64_t uuidsPerThread = totalUuids / numberOfThreads;
+        runBenchmark("shared generator with mutex",
+                     createUuidWithSharedGenerator,
+                     numberOfThreads,
+                     uuidsPerThread);
+        runBenchmark("thread local generator",
+                     joynr::util::createUuid,
+                     numberOfThreads,
+                     uuidsPerThread);
+    }
+
+    return 0;
+}
@@ -17,12 +17,16 @@
  * #L%
  */
 #include <boost/program_options.hpp>
+#include <atomic>
 #include <cstdlib>
 #include <chrono>
 #include <functional>
 #include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 #include <websocketpp/client.hpp>
 #include <websocketpp/config/asio_client.hpp>
 
@@ -31,10 +35,12 @@ using Client = websocketpp::client<websocketpp::config::asio_client>;
 class BenchmarkTest
 {
 public:
-    BenchmarkTest(Client& client, int numberOfMessagesToSend)
+    BenchmarkTest(Client& client, int numberOfConnections, int numberOfMessagesToSend)
             : client(client),
+              numberOfConnections(numberOfConnections),
               numberOfMessagesToSend(numberOfMessagesToSend),
-              numberOfReceivedMessages(0),
+              numberOfFinishedConnections(0),
+              startedOnce(),
               payload(R"({)"
                       R"("_typeName":"joynr.types.TestTypes.TStructExtended",)"
                       R"("tDouble":0.123456789,)"
@@ -48,22 +54,37 @@ public:
 
     void onConnectionEstablished(websocketpp::connection_hdl& connection)
     {
-        startedTimestamp = std::chrono::high_resolution_clock::now();
+        std::call_once(startedOnce, [this]() {
+            startedTimestamp = std::chrono::high_resolution_clock::now();
+        });
         sendMessages(connection);
     }
 
-    void onMessageReceived()
+    // invoked on the strand of the connection, hence the counter of a connection
+    // is never accessed concurrently
+    void onMessageReceived(websocketpp::connection_hdl& connection, int& numberOfReceivedMessages)
     {
         numberOfReceivedMessages++;
 
-        if (finished()) {
-            finishedTimestamp = std::chrono::high_resolution_clock::now();
+        if (numberOfReceivedMessages == numberOfMessagesToSend) {
+            if (++numberOfFinishedConnections == numberOfConnections) {
+                finishedTimestamp = std::chrono::high_resolution_clock::now();
+            }
+
+            websocketpp::lib::error_code errorCode;
+            client.close(
+                    connection, websocketpp::close::status::normal, std::string(""), errorCode);
+
+            if (errorCode) {
+                std::cout << "Failed to close connection";
+                std::exit(EXIT_FAILURE);
+            }
         }
     }
 
     bool finished() const
     {
-        return numberOfReceivedMessages >= numberOfMessagesToSend;
+        return numberOfFinishedConnections >= numberOfConnections;
     }
 
     std::chrono::microseconds getDurationUs() const
@@ -80,8 +101,9 @@ public:
             return 0.0;
         }
 
-        return static_cast<double>(numberOfMessagesToSend) /
-               (static_cast<double>(durationUs.count()) / 10e6);
+        return static_cast<double>(numberOfConnections) *
+               static_cast<double>(numberOfMessagesToSend) /
+               (static_cast<double>(durationUs.count()) / 1e6);
     }
 
 private:
@@ -102,9 +124,11 @@ private:
 private:
     Client& client;
 
+    int numberOfConnections;
     int numberOfMessagesToSend;
-    int numberOfReceivedMessages;
+    std::atomic<int> numberOfFinishedConnections;
 
+    std::once_flag startedOnce;
     std::chrono::high_resolution_clock::time_point startedTimestamp;
     std::chrono::high_resolution_clock::time_point finishedTimestamp;
 
@@ -118,6 +142,8 @@ int main(int argc, char* argv[])
     int port = 0;
     std::string hostAddress;
     int numberOfMessages = 0;
+    int numberOfConnections = 0;
+    int numberOfThreads = 0;
 
     po::options_description desc("parameters");
 
@@ -126,7 +152,13 @@ int main(int argc, char* argv[])
             "hostaddress,h", po::value<std::string>(&hostAddress)->default_value("localhost"),
             "server address")("numberofmessages,n",
                               po::value<int>(&numberOfMessages)->default_value(10000),
-                              "number of messages to transmit");
+                              "number of messages to transmit per connection")(
+            "connections,c",
+            po::value<int>(&numberOfConnections)->default_value(1),
+            "number of concurrent connections, e.g. 50 to simulate as many local clients")(
+            "threads,t",
+            po::value<int>(&numberOfThreads)->default_value(1),
+            "number of threads running the io_service of the client");
 
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -145,47 +177,50 @@ int main(int argc, char* argv[])
         client.clear_error_channels(websocketpp::log::alevel::all);
 
         const bool secureConnection = false;
-        websocketpp::lib::error_code errorCode;
         websocketpp::uri hostUri(secureConnection, hostAddress, port, std::string(""));
 
-        BenchmarkTest benchmark(client, numberOfMessages);
+        BenchmarkTest benchmark(client, numberOfConnections, numberOfMessages);
 
-        client.set_open_handler([&benchmark](websocketpp::connection_hdl connection) {
-            benchmark.onConnectionEstablished(connection);
-        });
-
-        client.set_message_handler(
-                [&benchmark, &client](websocketpp::connection_hdl connection,
-                                      websocketpp::config::asio_client::message_type::ptr message) {
-                    std::ignore = message;
+        for (int i = 0; i < numberOfConnections; i++) {
+            websocketpp::lib::error_code errorCode;
+            auto connection = client.get_connection(hostUri.str(), errorCode);
 
-                    benchmark.onMessageReceived();
+            if (errorCode) {
+                std::cout << "Failed to create connection: " << errorCode.message() << std::endl;
+                std::exit(EXIT_FAILURE);
+            }
 
-                    if (benchmark.finished()) {
-                        websocketpp::lib::error_code errorCode;
-                        client.close(connection, websocketpp::close::status::normal,
-                                     std::string(""), errorCode);
+            auto numberOfReceivedMessages = std::make_shared<int>(0);
 
-                        if (errorCode) {
-                            std::cout << "Failed to close connection";
-                            std::exit(EXIT_FAILURE);
-                        }
-                    }
-                });
+            connection->set_open_handler([&benchmark](websocketpp::connection_hdl connection) {
+                benchmark.onConnectionEstablished(connection);
+            });
 
-        auto connection = client.get_connection(hostUri.str(), errorCode);
+            connection->set_message_handler(
+                    [&benchmark, numberOfReceivedMessages](
+                            websocketpp::connection_hdl connection,
+                            websocketpp::config::asio_client::message_type::ptr message) {
+                        std::ignore = message;
+                        benchmark.onMessageReceived(connection, *numberOfReceivedMessages);
+                    });
 
-        if (errorCode) {
-            std::cout << "Failed to create connection: " << errorCode.message() << std::endl;
-            std::exit(EXIT_FAILURE1);
+            client.connect(connection);
         }
 
-        client.connect(connection);
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numberOfThreads; i++) {
+            threads.emplace_back(&Client::run, &client);
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
 
-        auto thread = std::thread(&Client::run, &client);
-        thread.join();
+        if (!benchmark.finished()) {
+            std::cout << "Not all messages have been echoed" << std::endl;
+            std::exit(EXIT_FAILURE);
+        }
 
-        std::cout << "Duration: " << static_cast<double>(benchmark.getDurationUs().count()) / 10e6
+        std::cout << "Duration: " << static_cast<double>(benchmark.getDurationUs().count()) / 1e6
                   << " sec" << std::endl;
         std::cout << "Msgs/s: " << benchmark.getNumMessagesPerSecond() << std::endl;
     } catch (websocketpp::exception const& e) {
@@ -16,14 +16,17 @@
  * limitations under the License.
  * #L%
  */
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 #include <websocketpp/config/asio_no_tls.hpp>
 #include <websocketpp/server.hpp>
 #include <boost/program_options.hpp>
 
 typedef websocketpp::server<websocketpp::config::asio> Server;
 
-int messageCount = 0;
+std::atomic<int> messageCount(0);
 
 void messageReceived(Server* server, websocketpp::connection_hdl hdl, Server::message_ptr message)
 {
@@ -49,28 +52,32 @@ void messageReceived(Server* server, websocketpp::connection_hdl hdl, Server::me
     }
 }
 
-int getPort(int argc, char* argv[])
+void parseCommandLine(int argc, char* argv[], int& port, int& numberOfThreads)
 {
-    int port;
     namespace po = boost::program_options;
     po::options_description desc("parameters");
     desc.add_options()("help", "show usage")(
-            "port,p", po::value<int>(&port)->default_value(4220), "server port");
+            "port,p", po::value<int>(&port)->default_value(4220), "server port")(
+            "threads,t",
+            po::value<int>(&numberOfThreads)->default_value(1),
+            "number of threads running the io_service; handlers of one connection are "
+            "serialized by a strand");
     po::variables_map vm;
     po::store(po::parse_command_line(argc, argv, desc), vm);
     po::notify(vm);
 
     if (vm.count("help")) {
-        std::cout << "usage: websocket-server-echo port" << std::endl;
+        std::cout << desc << std::endl;
         std::_Exit(0);
     }
-    return port;
 }
 
 int main(int argc, char* argv[])
 {
-    int port = getPort(argc, argv);
-    std::cout << "connecting on port:" << port << std::endl;
+    int port = 0;
+    int numberOfThreads = 0;
+    parseCommandLine(argc, argv, port, numberOfThreads);
+    std::cout << "connecting on port:" << port << " threads:" << numberOfThreads << std::endl;
     Server server;
 
     try {
@@ -81,9 +88,16 @@ int main(int argc, char* argv[])
         server.listen(port);
         server.start_accept();
 
-        // Start the ASIO io_service run loop
+        // Start the ASIO io_service run loop on all threads
         server.set_reuse_addr(true);
+        std::vector<std::thread> threads;
+        for (int i = 1; i < numberOfThreads; ++i) {
+            threads.emplace_back(&Server::run, &server);
+        }
         server.run();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
     } catch (websocketpp::exception const& e) {
         std::cout << e.what() << std::endl;
     } catch (...) {
@@ -47,6 +47,7 @@ class InterfaceRequestInterpreterCppTemplate extends InterfaceTemplate {
 #include "«getPackagePathWithJoynrPrefix(francaIntf, "/")»/«interfaceName»RequestInterpreter.h"
 #include "«getPackagePathWithJoynrPrefix(francaIntf, "/")»/«interfaceName»RequestCaller.h"
 #include "joynr/Util.h"
+#include "joynr/MethodDispatchTable.h"
 #include "joynr/Request.h"
 #include "joynr/OneWayRequest.h"
 #include "joynr/BaseReply.h"
@@ -76,71 +77,82 @@ void «interfaceName»RequestInterpreter::execute(
 		const std::vector<std::string>& paramTypes = request.getParamDatatypes();
 		const std::string& methodName = request.getMethodName();
 
-		// execute operation
-		«IF !attributes.empty»
+		// resolve the operation with a single hash lookup of the method name
+		static const joynr::MethodDispatchTable methodDispatchTable{
 			«FOR attribute : attributes»
 				«val attributeName = attribute.joynrName»
 				«IF attribute.readable»
-				if (methodName == "get«attributeName.toFirstUpper»" && paramTypes.size() == 0){
-					try {
-						auto requestCallerOnSuccess =
-								[onSuccess = std::move(onSuccess)](«attribute.typeName» «attributeName»){
-									BaseReply reply;
-									reply.setResponse(std::move(«attributeName»));
-									onSuccess(std::move(reply));
-								};
-						«requestCallerName»->get«attributeName.toFirstUpper»(
-																			std::move(requestCallerOnSuccess),
-																			onError);
-					} catch (const std::exception& exception) {
-						const std::string errorMessage = "Unexpected exception occurred in attribute getter get«attributeName.toFirstUpper» (): " + std::string(exception.what());
-						JOYNR_LOG_ERROR(logger(), errorMessage);
-						onError(
-							std::make_shared<exceptions::MethodInvocationException>(
-								errorMessage,
-								requestCaller->getProviderVersion()));
-					}
-					return;
+					{"get«attributeName.toFirstUpper»", 0, {}},
+				«ENDIF»
+				«IF attribute.writable»
+					{"set«attributeName.toFirstUpper»", 1, {}},
+				«ENDIF»
+			«ENDFOR»
+			«FOR method: methodsWithoutFireAndForget»
+				{"«method.joynrName»", «getInputParameters(method).size», {«FOR input : getInputParameters(method) SEPARATOR ', '»"«input.joynrTypeName»"«ENDFOR»}},
+			«ENDFOR»
+		};
+
+		// execute operation
+		«var methodIndex = -1»
+		switch (methodDispatchTable.find(methodName, paramTypes)) {
+		«FOR attribute : attributes»
+			«val attributeName = attribute.joynrName»
+			«IF attribute.readable»
+			case «methodIndex=methodIndex+1»: {
+				try {
+					auto requestCallerOnSuccess =
+							[onSuccess = std::move(onSuccess)](«attribute.typeName» «attributeName»){
+								BaseReply reply;
+								reply.setResponse(std::move(«attributeName»));
+								onSuccess(std::move(reply));
+							};
+					«requestCallerName»->get«attributeName.toFirstUpper»(
+																		std::move(requestCallerOnSuccess),
+																		onError);
+				} catch (const std::exception& exception) {
+					const std::string errorMessage = "Unexpected exception occurred in attribute getter get«attributeName.toFirstUpper» (): " + std::string(exception.what());
+					JOYNR_LOG_ERROR(logger(), errorMessage);
+					onError(
+						std::make_shared<exceptions::MethodInvocationException>(
+							errorMessage,
+							requestCaller->getProviderVersion()));
 				}
+				return;
+			}
 			«ENDIF»
 			«IF attribute.writable»
-				if (methodName == "set«attributeName.toFirstUpper»" && paramTypes.size() == 1){
-					try {
-						«attribute.typeName» typedInput«attributeName.toFirstUpper»;
-						request.getParams(typedInput«attributeName.toFirstUpper»);
-						auto requestCallerOnSuccess =
-								[onSuccess = std::move(onSuccess)] () {
-									BaseReply reply;
-									reply.setResponse();
-									onSuccess(std::move(reply));
-								};
-						«requestCallerName»->set«attributeName.toFirstUpper»(
-																			typedInput«attributeName.toFirstUpper»,
-																			std::move(requestCallerOnSuccess),
-																			onError);
-					} catch (const std::exception& exception) {
-						const std::string errorMessage = "Unexpected exception occurred in attribute setter set«attributeName.toFirstUpper» («getJoynrTypeName(attribute)»): " + std::string(exception.what());
-						JOYNR_LOG_ERROR(logger(), errorMessage);
-						onError(
-							std::make_shared<exceptions::MethodInvocationException>(
-								errorMessage,
-								requestCaller->getProviderVersion()));
-					}
-					return;
+			case «methodIndex=methodIndex+1»: {
+				try {
+					«attribute.typeName» typedInput«attributeName.toFirstUpper»;
+					request.getParams(typedInput«attributeName.toFirstUpper»);
+					auto requestCallerOnSuccess =
+							[onSuccess = std::move(onSuccess)] () {
+								BaseReply reply;
+								reply.setResponse();
+								onSuccess(std::move(reply));
+							};
+					«requestCallerName»->set«attributeName.toFirstUpper»(
+																		typedInput«attributeName.toFirstUpper»,
+																		std::move(requestCallerOnSuccess),
+																		onError);
+				} catch (const std::exception& exception) {
+					const std::string errorMessage = "Unexpected exception occurred in attribute setter set«attributeName.toFirstUpper» («getJoynrTypeName(attribute)»): " + std::string(exception.what());
+					JOYNR_LOG_ERROR(logger(), errorMessage);
+					onError(
+						std::make_shared<exceptions::MethodInvocationException>(
+							errorMessage,
+							requestCaller->getProviderVersion()));
 				}
+				return;
+			}
 			«ENDIF»
-			«ENDFOR»
-		«ENDIF»
+		«ENDFOR»
 		«FOR method: methodsWithoutFireAndForget»
 			«val inputUntypedParamList = getCommaSeperatedUntypedInputParameterList(method)»
 			«val methodName = method.joynrName»
 			«val inputParams = getInputParameters(method)»
-			«var iterator = -1»
-			if (methodName == "«methodName»" && paramTypes.size() == «inputParams.size»
-				«FOR input : inputParams»
-					&& paramTypes.at(«iterator=iterator+1») == "«input.joynrTypeName»"
-				«ENDFOR»
-			) {
+			case «methodIndex=methodIndex+1»: {
 				«val outputTypedParamList = getCommaSeperatedTypedConstOutputParameterList(method)»
 				auto requestCallerOnSuccess =
 						[onSuccess = std::move(onSuccess)](«outputTypedParamList»){
@@ -179,6 +191,9 @@ void «interfaceName»RequestInterpreter::execute(
 				return;
 			}
 		«ENDFOR»
+		default:
+			break;
+		}
 	«ELSE»
 		std::ignore = requestCaller;
 		std::ignore = onSuccess;
@@ -205,17 +220,21 @@ void «interfaceName»RequestInterpreter::execute(
 		std::shared_ptr<«interfaceName»RequestCaller> «requestCallerName» =
 				std::dynamic_pointer_cast<«interfaceName»RequestCaller>(requestCaller);
 
+		// resolve the operation with a single hash lookup of the method name
+		static const joynr::MethodDispatchTable methodDispatchTable{
+			«FOR method : fireAndForgetMethods»
+				{"«method.joynrName»", «getInputParameters(method).size», {«FOR input : getInputParameters(method) SEPARATOR ', '»"«input.joynrTypeName»"«ENDFOR»}},
+			«ENDFOR»
+		};
+
 		// execute operation
+		«var fireAndForgetMethodIndex = -1»
+		switch (methodDispatchTable.find(methodName, paramTypes)) {
 		«FOR method : fireAndForgetMethods»
 			«val inputUntypedParamList = getCommaSeperatedUntypedInputParameterList(method)»
 			«val methodName = method.joynrName»
 			«val inputParams = getInputParameters(method)»
-			«var iterator = -1»
-			if (methodName == "«methodName»" && paramTypes.size() == «inputParams.size»
-				«FOR input : inputParams»
-					&& paramTypes.at(«iterator=iterator+1») == "«input.joynrTypeName»"
-				«ENDFOR»
-			){
+			case «fireAndForgetMethodIndex=fireAndForgetMethodIndex+1»: {
 				«FOR input : inputParams»
 				«val inputName = input.joynrName»
 				«val inputType = input.type.resolveTypeDef»
@@ -237,6 +256,9 @@ void «interfaceName»RequestInterpreter::execute(
 				return;
 			}
 		«ENDFOR»
+		default:
+			break;
+		}
 	«ENDIF»
 
 	JOYNR_LOG_WARN(logger(), "unknown method name for interface «interfaceName»: {}", request.getMethodName());